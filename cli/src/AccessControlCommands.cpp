@@ -0,0 +1,243 @@
+/*
+ * AccessControlCommands.cpp - implementation of AccessControlCommands class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+
+#include "AccessControlCommands.h"
+#include "EnumHelper.h"
+#include "HostAddress.h"
+#include "NetworkObjectDirectory.h"
+#include "NetworkObjectDirectoryManager.h"
+#include "PlatformPluginInterface.h"
+#include "PlatformUserFunctions.h"
+#include "VeyonConfiguration.h"
+
+
+AccessControlCommands::AccessControlCommands( QObject* parent ) :
+	QObject( parent ),
+	m_commands( {
+		{ QStringLiteral("evaluate"), tr( "Evaluate access control rules for the given users accessing all computers "
+										  "of the network object directory <USERS> [<LOCAL-USER>] [<AUTH-METHOD-UID>]" ) },
+		{ QStringLiteral("explain"), tr( "Show which rules are checked for a single access and how long each one takes "
+										 "<ACCESSING-USER> <ACCESSING-COMPUTER> <LOCAL-USER> <LOCAL-COMPUTER> [<AUTH-METHOD-UID>]" ) },
+		} )
+{
+}
+
+
+
+QStringList AccessControlCommands::commands() const
+{
+	return m_commands.keys();
+}
+
+
+
+QString AccessControlCommands::commandHelp( const QString& command ) const
+{
+	return m_commands.value( command );
+}
+
+
+
+CommandLinePluginInterface::RunResult AccessControlCommands::handle_evaluate( const QStringList& arguments )
+{
+	if( arguments.isEmpty() )
+	{
+		return NotEnoughArguments;
+	}
+
+	if( VeyonCore::config().isAccessControlRulesProcessingEnabled() == false )
+	{
+		error( tr( "Access control rules processing is not enabled." ) );
+		return Failed;
+	}
+
+	QStringList users;
+	const auto userArguments = arguments.value( 0 ).split( QLatin1Char(',') );
+	for( const auto& user : userArguments )
+	{
+		if( user.trimmed().isEmpty() == false )
+		{
+			users.append( user.trimmed() );
+		}
+	}
+
+	const auto localUser = arguments.value( 1 );
+	const Plugin::Uid authMethodUid{ arguments.value( 2 ) };
+
+	const auto directory = VeyonCore::networkObjectDirectoryManager().configuredDirectory();
+	if( directory == nullptr )
+	{
+		error( tr( "No network object directory is configured." ) );
+		return Failed;
+	}
+
+	QStringList computers;
+	const auto hosts = directory->queryObjects( NetworkObject::Type::Host, NetworkObject::Property::None, {} );
+	computers.reserve( hosts.size() );
+	for( const auto& host : hosts )
+	{
+		const auto hostAddress = host.property( NetworkObject::Property::HostAddress ).toString();
+		if( hostAddress.isEmpty() == false )
+		{
+			computers.append( hostAddress );
+		}
+	}
+
+	if( users.isEmpty() || computers.isEmpty() )
+	{
+		error( tr( "No users or no computers to evaluate." ) );
+		return Failed;
+	}
+
+	const auto accessingComputer = HostAddress::localFQDN();
+
+	TableRows decisionRows;
+	decisionRows.reserve( users.size() * computers.size() );
+
+	QMap<QString, RuleStatistics> ruleStatistics;
+	qint64 evaluationTime = 0;
+	int groupLookups = 0;
+	qint64 groupLookupTime = 0;
+	int locationLookups = 0;
+	qint64 locationLookupTime = 0;
+
+	for( const auto& user : qAsConst(users) )
+	{
+		for( const auto& computer : qAsConst(computers) )
+		{
+			// use a new provider for each access as the server does for each connection
+			// so lookup results cached by the provider do not distort the timings
+			AccessControlProvider::Explanation explanation;
+			const auto action = AccessControlProvider().explainAccessControlRules( user, accessingComputer,
+																				   localUser, computer, {},
+																				   authMethodUid, explanation );
+			QString matchedRule = tr( "(none)" );
+			for( const auto& rule : qAsConst(explanation.rules) )
+			{
+				auto& statistics = ruleStatistics[rule.rule];
+				++statistics.evaluations;
+				statistics.time += rule.time;
+				if( rule.matched )
+				{
+					++statistics.matches;
+					matchedRule = rule.rule;
+				}
+			}
+
+			const auto time = totalTime( explanation );
+			evaluationTime += time;
+			groupLookups += explanation.groupLookups;
+			groupLookupTime += explanation.groupLookupTime;
+			locationLookups += explanation.locationLookups;
+			locationLookupTime += explanation.locationLookupTime;
+
+			decisionRows.append( { user, computer, EnumHelper::toString( action ), matchedRule, formatTime( time ) } );
+		}
+	}
+
+	printTable( Table( { tr("User"), tr("Computer"), tr("Decision"), tr("Matched rule"), tr("Time (ms)") },
+					   decisionRows ) );
+
+	TableRows ruleRows;
+	ruleRows.reserve( ruleStatistics.size() );
+	for( auto it = ruleStatistics.constBegin(), end = ruleStatistics.constEnd(); it != end; ++it )
+	{
+		ruleRows.append( { it.key(), QString::number( it->evaluations ), QString::number( it->matches ),
+						   formatTime( it->time ), formatTime( it->time / qMax( 1, it->evaluations ) ) } );
+	}
+
+	// show most expensive rules first
+	std::sort( ruleRows.begin(), ruleRows.end(), []( const TableRow& a, const TableRow& b ) {
+		return a.at(3).toDouble() > b.at(3).toDouble();
+	} );
+
+	print( {} );
+	printTable( Table( { tr("Rule"), tr("Evaluations"), tr("Matches"), tr("Total time (ms)"), tr("Average time (ms)") },
+					   ruleRows ) );
+
+	print( {} );
+	print( tr( "Evaluated %1 accesses in %2 ms" ).arg( decisionRows.size() ).arg( formatTime( evaluationTime ) ) );
+	print( tr( "User group lookups: %1 (%2 ms)" ).arg( groupLookups ).arg( formatTime( groupLookupTime ) ) );
+	print( tr( "Location lookups: %1 (%2 ms)" ).arg( locationLookups ).arg( formatTime( locationLookupTime ) ) );
+
+	return NoResult;
+}
+
+
+
+CommandLinePluginInterface::RunResult AccessControlCommands::handle_explain( const QStringList& arguments )
+{
+	if( arguments.count() < 4 )
+	{
+		return NotEnoughArguments;
+	}
+
+	AccessControlProvider::Explanation explanation;
+	const auto action = AccessControlProvider().explainAccessControlRules( arguments.value( 0 ), arguments.value( 1 ),
+																		   arguments.value( 2 ), arguments.value( 3 ),
+																		   {}, Plugin::Uid{ arguments.value( 4 ) },
+																		   explanation );
+
+	TableRows rows;
+	rows.reserve( explanation.rules.size() );
+	for( const auto& rule : qAsConst(explanation.rules) )
+	{
+		rows.append( { rule.rule,
+					   rule.matched ? tr( "matched" ) : tr( "not matched" ),
+					   rule.condition == AccessControlRule::Condition::None ? QString{} : EnumHelper::toString( rule.condition ),
+					   formatTime( rule.time ) } );
+	}
+
+	printTable( Table( { tr("Rule"), tr("Result"), tr("Deciding condition"), tr("Time (ms)") }, rows ) );
+
+	print( {} );
+	print( tr( "Decision: %1" ).arg( EnumHelper::toString( action ) ) );
+	print( tr( "Total time: %1 ms" ).arg( formatTime( totalTime( explanation ) ) ) );
+	print( tr( "User group lookups: %1 (%2 ms)" ).arg( explanation.groupLookups ).arg( formatTime( explanation.groupLookupTime ) ) );
+	print( tr( "Location lookups: %1 (%2 ms)" ).arg( explanation.locationLookups ).arg( formatTime( explanation.locationLookupTime ) ) );
+
+	return NoResult;
+}
+
+
+
+QString AccessControlCommands::formatTime( qint64 nanoseconds )
+{
+	return QString::number( double(nanoseconds) / 1000000, 'f', 3 );
+}
+
+
+
+qint64 AccessControlCommands::totalTime( const AccessControlProvider::Explanation& explanation )
+{
+	qint64 time = 0;
+	for( const auto& rule : explanation.rules )
+	{
+		time += rule.time;
+	}
+
+	return time;
+}
@@ -0,0 +1,101 @@
+/*
+ * AccessControlCommands.h - declaration of AccessControlCommands class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+
+#pragma once
+
+#include "AccessControlProvider.h"
+#include "CommandLinePluginInterface.h"
+#include "CommandLineIO.h"
+
+class AccessControlCommands : public QObject, CommandLinePluginInterface, PluginInterface, CommandLineIO
+{
+	Q_OBJECT
+	Q_INTERFACES(PluginInterface CommandLinePluginInterface)
+public:
+	explicit AccessControlCommands( QObject* parent = nullptr );
+	~AccessControlCommands() override = default;
+
+	Plugin::Uid uid() const override
+	{
+		return Plugin::Uid{ QStringLiteral("4c8f1e1a-5b2d-4d7e-9c43-2e6a0f7b18d5") };
+	}
+
+	QVersionNumber version() const override
+	{
+		return QVersionNumber( 1, 0 );
+	}
+
+	QString name() const override
+	{
+		return QStringLiteral( "AccessControl" );
+	}
+
+	QString description() const override
+	{
+		return tr( "Access control related CLI operations" );
+	}
+
+	QString vendor() const override
+	{
+		return QStringLiteral( "Veyon Community" );
+	}
+
+	QString copyright() const override
+	{
+		return QStringLiteral( "Tobias Junghans" );
+	}
+
+	QString commandLineModuleName() const override
+	{
+		return QStringLiteral( "accesscontrol" );
+	}
+
+	QString commandLineModuleHelp() const override
+	{
+		return tr( "Commands for evaluating and analyzing access control rules" );
+	}
+
+	QStringList commands() const override;
+	QString commandHelp( const QString& command ) const override;
+
+public Q_SLOTS:
+	CommandLinePluginInterface::RunResult handle_evaluate( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_explain( const QStringList& arguments );
+
+private:
+	struct RuleStatistics
+	{
+		int evaluations{0};
+		int matches{0};
+		qint64 time{0};
+	};
+
+	static QString formatTime( qint64 nanoseconds );
+	static qint64 totalTime( const AccessControlProvider::Explanation& explanation );
+
+	const QMap<QString, QString> m_commands;
+
+};
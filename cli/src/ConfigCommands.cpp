@@ -40,6 +40,7 @@ ConfigCommands::ConfigCommands( QObject* parent ) :
 { QStringLiteral("clear"), tr( "Clear system-wide Veyon configuration" ) },
 { QStringLiteral("list"), tr( "List all configuration keys and values" ) },
 { QStringLiteral("import"), tr( "Import configuration from given file" ) },
+{ QStringLiteral("diff"), tr( "Show configuration values which would be changed by importing given file" ) },
 { QStringLiteral("export"), tr( "Export configuration to given file" ) },
 { QStringLiteral("get"), tr( "Read and output configuration value for given key" ) },
 { QStringLiteral("set"), tr( "Write given value to given configuration key" ) },
@@ -116,13 +117,60 @@ CommandLinePluginInterface::RunResult ConfigCommands::handle_import( const QStri
 	Configuration::JsonStore xs( Configuration::JsonStore::System, fileName );
 
 	// merge configuration
-	VeyonCore::config() += VeyonConfiguration( &xs );
+	Configuration::Object mergedConfiguration;
+	mergedConfiguration += VeyonCore::config();
+	mergedConfiguration += VeyonConfiguration( &xs );
+
+	// do not rewrite the configuration and reload all services if applied repeatedly
+	if( VeyonCore::config().changedKeys( mergedConfiguration ).isEmpty() )
+	{
+		return Successful;
+	}
+
+	VeyonCore::config() += mergedConfiguration;
 
 	return applyConfiguration();
 }
 
 
 
+CommandLinePluginInterface::RunResult ConfigCommands::handle_diff( const QStringList& arguments )
+{
+	QString fileName = arguments.value( 0 );
+
+	if( fileName.isEmpty() || QFile( fileName ).exists() == false )
+	{
+		return operationError( tr( "Please specify an existing configuration file to import." ) );
+	}
+
+	Configuration::JsonStore xs( Configuration::JsonStore::System, fileName );
+
+	Configuration::Object mergedConfiguration;
+	mergedConfiguration += VeyonCore::config();
+	mergedConfiguration += VeyonConfiguration( &xs );
+
+	const auto changedKeys = VeyonCore::config().changedKeys( mergedConfiguration );
+
+	for( const auto& changedKey : changedKeys )
+	{
+		const auto& key = changedKey.first;
+		const auto& parentKey = changedKey.second;
+		const auto absoluteKey = parentKey.isEmpty() ? key : parentKey + QLatin1Char('/') + key;
+
+		if( VeyonCore::config().hasValue( key, parentKey ) )
+		{
+			CommandLineIO::print( QStringLiteral("-%1=%2").arg( absoluteKey,
+				printableConfigurationValue( VeyonCore::config().value( key, parentKey, {} ) ) ) );
+		}
+		CommandLineIO::print( QStringLiteral("+%1=%2").arg( absoluteKey,
+			printableConfigurationValue( mergedConfiguration.value( key, parentKey, {} ) ) ) );
+	}
+
+	return NoResult;
+}
+
+
+
 CommandLinePluginInterface::RunResult ConfigCommands::handle_export( const QStringList& arguments )
 {
 	QString fileName = arguments.value( 0 );
@@ -232,6 +280,14 @@ CommandLinePluginInterface::RunResult ConfigCommands::handle_set( const QStringL
 		configValue = value.split( QLatin1Char( ';' ) );
 	}
 
+	// setting the same value again must not rewrite the configuration and reload all services
+	if( VeyonCore::config().hasValue( key, parentKey ) &&
+		VeyonCore::config().value( key, parentKey, {} ) == configValue &&
+		configValue.userType() != QMetaType::QByteArray )
+	{
+		return Successful;
+	}
+
 	VeyonCore::config().setValue( key, configValue, parentKey );
 
 	return applyConfiguration();
@@ -82,6 +82,7 @@ public Q_SLOTS:
 	CommandLinePluginInterface::RunResult handle_clear( const QStringList& arguments );
 	CommandLinePluginInterface::RunResult handle_list( const QStringList& arguments );
 	CommandLinePluginInterface::RunResult handle_import( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_diff( const QStringList& arguments );
 	CommandLinePluginInterface::RunResult handle_export( const QStringList& arguments );
 	CommandLinePluginInterface::RunResult handle_get( const QStringList& arguments );
 	CommandLinePluginInterface::RunResult handle_set( const QStringList& arguments );
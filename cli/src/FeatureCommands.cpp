@@ -33,6 +33,7 @@
 #include "FeatureCommands.h"
 #include "FeatureManager.h"
 #include "PluginManager.h"
+#include "VeyonConfiguration.h"
 
 
 FeatureCommands::FeatureCommands( QObject* parent ) :
@@ -94,7 +95,8 @@ CommandLinePluginInterface::RunResult FeatureCommands::handle_help( const QStrin
 					{ { tr("ARGUMENTS"), {} } } );
 
 		printDescription( tr("Starts the specified feature on the specified host by connecting to "
-							  "the Veyon Server running remotely. The feature can be specified by name "
+							  "the Veyon Server running remotely. Multiple hosts can be specified "
+							  "separated by commas and are connected to in parallel. The feature can be specified by name "
 							  "or UID. Use the ``show`` command to see all available features. "
 							  "Depending on the feature, additional arguments (such as the text message to display) "
 							  "encoded as a single JSON string have to be specified. Please refer to "
@@ -124,7 +126,8 @@ CommandLinePluginInterface::RunResult FeatureCommands::handle_help( const QStrin
 					{ { tr("HOST ADDRESS"), {} }, { tr("FEATURE"), {} } }, {} );
 
 		printDescription( tr("Stops the specified feature on the specified host by connecting to "
-							  "the Veyon Server running remotely. The feature can be specified by name "
+							  "the Veyon Server running remotely. Multiple hosts can be specified "
+							  "separated by commas and are connected to in parallel. The feature can be specified by name "
 							  "or UID. Use the ``show`` command to see all available features.") );
 
 		printExamples( commandLineModuleName(), stopCommand(),
@@ -224,7 +227,21 @@ CommandLinePluginInterface::RunResult FeatureCommands::controlComputer( FeatureP
 		return NotEnoughArguments;
 	}
 
-	const auto host = arguments[0];
+	QStringList hosts;
+	const auto hostArguments = arguments[0].split( QLatin1Char(',') );
+	for( const auto& host : hostArguments )
+	{
+		if( host.trimmed().isEmpty() == false && hosts.contains( host.trimmed() ) == false )
+		{
+			hosts.append( host.trimmed() );
+		}
+	}
+
+	if( hosts.isEmpty() )
+	{
+		return InvalidArguments;
+	}
+
 	const auto featureNameOrUid = arguments[1];
 	const auto featureArguments = arguments.value(2);
 
@@ -269,55 +286,118 @@ CommandLinePluginInterface::RunResult FeatureCommands::controlComputer( FeatureP
 		return Failed;
 	}
 
-	Computer computer;
-	computer.setHostAddress( host );
-
-	auto computerControlInterface = ComputerControlInterface::Pointer::create( computer );
-	computerControlInterface->start();
+	struct HostConnection
+	{
+		QString host;
+		ComputerControlInterface::Pointer controlInterface;
+		QElapsedTimer elapsedTimer;
+		bool featureMessageSent{false};
+	};
 
 	static constexpr auto ConnectTimeout = 30 * 1000;
-	QTimer timeoutTimer;
-	timeoutTimer.start( ConnectTimeout );
+	static constexpr auto MessageQueueWaitTimeout = 10 * 1000;
+	static constexpr auto PollInterval = 10;
+
+	const auto maximumConcurrentConnections = VeyonCore::config().cliMaximumConcurrentConnections();
+	const auto reportSuccess = hosts.count() > 1;
+
+	auto pendingHosts = hosts;
+	QList<HostConnection> connections;
+	int failedHosts = 0;
 
 	QEventLoop eventLoop;
-	connect( &timeoutTimer, &QTimer::timeout, &eventLoop, &QEventLoop::quit );
-	connect( computerControlInterface.data(), &ComputerControlInterface::stateChanged, this,
-			 [&]() {
-				 if( computerControlInterface->state() == ComputerControlInterface::State::Connected )
-				 {
-					 eventLoop.quit();
-				 }
-			 } );
-
-	eventLoop.exec();
-
-	if( computerControlInterface->state() != ComputerControlInterface::State::Connected )
-	{
-		error( tr("Could not establish a connection to host %1").arg( host ) );
-		return Failed;
-	}
+	QTimer pollTimer;
 
-	featureManager.controlFeature( featureUid, operation,
-								   featureArgsJson.toVariant().toMap(),
-								   { computerControlInterface } );
+	// connect to multiple hosts in parallel and report results as soon as they are available
+	const auto poll = [&]() {
+		for( auto it = connections.begin(); it != connections.end(); )
+		{
+			auto& connection = *it;
+			auto finished = false;
 
-	static constexpr auto MessageQueueWaitTimeout = 10 * 1000;
-	static constexpr auto MessageQueuePollInterval = 10;
+			if( connection.featureMessageSent == false )
+			{
+				if( connection.controlInterface->state() == ComputerControlInterface::State::Connected )
+				{
+					featureManager.controlFeature( featureUid, operation,
+												   featureArgsJson.toVariant().toMap(),
+												   { connection.controlInterface } );
+					connection.featureMessageSent = true;
+					connection.elapsedTimer.restart();
+				}
+				else if( connection.controlInterface->state() == ComputerControlInterface::State::AuthenticationFailed ||
+						 connection.elapsedTimer.elapsed() >= ConnectTimeout )
+				{
+					error( tr("Could not establish a connection to host %1").arg( connection.host ) );
+					m_controlInterfaces.remove( connection.host );
+					++failedHosts;
+					finished = true;
+				}
+			}
+			else if( connection.controlInterface->isMessageQueueEmpty() )
+			{
+				if( reportSuccess )
+				{
+					info( tr("Feature control message successfully sent to host %1").arg( connection.host ) );
+				}
+				finished = true;
+			}
+			else if( connection.elapsedTimer.elapsed() >= MessageQueueWaitTimeout )
+			{
+				error( tr("Failed to send feature control message to host %1").arg( connection.host ) );
+				m_controlInterfaces.remove( connection.host );
+				++failedHosts;
+				finished = true;
+			}
+
+			if( finished )
+			{
+				it = connections.erase( it );
+			}
+			else
+			{
+				++it;
+			}
+		}
 
-	QElapsedTimer messageQueueWaitTimer;
-	messageQueueWaitTimer.start();
+		while( pendingHosts.isEmpty() == false &&
+			   ( maximumConcurrentConnections <= 0 || connections.count() < maximumConcurrentConnections ) )
+		{
+			const auto host = pendingHosts.takeFirst();
 
-	while( computerControlInterface->isMessageQueueEmpty() == false &&
-		   messageQueueWaitTimer.elapsed() < MessageQueueWaitTimeout )
-	{
-		QThread::msleep(MessageQueuePollInterval);
-	}
+			auto controlInterface = m_controlInterfaces.value( host );
+			if( controlInterface.isNull() )
+			{
+				Computer computer;
+				computer.setHostAddress( host );
+
+				controlInterface = ComputerControlInterface::Pointer::create( computer );
+				controlInterface->start();
 
-	if( messageQueueWaitTimer.elapsed() >= MessageQueueWaitTimeout )
+				m_controlInterfaces[host] = controlInterface;
+			}
+
+			HostConnection connection{ host, controlInterface, {} };
+			connection.elapsedTimer.start();
+
+			connections.append( connection );
+		}
+
+		if( connections.isEmpty() )
+		{
+			eventLoop.quit();
+		}
+	};
+
+	connect( &pollTimer, &QTimer::timeout, &eventLoop, poll );
+	pollTimer.start( PollInterval );
+
+	poll();
+
+	if( connections.isEmpty() == false )
 	{
-		error( tr("Failed to send feature control message to host %1").arg( host ) );
-		return Failed;
+		eventLoop.exec();
 	}
 
-	return Successful;
+	return failedHosts > 0 ? Failed : Successful;
 }
@@ -26,6 +26,7 @@
 
 #include "CommandLinePluginInterface.h"
 #include "CommandLineIO.h"
+#include "ComputerControlInterface.h"
 #include "FeatureProviderInterface.h"
 
 class FeatureCommands : public QObject, CommandLinePluginInterface, PluginInterface, CommandLineIO
@@ -111,4 +112,7 @@ private:
 
 	const QMap<QString, QString> m_commands;
 
+	// connections are kept open so subsequent commands in a shell session can reuse them
+	QHash<QString, ComputerControlInterface::Pointer> m_controlInterfaces;
+
 };
@@ -0,0 +1,148 @@
+/*
+ * LogCommands.cpp - implementation of LogCommands class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include <QDateTime>
+#include <QFile>
+#include <QThread>
+
+#include "EnumHelper.h"
+#include "LogCommands.h"
+#include "Logger.h"
+#include "StructuredLog.h"
+
+
+LogCommands::LogCommands( QObject* parent ) :
+	QObject( parent ),
+	m_commands( {
+		{ QStringLiteral("show"), tr( "Show all entries of a structured log file [<LEVEL>] [<TEXT>]" ) },
+		{ QStringLiteral("follow"), tr( "Show new entries of a structured log file as they are written [<LEVEL>] [<TEXT>]" ) },
+		} )
+{
+}
+
+
+
+QStringList LogCommands::commands() const
+{
+	return m_commands.keys();
+}
+
+
+
+QString LogCommands::commandHelp( const QString& command ) const
+{
+	return m_commands.value( command );
+}
+
+
+
+CommandLinePluginInterface::RunResult LogCommands::handle_show( const QStringList& arguments )
+{
+	QFile file;
+	const auto result = openLogFile( arguments, file );
+	if( result != Successful )
+	{
+		return result;
+	}
+
+	StructuredLog log( &file );
+	printEntries( log, arguments );
+
+	return NoResult;
+}
+
+
+
+CommandLinePluginInterface::RunResult LogCommands::handle_follow( const QStringList& arguments )
+{
+	QFile file;
+	const auto result = openLogFile( arguments, file );
+	if( result != Successful )
+	{
+		return result;
+	}
+
+	StructuredLog log( &file );
+
+	while( file.isOpen() )
+	{
+		printEntries( log, arguments );
+
+		// log file has been truncated due to size limit
+		if( file.size() < file.pos() )
+		{
+			file.seek( 0 );
+			log.reset();
+		}
+
+		QThread::msleep( FollowPollInterval );
+	}
+
+	return NoResult;
+}
+
+
+
+CommandLinePluginInterface::RunResult LogCommands::openLogFile( const QStringList& arguments, QFile& file )
+{
+	if( arguments.isEmpty() )
+	{
+		return NotEnoughArguments;
+	}
+
+	file.setFileName( arguments.first() );
+	if( file.open( QFile::ReadOnly ) == false )
+	{
+		error( tr( "Could not open log file %1" ).arg( file.fileName() ) );
+		return Failed;
+	}
+
+	return Successful;
+}
+
+
+
+void LogCommands::printEntries( StructuredLog& log, const QStringList& arguments )
+{
+	const auto maximumLogLevel = arguments.size() > 1 ? Logger::logLevelFromString( arguments.at( 1 ) ) : Logger::LogLevel::Max;
+	const auto filterText = arguments.value( 2 );
+
+	StructuredLog::Entry entry;
+	while( log.read( entry ) )
+	{
+		if( entry.logLevel > int(maximumLogLevel) ||
+			( filterText.isEmpty() == false && entry.message.contains( filterText, Qt::CaseInsensitive ) == false ) )
+		{
+			continue;
+		}
+
+		const auto logLevel = EnumHelper::toString( Logger::LogLevel(entry.logLevel) ).toUpper();
+		const auto category = entry.category.isEmpty() ? QString{} : QStringLiteral("[%1] ").arg( entry.category );
+
+		print( QStringLiteral("%1: [%2] [%3] %4%5").arg(
+				   QDateTime::fromMSecsSinceEpoch( entry.timestamp ).toString( Qt::ISODateWithMs ),
+				   QString::number( entry.sessionId ), logLevel, category, entry.message ) );
+	}
+}
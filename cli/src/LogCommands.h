@@ -0,0 +1,97 @@
+/*
+ * LogCommands.h - declaration of LogCommands class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#pragma once
+
+#include "CommandLinePluginInterface.h"
+#include "CommandLineIO.h"
+
+class QFile;
+class StructuredLog;
+
+class LogCommands : public QObject, CommandLinePluginInterface, PluginInterface, CommandLineIO
+{
+	Q_OBJECT
+	Q_INTERFACES(PluginInterface CommandLinePluginInterface)
+public:
+	explicit LogCommands( QObject* parent = nullptr );
+	~LogCommands() override = default;
+
+	Plugin::Uid uid() const override
+	{
+		return Plugin::Uid{ QStringLiteral("906af74c-2c40-49a0-a306-f973fe85d864") };
+	}
+
+	QVersionNumber version() const override
+	{
+		return QVersionNumber( 1, 0 );
+	}
+
+	QString name() const override
+	{
+		return QStringLiteral( "Log" );
+	}
+
+	QString description() const override
+	{
+		return tr( "Log-related CLI operations" );
+	}
+
+	QString vendor() const override
+	{
+		return QStringLiteral( "Veyon Community" );
+	}
+
+	QString copyright() const override
+	{
+		return QStringLiteral( "Tobias Junghans" );
+	}
+
+	QString commandLineModuleName() const override
+	{
+		return QStringLiteral( "log" );
+	}
+
+	QString commandLineModuleHelp() const override
+	{
+		return tr( "Commands for decoding structured log files" );
+	}
+
+	QStringList commands() const override;
+	QString commandHelp( const QString& command ) const override;
+
+public Q_SLOTS:
+	CommandLinePluginInterface::RunResult handle_show( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_follow( const QStringList& arguments );
+
+private:
+	static constexpr int FollowPollInterval = 250;
+
+	CommandLinePluginInterface::RunResult openLogFile( const QStringList& arguments, QFile& file );
+	void printEntries( StructuredLog& log, const QStringList& arguments );
+
+	const QMap<QString, QString> m_commands;
+
+};
@@ -34,6 +34,7 @@ ServiceControlCommands::ServiceControlCommands( QObject* parent ) :
 { QStringLiteral("start"), tr( "Start Veyon Service" ) },
 { QStringLiteral("stop"), tr( "Stop Veyon Service" ) },
 { QStringLiteral("restart"), tr( "Restart Veyon Service" ) },
+{ QStringLiteral("reload"), tr( "Apply changed configuration without restarting unaffected server instances" ) },
 { QStringLiteral("status"), tr( "Query status of Veyon Service" ) },
 				} )
 {
@@ -96,6 +97,18 @@ CommandLinePluginInterface::RunResult ServiceControlCommands::handle_restart( co
 
 
 
+CommandLinePluginInterface::RunResult ServiceControlCommands::handle_reload( const QStringList& arguments )
+{
+	Q_UNUSED(arguments)
+
+	VeyonServiceControl serviceControl;
+	serviceControl.reloadService();
+
+	return serviceControl.isServiceRunning() ? Successful : Failed;
+}
+
+
+
 CommandLinePluginInterface::RunResult ServiceControlCommands::handle_status( const QStringList& arguments )
 {
 	Q_UNUSED(arguments)
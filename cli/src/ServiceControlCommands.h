@@ -90,6 +90,7 @@ public Q_SLOTS:
 	CommandLinePluginInterface::RunResult handle_start( const QStringList& arguments );
 	CommandLinePluginInterface::RunResult handle_stop( const QStringList& arguments );
 	CommandLinePluginInterface::RunResult handle_restart( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_reload( const QStringList& arguments );
 	CommandLinePluginInterface::RunResult handle_status( const QStringList& arguments );
 
 private:
@@ -27,6 +27,7 @@
 #include <QProcess>
 
 #include "CommandLineIO.h"
+#include "PluginManager.h"
 #include "ShellCommands.h"
 
 
@@ -87,7 +88,13 @@ CommandLinePluginInterface::RunResult ShellCommands::handle_run( const QStringLi
 		return Failed;
 	}
 
-	while( scriptFile.canReadLine() )
+	if( scriptFile.open( QFile::ReadOnly | QFile::Text ) == false )
+	{
+		CommandLineIO::error( tr( "Could not open file \"%1\" for reading!" ).arg( scriptFile.fileName() ) );
+		return Failed;
+	}
+
+	while( scriptFile.atEnd() == false )
 	{
 		runCommand( QString::fromUtf8( scriptFile.readLine() ) );
 	}
@@ -99,6 +106,54 @@ CommandLinePluginInterface::RunResult ShellCommands::handle_run( const QStringLi
 
 void ShellCommands::runCommand( const QString& command )
 {
-	// TODO: properly split arguments containing spaces
-	QProcess::execute( QCoreApplication::applicationFilePath(), command.split( QLatin1Char(' ') ) );
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+	const auto arguments = QProcess::splitCommand( command );
+#else
+	const auto arguments = command.split( QLatin1Char(' '), QString::SkipEmptyParts );
+#endif
+
+	if( arguments.isEmpty() )
+	{
+		return;
+	}
+
+	// run commands within this process so plugins are loaded only once and
+	// connections established by previous commands can be reused
+	auto runResult = Unknown;
+	if( arguments.count() >= 2 && arguments[0] != commandLineModuleName() &&
+		runCommandInProcess( arguments[0], arguments[1], arguments.mid( 2 ), runResult ) )
+	{
+		// the command has been executed already so never run it a second time
+		CommandLineIO::printRunResult( runResult, arguments[0] );
+		return;
+	}
+
+	// let a separate process handle everything else, e.g. printing help
+	QProcess::execute( QCoreApplication::applicationFilePath(), arguments );
+}
+
+
+
+bool ShellCommands::runCommandInProcess( const QString& module, const QString& command,
+										const QStringList& arguments, RunResult& runResult )
+{
+	const auto handler = QStringLiteral( "handle_%1" ).arg( command ).toUtf8();
+	const auto signature = handler + QByteArrayLiteral("(QStringList)");
+
+	const auto pluginObjects = VeyonCore::pluginManager().pluginObjects();
+	for( auto pluginObject : pluginObjects )
+	{
+		auto commandLinePluginInterface = qobject_cast<CommandLinePluginInterface *>( pluginObject );
+		if( commandLinePluginInterface &&
+			commandLinePluginInterface->commandLineModuleName() == module &&
+			pluginObject->metaObject()->indexOfMethod( signature.constData() ) >= 0 )
+		{
+			QMetaObject::invokeMethod( pluginObject, handler.constData(), Qt::DirectConnection,
+									   Q_RETURN_ARG(CommandLinePluginInterface::RunResult, runResult),
+									   Q_ARG( QStringList, arguments ) );
+			return true;
+		}
+	}
+
+	return false;
 }
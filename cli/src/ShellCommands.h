@@ -83,6 +83,8 @@ public Q_SLOTS:
 
 private:
 	void runCommand( const QString& command );
+	bool runCommandInProcess( const QString& module, const QString& command, const QStringList& arguments,
+							  RunResult& runResult );
 
 	QMap<QString, QString> m_commands;
 
@@ -26,8 +26,10 @@
 
 #include <openssl/crypto.h>
 
+#include "AccessControlCommands.h"
 #include "ConfigCommands.h"
 #include "FeatureCommands.h"
+#include "LogCommands.h"
 #include "Logger.h"
 #include "PluginCommands.h"
 #include "PluginManager.h"
@@ -85,8 +87,10 @@ int main( int argc, char **argv )
 	}
 
 	auto core = new VeyonCore( app, VeyonCore::Component::CLI, QStringLiteral("CLI") );
+	VeyonCore::pluginManager().registerExtraPluginInterface( new AccessControlCommands( core ) );
 	VeyonCore::pluginManager().registerExtraPluginInterface( new ConfigCommands( core ) );
 	VeyonCore::pluginManager().registerExtraPluginInterface( new FeatureCommands( core ) );
+	VeyonCore::pluginManager().registerExtraPluginInterface( new LogCommands( core ) );
 	VeyonCore::pluginManager().registerExtraPluginInterface( new PluginCommands( core ) );
 	VeyonCore::pluginManager().registerExtraPluginInterface( new ServiceControlCommands( core ) );
 	VeyonCore::pluginManager().registerExtraPluginInterface( new ShellCommands( core ) );
@@ -138,34 +142,10 @@ int main( int argc, char **argv )
 				runResult = CommandLinePluginInterface::NotEnoughArguments;
 			}
 
-			switch( runResult )
+			if( CommandLineIO::printRunResult( runResult, module ) )
 			{
-			case CommandLinePluginInterface::NoResult:
-				return 0;
-			case CommandLinePluginInterface::Successful:
-				CommandLineIO::print( VeyonCore::tr( "[OK]" ) );
-				return 0;
-			case CommandLinePluginInterface::Failed:
-				CommandLineIO::print( VeyonCore::tr( "[FAIL]" ) );
-				return -1;
-			case CommandLinePluginInterface::InvalidCommand:
-				CommandLineIO::error( VeyonCore::tr( "Invalid command!" ) );
-				break;
-			case CommandLinePluginInterface::InvalidArguments:
-				CommandLineIO::error( VeyonCore::tr( "Invalid arguments given" ) );
-				return -1;
-			case CommandLinePluginInterface::NotEnoughArguments:
-				CommandLineIO::error( VeyonCore::tr( "Not enough arguments given - "
-													 "use \"%1 help\" for more information" ).arg( module ) );
-				return -1;
-			case CommandLinePluginInterface::NotLicensed:
-				CommandLineIO::error( VeyonCore::tr( "Plugin not licensed" ) );
-				return -1;
-			case CommandLinePluginInterface::Unknown:
-				break;
-			default:
-				CommandLineIO::error( VeyonCore::tr( "Unknown result!" ) );
-				return -1;
+				return runResult == CommandLinePluginInterface::NoResult ||
+						runResult == CommandLinePluginInterface::Successful ? 0 : -1;
 			}
 
 			auto commands = it.key()->commands();
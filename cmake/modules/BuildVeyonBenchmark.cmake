@@ -0,0 +1,11 @@
+# BuildVeyonBenchmark.cmake - Copyright (c) 2022 Tobias Junghans
+#
+# description: build benchmark for Veyon component
+# usage: build_veyon_benchmark(<NAME> <SOURCES>)
+
+macro(build_veyon_benchmark BENCHMARK_NAME)
+	add_executable(${BENCHMARK_NAME} ${ARGN})
+	set_default_target_properties(${BENCHMARK_NAME})
+	target_link_libraries(${BENCHMARK_NAME} veyon-core Qt${QT_MAJOR_VERSION}::Test)
+	add_test(NAME ${BENCHMARK_NAME} COMMAND ${BENCHMARK_NAME})
+endmacro()
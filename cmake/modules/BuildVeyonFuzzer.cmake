@@ -9,6 +9,10 @@ macro(build_veyon_fuzzer FUZZER_NAME)
 	target_compile_options(${FUZZER_NAME} PRIVATE "-g;-fsanitize=fuzzer")
 	target_link_options(${FUZZER_NAME} PRIVATE "-g;-fsanitize=fuzzer")
 	target_link_libraries(${FUZZER_NAME} veyon-core)
+	target_include_directories(${FUZZER_NAME} PRIVATE ${CMAKE_SOURCE_DIR}/tests/libfuzzer/common)
 	add_test(NAME ${FUZZER_NAME} COMMAND ${FUZZER_NAME} -max_total_time=60)
+	# catch inputs causing excessive processing time or memory usage relative to their size
+	add_test(NAME ${FUZZER_NAME}-cost COMMAND ${FUZZER_NAME} -max_total_time=60 -malloc_limit_mb=256 -rss_limit_mb=1024)
+	set_tests_properties(${FUZZER_NAME}-cost PROPERTIES ENVIRONMENT VEYON_FUZZER_MAX_NSECS_PER_BYTE=100000)
 endmacro()
 
@@ -72,6 +72,9 @@ int AccessControlRulesTestDialog::exec()
 
 void AccessControlRulesTestDialog::accept()
 {
+	// always evaluate rules against current group memberships and locations
+	AccessControlProvider::clearDecisionCache();
+
 	const auto result = AccessControlProvider{}
 							.processAccessControlRules( ui->accessingUserLineEdit->text(),
 														ui->accessingComputerLineEdit->text(),
@@ -86,14 +86,14 @@ void ServiceConfigurationPage::applyConfiguration()
 	VeyonServiceControl serviceControl( this );
 
 	if( serviceControl.isServiceRunning() &&
-		QMessageBox::question( this, tr( "Restart %1 Service" ).arg( VeyonCore::applicationName() ),
+		QMessageBox::question( this, tr( "Reload %1 Service" ).arg( VeyonCore::applicationName() ),
 			tr( "All settings were saved successfully. In order to take "
-				"effect the %1 service needs to be restarted. "
-				"Restart it now?" ).arg( VeyonCore::applicationName() ),
+				"effect the %1 service needs to reload its configuration. "
+				"Reload it now?" ).arg( VeyonCore::applicationName() ),
 			QMessageBox::Yes | QMessageBox::No, QMessageBox::Yes ) == QMessageBox::Yes )
 	{
-		serviceControl.stopService();
-		serviceControl.startService();
+		// restarts server instances or the whole service only if required by the changed settings
+		serviceControl.reloadService();
 	}
 }
 
@@ -22,6 +22,10 @@
  *
  */
 
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QMutex>
 #include <QNetworkInterface>
 #include <QRegularExpression>
 
@@ -37,6 +41,16 @@
 #include "PlatformUserFunctions.h"
 
 
+struct CachedAccessControlDecision
+{
+	AccessControlRule::Action action;
+	QElapsedTimer age;
+};
+
+static QMutex __decisionCacheMutex;
+static QHash<QString, CachedAccessControlDecision> __decisionCache;
+static QByteArray __decisionCacheRuleSetHash;
+
 AccessControlProvider::AccessControlProvider() :
 	m_userGroupsBackend( VeyonCore::userGroupsBackendManager().accessControlBackend() ),
 	m_networkObjectDirectory( VeyonCore::networkObjectDirectoryManager().configuredDirectory() ),
@@ -49,6 +63,28 @@ AccessControlProvider::AccessControlProvider() :
 	for( const auto& accessControlRule : accessControlRules )
 	{
 		m_accessControlRules.append( AccessControlRule( accessControlRule ) );
+
+		// compile group name patterns once instead of for each evaluation
+		const auto& rule = m_accessControlRules.constLast();
+		if( rule.isConditionEnabled( AccessControlRule::Condition::MemberOfGroup ) )
+		{
+			const auto groupName = rule.argument( AccessControlRule::Condition::MemberOfGroup );
+			m_groupNameRegularExpressions[groupName] = QRegularExpression( groupName );
+		}
+	}
+
+	m_ruleSetHash = QCryptographicHash::hash( QJsonDocument( accessControlRules ).toJson( QJsonDocument::Compact ) +
+												  QByteArray::number( m_queryDomainGroups ) +
+												  VeyonCore::config().accessControlUserGroupsBackend().toByteArray() +
+												  VeyonCore::config().enabledNetworkObjectDirectoryPlugins().join( QLatin1Char(',') ).toUtf8(),
+											  QCryptographicHash::Sha1 );
+
+	QMutexLocker locker( &__decisionCacheMutex );
+	if( __decisionCacheRuleSetHash != m_ruleSetHash )
+	{
+		// configuration changed, therefore discard all decisions based on previous rules
+		__decisionCache.clear();
+		__decisionCacheRuleSetHash = m_ruleSetHash;
 	}
 }
 
@@ -194,6 +230,85 @@ AccessControlRule::Action AccessControlProvider::processAccessControlRules( cons
 {
 	vDebug() << "processing rules for" << accessingUser << accessingComputer << localUser << localComputer << connectedUsers << authMethodUid;
 
+	const auto cacheable = areRulesCacheable();
+	auto sortedConnectedUsers = connectedUsers;
+	sortedConnectedUsers.sort();
+	const auto cacheKey = QStringList{ accessingUser, accessingComputer, localUser, localComputer,
+									   sortedConnectedUsers.join( QLatin1Char(',') ),
+									   authMethodUid.toString() }.join( QLatin1Char('\n') );
+
+	if( cacheable )
+	{
+		QMutexLocker locker( &__decisionCacheMutex );
+		const auto it = __decisionCache.constFind( cacheKey );
+		if( __decisionCacheRuleSetHash == m_ruleSetHash &&
+			it != __decisionCache.constEnd() &&
+			it->age.hasExpired( DecisionCacheTimeout ) == false )
+		{
+			vDebug() << "using cached decision" << it->action;
+			return it->action;
+		}
+	}
+
+	const auto action = evaluateAccessControlRules( accessingUser, accessingComputer, localUser, localComputer,
+													connectedUsers, authMethodUid );
+
+	if( cacheable )
+	{
+		CachedAccessControlDecision decision{ action, {} };
+		decision.age.start();
+
+		QMutexLocker locker( &__decisionCacheMutex );
+		if( __decisionCacheRuleSetHash == m_ruleSetHash )
+		{
+			if( __decisionCache.size() >= MaximumDecisionCacheSize )
+			{
+				__decisionCache.clear();
+			}
+			__decisionCache[cacheKey] = decision;
+		}
+	}
+
+	return action;
+}
+
+
+
+AccessControlRule::Action AccessControlProvider::explainAccessControlRules( const QString& accessingUser,
+																			const QString& accessingComputer,
+																			const QString& localUser,
+																			const QString& localComputer,
+																			const QStringList& connectedUsers,
+																			Plugin::Uid authMethodUid,
+																			Explanation& explanation )
+{
+	explanation = {};
+
+	m_explanation = &explanation;
+	const auto action = evaluateAccessControlRules( accessingUser, accessingComputer, localUser, localComputer,
+													connectedUsers, authMethodUid );
+	m_explanation = nullptr;
+
+	return action;
+}
+
+
+
+void AccessControlProvider::clearDecisionCache()
+{
+	QMutexLocker locker( &__decisionCacheMutex );
+	__decisionCache.clear();
+}
+
+
+
+AccessControlRule::Action AccessControlProvider::evaluateAccessControlRules( const QString& accessingUser,
+																			 const QString& accessingComputer,
+																			 const QString& localUser,
+																			 const QString& localComputer,
+																			 const QStringList& connectedUsers,
+																			 Plugin::Uid authMethodUid ) const
+{
 	for( const auto& rule : qAsConst( m_accessControlRules ) )
 	{
 		// rule disabled?
@@ -203,7 +318,26 @@ AccessControlRule::Action AccessControlProvider::processAccessControlRules( cons
 			continue;
 		}
 
-		if( rule.areConditionsIgnored() ||
+		if( m_explanation )
+		{
+			QElapsedTimer timer;
+			timer.start();
+
+			RuleEvaluation evaluation{ rule.name(), AccessControlRule::Condition::None, true, 0 };
+			if( rule.areConditionsIgnored() == false )
+			{
+				evaluation.matched = matchConditions( rule, accessingUser, accessingComputer, localUser, localComputer,
+													  connectedUsers, authMethodUid, evaluation.condition );
+			}
+			evaluation.time = timer.nsecsElapsed();
+			m_explanation->rules.append( evaluation );
+
+			if( evaluation.matched )
+			{
+				return rule.action();
+			}
+		}
+		else if( rule.areConditionsIgnored() ||
 			matchConditions( rule, accessingUser, accessingComputer, localUser, localComputer, connectedUsers, authMethodUid ) )
 		{
 			vDebug() << "rule" << rule.name() << "matched with action" << rule.action();
@@ -250,32 +384,107 @@ bool AccessControlProvider::isAccessToLocalComputerDenied() const
 
 
 
+bool AccessControlProvider::areRulesCacheable() const
+{
+	// rules depending on the state of local sessions have to be evaluated each time
+	static const std::initializer_list<AccessControlRule::Condition> volatileConditions{
+		AccessControlRule::Condition::NoUserLoggedInLocally,
+		AccessControlRule::Condition::NoUserLoggedInRemotely,
+		AccessControlRule::Condition::AccessedUserLoggedInLocally,
+		AccessControlRule::Condition::UserSession
+	};
+
+	for( const auto& rule : qAsConst( m_accessControlRules ) )
+	{
+		if( rule.action() == AccessControlRule::Action::None || rule.areConditionsIgnored() )
+		{
+			continue;
+		}
+
+		for( const auto condition : volatileConditions )
+		{
+			if( rule.isConditionEnabled( condition ) )
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+
+
+QStringList AccessControlProvider::groupsOfUser( const QString& user ) const
+{
+	auto it = m_groupsOfUserCache.constFind( user );
+	if( it == m_groupsOfUserCache.constEnd() )
+	{
+		QElapsedTimer timer;
+		timer.start();
+
+		it = m_groupsOfUserCache.insert( user, m_userGroupsBackend->groupsOfUser( user, m_queryDomainGroups ) );
+
+		if( m_explanation )
+		{
+			++m_explanation->groupLookups;
+			m_explanation->groupLookupTime += timer.nsecsElapsed();
+		}
+	}
+
+	return *it;
+}
+
+
+
+QStringList AccessControlProvider::cachedLocationsOfComputer( const QString& computer ) const
+{
+	auto it = m_locationsOfComputerCache.constFind( computer );
+	if( it == m_locationsOfComputerCache.constEnd() )
+	{
+		QElapsedTimer timer;
+		timer.start();
+
+		it = m_locationsOfComputerCache.insert( computer, locationsOfComputer( computer ) );
+
+		if( m_explanation )
+		{
+			++m_explanation->locationLookups;
+			m_explanation->locationLookupTime += timer.nsecsElapsed();
+		}
+	}
+
+	return *it;
+}
+
+
+
 bool AccessControlProvider::isMemberOfUserGroup( const QString &user,
 												 const QString &groupName ) const
 {
-	const QRegularExpression groupNameRX( groupName );
+	const auto groupNameRX = m_groupNameRegularExpressions.value( groupName, QRegularExpression( groupName ) );
 
 	if( groupNameRX.isValid() )
 	{
-		return m_userGroupsBackend->groupsOfUser( user, m_queryDomainGroups ).indexOf( groupNameRX ) >= 0;
+		return groupsOfUser( user ).indexOf( groupNameRX ) >= 0;
 	}
 
-	return m_userGroupsBackend->groupsOfUser( user, m_queryDomainGroups ).contains( groupName );
+	return groupsOfUser( user ).contains( groupName );
 }
 
 
 
 bool AccessControlProvider::isLocatedAt( const QString &computer, const QString &locationName ) const
 {
-	return locationsOfComputer( computer ).contains( locationName );
+	return cachedLocationsOfComputer( computer ).contains( locationName );
 }
 
 
 
 bool AccessControlProvider::haveGroupsInCommon( const QString &userOne, const QString &userTwo ) const
 {
-	const auto userOneGroups = m_userGroupsBackend->groupsOfUser( userOne, m_queryDomainGroups );
-	const auto userTwoGroups = m_userGroupsBackend->groupsOfUser( userTwo, m_queryDomainGroups );
+	const auto userOneGroups = groupsOfUser( userOne );
+	const auto userTwoGroups = groupsOfUser( userTwo );
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
 	const auto userOneGroupSet = QSet<QString>{ userOneGroups.begin(), userOneGroups.end() };
@@ -292,8 +501,8 @@ bool AccessControlProvider::haveGroupsInCommon( const QString &userOne, const QS
 
 bool AccessControlProvider::haveSameLocations( const QString &computerOne, const QString &computerTwo ) const
 {
-	const auto computerOneLocations = locationsOfComputer( computerOne );
-	const auto computerTwoLocations = locationsOfComputer( computerTwo );
+	const auto computerOneLocations = cachedLocationsOfComputer( computerOne );
+	const auto computerTwoLocations = cachedLocationsOfComputer( computerTwo );
 
 	return computerOneLocations.isEmpty() == false &&
 			computerOneLocations == computerTwoLocations;
@@ -352,10 +561,24 @@ bool AccessControlProvider::matchConditions( const AccessControlRule &rule,
 											 const QString& accessingUser, const QString& accessingComputer,
 											 const QString& localUser, const QString& localComputer,
 											 const QStringList& connectedUsers, Plugin::Uid authMethodUid ) const
+{
+	AccessControlRule::Condition condition{AccessControlRule::Condition::None};
+
+	return matchConditions( rule, accessingUser, accessingComputer, localUser, localComputer,
+							connectedUsers, authMethodUid, condition );
+}
+
+
+
+bool AccessControlProvider::matchConditions( const AccessControlRule &rule,
+											 const QString& accessingUser, const QString& accessingComputer,
+											 const QString& localUser, const QString& localComputer,
+											 const QStringList& connectedUsers, Plugin::Uid authMethodUid,
+											 AccessControlRule::Condition& condition ) const
 {
 	vDebug() << rule.toJson();
 
-	AccessControlRule::Condition condition{AccessControlRule::Condition::None};
+	condition = AccessControlRule::Condition::None;
 
 	if( rule.isConditionEnabled( AccessControlRule::Condition::AuthenticationMethod ) )
 	{
@@ -370,122 +593,123 @@ bool AccessControlProvider::matchConditions( const AccessControlRule &rule,
 		}
 	}
 
-	if( rule.isConditionEnabled( AccessControlRule::Condition::MemberOfGroup ) )
+	if( rule.isConditionEnabled( AccessControlRule::Condition::AccessFromLocalHost ) )
 	{
-		condition = AccessControlRule::Condition::MemberOfGroup;
-
-		const auto condition = AccessControlRule::Condition::MemberOfGroup;
-		const auto user = lookupSubject( rule.subject( condition ), accessingUser, {}, localUser, {} );
-		const auto group = rule.argument( condition );
+		condition = AccessControlRule::Condition::AccessFromLocalHost;
 
-		if( user.isEmpty() || group.isEmpty() ||
-			isMemberOfUserGroup( user, group ) == rule.isConditionInverted(condition) )
+		if( isLocalHost( accessingComputer ) == rule.isConditionInverted(condition) )
 		{
 			return false;
 		}
 	}
 
-	if( rule.isConditionEnabled( AccessControlRule::Condition::GroupsInCommon ) )
+	if( rule.isConditionEnabled( AccessControlRule::Condition::AccessFromSameUser ) )
 	{
-		condition = AccessControlRule::Condition::GroupsInCommon;
+		condition = AccessControlRule::Condition::AccessFromSameUser;
 
-		if( accessingUser.isEmpty() || localUser.isEmpty() ||
-			haveGroupsInCommon( accessingUser, localUser ) == rule.isConditionInverted(condition) )
+		if( isLocalUser( accessingUser, localUser ) == rule.isConditionInverted(condition) )
 		{
 			return false;
 		}
 	}
 
-	if( rule.isConditionEnabled( AccessControlRule::Condition::LocatedAt ) )
+	if( rule.isConditionEnabled( AccessControlRule::Condition::AccessFromAlreadyConnectedUser ) )
 	{
-		condition = AccessControlRule::Condition::LocatedAt;
-
-		const auto computer = lookupSubject( rule.subject( condition ), {}, accessingComputer, {}, localComputer );
-		const auto location = rule.argument( condition );
+		condition = AccessControlRule::Condition::AccessFromAlreadyConnectedUser;
 
-		if( computer.isEmpty() || location.isEmpty() ||
-			isLocatedAt( computer, location ) == rule.isConditionInverted(condition) )
+		if( connectedUsers.contains( accessingUser ) == rule.isConditionInverted(condition) )
 		{
 			return false;
 		}
 	}
 
-	if( rule.isConditionEnabled( AccessControlRule::Condition::LocationsInCommon ) )
+	if( rule.isConditionEnabled( AccessControlRule::Condition::AccessedUserLoggedInLocally ) )
 	{
-		condition = AccessControlRule::Condition::LocationsInCommon;
+		condition = AccessControlRule::Condition::AccessedUserLoggedInLocally;
 
-		if( accessingComputer.isEmpty() || localComputer.isEmpty() ||
-			haveSameLocations( accessingComputer, localComputer ) == rule.isConditionInverted(condition) )
+		if( VeyonCore::platform().sessionFunctions().currentSessionIsRemote() == rule.isConditionInverted(condition) )
 		{
 			return false;
 		}
 	}
 
-	if( rule.isConditionEnabled( AccessControlRule::Condition::AccessFromLocalHost ) )
+	if( rule.isConditionEnabled( AccessControlRule::Condition::NoUserLoggedInLocally ) )
 	{
-		condition = AccessControlRule::Condition::AccessFromLocalHost;
+		condition = AccessControlRule::Condition::NoUserLoggedInLocally;
 
-		if( isLocalHost( accessingComputer ) == rule.isConditionInverted(condition) )
+		if( isNoUserLoggedInLocally() == rule.isConditionInverted(condition) )
 		{
 			return false;
 		}
 	}
 
-	if( rule.isConditionEnabled( AccessControlRule::Condition::AccessFromSameUser ) )
+	if( rule.isConditionEnabled( AccessControlRule::Condition::NoUserLoggedInRemotely ) )
 	{
-		condition = AccessControlRule::Condition::AccessFromSameUser;
+		condition = AccessControlRule::Condition::NoUserLoggedInRemotely;
 
-		if( isLocalUser( accessingUser, localUser ) == rule.isConditionInverted(condition) )
+		if( isNoUserLoggedInRemotely() == rule.isConditionInverted(condition) )
 		{
 			return false;
 		}
 	}
 
-	if( rule.isConditionEnabled( AccessControlRule::Condition::AccessFromAlreadyConnectedUser ) )
+	if( rule.isConditionEnabled( AccessControlRule::Condition::UserSession ) )
 	{
-		condition = AccessControlRule::Condition::AccessFromAlreadyConnectedUser;
+		condition = AccessControlRule::Condition::UserSession;
 
-		if( connectedUsers.contains( accessingUser ) == rule.isConditionInverted(condition) )
+		if( VeyonCore::platform().sessionFunctions().currentSessionHasUser() == rule.isConditionInverted(condition) )
 		{
 			return false;
 		}
 	}
 
-	if( rule.isConditionEnabled( AccessControlRule::Condition::AccessedUserLoggedInLocally ) )
+	// conditions requiring user group backend or network object directory queries are checked last
+	if( rule.isConditionEnabled( AccessControlRule::Condition::MemberOfGroup ) )
 	{
-		condition = AccessControlRule::Condition::AccessedUserLoggedInLocally;
+		condition = AccessControlRule::Condition::MemberOfGroup;
 
-		if( VeyonCore::platform().sessionFunctions().currentSessionIsRemote() == rule.isConditionInverted(condition) )
+		const auto condition = AccessControlRule::Condition::MemberOfGroup;
+		const auto user = lookupSubject( rule.subject( condition ), accessingUser, {}, localUser, {} );
+		const auto group = rule.argument( condition );
+
+		if( user.isEmpty() || group.isEmpty() ||
+			isMemberOfUserGroup( user, group ) == rule.isConditionInverted(condition) )
 		{
 			return false;
 		}
 	}
 
-	if( rule.isConditionEnabled( AccessControlRule::Condition::NoUserLoggedInLocally ) )
+	if( rule.isConditionEnabled( AccessControlRule::Condition::GroupsInCommon ) )
 	{
-		condition = AccessControlRule::Condition::NoUserLoggedInLocally;
+		condition = AccessControlRule::Condition::GroupsInCommon;
 
-		if( isNoUserLoggedInLocally() == rule.isConditionInverted(condition) )
+		if( accessingUser.isEmpty() || localUser.isEmpty() ||
+			haveGroupsInCommon( accessingUser, localUser ) == rule.isConditionInverted(condition) )
 		{
 			return false;
 		}
 	}
 
-	if( rule.isConditionEnabled( AccessControlRule::Condition::NoUserLoggedInRemotely ) )
+	if( rule.isConditionEnabled( AccessControlRule::Condition::LocatedAt ) )
 	{
-		condition = AccessControlRule::Condition::NoUserLoggedInRemotely;
+		condition = AccessControlRule::Condition::LocatedAt;
 
-		if( isNoUserLoggedInRemotely() == rule.isConditionInverted(condition) )
+		const auto computer = lookupSubject( rule.subject( condition ), {}, accessingComputer, {}, localComputer );
+		const auto location = rule.argument( condition );
+
+		if( computer.isEmpty() || location.isEmpty() ||
+			isLocatedAt( computer, location ) == rule.isConditionInverted(condition) )
 		{
 			return false;
 		}
 	}
 
-	if( rule.isConditionEnabled( AccessControlRule::Condition::UserSession ) )
+	if( rule.isConditionEnabled( AccessControlRule::Condition::LocationsInCommon ) )
 	{
-		condition = AccessControlRule::Condition::UserSession;
+		condition = AccessControlRule::Condition::LocationsInCommon;
 
-		if( VeyonCore::platform().sessionFunctions().currentSessionHasUser() == rule.isConditionInverted(condition) )
+		if( accessingComputer.isEmpty() || localComputer.isEmpty() ||
+			haveSameLocations( accessingComputer, localComputer ) == rule.isConditionInverted(condition) )
 		{
 			return false;
 		}
@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <QRegularExpression>
+
 #include "AccessControlRule.h"
 #include "NetworkObject.h"
 #include "Plugin.h"
@@ -40,6 +42,26 @@ public:
 		ToBeConfirmed,
 	} ;
 
+	struct RuleEvaluation
+	{
+		QString rule;
+		// condition which made the rule fail or the last one checked if it matched
+		AccessControlRule::Condition condition{AccessControlRule::Condition::None};
+		bool matched{false};
+		qint64 time{0};
+	};
+
+	// collects details about a single evaluation of all access control rules,
+	// all times are in nanoseconds
+	struct Explanation
+	{
+		QVector<RuleEvaluation> rules;
+		int groupLookups{0};
+		qint64 groupLookupTime{0};
+		int locationLookups{0};
+		qint64 locationLookupTime{0};
+	};
+
 	AccessControlProvider();
 
 	QStringList userGroups() const;
@@ -58,9 +80,38 @@ public:
 														 const QStringList& connectedUsers,
 														 Plugin::Uid authMethodUid );
 
+	// evaluates all rules without using the decision cache and records which rules
+	// were checked, how long each of them took and the time spent for lookups
+	AccessControlRule::Action explainAccessControlRules( const QString& accessingUser,
+														 const QString& accessingComputer,
+														 const QString& localUser,
+														 const QString& localComputer,
+														 const QStringList& connectedUsers,
+														 Plugin::Uid authMethodUid,
+														 Explanation& explanation );
+
 	bool isAccessToLocalComputerDenied() const;
 
+	static void clearDecisionCache();
+
+	static constexpr auto DecisionCacheTimeout = 60*1000;
+	static constexpr auto MaximumDecisionCacheSize = 1024;
+
 private:
+	AccessControlRule::Action evaluateAccessControlRules( const QString& accessingUser,
+														  const QString& accessingComputer,
+														  const QString& localUser,
+														  const QString& localComputer,
+														  const QStringList& connectedUsers,
+														  Plugin::Uid authMethodUid ) const;
+
+	bool areRulesCacheable() const;
+
+	// results of user group backend and network object directory queries are cached
+	// for the lifetime of the provider as all rules usually query the same subjects
+	QStringList groupsOfUser( const QString& user ) const;
+	QStringList cachedLocationsOfComputer( const QString& computer ) const;
+
 	bool isMemberOfUserGroup( const QString& user, const QString& groupName ) const;
 	bool isLocatedAt( const QString& computer, const QString& locationName ) const;
 	bool haveGroupsInCommon( const QString& userOne, const QString& userTwo ) const;
@@ -79,6 +130,11 @@ private:
 						  const QString& localUser, const QString& localComputer,
 						  const QStringList& connectedUsers,
 						  Plugin::Uid authMethodUid ) const;
+	bool matchConditions( const AccessControlRule& rule,
+						  const QString& accessingUser, const QString& accessingComputer,
+						  const QString& localUser, const QString& localComputer,
+						  const QStringList& connectedUsers,
+						  Plugin::Uid authMethodUid, AccessControlRule::Condition& condition ) const;
 
 	static QStringList objectNames( const NetworkObjectList& objects );
 
@@ -86,5 +142,12 @@ private:
 	UserGroupsBackendInterface* m_userGroupsBackend;
 	NetworkObjectDirectory* m_networkObjectDirectory;
 	bool m_queryDomainGroups;
+	QByteArray m_ruleSetHash;
+
+	QHash<QString, QRegularExpression> m_groupNameRegularExpressions{};
+	mutable QHash<QString, QStringList> m_groupsOfUserCache{};
+	mutable QHash<QString, QStringList> m_locationsOfComputerCache{};
+
+	Explanation* m_explanation{nullptr};
 
 } ;
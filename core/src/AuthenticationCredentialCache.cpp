@@ -0,0 +1,119 @@
+/*
+ * AuthenticationCredentialCache.cpp - implementation of AuthenticationCredentialCache class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMessageAuthenticationCode>
+#include <QMutex>
+#include <QRandomGenerator>
+
+#include "AuthenticationCredentialCache.h"
+#include "VeyonConfiguration.h"
+
+
+namespace {
+
+QMutex cacheMutex;
+QHash<QByteArray, QElapsedTimer> cache;
+
+QByteArray salt()
+{
+	static const auto salt = []() {
+		QByteArray data( 32, '\0' );
+		QRandomGenerator::system()->fillRange( reinterpret_cast<quint32 *>( data.data() ), data.size() / int(sizeof(quint32)) );
+		return data;
+	}();
+
+	return salt;
+}
+
+}
+
+
+
+bool AuthenticationCredentialCache::contains( const QString& method, const QString& username,
+											  const CryptoCore::PlaintextPassword& password )
+{
+	const auto timeout = VeyonCore::config().authenticationCacheTimeout();
+	if( timeout <= 0 )
+	{
+		return false;
+	}
+
+	const auto cacheKey = key( method, username, password );
+
+	QMutexLocker locker( &cacheMutex );
+
+	const auto it = cache.find( cacheKey );
+	if( it == cache.end() )
+	{
+		return false;
+	}
+
+	if( it->hasExpired( qint64(timeout) * 1000 ) )
+	{
+		cache.erase( it );
+		return false;
+	}
+
+	return true;
+}
+
+
+
+void AuthenticationCredentialCache::insert( const QString& method, const QString& username,
+											const CryptoCore::PlaintextPassword& password )
+{
+	if( VeyonCore::config().authenticationCacheTimeout() <= 0 )
+	{
+		return;
+	}
+
+	const auto cacheKey = key( method, username, password );
+
+	QMutexLocker locker( &cacheMutex );
+
+	if( cache.size() >= MaximumCacheSize )
+	{
+		cache.clear();
+	}
+
+	cache[cacheKey].start();
+}
+
+
+
+QByteArray AuthenticationCredentialCache::key( const QString& method, const QString& username,
+											   const CryptoCore::PlaintextPassword& password )
+{
+	QMessageAuthenticationCode code( QCryptographicHash::Sha256, salt() );
+	code.addData( method.toUtf8() );
+	code.addData( QByteArrayLiteral("\0") );
+	code.addData( username.toUtf8() );
+	code.addData( QByteArrayLiteral("\0") );
+	code.addData( password.toByteArray() );
+
+	return code.result();
+}
@@ -0,0 +1,48 @@
+/*
+ * AuthenticationCredentialCache.h - declaration of AuthenticationCredentialCache class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include "CryptoCore.h"
+
+// remembers credentials which have been verified successfully so that
+// reconnects within the configured timeout do not have to run the
+// authentication backend (PAM, LDAP bind etc.) again - only salted
+// message authentication codes of the credentials are kept in memory
+class VEYON_CORE_EXPORT AuthenticationCredentialCache
+{
+public:
+	static bool contains( const QString& method, const QString& username,
+						  const CryptoCore::PlaintextPassword& password );
+
+	static void insert( const QString& method, const QString& username,
+						const CryptoCore::PlaintextPassword& password );
+
+private:
+	static constexpr auto MaximumCacheSize = 1024;
+
+	static QByteArray key( const QString& method, const QString& username,
+						   const CryptoCore::PlaintextPassword& password );
+
+} ;
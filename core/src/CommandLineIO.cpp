@@ -161,6 +161,41 @@ void CommandLineIO::printExamples( const QString& module, const QString& command
 
 
 
+bool CommandLineIO::printRunResult( CommandLinePluginInterface::RunResult runResult, const QString& module )
+{
+	switch( runResult )
+	{
+	case CommandLinePluginInterface::NoResult:
+		return true;
+	case CommandLinePluginInterface::Successful:
+		print( VeyonCore::tr( "[OK]" ) );
+		return true;
+	case CommandLinePluginInterface::Failed:
+		print( VeyonCore::tr( "[FAIL]" ) );
+		return true;
+	case CommandLinePluginInterface::InvalidCommand:
+		error( VeyonCore::tr( "Invalid command!" ) );
+		return false;
+	case CommandLinePluginInterface::InvalidArguments:
+		error( VeyonCore::tr( "Invalid arguments given" ) );
+		return true;
+	case CommandLinePluginInterface::NotEnoughArguments:
+		error( VeyonCore::tr( "Not enough arguments given - "
+							  "use \"%1 help\" for more information" ).arg( module ) );
+		return true;
+	case CommandLinePluginInterface::NotLicensed:
+		error( VeyonCore::tr( "Plugin not licensed" ) );
+		return true;
+	case CommandLinePluginInterface::Unknown:
+		return false;
+	default:
+		error( VeyonCore::tr( "Unknown result!" ) );
+		return true;
+	}
+}
+
+
+
 void CommandLineIO::printTableRuler( const CommandLineIO::TableColumnWidths& columnWidths, char horizontal, char corner )
 {
 	putc( corner, stdout );
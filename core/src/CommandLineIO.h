@@ -24,7 +24,7 @@
 
 #pragma once
 
-#include "VeyonCore.h"
+#include "CommandLinePluginInterface.h"
 
 // clazy:excludeall=rule-of-three
 
@@ -52,6 +52,7 @@ public:
 							const Arguments& mandatoryArguments, const Arguments& optionalArguments = {} );
 	static void printDescription( const QString& description );
 	static void printExamples( const QString& module, const QString& command, const Examples& examples );
+	static bool printRunResult( CommandLinePluginInterface::RunResult runResult, const QString& module );
 
 private:
 	static void printTableRuler( const TableColumnWidths& columnWidths, char horizontal, char corner );
@@ -26,6 +26,7 @@
 #include "ComputerControlInterface.h"
 #include "Computer.h"
 #include "FeatureManager.h"
+#include "Metrics.h"
 #include "MonitoringMode.h"
 #include "VeyonConfiguration.h"
 #include "VeyonConnection.h"
@@ -39,22 +40,27 @@ ComputerControlInterface::ComputerControlInterface( const Computer& computer, in
 {
 	m_pingTimer.setInterval(ConnectionWatchdogPingDelay);
 	m_pingTimer.setSingleShot(true);
-	connect(&m_pingTimer, &QTimer::timeout, this, &ComputerControlInterface::ping);
+	connect(&m_pingTimer, &WheelTimer::timeout, this, &ComputerControlInterface::ping);
 
-	m_connectionWatchdogTimer.setInterval( ConnectionWatchdogTimeout );
+	m_connectionWatchdogTimer.setInterval( VeyonCore::config().computerConnectionWatchdogTimeout() );
 	m_connectionWatchdogTimer.setSingleShot( true );
-	connect( &m_connectionWatchdogTimer, &QTimer::timeout, this, &ComputerControlInterface::restartConnection );
+	connect( &m_connectionWatchdogTimer, &WheelTimer::timeout, this, &ComputerControlInterface::handleWatchdogTimeout );
 
 	m_serverVersionQueryTimer.setInterval(ServerVersionQueryTimeout);
 	m_serverVersionQueryTimer.setSingleShot(true);
-	connect( &m_serverVersionQueryTimer, &QTimer::timeout, this, [this]() {
+	connect( &m_serverVersionQueryTimer, &WheelTimer::timeout, this, [this]() {
 		setServerVersion(VeyonCore::ApplicationVersion::Unknown);
 	});
 
-	connect(&m_statePollingTimer, &QTimer::timeout, this, [this]() {
+	connect(&m_statePollingTimer, &WheelTimer::timeout, this, [this]() {
 		updateUser();
 		updateActiveFeatures();
 	});
+
+	if( VeyonCore::config().thumbnailHistoryInterval() > 0 )
+	{
+		m_thumbnailHistory = new ThumbnailHistory( this );
+	}
 }
 
 
@@ -83,16 +89,22 @@ void ComputerControlInterface::start( QSize scaledFramebufferSize, UpdateMode up
 		{
 			vncConnection->setPort( m_port );
 		}
-		vncConnection->setQuality(VeyonCore::config().computerMonitoringImageQuality());
+		vncConnection->setAllowReducedColors(VeyonCore::config().computerMonitoringReducedColors());
+		vncConnection->setScalingMode(VeyonCore::config().computerMonitoringScalingMode());
 		vncConnection->setScaledSize( m_scaledFramebufferSize );
 
 		connect( vncConnection, &VncConnection::imageUpdated, this, [this]( int x, int y, int w, int h )
 		{
+			m_updatedFramebufferArea += qint64(w) * h;
 			Q_EMIT framebufferUpdated( QRect( x, y, w, h ) );
 		} );
-		connect( vncConnection, &VncConnection::framebufferUpdateComplete, this, [this]() {
-			resetWatchdog();
+		connect( vncConnection, &VncConnection::framebufferUpdateComplete, this, &ComputerControlInterface::resetWatchdog );
+		connect( vncConnection, &VncConnection::scaledFramebufferUpdated, this, [this]() {
 			++m_timestamp;
+			if( m_thumbnailHistory )
+			{
+				m_thumbnailHistory->add( scaledFramebuffer() );
+			}
 			Q_EMIT scaledFramebufferUpdated();
 		} );
 
@@ -128,6 +140,7 @@ void ComputerControlInterface::stop()
 	}
 
 	m_pingTimer.stop();
+	m_pingResponseTimer.invalidate();
 	m_connectionWatchdogTimer.stop();
 
 	m_state = State::Disconnected;
@@ -156,6 +169,11 @@ QSize ComputerControlInterface::screenSize() const
 
 void ComputerControlInterface::setScaledFramebufferSize( QSize scaledFramebufferSize )
 {
+	if( scaledFramebufferSize == m_scaledFramebufferSize )
+	{
+		return;
+	}
+
 	m_scaledFramebufferSize = scaledFramebufferSize;
 
 	if( vncConnection() )
@@ -246,12 +264,26 @@ void ComputerControlInterface::setScreens(const ScreenList& screens)
 	{
 		m_screens = screens;
 
+		updateFramebufferUpdateRegion();
+
 		Q_EMIT screensChanged();
 	}
 }
 
 
 
+void ComputerControlInterface::setMonitoredScreen( int index )
+{
+	if( index != m_monitoredScreen )
+	{
+		m_monitoredScreen = index;
+
+		updateFramebufferUpdateRegion();
+	}
+}
+
+
+
 void ComputerControlInterface::setActiveFeatures( const FeatureUidList& activeFeatures )
 {
 	if( activeFeatures != m_activeFeatures )
@@ -264,12 +296,15 @@ void ComputerControlInterface::setActiveFeatures( const FeatureUidList& activeFe
 
 
 
-void ComputerControlInterface::sendFeatureMessage(const FeatureMessage& featureMessage)
+bool ComputerControlInterface::sendFeatureMessage(const FeatureMessage& featureMessage,
+												  const QByteArray& serializedMessage)
 {
 	if( m_connection && m_connection->isConnected() )
 	{
-		m_connection->sendFeatureMessage(featureMessage);
+		return m_connection->sendFeatureMessage(featureMessage, serializedMessage);
 	}
+
+	return false;
 }
 
 
@@ -286,6 +321,18 @@ bool ComputerControlInterface::isMessageQueueEmpty()
 
 
 
+int ComputerControlInterface::messageQueueSize()
+{
+	if( vncConnection() && vncConnection()->isConnected() )
+	{
+		return vncConnection()->eventQueueSize();
+	}
+
+	return 0;
+}
+
+
+
 void ComputerControlInterface::setUpdateMode( UpdateMode updateMode )
 {
 	m_updateMode = updateMode;
@@ -294,12 +341,137 @@ void ComputerControlInterface::setUpdateMode( UpdateMode updateMode )
 
 	if (vncConnection())
 	{
+		vncConnection()->setQuality(imageQuality());
 		vncConnection()->setSkipHostPing(m_updateMode == UpdateMode::Basic);
+		vncConnection()->setReducedColors(m_updateMode == UpdateMode::Monitoring);
+		vncConnection()->setLowLatency(m_updateMode == UpdateMode::Live &&
+									   VeyonCore::config().lowLatencyRemoteAccess());
+
+		// user explicitly opened computer so do not wait for backed off connection retries
+		if (m_updateMode == UpdateMode::Live)
+		{
+			vncConnection()->resetConnectionRetryInterval();
+		}
+	}
+
+	updateServerSideScaling();
+	updateFramebufferUpdateRegion();
+}
+
+
+
+VncConnectionConfiguration::Quality ComputerControlInterface::imageQuality() const
+{
+	if( VeyonCore::config().lowBandwidthLocations().contains( m_computer.location() ) )
+	{
+		return VeyonCore::config().lowBandwidthImageQuality();
+	}
+
+	// remote access keeps following the monitoring quality unless configured explicitly
+	if( m_updateMode == UpdateMode::Live &&
+		VeyonCore::config().hasValue( QStringLiteral("RemoteAccessImageQuality"), QStringLiteral("Master") ) )
+	{
+		return VeyonCore::config().remoteAccessImageQuality();
+	}
+
+	return VeyonCore::config().computerMonitoringImageQuality();
+}
+
+
+
+void ComputerControlInterface::setServerSideScaling( bool enabled )
+{
+	if( enabled != m_serverSideScaling )
+	{
+		m_serverSideScaling = enabled;
+		updateServerSideScaling();
+	}
+}
+
+
+
+void ComputerControlInterface::updateServerSideScaling()
+{
+	// full resolution is restored as soon as the computer is shown in any other mode
+	if( vncConnection() )
+	{
+		vncConnection()->setServerSideScaling( m_updateMode == UpdateMode::Monitoring &&
+											   ( m_serverSideScaling || VeyonCore::config().serverSideThumbnailScaling() ) );
+	}
+}
+
+
+
+void ComputerControlInterface::updateFramebufferUpdateRegion()
+{
+	// leave regions set by other users of the connection (e.g. demo clients) alone
+	if( vncConnection() == nullptr ||
+		( m_monitoredScreen < 0 && m_framebufferUpdateRegionRestricted == false ) )
+	{
+		return;
+	}
+
+	// any other mode shows the whole desktop
+	QRect region;
+	if( ( m_updateMode == UpdateMode::Monitoring || m_updateMode == UpdateMode::Basic ) &&
+		m_monitoredScreen >= 0 && m_monitoredScreen < m_screens.size() )
+	{
+		// screen geometries are relative to the primary screen and in device-independent pixels
+		// while the framebuffer starts at the top left corner of the virtual desktop
+		QPoint minimumScreenPosition{};
+		for( const auto& screen : qAsConst(m_screens) )
+		{
+			minimumScreenPosition.setX( qMin( minimumScreenPosition.x(), screen.geometry.x() ) );
+			minimumScreenPosition.setY( qMin( minimumScreenPosition.y(), screen.geometry.y() ) );
+		}
+
+		const auto& screen = m_screens[m_monitoredScreen];
+		const auto geometry = screen.geometry.translated( -minimumScreenPosition );
+		const auto ratio = qMax<qreal>( 1, screen.devicePixelRatio );
+		region = QRect( qRound( geometry.x() * ratio ), qRound( geometry.y() * ratio ),
+						qRound( geometry.width() * ratio ), qRound( geometry.height() * ratio ) );
+	}
+
+	m_framebufferUpdateRegionRestricted = region.isEmpty() == false;
+	vncConnection()->setFramebufferUpdateRegion( region );
+}
+
+
+
+void ComputerControlInterface::setMonitoringUpdateInterval( int interval )
+{
+	if( interval != m_monitoringUpdateInterval )
+	{
+		m_monitoringUpdateInterval = interval;
+
+		if( m_updateMode == UpdateMode::Monitoring )
+		{
+			setMinimumFramebufferUpdateInterval();
+		}
 	}
 }
 
 
 
+int ComputerControlInterface::takeFramebufferActivity()
+{
+	const auto size = screenSize();
+	const auto screenArea = qint64(size.width()) * size.height();
+
+	const auto updatedArea = m_updatedFramebufferArea;
+	m_updatedFramebufferArea = 0;
+
+	if( screenArea <= 0 || updatedArea <= 0 )
+	{
+		return 0;
+	}
+
+	// report any update as activity, even if it covers less than one percent
+	return int( qBound<qint64>( 1, updatedArea * 100 / screenArea, 100 ) );
+}
+
+
+
 ComputerControlInterface::Pointer ComputerControlInterface::weakPointer()
 {
 	return Pointer( this, []( ComputerControlInterface* ) { } );
@@ -312,6 +484,7 @@ void ComputerControlInterface::ping()
 	if (m_serverVersion >= VeyonCore::ApplicationVersion::Version_4_7)
 	{
 		VeyonCore::builtinFeatures().monitoringMode().ping({weakPointer()});
+		m_pingResponseTimer.start();
 	}
 }
 
@@ -328,10 +501,14 @@ void ComputerControlInterface::setMinimumFramebufferUpdateInterval()
 		break;
 
 	case UpdateMode::Basic:
-	case UpdateMode::Monitoring:
 		updateInterval = VeyonCore::config().computerMonitoringUpdateInterval();
 		break;
 
+	case UpdateMode::Monitoring:
+		updateInterval = m_monitoringUpdateInterval > 0 ? m_monitoringUpdateInterval
+														: VeyonCore::config().computerMonitoringUpdateInterval();
+		break;
+
 	case UpdateMode::Live:
 		break;
 	}
@@ -353,6 +530,13 @@ void ComputerControlInterface::resetWatchdog()
 {
 	if( state() == State::Connected )
 	{
+		if( m_pingResponseTimer.isValid() )
+		{
+			updateResponseTime( m_pingResponseTimer.elapsed() );
+			m_pingResponseTimer.invalidate();
+		}
+
+		m_lastActivityTimer.start();
 		m_pingTimer.start();
 		m_connectionWatchdogTimer.start();
 	}
@@ -360,6 +544,54 @@ void ComputerControlInterface::resetWatchdog()
 
 
 
+void ComputerControlInterface::handleWatchdogTimeout()
+{
+	// on a busy master messages may already be waiting in the event queue
+	// so process them first before considering the connection to be stale
+	QTimer::singleShot( 0, this, [this]() {
+		if( m_lastActivityTimer.isValid() &&
+			m_lastActivityTimer.elapsed() < m_connectionWatchdogTimer.interval() )
+		{
+			return;
+		}
+
+		vDebug() << "no response within" << m_connectionWatchdogTimer.interval() << "ms"
+				 << "- smoothed response time:" << smoothedResponseTime() << "ms";
+		Metrics::increment( "veyon_connection_watchdog_restarts_total" );
+
+		restartConnection();
+	} );
+}
+
+
+
+void ComputerControlInterface::updateResponseTime( qint64 responseTime )
+{
+	// estimate mean and deviation similar to the TCP retransmission timeout (RFC 6298)
+	if( m_smoothedResponseTime <= 0 )
+	{
+		m_smoothedResponseTime = double(responseTime);
+		m_responseTimeDeviation = double(responseTime) / 2;
+	}
+	else
+	{
+		m_responseTimeDeviation = 0.75 * m_responseTimeDeviation + 0.25 * qAbs( m_smoothedResponseTime - double(responseTime) );
+		m_smoothedResponseTime = 0.875 * m_smoothedResponseTime + 0.125 * double(responseTime);
+	}
+
+	Metrics::observe( "veyon_connection_response_time_seconds", double(responseTime) / 1000 );
+
+	// the watchdog covers the ping delay plus the time a response can be expected in
+	const auto expectedResponseTime = m_smoothedResponseTime + ResponseTimeDeviationFactor * m_responseTimeDeviation;
+	const auto minimumTimeout = VeyonCore::config().computerConnectionWatchdogTimeout();
+
+	m_connectionWatchdogTimer.setInterval( qBound( minimumTimeout,
+												   ConnectionWatchdogPingDelay + int(ResponseTimeSafetyFactor * expectedResponseTime),
+												   qMax( minimumTimeout, int(MaximumConnectionWatchdogTimeout) ) ) );
+}
+
+
+
 void ComputerControlInterface::restartConnection()
 {
 	if( vncConnection() )
@@ -24,9 +24,13 @@
 
 #pragma once
 
+#include <QElapsedTimer>
+
 #include "Computer.h"
 #include "Feature.h"
 #include "Lockable.h"
+#include "ThumbnailHistory.h"
+#include "TimerWheel.h"
 #include "VeyonCore.h"
 #include "VeyonConnection.h"
 
@@ -49,11 +53,13 @@ public:
 		int index;
 		QString name;
 		QRect geometry;
+		qreal devicePixelRatio{1};
 		bool operator==(const ScreenProperties& other) const
 		{
 			return other.index == index &&
 				   other.name == name &&
-				   other.geometry == geometry;
+				   other.geometry == geometry &&
+				   qFuzzyCompare(other.devicePixelRatio, devicePixelRatio);
 		}
 	};
 	using ScreenList = QList<ScreenProperties>;
@@ -135,6 +141,20 @@ public:
 
 	void setScreens(const ScreenList& screens);
 
+	// recent thumbnails if enabled in the configuration, nullptr otherwise
+	const ThumbnailHistory* thumbnailHistory() const
+	{
+		return m_thumbnailHistory;
+	}
+
+	// restricts monitoring to the screen with the given index so that the server only
+	// sends and the master only scales this part of the framebuffer, -1 for all screens
+	void setMonitoredScreen( int index );
+	int monitoredScreen() const
+	{
+		return m_monitoredScreen;
+	}
+
 	const FeatureUidList& activeFeatures() const
 	{
 		return m_activeFeatures;
@@ -162,8 +182,9 @@ public:
 		m_groups = groups;
 	}
 
-	void sendFeatureMessage(const FeatureMessage& featureMessage);
+	bool sendFeatureMessage(const FeatureMessage& featureMessage, const QByteArray& serializedMessage = {});
 	bool isMessageQueueEmpty();
+	int messageQueueSize();
 
 	void setUpdateMode( UpdateMode updateMode );
 	UpdateMode updateMode() const
@@ -171,12 +192,41 @@ public:
 		return m_updateMode;
 	}
 
+	// lets the server downscale the framebuffer in monitoring mode regardless of the configuration
+	void setServerSideScaling( bool enabled );
+
+	// overrides the configured update interval in monitoring mode, <= 0 resets to default
+	void setMonitoringUpdateInterval( int interval );
+	int monitoringUpdateInterval() const
+	{
+		return m_monitoringUpdateInterval;
+	}
+
+	// returns percentage of the screen area updated since the last call (capped at 100)
+	int takeFramebufferActivity();
+
+	// smoothed time between sending a ping and receiving the next message in milliseconds
+	int smoothedResponseTime() const
+	{
+		return int(m_smoothedResponseTime);
+	}
+
+	int connectionWatchdogTimeout() const
+	{
+		return m_connectionWatchdogTimer.interval();
+	}
+
 	Pointer weakPointer();
 
 private:
 	void ping();
 	void setMinimumFramebufferUpdateInterval();
+	VncConnectionConfiguration::Quality imageQuality() const;
+	void updateServerSideScaling();
+	void updateFramebufferUpdateRegion();
 	void resetWatchdog();
+	void handleWatchdogTimeout();
+	void updateResponseTime( qint64 responseTime );
 	void restartConnection();
 
 	void updateState();
@@ -188,7 +238,9 @@ private:
 	void handleFeatureMessage( const FeatureMessage& message );
 
 	static constexpr int ConnectionWatchdogPingDelay = 10000;
-	static constexpr int ConnectionWatchdogTimeout = ConnectionWatchdogPingDelay*2;
+	static constexpr int MaximumConnectionWatchdogTimeout = 120000;
+	static constexpr int ResponseTimeDeviationFactor = 4;
+	static constexpr int ResponseTimeSafetyFactor = 2;
 	static constexpr int ServerVersionQueryTimeout = 5000;
 	static constexpr int UpdateIntervalDisabled = 5000;
 
@@ -196,26 +248,36 @@ private:
 	const int m_port;
 
 	UpdateMode m_updateMode{UpdateMode::Disabled};
+	bool m_serverSideScaling{false};
+	int m_monitoringUpdateInterval{-1};
+	qint64 m_updatedFramebufferArea{0};
 
 	State m_state{State::Disconnected};
 	QString m_userLoginName{};
 	QString m_userFullName{};
 	int m_userSessionId{0};
 	ScreenList m_screens;
+	int m_monitoredScreen{-1};
+	bool m_framebufferUpdateRegionRestricted{false};
 	FeatureUidList m_activeFeatures;
 	Feature::Uid m_designatedModeFeature;
 
 	QSize m_scaledFramebufferSize{};
 	int m_timestamp{0};
+	ThumbnailHistory* m_thumbnailHistory{nullptr};
 
 	VeyonConnection* m_connection{nullptr};
-	QTimer m_pingTimer{this};
-	QTimer m_connectionWatchdogTimer{this};
+	WheelTimer m_pingTimer{this};
+	WheelTimer m_connectionWatchdogTimer{this};
+	QElapsedTimer m_lastActivityTimer{};
+	QElapsedTimer m_pingResponseTimer{};
+	double m_smoothedResponseTime{0};
+	double m_responseTimeDeviation{0};
 
 	VeyonCore::ApplicationVersion m_serverVersion{VeyonCore::ApplicationVersion::Unknown};
-	QTimer m_serverVersionQueryTimer{this};
+	WheelTimer m_serverVersionQueryTimer{this};
 
-	QTimer m_statePollingTimer{this};
+	WheelTimer m_statePollingTimer{this};
 
 	QStringList m_groups;
 
@@ -26,6 +26,7 @@
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QSaveFile>
 
 #include "Configuration/JsonStore.h"
 #include "Configuration/Object.h"
@@ -85,7 +86,13 @@ void JsonStore::load( Object* obj )
 		return;
 	}
 
-	QJsonDocument jsonDoc = QJsonDocument::fromJson( jsonFile.readAll() );
+	// parse directly from the mapped file instead of copying its content into memory first
+	const auto size = jsonFile.size();
+	const auto data = size > 0 ? jsonFile.map( 0, size ) : nullptr;
+
+	const auto jsonDoc = data ? QJsonDocument::fromJson( QByteArray::fromRawData( reinterpret_cast<const char *>( data ),
+																				  int( size ) ) )
+							  : QJsonDocument::fromJson( jsonFile.readAll() );
 
 	loadJsonTree( obj, jsonDoc.object(), {} );
 }
@@ -131,14 +138,36 @@ static QJsonObject saveJsonTree( const Object::DataMap& dataMap )
 
 void JsonStore::flush( const Object* obj )
 {
-	QFile outfile( configurationFilePath() );
-	if( !outfile.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+	if( writeFile( configurationFilePath(), toJson( obj->data() ) ) == false )
 	{
 		vCritical() << "could not write to configuration file" << configurationFilePath();
-		return;
 	}
+}
+
+
+
+QByteArray JsonStore::toJson( const Object::DataMap& data )
+{
+	return QJsonDocument( saveJsonTree( data ) ).toJson();
+}
+
+
+
+bool JsonStore::writeFile( const QString& filePath, const QByteArray& data )
+{
+	// write the file atomically so readers never see partially written configurations
+	// and leave it untouched if the content did not change
+	QFile infile( filePath );
+	if( infile.size() == data.size() && infile.open( QFile::ReadOnly ) && infile.readAll() == data )
+	{
+		return true;
+	}
+	infile.close();
 
-	outfile.write( QJsonDocument( saveJsonTree( obj->data() ) ).toJson() );
+	QSaveFile outfile( filePath );
+	return outfile.open( QIODevice::WriteOnly ) &&
+		   outfile.write( data ) == data.size() &&
+		   outfile.commit();
 }
 
 
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "Configuration/Object.h"
 #include "Configuration/Store.h"
 
 namespace Configuration
@@ -41,9 +42,14 @@ public:
 	bool isWritable() const override;
 	void clear() override;
 
-private:
 	QString configurationFilePath() const;
 
+	// helpers which do not access any store or object and therefore can be used from other threads
+	static QByteArray toJson( const Object::DataMap& data );
+	static bool writeFile( const QString& filePath, const QByteArray& data );
+
+private:
+
 	QString m_file;
 
 } ;
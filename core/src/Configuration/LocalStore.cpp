@@ -57,12 +57,18 @@ static void loadSettingsTree( Object *obj, QSettings *s,
 		s->endGroup();
 	}
 
+	static const QRegularExpression jsonValueRX{ QStringLiteral("^@JsonValue(\\(.*\\))$") };
+
 	const auto childKeys = s->childKeys();
 
 	for( const auto& k : childKeys )
 	{
-		const auto stringValue = s->value( k ).toString();
-		const auto jsonValueMatch = QRegularExpression( QStringLiteral("^@JsonValue(\\(.*\\))$") ).match( stringValue );
+		const auto value = s->value( k );
+
+		// only run the regular expression on values which actually look like serialized JSON values
+		const auto isJsonValue = value.userType() == QMetaType::QString &&
+											 value.toString().startsWith( QLatin1String("@JsonValue(") );
+		const auto jsonValueMatch = isJsonValue ? jsonValueRX.match( value.toString() ) : QRegularExpressionMatch{};
 
 		if( jsonValueMatch.hasMatch() )
 		{
@@ -82,7 +88,7 @@ static void loadSettingsTree( Object *obj, QSettings *s,
 		}
 		else
 		{
-			obj->setValue( k, s->value( k ), parentKey );
+			obj->setValue( k, value, parentKey );
 		}
 	}
 }
@@ -66,6 +66,62 @@ Object::~Object()
 
 
 
+void Object::reloadFromStore()
+{
+	if( m_store == nullptr )
+	{
+		return;
+	}
+
+	// load into a separate object so only values which actually changed are announced
+	Object storedObject;
+	m_store->load( &storedObject );
+
+	QVector<QPair<QString, QString>> changedKeys;
+	collectChangedKeys( m_data, storedObject.data(), {}, changedKeys );
+
+	if( changedKeys.isEmpty() )
+	{
+		return;
+	}
+
+	setData( storedObject.data() );
+
+	for( const auto& changedKey : qAsConst(changedKeys) )
+	{
+		Q_EMIT valueChanged( changedKey.first, changedKey.second );
+	}
+
+	Q_EMIT configurationChanged();
+}
+
+
+
+void Object::collectChangedKeys( const DataMap& oldData, const DataMap& newData, const QString& parentKey,
+								 QVector<QPair<QString, QString>>& changedKeys )
+{
+	auto keys = oldData.keys() + newData.keys();
+	keys.removeDuplicates();
+
+	for( const auto& key : qAsConst(keys) )
+	{
+		const auto oldValue = oldData.value( key );
+		const auto newValue = newData.value( key );
+
+		if( oldValue.type() == QVariant::Map || newValue.type() == QVariant::Map )
+		{
+			const auto subParentKey = parentKey + ( parentKey.isEmpty() ? QString() : QStringLiteral("/") ) + key;
+			collectChangedKeys( oldValue.toMap(), newValue.toMap(), subParentKey, changedKeys );
+		}
+		else if( oldValue != newValue )
+		{
+			changedKeys.append( { key, parentKey } );
+		}
+	}
+}
+
+
+
 Object& Object::operator=( const Object& ref )
 {
 	if( &ref == this )
@@ -85,7 +141,7 @@ Object& Object::operator=( const Object& ref )
 		m_store = createStore( backend, scope );
 	}
 
-	m_data = ref.data();
+	setData( ref.data() );
 
 	return *this;
 }
@@ -113,7 +169,7 @@ static Object::DataMap operator+( Object::DataMap dst, Object::DataMap src )
 
 Object& Object::operator+=( const Object& ref )
 {
-	m_data = m_data + ref.data();
+	setData( m_data + ref.data() );
 
 	return *this;
 }
@@ -122,74 +178,14 @@ Object& Object::operator+=( const Object& ref )
 
 bool Object::hasValue( const QString& key, const QString& parentKey ) const
 {
-	// empty parentKey?
-	if( parentKey.isEmpty() )
-	{
-		// search for key in toplevel data map
-		return m_data.contains( key );
-	}
-
-	// recursively search through data maps and sub data-maps until
-	// all levels of the parentKey are processed
-	const QStringList subLevels = parentKey.split( QLatin1Char('/') );
-	DataMap currentMap = m_data;
-
-	for( const auto& level : subLevels )
-	{
-		if( currentMap.contains( level ) &&
-				currentMap[level].type() == QVariant::Map )
-		{
-			currentMap = currentMap[level].toMap();
-		}
-		else
-		{
-			return false;
-		}
-	}
-
-	// ok, we're there - does the current submap then contain our key?
-	return currentMap.contains( key );
+	return m_index.contains( absoluteKey( key, parentKey ) );
 }
 
 
 
-
 QVariant Object::value( const QString& key, const QString& parentKey, const QVariant& defaultValue ) const
 {
-	// empty parentKey?
-	if( parentKey.isEmpty() )
-	{
-		// search for key in toplevel data map
-		if( m_data.contains( key ) )
-		{
-			return m_data[key];
-		}
-		return defaultValue;
-	}
-
-	// recursively search through data maps and sub data-maps until
-	// all levels of the parentKey are processed
-	const QStringList subLevels = parentKey.split( QLatin1Char('/') );
-	DataMap currentMap = m_data;
-	for( const auto& level : subLevels )
-	{
-		if( currentMap.contains( level ) &&
-				currentMap[level].type() == QVariant::Map )
-		{
-			currentMap = currentMap[level].toMap();
-		}
-		else
-		{
-			return defaultValue;
-		}
-	}
-
-	// ok, we're there - does the current submap then contain our key?
-	if( currentMap.contains( key ) )
-	{
-		return currentMap[key];
-	}
-	return defaultValue;
+	return m_index.value( absoluteKey( key, parentKey ), defaultValue );
 }
 
 
@@ -247,6 +243,8 @@ void Object::setValue( const QString& key, const QVariant& value, const QString&
 	if( data != m_data )
 	{
 		m_data = data;
+		updateIndex( key, parentKey );
+		Q_EMIT valueChanged( key, parentKey );
 		Q_EMIT configurationChanged();
 	}
 }
@@ -289,6 +287,8 @@ void Object::removeValue( const QString& key, const QString& parentKey )
 	if( data != m_data )
 	{
 		m_data = data;
+		updateIndex( key, parentKey );
+		Q_EMIT valueChanged( key, parentKey );
 		Q_EMIT configurationChanged();
 	}
 }
@@ -327,6 +327,74 @@ void Object::addSubObject( Object* obj, const QString& parentKey )
 
 
 
+void Object::setData( const DataMap& data )
+{
+	m_data = data;
+
+	ValueIndex index;
+	index.reserve( m_index.size() );
+	buildIndex( m_data, {}, index );
+	m_index.swap( index );
+}
+
+
+
+void Object::updateIndex( const QString& key, const QString& parentKey )
+{
+	// sub data maps of all parent levels are indexed as well and have to be refreshed
+	DataMap data = m_data;
+	QString levelKey;
+	const auto levels = parentKey.split( QLatin1Char('/') );
+	for( const auto& level : levels )
+	{
+		levelKey = absoluteKey( level, levelKey );
+		const auto levelData = data.value( level );
+		m_index.insert( levelKey, levelData );
+		data = levelData.toMap();
+	}
+
+	const auto changedKey = absoluteKey( key, parentKey );
+	if( data.contains( key ) )
+	{
+		m_index.insert( changedKey, data.value( key ) );
+		return;
+	}
+
+	// value or whole sub data map has been removed
+	m_index.remove( changedKey );
+
+	const auto subKeyPrefix = changedKey + QLatin1Char('/');
+	for( auto it = m_index.begin(); it != m_index.end(); )
+	{
+		if( it.key().startsWith( subKeyPrefix ) )
+		{
+			it = m_index.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+
+
+void Object::buildIndex( const DataMap& data, const QString& parentKey, ValueIndex& index )
+{
+	for( auto it = data.begin(), end = data.end(); it != end; ++it )
+	{
+		const auto key = absoluteKey( it.key(), parentKey );
+		index.insert( key, it.value() );
+
+		if( it.value().type() == QVariant::Map )
+		{
+			buildIndex( it.value().toMap(), key, index );
+		}
+	}
+}
+
+
+
 Store* Object::createStore( Store::Backend backend, Store::Scope scope )
 {
 	switch( backend )
@@ -37,6 +37,7 @@ class VEYON_CORE_EXPORT Object : public QObject
 	Q_OBJECT
 public:
 	using DataMap = QMap<QString, QVariant>;
+	using ValueIndex = QHash<QString, QVariant>;
 
 	Object() = default;
 	Object( Store::Backend backend, Store::Scope scope, const QString& storeName = {} );
@@ -51,19 +52,29 @@ public:
 
 	QVariant value( const QString& key, const QString& parentKey, const QVariant& defaultValue ) const;
 
+	// looks up a value by its precomputed absolute key (see absoluteKey()) without any allocations
+	QVariant value( const QString& absoluteKey, const QVariant& defaultValue ) const
+	{
+		return m_index.value( absoluteKey, defaultValue );
+	}
+
+	static QString absoluteKey( const QString& key, const QString& parentKey )
+	{
+		if( parentKey.isEmpty() )
+		{
+			return key;
+		}
+
+		return parentKey + QLatin1Char('/') + key;
+	}
+
 	void setValue( const QString& key, const QVariant& value, const QString& parentKey );
 
 	void removeValue( const QString& key, const QString& parentKey );
 
 	void addSubObject( Object* obj, const QString& parentKey );
 
-	void reloadFromStore()
-	{
-		if( m_store )
-		{
-			m_store->load( this );
-		}
-	}
+	void reloadFromStore();
 
 	void flushStore()
 	{
@@ -81,6 +92,7 @@ public:
 	void clear()
 	{
 		m_data.clear();
+		m_index.clear();
 	}
 
 	const DataMap & data() const
@@ -88,18 +100,36 @@ public:
 		return m_data;
 	}
 
+	// returns pairs of key and parent key for all values which differ in the other object
+	QVector<QPair<QString, QString>> changedKeys( const Object& other ) const
+	{
+		QVector<QPair<QString, QString>> keys;
+		collectChangedKeys( m_data, other.data(), {}, keys );
+		return keys;
+	}
+
 
 Q_SIGNALS:
 	void configurationChanged();
+	void valueChanged( const QString& key, const QString& parentKey );
 
 
 private:
 	static Store* createStore( Store::Backend backend, Store::Scope scope );
+	void setData( const DataMap& data );
+	void updateIndex( const QString& key, const QString& parentKey );
+	static void buildIndex( const DataMap& data, const QString& parentKey, ValueIndex& index );
+	static void collectChangedKeys( const DataMap& oldData, const DataMap& newData, const QString& parentKey,
+									QVector<QPair<QString, QString>>& changedKeys );
 
 	Configuration::Store* m_store{nullptr};
 	bool m_customStore{false};
 	DataMap m_data{};
 
+	// flat copy of all values and sub data maps in m_data by absolute key so
+	// frequently read properties don't have to walk through nested data maps
+	ValueIndex m_index{};
+
 } ;
 
 }
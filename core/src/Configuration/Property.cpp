@@ -37,9 +37,11 @@ Configuration::Property::Property( Object* object, const QString& key, const QSt
 	m_proxy( nullptr ),
 	m_key( key ),
 	m_parentKey( parentKey ),
+	m_absoluteKey( Object::absoluteKey( key, parentKey ) ),
 	m_defaultValue( defaultValue ),
 	m_flags( flags )
 {
+	connect( object, &Object::valueChanged, this, &Property::handleValueChange );
 }
 
 
@@ -51,9 +53,11 @@ Configuration::Property::Property( Proxy* proxy, const QString& key, const QStri
 	m_proxy( proxy ),
 	m_key( key ),
 	m_parentKey( parentKey ),
+	m_absoluteKey( Object::absoluteKey( key, parentKey ) ),
 	m_defaultValue( defaultValue ),
 	m_flags( flags )
 {
+	connect( proxy->configurationObject(), &Object::valueChanged, this, &Property::handleValueChange );
 }
 
 
@@ -74,7 +78,7 @@ QVariant Property::variantValue() const
 {
 	if( m_object )
 	{
-		return m_object->value( m_key, m_parentKey, m_defaultValue );
+		return m_object->value( m_absoluteKey, m_defaultValue );
 	}
 
 	if( m_proxy )
@@ -105,6 +109,17 @@ void Property::setVariantValue( const QVariant& value ) const
 
 
 
+void Property::handleValueChange( const QString& key, const QString& parentKey )
+{
+	if( key == m_key &&
+		parentKey == ( m_proxy ? m_proxy->instanceParentKey( m_parentKey ) : m_parentKey ) )
+	{
+		Q_EMIT valueChanged();
+	}
+}
+
+
+
 Property* Property::find( QObject* parent, const QString& key, const QString& parentKey )
 {
 	const auto properties = parent->findChildren<Property *>();
@@ -96,14 +96,9 @@ public:
 		return m_parentKey;
 	}
 
-	QString absoluteKey() const
+	const QString& absoluteKey() const
 	{
-		if( m_parentKey.isEmpty() )
-		{
-			return m_key;
-		}
-
-		return m_parentKey + QLatin1Char('/') + m_key;
+		return m_absoluteKey;
 	}
 
 	const QVariant& defaultValue() const
@@ -116,11 +111,17 @@ public:
 		return m_flags;
 	}
 
+Q_SIGNALS:
+	void valueChanged();
+
 private:
+	void handleValueChange( const QString& key, const QString& parentKey );
+
 	Object* m_object;
 	Proxy* m_proxy;
 	const QString m_key;
 	const QString m_parentKey;
+	const QString m_absoluteKey;
 	const QVariant m_defaultValue;
 	const Flags m_flags;
 
@@ -53,6 +53,11 @@ public:
 		return m_object;
 	}
 
+	Object* configurationObject() const
+	{
+		return m_object;
+	}
+
 	const QString& instanceId() const
 	{
 		return m_instanceId;
@@ -65,9 +70,9 @@ public:
 
 	void removeInstance( const QString& parentKey );
 
-private:
 	QString instanceParentKey( const QString& parentKey ) const;
 
+private:
 	Object* m_object;
 	QString m_instanceId;
 
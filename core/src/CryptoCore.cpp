@@ -99,9 +99,9 @@ CryptoCore::PlaintextPassword CryptoCore::decryptPassword( const QString& encryp
 
 
 
-CryptoCore::PrivateKey CryptoCore::createPrivateKey()
+CryptoCore::PrivateKey CryptoCore::createPrivateKey( int keySize )
 {
-	return m_keyGenerator.createRSA( CryptoCore::RsaKeySize );
+	return m_keyGenerator.createRSA( keySize );
 }
 
 
@@ -55,11 +55,15 @@ public:
 	QString encryptPassword( const PlaintextPassword& password ) const;
 	PlaintextPassword decryptPassword( const QString& encryptedPassword ) const;
 
-	PrivateKey createPrivateKey();
+	PrivateKey createPrivateKey( int keySize = RsaKeySize );
 	Certificate createSelfSignedHostCertificate( const PrivateKey& privateKey );
 
-private:
 	static constexpr auto RsaKeySize = 4096;
+	// the self-signed host certificate only protects the transport while authentication is
+	// performed separately so use a smaller key to keep TLS handshakes cheap on the server
+	static constexpr auto SelfSignedHostKeySize = 2048;
+
+private:
 
 	QCA::Initializer m_qcaInitializer{};
 	QCA::KeyGenerator m_keyGenerator{};
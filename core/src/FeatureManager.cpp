@@ -51,24 +51,26 @@ FeatureManager::FeatureManager( QObject* parent ) :
 			m_featurePluginInterfaces += featurePluginInterface;
 
 			m_features += featurePluginInterface->featureList();
+
+			auto pluginInterface = qobject_cast<PluginInterface *>( pluginObject );
+			if( pluginInterface )
+			{
+				m_featurePluginInterfacesByUid[pluginInterface->uid()] = featurePluginInterface;
+			}
 		}
 	}
 
+	updateFeatureIndex();
 }
 
 
 
 const FeatureList& FeatureManager::features( Plugin::Uid pluginUid ) const
 {
-	for( auto pluginObject : m_pluginObjects )
+	const auto featureInterface = m_featurePluginInterfacesByUid.value( pluginUid );
+	if( featureInterface )
 	{
-		auto pluginInterface = qobject_cast<PluginInterface *>( pluginObject );
-		auto featurePluginInterface = qobject_cast<FeatureProviderInterface *>( pluginObject );
-
-		if( pluginInterface && featurePluginInterface && pluginInterface->uid() == pluginUid )
-		{
-			return featurePluginInterface->featureList();
-		}
+		return featureInterface->featureList();
 	}
 
 	return m_emptyFeatureList;
@@ -78,15 +80,10 @@ const FeatureList& FeatureManager::features( Plugin::Uid pluginUid ) const
 
 const Feature& FeatureManager::feature( Feature::Uid featureUid ) const
 {
-	for( const auto& featureInterface : m_featurePluginInterfaces )
+	const auto location = locate( featureUid );
+	if( location.featureInterface )
 	{
-		for( const auto& feature : featureInterface->featureList() )
-		{
-			if( feature.uid() == featureUid )
-			{
-				return feature;
-			}
-		}
+		return location.featureInterface->featureList().at( location.index );
 	}
 
 	return m_dummyFeature;
@@ -96,22 +93,23 @@ const Feature& FeatureManager::feature( Feature::Uid featureUid ) const
 
 const FeatureList& FeatureManager::relatedFeatures( Feature::Uid featureUid ) const
 {
-	return features( pluginUid( featureUid ) );
+	const auto location = locate( featureUid );
+	if( location.featureInterface )
+	{
+		return location.featureInterface->featureList();
+	}
+
+	return m_emptyFeatureList;
 }
 
 
 
 Feature::Uid FeatureManager::metaFeatureUid( Feature::Uid featureUid ) const
 {
-	for( const auto& featureInterface : m_featurePluginInterfaces )
+	const auto location = locate( featureUid );
+	if( location.featureInterface )
 	{
-		for( const auto& feature : featureInterface->featureList() )
-		{
-			if( feature.uid() == featureUid )
-			{
-				return featureInterface->metaFeature( featureUid );
-			}
-		}
+		return location.featureInterface->metaFeature( featureUid );
 	}
 
 	return {};
@@ -121,22 +119,7 @@ Feature::Uid FeatureManager::metaFeatureUid( Feature::Uid featureUid ) const
 
 Plugin::Uid FeatureManager::pluginUid( Feature::Uid featureUid ) const
 {
-	for( auto pluginObject : m_pluginObjects )
-	{
-		auto pluginInterface = qobject_cast<PluginInterface *>( pluginObject );
-		auto featurePluginInterface = qobject_cast<FeatureProviderInterface *>( pluginObject );
-
-		if( pluginInterface && featurePluginInterface &&
-			std::find_if( featurePluginInterface->featureList().begin(),
-						  featurePluginInterface->featureList().end(),
-						  [&featureUid]( const Feature& feature ) { return feature.uid() == featureUid; } )
-				!= featurePluginInterface->featureList().end() )
-		{
-			return pluginInterface->uid();
-		}
-	}
-
-	return {};
+	return locate( featureUid ).pluginUid;
 }
 
 
@@ -203,6 +186,13 @@ void FeatureManager::handleFeatureMessage(ComputerControlInterface::Pointer comp
 {
 	vDebug() << computerControlInterface << message;
 
+	const auto location = locate( message.featureUid() );
+	if( location.featureInterface )
+	{
+		location.featureInterface->handleFeatureMessage(computerControlInterface, message);
+		return;
+	}
+
 	for( const auto& featureInterface : qAsConst( m_featurePluginInterfaces ) )
 	{
 		featureInterface->handleFeatureMessage(computerControlInterface, message);
@@ -223,6 +213,13 @@ void FeatureManager::handleFeatureMessage(VeyonServerInterface& server,
 		return;
 	}
 
+	const auto location = locate( message.featureUid() );
+	if( location.featureInterface )
+	{
+		location.featureInterface->handleFeatureMessage(server, messageContext, message);
+		return;
+	}
+
 	for( const auto& featureInterface : qAsConst( m_featurePluginInterfaces ) )
 	{
 		featureInterface->handleFeatureMessage(server, messageContext, message);
@@ -235,6 +232,13 @@ void FeatureManager::handleFeatureMessage(VeyonWorkerInterface& worker, const Fe
 {
 	vDebug() << "[WORKER]" << message;
 
+	const auto location = locate( message.featureUid() );
+	if( location.featureInterface )
+	{
+		location.featureInterface->handleFeatureMessage(worker, message);
+		return;
+	}
+
 	for( const auto& featureInterface : qAsConst( m_featurePluginInterfaces ) )
 	{
 		featureInterface->handleFeatureMessage(worker, message);
@@ -273,3 +277,74 @@ FeatureUidList FeatureManager::activeFeatures( VeyonServerInterface& server ) co
 
 	return features;
 }
+
+
+
+FeatureManager::FeatureLocation FeatureManager::locate( Feature::Uid featureUid ) const
+{
+	if( featureUid.isNull() )
+	{
+		return {};
+	}
+
+	{
+		QReadLocker locker( &m_featureIndexLock );
+		const auto it = m_featureIndex.constFind( featureUid );
+		if( it != m_featureIndex.constEnd() && isValid( *it, featureUid ) )
+		{
+			return *it;
+		}
+	}
+
+	updateFeatureIndex();
+
+	QReadLocker locker( &m_featureIndexLock );
+	const auto location = m_featureIndex.value( featureUid );
+	if( location.featureInterface && isValid( location, featureUid ) )
+	{
+		return location;
+	}
+
+	return {};
+}
+
+
+
+bool FeatureManager::isValid( const FeatureLocation& location, Feature::Uid featureUid ) const
+{
+	const auto& features = location.featureInterface->featureList();
+
+	return location.index < features.size() && features.at( location.index ).uid() == featureUid;
+}
+
+
+
+void FeatureManager::updateFeatureIndex() const
+{
+	QHash<Feature::Uid, FeatureLocation> featureIndex;
+
+	for( auto pluginObject : m_pluginObjects )
+	{
+		auto pluginInterface = qobject_cast<PluginInterface *>( pluginObject );
+		auto featurePluginInterface = qobject_cast<FeatureProviderInterface *>( pluginObject );
+		if( featurePluginInterface == nullptr )
+		{
+			continue;
+		}
+
+		const auto pluginUid = pluginInterface ? pluginInterface->uid() : Plugin::Uid{};
+		const auto& features = featurePluginInterface->featureList();
+
+		for( int i = 0; i < features.size(); ++i )
+		{
+			// keep the first occurrence like the previous linear lookups did
+			if( featureIndex.contains( features[i].uid() ) == false )
+			{
+				featureIndex.insert( features[i].uid(), { featurePluginInterface, pluginUid, i } );
+			}
+		}
+	}
+
+	QWriteLocker locker( &m_featureIndexLock );
+	m_featureIndex.swap( featureIndex );
+}
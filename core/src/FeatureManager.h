@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QObject>
+#include <QReadWriteLock>
 
 #include "Feature.h"
 #include "FeatureProviderInterface.h"
@@ -81,10 +82,27 @@ public:
 	FeatureUidList activeFeatures( VeyonServerInterface& server ) const;
 
 private:
+	struct FeatureLocation
+	{
+		FeatureProviderInterface* featureInterface{nullptr};
+		Plugin::Uid pluginUid{};
+		int index{-1};
+	};
+
+	FeatureLocation locate( Feature::Uid featureUid ) const;
+	bool isValid( const FeatureLocation& location, Feature::Uid featureUid ) const;
+	void updateFeatureIndex() const;
+
 	FeatureList m_features{};
 	const FeatureList m_emptyFeatureList{};
 	QObjectList m_pluginObjects{};
 	FeatureProviderInterfaceList m_featurePluginInterfaces{};
+	QHash<Plugin::Uid, FeatureProviderInterface *> m_featurePluginInterfacesByUid{};
 	const Feature m_dummyFeature{};
 
+	// plugins may update their feature lists at runtime (e.g. when screens or predefined
+	// programs change) so the index is validated on every lookup and rebuilt if outdated
+	mutable QReadWriteLock m_featureIndexLock{};
+	mutable QHash<Feature::Uid, FeatureLocation> m_featureIndex{};
+
 };
@@ -22,6 +22,8 @@
  *
  */
 
+#include <QBuffer>
+
 #include "FeatureManager.h"
 #include "FeatureMessage.h"
 #include "VariantArrayMessage.h"
@@ -47,10 +49,22 @@ bool FeatureMessage::send( QIODevice* ioDevice ) const
 
 
 
+QByteArray FeatureMessage::serialize() const
+{
+	QBuffer buffer;
+	buffer.open( QBuffer::WriteOnly );
+
+	send( &buffer );
+
+	return buffer.data();
+}
+
+
+
 bool FeatureMessage::isReadyForReceive( QIODevice* ioDevice )
 {
 	return ioDevice != nullptr &&
-			VariantArrayMessage( ioDevice ).isReadyForReceive();
+			VariantArrayMessage::isReadyForReceive( ioDevice );
 }
 
 
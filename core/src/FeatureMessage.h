@@ -45,6 +45,7 @@ public:
 		DefaultCommand = 0,
 		InvalidCommand = -1,
 		InitCommand = -2,
+		BindCommand = -3,
 	};
 
 	FeatureMessage() = default;
@@ -108,6 +109,9 @@ public:
 
 	bool send( QIODevice* ioDevice ) const;
 
+	// returns the message encoded the same way as send() does
+	QByteArray serialize() const;
+
 	bool isReadyForReceive( QIODevice* ioDevice );
 
 	bool receive( QIODevice* ioDevice );
@@ -182,12 +182,25 @@ public:
 	}
 
 protected:
-	void sendFeatureMessage(const FeatureMessage& message, const ComputerControlInterfaceList& computerControlInterfaces)
+	// queues the message to all connections which are sent by their own threads without waiting
+	// for each other, returns the number of computers the message could not be queued for
+	int sendFeatureMessage(const FeatureMessage& message, const ComputerControlInterfaceList& computerControlInterfaces)
 	{
+		// encode message only once and share the (implicitly shared) data among all connections
+		const auto serializedMessage = computerControlInterfaces.size() > 1 ? message.serialize() : QByteArray{};
+
+		int failedCount = 0;
+
 		for (const auto& controlInterface : computerControlInterfaces)
 		{
-			controlInterface->sendFeatureMessage(message);
+			if (controlInterface->sendFeatureMessage(message, serializedMessage) == false)
+			{
+				vDebug() << "not connected, skipping" << controlInterface << message;
+				++failedCount;
+			}
 		}
+
+		return failedCount;
 	}
 
 };
@@ -30,9 +30,11 @@
 #include "FeatureManager.h"
 #include "FeatureWorkerManager.h"
 #include "Filesystem.h"
+#include "Metrics.h"
 #include "VeyonConfiguration.h"
 #include "VeyonCore.h"
 #include "PlatformCoreFunctions.h"
+#include "PlatformSessionFunctions.h"
 #include "PlatformUserFunctions.h"
 
 // clazy:excludeall=detaching-member
@@ -45,16 +47,17 @@ FeatureWorkerManager::FeatureWorkerManager( VeyonServerInterface& server, QObjec
 	connect( &m_tcpServer, &QTcpServer::newConnection,
 			 this, &FeatureWorkerManager::acceptConnection );
 
+	// don't hand out workers of a previous user session after logoff or user switch
+	m_standbyWorkerOwnerCheckTimer.setInterval( StandbyWorkerOwnerCheckInterval );
+	connect( &m_standbyWorkerOwnerCheckTimer, &QTimer::timeout, this, [this]() {
+		discardForeignStandbyWorkers( currentStandbyWorkerOwner() );
+	} );
+
 	if( !m_tcpServer.listen( QHostAddress::LocalHost,
 							 static_cast<quint16>( VeyonCore::config().featureWorkerManagerPort() + VeyonCore::sessionId() ) ) )
 	{
 		vCritical() << "can't listen on localhost!";
 	}
-
-	auto pendingMessagesTimer = new QTimer( this );
-	connect( pendingMessagesTimer, &QTimer::timeout, this, &FeatureWorkerManager::sendPendingMessages );
-
-	pendingMessagesTimer->start( 100 );
 }
 
 
@@ -63,6 +66,18 @@ FeatureWorkerManager::~FeatureWorkerManager()
 {
 	m_tcpServer.close();
 
+	// standby workers exit as soon as their connection is closed
+	const auto standbyWorkers = m_standbyWorkers;
+	m_standbyWorkers.clear();
+
+	for( const auto& standbyWorker : standbyWorkers )
+	{
+		if( standbyWorker.socket )
+		{
+			standbyWorker.socket->close();
+		}
+	}
+
 	// properly shutdown all worker processes
 	while( m_workers.isEmpty() == false )
 	{
@@ -105,6 +120,8 @@ bool FeatureWorkerManager::startManagedSystemWorker( Feature::Uid featureUid )
 		worker.process->start( VeyonCore::filesystem().workerFilePath(), { featureUid.toString() } );
 	}
 
+	worker.startTimer.start();
+
 	m_workersMutex.lock();
 	m_workers[featureUid] = worker;
 	m_workersMutex.unlock();
@@ -135,6 +152,14 @@ bool FeatureWorkerManager::startUnmanagedSessionWorker( Feature::Uid featureUid
 		return false;
 	}
 
+	// replenish pool of standby workers once the current request has been served
+	QTimer::singleShot( StandbyWorkerStartDelay, this, &FeatureWorkerManager::startStandbyWorkers );
+
+	if( bindStandbyWorker( featureUid ) )
+	{
+		return true;
+	}
+
 	const auto ret = VeyonCore::platform().coreFunctions().
 					 runProgramAsUser( VeyonCore::filesystem().workerFilePath(), { featureUid.toString() },
 									   currentUser,
@@ -145,6 +170,8 @@ bool FeatureWorkerManager::startUnmanagedSessionWorker( Feature::Uid featureUid
 		return false;
 	}
 
+	worker.startTimer.start();
+
 	m_workersMutex.lock();
 	m_workers[featureUid] = worker;
 	m_workersMutex.unlock();
@@ -211,13 +238,13 @@ void FeatureWorkerManager::sendMessageToManagedSystemWorker( const FeatureMessag
 
 
 
-void FeatureWorkerManager::sendMessageToUnmanagedSessionWorker( const FeatureMessage& message )
+bool FeatureWorkerManager::sendMessageToUnmanagedSessionWorker( const FeatureMessage& message )
 {
 	// don't start worker for logon screen sessions
 	if( VeyonCore::platform().userFunctions().isAnyUserLoggedInLocally() == false ||
 		VeyonCore::platform().coreFunctions().activeDesktopName().contains( QStringLiteral("winlogon"), Qt::CaseInsensitive ) )
 	{
-		return;
+		return false;
 	}
 
 	if( isWorkerRunning( message.featureUid() ) == false &&
@@ -226,10 +253,12 @@ void FeatureWorkerManager::sendMessageToUnmanagedSessionWorker( const FeatureMes
 		vDebug() << "User session likely not yet available - retrying worker start";
 		QTimer::singleShot( UnmanagedSessionProcessRetryInterval, this,
 							[=]() { sendMessageToUnmanagedSessionWorker( message ); } );
-		return;
+		return true;
 	}
 
 	sendMessage( message );
+
+	return true;
 }
 
 
@@ -242,12 +271,136 @@ bool FeatureWorkerManager::isWorkerRunning( Feature::Uid featureUid )
 
 
 
+bool FeatureWorkerManager::bindStandbyWorker( Feature::Uid featureUid )
+{
+	discardForeignStandbyWorkers( currentStandbyWorkerOwner() );
+
+	while( m_standbyWorkers.isEmpty() == false )
+	{
+		const auto socket = m_standbyWorkers.takeFirst().socket;
+		if( socket && socket->state() == QTcpSocket::ConnectedState )
+		{
+			vDebug() << "Binding standby worker to feature" << featureUid;
+
+			Worker worker;
+			worker.socket = socket;
+
+			m_workersMutex.lock();
+			m_workers[featureUid] = worker;
+			m_workersMutex.unlock();
+
+			connect( socket, &QTcpSocket::bytesWritten, this, &FeatureWorkerManager::sendPendingMessages );
+
+			return FeatureMessage( featureUid, FeatureMessage::BindCommand ).send( socket );
+		}
+	}
+
+	return false;
+}
+
+
+
+void FeatureWorkerManager::startStandbyWorkers()
+{
+	const auto owner = currentStandbyWorkerOwner();
+
+	discardForeignStandbyWorkers( owner );
+
+	if( owner.user.isEmpty() ||
+		owner.desktopName.contains( QStringLiteral("winlogon"), Qt::CaseInsensitive ) )
+	{
+		return;
+	}
+
+	auto missingWorkers = VeyonCore::config().standbyWorkerCount() - m_standbyWorkers.count() - m_startingStandbyWorkers.count();
+
+	while( missingWorkers > 0 )
+	{
+		const auto token = QUuid::createUuid().toString();
+
+		if( VeyonCore::platform().coreFunctions().runProgramAsUser( VeyonCore::filesystem().workerFilePath(),
+																	{ standbyWorkerArgument(), token },
+																	owner.user, owner.desktopName ) == false )
+		{
+			break;
+		}
+
+		vDebug() << "Started standby worker";
+		m_startingStandbyWorkers[token] = owner;
+		--missingWorkers;
+
+		// don't block the pool forever if started workers never manage to connect
+		QTimer::singleShot( StandbyWorkerConnectTimeout, this, [this, token]() { m_startingStandbyWorkers.remove( token ); } );
+	}
+}
+
+
+
+FeatureWorkerManager::StandbyWorkerOwner FeatureWorkerManager::currentStandbyWorkerOwner()
+{
+	return { VeyonCore::platform().userFunctions().currentUser(),
+			 VeyonCore::platform().coreFunctions().activeDesktopName(),
+			 VeyonCore::platform().sessionFunctions().currentSessionId() };
+}
+
+
+
+void FeatureWorkerManager::discardForeignStandbyWorkers( const StandbyWorkerOwner& owner )
+{
+	for( auto it = m_startingStandbyWorkers.begin(); it != m_startingStandbyWorkers.end(); )
+	{
+		if( it.value() == owner )
+		{
+			++it;
+		}
+		else
+		{
+			it = m_startingStandbyWorkers.erase( it );
+		}
+	}
+
+	QList<QPointer<QTcpSocket>> foreignSockets;
+
+	for( auto it = m_standbyWorkers.begin(); it != m_standbyWorkers.end(); )
+	{
+		if( it->socket && it->owner == owner )
+		{
+			++it;
+		}
+		else
+		{
+			foreignSockets.append( it->socket );
+			it = m_standbyWorkers.erase( it );
+		}
+	}
+
+	// closing makes the workers exit
+	for( const auto& socket : qAsConst(foreignSockets) )
+	{
+		if( socket )
+		{
+			vDebug() << "discarding standby worker of previous user session";
+			socket->close();
+		}
+	}
+
+	if( m_standbyWorkers.isEmpty() )
+	{
+		m_standbyWorkerOwnerCheckTimer.stop();
+	}
+}
+
+
+
 void FeatureWorkerManager::acceptConnection()
 {
 	vDebug() << "accepting connection";
 
 	QTcpSocket* socket = m_tcpServer.nextPendingConnection();
 
+	// messages are small and latency-sensitive, so don't let Nagle's algorithm delay them
+	socket->setSocketOption( QAbstractSocket::LowDelayOption, 1 );
+
 	// connect to readyRead() signal of new connection
 	connect( socket, &QTcpSocket::readyRead,
 			 this, [=] () { processConnection( socket ); } );
@@ -260,32 +413,59 @@ void FeatureWorkerManager::acceptConnection()
 
 void FeatureWorkerManager::processConnection( QTcpSocket* socket )
 {
+	// process all complete messages as readyRead() is not emitted again for data already buffered
 	FeatureMessage message;
-	message.receive( socket );
-
-	m_workersMutex.lock();
-
-	// set socket information
-	if( m_workers.contains( message.featureUid() ) )
+	while( message.isReadyForReceive( socket ) && message.receive( socket ) )
 	{
-		if( m_workers[message.featureUid()].socket.isNull() )
+		if( message.featureUid().isNull() && message.command() == FeatureMessage::InitCommand )
 		{
-			m_workers[message.featureUid()].socket = socket;
-			sendPendingMessages();
+			const auto token = message.argument( InitArgument::StandbyToken ).toString();
+			const auto owner = m_startingStandbyWorkers.take( token );
+
+			if( token.isEmpty() || owner.user.isEmpty() || ( owner == currentStandbyWorkerOwner() ) == false )
+			{
+				vWarning() << "rejecting standby worker not started for the current user session";
+				socket->close();
+				return;
+			}
+
+			vDebug() << "standby worker connected";
+			m_standbyWorkers.append( { owner, socket } );
+			m_standbyWorkerOwnerCheckTimer.start();
+			continue;
 		}
 
-		m_workersMutex.unlock();
+		m_workersMutex.lock();
 
-		if( message.command() >= 0 )
+		// set socket information
+		if( m_workers.contains( message.featureUid() ) )
 		{
-			VeyonCore::featureManager().handleFeatureMessage( m_server, MessageContext( socket ), message );
+			auto& worker = m_workers[message.featureUid()];
+			if( worker.socket.isNull() )
+			{
+				worker.socket = socket;
+				connect( socket, &QTcpSocket::bytesWritten, this, &FeatureWorkerManager::sendPendingMessages );
+
+				if( worker.startTimer.isValid() )
+				{
+					Metrics::observe( "veyon_worker_start_seconds", double(worker.startTimer.elapsed()) / 1000 );
+				}
+				sendPendingMessages();
+			}
+
+			m_workersMutex.unlock();
+
+			if( message.command() >= 0 )
+			{
+				VeyonCore::featureManager().handleFeatureMessage( m_server, MessageContext( socket ), message );
+			}
 		}
-	}
-	else
-	{
-		m_workersMutex.unlock();
+		else
+		{
+			m_workersMutex.unlock();
 
-		vCritical() << "got data from non-existing worker!" << message.featureUid();
+			vCritical() << "got data from non-existing worker!" << message.featureUid();
+		}
 	}
 }
 
@@ -293,6 +473,18 @@ void FeatureWorkerManager::processConnection( QTcpSocket* socket )
 
 void FeatureWorkerManager::closeConnection( QTcpSocket* socket )
 {
+	for( auto it = m_standbyWorkers.begin(); it != m_standbyWorkers.end(); )
+	{
+		if( it->socket == socket )
+		{
+			it = m_standbyWorkers.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+
 	m_workersMutex.lock();
 
 	for( auto it = m_workers.begin(); it != m_workers.end(); )
@@ -329,6 +521,16 @@ void FeatureWorkerManager::sendMessage( const FeatureMessage& message )
 	}
 
 	m_workersMutex.unlock();
+
+	// sockets may only be written to from the thread they belong to
+	if( thread() == QThread::currentThread() )
+	{
+		sendPendingMessages();
+	}
+	else
+	{
+		QMetaObject::invokeMethod( this, &FeatureWorkerManager::sendPendingMessages, Qt::QueuedConnection );
+	}
 }
 
 
@@ -341,7 +543,10 @@ void FeatureWorkerManager::sendPendingMessages()
 	{
 		auto& worker = it.value();
 
-		while( worker.socket && worker.pendingMessages.isEmpty() == false )
+		// stop writing while the worker has not yet consumed previous data - remaining
+		// messages are sent as soon as bytesWritten() is emitted for the socket
+		while( worker.socket && worker.pendingMessages.isEmpty() == false &&
+			   worker.socket->bytesToWrite() < MaximumPendingBytesPerWorker )
 		{
 			worker.pendingMessages.first().send( worker.socket );
 			worker.pendingMessages.removeFirst();
@@ -24,10 +24,12 @@
 
 #pragma once
 
+#include <QElapsedTimer>
 #include <QPointer>
 #include <QProcess>
 #include <QTcpServer>
 #include <QTcpSocket>
+#include <QTimer>
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
 #include <QRecursiveMutex>
@@ -36,6 +38,7 @@
 #endif
 
 #include "FeatureMessage.h"
+#include "PlatformSessionFunctions.h"
 
 class FeatureManager;
 class VeyonServerInterface;
@@ -44,6 +47,12 @@ class VEYON_CORE_EXPORT FeatureWorkerManager : public QObject
 {
 	Q_OBJECT
 public:
+	enum class InitArgument
+	{
+		StandbyToken
+	};
+	Q_ENUM(InitArgument)
+
 	FeatureWorkerManager( VeyonServerInterface& server, QObject* parent = nullptr );
 	~FeatureWorkerManager() override;
 
@@ -53,11 +62,39 @@ public:
 	bool stopWorker( Feature::Uid featureUid );
 
 	void sendMessageToManagedSystemWorker( const FeatureMessage& message );
-	void sendMessageToUnmanagedSessionWorker( const FeatureMessage& message );
+	bool sendMessageToUnmanagedSessionWorker( const FeatureMessage& message );
 
 	bool isWorkerRunning( Feature::Uid featureUid );
 
+	static QString standbyWorkerArgument()
+	{
+		return QStringLiteral("--standby");
+	}
+
 private:
+	struct StandbyWorkerOwner
+	{
+		QString user;
+		QString desktopName;
+		PlatformSessionFunctions::SessionId sessionId{PlatformSessionFunctions::InvalidSessionId};
+
+		bool operator==( const StandbyWorkerOwner& other ) const
+		{
+			return user == other.user && desktopName == other.desktopName && sessionId == other.sessionId;
+		}
+	};
+
+	struct StandbyWorker
+	{
+		StandbyWorkerOwner owner;
+		QPointer<QTcpSocket> socket;
+	};
+
+	bool bindStandbyWorker( Feature::Uid featureUid );
+	void startStandbyWorkers();
+	StandbyWorkerOwner currentStandbyWorkerOwner();
+	void discardForeignStandbyWorkers( const StandbyWorkerOwner& owner );
+
 	void acceptConnection();
 	void processConnection( QTcpSocket* socket );
 	void closeConnection( QTcpSocket* socket );
@@ -67,6 +104,10 @@ private:
 	void sendPendingMessages();
 
 	static constexpr auto UnmanagedSessionProcessRetryInterval = 5000;
+	static constexpr auto StandbyWorkerStartDelay = 1000;
+	static constexpr auto StandbyWorkerConnectTimeout = 30000;
+	static constexpr auto StandbyWorkerOwnerCheckInterval = 5000;
+	static constexpr qint64 MaximumPendingBytesPerWorker = 1024*1024;
 
 	VeyonServerInterface& m_server;
 	QTcpServer m_tcpServer;
@@ -75,12 +116,19 @@ private:
 	{
 		QPointer<QTcpSocket> socket;
 		QPointer<QProcess> process;
+		QElapsedTimer startTimer;
 		QList<FeatureMessage> pendingMessages;
 	};
 
 	using WorkerMap = QMap<Feature::Uid, Worker>;
 	WorkerMap m_workers;
 
+	// idle session workers which have been started in advance for the current user session and can
+	// be bound to any feature - starting workers are identified by a random token passed to them
+	QList<StandbyWorker> m_standbyWorkers;
+	QMap<QString, StandbyWorkerOwner> m_startingStandbyWorkers;
+	QTimer m_standbyWorkerOwnerCheckTimer{this};
+
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
 	QRecursiveMutex m_workersMutex;
 #else
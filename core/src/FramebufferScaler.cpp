@@ -0,0 +1,373 @@
+/*
+ * FramebufferScaler.cpp - implementation of FramebufferScaler class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FRAMEBUFFER_SCALER_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define FRAMEBUFFER_SCALER_NEON
+#include <arm_neon.h>
+#endif
+
+#include "FramebufferScaler.h"
+
+
+namespace {
+
+constexpr int ChannelsPerPixel = 4;
+
+using AccumulateRowFunction = void (*)(const uint8_t* source, uint16_t* accumulator, int sampleCount);
+using ReduceRowFunction = void (*)(const uint16_t* accumulator, const int* columns, int width, int rowCount,
+									uint32_t* destination);
+
+struct ScalerFunctions
+{
+	FramebufferScaler::Implementation implementation;
+	AccumulateRowFunction accumulateRow;
+	ReduceRowFunction reduceRow;
+};
+
+
+
+void accumulateRowGeneric(const uint8_t* source, uint16_t* accumulator, int sampleCount)
+{
+	for (int i = 0; i < sampleCount; ++i)
+	{
+		accumulator[i] += source[i];
+	}
+}
+
+
+
+void reduceRowGeneric(const uint16_t* accumulator, const int* columns, int width, int rowCount,
+					  uint32_t* destination)
+{
+	for (int x = 0; x < width; ++x)
+	{
+		const auto area = uint32_t(columns[x+1] - columns[x]) * uint32_t(rowCount);
+		uint32_t sums[ChannelsPerPixel]{};
+
+		for (int column = columns[x]; column < columns[x+1]; ++column)
+		{
+			const auto samples = accumulator + column * ChannelsPerPixel;
+			for (int channel = 0; channel < ChannelsPerPixel; ++channel)
+			{
+				sums[channel] += samples[channel];
+			}
+		}
+
+		uint32_t pixel = 0;
+		for (int channel = 0; channel < ChannelsPerPixel; ++channel)
+		{
+			pixel |= ((sums[channel] + area / 2) / area) << (channel * 8);
+		}
+
+		destination[x] = pixel;
+	}
+}
+
+
+
+#ifdef FRAMEBUFFER_SCALER_X86
+__attribute__((target("sse2")))
+void accumulateRowSSE2(const uint8_t* source, uint16_t* accumulator, int sampleCount)
+{
+	const auto zero = _mm_setzero_si128();
+
+	int i = 0;
+	for (; i + 16 <= sampleCount; i += 16)
+	{
+		const auto samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+		const auto low = reinterpret_cast<__m128i *>(accumulator + i);
+		const auto high = reinterpret_cast<__m128i *>(accumulator + i + 8);
+
+		_mm_storeu_si128(low, _mm_add_epi16(_mm_loadu_si128(low), _mm_unpacklo_epi8(samples, zero)));
+		_mm_storeu_si128(high, _mm_add_epi16(_mm_loadu_si128(high), _mm_unpackhi_epi8(samples, zero)));
+	}
+
+	accumulateRowGeneric(source + i, accumulator + i, sampleCount - i);
+}
+
+
+
+__attribute__((target("sse2")))
+void reduceRowSSE2(const uint16_t* accumulator, const int* columns, int width, int rowCount,
+				   uint32_t* destination)
+{
+	const auto zero = _mm_setzero_si128();
+
+	for (int x = 0; x < width; ++x)
+	{
+		auto sums = _mm_setzero_si128();
+
+		for (int column = columns[x]; column < columns[x+1]; ++column)
+		{
+			const auto samples = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(accumulator + column * ChannelsPerPixel));
+			sums = _mm_add_epi32(sums, _mm_unpacklo_epi16(samples, zero));
+		}
+
+		const auto factor = _mm_set1_ps(1.0f / float((columns[x+1] - columns[x]) * rowCount));
+		const auto averages = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(sums), factor));
+
+		destination[x] = uint32_t(_mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(averages, zero), zero)));
+	}
+}
+
+
+
+__attribute__((target("avx2")))
+void accumulateRowAVX2(const uint8_t* source, uint16_t* accumulator, int sampleCount)
+{
+	int i = 0;
+	for (; i + 32 <= sampleCount; i += 32)
+	{
+		const auto low = reinterpret_cast<__m256i *>(accumulator + i);
+		const auto high = reinterpret_cast<__m256i *>(accumulator + i + 16);
+
+		const auto lowSamples = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i)));
+		const auto highSamples = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i + 16)));
+
+		_mm256_storeu_si256(low, _mm256_add_epi16(_mm256_loadu_si256(low), lowSamples));
+		_mm256_storeu_si256(high, _mm256_add_epi16(_mm256_loadu_si256(high), highSamples));
+	}
+
+	accumulateRowSSE2(source + i, accumulator + i, sampleCount - i);
+}
+#endif
+
+
+
+#ifdef FRAMEBUFFER_SCALER_NEON
+void accumulateRowNEON(const uint8_t* source, uint16_t* accumulator, int sampleCount)
+{
+	int i = 0;
+	for (; i + 16 <= sampleCount; i += 16)
+	{
+		const auto samples = vld1q_u8(source + i);
+
+		vst1q_u16(accumulator + i, vaddw_u8(vld1q_u16(accumulator + i), vget_low_u8(samples)));
+		vst1q_u16(accumulator + i + 8, vaddw_u8(vld1q_u16(accumulator + i + 8), vget_high_u8(samples)));
+	}
+
+	accumulateRowGeneric(source + i, accumulator + i, sampleCount - i);
+}
+
+
+
+void reduceRowNEON(const uint16_t* accumulator, const int* columns, int width, int rowCount,
+				   uint32_t* destination)
+{
+	for (int x = 0; x < width; ++x)
+	{
+		auto sums = vdupq_n_u32(0);
+
+		for (int column = columns[x]; column < columns[x+1]; ++column)
+		{
+			sums = vaddw_u16(sums, vld1_u16(accumulator + column * ChannelsPerPixel));
+		}
+
+		const auto factor = 1.0f / float((columns[x+1] - columns[x]) * rowCount);
+		const auto averages = vcvtq_u32_f32(vaddq_f32(vmulq_n_f32(vcvtq_f32_u32(sums), factor), vdupq_n_f32(0.5f)));
+		const auto narrowed = vmovn_u16(vcombine_u16(vmovn_u32(averages), vdup_n_u16(0)));
+
+		destination[x] = vget_lane_u32(vreinterpret_u32_u8(narrowed), 0);
+	}
+}
+#endif
+
+
+
+ScalerFunctions detectScalerFunctions()
+{
+#if defined(FRAMEBUFFER_SCALER_X86)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return { FramebufferScaler::Implementation::AVX2, accumulateRowAVX2, reduceRowSSE2 };
+	}
+	if (__builtin_cpu_supports("sse2"))
+	{
+		return { FramebufferScaler::Implementation::SSE2, accumulateRowSSE2, reduceRowSSE2 };
+	}
+#elif defined(FRAMEBUFFER_SCALER_NEON)
+	return { FramebufferScaler::Implementation::NEON, accumulateRowNEON, reduceRowNEON };
+#endif
+
+	return { FramebufferScaler::Implementation::Generic, accumulateRowGeneric, reduceRowGeneric };
+}
+
+
+
+const ScalerFunctions& scalerFunctions()
+{
+	static const ScalerFunctions functions = detectScalerFunctions();
+	return functions;
+}
+
+}
+
+
+
+QImage FramebufferScaler::scaled(const QImage& image, QSize size, VncConnectionConfiguration::ScalingMode mode)
+{
+	switch (mode)
+	{
+	case VncConnectionConfiguration::ScalingMode::Fast:
+		return image.scaled(size, Qt::IgnoreAspectRatio, Qt::FastTransformation);
+	case VncConnectionConfiguration::ScalingMode::AreaAveraging:
+		return areaAveraged(image, size);
+	case VncConnectionConfiguration::ScalingMode::Smooth:
+		break;
+	}
+
+	return image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
+
+
+
+QImage FramebufferScaler::areaAveraged(const QImage& image, QSize size)
+{
+	if (image.isNull() || size.isEmpty())
+	{
+		return {};
+	}
+
+	if (supportsAreaAveraging(image.size(), size) == false)
+	{
+		return image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+	}
+
+	const auto source = image.format() == QImage::Format_RGB32 ? image : image.convertToFormat(QImage::Format_RGB32);
+
+	QImage destination(size, QImage::Format_RGB32);
+
+	scaleArea(source, destination, destination.rect());
+
+	return destination;
+}
+
+
+
+bool FramebufferScaler::areaAveraged(const QImage& image, QImage& scaledImage, const QRect& rect)
+{
+	if (image.isNull() || scaledImage.isNull() ||
+		image.format() != QImage::Format_RGB32 ||
+		scaledImage.format() != QImage::Format_RGB32 ||
+		supportsAreaAveraging(image.size(), scaledImage.size()) == false)
+	{
+		return false;
+	}
+
+	const auto scaledRect = mapToScaled(rect, image.size(), scaledImage.size());
+	if (scaledRect.isEmpty() == false)
+	{
+		scaleArea(image, scaledImage, scaledRect);
+	}
+
+	return true;
+}
+
+
+
+QRect FramebufferScaler::mapToScaled(const QRect& rect, QSize size, QSize scaledSize)
+{
+	const auto clippedRect = rect.intersected(QRect(QPoint(0, 0), size));
+	if (clippedRect.isEmpty() || size.isEmpty())
+	{
+		return {};
+	}
+
+	// map to all scaled pixels whose source area intersects with the given rect
+	const auto left = int(qint64(clippedRect.left()) * scaledSize.width() / size.width());
+	const auto top = int(qint64(clippedRect.top()) * scaledSize.height() / size.height());
+	const auto right = int((qint64(clippedRect.right() + 1) * scaledSize.width() + size.width() - 1) / size.width());
+	const auto bottom = int((qint64(clippedRect.bottom() + 1) * scaledSize.height() + size.height() - 1) / size.height());
+
+	return QRect(QPoint(left, top), QPoint(right - 1, bottom - 1)).intersected(QRect(QPoint(0, 0), scaledSize));
+}
+
+
+
+FramebufferScaler::Implementation FramebufferScaler::implementation()
+{
+	return scalerFunctions().implementation;
+}
+
+
+
+bool FramebufferScaler::supportsAreaAveraging(QSize size, QSize scaledSize)
+{
+	// box filter only makes sense for downscaling
+	return scaledSize.isEmpty() == false &&
+		   scaledSize.width() <= size.width() &&
+		   scaledSize.height() <= size.height() &&
+		   (size.height() + scaledSize.height() - 1) / scaledSize.height() <= MaximumRowsPerPixel;
+}
+
+
+
+void FramebufferScaler::scaleArea(const QImage& source, QImage& destination, const QRect& rect)
+{
+	const auto sourceWidth = source.width();
+	const auto sourceHeight = source.height();
+	const auto width = destination.width();
+	const auto height = destination.height();
+
+	// determine source columns for each destination column relative to the first source column
+	std::vector<int> columns(size_t(rect.width()) + 1);
+	for (int x = 0; x <= rect.width(); ++x)
+	{
+		columns[size_t(x)] = int(qint64(rect.x() + x) * sourceWidth / width);
+	}
+
+	const auto firstColumn = columns.front();
+	for (auto& column : columns)
+	{
+		column -= firstColumn;
+	}
+
+	const auto sampleCount = columns.back() * ChannelsPerPixel;
+	std::vector<uint16_t> accumulator(size_t(sampleCount));
+
+	const auto& functions = scalerFunctions();
+
+	for (int y = rect.top(); y <= rect.bottom(); ++y)
+	{
+		const auto firstRow = int(qint64(y) * sourceHeight / height);
+		const auto lastRow = int(qint64(y + 1) * sourceHeight / height);
+
+		std::fill(accumulator.begin(), accumulator.end(), 0);
+
+		for (int row = firstRow; row < lastRow; ++row)
+		{
+			functions.accumulateRow(source.constScanLine(row) + firstColumn * ChannelsPerPixel,
+									accumulator.data(), sampleCount);
+		}
+
+		functions.reduceRow(accumulator.data(), columns.data(), rect.width(), lastRow - firstRow,
+							reinterpret_cast<uint32_t *>(destination.scanLine(y)) + rect.x());
+	}
+}
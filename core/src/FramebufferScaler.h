@@ -0,0 +1,65 @@
+/*
+ * FramebufferScaler.h - declaration of FramebufferScaler class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QImage>
+
+#include "VncConnectionConfiguration.h"
+
+// downscales RGB32 framebuffers using a box filter (area averaging) with
+// SIMD implementations selected at runtime depending on CPU capabilities
+class VEYON_CORE_EXPORT FramebufferScaler
+{
+	Q_GADGET
+public:
+	enum class Implementation
+	{
+		Generic,
+		SSE2,
+		AVX2,
+		NEON
+	};
+	Q_ENUM(Implementation)
+
+	static QImage scaled(const QImage& image, QSize size, VncConnectionConfiguration::ScalingMode mode);
+
+	static QImage areaAveraged(const QImage& image, QSize size);
+
+	// updates the region of scaledImage which corresponds to rect in image,
+	// returns false if scaledImage has to be regenerated completely instead
+	static bool areaAveraged(const QImage& image, QImage& scaledImage, const QRect& rect);
+
+	static QRect mapToScaled(const QRect& rect, QSize size, QSize scaledSize);
+
+	static Implementation implementation();
+
+	// 16 bit accumulators allow summing up to 257 rows of 8 bit samples
+	static constexpr int MaximumRowsPerPixel = 256;
+
+private:
+	static bool supportsAreaAveraging(QSize size, QSize scaledSize);
+	static void scaleArea(const QImage& source, QImage& destination, const QRect& rect);
+
+} ;
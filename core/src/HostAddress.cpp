@@ -22,13 +22,25 @@
  *
  */
 
+#include <QElapsedTimer>
 #include <QHostInfo>
+#include <QMutex>
 #include <QNetworkInterface>
+#include <QtConcurrent>
 #include <QUrl>
 
 #include "HostAddress.h"
 
 
+struct CachedHostInfo
+{
+	QHostInfo hostInfo;
+	QElapsedTimer age;
+};
+
+static QMutex __hostLookupCacheMutex;
+static QHash<QString, CachedHostInfo> __hostLookupCache;
+
 QString HostAddress::s_cachedLocalFQDN;
 
 HostAddress::HostAddress( const QString& address ) :
@@ -54,7 +66,7 @@ bool HostAddress::isLocalHost() const
 		return hostAddress.isLoopback() || allLocalAddresses.contains( hostAddress );
 	}
 
-	const auto addresses = QHostInfo::fromName( m_address ).addresses();
+	const auto addresses = lookupHost( m_address ).addresses();
 	for( const auto& address : addresses )
 	{
 		if( address.isLoopback() || allLocalAddresses.contains( address ) )
@@ -105,7 +117,7 @@ QString HostAddress::tryConvert( HostAddress::Type targetType ) const
 QStringList HostAddress::lookupIpAddresses() const
 {
 	const auto hostName = convert( Type::FullyQualifiedDomainName );
-	const auto hostInfo = QHostInfo::fromName( hostName );
+	const auto hostInfo = lookupHost( hostName );
 	if( hostInfo.error() != QHostInfo::NoError || hostInfo.addresses().isEmpty() )
 	{
 		vWarning() << "could not lookup IP addresses of host" << hostName << "error:" << hostInfo.errorString();
@@ -167,6 +179,53 @@ QString HostAddress::localFQDN()
 
 
 
+void HostAddress::prefetch( const QStringList& addresses )
+{
+	auto pendingAddresses = addresses;
+	pendingAddresses.removeDuplicates();
+
+	QtConcurrent::blockingMap( pendingAddresses, []( const QString& address ) {
+		lookupHost( address );
+	} );
+}
+
+
+
+QHostInfo HostAddress::lookupHost( const QString& name )
+{
+	const auto key = name.toLower();
+
+	__hostLookupCacheMutex.lock();
+	const auto it = __hostLookupCache.constFind( key );
+	if( it != __hostLookupCache.constEnd() &&
+		it->age.hasExpired( it->hostInfo.error() == QHostInfo::NoError ? HostLookupCacheTimeout
+																	   : FailedHostLookupCacheTimeout ) == false )
+	{
+		const auto hostInfo = it->hostInfo;
+		__hostLookupCacheMutex.unlock();
+		return hostInfo;
+	}
+	__hostLookupCacheMutex.unlock();
+
+	// do not hold lock while performing blocking lookup so other lookups can proceed in parallel
+	const auto hostInfo = QHostInfo::fromName( name );
+
+	CachedHostInfo cachedHostInfo{ hostInfo, {} };
+	cachedHostInfo.age.start();
+
+	__hostLookupCacheMutex.lock();
+	if( __hostLookupCache.size() >= MaximumHostLookupCacheSize )
+	{
+		__hostLookupCache.clear();
+	}
+	__hostLookupCache[key] = cachedHostInfo;
+	__hostLookupCacheMutex.unlock();
+
+	return hostInfo;
+}
+
+
+
 HostAddress::Type HostAddress::determineType( const QString& address )
 {
 	if( address.isEmpty() )
@@ -201,7 +260,7 @@ QString HostAddress::toIpAddress( const QString& hostName )
 	}
 
 	// then try to resolve ist first
-	const auto hostInfo = QHostInfo::fromName( hostName );
+	const auto hostInfo = lookupHost( hostName );
 	if( hostInfo.error() != QHostInfo::NoError || hostInfo.addresses().isEmpty() )
 	{
 		vWarning() << "could not lookup IP address of host" << hostName << "error:" << hostInfo.errorString();
@@ -231,7 +290,7 @@ QString HostAddress::toHostName( HostAddress::Type type, const QString& address
 
 	case Type::IpAddress:
 	{
-		const auto hostInfo = QHostInfo::fromName( address );
+		const auto hostInfo = lookupHost( address );
 		if( hostInfo.error() != QHostInfo::NoError )
 		{
 			vWarning() << "could not lookup hostname for IP address" << address << "error:" << hostInfo.errorString();
@@ -267,7 +326,7 @@ QString HostAddress::toFQDN( HostAddress::Type type, const QString& address )
 
 	case Type::IpAddress:
 	{
-		const auto hostInfo = QHostInfo::fromName( address );
+		const auto hostInfo = lookupHost( address );
 		if( hostInfo.error() != QHostInfo::NoError )
 		{
 			vWarning() << "could not lookup hostname for IP address" << address << "error:" << hostInfo.errorString();
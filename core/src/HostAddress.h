@@ -26,6 +26,8 @@
 
 #include "VeyonCore.h"
 
+class QHostInfo;
+
 class VEYON_CORE_EXPORT HostAddress
 {
 	Q_GADGET
@@ -58,7 +60,16 @@ public:
 
 	static QString localFQDN();
 
+	// resolves given addresses in parallel and stores the results in the host lookup cache
+	static void prefetch( const QStringList& addresses );
+
 private:
+	static constexpr int HostLookupCacheTimeout = 5 * 60 * 1000;
+	static constexpr int FailedHostLookupCacheTimeout = 30 * 1000;
+	static constexpr int MaximumHostLookupCacheSize = 4096;
+
+	static QHostInfo lookupHost( const QString& name );
+
 	static Type determineType( const QString& address );
 	static QString toIpAddress( const QString& hostName );
 	static QString toHostName( Type type, const QString& address );
@@ -26,6 +26,7 @@
 #include "PlatformInputDeviceFunctions.h"
 
 #include <QApplication>
+#include <QPaintEvent>
 #include <QPainter>
 #include <QScreen>
 #include <QWindow>
@@ -56,6 +57,12 @@ LockWidget::LockWidget( Mode mode, const QPixmap& background, QWidget* parent )
 	VeyonCore::platform().coreFunctions().setSystemUiState( false );
 	VeyonCore::platform().inputDeviceFunctions().disableInputDevices();
 
+	if( mode != NoBackground )
+	{
+		// the cached background covers the whole widget so skip erasing it before each repaint
+		setAttribute( Qt::WA_OpaquePaintEvent );
+	}
+
 	setWindowTitle( {} );
 
 	move(leftMostScreen->geometry().topLeft());
@@ -89,12 +96,40 @@ LockWidget::~LockWidget()
 
 void LockWidget::paintEvent( QPaintEvent* event )
 {
-	Q_UNUSED(event)
+	if( m_mode == NoBackground )
+	{
+		return;
+	}
+
+	const auto pixelRatio = devicePixelRatioF();
+	if( m_renderedBackground.isNull() ||
+		m_renderedBackground.size() != size() * pixelRatio ||
+		m_renderedBackground.devicePixelRatioF() != pixelRatio )
+	{
+		renderBackground();
+	}
+
+	const auto& rect = event->rect();
 
 	QPainter p( this );
+	p.drawPixmap( rect.topLeft(), m_renderedBackground,
+				  QRectF( QPointF( rect.topLeft() ) * pixelRatio, QSizeF( rect.size() ) * pixelRatio ) );
+}
+
+
+
+void LockWidget::renderBackground()
+{
+	const auto pixelRatio = devicePixelRatioF();
+
+	m_renderedBackground = QPixmap( size() * pixelRatio );
+	m_renderedBackground.setDevicePixelRatio( pixelRatio );
+
+	QPainter p( &m_renderedBackground );
 	switch( m_mode )
 	{
 	case DesktopVisible:
+		p.fillRect( rect(), Qt::black );
 		p.drawPixmap( 0, 0, m_background );
 		break;
 
@@ -45,9 +45,14 @@ public:
 
 
 private:
-	void paintEvent( QPaintEvent * ) override;
+	void paintEvent( QPaintEvent* event ) override;
+
+	void renderBackground();
 
 	QPixmap m_background;
 	Mode m_mode;
 
+	// background composed for the current widget size so that repaints only blit it
+	QPixmap m_renderedBackground;
+
 } ;
@@ -26,17 +26,45 @@
 #include <QDateTime>
 #include <QDir>
 #include <QFile>
+#include <QThread>
+
+#include <functional>
 
 #include "VeyonConfiguration.h"
 #include "Filesystem.h"
 #include "Logger.h"
 #include "PlatformCoreFunctions.h"
 #include "PlatformFilesystemFunctions.h"
+#include "StructuredLog.h"
 
 QAtomicPointer<Logger> Logger::s_instance = nullptr;
 QMutex Logger::s_instanceMutex;
 
 
+namespace {
+
+class LogWriterThread : public QThread
+{
+public:
+	explicit LogWriterThread( const std::function<void()>& function ) :
+		m_function( function )
+	{
+	}
+
+protected:
+	void run() override
+	{
+		m_function();
+	}
+
+private:
+	const std::function<void()> m_function;
+
+};
+
+}
+
+
 Logger::Logger( const QString &appName ) :
 	m_appName( QStringLiteral( "Veyon" ) + appName )
 {
@@ -69,6 +97,11 @@ Logger::Logger( const QString &appName ) :
 		initLogFile();
 	}
 
+	if( VeyonCore::config().logAsynchronously() )
+	{
+		startWriterThread();
+	}
+
 	qInstallMessageHandler( qtMsgHandler );
 
 	VeyonCore::platform().coreFunctions().initNativeLoggingSystem( appName );
@@ -91,6 +124,8 @@ Logger::~Logger()
 {
 	vDebug() << "Shutdown";
 
+	stopWriterThread();
+
 	QMutexLocker l( &m_logMutex );
 
 	qInstallMessageHandler(nullptr);
@@ -99,6 +134,8 @@ Logger::~Logger()
 	s_instance = nullptr;
 	s_instanceMutex.unlock();
 
+	delete m_structuredLog;
+	delete m_structuredLogFile;
 	delete m_logFile;
 }
 
@@ -158,6 +195,22 @@ void Logger::initLogFile()
 
 	openLogFile();
 
+	if( VeyonCore::config().structuredLogFileEnabled() )
+	{
+		m_structuredLogFile = new QFile( logPath + m_appName + StructuredLog::fileSuffix() );
+		if( VeyonCore::platform().filesystemFunctions().openFileSafely(
+				m_structuredLogFile, QFile::WriteOnly | QFile::Append,
+				QFile::ReadOwner | QFile::WriteOwner ) )
+		{
+			m_structuredLog = new StructuredLog( m_structuredLogFile );
+		}
+		else
+		{
+			delete m_structuredLogFile;
+			m_structuredLogFile = nullptr;
+		}
+	}
+
 	if( VeyonCore::config().logFileSizeLimitEnabled() )
 	{
 		static constexpr auto BytesPerKB = 1024;
@@ -327,17 +380,13 @@ void Logger::log( LogLevel logLevel, const QString& message )
 		{
 			if( m_lastMessageCount )
 			{
-				outputMessage( formatMessage( m_lastMessageLevel, QStringLiteral( "---" ) ) );
-				outputMessage( formatMessage( m_lastMessageLevel, QStringLiteral( "Last message repeated %1 times" ).arg( m_lastMessageCount ) ) );
-				outputMessage( formatMessage( m_lastMessageLevel, QStringLiteral( "---" ) ) );
+				writeMessage( m_lastMessageLevel, formatMessage( m_lastMessageLevel, QStringLiteral( "---" ) ) +
+							  formatMessage( m_lastMessageLevel, QStringLiteral( "Last message repeated %1 times" ).arg( m_lastMessageCount ) ) +
+							  formatMessage( m_lastMessageLevel, QStringLiteral( "---" ) ) );
 				m_lastMessageCount = 0;
 			}
-			outputMessage( formatMessage( logLevel, message ) );
 
-			if( m_logToSystem )
-			{
-				VeyonCore::platform().coreFunctions().writeToNativeLoggingSystem( message, logLevel );
-			}
+			writeMessage( logLevel, formatMessage( logLevel, message ), message );
 
 			m_lastMessage = message;
 			m_lastMessageLevel = logLevel;
@@ -347,6 +396,181 @@ void Logger::log( LogLevel logLevel, const QString& message )
 
 
 
+void Logger::writeMessage( LogLevel logLevel, const QString& message, const QString& rawMessage )
+{
+	const auto timestamp = QDateTime::currentMSecsSinceEpoch();
+
+	if( m_writerThread == nullptr )
+	{
+		writeMessageNow( logLevel, timestamp, message, rawMessage );
+		return;
+	}
+
+	// make sure errors (e.g. explaining a subsequent abort via qFatal()) reach the log in any case
+	if( logLevel <= LogLevel::Error )
+	{
+		QMutexLocker outputLocker( &m_outputMutex );
+		writeQueuedMessages();
+		writeMessageNow( logLevel, timestamp, message, rawMessage );
+		return;
+	}
+
+	QMutexLocker locker( &m_queueMutex );
+
+	// never block the calling thread if the writer thread can't keep up
+	if( m_queuedMessages.size() >= MaximumQueuedMessages )
+	{
+		++m_droppedMessageCount;
+		return;
+	}
+
+	m_queuedMessages.append( { logLevel, timestamp, message, rawMessage } );
+	m_queueCondition.wakeOne();
+}
+
+
+
+void Logger::writeMessageNow( LogLevel logLevel, qint64 timestamp, const QString& message, const QString& rawMessage )
+{
+	outputMessage( message );
+	outputRawMessage( logLevel, timestamp, rawMessage );
+
+	if( m_structuredLogFile )
+	{
+		m_structuredLogFile->flush();
+	}
+}
+
+
+
+void Logger::startWriterThread()
+{
+	m_writerThread = new LogWriterThread( [this]() { processQueuedMessages(); } );
+	m_writerThread->start( QThread::LowPriority );
+}
+
+
+
+void Logger::stopWriterThread()
+{
+	if( m_writerThread == nullptr )
+	{
+		return;
+	}
+
+	m_queueMutex.lock();
+	m_stopWriterThread = true;
+	m_queueCondition.wakeOne();
+	m_queueMutex.unlock();
+
+	m_writerThread->wait();
+
+	// lock log mutex so that no other thread is about to queue a message
+	m_logMutex.lock();
+	delete m_writerThread;
+	m_writerThread = nullptr;
+
+	// output messages which have been queued while the writer thread was exiting
+	m_outputMutex.lock();
+	writeQueuedMessages();
+	m_outputMutex.unlock();
+
+	m_logMutex.unlock();
+}
+
+
+
+void Logger::processQueuedMessages()
+{
+	while( true )
+	{
+		m_queueMutex.lock();
+
+		while( m_queuedMessages.isEmpty() && m_stopWriterThread == false )
+		{
+			m_queueCondition.wait( &m_queueMutex );
+		}
+
+		const auto stop = m_queuedMessages.isEmpty();
+
+		m_queueMutex.unlock();
+
+		if( stop )
+		{
+			break;
+		}
+
+		m_outputMutex.lock();
+		writeQueuedMessages();
+		m_outputMutex.unlock();
+	}
+}
+
+
+
+void Logger::writeQueuedMessages()
+{
+	m_queueMutex.lock();
+	QVector<QueuedMessage> messages;
+	messages.swap( m_queuedMessages );
+	const auto droppedMessageCount = m_droppedMessageCount;
+	m_droppedMessageCount = 0;
+	m_queueMutex.unlock();
+
+	if( messages.isEmpty() && droppedMessageCount == 0 )
+	{
+		return;
+	}
+
+	QString batch;
+	if( droppedMessageCount > 0 )
+	{
+		batch += formatMessage( LogLevel::Warning, QStringLiteral( "%1 messages have been dropped" ).arg( droppedMessageCount ) );
+	}
+
+	// write all messages with the timestamps of the time they were queued at
+	for( const auto& queuedMessage : qAsConst(messages) )
+	{
+		batch += queuedMessage.message;
+		outputRawMessage( queuedMessage.logLevel, queuedMessage.timestamp, queuedMessage.rawMessage );
+	}
+
+	outputMessage( batch );
+
+	if( m_structuredLogFile )
+	{
+		m_structuredLogFile->flush();
+	}
+}
+
+
+
+void Logger::outputRawMessage( LogLevel logLevel, qint64 timestamp, const QString& rawMessage )
+{
+	if( rawMessage.isEmpty() )
+	{
+		return;
+	}
+
+	if( m_logToSystem )
+	{
+		VeyonCore::platform().coreFunctions().writeToNativeLoggingSystem( rawMessage, logLevel );
+	}
+
+	if( m_structuredLog )
+	{
+		if( m_logFileSizeLimit > 0 && m_structuredLogFile->size() > m_logFileSizeLimit )
+		{
+			m_structuredLogFile->resize( 0 );
+			m_structuredLogFile->seek( 0 );
+		}
+
+		m_structuredLog->write( timestamp, int(logLevel), VeyonCore::instance()->sessionId(), rawMessage );
+	}
+}
+
+
+
 void Logger::outputMessage( const QString& message )
 {
 	if( m_logFile )
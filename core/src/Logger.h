@@ -26,10 +26,14 @@
 
 #include <QMutex>
 #include <QTextStream>
+#include <QVector>
+#include <QWaitCondition>
 
 #include "VeyonCore.h"
 
 class QFile;
+class QThread;
+class StructuredLog;
 
 // clazy:excludeall=rule-of-three
 
@@ -55,6 +59,7 @@ public:
 	static constexpr int DefaultFileSizeLimit = 100;
 	static constexpr int DefaultFileRotationCount = 10;
 	static constexpr int MaximumMessageSize = 1000;
+	static constexpr int MaximumQueuedMessages = 10000;
 	static constexpr const char* DefaultLogFileDirectory = "%TEMP%";
 
 	explicit Logger( const QString &appName );
@@ -80,7 +85,16 @@ private:
 	void rotateLogFile();
 
 	void log( LogLevel logLevel, const QString& message );
+	void writeMessage( LogLevel logLevel, const QString& message, const QString& rawMessage = {} );
+	void writeMessageNow( LogLevel logLevel, qint64 timestamp, const QString& message, const QString& rawMessage );
 	void outputMessage( const QString& message );
+	void outputRawMessage( LogLevel logLevel, qint64 timestamp, const QString& rawMessage );
+
+	void startWriterThread();
+	void stopWriterThread();
+	void processQueuedMessages();
+	// requires m_outputMutex to be locked
+	void writeQueuedMessages();
 
 	static QString formatMessage( LogLevel ll, const QString &msg );
 	static void qtMsgHandler( QtMsgType msgType, const QMessageLogContext &, const QString& msg );
@@ -103,4 +117,25 @@ private:
 	int m_logFileSizeLimit{-1};
 	int m_logFileRotationCount{-1};
 
+	QFile* m_structuredLogFile{nullptr};
+	StructuredLog* m_structuredLog{nullptr};
+
+	// asynchronous mode: messages are queued and written in batches by a separate thread
+	struct QueuedMessage
+	{
+		LogLevel logLevel;
+		qint64 timestamp;
+		QString message;
+		QString rawMessage;
+	};
+
+	QThread* m_writerThread{nullptr};
+	// serializes output of the writer thread and messages written synchronously
+	QMutex m_outputMutex{};
+	QMutex m_queueMutex{};
+	QWaitCondition m_queueCondition{};
+	QVector<QueuedMessage> m_queuedMessages{};
+	int m_droppedMessageCount{0};
+	bool m_stopWriterThread{false};
+
 } ;
@@ -0,0 +1,151 @@
+/*
+ * Metrics.cpp - implementation of Metrics class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include <QMap>
+#include <QMutex>
+
+#include <array>
+
+#include "Metrics.h"
+
+
+namespace {
+
+constexpr std::array<double, 10> HistogramBuckets{ 0.001, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 5 };
+
+struct Histogram
+{
+	std::array<qint64, HistogramBuckets.size()> bucketCounts{};
+	double sum{0};
+	qint64 count{0};
+};
+
+}
+
+static QMutex __metricsMutex;
+static QMap<QString, qint64> __counters;
+static QMap<QString, Histogram> __histograms;
+
+QAtomicInt Metrics::s_enabled{0};
+
+
+void Metrics::setEnabled( bool enabled )
+{
+	s_enabled.storeRelease( enabled ? 1 : 0 );
+}
+
+
+
+void Metrics::increment( const char* name, qint64 value, const QString& label, const QString& labelValue )
+{
+	if( isEnabled() == false )
+	{
+		return;
+	}
+
+	const auto series = seriesName( name, label, labelValue );
+
+	QMutexLocker locker( &__metricsMutex );
+	__counters[series] += value;
+}
+
+
+
+void Metrics::observe( const char* name, double value )
+{
+	if( isEnabled() == false )
+	{
+		return;
+	}
+
+	const auto series = QString::fromLatin1( name );
+
+	QMutexLocker locker( &__metricsMutex );
+
+	auto& histogram = __histograms[series];
+	for( size_t i = 0; i < HistogramBuckets.size(); ++i )
+	{
+		if( value <= HistogramBuckets[i] )
+		{
+			++histogram.bucketCounts[i];
+		}
+	}
+	histogram.sum += value;
+	++histogram.count;
+}
+
+
+
+QByteArray Metrics::toPrometheusText()
+{
+	QByteArray text;
+	QString lastName;
+
+	QMutexLocker locker( &__metricsMutex );
+
+	for( auto it = __counters.constBegin(), end = __counters.constEnd(); it != end; ++it )
+	{
+		const auto name = it.key().section( QLatin1Char('{'), 0, 0 );
+		if( name != lastName )
+		{
+			text += "# TYPE " + name.toLatin1() + " counter\n";
+			lastName = name;
+		}
+		text += it.key().toUtf8() + ' ' + QByteArray::number( it.value() ) + '\n';
+	}
+
+	for( auto it = __histograms.constBegin(), end = __histograms.constEnd(); it != end; ++it )
+	{
+		const auto name = it.key().toLatin1();
+		const auto& histogram = it.value();
+
+		text += "# TYPE " + name + " histogram\n";
+		for( size_t i = 0; i < HistogramBuckets.size(); ++i )
+		{
+			text += name + "_bucket{le=\"" + QByteArray::number( HistogramBuckets[i] ) + "\"} " +
+					QByteArray::number( histogram.bucketCounts[i] ) + '\n';
+		}
+		text += name + "_bucket{le=\"+Inf\"} " + QByteArray::number( histogram.count ) + '\n';
+		text += name + "_sum " + QByteArray::number( histogram.sum ) + '\n';
+		text += name + "_count " + QByteArray::number( histogram.count ) + '\n';
+	}
+
+	return text;
+}
+
+
+
+QString Metrics::seriesName( const char* name, const QString& label, const QString& labelValue )
+{
+	if( label.isEmpty() )
+	{
+		return QString::fromLatin1( name );
+	}
+
+	auto escapedValue = labelValue;
+	escapedValue.replace( QLatin1Char('\\'), QStringLiteral("\\\\") ).replace( QLatin1Char('"'), QStringLiteral("\\\"") );
+
+	return QStringLiteral("%1{%2=\"%3\"}").arg( QString::fromLatin1( name ), label, escapedValue );
+}
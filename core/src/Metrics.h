@@ -0,0 +1,56 @@
+/*
+ * Metrics.h - declaration of Metrics class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#pragma once
+
+#include <QAtomicInt>
+
+#include "VeyonCore.h"
+
+// process-wide registry of counters and histograms which can be exported in the
+// Prometheus text exposition format - recording is a no-op unless enabled
+class VEYON_CORE_EXPORT Metrics
+{
+public:
+	static bool isEnabled()
+	{
+		return s_enabled.loadAcquire() != 0;
+	}
+
+	static void setEnabled( bool enabled );
+
+	static void increment( const char* name, qint64 value = 1, const QString& label = {}, const QString& labelValue = {} );
+
+	// durations and other values to be aggregated into fixed buckets (in seconds)
+	static void observe( const char* name, double value );
+
+	static QByteArray toPrometheusText();
+
+private:
+	static QString seriesName( const char* name, const QString& label, const QString& labelValue );
+
+	static QAtomicInt s_enabled;
+
+} ;
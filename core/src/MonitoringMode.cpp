@@ -181,6 +181,7 @@ bool MonitoringMode::handleFeatureMessage( ComputerControlInterface::Pointer com
 			screenProperties.index = i + 1;
 			screenProperties.name = screenInfo.value(QStringLiteral("name")).toString();
 			screenProperties.geometry = screenInfo.value(QStringLiteral("geometry")).toRect();
+			screenProperties.devicePixelRatio = screenInfo.value(QStringLiteral("devicePixelRatio"), 1).toReal();
 			screens.append(screenProperties);
 		}
 
@@ -330,6 +331,8 @@ void MonitoringMode::updateActiveFeatures()
 		{
 			m_activeFeatures = activeFeatures;
 			m_activeFeaturesVersion++;
+
+			Q_EMIT stateChanged();
 		}
 	}
 }
@@ -355,8 +358,14 @@ void MonitoringMode::updateUserData()
 				m_userFullName = userFullName;
 				m_userSessionId = userSessionId;
 				++m_userInfoVersion;
+				m_userDataLock.unlock();
+
+				Q_EMIT stateChanged();
+			}
+			else
+			{
+				m_userDataLock.unlock();
 			}
-			m_userDataLock.unlock();
 		}
 	} );
 }
@@ -376,6 +385,7 @@ void MonitoringMode::updateScreenInfoList()
 		QVariantMap screenInfo;
 		screenInfo[QStringLiteral("name")] = VeyonCore::screenName(*screen, index);
 		screenInfo[QStringLiteral("geometry")] = screen->geometry();
+		screenInfo[QStringLiteral("devicePixelRatio")] = screen->devicePixelRatio();
 		screenInfoList.append(screenInfo);
 		++index;
 
@@ -386,5 +396,7 @@ void MonitoringMode::updateScreenInfoList()
 	{
 		m_screenInfoList = screenInfoList;
 		++m_screenInfoListVersion;
+
+		Q_EMIT stateChanged();
 	}
 }
@@ -45,6 +45,12 @@ public:
 	};
 	Q_ENUM(Argument)
 
+	enum Command
+	{
+		Ping,
+		SetMinimumFramebufferUpdateInterval
+	};
+
 	explicit MonitoringMode( QObject* parent = nullptr );
 
 	const Feature& feature() const
@@ -52,6 +58,26 @@ public:
 		return m_monitoringModeFeature;
 	}
 
+	const Feature& queryApplicationVersionFeature() const
+	{
+		return m_queryApplicationVersionFeature;
+	}
+
+	const Feature& queryActiveFeaturesFeature() const
+	{
+		return m_queryActiveFeatures;
+	}
+
+	const Feature& queryLoggedOnUserInfoFeature() const
+	{
+		return m_queryLoggedOnUserInfoFeature;
+	}
+
+	const Feature& queryScreensFeature() const
+	{
+		return m_queryScreensFeature;
+	}
+
 	Plugin::Uid uid() const override
 	{
 		return Plugin::Uid{ QStringLiteral("1a6a59b1-c7a1-43cc-bcab-c136a4d91be8") };
@@ -144,12 +170,6 @@ private:
 	void updateUserData();
 	void updateScreenInfoList();
 
-	enum Command
-	{
-		Ping,
-		SetMinimumFramebufferUpdateInterval
-	};
-
 	static constexpr int ActiveFeaturesUpdateInterval = 250;
 
 	const Feature m_monitoringModeFeature;
@@ -172,4 +192,14 @@ private:
 	QVariantList m_screenInfoList;
 	int m_screenInfoListVersion{0};
 
+public:
+	int userInfoVersion() const
+	{
+		return m_userInfoVersion.loadAcquire();
+	}
+
+Q_SIGNALS:
+	// emitted (possibly from a worker thread) whenever data served via sendAsyncFeatureMessages() changed
+	void stateChanged();
+
 };
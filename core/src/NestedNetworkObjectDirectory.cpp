@@ -22,6 +22,8 @@
  *
  */
 
+#include <QTimer>
+
 #include "NestedNetworkObjectDirectory.h"
 
 
@@ -78,9 +80,13 @@ void NestedNetworkObjectDirectory::update()
 											{}, rootObject().uid() };
 		addOrUpdateObject( subDirectoryObject, rootObject() );
 
-		subDirectory->update();
+		// only synchronize sub-directories which have been populated on demand before
+		if( isSubDirectoryPopulated( subDirectoryObject ) )
+		{
+			subDirectory->update();
 
-		replaceObjectsRecursively( subDirectory, subDirectoryObject );
+			replaceObjectsRecursively( subDirectory, subDirectoryObject );
+		}
 	}
 
 	removeObjects( rootObject(), [subDirectoryNames]( const NetworkObject& object ) {
@@ -100,12 +106,74 @@ void NestedNetworkObjectDirectory::fetchObjects( const NetworkObject& parent )
 		parent.directory()->fetchObjects( parent );
 		replaceObjects( parent.directory()->objects(parent), parent );
 	}
+	else if( parent.type() == NetworkObject::Type::SubDirectory )
+	{
+		populateSubDirectory( parent );
+
+		// load remaining sub-directories one after another while idle so they
+		// are likely available once the user expands them
+		QTimer::singleShot( 0, this, &NestedNetworkObjectDirectory::prefetchSubDirectory );
+		return;
+	}
 
 	setObjectPopulated( parent );
 }
 
 
 
+void NestedNetworkObjectDirectory::populateSubDirectory( const NetworkObject& subDirectoryObject )
+{
+	auto* subDirectory = findSubDirectory( subDirectoryObject.name() );
+	if( subDirectory )
+	{
+		subDirectory->update();
+		replaceObjectsRecursively( subDirectory, subDirectoryObject );
+	}
+
+	setObjectPopulated( subDirectoryObject );
+}
+
+
+
+void NestedNetworkObjectDirectory::prefetchSubDirectory()
+{
+	const auto subDirectoryObjects = objects( rootObject() );
+	for( const auto& subDirectoryObject : subDirectoryObjects )
+	{
+		if( subDirectoryObject.type() == NetworkObject::Type::SubDirectory &&
+			subDirectoryObject.isPopulated() == false )
+		{
+			populateSubDirectory( subDirectoryObject );
+			QTimer::singleShot( 0, this, &NestedNetworkObjectDirectory::prefetchSubDirectory );
+			return;
+		}
+	}
+}
+
+
+
+bool NestedNetworkObjectDirectory::isSubDirectoryPopulated( const NetworkObject& subDirectoryObject ) const
+{
+	return object( rootId(), subDirectoryObject.modelId() ).isPopulated();
+}
+
+
+
+NetworkObjectDirectory* NestedNetworkObjectDirectory::findSubDirectory( const QString& name ) const
+{
+	for( auto* subDirectory : m_subDirectories )
+	{
+		if( subDirectory->name() == name )
+		{
+			return subDirectory;
+		}
+	}
+
+	return nullptr;
+}
+
+
+
 void NestedNetworkObjectDirectory::replaceObjectsRecursively( NetworkObjectDirectory* directory,
 															   const NetworkObject& parent )
 {
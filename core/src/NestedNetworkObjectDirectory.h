@@ -42,6 +42,11 @@ public:
 	void fetchObjects( const NetworkObject& parent ) override;
 
 private:
+	void populateSubDirectory( const NetworkObject& subDirectoryObject );
+	void prefetchSubDirectory();
+	bool isSubDirectoryPopulated( const NetworkObject& subDirectoryObject ) const;
+	NetworkObjectDirectory* findSubDirectory( const QString& name ) const;
+
 	void replaceObjectsRecursively( NetworkObjectDirectory* directory,
 								   const NetworkObject& parent );
 
@@ -71,7 +71,7 @@ NetworkObject::NetworkObject( NetworkObjectDirectory* directory,
 
 NetworkObject::NetworkObject( const QJsonObject& jsonObject, NetworkObjectDirectory* directory ) :
 	m_directory( directory ),
-	m_properties( jsonObject.toVariantMap() ),
+	m_properties( internedProperties( jsonObject ) ),
 	m_type( Type( jsonObject.value( propertyKey( Property::Type ) ).toInt() ) ),
 	m_name( jsonObject.value( propertyKey( Property::Name ) ).toString() ),
 	m_uid( jsonObject.value( propertyKey( Property::Uid ) ).toString() ),
@@ -174,7 +174,18 @@ QVariant NetworkObject::property( Property property ) const
 
 QString NetworkObject::propertyKey( Property property )
 {
-	return EnumHelper::toString(property);
+	// share the key strings between all lookups and property maps instead of
+	// allocating them again for each of possibly tens of thousands of objects
+	static const auto propertyKeys = []() {
+		QVector<QString> keys;
+		for( int i = int(Property::None); i <= int(Property::DirectoryAddress); ++i )
+		{
+			keys.append( EnumHelper::toString( Property(i) ) );
+		}
+		return keys;
+	}();
+
+	return propertyKeys.value( int(property) );
 }
 
 
@@ -222,6 +233,31 @@ bool NetworkObject::isPropertyValueEqual( NetworkObject::Property property,
 
 
 
+NetworkObject::Properties NetworkObject::internedProperties( const QJsonObject& jsonObject )
+{
+	Properties properties;
+
+	for( auto it = jsonObject.begin(), end = jsonObject.end(); it != end; ++it )
+	{
+		auto key = it.key();
+		for( int i = int(Property::Type); i <= int(Property::DirectoryAddress); ++i )
+		{
+			const auto propertyKey = NetworkObject::propertyKey( Property(i) );
+			if( key == propertyKey )
+			{
+				key = propertyKey;
+				break;
+			}
+		}
+
+		properties.insert( key, it.value().toVariant() );
+	}
+
+	return properties;
+}
+
+
+
 NetworkObject::Uid NetworkObject::calculateUid() const
 {
 	// if a directory address is set (e.g. full DN in LDAP) it should be unique and can be
@@ -150,6 +150,8 @@ public:
 	bool isPropertyValueEqual( Property property, const QVariant& value, Qt::CaseSensitivity cs ) const;
 
 private:
+	static Properties internedProperties( const QJsonObject& jsonObject );
+
 	Uid calculateUid() const;
 
 	NetworkObjectDirectory* m_directory;
@@ -22,6 +22,7 @@
  *
  */
 
+#include <QSet>
 #include <QTimer>
 
 #include "VeyonConfiguration.h"
@@ -97,6 +98,24 @@ const NetworkObject& NetworkObjectDirectory::object( NetworkObject::ModelId pare
 
 
 
+const NetworkObject& NetworkObjectDirectory::object( NetworkObject::ModelId object ) const
+{
+	if( object == rootId() )
+	{
+		return m_rootObject;
+	}
+
+	const auto it = m_parentIds.constFind( object );
+	if( it != m_parentIds.constEnd() )
+	{
+		return NetworkObjectDirectory::object( it.value(), object );
+	}
+
+	return m_invalidObject;
+}
+
+
+
 int NetworkObjectDirectory::index( NetworkObject::ModelId parent, NetworkObject::ModelId child ) const
 {
 	const auto it = m_objects.constFind( parent );
@@ -154,20 +173,7 @@ NetworkObject::ModelId NetworkObjectDirectory::parentId( NetworkObject::ModelId
 		return 0;
 	}
 
-	for( auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it )
-	{
-		const auto& objectList = it.value();
-
-		for( const auto& object : objectList )
-		{
-			if( object.modelId() == child )
-			{
-				return it.key();
-			}
-		}
-	}
-
-	return 0;
+	return m_parentIds.value( child, 0 );
 }
 
 
@@ -190,6 +196,35 @@ NetworkObjectList NetworkObjectDirectory::queryObjects( NetworkObject::Type type
 
 	NetworkObjectList objects;
 
+	// try a lookup via the index first and only fall back to a full scan (which
+	// also matches equivalent host addresses in different formats) if nothing was found
+	const QMultiHash<QString, NetworkObject::ModelId>* lookupIndex = nullptr;
+	switch( property )
+	{
+	case NetworkObject::Property::Name: lookupIndex = &m_nameIndex; break;
+	case NetworkObject::Property::HostAddress: lookupIndex = &m_hostAddressIndex; break;
+	default: break;
+	}
+
+	if( lookupIndex )
+	{
+		const auto candidates = lookupIndex->values( indexKey( value.toString() ) );
+		for( const auto& candidate : candidates )
+		{
+			const auto& object = NetworkObjectDirectory::object( candidate );
+			if( ( type == NetworkObject::Type::None || object.type() == type ) &&
+				object.isPropertyValueEqual( property, value, Qt::CaseInsensitive ) )
+			{
+				objects.append( object );
+			}
+		}
+
+		if( objects.isEmpty() == false )
+		{
+			return objects;
+		}
+	}
+
 	for( auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it )
 	{
 		const auto& objectList = it.value();
@@ -222,16 +257,13 @@ NetworkObjectList NetworkObjectDirectory::queryParents( const NetworkObject& chi
 		return {};
 	}
 
-	for( auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it )
+	const auto it = m_uidIndex.constFind( child.parentUid() );
+	if( it != m_uidIndex.constEnd() )
 	{
-		const auto& objectList = it.value();
-
-		for( const auto& object : objectList )
+		const auto& parent = object( it.value() );
+		if( parent.isValid() && parent.type() != NetworkObject::Type::Root )
 		{
-			if( object.uid() == child.parentUid() )
-			{
-				return queryParents( object ) + NetworkObjectList( { object } );
-			}
+			return queryParents( parent ) + NetworkObjectList( { parent } );
 		}
 	}
 
@@ -287,11 +319,15 @@ void NetworkObjectDirectory::addOrUpdateObject( const NetworkObject& networkObje
 			m_objects[completeNetworkObject.modelId()] = {};
 		}
 
+		addToIndex( completeNetworkObject, parent.modelId() );
+
 		Q_EMIT objectsInserted();
 	}
 	else if( objectList[index].exactMatch( completeNetworkObject ) == false )
 	{
+		removeFromIndex( objectList[index] );
 		objectList.replace( index, completeNetworkObject );
+		addToIndex( completeNetworkObject, parent.modelId() );
 		Q_EMIT objectChanged( parent, index );
 	}
 }
@@ -309,29 +345,41 @@ void NetworkObjectDirectory::removeObjects( const NetworkObject& parent, const N
 	int index = 0;
 	QList<NetworkObject::ModelId> objectsToRemove;
 
-	for( auto it = objectList.begin(); it != objectList.end(); )
+	while( index < objectList.count() )
 	{
-		if( removeObjectFilter( *it ) )
+		if( removeObjectFilter( objectList[index] ) == false )
 		{
-			if( it->isContainer() )
-			{
-				objectsToRemove.append( it->modelId() );
-			}
+			++index;
+			continue;
+		}
 
-			Q_EMIT objectsAboutToBeRemoved( parent, index, 1 );
-			it = objectList.erase( it );
-			Q_EMIT objectsRemoved();
+		// remove contiguous ranges at once so attached views are notified only once per range
+		int count = 1;
+		while( index + count < objectList.count() && removeObjectFilter( objectList[index + count] ) )
+		{
+			++count;
 		}
-		else
+
+		Q_EMIT objectsAboutToBeRemoved( parent, index, count );
+
+		for( int i = index; i < index + count; ++i )
 		{
-			++it;
-			++index;
+			const auto& object = objectList[i];
+			if( object.isContainer() )
+			{
+				objectsToRemove.append( object.modelId() );
+			}
+			removeFromIndex( object );
 		}
+
+		objectList.erase( objectList.begin() + index, objectList.begin() + index + count );
+
+		Q_EMIT objectsRemoved();
 	}
 
 	for( const auto& groupId : objectsToRemove )
 	{
-		m_objects.remove( groupId );
+		removeChildObjects( groupId );
 	}
 }
 
@@ -339,12 +387,128 @@ void NetworkObjectDirectory::removeObjects( const NetworkObject& parent, const N
 
 void NetworkObjectDirectory::replaceObjects( const NetworkObjectList& objects, const NetworkObject& parent )
 {
+	if( m_objects.contains( parent.modelId() ) == false )
+	{
+		vCritical() << "parent" << parent.toJson() << "does not exist";
+		return;
+	}
+
+	NetworkObjectList completeObjects;
+	completeObjects.reserve( objects.count() );
+
+	QSet<NetworkObject::Uid> uids;
+	uids.reserve( objects.count() );
+
 	for( const auto& object : objects )
 	{
-		addOrUpdateObject( object, parent );
+		auto completeObject = object;
+		if( completeObject.parentUid().isNull() )
+		{
+			completeObject.setParentUid( parent.uid() );
+		}
+		uids.insert( completeObject.uid() );
+		completeObjects.append( completeObject );
+	}
+
+	removeObjects( parent, [&uids]( const NetworkObject& object ) { return uids.contains( object.uid() ) == false; } );
+
+	auto& objectList = m_objects[parent.modelId()]; // clazy:exclude=detaching-member
+
+	QHash<NetworkObject::Uid, int> positions;
+	positions.reserve( objectList.count() );
+	for( int i = 0; i < objectList.count(); ++i )
+	{
+		positions[objectList[i].uid()] = i;
+	}
+
+	NetworkObjectList newObjects;
+
+	for( const auto& object : qAsConst(completeObjects) )
+	{
+		const auto it = positions.constFind( object.uid() );
+		if( it == positions.constEnd() )
+		{
+			positions[object.uid()] = -1;
+			newObjects.append( object );
+		}
+		else if( it.value() >= 0 && objectList[it.value()].exactMatch( object ) == false )
+		{
+			removeFromIndex( objectList[it.value()] );
+			objectList.replace( it.value(), object );
+			addToIndex( object, parent.modelId() );
+			Q_EMIT objectChanged( parent, it.value() );
+		}
+	}
+
+	if( newObjects.isEmpty() )
+	{
+		return;
+	}
+
+	Q_EMIT objectsAboutToBeInserted( parent, objectList.count(), newObjects.count() );
+
+	objectList.append( newObjects );
+
+	// objectList must not be accessed anymore as inserting into m_objects may invalidate it
+	for( const auto& object : qAsConst(newObjects) )
+	{
+		if( object.isContainer() )
+		{
+			m_objects[object.modelId()] = {};
+		}
+		addToIndex( object, parent.modelId() );
+	}
+
+	Q_EMIT objectsInserted();
+}
+
+
+
+void NetworkObjectDirectory::removeChildObjects( NetworkObject::ModelId parent )
+{
+	const auto children = m_objects.take( parent );
+	for( const auto& child : children )
+	{
+		removeFromIndex( child );
+		if( child.isContainer() )
+		{
+			removeChildObjects( child.modelId() );
+		}
+	}
+}
+
+
+
+void NetworkObjectDirectory::addToIndex( const NetworkObject& object, NetworkObject::ModelId parent )
+{
+	const auto modelId = object.modelId();
+
+	m_parentIds[modelId] = parent;
+	m_uidIndex[object.uid()] = modelId;
+	m_nameIndex.insert( indexKey( object.name() ), modelId );
+
+	const auto hostAddress = object.property( NetworkObject::Property::HostAddress ).toString();
+	if( hostAddress.isEmpty() == false )
+	{
+		m_hostAddressIndex.insert( indexKey( hostAddress ), modelId );
 	}
+}
 
-	removeObjects( parent, [&objects]( const NetworkObject& object ) { return objects.contains( object ) == false; } );
+
+
+void NetworkObjectDirectory::removeFromIndex( const NetworkObject& object )
+{
+	const auto modelId = object.modelId();
+
+	m_parentIds.remove( modelId );
+	m_uidIndex.remove( object.uid() );
+	m_nameIndex.remove( indexKey( object.name() ), modelId );
+
+	const auto hostAddress = object.property( NetworkObject::Property::HostAddress ).toString();
+	if( hostAddress.isEmpty() == false )
+	{
+		m_hostAddressIndex.remove( indexKey( hostAddress ), modelId );
+	}
 }
 
 
@@ -53,6 +53,7 @@ public:
 	const NetworkObjectList& objects( const NetworkObject& parent ) const;
 
 	const NetworkObject& object( NetworkObject::ModelId parent, NetworkObject::ModelId object ) const;
+	const NetworkObject& object( NetworkObject::ModelId object ) const;
 	int index( NetworkObject::ModelId parent, NetworkObject::ModelId child ) const;
 	int childCount( NetworkObject::ModelId parent ) const;
 	NetworkObject::ModelId childId( NetworkObject::ModelId parent, int index ) const;
@@ -82,9 +83,22 @@ protected:
 	void setObjectPopulated( const NetworkObject& networkObject );
 
 private:
+	void removeChildObjects( NetworkObject::ModelId parent );
+	void addToIndex( const NetworkObject& object, NetworkObject::ModelId parent );
+	void removeFromIndex( const NetworkObject& object );
+
+	static QString indexKey( const QString& value )
+	{
+		return value.toLower();
+	}
+
 	const QString m_name;
 	QTimer* m_updateTimer{nullptr};
 	QHash<NetworkObject::ModelId, NetworkObjectList> m_objects{};
+	QHash<NetworkObject::ModelId, NetworkObject::ModelId> m_parentIds{};
+	QHash<NetworkObject::Uid, NetworkObject::ModelId> m_uidIndex{};
+	QMultiHash<QString, NetworkObject::ModelId> m_nameIndex{};
+	QMultiHash<QString, NetworkObject::ModelId> m_hostAddressIndex{};
 	NetworkObject m_invalidObject{this, NetworkObject::Type::None};
 	NetworkObject m_rootObject{this, NetworkObject::Type::Root};
 	NetworkObjectList m_defaultObjectList{};
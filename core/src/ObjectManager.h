@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <QHash>
 #include <QJsonArray>
 
 #include "VeyonCore.h"
@@ -72,6 +73,34 @@ public:
 		return m_objects;
 	}
 
+	const QJsonArray& update( const QVector<T>& objects, bool addIfNotFound = false )
+	{
+		// look up existing objects via a hash instead of scanning the list for every object
+		QHash<typename T::Uid, int> indexes;
+		indexes.reserve( m_objects.size() );
+
+		for( int i = 0; i < m_objects.size(); ++i )
+		{
+			indexes.insert( T( m_objects.at( i ).toObject() ).uid(), i );
+		}
+
+		for( const auto& object : objects )
+		{
+			const auto it = indexes.constFind( object.uid() );
+			if( it != indexes.constEnd() )
+			{
+				m_objects[it.value()] = object.toJson();
+			}
+			else if( addIfNotFound )
+			{
+				indexes.insert( object.uid(), m_objects.size() );
+				add( object );
+			}
+		}
+
+		return m_objects;
+	}
+
 	const QJsonArray& remove( typename T::Uid objectUid, bool recursive = false )
 	{
 		if( recursive )
@@ -47,6 +47,8 @@ public:
 	virtual bool isRunning( const QString& name ) = 0;
 	virtual bool start( const QString& name ) = 0;
 	virtual bool stop( const QString& name ) = 0;
+	// apply changed configuration without restarting unaffected server instances
+	virtual bool reload( const QString& name ) = 0;
 	virtual bool install( const QString& name, const QString& filePath,
 						  StartMode startMode, const QString& displayName ) = 0;
 	virtual bool uninstall( const QString& name ) = 0;
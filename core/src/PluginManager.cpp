@@ -25,11 +25,16 @@
 #include <veyonconfig.h>
 
 #include <QCoreApplication>
+#include <QDateTime>
 #include <QDir>
+#include <QJsonDocument>
 #include <QPluginLoader>
+#include <QSaveFile>
+#include <QStandardPaths>
 
 #include "Logger.h"
 #include "PluginManager.h"
+#include "Tracer.h"
 #include "VeyonConfiguration.h"
 
 
@@ -180,6 +185,8 @@ void PluginManager::loadPlugins( const QString& nameFilter )
 		plugins.append(QDir(pluginSearchPath).entryInfoList({nameFilter}));
 	}
 
+	loadManifest();
+
 	for( const auto& fileInfo : plugins )
 	{
 		const auto fileName = fileInfo.fileName();
@@ -191,6 +198,17 @@ void PluginManager::loadPlugins( const QString& nameFilter )
 			continue;
 		}
 
+		// skip files which are no Veyon plugins or which provide an already loaded plugin
+		// (e.g. platform plugins or the same plugin in multiple search paths)
+		const auto interfaceId = pluginInterfaceId( fileInfo );
+		if( interfaceId.startsWith( QLatin1String("io.veyon.Veyon.Plugins.") ) == false ||
+			m_loadedPluginInterfaceIds.contains( interfaceId ) )
+		{
+			continue;
+		}
+
+		const Tracer::Scope traceScope( "PluginManager::loadPlugin", fileName );
+
 		auto pluginLoader = new QPluginLoader( fileInfo.filePath(), this );
 		auto pluginObject = pluginLoader->instance();
 		auto pluginInterface = qobject_cast<PluginInterface *>( pluginObject );
@@ -205,10 +223,106 @@ void PluginManager::loadPlugins( const QString& nameFilter )
 			m_pluginInterfaces += pluginInterface;	// clazy:exclude=reserve-candidates
 			m_pluginObjects += pluginObject;		// clazy:exclude=reserve-candidates
 			m_pluginLoaders += pluginLoader;			// clazy:exclude=reserve-candidates
+			m_loadedPluginInterfaceIds.insert( interfaceId );
 		}
 		else
 		{
 			delete pluginLoader;
 		}
 	}
+
+	saveManifest();
+}
+
+
+
+QString PluginManager::pluginInterfaceId( const QFileInfo& fileInfo )
+{
+	const auto filePath = fileInfo.absoluteFilePath();
+	const auto size = fileInfo.size();
+	const auto lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+	const auto entry = m_manifest.value( filePath ).toObject();
+	if( entry.value( QStringLiteral("size") ).toDouble() == double(size) &&
+		entry.value( QStringLiteral("lastModified") ).toDouble() == double(lastModified) )
+	{
+		return entry.value( QStringLiteral("iid") ).toString();
+	}
+
+	// reading metadata does not load the library
+	const auto interfaceId = QPluginLoader( filePath ).metaData().value( QStringLiteral("IID") ).toString();
+
+	m_manifest[filePath] = QJsonObject{
+		{ QStringLiteral("size"), double(size) },
+		{ QStringLiteral("lastModified"), double(lastModified) },
+		{ QStringLiteral("iid"), interfaceId }
+	};
+	m_manifestChanged = true;
+
+	return interfaceId;
+}
+
+
+
+QString PluginManager::manifestFilePath()
+{
+	return QStandardPaths::writableLocation( QStandardPaths::CacheLocation ) + QDir::separator() +
+		   QStringLiteral("plugin-manifest.json");
+}
+
+
+
+void PluginManager::loadManifest()
+{
+	if( m_manifestLoaded )
+	{
+		return;
+	}
+
+	m_manifestLoaded = true;
+
+	QFile manifestFile( manifestFilePath() );
+	if( manifestFile.open( QFile::ReadOnly ) )
+	{
+		const auto manifest = QJsonDocument::fromJson( manifestFile.readAll() ).object();
+		if( manifest.value( QStringLiteral("version") ).toInt() == ManifestVersion &&
+			manifest.value( QStringLiteral("veyonVersion") ).toString() == VeyonCore::versionString() )
+		{
+			m_manifest = manifest.value( QStringLiteral("plugins") ).toObject();
+		}
+	}
+}
+
+
+
+void PluginManager::saveManifest()
+{
+	if( m_manifestChanged == false )
+	{
+		return;
+	}
+
+	const auto filePath = manifestFilePath();
+	if( QDir().mkpath( QFileInfo( filePath ).absolutePath() ) == false )
+	{
+		return;
+	}
+
+	const QJsonObject manifest{
+		{ QStringLiteral("version"), ManifestVersion },
+		{ QStringLiteral("veyonVersion"), VeyonCore::versionString() },
+		{ QStringLiteral("plugins"), m_manifest }
+	};
+
+	QSaveFile manifestFile( filePath );
+	if( manifestFile.open( QFile::WriteOnly ) &&
+		manifestFile.write( QJsonDocument( manifest ).toJson( QJsonDocument::Compact ) ) > 0 &&
+		manifestFile.commit() )
+	{
+		m_manifestChanged = false;
+	}
+	else if( m_noDebugMessages == false )
+	{
+		vDebug() << "could not write plugin manifest" << filePath;
+	}
 }
@@ -24,11 +24,14 @@
 
 #pragma once
 
+#include <QJsonObject>
 #include <QObject>
+#include <QSet>
 
 #include "Plugin.h"
 #include "PluginInterface.h"
 
+class QFileInfo;
 class QPluginLoader;
 
 class VEYON_CORE_EXPORT PluginManager : public QObject
@@ -77,7 +80,20 @@ private:
 	void initPluginSearchPath();
 	void loadPlugins( const QString& nameFilter );
 
+	// the manifest caches plugin metadata per file so files which are not (new) Veyon
+	// plugins can be skipped without opening or even scanning them
+	QString pluginInterfaceId( const QFileInfo& fileInfo );
+	static QString manifestFilePath();
+	void loadManifest();
+	void saveManifest();
+
+	static constexpr int ManifestVersion = 1;
+
 	QStringList m_pluginSearchPaths;
+	QJsonObject m_manifest;
+	bool m_manifestLoaded{false};
+	bool m_manifestChanged{false};
+	QSet<QString> m_loadedPluginInterfaceIds;
 	PluginInterfaceList m_pluginInterfaces{};
 	QObjectList m_pluginObjects{};
 	QList<QPluginLoader *> m_pluginLoaders{};
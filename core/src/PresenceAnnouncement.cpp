@@ -0,0 +1,57 @@
+/*
+ * PresenceAnnouncement.cpp - implementation of PresenceAnnouncement class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include "PresenceAnnouncement.h"
+
+
+static const auto presenceAnnouncementPrefix = QByteArrayLiteral("VEYON-PRESENCE/1 ");
+
+
+QByteArray PresenceAnnouncement::create( Event event, const QString& hostName )
+{
+	return ( presenceAnnouncementPrefix + QByteArray::number( int(event) ) + ' ' + hostName.toUtf8() ).left( MaximumSize );
+}
+
+
+
+bool PresenceAnnouncement::parse( const QByteArray& datagram, Event* event, QString* hostName )
+{
+	if( datagram.size() > MaximumSize || datagram.startsWith( presenceAnnouncementPrefix ) == false )
+	{
+		return false;
+	}
+
+	const auto fields = datagram.mid( presenceAnnouncementPrefix.size() ).split( ' ' );
+	bool ok = false;
+	const auto eventValue = fields.value( 0 ).toInt( &ok );
+	if( ok == false || eventValue < int(Event::Started) || eventValue > int(Event::SessionChanged) )
+	{
+		return false;
+	}
+
+	*event = Event(eventValue);
+	*hostName = QString::fromUtf8( fields.value( 1 ) );
+
+	return true;
+}
@@ -0,0 +1,48 @@
+/*
+ * PresenceAnnouncement.h - declaration of PresenceAnnouncement class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include "VeyonCore.h"
+
+// datagrams broadcast by veyon-server on the local subnet (if enabled) so masters
+// can connect to computers as soon as they come online instead of polling them
+class VEYON_CORE_EXPORT PresenceAnnouncement
+{
+	Q_GADGET
+public:
+	enum class Event
+	{
+		Started,
+		Stopped,
+		SessionChanged
+	};
+	Q_ENUM(Event)
+
+	static constexpr int MaximumSize = 512;
+
+	static QByteArray create( Event event, const QString& hostName );
+	static bool parse( const QByteArray& datagram, Event* event, QString* hostName );
+
+} ;
@@ -22,6 +22,10 @@
  *
  */
 
+#include <QTimer>
+
+#include <memory>
+
 #include "ProcessHelper.h"
 
 
@@ -55,3 +59,65 @@ QByteArray ProcessHelper::runAndReadAll()
 
 	return QByteArray();
 }
+
+
+
+void ProcessHelper::runAsync( const QString& program, const QStringList& arguments, int timeout, QObject* context,
+							  const ResultHandler& resultHandler, const OutputHandler& outputHandler )
+{
+	// owned by context so that nothing is called on a destroyed context
+	auto process = new QProcess( context );
+	auto result = std::make_shared<Result>();
+	auto finished = std::make_shared<bool>( false );
+
+	const auto finish = [=]() {
+		if( *finished )
+		{
+			return;
+		}
+		*finished = true;
+
+		if( resultHandler )
+		{
+			resultHandler( *result );
+		}
+		process->deleteLater();
+	};
+
+	QObject::connect( process, &QProcess::readyReadStandardOutput, process, [=]() {
+		const auto data = process->readAllStandardOutput();
+		if( outputHandler )
+		{
+			outputHandler( data );
+		}
+		else
+		{
+			result->output.append( data );
+		}
+	} );
+
+	QObject::connect( process, QOverload<int, QProcess::ExitStatus>::of( &QProcess::finished ), process,
+					  [=]( int exitCode, QProcess::ExitStatus exitStatus ) {
+		result->exitCode = exitStatus == QProcess::NormalExit ? exitCode : -1;
+		finish();
+	} );
+
+	QObject::connect( process, &QProcess::errorOccurred, process, [=]( QProcess::ProcessError error ) {
+		if( error == QProcess::FailedToStart )
+		{
+			vWarning() << "failed to start" << program << process->errorString();
+			finish();
+		}
+	} );
+
+	if( timeout > 0 )
+	{
+		QTimer::singleShot( timeout, process, [=]() {
+			result->timedOut = true;
+			vWarning() << program << "did not finish within" << timeout << "ms";
+			process->kill();
+		} );
+	}
+
+	process->start( program, arguments );
+}
@@ -26,15 +26,34 @@
 
 #include <QProcess>
 
+#include <functional>
+
 #include "VeyonCore.h"
 
 class VEYON_CORE_EXPORT ProcessHelper {
 public:
+	struct Result
+	{
+		int exitCode{-1};
+		QByteArray output{};
+		bool timedOut{false};
+	};
+
+	using ResultHandler = std::function<void(const Result&)>;
+	using OutputHandler = std::function<void(const QByteArray&)>;
+
 	ProcessHelper( const QString& program, const QStringList& arguments );
 
 	int run();
 	QByteArray runAndReadAll();
 
+	// starts the program without waiting for it - the handlers are called in the thread of
+	// context, which requires an event loop, and are not called at all if context is destroyed
+	// before; standard output is passed to outputHandler as it arrives if specified and
+	// collected in Result::output otherwise; the program is killed after timeout ms if > 0
+	static void runAsync( const QString& program, const QStringList& arguments, int timeout, QObject* context,
+						  const ResultHandler& resultHandler = {}, const OutputHandler& outputHandler = {} );
+
 private:
 	QProcess m_process{};
 
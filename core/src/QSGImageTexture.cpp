@@ -47,7 +47,8 @@
 #endif
 
 QSGImageTexture::QSGImageTexture()
-	: m_texture_id(0)
+	: m_external_format(0)
+	, m_texture_id(0)
 	, m_has_alpha(false)
 	, m_dirty_texture(false)
 	, m_dirty_bind_options(false)
@@ -69,8 +70,28 @@ void QSGImageTexture::setImage(const QImage &image)
 	m_has_alpha = image.hasAlphaChannel();
 	m_dirty_texture = true;
 	m_dirty_bind_options = true;
+	m_sub_images.clear();
  }
 
+bool QSGImageTexture::updateImage(const QImage &image, const QRegion &region, QPoint offset)
+{
+	if (m_texture_id == 0 || m_external_format == 0 || m_dirty_texture ||
+		image.format() != QImage::Format_RGB32 ||
+		region.boundingRect().translated(-offset).intersected(QRect(QPoint(0, 0), m_texture_size)) !=
+			region.boundingRect().translated(-offset)) {
+		return false;
+	}
+
+	for (const auto &rect : region) {
+		auto subImage = image.copy(rect);
+		if (m_external_format != GL_BGRA)
+			subImage = std::move(subImage).convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+		m_sub_images.append({rect.topLeft() - offset, subImage});
+	}
+
+	return true;
+}
+
 int QSGImageTexture::textureId() const
 {
 	if (m_dirty_texture) {
@@ -94,12 +115,14 @@ void QSGImageTexture::bind()
 	QOpenGLFunctions *funcs = context->functions();
 	if (!m_dirty_texture) {
 		funcs->glBindTexture(GL_TEXTURE_2D, m_texture_id);
+		uploadSubImages();
 		updateBindOptions(m_dirty_bind_options);
 		m_dirty_bind_options = false;
 		return;
 	}
 
 	m_dirty_texture = false;
+	m_sub_images.clear();
 
 	if (m_image.isNull()) {
 		if (m_texture_id && m_owns_texture) {
@@ -108,6 +131,7 @@ void QSGImageTexture::bind()
 		m_texture_id = 0;
 		m_texture_size = QSize();
 		m_has_alpha = false;
+		m_external_format = 0;
 
 		return;
 	}
@@ -122,9 +146,11 @@ void QSGImageTexture::bind()
 
 	int max;
 	funcs->glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max);
+	bool scaled = false;
 	if (tmp.width() > max || tmp.height() > max) {
 		tmp = tmp.scaled(qMin(max, tmp.width()), qMin(max, tmp.height()), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
 		m_texture_size = tmp.size();
+		scaled = true;
 	}
 
 	if (tmp.width() * 4 != tmp.bytesPerLine())
@@ -170,7 +196,27 @@ void QSGImageTexture::bind()
 
 	funcs->glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_texture_size.width(), m_texture_size.height(), 0, externalFormat, GL_UNSIGNED_BYTE, tmp.constBits());
 
+	// partial updates are not possible for downscaled textures
+	m_external_format = scaled ? 0 : externalFormat;
+
 	m_dirty_bind_options = false;
 	m_image = {};
 }
+
+void QSGImageTexture::uploadSubImages()
+{
+	if (m_sub_images.isEmpty())
+		return;
+
+	QOpenGLFunctions *funcs = QOpenGLContext::currentContext()->functions();
+
+	// sub images are tightly packed 32 bit images so default alignment of 4 is fine
+	for (const auto &subImage : qAsConst(m_sub_images)) {
+		funcs->glTexSubImage2D(GL_TEXTURE_2D, 0, subImage.position.x(), subImage.position.y(),
+							   subImage.image.width(), subImage.image.height(),
+							   m_external_format, GL_UNSIGNED_BYTE, subImage.image.constBits());
+	}
+
+	m_sub_images.clear();
+}
 #endif
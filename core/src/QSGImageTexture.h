@@ -40,6 +40,8 @@
 #pragma once
 
 #include <QImage>
+#include <QRegion>
+#include <QVector>
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
 #include <QSGTexture>
 
@@ -65,6 +67,10 @@ public:
 	void setImage(const QImage &image);
 	const QImage &image() { return m_image; }
 
+	// uploads the given region of image (translated by -offset) into the existing
+	// texture on next bind(), returns false if a full upload via setImage() is required
+	bool updateImage(const QImage &image, const QRegion &region, QPoint offset = {});
+
 	void bind() override;
 
 	static QSGImageTexture *fromImage(const QImage &image) {
@@ -74,7 +80,18 @@ public:
 	}
 
 protected:
+	struct SubImage
+	{
+		QPoint position;
+		QImage image;
+	};
+
+	void uploadSubImages();
+
 	QImage m_image;
+	QVector<SubImage> m_sub_images;
+
+	uint m_external_format;
 
 	uint m_texture_id;
 	QSize m_texture_size;
@@ -0,0 +1,56 @@
+/*
+ * RfbContinuousUpdates.h - declarations for the RFB ContinuousUpdates extension
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+
+// ContinuousUpdates extension as specified by the RFB community protocol
+// specification - clients announce support through the pseudo encoding,
+// servers confirm by sending an EndOfContinuousUpdates message and then
+// push updates for the enabled area without waiting for update requests
+struct RfbContinuousUpdates
+{
+	static constexpr int32_t PseudoEncoding = -313;
+
+	// client to server
+	static constexpr uint8_t EnableMessageType = 150;
+
+	// server to client
+	static constexpr uint8_t EndMessageType = 150;
+
+	struct EnableMessage
+	{
+		uint8_t type;
+		uint8_t enable;
+		uint16_t x;
+		uint16_t y;
+		uint16_t w;
+		uint16_t h;
+	};
+
+	static constexpr int EnableMessageSize = 10;
+	static constexpr int EndMessageSize = 1;
+
+} ;
@@ -0,0 +1,243 @@
+/*
+ * RfbRecording.cpp - implementation of RfbRecording class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QRegularExpression>
+
+#include "RfbRecording.h"
+
+
+RfbRecording::RfbRecording( const QString& name )
+{
+	if( isEnabled() )
+	{
+		open( QString::fromLocal8Bit( qgetenv( recordingDirectoryEnvironmentVariable() ) ), name );
+	}
+}
+
+
+
+RfbRecording::RfbRecording( const QString& directory, const QString& name )
+{
+	open( directory, name );
+}
+
+
+
+RfbRecording::~RfbRecording()
+{
+	if( isRecording() == false )
+	{
+		return;
+	}
+
+	const auto indexOffset = m_file.pos();
+
+	m_stream << quint8(RecordType::Index) << quint32(m_index.size());
+	for( const auto& entry : qAsConst(m_index) )
+	{
+		m_stream << entry.timestamp << entry.offset;
+	}
+
+	m_stream << indexOffset;
+}
+
+
+
+bool RfbRecording::isEnabled()
+{
+	static const bool enabled = qEnvironmentVariableIsSet( recordingDirectoryEnvironmentVariable() );
+
+	return enabled;
+}
+
+
+
+void RfbRecording::record( const QByteArray& message, bool keyFrame )
+{
+	if( isRecording() == false )
+	{
+		return;
+	}
+
+	const auto timestamp = m_timer.elapsed();
+
+	if( keyFrame )
+	{
+		m_index.append( { timestamp, m_file.pos() } );
+	}
+
+	m_stream << quint8(keyFrame ? RecordType::KeyFrame : RecordType::Message) << timestamp << message;
+}
+
+
+
+RfbRecording::Messages RfbRecording::load( const QString& fileName, qint64 startTime )
+{
+	QFile file( fileName );
+	if( file.open( QFile::ReadOnly ) == false )
+	{
+		vCritical() << "could not open RFB recording" << fileName;
+		return {};
+	}
+
+	QDataStream stream( &file );
+
+	quint32 magic = 0;
+	quint32 version = 0;
+	stream >> magic >> version;
+
+	if( magic != Magic || ( version != Version && version != VersionWithoutIndex ) )
+	{
+		vCritical() << "invalid RFB recording" << fileName;
+		return {};
+	}
+
+	const auto hasRecordTypes = version == Version;
+	const auto dataOffset = file.pos();
+	const auto keyFrameOffset = ( hasRecordTypes && startTime > 0 ) ? findKeyFrame( file, fileName, startTime ) : -1;
+
+	file.seek( dataOffset );
+
+	Messages messages;
+	auto keyFrameFound = keyFrameOffset > 0;
+
+	while( stream.atEnd() == false )
+	{
+		auto type = quint8(RecordType::Message);
+		if( hasRecordTypes )
+		{
+			stream >> type;
+			if( type == quint8(RecordType::Index) )
+			{
+				break;
+			}
+		}
+
+		Message message;
+		stream >> message.timestamp >> message.data;
+
+		if( stream.status() != QDataStream::Ok )
+		{
+			vWarning() << "truncated RFB recording" << fileName;
+			break;
+		}
+
+		// recordings without index (e.g. from crashed processes) are scanned up to the wanted position
+		if( type == quint8(RecordType::KeyFrame) && message.timestamp <= startTime && messages.isEmpty() == false )
+		{
+			messages.resize( 1 );
+			keyFrameFound = true;
+		}
+
+		messages.append( message );
+
+		if( messages.size() == 1 && keyFrameOffset > 0 )
+		{
+			file.seek( keyFrameOffset );
+		}
+	}
+
+	if( startTime > 0 && keyFrameFound == false )
+	{
+		vWarning() << "no key frame before requested position in RFB recording" << fileName
+				   << "- playing from the beginning";
+	}
+
+	return messages;
+}
+
+
+
+void RfbRecording::open( const QString& directory, const QString& name )
+{
+	auto fileName = name;
+	fileName.replace( QRegularExpression( QStringLiteral("[^a-zA-Z0-9_.-]") ), QStringLiteral("_") );
+
+	m_file.setFileName( QDir( directory ).filePath( QStringLiteral("%1-%2-%3.vrfb")
+													 .arg( fileName )
+													 .arg( QCoreApplication::applicationPid() )
+													 .arg( QDateTime::currentMSecsSinceEpoch() ) ) );
+
+	if( m_file.open( QFile::WriteOnly | QFile::Truncate ) == false )
+	{
+		vWarning() << "could not create RFB recording" << m_file.fileName();
+		return;
+	}
+
+	m_stream.setDevice( &m_file );
+	m_stream << Magic << Version;
+
+	m_timer.start();
+}
+
+
+
+qint64 RfbRecording::findKeyFrame( QFile& file, const QString& fileName, qint64 startTime )
+{
+	const auto fileSize = file.size();
+	if( fileSize < IndexOffsetSize || file.seek( fileSize - IndexOffsetSize ) == false )
+	{
+		return -1;
+	}
+
+	QDataStream stream( &file );
+
+	qint64 indexOffset = 0;
+	stream >> indexOffset;
+
+	if( indexOffset <= 0 || indexOffset >= fileSize - IndexOffsetSize || file.seek( indexOffset ) == false )
+	{
+		vDebug() << "no key frame index in RFB recording" << fileName;
+		return -1;
+	}
+
+	quint8 type = 0;
+	quint32 count = 0;
+	stream >> type >> count;
+
+	if( type != quint8(RecordType::Index) || qint64(count) * 2 * qint64(sizeof(qint64)) > fileSize - indexOffset )
+	{
+		vWarning() << "invalid key frame index in RFB recording" << fileName;
+		return -1;
+	}
+
+	qint64 keyFrameOffset = -1;
+
+	for( quint32 i = 0; i < count; ++i )
+	{
+		IndexEntry entry{};
+		stream >> entry.timestamp >> entry.offset;
+		if( stream.status() != QDataStream::Ok || entry.timestamp > startTime )
+		{
+			break;
+		}
+		keyFrameOffset = entry.offset;
+	}
+
+	return keyFrameOffset;
+}
@@ -0,0 +1,102 @@
+/*
+ * RfbRecording.h - declaration of RfbRecording class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#pragma once
+
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QFile>
+
+#include "VeyonCore.h"
+
+// records server-to-client RFB messages including their timing if the environment
+// variable VEYON_RFB_RECORDING_DIR is set so they can be replayed later on, e.g. for load tests
+// or for watching a monitoring or demo session again - messages which fully update the
+// framebuffer are marked as key frames and indexed at the end of the file so playback can
+// start at any position without decoding all previous messages
+class VEYON_CORE_EXPORT RfbRecording
+{
+public:
+	struct Message
+	{
+		qint64 timestamp;
+		QByteArray data;
+	};
+	using Messages = QVector<Message>;
+
+	explicit RfbRecording( const QString& name );
+	RfbRecording( const QString& directory, const QString& name );
+	~RfbRecording();
+
+	Q_DISABLE_COPY(RfbRecording)
+
+	static const char* recordingDirectoryEnvironmentVariable()
+	{
+		return "VEYON_RFB_RECORDING_DIR";
+	}
+
+	static bool isEnabled();
+
+	bool isRecording() const
+	{
+		return m_file.isOpen();
+	}
+
+	void record( const QByteArray& message, bool keyFrame = false );
+
+	// the first message in a recording always is the server init message - if startTime
+	// is given, the messages following it start at the last key frame at or before startTime
+	static Messages load( const QString& fileName, qint64 startTime = 0 );
+
+private:
+	enum class RecordType : quint8
+	{
+		Message,
+		KeyFrame,
+		Index
+	};
+
+	struct IndexEntry
+	{
+		qint64 timestamp;
+		qint64 offset;
+	};
+	using Index = QVector<IndexEntry>;
+
+	static constexpr quint32 Magic = 0x56524642; // "VRFB"
+	static constexpr quint32 Version = 2;
+	static constexpr quint32 VersionWithoutIndex = 1;
+	static constexpr qint64 IndexOffsetSize = sizeof(qint64);
+
+	void open( const QString& directory, const QString& name );
+
+	static qint64 findKeyFrame( QFile& file, const QString& fileName, qint64 startTime );
+
+	QFile m_file;
+	QDataStream m_stream;
+	QElapsedTimer m_timer;
+	Index m_index;
+
+} ;
@@ -26,12 +26,15 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QImageWriter>
 #include <QMessageBox>
 #include <QMetaEnum>
 #include <QPainter>
 #include <QRegularExpression>
+#include <QtConcurrent>
 
 #include "Screenshot.h"
+#include "ScreenshotCatalog.h"
 #include "VeyonConfiguration.h"
 #include "Computer.h"
 #include "ComputerControlInterface.h"
@@ -50,7 +53,7 @@ Screenshot::Screenshot( const QString &fileName, QObject* parent ) :
 
 
 
-void Screenshot::take( const ComputerControlInterface::Pointer& computerControlInterface )
+void Screenshot::take( const ComputerControlInterface::Pointer& computerControlInterface, const QImage& image )
 {
 	auto userLogin = computerControlInterface->userLoginName();
 	if( userLogin.isEmpty() )
@@ -72,15 +75,21 @@ void Screenshot::take( const ComputerControlInterface::Pointer& computerControlI
 		return;
 	}
 
+	const auto format = supportedFormat( VeyonCore::config().screenshotFormat() );
+
 	// construct filename
-	m_fileName = dir + QDir::separator() + constructFileName( userLogin, computerControlInterface->computer().hostAddress() );
+	m_fileName = dir + QDir::separator() + constructFileName( userLogin, computerControlInterface->computer().hostAddress(),
+															  QDate::currentDate(), QTime::currentTime(),
+															  fileSuffix( format ) );
 
-	QFile outputFile( m_fileName );
+	auto outputFile = new QFile( m_fileName );
 	if( VeyonCore::platform().filesystemFunctions().openFileSafely(
-			&outputFile,
+			outputFile,
 			QFile::WriteOnly | QFile::Truncate,
 			QFile::ReadOwner | QFile::WriteOwner ) == false )
 	{
+		delete outputFile;
+
 		const auto msg = tr( "Could not open screenshot file %1 for writing." ).arg( m_fileName );
 		vCritical() << msg.toUtf8().constData();
 		if( qobject_cast<QApplication *>( QCoreApplication::instance() ) )
@@ -104,7 +113,7 @@ void Screenshot::take( const ComputerControlInterface::Pointer& computerControlI
 
 	const auto caption = QStringLiteral( "%1@%2 %3 %4" ).arg( user, host, date, time );
 
-	m_image = computerControlInterface->framebuffer();
+	m_image = image.isNull() ? computerControlInterface->framebuffer() : image;
 
 	QPixmap icon( QStringLiteral( ":/core/icon16.png" ) );
 
@@ -145,27 +154,53 @@ void Screenshot::take( const ComputerControlInterface::Pointer& computerControlI
 	m_image.setText( metaDataKey( MetaData::Date ), date );
 	m_image.setText( metaDataKey( MetaData::Time ), time );
 
-	m_image.save( &outputFile, "PNG", 50 );
+	// encode and write image in background so taking screenshots of many computers does not block the UI
+	outputFile->moveToThread( nullptr );
+
+	(void) QtConcurrent::run( [image = m_image, outputFile, format]() {
+		const auto fileName = outputFile->fileName();
+		const auto success = save( image, outputFile, format );
+
+		delete outputFile;
+
+		if( success )
+		{
+			ScreenshotCatalog::createThumbnail( fileName, image );
+		}
+		else
+		{
+			vCritical() << "failed to write screenshot" << fileName;
+		}
 
-	Q_EMIT VeyonCore::filesystem().screenshotDirectoryModified();
+		Q_EMIT VeyonCore::filesystem().screenshotDirectoryModified();
+	} );
 }
 
 
 
-QString Screenshot::constructFileName( const QString& user, const QString& hostAddress, QDate date, QTime time )
+QString Screenshot::constructFileName( const QString& user, const QString& hostAddress, QDate date, QTime time,
+									   const QString& suffix )
 {
 	const auto userSimplified = VeyonCore::stripDomain( user ).toLower().remove(
 				QRegularExpression( QStringLiteral("[^a-z0-9.]") ) );
 
-	return QStringLiteral( "%1_%2_%3_%4.png" ).arg( userSimplified,
-													hostAddress,
-													date.toString( Qt::ISODate ),
-													time.toString( Qt::ISODate ) ).
+	return QStringLiteral( "%1_%2_%3_%4.%5" ).arg( userSimplified,
+												   hostAddress,
+												   date.toString( Qt::ISODate ),
+												   time.toString( Qt::ISODate ),
+												   suffix ).
 			replace( QLatin1Char(':'), QLatin1Char('-') );
 }
 
 
 
+QStringList Screenshot::fileNameFilters()
+{
+	return { QStringLiteral("*.png"), QStringLiteral("*.jpg"), QStringLiteral("*.webp") };
+}
+
+
+
 QString Screenshot::user() const
 {
 	return property( metaDataKey( MetaData::User ), 0 );
@@ -182,15 +217,14 @@ QString Screenshot::host() const
 
 QString Screenshot::date() const
 {
-	return QLocale::system().toString( QDate::fromString( property( metaDataKey( MetaData::Date ), 2 ), Qt::ISODate ),
-									   QLocale::ShortFormat );
+	return formatDate( property( metaDataKey( MetaData::Date ), 2 ) );
 }
 
 
 
 QString Screenshot::time() const
 {
-	return property( metaDataKey( MetaData::Time ), 3 ).section( QLatin1Char('.'), 0, 0 ).replace( QLatin1Char('-'), QLatin1Char(':') );
+	return formatTime( property( metaDataKey( MetaData::Time ), 3 ) );
 }
 
 
@@ -202,6 +236,20 @@ QString Screenshot::metaDataKey( MetaData key )
 
 
 
+QString Screenshot::formatDate( const QString& date )
+{
+	return QLocale::system().toString( QDate::fromString( date, Qt::ISODate ), QLocale::ShortFormat );
+}
+
+
+
+QString Screenshot::formatTime( const QString& time )
+{
+	return QString( time ).section( QLatin1Char('.'), 0, 0 ).replace( QLatin1Char('-'), QLatin1Char(':') );
+}
+
+
+
 QString Screenshot::property( const QString& key, int section ) const
 {
 	const auto embeddedProperty = m_image.text( key );
@@ -219,3 +267,56 @@ QString Screenshot::fileNameSection( int n ) const
 {
 	return QFileInfo( fileName() ).fileName().section( QLatin1Char('_'), n, n );
 }
+
+
+
+ScreenshotConfiguration::Format Screenshot::supportedFormat( ScreenshotConfiguration::Format format )
+{
+	// WebP support depends on the availability of the corresponding image format plugin
+	if( ( format == ScreenshotConfiguration::Format::WebP ||
+		  format == ScreenshotConfiguration::Format::WebPLossless ) &&
+		QImageWriter::supportedImageFormats().contains( QByteArrayLiteral("webp") ) == false )
+	{
+		vWarning() << "WebP not supported - falling back to PNG";
+		return ScreenshotConfiguration::Format::PNG;
+	}
+
+	return format;
+}
+
+
+
+QString Screenshot::fileSuffix( ScreenshotConfiguration::Format format )
+{
+	switch( format )
+	{
+	case ScreenshotConfiguration::Format::JPEG: return QStringLiteral("jpg");
+	case ScreenshotConfiguration::Format::WebP:
+	case ScreenshotConfiguration::Format::WebPLossless: return QStringLiteral("webp");
+	default:
+		break;
+	}
+
+	return QStringLiteral("png");
+}
+
+
+
+bool Screenshot::save( const QImage& image, QIODevice* ioDevice, ScreenshotConfiguration::Format format )
+{
+	switch( format )
+	{
+	case ScreenshotConfiguration::Format::PNGFast:
+		return image.save( ioDevice, "PNG", ScreenshotConfiguration::PNGFastQuality );
+	case ScreenshotConfiguration::Format::JPEG:
+		return image.convertToFormat( QImage::Format_RGB32 ).save( ioDevice, "JPEG", ScreenshotConfiguration::JPEGQuality );
+	case ScreenshotConfiguration::Format::WebP:
+		return image.save( ioDevice, "WEBP", ScreenshotConfiguration::WebPQuality );
+	case ScreenshotConfiguration::Format::WebPLossless:
+		return image.save( ioDevice, "WEBP", ScreenshotConfiguration::WebPLosslessQuality );
+	default:
+		break;
+	}
+
+	return image.save( ioDevice, "PNG", ScreenshotConfiguration::PNGQuality );
+}
@@ -24,6 +24,7 @@
 #pragma once
 
 #include "ComputerControlInterface.h"
+#include "ScreenshotConfiguration.h"
 #include "VeyonCore.h"
 
 #include <QDate>
@@ -46,7 +47,8 @@ public:
 
 	explicit Screenshot( const QString &fileName = {}, QObject* parent = nullptr );
 
-	void take( const ComputerControlInterface::Pointer& computerControlInterface );
+	// captions and saves the given image or the current framebuffer of the computer if no image is given
+	void take( const ComputerControlInterface::Pointer& computerControlInterface, const QImage& image = {} );
 
 	bool isValid() const
 	{
@@ -70,7 +72,10 @@ public:
 
 	static QString constructFileName( const QString& user, const QString& hostAddress,
 									  QDate date = QDate::currentDate(),
-									  QTime time = QTime::currentTime() );
+									  QTime time = QTime::currentTime(),
+									  const QString& suffix = QStringLiteral("png") );
+
+	static QStringList fileNameFilters();
 
 	QString user() const;
 	QString host() const;
@@ -79,9 +84,16 @@ public:
 
 	static QString metaDataKey( MetaData key );
 
+	static QString formatDate( const QString& date );
+	static QString formatTime( const QString& time );
+
 private:
 	static constexpr auto ScreenshotLabelFontPointSize = 14;
 
+	static ScreenshotConfiguration::Format supportedFormat( ScreenshotConfiguration::Format format );
+	static QString fileSuffix( ScreenshotConfiguration::Format format );
+	static bool save( const QImage& image, QIODevice* ioDevice, ScreenshotConfiguration::Format format );
+
 	QString property( const QString& key, int section ) const;
 	QString fileNameSection( int n ) const;
 
@@ -0,0 +1,240 @@
+/*
+ * ScreenshotCatalog.cpp - implementation of ScreenshotCatalog class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QImageReader>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include "Filesystem.h"
+#include "Screenshot.h"
+#include "ScreenshotCatalog.h"
+
+
+ScreenshotCatalog::ScreenshotCatalog( QObject* parent ) :
+	QObject( parent ),
+	m_directory( VeyonCore::filesystem().screenshotDirectoryPath() )
+{
+	loadIndex();
+}
+
+
+
+ScreenshotCatalog::~ScreenshotCatalog()
+{
+	saveIndex();
+}
+
+
+
+QStringList ScreenshotCatalog::update()
+{
+	const auto fileInfos = QDir( m_directory ).entryInfoList( Screenshot::fileNameFilters(),
+															  QDir::Filter::Files, QDir::SortFlag::Name );
+
+	QStringList fileNames;
+	fileNames.reserve( fileInfos.size() );
+
+	QJsonObject index;
+
+	for( const auto& fileInfo : fileInfos )
+	{
+		const auto fileName = fileInfo.fileName();
+		fileNames.append( fileName );
+
+		// keep metadata of unchanged files only
+		const auto cachedEntry = m_index.value( fileName ).toObject();
+		if( cachedEntry.isEmpty() == false &&
+			cachedEntry.value( QStringLiteral("size") ).toDouble() == double(fileInfo.size()) &&
+			cachedEntry.value( QStringLiteral("lastModified") ).toDouble() == double(fileInfo.lastModified().toMSecsSinceEpoch()) )
+		{
+			index[fileName] = cachedEntry;
+		}
+	}
+
+	if( index.size() != m_index.size() )
+	{
+		m_index = index;
+		m_indexChanged = true;
+	}
+
+	saveIndex();
+
+	return fileNames;
+}
+
+
+
+ScreenshotCatalog::Entry ScreenshotCatalog::entry( const QString& fileName )
+{
+	auto cachedEntry = m_index.value( fileName ).toObject();
+
+	if( cachedEntry.isEmpty() )
+	{
+		const QFileInfo fileInfo( m_directory + QDir::separator() + fileName );
+
+		// reading the embedded texts does not require decoding the image data
+		QImageReader reader( fileInfo.filePath() );
+
+		const auto metaData = [&]( Screenshot::MetaData key, int section ) {
+			const auto text = reader.text( Screenshot::metaDataKey( key ) );
+			return text.isEmpty() ? fileName.section( QLatin1Char('_'), section, section ) : text;
+		};
+
+		cachedEntry = QJsonObject{
+			{ QStringLiteral("size"), double(fileInfo.size()) },
+			{ QStringLiteral("lastModified"), double(fileInfo.lastModified().toMSecsSinceEpoch()) },
+			{ QStringLiteral("user"), metaData( Screenshot::MetaData::User, 0 ) },
+			{ QStringLiteral("host"), metaData( Screenshot::MetaData::Host, 1 ) },
+			{ QStringLiteral("date"), metaData( Screenshot::MetaData::Date, 2 ) },
+			{ QStringLiteral("time"), metaData( Screenshot::MetaData::Time, 3 ) }
+		};
+
+		m_index[fileName] = cachedEntry;
+		m_indexChanged = true;
+	}
+
+	return { cachedEntry.value( QStringLiteral("user") ).toString(),
+			 cachedEntry.value( QStringLiteral("host") ).toString(),
+			 Screenshot::formatDate( cachedEntry.value( QStringLiteral("date") ).toString() ),
+			 Screenshot::formatTime( cachedEntry.value( QStringLiteral("time") ).toString() ) };
+}
+
+
+
+QString ScreenshotCatalog::thumbnailFilePath( const QString& fileName ) const
+{
+	const QFileInfo fileInfo( m_directory + QDir::separator() + fileName );
+	const auto thumbnailPath = thumbnailFilePath( fileInfo.filePath(), fileInfo.lastModified().toMSecsSinceEpoch() );
+
+	if( QFileInfo::exists( thumbnailPath ) == false )
+	{
+		QImageReader reader( fileInfo.filePath() );
+		// allows decoders such as the JPEG one to skip most of the work
+		reader.setScaledSize( reader.size().scaled( ThumbnailWidth, ThumbnailHeight, Qt::KeepAspectRatio ) );
+
+		createThumbnail( fileInfo.filePath(), reader.read() );
+
+		if( QFileInfo::exists( thumbnailPath ) == false )
+		{
+			return fileInfo.filePath();
+		}
+	}
+
+	return thumbnailPath;
+}
+
+
+
+void ScreenshotCatalog::createThumbnail( const QString& filePath, const QImage& image )
+{
+	if( image.isNull() || QDir().mkpath( cacheDirectoryPath() ) == false )
+	{
+		return;
+	}
+
+	const auto thumbnail = image.width() > ThumbnailWidth || image.height() > ThumbnailHeight ?
+							   image.scaled( ThumbnailWidth, ThumbnailHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation ) :
+							   image;
+
+	QSaveFile thumbnailFile( thumbnailFilePath( filePath, QFileInfo( filePath ).lastModified().toMSecsSinceEpoch() ) );
+	if( thumbnailFile.open( QFile::WriteOnly ) == false ||
+		thumbnail.convertToFormat( QImage::Format_RGB32 ).save( &thumbnailFile, "JPEG", ThumbnailQuality ) == false ||
+		thumbnailFile.commit() == false )
+	{
+		vDebug() << "could not write thumbnail for" << filePath;
+	}
+}
+
+
+
+QString ScreenshotCatalog::cacheDirectoryPath()
+{
+	return QStandardPaths::writableLocation( QStandardPaths::CacheLocation ) + QDir::separator() +
+		   QStringLiteral("screenshots");
+}
+
+
+
+QString ScreenshotCatalog::thumbnailFilePath( const QString& filePath, qint64 lastModified )
+{
+	const auto key = QCryptographicHash::hash( QFileInfo( filePath ).absoluteFilePath().toUtf8() +
+											   QByteArray::number( lastModified ), QCryptographicHash::Sha1 ).toHex();
+
+	return cacheDirectoryPath() + QDir::separator() + QString::fromLatin1( key ) + QStringLiteral(".jpg");
+}
+
+
+
+QString ScreenshotCatalog::indexFilePath() const
+{
+	const auto key = QCryptographicHash::hash( QDir( m_directory ).absolutePath().toUtf8(),
+											   QCryptographicHash::Sha1 ).toHex();
+
+	return cacheDirectoryPath() + QDir::separator() + QString::fromLatin1( key ) + QStringLiteral(".json");
+}
+
+
+
+void ScreenshotCatalog::loadIndex()
+{
+	QFile indexFile( indexFilePath() );
+	if( indexFile.open( QFile::ReadOnly ) )
+	{
+		const auto index = QJsonDocument::fromJson( indexFile.readAll() ).object();
+		if( index.value( QStringLiteral("version") ).toInt() == IndexVersion )
+		{
+			m_index = index.value( QStringLiteral("screenshots") ).toObject();
+		}
+	}
+}
+
+
+
+void ScreenshotCatalog::saveIndex()
+{
+	if( m_indexChanged == false || QDir().mkpath( cacheDirectoryPath() ) == false )
+	{
+		return;
+	}
+
+	const QJsonObject index{
+		{ QStringLiteral("version"), IndexVersion },
+		{ QStringLiteral("screenshots"), m_index }
+	};
+
+	QSaveFile indexFile( indexFilePath() );
+	if( indexFile.open( QFile::WriteOnly ) &&
+		indexFile.write( QJsonDocument( index ).toJson( QJsonDocument::Compact ) ) > 0 &&
+		indexFile.commit() )
+	{
+		m_indexChanged = false;
+	}
+	else
+	{
+		vDebug() << "could not write screenshot index" << indexFilePath();
+	}
+}
@@ -0,0 +1,79 @@
+/*
+ * ScreenshotCatalog.h - declaration of ScreenshotCatalog class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QJsonObject>
+#include <QSize>
+
+#include "VeyonCore.h"
+
+class QImage;
+
+// index of the screenshot directory with cached metadata and thumbnails so
+// browsing does not require loading and decoding each screenshot
+class VEYON_CORE_EXPORT ScreenshotCatalog : public QObject
+{
+	Q_OBJECT
+public:
+	struct Entry
+	{
+		QString user;
+		QString host;
+		QString date;
+		QString time;
+	};
+
+	explicit ScreenshotCatalog( QObject* parent = nullptr );
+	~ScreenshotCatalog() override;
+
+	// rescans the screenshot directory and returns the sorted list of screenshot file names
+	QStringList update();
+
+	Entry entry( const QString& fileName );
+
+	// returns the path of the (lazily generated) thumbnail for the given screenshot
+	QString thumbnailFilePath( const QString& fileName ) const;
+
+	static void createThumbnail( const QString& filePath, const QImage& image );
+
+	static constexpr int ThumbnailWidth = 320;
+	static constexpr int ThumbnailHeight = 180;
+
+private:
+	static constexpr int IndexVersion = 1;
+	static constexpr int ThumbnailQuality = 80;
+
+	static QString cacheDirectoryPath();
+	static QString thumbnailFilePath( const QString& filePath, qint64 lastModified );
+
+	QString indexFilePath() const;
+	void loadIndex();
+	void saveIndex();
+
+	QString m_directory;
+	QJsonObject m_index;
+	bool m_indexChanged{false};
+
+} ;
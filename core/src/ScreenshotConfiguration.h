@@ -0,0 +1,50 @@
+/*
+ * ScreenshotConfiguration.h - declaration of ScreenshotConfiguration
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include "VeyonCore.h"
+
+class VEYON_CORE_EXPORT ScreenshotConfiguration
+{
+	Q_GADGET
+public:
+	enum class Format
+	{
+		PNG,
+		PNGFast,
+		JPEG,
+		WebP,
+		WebPLossless
+	};
+	Q_ENUM(Format)
+
+	// quality values as interpreted by the corresponding QImageWriter plugins
+	static constexpr int PNGQuality = 50;
+	static constexpr int PNGFastQuality = 90;
+	static constexpr int JPEGQuality = 85;
+	static constexpr int WebPQuality = 85;
+	static constexpr int WebPLosslessQuality = 100;
+
+} ;
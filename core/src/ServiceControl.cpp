@@ -76,6 +76,14 @@ void ServiceControl::stopService()
 
 
 
+void ServiceControl::reloadService()
+{
+	serviceControl( tr( "Reloading service %1" ).arg( m_name ),
+					QtConcurrent::run( [=]() { VeyonCore::platform().serviceFunctions().reload( m_name ); } ) );
+}
+
+
+
 void ServiceControl::registerService()
 {
 	serviceControl( tr( "Registering service %1" ).arg( m_name ),
@@ -49,6 +49,7 @@ public:
 
 	void startService();
 	void stopService();
+	void reloadService();
 
 
 private:
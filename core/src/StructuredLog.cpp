@@ -0,0 +1,280 @@
+/*
+ * StructuredLog.cpp - implementation of StructuredLog class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include <QIODevice>
+#include <QRegularExpression>
+#include <QtEndian>
+
+#include "StructuredLog.h"
+
+
+static constexpr QChar ArgumentPlaceholder = QChar(0x1a);
+
+
+StructuredLog::StructuredLog( QIODevice* device ) :
+	m_device( device )
+{
+}
+
+
+
+void StructuredLog::write( qint64 timestamp, int logLevel, int sessionId, const QString& message )
+{
+	if( m_device->pos() == 0 )
+	{
+		reset();
+
+		QByteArray header;
+		QDataStream headerStream( &header, QIODevice::WriteOnly );
+		headerStream << Magic << Version;
+		m_device->write( header );
+	}
+
+	// split off category prefix generated by Logger::qtMsgHandler()
+	QString category;
+	auto text = message;
+	if( text.startsWith( QLatin1Char('[') ) )
+	{
+		const auto end = text.indexOf( QLatin1String("] ") );
+		if( end > 0 )
+		{
+			category = text.mid( 1, end - 1 );
+			text = text.mid( end + 2 );
+		}
+	}
+
+	// quoted strings (e.g. from QDebug), paths and tokens containing digits or separators
+	// such as numbers, addresses, UUIDs or host names
+	static const QRegularExpression argumentRX{ QStringLiteral(
+		"\"(?:[^\"\\\\]|\\\\.)*\"|"
+		"(?<![\\w/\\\\])(?:[A-Za-z]:)?[/\\\\][^\\s\"',;()\\[\\]]+|"
+		"(?<![\\w])(?:\\w*\\d[\\w.:@-]*|\\w+(?:[.:@-]\\w+)+)") };
+
+	QStringList arguments;
+	QString messageTemplate;
+	messageTemplate.reserve( text.size() );
+
+	int lastEnd = 0;
+	auto matches = argumentRX.globalMatch( text );
+	while( matches.hasNext() )
+	{
+		const auto match = matches.next();
+		messageTemplate += text.mid( lastEnd, match.capturedStart() - lastEnd );
+		messageTemplate += ArgumentPlaceholder;
+		arguments.append( match.captured() );
+		lastEnd = match.capturedEnd();
+	}
+	messageTemplate += text.mid( lastEnd );
+
+	const auto categoryId = templateId( category );
+	const auto messageTemplateId = templateId( messageTemplate );
+
+	QByteArray record;
+	QDataStream stream( &record, QIODevice::WriteOnly );
+	stream.setVersion( StreamVersion );
+
+	if( categoryId == InvalidTemplateId || messageTemplateId == InvalidTemplateId )
+	{
+		stream << quint8(RecordType::LiteralEntry) << timestamp << quint8(logLevel) << qint32(sessionId)
+			   << category << text;
+	}
+	else
+	{
+		stream << quint8(RecordType::Entry) << timestamp << quint8(logLevel) << qint32(sessionId)
+			   << categoryId << messageTemplateId << arguments;
+	}
+
+	writeRecord( record );
+}
+
+
+
+bool StructuredLog::read( Entry& entry )
+{
+	if( m_headerValid == false && readHeader() == false )
+	{
+		return false;
+	}
+
+	while( true )
+	{
+		quint32 recordSize = 0;
+		if( m_device->peek( reinterpret_cast<char *>( &recordSize ), sizeof(recordSize) ) != sizeof(recordSize) )
+		{
+			return false;
+		}
+
+		recordSize = qFromBigEndian( recordSize );
+		if( recordSize > MaximumRecordSize )
+		{
+			vWarning() << "invalid record size" << recordSize;
+			return false;
+		}
+
+		if( m_device->bytesAvailable() < qint64(sizeof(recordSize) + recordSize) )
+		{
+			return false;
+		}
+
+		m_device->read( sizeof(recordSize) );
+		const auto record = m_device->read( recordSize );
+
+		QDataStream stream( record );
+		stream.setVersion( StreamVersion );
+
+		quint8 recordType = 0;
+		stream >> recordType;
+
+		if( recordType == quint8(RecordType::Template) )
+		{
+			quint32 id = 0;
+			QString messageTemplate;
+			stream >> id >> messageTemplate;
+			m_templates[id] = messageTemplate;
+			continue;
+		}
+
+		if( recordType == quint8(RecordType::LiteralEntry) )
+		{
+			quint8 logLevel = 0;
+			qint32 sessionId = 0;
+
+			stream >> entry.timestamp >> logLevel >> sessionId >> entry.category >> entry.message;
+
+			entry.logLevel = logLevel;
+			entry.sessionId = sessionId;
+
+			return true;
+		}
+
+		if( recordType != quint8(RecordType::Entry) )
+		{
+			continue;
+		}
+
+		quint8 logLevel = 0;
+		qint32 sessionId = 0;
+		quint32 categoryId = 0;
+		quint32 messageTemplateId = 0;
+		QStringList arguments;
+
+		stream >> entry.timestamp >> logLevel >> sessionId >> categoryId >> messageTemplateId >> arguments;
+
+		entry.logLevel = logLevel;
+		entry.sessionId = sessionId;
+		entry.category = m_templates.value( categoryId );
+		entry.message.clear();
+
+		const auto messageTemplate = m_templates.value( messageTemplateId );
+		int argumentIndex = 0;
+		for( const auto& c : messageTemplate )
+		{
+			if( c == ArgumentPlaceholder && argumentIndex < arguments.size() )
+			{
+				entry.message += arguments.at( argumentIndex++ );
+			}
+			else
+			{
+				entry.message += c;
+			}
+		}
+
+		return true;
+	}
+}
+
+
+
+void StructuredLog::reset()
+{
+	m_templateIds.clear();
+	m_templates.clear();
+	m_headerValid = false;
+}
+
+
+
+quint32 StructuredLog::templateId( const QString& messageTemplate )
+{
+	const auto it = m_templateIds.constFind( messageTemplate );
+	if( it != m_templateIds.constEnd() )
+	{
+		return it.value();
+	}
+
+	// don't let the template table grow without bounds if log rotation is disabled
+	if( m_templateIds.size() >= MaximumTemplateCount )
+	{
+		return InvalidTemplateId;
+	}
+
+	const auto id = quint32( m_templateIds.size() );
+	m_templateIds[messageTemplate] = id;
+
+	QByteArray record;
+	QDataStream stream( &record, QIODevice::WriteOnly );
+	stream.setVersion( StreamVersion );
+	stream << quint8(RecordType::Template) << id << messageTemplate;
+
+	writeRecord( record );
+
+	return id;
+}
+
+
+
+void StructuredLog::writeRecord( const QByteArray& record )
+{
+	const auto recordSize = qToBigEndian( quint32( record.size() ) );
+
+	m_device->write( reinterpret_cast<const char *>( &recordSize ), sizeof(recordSize) );
+	m_device->write( record );
+}
+
+
+
+bool StructuredLog::readHeader()
+{
+	if( m_device->bytesAvailable() < qint64(2 * sizeof(quint32)) )
+	{
+		return false;
+	}
+
+	quint32 magic = 0;
+	quint32 version = 0;
+	QDataStream stream( m_device->read( 2 * sizeof(quint32) ) );
+	stream >> magic >> version;
+
+	if( magic != Magic || version != Version )
+	{
+		vWarning() << "invalid or unsupported structured log file";
+		m_device->close();
+		return false;
+	}
+
+	m_headerValid = true;
+
+	return true;
+}
@@ -0,0 +1,90 @@
+/*
+ * StructuredLog.h - declaration of StructuredLog class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#pragma once
+
+#include <QDataStream>
+#include <QHash>
+
+#include "VeyonCore.h"
+
+class QIODevice;
+
+// compact binary log format: each distinct message template (message with arguments such as
+// numbers, quoted strings, paths or host names replaced by placeholders) is stored once,
+// entries only reference it by ID
+class VEYON_CORE_EXPORT StructuredLog
+{
+public:
+	struct Entry
+	{
+		qint64 timestamp{0};
+		int logLevel{0};
+		int sessionId{0};
+		QString category;
+		QString message;
+	};
+
+	explicit StructuredLog( QIODevice* device );
+
+	static QString fileSuffix()
+	{
+		return QStringLiteral(".vlog");
+	}
+
+	void write( qint64 timestamp, int logLevel, int sessionId, const QString& message );
+
+	// returns false if no complete entry is available (yet)
+	bool read( Entry& entry );
+
+	// has to be called after the underlying file has been truncated or replaced
+	void reset();
+
+private:
+	enum class RecordType : quint8
+	{
+		Template,
+		Entry,
+		LiteralEntry
+	};
+
+	static constexpr quint32 Magic = 0x564c4f47; // "VLOG"
+	static constexpr quint32 Version = 1;
+	static constexpr quint32 MaximumRecordSize = 1024*1024;
+	// messages with new templates are stored literally once reached
+	static constexpr int MaximumTemplateCount = 10000;
+	static constexpr quint32 InvalidTemplateId = 0xffffffff;
+	static constexpr QDataStream::Version StreamVersion = QDataStream::Qt_5_6;
+
+	quint32 templateId( const QString& messageTemplate );
+	void writeRecord( const QByteArray& record );
+	bool readHeader();
+
+	QIODevice* m_device;
+	QHash<QString, quint32> m_templateIds;
+	QHash<quint32, QString> m_templates;
+	bool m_headerValid{false};
+
+} ;
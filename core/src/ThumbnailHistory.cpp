@@ -0,0 +1,177 @@
+/*
+ * ThumbnailHistory.cpp - implementation of ThumbnailHistory class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QUuid>
+
+#include "Filesystem.h"
+#include "ThumbnailHistory.h"
+#include "VeyonConfiguration.h"
+
+
+QAtomicInteger<qint64> ThumbnailHistory::s_memoryUsage{0};
+
+
+ThumbnailHistory::ThumbnailHistory( QObject* parent ) :
+	QObject( parent ),
+	m_fileNamePrefix( QUuid::createUuid().toString( QUuid::WithoutBraces ) ),
+	m_interval( qint64(VeyonCore::config().thumbnailHistoryInterval()) * 1000 ),
+	m_duration( qint64(VeyonCore::config().thumbnailHistoryDuration()) * 60 * 1000 ),
+	m_directory( VeyonCore::filesystem().expandPath( VeyonCore::config().thumbnailHistoryDirectory() ) )
+{
+	if( m_directory.isEmpty() == false )
+	{
+		QDir().mkpath( m_directory );
+	}
+}
+
+
+
+ThumbnailHistory::~ThumbnailHistory()
+{
+	while( m_entries.isEmpty() == false )
+	{
+		removeOldest();
+	}
+}
+
+
+
+void ThumbnailHistory::add( const QImage& image )
+{
+	const auto now = QDateTime::currentMSecsSinceEpoch();
+
+	if( image.isNull() ||
+		( m_entries.isEmpty() == false && now - m_entries.last().timestamp < m_interval ) )
+	{
+		return;
+	}
+
+	Entry entry;
+	entry.timestamp = now;
+
+	QBuffer buffer( &entry.data );
+	buffer.open( QBuffer::WriteOnly );
+	if( image.save( &buffer, "JPG", JpegQuality ) == false )
+	{
+		return;
+	}
+
+	s_memoryUsage += entry.data.size();
+	m_entries.enqueue( entry );
+
+	while( m_entries.isEmpty() == false && now - m_entries.first().timestamp > m_duration )
+	{
+		removeOldest();
+	}
+
+	releaseMemory();
+
+	Q_EMIT thumbnailAdded();
+}
+
+
+
+QDateTime ThumbnailHistory::timestamp( int index ) const
+{
+	if( index < 0 || index >= m_entries.count() )
+	{
+		return {};
+	}
+
+	return QDateTime::fromMSecsSinceEpoch( m_entries[index].timestamp );
+}
+
+
+
+QImage ThumbnailHistory::image( int index ) const
+{
+	if( index < 0 || index >= m_entries.count() )
+	{
+		return {};
+	}
+
+	const auto& entry = m_entries[index];
+	if( entry.fileName.isEmpty() )
+	{
+		return QImage::fromData( entry.data, "JPG" );
+	}
+
+	return QImage( entry.fileName, "JPG" );
+}
+
+
+
+void ThumbnailHistory::removeOldest()
+{
+	const auto entry = m_entries.dequeue();
+
+	if( entry.fileName.isEmpty() )
+	{
+		s_memoryUsage -= entry.data.size();
+	}
+	else
+	{
+		QFile::remove( entry.fileName );
+	}
+
+	m_firstEntryInMemory = qMax( 0, m_firstEntryInMemory - 1 );
+}
+
+
+
+void ThumbnailHistory::releaseMemory()
+{
+	const auto memoryLimit = qint64(VeyonCore::config().thumbnailHistoryMemoryLimit()) * 1024 * 1024;
+
+	// every instance releases its own oldest thumbnails when adding a new one so that
+	// the memory is shared evenly between all computers adding thumbnails at the same rate
+	while( s_memoryUsage > memoryLimit && m_firstEntryInMemory < m_entries.count() - 1 )
+	{
+		auto& entry = m_entries[m_firstEntryInMemory];
+
+		if( m_directory.isEmpty() )
+		{
+			removeOldest();
+			continue;
+		}
+
+		const auto fileName = QStringLiteral("%1/%2-%3.jpg").arg( m_directory, m_fileNamePrefix ).arg( entry.timestamp );
+		QFile file( fileName );
+		if( file.open( QFile::WriteOnly ) == false || file.write( entry.data ) != entry.data.size() )
+		{
+			file.remove();
+			removeOldest();
+			continue;
+		}
+
+		s_memoryUsage -= entry.data.size();
+		entry.data = {};
+		entry.fileName = fileName;
+		++m_firstEntryInMemory;
+	}
+}
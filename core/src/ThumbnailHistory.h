@@ -0,0 +1,80 @@
+/*
+ * ThumbnailHistory.h - declaration of ThumbnailHistory class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#pragma once
+
+#include <QDateTime>
+#include <QImage>
+#include <QQueue>
+
+#include "VeyonCore.h"
+
+// keeps JPEG compressed thumbnails of the last minutes of a computer, the memory used by all
+// instances is limited globally - older thumbnails are moved to disk or discarded if exceeded
+class VEYON_CORE_EXPORT ThumbnailHistory : public QObject
+{
+	Q_OBJECT
+public:
+	explicit ThumbnailHistory( QObject* parent = nullptr );
+	~ThumbnailHistory() override;
+
+	// stores the image if the configured interval has passed since the last thumbnail
+	void add( const QImage& image );
+
+	int count() const
+	{
+		return m_entries.count();
+	}
+
+	QDateTime timestamp( int index ) const;
+	QImage image( int index ) const;
+
+private:
+	static constexpr int JpegQuality = 60;
+
+	struct Entry
+	{
+		qint64 timestamp{0};
+		QByteArray data{};
+		QString fileName{};
+	};
+
+	void removeOldest();
+	void releaseMemory();
+
+	static QAtomicInteger<qint64> s_memoryUsage;
+
+	const QString m_fileNamePrefix;
+	const qint64 m_interval;
+	const qint64 m_duration;
+	const QString m_directory;
+
+	QQueue<Entry> m_entries{};
+	int m_firstEntryInMemory{0};
+
+Q_SIGNALS:
+	void thumbnailAdded();
+
+} ;
@@ -0,0 +1,220 @@
+/*
+ * TimerWheel.cpp - implementation of TimerWheel and WheelTimer classes
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include <QCoreApplication>
+#include <QPointer>
+#include <QRandomGenerator>
+#include <QThread>
+
+#include "TimerWheel.h"
+
+
+TimerWheel::TimerWheel( QObject* parent ) :
+	QObject( parent )
+{
+	m_clock.start();
+
+	connect( &m_tickTimer, &QTimer::timeout, this, &TimerWheel::tick );
+	m_tickTimer.setInterval( TickInterval );
+	m_tickTimer.setTimerType( Qt::CoarseTimer );
+}
+
+
+
+TimerWheel::~TimerWheel()
+{
+	for( const auto& slot : m_slots )
+	{
+		for( auto timer : slot )
+		{
+			timer->m_scheduled = false;
+		}
+	}
+
+	for( auto timer : qAsConst(m_dueTimers) )
+	{
+		if( timer )
+		{
+			timer->m_dueIndex = -1;
+		}
+	}
+}
+
+
+
+TimerWheel* TimerWheel::instance()
+{
+	static QPointer<TimerWheel> timerWheel;
+
+	if( timerWheel.isNull() )
+	{
+		timerWheel = new TimerWheel( QCoreApplication::instance() );
+	}
+
+	return timerWheel;
+}
+
+
+
+void TimerWheel::schedule( WheelTimer* timer, int delay )
+{
+	Q_ASSERT( QThread::currentThread() == thread() );
+
+	cancel( timer );
+
+	if( m_scheduledTimerCount == 0 && m_firing == false )
+	{
+		m_lastTick = currentTick();
+		m_tickTimer.start();
+	}
+
+	timer->m_expiryTick = currentTick() + qMax( 1, ( delay + TickInterval - 1 ) / TickInterval );
+	timer->m_slot = int( timer->m_expiryTick % SlotCount );
+	auto& slot = m_slots[size_t(timer->m_slot)];
+	timer->m_position = slot.insert( slot.end(), timer );
+	timer->m_scheduled = true;
+
+	++m_scheduledTimerCount;
+}
+
+
+
+void TimerWheel::cancel( WheelTimer* timer )
+{
+	if( timer->m_scheduled )
+	{
+		m_slots[size_t(timer->m_slot)].erase( timer->m_position );
+		timer->m_scheduled = false;
+		--m_scheduledTimerCount;
+	}
+	else if( timer->m_dueIndex >= 0 )
+	{
+		m_dueTimers[timer->m_dueIndex] = nullptr;
+		timer->m_dueIndex = -1;
+	}
+}
+
+
+
+void TimerWheel::tick()
+{
+	// a nested event loop started by a timeout handler must not fire timers again
+	if( m_firing )
+	{
+		return;
+	}
+
+	const auto now = currentTick();
+
+	// each slot has to be visited at most once even if ticks have been missed
+	const auto lastTick = qMin( now, m_lastTick + SlotCount );
+	for( auto tick = m_lastTick + 1; tick <= lastTick; ++tick )
+	{
+		auto& slot = m_slots[size_t(tick % SlotCount)];
+		for( auto it = slot.begin(); it != slot.end(); )
+		{
+			auto timer = *it;
+			if( timer->m_expiryTick <= now )
+			{
+				it = slot.erase( it );
+				timer->m_scheduled = false;
+				timer->m_dueIndex = m_dueTimers.size();
+				m_dueTimers.append( timer );
+				--m_scheduledTimerCount;
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+	m_lastTick = now;
+
+	m_firing = true;
+	for( int i = 0; i < m_dueTimers.size(); ++i )
+	{
+		auto timer = m_dueTimers[i];
+		if( timer )
+		{
+			timer->m_dueIndex = -1;
+			if( timer->m_singleShot == false )
+			{
+				schedule( timer, timer->m_interval );
+			}
+			Q_EMIT timer->timeout();
+		}
+	}
+	m_dueTimers.clear();
+	m_firing = false;
+
+	if( m_scheduledTimerCount == 0 )
+	{
+		m_tickTimer.stop();
+	}
+	else if( m_tickTimer.isActive() == false )
+	{
+		m_lastTick = currentTick();
+		m_tickTimer.start();
+	}
+}
+
+
+
+WheelTimer::~WheelTimer()
+{
+	stop();
+}
+
+
+
+void WheelTimer::start()
+{
+	if( m_singleShot )
+	{
+		TimerWheel::instance()->schedule( this, m_interval );
+	}
+	else
+	{
+		TimerWheel::instance()->schedule( this, int( QRandomGenerator::global()->bounded( qMax( 1, m_interval ) ) ) + 1 );
+	}
+}
+
+
+
+void WheelTimer::start( int interval )
+{
+	m_interval = interval;
+	start();
+}
+
+
+
+void WheelTimer::stop()
+{
+	if( isActive() )
+	{
+		TimerWheel::instance()->cancel( this );
+	}
+}
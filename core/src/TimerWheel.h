@@ -0,0 +1,139 @@
+/*
+ * TimerWheel.h - declaration of TimerWheel and WheelTimer classes
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVector>
+
+#include <array>
+#include <list>
+
+#include "VeyonCore.h"
+
+class WheelTimer;
+
+// drives any number of WheelTimer instances of the main thread through a
+// single QTimer, expiries are rounded up to the next tick
+class VEYON_CORE_EXPORT TimerWheel : public QObject
+{
+	Q_OBJECT
+public:
+	static constexpr int TickInterval = 50;
+	static constexpr int SlotCount = 512;
+
+	static TimerWheel* instance();
+
+	void schedule( WheelTimer* timer, int delay );
+	void cancel( WheelTimer* timer );
+
+private:
+	explicit TimerWheel( QObject* parent );
+	~TimerWheel() override;
+
+	qint64 currentTick() const
+	{
+		return m_clock.elapsed() / TickInterval;
+	}
+
+	void tick();
+
+	using Slot = std::list<WheelTimer *>;
+
+	std::array<Slot, SlotCount> m_slots{};
+	QVector<WheelTimer *> m_dueTimers{};
+	int m_scheduledTimerCount{0};
+	qint64 m_lastTick{0};
+	bool m_firing{false};
+
+	QElapsedTimer m_clock{};
+	QTimer m_tickTimer{this};
+
+	friend class WheelTimer;
+
+} ;
+
+
+// lightweight replacement for QTimer - periodic timers start with a random
+// phase so that timers of many objects started at the same time do not fire
+// all at once
+class VEYON_CORE_EXPORT WheelTimer : public QObject
+{
+	Q_OBJECT
+public:
+	explicit WheelTimer( QObject* parent = nullptr ) :
+		QObject( parent )
+	{
+	}
+
+	~WheelTimer() override;
+
+	void setInterval( int interval )
+	{
+		m_interval = interval;
+	}
+
+	int interval() const
+	{
+		return m_interval;
+	}
+
+	void setSingleShot( bool singleShot )
+	{
+		m_singleShot = singleShot;
+	}
+
+	bool isSingleShot() const
+	{
+		return m_singleShot;
+	}
+
+	bool isActive() const
+	{
+		return m_scheduled || m_dueIndex >= 0;
+	}
+
+	void start();
+	void start( int interval );
+	void stop();
+
+private:
+	int m_interval{0};
+	bool m_singleShot{false};
+
+	// position in TimerWheel
+	bool m_scheduled{false};
+	qint64 m_expiryTick{0};
+	int m_slot{0};
+	std::list<WheelTimer *>::iterator m_position{};
+	int m_dueIndex{-1};
+
+	friend class TimerWheel;
+
+Q_SIGNALS:
+	void timeout();
+
+} ;
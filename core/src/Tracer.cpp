@@ -0,0 +1,142 @@
+/*
+ * Tracer.cpp - implementation of Tracer class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QThread>
+
+#include <chrono>
+
+#include "Tracer.h"
+
+
+static QMutex __traceFileMutex;
+static QFile* __traceFile = nullptr;
+
+
+Tracer::Scope::Scope( const char* name, const QString& detail ) :
+	m_name( name ),
+	m_detail( detail )
+{
+	if( isEnabled() )
+	{
+		m_startTime = timestamp();
+	}
+}
+
+
+
+Tracer::Scope::~Scope()
+{
+	if( m_startTime >= 0 )
+	{
+		writeEvent( m_name, 'X', m_startTime, timestamp() - m_startTime, m_detail );
+	}
+}
+
+
+
+bool Tracer::isEnabled()
+{
+	static const bool enabled = qEnvironmentVariableIsSet( traceDirectoryEnvironmentVariable() );
+
+	return enabled;
+}
+
+
+
+void Tracer::milestone( const char* name, const QString& detail )
+{
+	if( isEnabled() )
+	{
+		writeEvent( name, 'i', timestamp(), 0, detail );
+	}
+}
+
+
+
+qint64 Tracer::timestamp()
+{
+	// use a monotonic system-wide clock so traces of different processes can be merged
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+
+
+void Tracer::writeEvent( const char* name, char phase, qint64 timestamp, qint64 duration, const QString& detail )
+{
+	QJsonObject event{
+		{ QStringLiteral("name"), QString::fromUtf8( name ) },
+		{ QStringLiteral("cat"), QStringLiteral("veyon") },
+		{ QStringLiteral("ph"), QString( QLatin1Char( phase ) ) },
+		{ QStringLiteral("ts"), double(timestamp) },
+		{ QStringLiteral("pid"), double(QCoreApplication::applicationPid()) },
+		{ QStringLiteral("tid"), double(quintptr(QThread::currentThreadId())) }
+	};
+
+	if( phase == 'X' )
+	{
+		event[QStringLiteral("dur")] = double(duration);
+	}
+	else
+	{
+		event[QStringLiteral("s")] = QStringLiteral("p");
+	}
+
+	if( detail.isEmpty() == false )
+	{
+		event[QStringLiteral("args")] = QJsonObject{ { QStringLiteral("detail"), detail } };
+	}
+
+	const auto data = QJsonDocument( event ).toJson( QJsonDocument::Compact ) + ",\n";
+
+	QMutexLocker locker( &__traceFileMutex );
+
+	if( __traceFile == nullptr )
+	{
+		const auto processName = QCoreApplication::instance() ?
+									 QFileInfo( QCoreApplication::applicationFilePath() ).baseName() :
+									 QStringLiteral("veyon");
+
+		// one file per process in the JSON array format which explicitly allows omitting the closing bracket
+		__traceFile = new QFile( QDir( QString::fromLocal8Bit( qgetenv( traceDirectoryEnvironmentVariable() ) ) )
+									 .filePath( QStringLiteral("%1-%2.json").arg( processName ).arg( QCoreApplication::applicationPid() ) ) );
+		if( __traceFile->open( QFile::WriteOnly | QFile::Truncate | QFile::Unbuffered ) )
+		{
+			__traceFile->write( "[\n" );
+		}
+	}
+
+	if( __traceFile->isOpen() )
+	{
+		__traceFile->write( data );
+	}
+}
@@ -0,0 +1,63 @@
+/*
+ * Tracer.h - declaration of Tracer class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#pragma once
+
+#include "VeyonCore.h"
+
+// records timing information as Chrome trace events (to be loaded into chrome://tracing
+// or ui.perfetto.dev) if the environment variable VEYON_TRACE_DIR is set
+class VEYON_CORE_EXPORT Tracer
+{
+public:
+	class VEYON_CORE_EXPORT Scope
+	{
+	public:
+		explicit Scope( const char* name, const QString& detail = {} );
+		~Scope();
+
+		Q_DISABLE_COPY(Scope)
+
+	private:
+		const char* m_name;
+		QString m_detail;
+		qint64 m_startTime{-1};
+
+	} ;
+
+	static const char* traceDirectoryEnvironmentVariable()
+	{
+		return "VEYON_TRACE_DIR";
+	}
+
+	static bool isEnabled();
+
+	static void milestone( const char* name, const QString& detail = {} );
+
+private:
+	static qint64 timestamp();
+	static void writeEvent( const char* name, char phase, qint64 timestamp, qint64 duration, const QString& detail );
+
+} ;
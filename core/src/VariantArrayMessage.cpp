@@ -42,8 +42,14 @@ VariantArrayMessage::VariantArrayMessage( QIODevice* ioDevice ) :
 bool VariantArrayMessage::send()
 {
 	const auto messageSize = qToBigEndian<MessageSize>( static_cast<MessageSize>( m_buffer.size() ) );
-	m_ioDevice->write( reinterpret_cast<const char *>( &messageSize ), sizeof(messageSize) );
-	m_ioDevice->write( m_buffer.data() );
+
+	// send header and payload with a single write so they end up in the same packet
+	QByteArray message;
+	message.reserve( int( sizeof(messageSize) + m_buffer.size() ) );
+	message.append( reinterpret_cast<const char *>( &messageSize ), sizeof(messageSize) );
+	message.append( m_buffer.data() );
+
+	m_ioDevice->write( message );
 
 	return true;
 }
@@ -51,14 +57,23 @@ bool VariantArrayMessage::send()
 
 
 bool VariantArrayMessage::isReadyForReceive()
+{
+	return isReadyForReceive( m_ioDevice );
+}
+
+
+
+bool VariantArrayMessage::isReadyForReceive( QIODevice* ioDevice )
 {
 	MessageSize messageSize;
 
-	if( m_ioDevice->peek( reinterpret_cast<char *>( &messageSize ), sizeof(messageSize) ) == sizeof(messageSize) )
+	if( ioDevice->peek( reinterpret_cast<char *>( &messageSize ), sizeof(messageSize) ) == sizeof(messageSize) )
 	{
 		messageSize = qFromBigEndian(messageSize);
 
-		return m_ioDevice->bytesAvailable() >= static_cast<MessageSize>( sizeof(messageSize) + messageSize );
+		// let receive() reject invalid messages right away instead of buffering them
+		return messageSize > MaxMessageSize ||
+			   ioDevice->bytesAvailable() >= static_cast<MessageSize>( sizeof(messageSize) + messageSize );
 	}
 
 	return false;
@@ -79,7 +94,8 @@ bool VariantArrayMessage::receive()
 	messageSize = qFromBigEndian(messageSize);
 	if( messageSize > MaxMessageSize )
 	{
-		vDebug() << "invalid message size" << messageSize;
+		vWarning() << "invalid message size" << messageSize;
+		m_ioDevice->close();
 		return false;
 	}
 
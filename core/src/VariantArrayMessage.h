@@ -41,6 +41,7 @@ public:
 	bool send();
 
 	bool isReadyForReceive();
+	static bool isReadyForReceive( QIODevice* ioDevice );
 
 	bool receive();
 
@@ -58,11 +59,12 @@ public:
 		return m_ioDevice;
 	}
 
-private:
 	enum {
 		MaxMessageSize = 1024*1024*32
 	};
 
+private:
+
 	QBuffer m_buffer{};
 	VariantStream m_stream;
 	QIODevice* m_ioDevice;
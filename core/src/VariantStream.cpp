@@ -22,7 +22,9 @@
  *
  */
 
+#include <QSysInfo>
 #include <QUuid>
+#include <QtEndian>
 
 #include "VariantStream.h"
 
@@ -38,16 +40,16 @@ QVariant VariantStream::read() // Flawfinder: ignore
 {
 	QVariant v;
 
+	// decode and validate in a single pass - values are only accepted once complete
 	m_dataStream.startTransaction();
-	const auto isValid = checkVariant(0);
-	m_dataStream.rollbackTransaction();
 
-	if (isValid == false)
+	if (readVariant(v, 0) == false || m_dataStream.status() != QDataStream::Status::Ok)
 	{
+		m_dataStream.rollbackTransaction();
 		return {};
 	}
 
-	m_dataStream >> v;
+	m_dataStream.commitTransaction();
 
 	if( v.isValid() == false || v.isNull() )
 	{
@@ -66,26 +68,16 @@ void VariantStream::write( const QVariant& v )
 
 
 
-bool VariantStream::checkBool()
+bool VariantStream::readByteArray(QByteArray& byteArray)
 {
-	bool b;
-	m_dataStream >> b;
-	return m_dataStream.status() == QDataStream::Status::Ok;
-}
-
-
-
-bool VariantStream::checkByteArray()
-{
-	const auto pos = m_dataStream.device()->pos();
-
 	quint32 len;
 	m_dataStream >> len;
 
 	// null array?
 	if (len == 0xffffffff)
 	{
-		return true;
+		byteArray = {};
+		return m_dataStream.status() == QDataStream::Status::Ok;
 	}
 
 	if (len > MaxByteArraySize)
@@ -94,64 +86,65 @@ bool VariantStream::checkByteArray()
 		return false;
 	}
 
-	m_dataStream.device()->seek(pos);
-
-	QByteArray s;
-	m_dataStream >> s;
-
-	return m_dataStream.status() == QDataStream::Status::Ok;
-}
-
-
-
-bool VariantStream::checkInt()
-{
-	int i;
-	m_dataStream >> i;
-	return m_dataStream.status() == QDataStream::Status::Ok;
-}
-
+	if (m_dataStream.device()->bytesAvailable() < len)
+	{
+		m_dataStream.setStatus(QDataStream::Status::ReadPastEnd);
+		return false;
+	}
 
+	byteArray.resize(int(len));
 
-bool VariantStream::checkRect()
-{
-	qint32 i;
-	m_dataStream >> i >> i >> i >> i;
-	return m_dataStream.status() == QDataStream::Status::Ok;
+	return m_dataStream.readRawData(byteArray.data(), int(len)) == int(len);
 }
 
 
 
-bool VariantStream::checkString()
+bool VariantStream::readString(QString& string)
 {
-	const auto pos = m_dataStream.device()->pos();
-
 	quint32 len;
 	m_dataStream >> len;
 
 	// null string?
 	if (len == 0xffffffff)
 	{
-		return true;
+		string = {};
+		return m_dataStream.status() == QDataStream::Status::Ok;
 	}
 
-	if (len > MaxStringSize)
+	if (len > MaxStringSize || len % sizeof(char16_t) != 0)
 	{
-		vDebug() << "string too long";
+		vDebug() << "string too long or invalid";
 		return false;
 	}
 
-	m_dataStream.device()->seek(pos);
+	if (m_dataStream.device()->bytesAvailable() < len)
+	{
+		m_dataStream.setStatus(QDataStream::Status::ReadPastEnd);
+		return false;
+	}
 
-	QString s;
-	m_dataStream >> s;
+	string.resize(int(len / sizeof(char16_t)));
 
-	return m_dataStream.status() == QDataStream::Status::Ok;
+	if (m_dataStream.readRawData(reinterpret_cast<char *>(string.data()), int(len)) != int(len))
+	{
+		return false;
+	}
+
+	// strings are serialized as UTF-16 in stream byte order
+	if ((m_dataStream.byteOrder() == QDataStream::BigEndian) != (QSysInfo::ByteOrder == QSysInfo::BigEndian))
+	{
+		for (auto& c : string)
+		{
+			c = QChar(qbswap(c.unicode()));
+		}
+	}
+
+	return true;
 }
 
 
 
-bool VariantStream::checkStringList()
+bool VariantStream::readStringList(QStringList& stringList)
 {
 	quint32 n;
 	m_dataStream >> n;
@@ -162,12 +155,16 @@ bool VariantStream::checkStringList()
 		return false;
 	}
 
+	stringList.reserve(int(n));
+
 	for (quint32 i = 0; i < n; ++i)
 	{
-		if (checkString() == false)
+		QString s;
+		if (readString(s) == false)
 		{
 			return false;
 		}
+		stringList.append(s);
 	}
 
 	return m_dataStream.status() == QDataStream::Status::Ok;
@@ -175,16 +172,7 @@ bool VariantStream::checkStringList()
 
 
 
-bool VariantStream::checkUuid()
-{
-	QUuid uuid;
-	m_dataStream >> uuid;
-	return m_dataStream.status() == QDataStream::Status::Ok;
-}
-
-
-
-bool VariantStream::checkVariant(int depth)
+bool VariantStream::readVariant(QVariant& value, int depth)
 {
 	if (depth > MaxCheckRecursionDepth)
 	{
@@ -200,15 +188,84 @@ bool VariantStream::checkVariant(int depth)
 
 	switch(typeId)
 	{
-	case QMetaType::Bool: return checkBool();
-	case QMetaType::QByteArray: return checkByteArray();
-	case QMetaType::Int: return checkInt();
-	case QMetaType::QRect: return checkRect();
-	case QMetaType::QString: return checkString();
-	case QMetaType::QStringList: return checkStringList();
-	case QMetaType::QUuid: return checkUuid();
-	case QMetaType::QVariantList: return checkVariantList(depth);
-	case QMetaType::QVariantMap: return checkVariantMap(depth);
+	case QMetaType::Bool:
+	{
+		bool b;
+		m_dataStream >> b;
+		value = b;
+		break;
+	}
+	case QMetaType::QByteArray:
+	{
+		QByteArray byteArray;
+		if (readByteArray(byteArray) == false)
+		{
+			return false;
+		}
+		value = byteArray;
+		break;
+	}
+	case QMetaType::Int:
+	{
+		qint32 i;
+		m_dataStream >> i;
+		value = int(i);
+		break;
+	}
+	case QMetaType::QRect:
+	{
+		QRect rect;
+		m_dataStream >> rect;
+		value = rect;
+		break;
+	}
+	case QMetaType::QString:
+	{
+		QString string;
+		if (readString(string) == false)
+		{
+			return false;
+		}
+		value = string;
+		break;
+	}
+	case QMetaType::QStringList:
+	{
+		QStringList stringList;
+		if (readStringList(stringList) == false)
+		{
+			return false;
+		}
+		value = stringList;
+		break;
+	}
+	case QMetaType::QUuid:
+	{
+		QUuid uuid;
+		m_dataStream >> uuid;
+		value = uuid;
+		break;
+	}
+	case QMetaType::QVariantList:
+	{
+		QVariantList variantList;
+		if (readVariantList(variantList, depth) == false)
+		{
+			return false;
+		}
+		value = variantList;
+		break;
+	}
+	case QMetaType::QVariantMap:
+	{
+		QVariantMap variantMap;
+		if (readVariantMap(variantMap, depth) == false)
+		{
+			return false;
+		}
+		value = variantMap;
+		break;
+	}
 	default:
 		vDebug() << "invalid type" << typeId;
 		return false;
@@ -219,7 +276,7 @@ bool VariantStream::checkVariant(int depth)
 
 
 
-bool VariantStream::checkVariantList(int depth)
+bool VariantStream::readVariantList(QVariantList& variantList, int depth)
 {
 	quint32 n;
 	m_dataStream >> n;
@@ -230,12 +287,16 @@ bool VariantStream::checkVariantList(int depth)
 		return false;
 	}
 
+	variantList.reserve(int(n));
+
 	for (quint32 i = 0; i < n; ++i)
 	{
-		if (checkVariant(depth+1) == false)
+		QVariant v;
+		if (readVariant(v, depth+1) == false)
 		{
 			return false;
 		}
+		variantList.append(v);
 	}
 
 	return m_dataStream.status() == QDataStream::Status::Ok;
@@ -243,7 +304,7 @@ bool VariantStream::checkVariantList(int depth)
 
 
 
-bool VariantStream::checkVariantMap(int depth)
+bool VariantStream::readVariantMap(QVariantMap& variantMap, int depth)
 {
 	quint32 n;
 	m_dataStream >> n;
@@ -256,11 +317,15 @@ bool VariantStream::checkVariantMap(int depth)
 
 	for (quint32 i = 0; i < n; ++i)
 	{
-		if (checkString() == false ||
-			checkVariant(depth+1) == false)
+		QString key;
+		QVariant v;
+		if (readString(key) == false ||
+			readVariant(v, depth+1) == false)
 		{
 			return false;
 		}
+
+		variantMap.insert(key, v);
 	}
 
 	return m_dataStream.status() == QDataStream::Status::Ok;
@@ -43,16 +43,12 @@ public:
 	void write( const QVariant& v );
 
 private:
-	bool checkBool();
-	bool checkByteArray();
-	bool checkInt();
-	bool checkRect();
-	bool checkString();
-	bool checkStringList();
-	bool checkUuid();
-	bool checkVariant(int depth);
-	bool checkVariantList(int depth);
-	bool checkVariantMap(int depth);
+	bool readByteArray(QByteArray& byteArray);
+	bool readString(QString& string);
+	bool readStringList(QStringList& stringList);
+	bool readVariant(QVariant& value, int depth);
+	bool readVariantList(QVariantList& variantList, int depth);
+	bool readVariantMap(QVariantMap& variantMap, int depth);
 
 	QDataStream m_dataStream;
 
@@ -46,6 +46,40 @@ VeyonConfiguration::VeyonConfiguration( Configuration::Store* store ) :
 
 
 
+VeyonConfiguration::ServiceReloadMode VeyonConfiguration::reloadForService()
+{
+	Configuration::Object previousConfiguration;
+	previousConfiguration += *this;
+
+	reloadFromStore();
+
+	auto reloadMode = ServiceReloadMode::None;
+
+	const auto changedKeys = previousConfiguration.changedKeys( *this );
+	for( const auto& changedKey : changedKeys )
+	{
+		const auto section = changedKey.second.section( QLatin1Char('/'), 0, 0 );
+
+		// session management and other settings of the service itself are only read on startup
+		if( section == QLatin1String("Service") )
+		{
+			vDebug() << "service restart required due to changed setting" << changedKey.second << changedKey.first;
+			return ServiceReloadMode::RestartService;
+		}
+
+		// settings of Veyon Master are not used by server instances
+		if( section != QLatin1String("Master") && reloadMode == ServiceReloadMode::None )
+		{
+			vDebug() << "server restart required due to changed setting" << changedKey.second << changedKey.first;
+			reloadMode = ServiceReloadMode::RestartServers;
+		}
+	}
+
+	return reloadMode;
+}
+
+
+
 void VeyonConfiguration::upgrade()
 {
 	if( applicationVersion() < VeyonCore::ApplicationVersion::Version_4_2 )
@@ -42,6 +42,17 @@ public:
 
 	void upgrade();
 
+	enum class ServiceReloadMode
+	{
+		None,
+		RestartServers,
+		RestartService
+	};
+
+	// reloads the configuration from the store and returns what has to be
+	// restarted in order to apply the changed settings
+	ServiceReloadMode reloadForService();
+
 	static QString expandPath( QString path );
 
 	FOREACH_VEYON_CONFIG_PROPERTY(DECLARE_CONFIG_PROPERTY)
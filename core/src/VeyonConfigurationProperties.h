@@ -33,6 +33,7 @@
 #include "ComputerListModel.h"
 #include "Logger.h"
 #include "NetworkObjectDirectory.h"
+#include "ScreenshotConfiguration.h"
 #include "VncConnectionConfiguration.h"
 
 #define FOREACH_VEYON_CORE_CONFIG_PROPERTIES(OP)		\
@@ -47,12 +48,14 @@
 	OP( VeyonConfiguration, VeyonCore::config(), int, vncConnectionConnectTimeout, setVncConnectionConnectTimeout, "ConnectTimeout", "VncConnection", VncConnectionConfiguration::DefaultConnectTimeout, Configuration::Property::Flag::Hidden )			\
 	OP( VeyonConfiguration, VeyonCore::config(), int, vncConnectionReadTimeout, setVncConnectionReadTimeout, "ReadTimeout", "VncConnection", VncConnectionConfiguration::DefaultReadTimeout, Configuration::Property::Flag::Hidden )			\
 	OP( VeyonConfiguration, VeyonCore::config(), int, vncConnectionRetryInterval, setVncConnectionRetryInterval, "ConnectionRetryInterval", "VncConnection", VncConnectionConfiguration::DefaultConnectionRetryInterval, Configuration::Property::Flag::Hidden )			\
+	OP( VeyonConfiguration, VeyonCore::config(), int, vncConnectionMaximumRetryInterval, setVncConnectionMaximumRetryInterval, "MaximumConnectionRetryInterval", "VncConnection", VncConnectionConfiguration::DefaultMaximumConnectionRetryInterval, Configuration::Property::Flag::Hidden )			\
 	OP( VeyonConfiguration, VeyonCore::config(), int, vncConnectionMessageWaitTimeout, setVncConnectionMessageWaitTimeout, "MessageWaitTimeout", "VncConnection", VncConnectionConfiguration::DefaultMessageWaitTimeout, Configuration::Property::Flag::Hidden )			\
 	OP( VeyonConfiguration, VeyonCore::config(), int, vncConnectionFastFramebufferUpdateInterval, setVncConnectionFastFramebufferUpdateInterval, "FastFramebufferUpdateInterval", "VncConnection", VncConnectionConfiguration::DefaultFastFramebufferUpdateInterval, Configuration::Property::Flag::Hidden )			\
 	OP( VeyonConfiguration, VeyonCore::config(), int, vncConnectionFramebufferUpdateWatchdogTimeout, setVncConnectionFramebufferUpdateWatchdogTimeout, "FramebufferUpdateWatchdogTimeout", "VncConnection", VncConnectionConfiguration::DefaultFramebufferUpdateWatchdogTimeout, Configuration::Property::Flag::Hidden )			\
 	OP( VeyonConfiguration, VeyonCore::config(), int, vncConnectionSocketKeepaliveIdleTime, setVncConnectionSocketKeepaliveIdleTime, "SocketKeepaliveIdleTime", "VncConnection", VncConnectionConfiguration::DefaultSocketKeepaliveIdleTime, Configuration::Property::Flag::Hidden )			\
 	OP( VeyonConfiguration, VeyonCore::config(), int, vncConnectionSocketKeepaliveInterval, setVncConnectionSocketKeepaliveInterval, "SocketKeepaliveInterval", "VncConnection", VncConnectionConfiguration::DefaultSocketKeepaliveInterval, Configuration::Property::Flag::Hidden )			\
 	OP( VeyonConfiguration, VeyonCore::config(), int, vncConnectionSocketKeepaliveCount, setVncConnectionSocketKeepaliveCount, "SocketKeepaliveCount", "VncConnection", VncConnectionConfiguration::DefaultSocketKeepaliveCount, Configuration::Property::Flag::Hidden )			\
+	OP( VeyonConfiguration, VeyonCore::config(), int, vncConnectionThreadStackSize, setVncConnectionThreadStackSize, "ThreadStackSize", "VncConnection", VncConnectionConfiguration::DefaultThreadStackSize, Configuration::Property::Flag::Hidden )			\
 
 #define FOREACH_VEYON_UI_CONFIG_PROPERTY(OP)				\
 	OP( VeyonConfiguration, VeyonCore::config(), QString, applicationName, setApplicationName, "ApplicationName", "UI", QStringLiteral("Veyon"), Configuration::Property::Flag::Hidden )			\
@@ -104,11 +107,14 @@
 #define FOREACH_VEYON_DIRECTORIES_CONFIG_PROPERTY(OP) \
 	OP( VeyonConfiguration, VeyonCore::config(), QString, userConfigurationDirectory, setUserConfigurationDirectory, "UserConfiguration", "Directories", QDir::toNativeSeparators( QStringLiteral( "%APPDATA%/Config" ) ), Configuration::Property::Flag::Standard )	\
 	OP( VeyonConfiguration, VeyonCore::config(), QString, screenshotDirectory, setScreenshotDirectory, "Screenshots", "Directories", QDir::toNativeSeparators( QStringLiteral( "%APPDATA%/Screenshots" ) ), Configuration::Property::Flag::Standard )	\
+	OP( VeyonConfiguration, VeyonCore::config(), ScreenshotConfiguration::Format, screenshotFormat, setScreenshotFormat, "ScreenshotFormat", "Directories", QVariant::fromValue(ScreenshotConfiguration::Format::PNG), Configuration::Property::Flag::Standard )	\
 
 #define FOREACH_VEYON_MASTER_CONFIG_PROPERTY(OP) \
 	OP( VeyonConfiguration, VeyonCore::config(), bool, modernUserInterface, setModernUserInterface, "ModernUserInterface", "Master", false, Configuration::Property::Flag::Standard )	\
 	OP( VeyonConfiguration, VeyonCore::config(), VncConnectionConfiguration::Quality, computerMonitoringImageQuality, setComputerMonitoringUpdateInterval, "ComputerMonitoringImageQuality", "Master", QVariant::fromValue(VncConnectionConfiguration::Quality::High), Configuration::Property::Flag::Standard )    \
+	OP( VeyonConfiguration, VeyonCore::config(), VncConnectionConfiguration::ScalingMode, computerMonitoringScalingMode, setComputerMonitoringScalingMode, "ComputerMonitoringScalingMode", "Master", QVariant::fromValue(VncConnectionConfiguration::ScalingMode::AreaAveraging), Configuration::Property::Flag::Standard )    \
 	OP( VeyonConfiguration, VeyonCore::config(), int, computerMonitoringUpdateInterval, setComputerMonitoringUpdateInterval, "ComputerMonitoringUpdateInterval", "Master", 1000, Configuration::Property::Flag::Standard )	\
+	OP( VeyonConfiguration, VeyonCore::config(), bool, adaptiveComputerMonitoringUpdateInterval, setAdaptiveComputerMonitoringUpdateInterval, "AdaptiveComputerMonitoringUpdateInterval", "Master", true, Configuration::Property::Flag::Standard )	\
 	OP( VeyonConfiguration, VeyonCore::config(), int, computerMonitoringThumbnailSpacing, setComputerMonitoringThumbnailSpacing, "ComputerMonitoringThumbnailSpacing", "Master", 5, Configuration::Property::Flag::Standard )	\
 	OP( VeyonConfiguration, VeyonCore::config(), ComputerListModel::DisplayRoleContent, computerDisplayRoleContent, setComputerDisplayRoleContent, "ComputerDisplayRoleContent", "Master", QVariant::fromValue(ComputerListModel::DisplayRoleContent::UserAndComputerName), Configuration::Property::Flag::Standard )	\
 	OP( VeyonConfiguration, VeyonCore::config(), ComputerListModel::SortOrder, computerMonitoringSortOrder, setComputerMonitoringSortOrder, "ComputerMonitoringSortOrder", "Master", QVariant::fromValue(ComputerListModel::SortOrder::ComputerAndUserName), Configuration::Property::Flag::Standard )	\
@@ -130,6 +136,37 @@
 	OP( VeyonConfiguration, VeyonCore::config(), bool, confirmUnsafeActions, setConfirmUnsafeActions, "ConfirmUnsafeActions", "Master", false, Configuration::Property::Flag::Standard )	\
 	OP( VeyonConfiguration, VeyonCore::config(), bool, showFeatureWindowsOnSameScreen, setShowFeatureWindowsOnSameScreen, "ShowFeatureWindowsOnSameScreen", "Master", false, Configuration::Property::Flag::Standard )	\
 
+#define FOREACH_VEYON_PERFORMANCE_CONFIG_PROPERTY(OP) \
+	OP( VeyonConfiguration, VeyonCore::config(), int, standbyWorkerCount, setStandbyWorkerCount, "StandbyWorkers", "Service", 1, Configuration::Property::Flag::Advanced )			\
+	OP( VeyonConfiguration, VeyonCore::config(), bool, logAsynchronously, setLogAsynchronously, "AsynchronousLogging", "Logging", false, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), bool, structuredLogFileEnabled, setStructuredLogFileEnabled, "StructuredLogFileEnabled", "Logging", false, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), int, framebufferUpdateBudget, setFramebufferUpdateBudget, "FramebufferUpdateBudget", "Service", 0, Configuration::Property::Flag::Advanced )			\
+	OP( VeyonConfiguration, VeyonCore::config(), int, metricsServerPort, setMetricsServerPort, "MetricsServerPort", "Network", 0, Configuration::Property::Flag::Advanced )			\
+	OP( VeyonConfiguration, VeyonCore::config(), bool, presenceAnnouncementsEnabled, setPresenceAnnouncementsEnabled, "PresenceAnnouncementsEnabled", "Network", false, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), int, presenceAnnouncementPort, setPresenceAnnouncementPort, "PresenceAnnouncementPort", "Network", 11500, Configuration::Property::Flag::Advanced )			\
+	OP( VeyonConfiguration, VeyonCore::config(), bool, serverSideThumbnailScaling, setServerSideThumbnailScaling, "ServerSideThumbnailScaling", "Master", false, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), bool, computerMonitoringReducedColors, setComputerMonitoringReducedColors, "ComputerMonitoringReducedColors", "Master", false, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), int, framebufferMemoryLimit, setFramebufferMemoryLimit, "FramebufferMemoryLimit", "Master", 1024, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), int, maximumConcurrentConnectionAttempts, setMaximumConcurrentConnectionAttempts, "MaximumConcurrentConnectionAttempts", "Master", 16, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), int, connectionPoolMemoryLimit, setConnectionPoolMemoryLimit, "ConnectionPoolMemoryLimit", "Master", 256, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), bool, serverSideScreenshots, setServerSideScreenshots, "ServerSideScreenshots", "Master", true, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), QStringList, unencryptedNetworks, setUnencryptedNetworks, "UnencryptedNetworks", "TLS", QStringList(), Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), int, authenticationCacheTimeout, setAuthenticationCacheTimeout, "CacheTimeout", "Authentication", 0, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), int, powerControlRatePerLocation, setPowerControlRatePerLocation, "PowerControlRatePerLocation", "Master", 0, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), int, userLogonRate, setUserLogonRate, "UserLogonRate", "Master", 0, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), VncConnectionConfiguration::Quality, remoteAccessImageQuality, setRemoteAccessImageQuality, "RemoteAccessImageQuality", "Master", QVariant::fromValue(VncConnectionConfiguration::Quality::High), Configuration::Property::Flag::Advanced )    \
+	OP( VeyonConfiguration, VeyonCore::config(), QStringList, lowBandwidthLocations, setLowBandwidthLocations, "LowBandwidthLocations", "Master", QStringList(), Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), VncConnectionConfiguration::Quality, lowBandwidthImageQuality, setLowBandwidthImageQuality, "LowBandwidthImageQuality", "Master", QVariant::fromValue(VncConnectionConfiguration::Quality::Lowest), Configuration::Property::Flag::Advanced )    \
+	OP( VeyonConfiguration, VeyonCore::config(), bool, lowLatencyRemoteAccess, setLowLatencyRemoteAccess, "LowLatencyRemoteAccess", "Master", false, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), int, computerConnectionWatchdogTimeout, setComputerConnectionWatchdogTimeout, "ComputerConnectionWatchdogTimeout", "Master", 20000, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), int, computerMonitoringScreen, setComputerMonitoringScreen, "ComputerMonitoringScreen", "Master", -1, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), int, thumbnailHistoryInterval, setThumbnailHistoryInterval, "ThumbnailHistoryInterval", "Master", 0, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), int, thumbnailHistoryDuration, setThumbnailHistoryDuration, "ThumbnailHistoryDuration", "Master", 30, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), int, thumbnailHistoryMemoryLimit, setThumbnailHistoryMemoryLimit, "ThumbnailHistoryMemoryLimit", "Master", 64, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), QString, thumbnailHistoryDirectory, setThumbnailHistoryDirectory, "ThumbnailHistoryDirectory", "Master", QString(), Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), bool, connectionStatisticsOverlay, setConnectionStatisticsOverlay, "ConnectionStatisticsOverlay", "Master", false, Configuration::Property::Flag::Advanced )	\
+	OP( VeyonConfiguration, VeyonCore::config(), int, cliMaximumConcurrentConnections, setCliMaximumConcurrentConnections, "MaximumConcurrentConnections", "CLI", 32, Configuration::Property::Flag::Advanced )	\
+
 #define FOREACH_VEYON_AUTHENTICATION_CONFIG_PROPERTY(OP) \
 	OP( VeyonConfiguration, VeyonCore::config(), QStringList, enabledAuthenticationPlugins, setEnabledAuthenticationPlugins, "EnabledPlugins", "Authentication", QStringList(), Configuration::Property::Flag::Standard )	\
 
@@ -170,4 +207,5 @@
 	FOREACH_VEYON_MASTER_CONFIG_PROPERTY(OP)	\
 	FOREACH_VEYON_AUTHENTICATION_CONFIG_PROPERTY(OP)	\
 	FOREACH_VEYON_ACCESS_CONTROL_CONFIG_PROPERTY(OP) \
+	FOREACH_VEYON_PERFORMANCE_CONFIG_PROPERTY(OP) \
 	FOREACH_VEYON_LEGACY_CONFIG_PROPERTY(OP)
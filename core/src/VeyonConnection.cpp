@@ -87,12 +87,14 @@ void VeyonConnection::stopAndDeleteLater()
 
 
 
-void VeyonConnection::sendFeatureMessage(const FeatureMessage& featureMessage)
+bool VeyonConnection::sendFeatureMessage(const FeatureMessage& featureMessage, const QByteArray& serializedMessage)
 {
 	if( m_vncConnection )
 	{
-		m_vncConnection->enqueueEvent(new VncFeatureMessageEvent(featureMessage));
+		return m_vncConnection->enqueueEvent(new VncFeatureMessageEvent(featureMessage, serializedMessage));
 	}
+
+	return false;
 }
 
 
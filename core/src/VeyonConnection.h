@@ -64,7 +64,7 @@ public:
 		return m_userHomeDir;
 	}
 
-	void sendFeatureMessage(const FeatureMessage& featureMessage);
+	bool sendFeatureMessage(const FeatureMessage& featureMessage, const QByteArray& serializedMessage = {});
 
 	bool handleServerMessage( rfbClient* client, uint8_t msg );
 
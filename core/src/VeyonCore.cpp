@@ -29,6 +29,7 @@
 #include <QApplication>
 #include <QDir>
 #include <QGroupBox>
+#include <QHostAddress>
 #include <QJsonDocument>
 #include <QLabel>
 #include <QLibraryInfo>
@@ -50,11 +51,17 @@
 #include "PlatformSessionFunctions.h"
 #include "PluginManager.h"
 #include "QmlCore.h"
+#include "Tracer.h"
 #include "TranslationLoader.h"
 #include "UserGroupsBackendManager.h"
 #include "VeyonConfiguration.h"
 #include "VncConnection.h"
 
+#if defined(Q_PROCESSOR_ARM_64) && defined(Q_OS_LINUX)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
 
 VeyonCore* VeyonCore::s_instance = nullptr;
 
@@ -74,6 +81,7 @@ VeyonCore::VeyonCore( QCoreApplication* application, Component component, const
 	m_userGroupsBackendManager( nullptr ),
 	m_networkObjectDirectoryManager( nullptr ),
 	m_component( component ),
+	m_appComponentName( appComponentName ),
 	m_applicationName( QStringLiteral( "Veyon" ) ),
 	m_debugging( false )
 {
@@ -81,6 +89,8 @@ VeyonCore::VeyonCore( QCoreApplication* application, Component component, const
 
 	s_instance = this;
 
+	const Tracer::Scope traceScope( "VeyonCore::VeyonCore", appComponentName );
+
 	initPlatformPlugin();
 
 	initConfiguration();
@@ -506,6 +516,8 @@ int VeyonCore::exec()
 {
 	Q_EMIT applicationLoaded();
 
+	Tracer::milestone( "running" );
+
 	vDebug() << "Running";
 
 	const auto result = QCoreApplication::exec();
@@ -517,8 +529,22 @@ int VeyonCore::exec()
 
 
 
+void VeyonCore::reapplyConfiguration()
+{
+	delete m_logger;
+	m_logger = nullptr;
+
+	initLogging( m_appComponentName );
+
+	initTlsConfiguration();
+}
+
+
+
 void VeyonCore::initPlatformPlugin()
 {
+	const Tracer::Scope traceScope( "VeyonCore::initPlatformPlugin" );
+
 	// initialize plugin manager and load platform plugins first
 	m_pluginManager = new PluginManager( this );
 	m_pluginManager->loadPlatformPlugins();
@@ -532,6 +558,8 @@ void VeyonCore::initPlatformPlugin()
 
 void VeyonCore::initSession()
 {
+	const Tracer::Scope traceScope( "VeyonCore::initSession" );
+
 	if( component() != Component::Service && config().multiSessionModeEnabled() )
 	{
 		const auto systemEnv = QProcessEnvironment::systemEnvironment();
@@ -557,6 +585,8 @@ void VeyonCore::initSession()
 
 void VeyonCore::initConfiguration()
 {
+	const Tracer::Scope traceScope( "VeyonCore::initConfiguration" );
+
 	m_config = new VeyonConfiguration();
 	m_config->upgrade();
 
@@ -575,6 +605,8 @@ void VeyonCore::initConfiguration()
 
 void VeyonCore::initLogging( const QString& appComponentName )
 {
+	const Tracer::Scope traceScope( "VeyonCore::initLogging" );
+
 	const auto currentSessionId = sessionId();
 
 	if( currentSessionId != PlatformSessionFunctions::DefaultSessionId )
@@ -595,6 +627,15 @@ void VeyonCore::initLogging( const QString& appComponentName )
 
 void VeyonCore::initLocaleAndTranslation()
 {
+	const Tracer::Scope traceScope( "VeyonCore::initLocaleAndTranslation" );
+
+	// the service doesn't present any UI itself - servers do (e.g. tray icon, access and
+	// authentication dialogs and notifications) so they have to be translated
+	if( component() == Component::Service )
+	{
+		return;
+	}
+
 	if( TranslationLoader::load( QStringLiteral("qtbase") ) == false )
 	{
 		TranslationLoader::load( QStringLiteral("qt") );
@@ -613,6 +654,8 @@ void VeyonCore::initLocaleAndTranslation()
 
 void VeyonCore::initCryptoCore()
 {
+	const Tracer::Scope traceScope( "VeyonCore::initCryptoCore" );
+
 	m_cryptoCore = new CryptoCore;
 }
 
@@ -620,6 +663,8 @@ void VeyonCore::initCryptoCore()
 
 void VeyonCore::initQmlCore()
 {
+	const Tracer::Scope traceScope( "VeyonCore::initQmlCore" );
+
 	m_qmlCore = new QmlCore( this );
 }
 
@@ -640,6 +685,8 @@ void VeyonCore::initAuthenticationCredentials()
 
 void VeyonCore::initPlugins()
 {
+	const Tracer::Scope traceScope( "VeyonCore::initPlugins" );
+
 	// load all other (non-platform) plugins
 	m_pluginManager->loadPlugins();
 	m_pluginManager->upgradePlugins();
@@ -651,6 +698,8 @@ void VeyonCore::initPlugins()
 
 void VeyonCore::initManagers()
 {
+	const Tracer::Scope traceScope( "VeyonCore::initManagers" );
+
 	m_authenticationManager = new AuthenticationManager( this );
 	m_featureManager = new FeatureManager(this);
 	m_userGroupsBackendManager = new UserGroupsBackendManager( this );
@@ -670,6 +719,8 @@ void VeyonCore::initSystemInfo()
 
 void VeyonCore::initTlsConfiguration()
 {
+	const Tracer::Scope traceScope( "VeyonCore::initTlsConfiguration" );
+
 	auto tlsConfig{TlsConfiguration::defaultConfiguration()};
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
@@ -678,6 +729,8 @@ void VeyonCore::initTlsConfiguration()
 	tlsConfig.setProtocol( QSsl::TlsV1_2OrLater );
 #endif
 
+	setTlsCipherPreferences( &tlsConfig );
+
 	if( config().tlsUseCertificateAuthority() )
 	{
 		loadCertificateAuthorityFiles( &tlsConfig );
@@ -692,6 +745,73 @@ void VeyonCore::initTlsConfiguration()
 
 
 
+bool VeyonCore::isTransportEncryptionRequired( const QHostAddress& peerAddress )
+{
+	// IPv4 peers connecting to dual-stack sockets appear as IPv4-mapped IPv6 addresses
+	auto ok = false;
+	const auto ipv4Address = QHostAddress( peerAddress.toIPv4Address( &ok ) );
+	const auto address = ok ? ipv4Address : peerAddress;
+
+	const auto networks = config().unencryptedNetworks();
+	for( const auto& network : networks )
+	{
+		const auto subnet = QHostAddress::parseSubnet( network.trimmed() );
+		if( subnet.first.isNull() == false && address.isInSubnet( subnet ) )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+
+void VeyonCore::setTlsCipherPreferences( TlsConfiguration* tlsConfig )
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 13, 0)
+	// forward secrecy with AEAD ciphers only - prefer AES-GCM if the CPU accelerates AES
+	// and ChaCha20 otherwise, which is considerably faster in software
+	const auto aesCiphers = QByteArrayLiteral("TLS_AES_128_GCM_SHA256:TLS_AES_256_GCM_SHA384");
+	const auto chaChaCiphers = QByteArrayLiteral("TLS_CHACHA20_POLY1305_SHA256");
+	const auto aesCipherString = QByteArrayLiteral("ECDHE+AESGCM");
+	const auto chaChaCipherString = QByteArrayLiteral("ECDHE+CHACHA20");
+
+	if( hasHardwareAes() )
+	{
+		tlsConfig->setBackendConfigurationOption( "Ciphersuites", aesCiphers + ':' + chaChaCiphers );
+		tlsConfig->setBackendConfigurationOption( "CipherString", aesCipherString + ':' + chaChaCipherString );
+	}
+	else
+	{
+		tlsConfig->setBackendConfigurationOption( "Ciphersuites", chaChaCiphers + ':' + aesCiphers );
+		tlsConfig->setBackendConfigurationOption( "CipherString", chaChaCipherString + ':' + aesCipherString );
+	}
+
+	// X25519 key exchange is the cheapest one, let servers pick ChaCha20 for clients without AES acceleration
+	tlsConfig->setBackendConfigurationOption( "Groups", QByteArrayLiteral("X25519:P-256:P-384") );
+	tlsConfig->setBackendConfigurationOption( "Options", QByteArrayLiteral("ServerPreference,PrioritizeChaCha") );
+#else
+	Q_UNUSED(tlsConfig)
+#endif
+}
+
+
+
+bool VeyonCore::hasHardwareAes()
+{
+#if (defined(Q_PROCESSOR_X86) && (defined(Q_CC_GNU) || defined(Q_CC_CLANG)))
+	return __builtin_cpu_supports("aes");
+#elif defined(Q_PROCESSOR_ARM_64) && defined(Q_OS_LINUX)
+	return getauxval( AT_HWCAP ) & HWCAP_AES;
+#else
+	// assume modern hardware which OpenSSL optimizes for by default
+	return true;
+#endif
+}
+
+
+
 bool VeyonCore::loadCertificateAuthorityFiles( TlsConfiguration* tlsConfig )
 {
 	QFile caCertFile( filesystem().expandPath( config().tlsCaCertificateFile() ) );
@@ -789,7 +909,7 @@ bool VeyonCore::loadCertificateAuthorityFiles( TlsConfiguration* tlsConfig )
 
 bool VeyonCore::addSelfSignedHostCertificate( TlsConfiguration* tlsConfig )
 {
-	const auto privateKey = cryptoCore().createPrivateKey();
+	const auto privateKey = cryptoCore().createPrivateKey( CryptoCore::SelfSignedHostKeySize );
 	if( privateKey.isNull() )
 	{
 		vCritical() << "failed to create private key for host certificate";
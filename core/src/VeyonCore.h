@@ -42,6 +42,7 @@
 #endif
 
 class QCoreApplication;
+class QHostAddress;
 class QScreen;
 class QSslConfiguration;
 class QWidget;
@@ -95,6 +96,9 @@ public:
 
 	static constexpr char RfbSecurityTypeVeyon = 40;
 
+	// sent by clients instead of a TLS ClientHello to request an unencrypted transport
+	static constexpr char PlainTransportRequest = 'P';
+
 	VeyonCore( QCoreApplication* application, Component component, const QString& appComponentName );
 	~VeyonCore() override;
 
@@ -195,8 +199,14 @@ public:
 
 	static QString screenName( const QScreen& screen, int index );
 
+	// returns false if the peer is located in a network configured for unencrypted connections
+	static bool isTransportEncryptionRequired( const QHostAddress& peerAddress );
+
 	int exec();
 
+	// re-initializes logging and TLS settings after the configuration has been reloaded
+	void reapplyConfiguration();
+
 private:
 	void initPlatformPlugin();
 	void initSession();
@@ -212,6 +222,8 @@ private:
 	void initSystemInfo();
 	void initTlsConfiguration();
 
+	static void setTlsCipherPreferences( TlsConfiguration* tlsConfig );
+	static bool hasHardwareAes();
 	bool loadCertificateAuthorityFiles( TlsConfiguration* tlsConfig );
 	bool addSelfSignedHostCertificate( TlsConfiguration* tlsConfig );
 
@@ -233,6 +245,7 @@ private:
 	NetworkObjectDirectoryManager* m_networkObjectDirectoryManager;
 
 	Component m_component;
+	QString m_appComponentName;
 	QString m_applicationName;
 	bool m_debugging;
 
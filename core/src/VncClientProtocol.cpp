@@ -82,6 +82,8 @@ VncClientProtocol::VncClientProtocol( QIODevice* socket, const Password& vncPass
 void VncClientProtocol::start()
 {
 	m_state = State::Protocol;
+	m_minimumMessageSize = 0;
+	m_updateMessage.clear();
 }
 
 
@@ -158,15 +160,22 @@ bool VncClientProtocol::setEncodings( const QVector<uint32_t>& encodings )
 
 
 void VncClientProtocol::requestFramebufferUpdate( bool incremental )
+{
+	requestFramebufferUpdate( QRect( 0, 0, m_framebufferWidth, m_framebufferHeight ), incremental );
+}
+
+
+
+void VncClientProtocol::requestFramebufferUpdate( const QRect& rect, bool incremental )
 {
 	rfbFramebufferUpdateRequestMsg updateRequest;
 
 	updateRequest.type = rfbFramebufferUpdateRequest;
 	updateRequest.incremental = incremental ? 1 : 0;
-	updateRequest.x = 0;
-	updateRequest.y = 0;
-	updateRequest.w = qFromBigEndian<uint16_t>( m_framebufferWidth );
-	updateRequest.h = qFromBigEndian<uint16_t>( m_framebufferHeight );
+	updateRequest.x = qFromBigEndian<uint16_t>( rect.x() );
+	updateRequest.y = qFromBigEndian<uint16_t>( rect.y() );
+	updateRequest.w = qFromBigEndian<uint16_t>( rect.width() );
+	updateRequest.h = qFromBigEndian<uint16_t>( rect.height() );
 
 	if( m_socket->write( reinterpret_cast<const char *>( &updateRequest ), sz_rfbFramebufferUpdateRequestMsg ) != sz_rfbFramebufferUpdateRequestMsg )
 	{
@@ -186,6 +195,23 @@ bool VncClientProtocol::receiveMessage()
 		return false;
 	}
 
+	// skip the remains of an oversized message in chunks so it never is buffered completely
+	while( m_discardSize > 0 )
+	{
+		const auto discardedSize = m_socket->read( int( qMin<qint64>( m_discardSize, DiscardChunkSize ) ) ).size(); // Flawfinder: ignore
+		if( discardedSize <= 0 )
+		{
+			return false;
+		}
+		m_discardSize -= discardedSize;
+	}
+
+	// continue receiving a partially received framebuffer update message
+	if( m_updateMessage.isEmpty() == false )
+	{
+		return receiveFramebufferUpdateMessage();
+	}
+
 	uint8_t messageType = 0;
 	if( m_socket->peek( reinterpret_cast<char *>( &messageType ), sizeof(messageType) ) != sizeof(messageType) )
 	{
@@ -416,26 +442,96 @@ bool VncClientProtocol::receiveServerInitMessage()
 
 bool VncClientProtocol::receiveFramebufferUpdateMessage()
 {
-	// peek all available data and work on a local buffer so we can continously read from it
-	auto data = m_socket->peek( m_socket->bytesAvailable() );
+	if( m_updateMessage.isEmpty() )
+	{
+		m_minimumMessageSize = sz_rfbFramebufferUpdateMsg;
+		m_parsedMessageSize = 0;
+		m_remainingRects = 0;
+		m_hextileResumeTile = 0;
+		m_updatedRegion = {};
+		m_updateContainsCopyRect = false;
+		m_updateContainsStatefulRect = false;
+	}
+
+	while( true )
+	{
+		if( m_minimumMessageSize > MaximumMessageSize )
+		{
+			vCritical() << "framebuffer update message too big or invalid";
+			m_socket->close();
+			return false;
+		}
+
+		// move exactly as many bytes from the socket as the parser requires so far so we never
+		// consume data of subsequent messages and never have to copy or re-read the message again
+		const auto messageSize = m_updateMessage.size();
+		const auto missingSize = qMin( m_minimumMessageSize - messageSize, m_socket->bytesAvailable() );
+		if( missingSize > 0 )
+		{
+			m_updateMessage.resize( int(messageSize + missingSize) );
+			const auto readSize = m_socket->read( m_updateMessage.data() + messageSize, missingSize ); // Flawfinder: ignore
+			m_updateMessage.resize( int(messageSize + qMax<qint64>( 0, readSize )) );
+		}
 
-	QBuffer buffer( &data );
+		if( m_updateMessage.size() < m_minimumMessageSize )
+		{
+			return false;
+		}
+
+		const auto previousMinimumMessageSize = m_minimumMessageSize;
+
+		if( parseFramebufferUpdateMessage() )
+		{
+			break;
+		}
+
+		// parser failed without requesting more data, i.e. the message is invalid
+		if( m_minimumMessageSize <= previousMinimumMessageSize ||
+			m_socket->isOpen() == false )
+		{
+			vCritical() << "invalid framebuffer update message";
+			m_updateMessage.clear();
+			m_socket->close();
+			return false;
+		}
+	}
+
+	m_lastUpdatedRect = m_updatedRegion.boundingRect();
+	m_lastUpdateContainsCopyRect = m_updateContainsCopyRect;
+	m_lastUpdateContainsStatefulRect = m_updateContainsStatefulRect;
+	m_lastMessage = std::move( m_updateMessage );
+	m_updateMessage = {};
+	m_minimumMessageSize = 0;
+
+	return true;
+}
+
+
+
+bool VncClientProtocol::parseFramebufferUpdateMessage()
+{
+	QBuffer buffer( &m_updateMessage );
 	buffer.open( QBuffer::ReadOnly ); // Flawfinder: ignore
 
-	rfbFramebufferUpdateMsg message;
-	if( buffer.read( reinterpret_cast<char *>( &message ), sz_rfbFramebufferUpdateMsg ) != sz_rfbFramebufferUpdateMsg )
+	if( m_parsedMessageSize == 0 )
 	{
-		return false;
-	}
+		rfbFramebufferUpdateMsg message;
+		if( readData( buffer, &message, sz_rfbFramebufferUpdateMsg ) == false )
+		{
+			return false;
+		}
 
-	QRegion updatedRegion;
+		m_remainingRects = qFromBigEndian( message.nRects );
+		m_parsedMessageSize = buffer.pos();
+	}
 
-	const auto nRects = qFromBigEndian( message.nRects );
+	// resume after the last completely parsed rect
+	buffer.seek( m_parsedMessageSize );
 
-	for( int i = 0; i < nRects; ++i )
+	while( m_remainingRects > 0 )
 	{
 		rfbFramebufferUpdateRectHeader rectHeader;
-		if( buffer.read( reinterpret_cast<char *>( &rectHeader ), sz_rfbFramebufferUpdateRectHeader ) != sz_rfbFramebufferUpdateRectHeader )
+		if( readData( buffer, &rectHeader, sz_rfbFramebufferUpdateRectHeader ) == false )
 		{
 			return false;
 		}
@@ -448,6 +544,7 @@ bool VncClientProtocol::receiveFramebufferUpdateMessage()
 
 		if( rectHeader.encoding == rfbEncodingLastRect )
 		{
+			m_remainingRects = 0;
 			break;
 		}
 
@@ -456,18 +553,33 @@ bool VncClientProtocol::receiveFramebufferUpdateMessage()
 			return false;
 		}
 
+		if( rectHeader.encoding == rfbEncodingCopyRect )
+		{
+			m_updateContainsCopyRect = true;
+		}
+
+		// zlib based encodings share their compression streams across rects and messages
+		if( rectHeader.encoding == rfbEncodingZlib ||
+			rectHeader.encoding == rfbEncodingTight ||
+			rectHeader.encoding == rfbEncodingZRLE ||
+			rectHeader.encoding == rfbEncodingZYWRLE )
+		{
+			m_updateContainsStatefulRect = true;
+		}
+
 		if( isPseudoEncoding( rectHeader ) == false &&
 			rectHeader.r.x+rectHeader.r.w <= m_framebufferWidth &&
 			rectHeader.r.y+rectHeader.r.h <= m_framebufferHeight )
 		{
-			updatedRegion += QRect( rectHeader.r.x, rectHeader.r.y, rectHeader.r.w, rectHeader.r.h );
+			m_updatedRegion += QRect( rectHeader.r.x, rectHeader.r.y, rectHeader.r.w, rectHeader.r.h );
 		}
-	}
 
-	m_lastUpdatedRect = updatedRegion.boundingRect();
+		m_parsedMessageSize = buffer.pos();
+		m_hextileResumeTile = 0;
+		--m_remainingRects;
+	}
 
-	// save as much data as we read by processing rects
-	return readMessage( static_cast<int>( buffer.pos() ) );
+	return true;
 }
 
 
@@ -501,7 +613,15 @@ bool VncClientProtocol::receiveCutTextMessage()
 		return false;
 	}
 
-	return readMessage( sz_rfbServerCutTextMsg + static_cast<int>( qFromBigEndian( message.length ) ) );
+	const auto length = qFromBigEndian( message.length );
+	if( length > MaximumCutTextLength )
+	{
+		vWarning() << "discarding cut text of" << length << "bytes";
+		m_discardSize = sz_rfbServerCutTextMsg + qint64(length);
+		return receiveMessage();
+	}
+
+	return readMessage( sz_rfbServerCutTextMsg + int(length) );
 }
 
 
@@ -536,20 +656,53 @@ bool VncClientProtocol::readMessage( int size )
 		return false;
 	}
 
-	auto message = m_socket->read( size );
-	if( message.size() == size )
+	// reuse the buffer of the previous message as long as no one else holds a reference to it
+	m_lastMessage.resize( size );
+	const auto readSize = m_socket->read( m_lastMessage.data(), size ); // Flawfinder: ignore
+	if( readSize == size )
 	{
-		m_lastMessage = message;
 		return true;
 	}
 
-	vWarning() << "only received" << message.size() << "of" << size << "bytes";
+	vWarning() << "only received" << readSize << "of" << size << "bytes";
 
 	return false;
 }
 
 
 
+bool VncClientProtocol::readData( QBuffer& buffer, void* data, qint64 size )
+{
+	if( buffer.bytesAvailable() < size )
+	{
+		m_minimumMessageSize = qMax( m_minimumMessageSize, buffer.pos() + size );
+		return false;
+	}
+
+	return buffer.read( static_cast<char *>( data ), size ) == size;
+}
+
+
+
+bool VncClientProtocol::skipData( QBuffer& buffer, qint64 size )
+{
+	if( size < 0 )
+	{
+		return false;
+	}
+
+	if( buffer.bytesAvailable() < size )
+	{
+		m_minimumMessageSize = qMax( m_minimumMessageSize, buffer.pos() + size );
+		return false;
+	}
+
+	// just advance instead of copying payload data we don't process anyway
+	return buffer.seek( buffer.pos() + size );
+}
+
+
+
 bool VncClientProtocol::handleRect( QBuffer& buffer, rfbFramebufferUpdateRectHeader rectHeader )
 {
 	const uint width = rectHeader.r.w;
@@ -565,27 +718,27 @@ bool VncClientProtocol::handleRect( QBuffer& buffer, rfbFramebufferUpdateRectHea
 
 	case rfbEncodingXCursor:
 		return width * height == 0 ||
-				( buffer.read( sz_rfbXCursorColors ).size() == sz_rfbXCursorColors &&
-				  buffer.read( size_t(2) * bytesPerRow * height ).size() == static_cast<int>( 2 * bytesPerRow * height ) );
+				( skipData( buffer, sz_rfbXCursorColors ) &&
+				  skipData( buffer, qint64(2) * bytesPerRow * height ) );
 
 	case rfbEncodingRichCursor:
 		return width * height == 0 ||
-				( buffer.read( size_t(width) * height * bytesPerPixel ).size() == static_cast<int>( width * height * bytesPerPixel ) &&
-				  buffer.read( size_t(bytesPerRow) * height ).size() == static_cast<int>( bytesPerRow * height ) );
+				( skipData( buffer, qint64(width) * height * bytesPerPixel ) &&
+				  skipData( buffer, qint64(bytesPerRow) * height ) );
 
 	case rfbEncodingSupportedMessages:
-		return buffer.read( sz_rfbSupportedMessages ).size() == sz_rfbSupportedMessages;
+		return skipData( buffer, sz_rfbSupportedMessages );
 
 	case rfbEncodingSupportedEncodings:
 	case rfbEncodingServerIdentity:
 		// width = byte count
-		return buffer.read( width ).size() == static_cast<int>( width );
+		return skipData( buffer, width );
 
 	case rfbEncodingRaw:
-		return buffer.read( size_t(width) * height * bytesPerPixel ).size() == static_cast<int>( width * height * bytesPerPixel );
+		return skipData( buffer, qint64(width) * height * bytesPerPixel );
 
 	case rfbEncodingCopyRect:
-		return buffer.read( sz_rfbCopyRect ).size() == sz_rfbCopyRect;
+		return skipData( buffer, sz_rfbCopyRect );
 
 	case rfbEncodingRRE:
 		return handleRectEncodingRRE( buffer, bytesPerPixel );
@@ -632,7 +785,7 @@ bool VncClientProtocol::handleRectEncodingRRE( QBuffer& buffer, uint bytesPerPix
 {
 	rfbRREHeader hdr;
 
-	if( buffer.read( reinterpret_cast<char *>( &hdr ), sz_rfbRREHeader ) != sz_rfbRREHeader )
+	if( readData( buffer, &hdr, sz_rfbRREHeader ) == false )
 	{
 		return false;
 	}
@@ -640,7 +793,7 @@ bool VncClientProtocol::handleRectEncodingRRE( QBuffer& buffer, uint bytesPerPix
 	const auto rectDataSize = qFromBigEndian( hdr.nSubrects ) * ( bytesPerPixel + sz_rfbRectangle );
 	const auto totalDataSize = static_cast<int>( bytesPerPixel + rectDataSize );
 
-	return totalDataSize < MaxMessageSize && buffer.read( totalDataSize ).size() == totalDataSize;
+	return totalDataSize < MaxMessageSize && skipData( buffer, totalDataSize );
 }
 
 
@@ -649,7 +802,7 @@ bool VncClientProtocol::handleRectEncodingCoRRE( QBuffer& buffer, uint bytesPerP
 {
 	rfbRREHeader hdr;
 
-	if( buffer.read( reinterpret_cast<char *>( &hdr ), sz_rfbRREHeader ) != sz_rfbRREHeader )
+	if( readData( buffer, &hdr, sz_rfbRREHeader ) == false )
 	{
 		return false;
 	}
@@ -657,7 +810,7 @@ bool VncClientProtocol::handleRectEncodingCoRRE( QBuffer& buffer, uint bytesPerP
 	const auto rectDataSize = qFromBigEndian( hdr.nSubrects ) * ( bytesPerPixel + 4 );
 	const auto totalDataSize = static_cast<int>( bytesPerPixel + rectDataSize );
 
-	return totalDataSize < MaxMessageSize && buffer.read( totalDataSize ).size() == totalDataSize;
+	return totalDataSize < MaxMessageSize && skipData( buffer, totalDataSize );
 
 }
 
@@ -672,79 +825,93 @@ bool VncClientProtocol::handleRectEncodingHextile( QBuffer& buffer,
 	const uint rw = rectHeader.r.w;
 	const uint rh = rectHeader.r.h;
 
-	for( uint y = ry; y < ry+rh; y += 16 )
+	const uint tilesPerRow = ( rw + 15 ) / 16;
+	const uint tileCount = tilesPerRow * ( ( rh + 15 ) / 16 );
+
+	// continue with the first incomplete tile of a partially received rect
+	if( m_hextileResumeTile > 0 )
 	{
-		for( uint x = rx; x < rx+rw; x += 16 )
-		{
-			uint w = 16;
-			uint h = 16;
-			if( rx+rw - x < 16 )
-			{
-				w = rx+rw - x;
-			}
-			if( ry+rh - y < 16 )
-			{
-				h = ry+rh - y;
-			}
+		buffer.seek( m_hextileResumeOffset );
+	}
 
-			uint8_t subEncoding = 0;
-			if( buffer.read( reinterpret_cast<char *>( &subEncoding ), 1 ) != 1 )
-			{
-				return false;
-			}
+	for( uint tile = m_hextileResumeTile; tile < tileCount; ++tile )
+	{
+		const uint x = rx + ( tile % tilesPerRow ) * 16;
+		const uint y = ry + ( tile / tilesPerRow ) * 16;
 
-			if( subEncoding & rfbHextileRaw )
-			{
-				const auto dataSize = static_cast<int>( w * h * bytesPerPixel );
-				if( buffer.read( dataSize ).size() != dataSize )
-				{
-					return false;
-				}
-				continue;
-			}
+		uint w = 16;
+		uint h = 16;
+		if( rx+rw - x < 16 )
+		{
+			w = rx+rw - x;
+		}
+		if( ry+rh - y < 16 )
+		{
+			h = ry+rh - y;
+		}
 
-			if( subEncoding & rfbHextileBackgroundSpecified )
-			{
-				if( buffer.read( bytesPerPixel ).size() != static_cast<int>( bytesPerPixel ) )
-				{
-					return false;
-				}
-			}
+		m_hextileResumeTile = tile;
+		m_hextileResumeOffset = buffer.pos();
 
-			if( subEncoding & rfbHextileForegroundSpecified )
+		uint8_t subEncoding = 0;
+		if( readData( buffer, &subEncoding, 1 ) == false )
+		{
+			// each remaining tile requires at least one more byte
+			m_minimumMessageSize = qMax( m_minimumMessageSize, buffer.pos() + ( tileCount - tile ) );
+			return false;
+		}
+
+		if( subEncoding & rfbHextileRaw )
+		{
+			const auto dataSize = static_cast<int>( w * h * bytesPerPixel );
+			if( skipData( buffer, dataSize ) == false )
 			{
-				if( buffer.read( bytesPerPixel ).size() != static_cast<int>( bytesPerPixel ) )
-				{
-					return false;
-				}
+				return false;
 			}
+			continue;
+		}
 
-			if( !( subEncoding & rfbHextileAnySubrects ) )
+		if( subEncoding & rfbHextileBackgroundSpecified )
+		{
+			if( skipData( buffer, bytesPerPixel ) == false )
 			{
-				continue;
+				return false;
 			}
+		}
 
-			uint8_t nSubrects = 0;
-			if( buffer.read( reinterpret_cast<char *>( &nSubrects ), 1 ) != 1 )
+		if( subEncoding & rfbHextileForegroundSpecified )
+		{
+			if( skipData( buffer, bytesPerPixel ) == false )
 			{
 				return false;
 			}
+		}
 
-			int subRectDataSize = 0;
+		if( !( subEncoding & rfbHextileAnySubrects ) )
+		{
+			continue;
+		}
 
-			if( subEncoding & rfbHextileSubrectsColoured )
-			{
-				subRectDataSize = static_cast<int>( nSubrects * ( 2 + bytesPerPixel ) );
-			}
-			else
-			{
-				subRectDataSize = nSubrects * 2;
-			}
+		uint8_t nSubrects = 0;
+		if( readData( buffer, &nSubrects, 1 ) == false )
+		{
+			return false;
+		}
 
-			if( buffer.read( subRectDataSize ).size() != subRectDataSize )
-			{
-				return false;
-			}
+		int subRectDataSize = 0;
+
+		if( subEncoding & rfbHextileSubrectsColoured )
+		{
+			subRectDataSize = static_cast<int>( nSubrects * ( 2 + bytesPerPixel ) );
+		}
+		else
+		{
+			subRectDataSize = nSubrects * 2;
+		}
+
+		if( skipData( buffer, subRectDataSize ) == false )
+		{
+			return false;
 		}
 	}
 
@@ -757,14 +924,14 @@ bool VncClientProtocol::handleRectEncodingZlib( QBuffer& buffer )
 {
 	rfbZlibHeader hdr;
 
-	if( buffer.read( reinterpret_cast<char *>( &hdr ), sz_rfbZlibHeader ) != sz_rfbZlibHeader )
+	if( readData( buffer, &hdr, sz_rfbZlibHeader ) == false )
 	{
 		return false;
 	}
 
 	const auto n = qFromBigEndian( hdr.nBytes );
 
-	return n < MaxMessageSize && uint32_t(buffer.read(n).size()) == n;
+	return n < MaxMessageSize && skipData(buffer, n);
 }
 
 
@@ -773,14 +940,14 @@ bool VncClientProtocol::handleRectEncodingZRLE(QBuffer &buffer)
 {
 	rfbZRLEHeader hdr;
 
-	if( buffer.read( reinterpret_cast<char *>( &hdr ), sz_rfbZRLEHeader ) != sz_rfbZRLEHeader )
+	if( readData( buffer, &hdr, sz_rfbZRLEHeader ) == false )
 	{
 		return false;
 	}
 
 	const auto n = qFromBigEndian( hdr.length );
 
-	return n < MaxMessageSize && uint32_t(buffer.read(n).size()) == n;
+	return n < MaxMessageSize && skipData(buffer, n);
 }
 
 
@@ -788,12 +955,12 @@ bool VncClientProtocol::handleRectEncodingZRLE(QBuffer &buffer)
 bool VncClientProtocol::handleRectEncodingTight(QBuffer& buffer,
 												const rfbFramebufferUpdateRectHeader rectHeader)
 {
-	static const auto readCompactLength = [](QBuffer& buffer) -> int64_t
+	const auto readCompactLength = [this](QBuffer& buffer) -> int64_t
 	{
 		int64_t len;
 		uint8_t b;
 
-		if (buffer.read(reinterpret_cast<char *>(&b), 1 ) != 1)
+		if (readData(buffer, &b, 1) == false)
 		{
 			return -1;
 		}
@@ -802,7 +969,7 @@ bool VncClientProtocol::handleRectEncodingTight(QBuffer& buffer,
 
 		if (b & 0x80)
 		{
-			if (buffer.read(reinterpret_cast<char *>(&b), 1) != 1)
+			if (readData(buffer, &b, 1) == false)
 			{
 				return -1;
 			}
@@ -811,7 +978,7 @@ bool VncClientProtocol::handleRectEncodingTight(QBuffer& buffer,
 
 			if (b & 0x80)
 			{
-				if (buffer.read(reinterpret_cast<char *>(&b), 1) != 1)
+				if (readData(buffer, &b, 1) == false)
 				{
 					return -1;
 				}
@@ -836,7 +1003,7 @@ bool VncClientProtocol::handleRectEncodingTight(QBuffer& buffer,
 	const auto bytesPerPixel = bitsPerPixel / 8;
 
 	uint8_t compCtl = 255;
-	if (buffer.read(reinterpret_cast<char *>(&compCtl), 1) != 1)
+	if (readData(buffer, &compCtl, 1) == false)
 	{
 		return false;
 	}
@@ -850,13 +1017,13 @@ bool VncClientProtocol::handleRectEncodingTight(QBuffer& buffer,
 
 	if (compCtl == rfbTightFill)
 	{
-		return buffer.read(bytesPerPixel).size() == bytesPerPixel;
+		return skipData(buffer, bytesPerPixel);
 	}
 
 	if (compCtl == rfbTightJpeg)
 	{
 		const auto dataLength = readCompactLength(buffer);
-		return buffer.read(dataLength).size() == dataLength;
+		return skipData(buffer, dataLength);
 	}
 
 	if (compCtl > rfbTightMaxSubencoding)
@@ -868,7 +1035,7 @@ bool VncClientProtocol::handleRectEncodingTight(QBuffer& buffer,
 	if (compCtl & rfbTightExplicitFilter)
 	{
 		uint8_t filterId = 0;
-		if (buffer.read(reinterpret_cast<char *>(&filterId), 1) != 1)
+		if (readData(buffer, &filterId, 1) == false)
 		{
 			return false;
 		}
@@ -880,7 +1047,7 @@ bool VncClientProtocol::handleRectEncodingTight(QBuffer& buffer,
 		case rfbTightFilterPalette:
 		{
 			uint8_t numColors;
-			if (buffer.read(reinterpret_cast<char *>(&numColors), 1) != 1)
+			if (readData(buffer, &numColors, 1) == false)
 			{
 				return false;
 			}
@@ -890,7 +1057,7 @@ bool VncClientProtocol::handleRectEncodingTight(QBuffer& buffer,
 				return false;
 			}
 			const auto rectBytes = tightRectColors * bytesPerPixel;
-			if (buffer.read(rectBytes).size() != rectBytes)
+			if (skipData(buffer, rectBytes) == false)
 			{
 				return false;
 			}
@@ -911,7 +1078,7 @@ bool VncClientProtocol::handleRectEncodingTight(QBuffer& buffer,
 	const int uncompressedRectSize = rectHeader.r.h * rowSize;
 	if (uncompressedRectSize < MaximumUncompressedSize)
 	{
-		return buffer.read(uncompressedRectSize).size() == uncompressedRectSize;
+		return skipData(buffer, uncompressedRectSize);
 	}
 
 	const auto compressedLength = readCompactLength(buffer);
@@ -921,7 +1088,7 @@ bool VncClientProtocol::handleRectEncodingTight(QBuffer& buffer,
 		return false;
 	}
 
-	return buffer.read(compressedLength).size() == compressedLength;
+	return skipData(buffer, compressedLength);
 }
 
 
@@ -929,18 +1096,17 @@ bool VncClientProtocol::handleRectEncodingTight(QBuffer& buffer,
 bool VncClientProtocol::handleRectEncodingExtDesktopSize(QBuffer& buffer)
 {
 	rfbExtDesktopSizeMsg extDesktopSizeMsg;
-	if (buffer.peek(reinterpret_cast<char *>(&extDesktopSizeMsg), sz_rfbExtDesktopSizeMsg) != sz_rfbExtDesktopSizeMsg)
+	if (buffer.bytesAvailable() < sz_rfbExtDesktopSizeMsg)
 	{
+		m_minimumMessageSize = qMax(m_minimumMessageSize, buffer.pos() + sz_rfbExtDesktopSizeMsg);
 		return false;
 	}
 
+	buffer.peek(reinterpret_cast<char *>(&extDesktopSizeMsg), sz_rfbExtDesktopSizeMsg);
+
 	const auto totalMessageSize = sz_rfbExtDesktopSizeMsg + extDesktopSizeMsg.numberOfScreens * sz_rfbExtDesktopScreen;
-	if (buffer.bytesAvailable() >= totalMessageSize)
-	{
-		return buffer.read(totalMessageSize).size() == totalMessageSize;
-	}
 
-	return false;
+	return skipData(buffer, totalMessageSize);
 }
 
 
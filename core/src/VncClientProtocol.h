@@ -27,6 +27,7 @@
 #include "rfb/rfbproto.h"
 
 #include <QRect>
+#include <QRegion>
 
 #include "CryptoCore.h"
 
@@ -79,6 +80,7 @@ public:
 	bool setEncodings( const QVector<uint32_t>& encodings );
 
 	void requestFramebufferUpdate( bool incremental );
+	void requestFramebufferUpdate( const QRect& rect, bool incremental );
 
 	bool receiveMessage();
 
@@ -97,6 +99,20 @@ public:
 		return m_lastUpdatedRect;
 	}
 
+	// CopyRect rects refer to previous framebuffer contents, i.e. the last
+	// update can't be applied to an arbitrary framebuffer state
+	bool lastUpdateContainsCopyRect() const
+	{
+		return m_lastUpdateContainsCopyRect;
+	}
+
+	// the last update can be decoded on its own, i.e. it neither refers to previous framebuffer
+	// contents nor depends on compression state built up by previous messages
+	bool lastUpdateIsSelfContained() const
+	{
+		return m_lastUpdateContainsCopyRect == false && m_lastUpdateContainsStatefulRect == false;
+	}
+
 protected:
 	void setState(State state)
 	{
@@ -113,6 +129,7 @@ private:
 	bool receiveServerInitMessage();
 
 	bool receiveFramebufferUpdateMessage();
+	bool parseFramebufferUpdateMessage();
 	bool receiveColourMapEntriesMessage();
 	bool receiveBellMessage();
 	bool receiveCutTextMessage();
@@ -121,6 +138,9 @@ private:
 
 	bool readMessage( int size );
 
+	bool readData( QBuffer& buffer, void* data, qint64 size );
+	bool skipData( QBuffer& buffer, qint64 size );
+
 	bool handleRect( QBuffer& buffer, rfbFramebufferUpdateRectHeader rectHeader );
 	bool handleRectEncodingRRE( QBuffer& buffer, uint bytesPerPixel );
 	bool handleRectEncodingCoRRE( QBuffer& buffer, uint bytesPerPixel );
@@ -136,6 +156,8 @@ private:
 	static bool isPseudoEncoding( rfbFramebufferUpdateRectHeader header );
 
 	static constexpr auto MaximumMessageSize = 4096*4096*4;
+	static constexpr auto MaximumCutTextLength = 1024*1024;
+	static constexpr auto DiscardChunkSize = 64*1024;
 
 	QIODevice* m_socket{nullptr};
 	State m_state{State::Disconnected};
@@ -151,5 +173,20 @@ private:
 
 	QByteArray m_lastMessage;
 	QRect m_lastUpdatedRect;
+	bool m_lastUpdateContainsCopyRect{false};
+	bool m_lastUpdateContainsStatefulRect{false};
+
+	qint64 m_minimumMessageSize{0};
+	qint64 m_discardSize{0};
+
+	// state of a partially received framebuffer update message
+	QByteArray m_updateMessage;
+	qint64 m_parsedMessageSize{0};
+	int m_remainingRects{0};
+	uint m_hextileResumeTile{0};
+	qint64 m_hextileResumeOffset{0};
+	QRegion m_updatedRegion;
+	bool m_updateContainsCopyRect{false};
+	bool m_updateContainsStatefulRect{false};
 
 } ;
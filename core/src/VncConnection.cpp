@@ -27,15 +27,19 @@
 
 #include <rfb/rfbclient.h>
 
-#include <QBitmap>
+#include <QBuffer>
+#include <QHash>
 #include <QHostAddress>
 #include <QMutexLocker>
-#include <QPixmap>
 #include <QRegularExpression>
 #include <QSslSocket>
 #include <QTime>
 
+#include "FramebufferScaler.h"
+#include "Metrics.h"
 #include "PlatformNetworkFunctions.h"
+#include "RfbContinuousUpdates.h"
+#include "Tracer.h"
 #include "VeyonConfiguration.h"
 #include "VncConnection.h"
 #include "RfbClientCallback.h"
@@ -43,6 +47,7 @@
 #include "VncEvents.h"
 
 
+
 VncConnection::VncConnection( QObject* parent ) :
 	QThread( parent ),
 	m_verifyServerCertificate( VeyonCore::config().tlsUseCertificateAuthority() ),
@@ -54,13 +59,26 @@ VncConnection::VncConnection( QObject* parent ) :
 		m_connectTimeout = VeyonCore::config().vncConnectionConnectTimeout();
 		m_readTimeout = VeyonCore::config().vncConnectionReadTimeout();
 		m_connectionRetryInterval = VeyonCore::config().vncConnectionRetryInterval();
+		m_maximumConnectionRetryInterval = VeyonCore::config().vncConnectionMaximumRetryInterval();
 		m_messageWaitTimeout = VeyonCore::config().vncConnectionMessageWaitTimeout();
 		m_fastFramebufferUpdateInterval = VeyonCore::config().vncConnectionFastFramebufferUpdateInterval();
 		m_framebufferUpdateWatchdogTimeout = VeyonCore::config().vncConnectionFramebufferUpdateWatchdogTimeout();
 		m_socketKeepaliveIdleTime = VeyonCore::config().vncConnectionSocketKeepaliveIdleTime();
 		m_socketKeepaliveInterval = VeyonCore::config().vncConnectionSocketKeepaliveInterval();
 		m_socketKeepaliveCount = VeyonCore::config().vncConnectionSocketKeepaliveCount();
+		m_threadStackSize = VeyonCore::config().vncConnectionThreadStackSize();
+	}
+
+	// large deployments run one connection thread per computer so do not
+	// reserve the (usually much bigger) default stack size for each of them
+	if( m_threadStackSize > 0 )
+	{
+		setStackSize( uint(m_threadStackSize) );
 	}
+
+	m_currentConnectionRetryInterval = m_connectionRetryInterval;
+
+	m_latencyTimer.start();
 }
 
 
@@ -119,7 +137,9 @@ void VncConnection::stop()
 {
 	setClientData( VncConnectionTag, nullptr );
 
+	m_scaledFramebufferMutex.lock();
 	m_scaledFramebuffer = {};
+	m_scaledFramebufferMutex.unlock();
 
 	setControlFlag( ControlFlag::TerminateThread, true );
 
@@ -191,6 +211,11 @@ void VncConnection::setPort( int port )
 
 void VncConnection::setQuality(VncConnectionConfiguration::Quality quality)
 {
+	if (quality == m_quality)
+	{
+		return;
+	}
+
 	m_quality = quality;
 
 	if (m_client)
@@ -202,6 +227,88 @@ void VncConnection::setQuality(VncConnectionConfiguration::Quality quality)
 
 
 
+void VncConnection::setLowLatency( bool enabled )
+{
+	if( m_lowLatency == enabled )
+	{
+		return;
+	}
+
+	m_lowLatency = enabled;
+	m_pendingInputTimestamp = -1;
+
+	if (m_client)
+	{
+		updateEncodingSettingsFromQuality();
+		enqueueEvent(new VncUpdateFormatAndEncodingsEvent);
+	}
+}
+
+
+
+VncConnection::Statistics VncConnection::statistics()
+{
+	QMutexLocker locker( &m_statisticsMutex );
+
+	const auto elapsed = m_statisticsTimer.isValid() ? m_statisticsTimer.restart() : 0;
+	if( elapsed <= 0 )
+	{
+		m_statisticsTimer.start();
+	}
+
+	const auto frames = m_framebufferUpdateCount.fetchAndStoreRelaxed( 0 );
+	const auto bytes = m_receivedBytes.fetchAndStoreRelaxed( 0 );
+	const auto decodeTime = m_decodeTime.fetchAndStoreRelaxed( 0 );
+
+	Statistics statistics;
+	if( elapsed > 0 )
+	{
+		statistics.framesPerSecond = qreal(frames) * 1000 / elapsed;
+		statistics.bytesPerSecond = qreal(bytes) * 1000 / elapsed;
+	}
+	if( frames > 0 )
+	{
+		statistics.averageDecodeTime = qreal(decodeTime) / 1000000 / frames;
+	}
+	statistics.inputLatency = m_inputLatency;
+
+	m_eventQueueMutex.lock();
+	statistics.queuedEvents = m_eventQueue.size();
+	m_eventQueueMutex.unlock();
+
+	const auto encodings = m_encodings.load();
+	if( encodings )
+	{
+		statistics.encodings = QString::fromLatin1( encodings );
+	}
+
+	return statistics;
+}
+
+
+
+void VncConnection::setReducedColors( bool enabled )
+{
+	if( m_allowReducedColors && enabled != m_reducedColors )
+	{
+		m_reducedColors = enabled;
+		setControlFlag( ControlFlag::PixelFormatChanged, true );
+	}
+}
+
+
+
+void VncConnection::setScalingMode(VncConnectionConfiguration::ScalingMode scalingMode)
+{
+	m_scalingMode = scalingMode;
+
+	// enforce full rescale with new scaling mode
+	m_scaledFramebufferSourceRect = {};
+	setControlFlag(ControlFlag::ScaledFramebufferNeedsUpdate, true);
+}
+
+
+
 void VncConnection::setUseRemoteCursor( bool enabled )
 {
 	m_useRemoteCursor = enabled;
@@ -223,11 +330,23 @@ void VncConnection::setServerReachable()
 
 
 
-void VncConnection::enqueueEvent(VncEvent* event)
+void VncConnection::resetConnectionRetryInterval()
+{
+	if( m_currentConnectionRetryInterval.fetchAndStoreOrdered( m_connectionRetryInterval ) != m_connectionRetryInterval &&
+		state() == State::HostOffline )
+	{
+		m_updateIntervalSleeper.wakeAll();
+	}
+}
+
+
+
+bool VncConnection::enqueueEvent(VncEvent* event)
 {
 	if( state() != State::Connected )
 	{
-		return;
+		delete event;
+		return false;
 	}
 
 	m_eventQueueMutex.lock();
@@ -235,6 +354,8 @@ void VncConnection::enqueueEvent(VncEvent* event)
 	m_eventQueueMutex.unlock();
 
 	m_updateIntervalSleeper.wakeAll();
+
+	return true;
 }
 
 
@@ -247,6 +368,14 @@ bool VncConnection::isEventQueueEmpty()
 
 
 
+int VncConnection::eventQueueSize()
+{
+	QMutexLocker lock( &m_eventQueueMutex );
+	return m_eventQueue.size();
+}
+
+
+
 void VncConnection::setScaledSize( QSize s )
 {
 	QMutexLocker globalLock( &m_globalMutex );
@@ -255,6 +384,7 @@ void VncConnection::setScaledSize( QSize s )
 	{
 		m_scaledSize = s;
 		setControlFlag( ControlFlag::ScaledFramebufferNeedsUpdate, true );
+		m_updateIntervalSleeper.wakeAll();
 	}
 }
 
@@ -262,7 +392,9 @@ void VncConnection::setScaledSize( QSize s )
 
 QImage VncConnection::scaledFramebuffer()
 {
-	rescaleFramebuffer();
+	// rescaling happens on the connection thread only so views never block
+	// but always pick up the last finished image
+	QMutexLocker locker( &m_scaledFramebufferMutex );
 	return m_scaledFramebuffer;
 }
 
@@ -282,10 +414,29 @@ void VncConnection::setFramebufferUpdateInterval( int interval )
 
 
 
+void VncConnection::setFramebufferUpdateRegion( QRect region )
+{
+	QMutexLocker globalLock( &m_globalMutex );
+
+	if( m_framebufferUpdateRegion != region )
+	{
+		m_framebufferUpdateRegion = region;
+		setControlFlag( ControlFlag::FramebufferUpdateRegionChanged, true );
+		setControlFlag( ControlFlag::ScaledFramebufferNeedsUpdate, true );
+	}
+}
+
+
+
 void VncConnection::rescaleFramebuffer()
 {
-	if( hasValidFramebuffer() == false || m_scaledSize.isNull() )
+	m_globalMutex.lock();
+	const auto scaledSize = m_scaledSize;
+	m_globalMutex.unlock();
+
+	if( hasValidFramebuffer() == false || scaledSize.isNull() )
 	{
+		QMutexLocker locker( &m_scaledFramebufferMutex );
 		m_scaledFramebuffer = {};
 		return;
 	}
@@ -302,9 +453,120 @@ void VncConnection::rescaleFramebuffer()
 		return;
 	}
 
-	m_scaledFramebuffer = m_image.scaled( m_scaledSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation );
-
 	setControlFlag( ControlFlag::ScaledFramebufferNeedsUpdate, false );
+
+	m_dirtyRegionMutex.lock();
+	const auto dirtyRegion = m_dirtyRegion;
+	m_dirtyRegion = {};
+	m_dirtyRegionMutex.unlock();
+
+	// never modify the published image as it may be in use by other threads
+	m_scaledFramebufferMutex.lock();
+	auto scaledFramebuffer = m_scaledFramebuffer;
+	m_scaledFramebufferMutex.unlock();
+
+	auto previousScaledFramebuffer = scaledFramebuffer;
+
+	// only scale the area updates are requested for since the rest of the framebuffer is not updated
+	const auto sourceRect = framebufferUpdateRect();
+	const auto source = sourceRect == m_image.rect() ? m_image :
+							QImage( m_image.constBits() + sourceRect.y() * m_image.bytesPerLine() + sourceRect.x() * 4,
+									sourceRect.width(), sourceRect.height(), m_image.bytesPerLine(), m_image.format() );
+
+	QRegion sourceDirtyRegion = dirtyRegion.translated( -sourceRect.topLeft() ) & source.rect();
+
+	bool partialRescaleSucceeded = false;
+
+	if( m_scalingMode == VncConnectionConfiguration::ScalingMode::AreaAveraging &&
+		scaledFramebuffer.size() == scaledSize &&
+		m_scaledFramebufferSourceRect == sourceRect &&
+		isPartialRescaleFeasible( sourceDirtyRegion ) )
+	{
+		partialRescaleSucceeded = true;
+		for( const auto& rect : sourceDirtyRegion )
+		{
+			partialRescaleSucceeded &= FramebufferScaler::areaAveraged( source, scaledFramebuffer, rect );
+		}
+	}
+
+	QRegion scaledDirtyRegion;
+
+	if( partialRescaleSucceeded )
+	{
+		for( const auto& rect : sourceDirtyRegion )
+		{
+			scaledDirtyRegion += FramebufferScaler::mapToScaled( rect, source.size(), scaledSize );
+		}
+	}
+	else
+	{
+		scaledFramebuffer = FramebufferScaler::scaled(source, scaledSize, m_scalingMode);
+		if( scaledFramebuffer.constBits() == source.constBits() )
+		{
+			// scaling is a no-op for matching sizes and would return an image sharing the framebuffer
+			// memory which is written to by libvncclient and becomes invalid after a resize
+			scaledFramebuffer = source.copy();
+		}
+		m_scaledFramebufferSourceRect = sourceRect;
+		scaledDirtyRegion = QRect( QPoint( 0, 0 ), scaledSize );
+	}
+
+	// updates from blinking cursors or ticking clocks often are not visible at thumbnail scale
+	if( isImageAreaEqual( scaledFramebuffer, previousScaledFramebuffer, scaledDirtyRegion ) )
+	{
+		return;
+	}
+
+	QMutexLocker scaledFramebufferLocker( &m_scaledFramebufferMutex );
+	m_scaledFramebuffer = scaledFramebuffer;
+	m_scaledFramebufferChanged = true;
+}
+
+
+
+bool VncConnection::isImageAreaEqual( const QImage& image, const QImage& otherImage, const QRegion& region )
+{
+	if( image.size() != otherImage.size() || image.format() != otherImage.format() || image.isNull() )
+	{
+		return false;
+	}
+
+	const auto bytesPerPixel = image.depth() / 8;
+
+	for( const auto& rect : region )
+	{
+		const auto offset = rect.x() * bytesPerPixel;
+		const auto length = size_t(rect.width() * bytesPerPixel);
+
+		for( int y = rect.top(); y <= rect.bottom(); ++y )
+		{
+			// memcmp() is vectorized by all common C libraries
+			if( memcmp( image.constScanLine( y ) + offset, otherImage.constScanLine( y ) + offset, length ) != 0 )
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+
+
+bool VncConnection::isPartialRescaleFeasible( const QRegion& dirtyRegion ) const
+{
+	if( dirtyRegion.isEmpty() )
+	{
+		return true;
+	}
+
+	qint64 dirtyArea = 0;
+	for( const auto& rect : dirtyRegion )
+	{
+		dirtyArea += qint64(rect.width()) * rect.height();
+	}
+
+	return dirtyArea * 100 < qint64(m_image.width()) * m_image.height() * MaximumPartialRescaleAreaPercentage;
 }
 
 
@@ -353,7 +615,33 @@ qint64 VncConnection::libvncClientDispatcher( char* buffer, const qint64 bytes,
 
 void VncConnection::mouseEvent( int x, int y, uint buttonMask )
 {
-	enqueueEvent(new VncPointerEvent(x, y, buttonMask));
+	if( state() != State::Connected )
+	{
+		return;
+	}
+
+	// coalesce pointer movements which have not been sent yet - button state changes
+	// are never merged so presses and releases happen at their original position
+	m_eventQueueMutex.lock();
+	const auto isMotion = buttonMask == m_lastPointerButtonMask;
+	m_lastPointerButtonMask = buttonMask;
+	auto pendingPointerEvent = m_eventQueue.isEmpty() ? nullptr : dynamic_cast<VncPointerEvent *>( m_eventQueue.last() );
+	if( isMotion && pendingPointerEvent && pendingPointerEvent->isMotion() &&
+		pendingPointerEvent->buttonMask() == buttonMask )
+	{
+		pendingPointerEvent->setPosition( x, y );
+		m_eventQueueMutex.unlock();
+	}
+	else
+	{
+		m_eventQueueMutex.unlock();
+		enqueueEvent(new VncPointerEvent(x, y, buttonMask, isMotion));
+	}
+
+	if( m_lowLatency )
+	{
+		m_pendingInputTimestamp.testAndSetRelaxed( -1, m_latencyTimer.elapsed() );
+	}
 }
 
 
@@ -361,6 +649,11 @@ void VncConnection::mouseEvent( int x, int y, uint buttonMask )
 void VncConnection::keyEvent( unsigned int key, bool pressed )
 {
 	enqueueEvent(new VncKeyEvent(key, pressed));
+
+	if( m_lowLatency )
+	{
+		m_pendingInputTimestamp.testAndSetRelaxed( -1, m_latencyTimer.elapsed() );
+	}
 }
 
 
@@ -398,13 +691,27 @@ void VncConnection::establishConnection()
 
 	m_framebufferState = FramebufferState::Invalid;
 
+	// register after the Veyon protocol extension so ContinuousUpdates messages
+	// are handled first (libvncclient prepends new extensions to its list)
+	static const auto continuousUpdatesExtension = [] {
+		static std::array<int, 2> encodings{ RfbContinuousUpdates::PseudoEncoding, 0 };
+		auto extension = new rfbClientProtocolExtension{};
+		extension->encodings = encodings.data();
+		extension->handleMessage = RfbClientCallback::wrap<&VncConnection::handleServerMessage, FALSE>;
+		rfbClientRegisterExtension( extension );
+		return extension;
+	}();
+	Q_UNUSED(continuousUpdatesExtension)
+
+	m_continuousUpdatesState = ContinuousUpdatesState::Unsupported;
+
 	while( isControlFlagSet( ControlFlag::TerminateThread ) == false &&
 		   state() != State::Connected ) // try to connect as long as the server allows
 	{
 		m_client = rfbGetClient( RfbBitsPerSample, RfbSamplesPerPixel, RfbBytesPerPixel );
 		m_client->canHandleNewFBSize = true;
 		m_client->MallocFrameBuffer = RfbClientCallback::wrap<&VncConnection::initFrameBuffer>;
-		m_client->GotFrameBufferUpdate = RfbClientCallback::wrap<&VncConnection::imageUpdated>;
+		m_client->GotFrameBufferUpdate = RfbClientCallback::wrap<&VncConnection::updateImage>;
 		m_client->FinishedFrameBufferUpdate = RfbClientCallback::wrap<&VncConnection::finishFrameBufferUpdate>;
 		m_client->HandleCursorPos = RfbClientCallback::wrap<&VncConnection::updateCursorPosition>;
 		m_client->GotCursorShape = RfbClientCallback::wrap<&VncConnection::updateCursorShape>;
@@ -456,10 +763,16 @@ void VncConnection::establishConnection()
 		{
 			m_framebufferUpdateWatchdog.restart();
 
+			// new sessions always start unscaled
+			m_serverScale = 1;
+			m_unscaledFramebufferSize = {};
+
 			VeyonCore::platform().networkFunctions().
 					configureSocketKeepalive( static_cast<PlatformNetworkFunctions::Socket>( m_client->sock ), true,
 											  m_socketKeepaliveIdleTime, m_socketKeepaliveInterval, m_socketKeepaliveCount );
 
+			m_currentConnectionRetryInterval = m_connectionRetryInterval;
+
 			setState( State::Connected );
 		}
 		else
@@ -487,24 +800,39 @@ void VncConnection::establishConnection()
 				setState( State::ConnectionFailed );
 			}
 
-			// wait a bit until next connect
-			sleeperMutex.lock();
-			if( m_framebufferUpdateInterval > 0 )
-			{
-				m_updateIntervalSleeper.wait( &sleeperMutex, m_framebufferUpdateInterval );
-			}
-			else
-			{
-				// default: retry every second
-				m_updateIntervalSleeper.wait( &sleeperMutex, m_connectionRetryInterval );
-			}
-			sleeperMutex.unlock();
+			waitForConnectionRetry( &sleeperMutex );
 		}
 	}
 }
 
 
 
+void VncConnection::waitForConnectionRetry( QMutex* sleeperMutex )
+{
+	QMutexLocker locker( sleeperMutex );
+
+	if( state() == State::HostOffline )
+	{
+		// back off exponentially while the host is switched off
+		const int retryInterval = m_currentConnectionRetryInterval;
+		m_currentConnectionRetryInterval.testAndSetOrdered( retryInterval,
+															qMin( retryInterval * 2, qMax( m_connectionRetryInterval,
+																						   m_maximumConnectionRetryInterval ) ) );
+		m_updateIntervalSleeper.wait( sleeperMutex, qMax<int>( retryInterval, m_framebufferUpdateInterval ) );
+	}
+	else if( m_framebufferUpdateInterval > 0 )
+	{
+		m_updateIntervalSleeper.wait( sleeperMutex, m_framebufferUpdateInterval );
+	}
+	else
+	{
+		// default: retry every second
+		m_updateIntervalSleeper.wait( sleeperMutex, m_connectionRetryInterval );
+	}
+}
+
+
+
 void VncConnection::handleConnection()
 {
 	QMutex sleeperMutex;
@@ -527,9 +855,12 @@ void VncConnection::handleConnection()
 		{
 			// handle all available messages
 			bool handledOkay = true;
+			QElapsedTimer decodeTimer;
+			decodeTimer.start();
 			do {
 				handledOkay &= HandleRFBServerMessage( m_client );
 			} while( handledOkay && WaitForMessage( m_client, 0 ) );
+			m_decodeTime += decodeTimer.nsecsElapsed();
 
 			if( handledOkay == false )
 			{
@@ -539,7 +870,8 @@ void VncConnection::handleConnection()
 		else if (m_framebufferUpdateWatchdog.elapsed() >=
 				 qMax<qint64>(2*m_framebufferUpdateInterval, m_framebufferUpdateWatchdogTimeout))
 		{
-			SendFramebufferUpdateRequest(m_client, 0, 0, m_client->width, m_client->height, false);
+			SendFramebufferUpdateRequest(m_client, m_client->updateRect.x, m_client->updateRect.y,
+										 m_client->updateRect.w, m_client->updateRect.h, false);
 			m_framebufferUpdateWatchdog.restart();
 		}
 		else if (m_framebufferUpdateInterval > 0 && m_framebufferUpdateWatchdog.elapsed() > m_framebufferUpdateInterval)
@@ -553,6 +885,28 @@ void VncConnection::handleConnection()
 			SendIncrementalFramebufferUpdateRequest(m_client);
 		}
 
+		if( isControlFlagSet( ControlFlag::FramebufferUpdateRegionChanged ) &&
+			m_framebufferState != FramebufferState::Invalid )
+		{
+			updateFramebufferUpdateRegion();
+
+			// contents of newly covered areas are unknown
+			SendFramebufferUpdateRequest( m_client, m_client->updateRect.x, m_client->updateRect.y,
+										  m_client->updateRect.w, m_client->updateRect.h, false );
+		}
+
+		if( isControlFlagSet( ControlFlag::PixelFormatChanged ) &&
+			m_framebufferState != FramebufferState::Invalid )
+		{
+			updatePixelFormat();
+			updateEncodingSettingsFromQuality();
+			SetFormatAndEncodings( m_client );
+
+			// transfer all pixels again in the new format
+			SendFramebufferUpdateRequest( m_client, m_client->updateRect.x, m_client->updateRect.y,
+										  m_client->updateRect.w, m_client->updateRect.h, false );
+		}
+
 		const auto remainingUpdateInterval = m_framebufferUpdateInterval - loopTimer.elapsed();
 
 		// compat with Veyon Server < 4.7
@@ -565,6 +919,19 @@ void VncConnection::handleConnection()
 			sleeperMutex.unlock();
 		}
 
+		if( m_framebufferState == FramebufferState::Valid )
+		{
+			updateServerScale();
+			updateContinuousUpdates();
+
+			// apply changes of scaled size or update region without waiting for the next update
+			rescaleFramebuffer();
+			if( m_scaledFramebufferChanged.exchange( false ) )
+			{
+				Q_EMIT scaledFramebufferUpdated();
+			}
+		}
+
 		sendEvents();
 	}
 }
@@ -626,6 +993,9 @@ rfbBool VncConnection::initFrameBuffer( rfbClient* client )
 
 	const auto pixelCount = uint32_t(client->width) * uint32_t(client->height);
 
+	// the server may change its resolution at any time, also while scaling on the server side is active
+	m_unscaledFramebufferSize = QSize( client->width * m_serverScale, client->height * m_serverScale );
+
 	client->frameBuffer = reinterpret_cast<uint8_t *>( new RfbPixel[pixelCount] );
 
 	memset( client->frameBuffer, '\0', pixelCount*RfbBytesPerPixel );
@@ -636,19 +1006,16 @@ rfbBool VncConnection::initFrameBuffer( rfbClient* client )
 	m_image = QImage( client->frameBuffer, client->width, client->height, QImage::Format_RGB32, framebufferCleanup, client->frameBuffer );
 	m_imgLock.unlock();
 
-	// set up pixel format according to QImage
-	client->format.redShift = 16;
-	client->format.greenShift = 8;
-	client->format.blueShift = 0;
-	client->format.redMax = 0xff;
-	client->format.greenMax = 0xff;
-	client->format.blueMax = 0xff;
+	updatePixelFormat();
 
 	client->appData.useRemoteCursor = m_useRemoteCursor ? TRUE : FALSE;
 	client->appData.useBGR233 = false;
 
 	updateEncodingSettingsFromQuality();
 
+	// libvncclient resets the update region on framebuffer size changes
+	updateFramebufferUpdateRegion();
+
 	m_framebufferState = FramebufferState::Initialized;
 
 	Q_EMIT framebufferSizeChanged( client->width, client->height );
@@ -658,39 +1025,187 @@ rfbBool VncConnection::initFrameBuffer( rfbClient* client )
 
 
 
+void VncConnection::updateImage(int x, int y, int w, int h)
+{
+	m_dirtyRegionMutex.lock();
+	m_dirtyRegion += QRect(x, y, w, h);
+	if (m_dirtyRegion.rectCount() > MaximumDirtyRectCount)
+	{
+		m_dirtyRegion = m_dirtyRegion.boundingRect();
+	}
+	m_dirtyRegionMutex.unlock();
+
+	Q_EMIT imageUpdated(x, y, w, h);
+}
+
+
+
 void VncConnection::finishFrameBufferUpdate()
 {
 	m_framebufferUpdateWatchdog.restart();
+	++m_framebufferUpdateCount;
+
+	if( m_framebufferState != FramebufferState::Valid )
+	{
+		Tracer::milestone( "VncConnection::firstFramebufferUpdate", m_host );
+	}
 
 	m_framebufferState = FramebufferState::Valid;
 	setControlFlag( ControlFlag::ScaledFramebufferNeedsUpdate, true );
 
+	// rescale on this thread so that views only pick up finished images
+	rescaleFramebuffer();
+
+	if( m_lowLatency && m_continuousUpdatesState != ContinuousUpdatesState::Enabled )
+	{
+		// libvncclient only requests the next update after having processed
+		// the current one - keep one more request in flight so the server can
+		// send changes right away instead of waiting for a full round trip
+		SendIncrementalFramebufferUpdateRequest( m_client );
+
+		const auto inputTimestamp = m_pendingInputTimestamp.fetchAndStoreRelaxed( -1 );
+		if( inputTimestamp >= 0 )
+		{
+			const auto latency = m_latencyTimer.elapsed() - inputTimestamp;
+			m_inputLatency = int(latency);
+			Metrics::observe( "veyon_remote_access_input_latency_seconds", double(latency) / 1000 );
+		}
+	}
+
 	Q_EMIT framebufferUpdateComplete();
+
+	m_globalMutex.lock();
+	const auto hasScaledSize = m_scaledSize.isNull() == false;
+	m_globalMutex.unlock();
+
+	if( m_scaledFramebufferChanged.exchange( false ) || hasScaledSize == false )
+	{
+		Q_EMIT scaledFramebufferUpdated();
+	}
+}
+
+
+
+void VncConnection::updatePixelFormat()
+{
+	setControlFlag( ControlFlag::PixelFormatChanged, false );
+
+	// set up pixel format according to QImage
+	if( m_allowReducedColors && m_reducedColors )
+	{
+		// place the reduced samples in the most significant bits of each channel
+		// so that the framebuffer can still be used as RGB32 image without conversion
+		m_client->format.depth = 8;
+		m_client->format.redShift = 21;
+		m_client->format.greenShift = 13;
+		m_client->format.blueShift = 6;
+		m_client->format.redMax = 0x07;
+		m_client->format.greenMax = 0x07;
+		m_client->format.blueMax = 0x03;
+	}
+	else
+	{
+		m_client->format.depth = RfbBitsPerSample * RfbSamplesPerPixel;
+		m_client->format.redShift = 16;
+		m_client->format.greenShift = 8;
+		m_client->format.blueShift = 0;
+		m_client->format.redMax = 0xff;
+		m_client->format.greenMax = 0xff;
+		m_client->format.blueMax = 0xff;
+	}
 }
 
 
 
 void VncConnection::updateEncodingSettingsFromQuality()
 {
-	m_client->appData.encodingsString = m_quality == VncConnectionConfiguration::Quality::Highest ?
-											"zrle ultra copyrect hextile zlib corre rre raw" :
-											"tight zywrle zrle ultra";
+	if( m_lowLatency )
+	{
+		// favor encoding speed and small updates over image quality
+		m_client->appData.encodingsString = "copyrect tight zrle ultra hextile raw";
+		m_client->appData.compressLevel = 1;
+		m_client->appData.qualityLevel = m_quality == VncConnectionConfiguration::Quality::Lowest ? 0 : 4;
+		m_client->appData.enableJPEG = true;
+	}
+	else
+	{
+		m_client->appData.encodingsString = m_quality == VncConnectionConfiguration::Quality::Highest ?
+												"zrle ultra copyrect hextile zlib corre rre raw" :
+												"tight zywrle zrle ultra copyrect";
+
+		m_client->appData.compressLevel = 9;
+
+		m_client->appData.qualityLevel = [this] {
+			switch(m_quality)
+			{
+			case VncConnectionConfiguration::Quality::Highest: return 9;
+			case VncConnectionConfiguration::Quality::High: return 7;
+			case VncConnectionConfiguration::Quality::Medium: return 5;
+			case VncConnectionConfiguration::Quality::Low: return 3;
+			case VncConnectionConfiguration::Quality::Lowest: return 0;
+			}
+			return 5;
+		}();
 
-	m_client->appData.compressLevel = 9;
+		m_client->appData.enableJPEG = m_quality != VncConnectionConfiguration::Quality::Highest;
+	}
 
-	m_client->appData.qualityLevel = [this] {
-		switch(m_quality)
+	if( m_allowReducedColors )
+	{
+		// updates still in flight while switching the pixel format are decoded properly only
+		// with encodings which transfer all 32 bits of each pixel regardless of the depth
+		if( m_reducedColors )
 		{
-		case VncConnectionConfiguration::Quality::Highest: return 9;
-		case VncConnectionConfiguration::Quality::High: return 7;
-		case VncConnectionConfiguration::Quality::Medium: return 5;
-		case VncConnectionConfiguration::Quality::Low: return 3;
-		case VncConnectionConfiguration::Quality::Lowest: return 0;
+			m_client->appData.encodingsString = "zrle ultra copyrect hextile raw";
 		}
-		return 5;
-	}();
+		else if( m_lowLatency )
+		{
+			m_client->appData.encodingsString = "copyrect zrle ultra hextile raw";
+		}
+		else if( m_quality != VncConnectionConfiguration::Quality::Highest )
+		{
+			m_client->appData.encodingsString = "zywrle zrle ultra copyrect";
+		}
+		m_client->appData.enableJPEG = false;
+	}
 
-	m_client->appData.enableJPEG = m_quality != VncConnectionConfiguration::Quality::Highest;
+	m_encodings = m_client->appData.encodingsString;
+}
+
+
+
+void VncConnection::updateServerScale()
+{
+	auto scale = 1;
+
+	if( m_serverSideScaling && m_unscaledFramebufferSize.isEmpty() == false )
+	{
+		m_globalMutex.lock();
+		const auto scaledSize = m_scaledSize;
+		m_globalMutex.unlock();
+
+		if( scaledSize.isEmpty() == false )
+		{
+			// never let the server scale below the size of the thumbnail
+			scale = qBound( 1, qMin( m_unscaledFramebufferSize.width() / scaledSize.width(),
+									 m_unscaledFramebufferSize.height() / scaledSize.height() ),
+							int(MaximumServerScale) );
+		}
+	}
+
+	if( scale == m_serverScale || SupportsClient2Server( m_client, rfbSetScale ) == false )
+	{
+		return;
+	}
+
+	rfbSetScaleMsg message{};
+	message.type = rfbSetScale;
+	message.scale = uint8_t(scale);
+
+	if( WriteToRFBServer( m_client, reinterpret_cast<char *>( &message ), sz_rfbSetScaleMsg ) )
+	{
+		m_serverScale = scale;
+	}
 }
 
 
@@ -711,13 +1226,43 @@ void VncConnection::updateCursorShape( rfbClient* client, int xh, int yh, int w,
 		return;
 	}
 
-	QImage alpha( client->rcMask, w, h, QImage::Format_Indexed8 );
-	alpha.setColorTable( { qRgb(255,255,255), qRgb(0,0,0) } );
+	const auto pixelCount = size_t(w) * size_t(h);
+	const auto key = ( quint64( qHashBits( client->rcSource, pixelCount * 4, uint(w) << 16 | uint(h) ) ) << 32 ) |
+					 quint64( qHashBits( client->rcMask, pixelCount ) );
 
-	QPixmap cursorShape( QPixmap::fromImage( QImage( client->rcSource, w, h, QImage::Format_RGB32 ) ) );
-	cursorShape.setMask( QBitmap::fromImage( alpha ) );
+	// servers resend the current shape e.g. when the pointer enters another window
+	if( key == m_cursorShapeKey && m_cursorHotSpot == QPoint( xh, yh ) )
+	{
+		return;
+	}
 
-	Q_EMIT cursorShapeUpdated( cursorShape, xh, yh );
+	m_cursorShapeKey = key;
+	m_cursorHotSpot = QPoint( xh, yh );
+
+	auto cursorShape = m_cursorShapeCache.object( key );
+	if( cursorShape == nullptr )
+	{
+		cursorShape = new QImage( QImage( client->rcSource, w, h, QImage::Format_RGB32 ).convertToFormat( QImage::Format_ARGB32 ) );
+
+		const auto mask = client->rcMask;
+		for( int y = 0; y < h; ++y )
+		{
+			auto line = reinterpret_cast<QRgb *>( cursorShape->scanLine( y ) );
+			for( int x = 0; x < w; ++x )
+			{
+				if( mask[y*w+x] == 0 )
+				{
+					line[x] = 0;
+				}
+			}
+		}
+
+		m_cursorShapeCache.insert( key, cursorShape );
+	}
+
+	// QImage (unlike QPixmap) can be created outside the GUI thread and is shared
+	// implicitly so views can cache their scaled cursors by cacheKey()
+	Q_EMIT cursorShapeUpdated( *cursorShape, xh, yh );
 }
 
 
@@ -734,8 +1279,117 @@ void VncConnection::updateClipboard( const char* text, int textlen )
 
 
 
+rfbBool VncConnection::handleServerMessage( rfbServerToClientMsg* message )
+{
+	if( message->type != RfbContinuousUpdates::EndMessageType )
+	{
+		return FALSE;
+	}
+
+	if( m_continuousUpdatesState == ContinuousUpdatesState::Unsupported )
+	{
+		// initial message in response to announcing the pseudo encoding
+		m_continuousUpdatesState = ContinuousUpdatesState::Disabled;
+	}
+	else if( m_continuousUpdatesState != ContinuousUpdatesState::Disabled )
+	{
+		// server stopped sending updates on its own so resume requesting them
+		m_continuousUpdatesState = ContinuousUpdatesState::Disabled;
+		SendIncrementalFramebufferUpdateRequest( m_client );
+	}
+
+	return TRUE;
+}
+
+
+
+void VncConnection::updateContinuousUpdates()
+{
+	if( m_continuousUpdatesState == ContinuousUpdatesState::Unsupported ||
+		m_continuousUpdatesState == ContinuousUpdatesState::Disabling )
+	{
+		return;
+	}
+
+	// continuous updates only make sense when not limiting the update rate
+	const auto enable = m_framebufferUpdateInterval <= 0 &&
+						isControlFlagSet( ControlFlag::RequiresManualUpdateRateControl ) == false;
+
+	if( enable == ( m_continuousUpdatesState == ContinuousUpdatesState::Enabled ) )
+	{
+		return;
+	}
+
+	RfbContinuousUpdates::EnableMessage message{};
+	message.type = RfbContinuousUpdates::EnableMessageType;
+	message.enable = enable ? 1 : 0;
+	message.x = qToBigEndian<uint16_t>( m_client->updateRect.x );
+	message.y = qToBigEndian<uint16_t>( m_client->updateRect.y );
+	message.w = qToBigEndian<uint16_t>( m_client->updateRect.w );
+	message.h = qToBigEndian<uint16_t>( m_client->updateRect.h );
+
+	if( WriteToRFBServer( m_client, reinterpret_cast<const char *>( &message ), RfbContinuousUpdates::EnableMessageSize ) )
+	{
+		// when disabling wait for the server to confirm with an EndOfContinuousUpdates message
+		m_continuousUpdatesState = enable ? ContinuousUpdatesState::Enabled : ContinuousUpdatesState::Disabling;
+	}
+}
+
+
+
+QRect VncConnection::framebufferUpdateRect()
+{
+	m_globalMutex.lock();
+	const auto region = m_framebufferUpdateRegion;
+	m_globalMutex.unlock();
+
+	const auto framebufferRect = m_image.rect();
+	const auto updateRect = region.intersected( framebufferRect );
+	if( updateRect.isEmpty() || m_serverScale != 1 )
+	{
+		return framebufferRect;
+	}
+
+	return updateRect;
+}
+
+
+
+void VncConnection::updateFramebufferUpdateRegion()
+{
+	setControlFlag( ControlFlag::FramebufferUpdateRegionChanged, false );
+
+	m_globalMutex.lock();
+	const auto region = m_framebufferUpdateRegion;
+	m_globalMutex.unlock();
+
+	// libvncclient uses updateRect for all incremental update requests
+	const QRect framebufferRect( 0, 0, m_client->width, m_client->height );
+	auto updateRect = region.intersected( framebufferRect );
+	if( updateRect.isEmpty() || m_serverScale != 1 )
+	{
+		updateRect = framebufferRect;
+	}
+
+	m_client->updateRect.x = updateRect.x();
+	m_client->updateRect.y = updateRect.y();
+	m_client->updateRect.w = updateRect.width();
+	m_client->updateRect.h = updateRect.height();
+
+	if( m_continuousUpdatesState == ContinuousUpdatesState::Enabled )
+	{
+		// make updateContinuousUpdates() send a new enable message for the changed area
+		m_continuousUpdatesState = ContinuousUpdatesState::Disabled;
+	}
+}
+
+
+
 void VncConnection::sendEvents()
 {
+	QBuffer eventBatch;
+	eventBatch.open( QBuffer::WriteOnly );
+
 	m_eventQueueMutex.lock();
 
 	while( m_eventQueue.isEmpty() == false )
@@ -747,7 +1401,20 @@ void VncConnection::sendEvents()
 
 		if( isControlFlagSet( ControlFlag::TerminateThread ) == false )
 		{
-			event->fire( m_client );
+			// collect consecutive input events and feature messages and send them with a single write
+			if( event->serialize( m_client, &eventBatch ) )
+			{
+				if( eventBatch.size() >= MaximumEventBatchSize )
+				{
+					sendEventBatch( eventBatch );
+				}
+			}
+			else
+			{
+				// keep order of events
+				sendEventBatch( eventBatch );
+				event->fire( m_client );
+			}
 		}
 
 		delete event;
@@ -757,6 +1424,22 @@ void VncConnection::sendEvents()
 	}
 
 	m_eventQueueMutex.unlock();
+
+	sendEventBatch( eventBatch );
+}
+
+
+
+void VncConnection::sendEventBatch( QBuffer& batch )
+{
+	if( batch.size() > 0 )
+	{
+		SocketDevice socketDevice( libvncClientDispatcher, m_client );
+		socketDevice.write( batch.data().constData(), batch.size() );
+
+		batch.buffer().clear();
+		batch.seek( 0 );
+	}
 }
 
 
@@ -816,7 +1499,33 @@ rfbSocket VncConnection::openTlsSocket( const char* hostname, int port )
 
 	m_sslSocket->setPeerVerifyMode( m_verifyServerCertificate ? QSslSocket::VerifyPeer : QSslSocket::QueryPeer );
 
-	m_sslSocket->connectToHostEncrypted( QString::fromUtf8(hostname), port );
+	m_sslSocket->connectToHost( QString::fromUtf8(hostname), port );
+	if( m_sslSocket->waitForConnected() == false )
+	{
+		delete m_sslSocket;
+		m_sslSocket = nullptr;
+		return RFB_INVALID_SOCKET;
+	}
+
+	if( VeyonCore::isTransportEncryptionRequired( m_sslSocket->peerAddress() ) == false )
+	{
+		// tell the server explicitly instead of relying on it to make the same decision
+		vDebug() << "requesting unencrypted connection to" << m_sslSocket->peerAddress();
+		const char transportRequest = VeyonCore::PlainTransportRequest;
+		if( m_sslSocket->write( &transportRequest, sizeof(transportRequest) ) != sizeof(transportRequest) ||
+			m_sslSocket->waitForBytesWritten() == false )
+		{
+			delete m_sslSocket;
+			m_sslSocket = nullptr;
+			return RFB_INVALID_SOCKET;
+		}
+
+		return m_sslSocket->socketDescriptor();
+	}
+
+	// always perform a full handshake - TLS sessions can't be resumed as each server-side
+	// QSslSocket uses its own OpenSSL context with own ticket keys
+	m_sslSocket->startClientEncryption();
 	if( m_sslSocket->waitForEncrypted() == false || m_sslSocket->socketDescriptor() < 0 )
 	{
 		delete m_sslSocket;
@@ -845,7 +1554,13 @@ int VncConnection::readFromTlsSocket( char* buffer, unsigned int len )
 		}
 	}
 
-	return m_sslSocket->read( buffer, len );
+	const auto ret = m_sslSocket->read( buffer, len );
+	if( ret > 0 )
+	{
+		m_receivedBytes += ret;
+	}
+
+	return int(ret);
 }
 
 
@@ -29,11 +29,13 @@
 
 #include <rfb/rfbproto.h>
 
+#include <QCache>
 #include <QElapsedTimer>
 #include <QImage>
 #include <QMutex>
 #include <QQueue>
 #include <QReadWriteLock>
+#include <QRegion>
 #include <QThread>
 #include <QTimer>
 #include <QWaitCondition>
@@ -44,6 +46,7 @@
 
 using rfbClient = struct _rfbClient;
 
+class QBuffer;
 class QSslSocket;
 class VncEvent;
 
@@ -101,12 +104,65 @@ public:
 
 	void setQuality(VncConnectionConfiguration::Quality quality);
 
+	void setScalingMode(VncConnectionConfiguration::ScalingMode scalingMode);
+
+	// let the server downscale the framebuffer to roughly the scaled size if supported
+	void setServerSideScaling( bool enabled )
+	{
+		m_serverSideScaling = enabled;
+	}
+
+	// factor by which the server currently downscales the framebuffer
+	int serverScale() const
+	{
+		return m_serverScale;
+	}
+
+	// allow switching to a pixel format with 3 bits for red and green and 2 bits for blue
+	// at runtime - has to be set before starting the connection as it rules out Tight
+	// encoding whose wire format depends on the pixel format
+	void setAllowReducedColors( bool allowed )
+	{
+		m_allowReducedColors = allowed;
+	}
+
+	void setReducedColors( bool enabled );
+
 	void setUseRemoteCursor( bool enabled );
 
+	// keep an additional update request outstanding and prefer fast encodings
+	// in order to minimize the delay between input events and screen updates
+	void setLowLatency( bool enabled );
+
+	// time between the first input event and the next completed framebuffer
+	// update in milliseconds or -1 if not measured in low latency mode yet
+	int inputLatency() const
+	{
+		return m_inputLatency;
+	}
+
+	struct Statistics
+	{
+		qreal framesPerSecond{0};
+		qreal bytesPerSecond{0};
+		qreal averageDecodeTime{0};
+		int inputLatency{-1};
+		int queuedEvents{0};
+		QString encodings{};
+	};
+
+	// returns the rates measured since the previous call
+	Statistics statistics();
+
 	void setServerReachable();
 
-	void enqueueEvent(VncEvent* event);
+	// retry connecting to offline hosts immediately and with the initial
+	// retry interval again, e.g. after sending a Wake-on-LAN packet
+	void resetConnectionRetryInterval();
+
+	bool enqueueEvent(VncEvent* event);
 	bool isEventQueueEmpty();
+	int eventQueueSize();
 
 	/** \brief Returns whether framebuffer data is valid, i.e. at least one full FB update received */
 	bool hasValidFramebuffer() const
@@ -120,6 +176,10 @@ public:
 
 	void setFramebufferUpdateInterval( int interval );
 
+	// restricts framebuffer update requests to given area (e.g. the viewport of a demo),
+	// an empty rect requests updates of the whole framebuffer
+	void setFramebufferUpdateRegion( QRect region );
+
 	void setSkipHostPing( bool on )
 	{
 		setControlFlag( ControlFlag::SkipHostPing, on );
@@ -130,8 +190,6 @@ public:
 		setControlFlag(ControlFlag::RequiresManualUpdateRateControl, on);
 	}
 
-	void rescaleFramebuffer();
-
 	static constexpr int VncConnectionTag = 0x590123;
 
 	static void* clientData( rfbClient* client, int tag );
@@ -148,9 +206,10 @@ Q_SIGNALS:
 	void connectionPrepared();
 	void imageUpdated( int x, int y, int w, int h );
 	void framebufferUpdateComplete();
+	void scaledFramebufferUpdated();
 	void framebufferSizeChanged( int w, int h );
 	void cursorPosChanged( int x, int y );
-	void cursorShapeUpdated( const QPixmap& cursorShape, int xh, int yh );
+	void cursorShapeUpdated( const QImage& cursorShape, int xh, int yh );
 	void gotCut( const QString& text );
 	void stateChanged();
 
@@ -164,6 +223,21 @@ private:
 	static constexpr int RfbSamplesPerPixel = 3;
 	static constexpr int RfbBytesPerPixel = sizeof(RfbPixel);
 
+	// rescale whole framebuffer if dirty region exceeds given percentage or number of rectangles
+	static constexpr int MaximumPartialRescaleAreaPercentage = 50;
+	static constexpr int MaximumDirtyRectCount = 64;
+
+	static constexpr int MaximumServerScale = 8;
+	static constexpr int MaximumEventBatchSize = 64*1024;
+	static constexpr int CursorShapeCacheSize = 16;
+
+	enum class ContinuousUpdatesState {
+		Unsupported,
+		Disabled,
+		Enabled,
+		Disabling
+	};
+
 	enum class ControlFlag {
 		ScaledFramebufferNeedsUpdate = 0x01,
 		ServerReachable = 0x02,
@@ -172,7 +246,9 @@ private:
 		DeleteAfterFinished = 0x10,
 		SkipHostPing = 0x20,
 		RequiresManualUpdateRateControl = 0x40,
-		TriggerFramebufferUpdate = 0x80
+		TriggerFramebufferUpdate = 0x80,
+		FramebufferUpdateRegionChanged = 0x100,
+		PixelFormatChanged = 0x200
 	};
 
 	~VncConnection() override;
@@ -183,19 +259,35 @@ private:
 
 	void setState( State state );
 
+	void waitForConnectionRetry( QMutex* sleeperMutex );
+
 	void setControlFlag( ControlFlag flag, bool on );
 	bool isControlFlagSet( ControlFlag flag );
 
 	rfbBool initFrameBuffer( rfbClient* client );
+	void updateImage(int x, int y, int w, int h);
 	void finishFrameBufferUpdate();
 
+	void updatePixelFormat();
 	void updateEncodingSettingsFromQuality();
+	void updateServerScale();
+
+	// must only be called from the connection thread
+	void rescaleFramebuffer();
+	bool isPartialRescaleFeasible( const QRegion& dirtyRegion ) const;
+	QRect framebufferUpdateRect();
+	static bool isImageAreaEqual( const QImage& image, const QImage& otherImage, const QRegion& region );
 
 	rfbBool updateCursorPosition( int x, int y );
 	void updateCursorShape( rfbClient* client, int xh, int yh, int w, int h, int bpp );
 	void updateClipboard( const char *text, int textlen );
+	rfbBool handleServerMessage( rfbServerToClientMsg* message );
+
+	void updateContinuousUpdates();
+	void updateFramebufferUpdateRegion();
 
 	void sendEvents();
+	void sendEventBatch( QBuffer& batch );
 
 	void deleteLaterInMainThread();
 
@@ -213,12 +305,14 @@ private:
 	int m_connectTimeout{VncConnectionConfiguration::DefaultConnectTimeout};
 	int m_readTimeout{VncConnectionConfiguration::DefaultReadTimeout};
 	int m_connectionRetryInterval{VncConnectionConfiguration::DefaultConnectionRetryInterval};
+	int m_maximumConnectionRetryInterval{VncConnectionConfiguration::DefaultMaximumConnectionRetryInterval};
 	int m_messageWaitTimeout{VncConnectionConfiguration::DefaultMessageWaitTimeout};
 	int m_fastFramebufferUpdateInterval{VncConnectionConfiguration::DefaultFastFramebufferUpdateInterval};
 	int m_framebufferUpdateWatchdogTimeout{VncConnectionConfiguration::DefaultFramebufferUpdateWatchdogTimeout};
 	int m_socketKeepaliveIdleTime{VncConnectionConfiguration::DefaultSocketKeepaliveIdleTime};
 	int m_socketKeepaliveInterval{VncConnectionConfiguration::DefaultSocketKeepaliveInterval};
 	int m_socketKeepaliveCount{VncConnectionConfiguration::DefaultSocketKeepaliveCount};
+	int m_threadStackSize{VncConnectionConfiguration::DefaultThreadStackSize};
 
 	// states and flags
 	std::atomic<State> m_state{State::Disconnected};
@@ -235,21 +329,53 @@ private:
 	int m_port{-1};
 	int m_defaultPort{-1};
 	bool m_useRemoteCursor{false};
+	std::atomic<bool> m_lowLatency{false};
+	bool m_allowReducedColors{false};
+	std::atomic<bool> m_reducedColors{false};
+	ContinuousUpdatesState m_continuousUpdatesState{ContinuousUpdatesState::Unsupported};
+	std::atomic<bool> m_serverSideScaling{false};
+	std::atomic<int> m_serverScale{1};
+	QSize m_unscaledFramebufferSize{};
+	QRect m_framebufferUpdateRegion{};
 
 	// thread and timing control
 	QMutex m_globalMutex{};
 	QMutex m_eventQueueMutex{};
 	QWaitCondition m_updateIntervalSleeper{};
 	QAtomicInt m_framebufferUpdateInterval{0};
+	QAtomicInt m_currentConnectionRetryInterval{0};
 	QElapsedTimer m_framebufferUpdateWatchdog{};
+	QElapsedTimer m_latencyTimer{};
+	QAtomicInteger<qint64> m_pendingInputTimestamp{-1};
+	QAtomicInt m_inputLatency{-1};
+
+	// counters for statistics()
+	QAtomicInt m_framebufferUpdateCount{0};
+	QAtomicInteger<qint64> m_receivedBytes{0};
+	QAtomicInteger<qint64> m_decodeTime{0};
+	std::atomic<const char*> m_encodings{nullptr};
+	QElapsedTimer m_statisticsTimer{};
+	QMutex m_statisticsMutex{};
 
 	// queue for RFB and custom events
 	QQueue<VncEvent *> m_eventQueue{};
+	uint m_lastPointerButtonMask{0};
 
 	// framebuffer data and thread synchronization objects
 	QImage m_image{};
 	QImage m_scaledFramebuffer{};
+	QMutex m_scaledFramebufferMutex{};
 	QSize m_scaledSize{};
+	QRect m_scaledFramebufferSourceRect{};
+	std::atomic<bool> m_scaledFramebufferChanged{false};
+	VncConnectionConfiguration::ScalingMode m_scalingMode{VncConnectionConfiguration::ScalingMode::AreaAveraging};
+	QRegion m_dirtyRegion{};
+	QMutex m_dirtyRegionMutex{};
 	QReadWriteLock m_imgLock{};
 
+	// the pointer usually switches between a few shapes only (arrow, I-beam, hand etc.)
+	QCache<quint64, QImage> m_cursorShapeCache{CursorShapeCacheSize};
+	quint64 m_cursorShapeKey{0};
+	QPoint m_cursorHotSpot{};
+
 } ;
@@ -40,11 +40,20 @@ public:
 	};
 	Q_ENUM(Quality)
 
+	enum class ScalingMode
+	{
+		Fast,
+		AreaAveraging,
+		Smooth
+	};
+	Q_ENUM(ScalingMode)
+
 	// intervals and timeouts
 	static constexpr int DefaultThreadTerminationTimeout = 30000;
 	static constexpr int DefaultConnectTimeout = 10000;
 	static constexpr int DefaultReadTimeout = 30000;
 	static constexpr int DefaultConnectionRetryInterval = 1000;
+	static constexpr int DefaultMaximumConnectionRetryInterval = 60000;
 	static constexpr int DefaultMessageWaitTimeout = 500;
 	static constexpr int DefaultFastFramebufferUpdateInterval = 100;
 	static constexpr int DefaultFramebufferUpdateWatchdogTimeout = 10000;
@@ -52,4 +61,7 @@ public:
 	static constexpr int DefaultSocketKeepaliveInterval = 500;
 	static constexpr int DefaultSocketKeepaliveCount = 5;
 
+	// threads and resources (a stack size of 0 selects the platform default)
+	static constexpr int DefaultThreadStackSize = 1024*1024;
+
 } ;
@@ -24,6 +24,9 @@
 
 #include <rfb/rfbclient.h>
 
+#include <QIODevice>
+#include <QtEndian>
+
 #include "VncEvents.h"
 
 
@@ -41,10 +44,29 @@ void VncKeyEvent::fire( rfbClient* client )
 
 
 
-VncPointerEvent::VncPointerEvent(int x, int y, uint buttonMask) :
+bool VncKeyEvent::serialize( rfbClient* client, QIODevice* ioDevice ) const
+{
+	// same as SendKeyEvent()
+	if( SupportsClient2Server( client, rfbKeyEvent ) )
+	{
+		rfbKeyEventMsg message{};
+		message.type = rfbKeyEvent;
+		message.down = m_pressed ? 1 : 0;
+		message.key = qToBigEndian<uint32_t>( m_key );
+
+		ioDevice->write( reinterpret_cast<const char *>( &message ), sz_rfbKeyEventMsg );
+	}
+
+	return true;
+}
+
+
+
+VncPointerEvent::VncPointerEvent(int x, int y, uint buttonMask, bool isMotion) :
 	m_x( x ),
 	m_y( y ),
-	m_buttonMask( buttonMask )
+	m_buttonMask( buttonMask ),
+	m_isMotion( isMotion )
 {
 }
 
@@ -57,6 +79,25 @@ void VncPointerEvent::fire(rfbClient *client)
 
 
 
+bool VncPointerEvent::serialize( rfbClient* client, QIODevice* ioDevice ) const
+{
+	// same as SendPointerEvent()
+	if( SupportsClient2Server( client, rfbPointerEvent ) )
+	{
+		rfbPointerEventMsg message{};
+		message.type = rfbPointerEvent;
+		message.buttonMask = uint8_t(m_buttonMask);
+		message.x = qToBigEndian<uint16_t>( uint16_t(qMax( 0, m_x )) );
+		message.y = qToBigEndian<uint16_t>( uint16_t(qMax( 0, m_y )) );
+
+		ioDevice->write( reinterpret_cast<const char *>( &message ), sz_rfbPointerEventMsg );
+	}
+
+	return true;
+}
+
+
+
 VncClientCutEvent::VncClientCutEvent( const QString& text ) :
 	m_text( text.toUtf8() )
 {
@@ -26,6 +26,8 @@
 
 #include <QString>
 
+class QIODevice;
+
 using rfbClient = struct _rfbClient;
 
 // clazy:excludeall=copyable-polymorphic
@@ -36,6 +38,15 @@ public:
 	virtual ~VncEvent() = default;
 	virtual void fire( rfbClient* client ) = 0;
 
+	// writes the event to ioDevice so it can be sent along with other events in a
+	// single write, returns false if the event can only be sent through fire()
+	virtual bool serialize( rfbClient* client, QIODevice* ioDevice ) const
+	{
+		Q_UNUSED(client)
+		Q_UNUSED(ioDevice)
+		return false;
+	}
+
 } ;
 
 
@@ -45,6 +56,7 @@ public:
 	VncKeyEvent( unsigned int key, bool pressed );
 
 	void fire( rfbClient* client ) override;
+	bool serialize( rfbClient* client, QIODevice* ioDevice ) const override;
 
 private:
 	unsigned int m_key;
@@ -55,14 +67,33 @@ private:
 class VncPointerEvent : public VncEvent
 {
 public:
-	VncPointerEvent( int x, int y, uint buttonMask );
+	VncPointerEvent( int x, int y, uint buttonMask, bool isMotion = false );
+
+	uint buttonMask() const
+	{
+		return m_buttonMask;
+	}
+
+	// whether the button state did not change compared to the previous pointer event
+	bool isMotion() const
+	{
+		return m_isMotion;
+	}
+
+	void setPosition( int x, int y )
+	{
+		m_x = x;
+		m_y = y;
+	}
 
 	void fire( rfbClient* client ) override;
+	bool serialize( rfbClient* client, QIODevice* ioDevice ) const override;
 
 private:
 	int m_x;
 	int m_y;
 	uint m_buttonMask;
+	bool m_isMotion;
 } ;
 
 
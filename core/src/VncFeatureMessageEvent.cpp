@@ -29,21 +29,40 @@
 #include "VncFeatureMessageEvent.h"
 
 
-VncFeatureMessageEvent::VncFeatureMessageEvent( const FeatureMessage& featureMessage ) :
-	m_featureMessage( featureMessage )
+VncFeatureMessageEvent::VncFeatureMessageEvent( const FeatureMessage& featureMessage,
+												const QByteArray& serializedMessage ) :
+	m_featureMessage( featureMessage ),
+	m_serializedMessage( serializedMessage )
 {
 }
 
 
 
 void VncFeatureMessageEvent::fire( rfbClient* client )
+{
+	SocketDevice socketDevice( VncConnection::libvncClientDispatcher, client );
+
+	serialize( client, &socketDevice );
+}
+
+
+
+bool VncFeatureMessageEvent::serialize( rfbClient* client, QIODevice* ioDevice ) const
 {
 	vDebug() << qUtf8Printable(QStringLiteral("%1:%2").arg(QString::fromUtf8(client->serverHost)).arg(client->serverPort))
 			 << m_featureMessage;
 
-	SocketDevice socketDevice( VncConnection::libvncClientDispatcher, client );
 	const char messageType = FeatureMessage::RfbMessageType;
-	socketDevice.write( &messageType, sizeof(messageType) );
+	ioDevice->write( &messageType, sizeof(messageType) );
+
+	if( m_serializedMessage.isEmpty() )
+	{
+		m_featureMessage.send( ioDevice );
+	}
+	else
+	{
+		ioDevice->write( m_serializedMessage );
+	}
 
-	m_featureMessage.send( &socketDevice );
+	return true;
 }
@@ -32,11 +32,15 @@
 class VncFeatureMessageEvent : public VncEvent
 {
 public:
-	explicit VncFeatureMessageEvent( const FeatureMessage& featureMessage );
+	explicit VncFeatureMessageEvent( const FeatureMessage& featureMessage,
+									 const QByteArray& serializedMessage = {} );
 
 	void fire( rfbClient* client ) override;
 
+	bool serialize( rfbClient* client, QIODevice* ioDevice ) const override;
+
 private:
 	FeatureMessage m_featureMessage;
+	QByteArray m_serializedMessage;
 
 } ;
@@ -107,6 +107,11 @@ public:
 		return m_accessControlTimer;
 	}
 
+	QElapsedTimer& authenticationTimer()
+	{
+		return m_authenticationTimer;
+	}
+
 	const QString& username() const
 	{
 		return m_username;
@@ -162,6 +167,7 @@ private:
 	Plugin::Uid m_authMethodUid;
 	AccessControlState m_accessControlState;
 	QElapsedTimer m_accessControlTimer;
+	QElapsedTimer m_authenticationTimer;
 	QString m_username;
 	QString m_hostAddress;
 	QByteArray m_challenge;
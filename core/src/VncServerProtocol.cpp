@@ -221,6 +221,7 @@ bool VncServerProtocol::receiveAuthenticationMethodResponse()
 		const auto username = message.read().toString();
 
 		m_client->setAuthMethodUid( chosenAuthMethodUid );
+		m_client->authenticationTimer().start();
 		m_client->setUsername( username );
 
 		setState( State::Authenticating );
@@ -0,0 +1,65 @@
+/*
+ * VncStatisticsOverlay.cpp - implementation of VncStatisticsOverlay class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include "VncConnection.h"
+#include "VncStatisticsOverlay.h"
+
+
+VncStatisticsOverlay::VncStatisticsOverlay( VncConnection* connection, QWidget* parent ) :
+	QLabel( parent ),
+	m_connection( connection )
+{
+	setAttribute( Qt::WA_TransparentForMouseEvents );
+	setStyleSheet( QStringLiteral("QLabel { background: rgba(0, 0, 0, 160); color: white; padding: 4px; font-family: monospace; }") );
+
+	// discard counters accumulated before the overlay was shown
+	m_connection->statistics();
+
+	connect( &m_updateTimer, &QTimer::timeout, this, &VncStatisticsOverlay::updateStatistics );
+	m_updateTimer.start( UpdateInterval );
+
+	updateStatistics();
+}
+
+
+
+void VncStatisticsOverlay::updateStatistics()
+{
+	const auto statistics = m_connection->statistics();
+
+	setText( tr( "%1 FPS\n%2 KB/s\nDecode: %3 ms/frame\nLatency: %4\nQueued events: %5\nEncodings: %6" )
+				 .arg( statistics.framesPerSecond, 0, 'f', 1 )
+				 .arg( statistics.bytesPerSecond / 1024, 0, 'f', 1 )
+				 .arg( statistics.averageDecodeTime, 0, 'f', 2 )
+				 .arg( statistics.inputLatency >= 0 ? tr( "%1 ms" ).arg( statistics.inputLatency ) : tr( "n/a" ) )
+				 .arg( statistics.queuedEvents )
+				 .arg( statistics.encodings ) );
+	adjustSize();
+
+	if( parentWidget() )
+	{
+		move( Margin, parentWidget()->height() - height() - Margin );
+	}
+	raise();
+}
@@ -0,0 +1,51 @@
+/*
+ * VncStatisticsOverlay.h - declaration of VncStatisticsOverlay class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QLabel>
+#include <QTimer>
+
+#include "VeyonCore.h"
+
+class VncConnection;
+
+// shows frame rate, bandwidth, decode times etc. of a VncConnection
+// in the lower left corner of the parent widget
+class VEYON_CORE_EXPORT VncStatisticsOverlay : public QLabel
+{
+	Q_OBJECT
+public:
+	VncStatisticsOverlay( VncConnection* connection, QWidget* parent );
+
+private:
+	static constexpr int UpdateInterval = 1000;
+	static constexpr int Margin = 8;
+
+	void updateStatistics();
+
+	VncConnection* m_connection;
+	QTimer m_updateTimer{this};
+
+} ;
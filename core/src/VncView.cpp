@@ -260,14 +260,28 @@ QRect VncView::mapFromFramebuffer( QRect r )
 
 
 
-void VncView::updateCursorShape( const QPixmap& cursorShape, int xh, int yh )
+void VncView::updateCursorShape( const QImage& cursorShape, int xh, int yh )
 {
 	const auto scale = scaleFactor();
 
+	if( qFuzzyCompare( scale, m_scaledCursorShapesScale ) == false )
+	{
+		m_scaledCursorShapes.clear();
+		m_scaledCursorShapesScale = scale;
+	}
+
+	// the connection reuses images for recurring shapes so they can be looked up by cache key
+	auto scaledCursorShape = m_scaledCursorShapes.object( cursorShape.cacheKey() );
+	if( scaledCursorShape == nullptr )
+	{
+		scaledCursorShape = new QPixmap( QPixmap::fromImage( cursorShape.scaled( int( cursorShape.width()*scale ),
+																				 int( cursorShape.height()*scale ),
+																				 Qt::IgnoreAspectRatio, Qt::SmoothTransformation ) ) );
+		m_scaledCursorShapes.insert( cursorShape.cacheKey(), scaledCursorShape );
+	}
+
 	m_cursorHot = { int( xh*scale ), int( yh*scale ) };
-	m_cursorShape = cursorShape.scaled( int( cursorShape.width()*scale ),
-										int( cursorShape.height()*scale ),
-										Qt::IgnoreAspectRatio, Qt::SmoothTransformation );
+	m_cursorShape = *scaledCursorShape;
 
 	updateLocalCursor();
 }
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <QCache>
 #include <QEvent>
 #include <QPixmap>
 
@@ -96,7 +97,7 @@ protected:
 						  [this]( int w, int h ) { updateFramebufferSize( w, h ); } );
 
 		QObject::connect( connection(), &VncConnection::cursorShapeUpdated, object,
-						  [this]( const QPixmap& cursorShape, int xh, int yh ) { updateCursorShape( cursorShape, xh, yh ); } );
+						  [this]( const QImage& cursorShape, int xh, int yh ) { updateCursorShape( cursorShape, xh, yh ); } );
 	}
 
 	virtual void updateView( int x, int y, int w, int h ) = 0;
@@ -104,7 +105,7 @@ protected:
 	virtual void setViewCursor( const QCursor& cursor ) = 0;
 	virtual void updateGeometry() = 0;
 
-	void updateCursorShape( const QPixmap& cursorShape, int xh, int yh );
+	void updateCursorShape( const QImage& cursorShape, int xh, int yh );
 	void updateFramebufferSize( int w, int h );
 	void updateImage( int x, int y, int w, int h );
 
@@ -132,6 +133,8 @@ protected:
 	void updateLocalCursor();
 
 private:
+	static constexpr int CursorShapeCacheSize = 16;
+
 	void pressKey( unsigned int key );
 	void unpressKey( unsigned int key );
 
@@ -141,6 +144,8 @@ private:
 	VncConnection* m_connection{nullptr};
 	QPixmap m_cursorShape{};
 	QPoint m_cursorHot{0, 0};
+	QCache<qint64, QPixmap> m_scaledCursorShapes{CursorShapeCacheSize};
+	qreal m_scaledCursorShapesScale{0};
 	QSize m_framebufferSize{0, 0};
 	bool m_viewOnly{true};
 
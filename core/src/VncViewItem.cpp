@@ -23,6 +23,7 @@
  */
 
 
+#include <QQuickWindow>
 #include <QSGSimpleTextureNode>
 
 #include "QSGImageTexture.h"
@@ -35,6 +36,8 @@ VncViewItem::VncViewItem( const ComputerControlInterface::Pointer& computerContr
 {
 	connectUpdateFunctions( this );
 
+	connect( connection(), &VncConnection::imageUpdated, this, &VncViewItem::addDirtyRect );
+
 	setAcceptHoverEvents( true );
 	setAcceptedMouseButtons( Qt::AllButtons );
 	setKeepMouseGrab( true );
@@ -58,8 +61,27 @@ QSGNode* VncViewItem::updatePaintNode( QSGNode* oldNode, UpdatePaintNodeData* up
 	Q_UNUSED(updatePaintNodeData)
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-	// TODO
-	return oldNode;
+	const auto framebuffer = computerControlInterface()->framebuffer();
+	if( framebuffer.isNull() )
+	{
+		return oldNode;
+	}
+
+	auto* node = static_cast<QSGSimpleTextureNode *>(oldNode);
+	if( !node )
+	{
+		node = new QSGSimpleTextureNode();
+		node->setOwnsTexture( true );
+		m_fullUpdatePending = true;
+	}
+
+	// RHI textures can't be updated partially from here so upload the whole image on any change
+	if( m_fullUpdatePending || m_dirtyRegion.isEmpty() == false )
+	{
+		node->setTexture( window()->createTextureFromImage( viewport().isValid() ? framebuffer.copy( viewport() )
+																				   : framebuffer ) );
+		m_fullUpdatePending = false;
+	}
 #else
 	auto* node = static_cast<QSGSimpleTextureNode *>(oldNode);
 	if( !node )
@@ -70,19 +92,34 @@ QSGNode* VncViewItem::updatePaintNode( QSGNode* oldNode, UpdatePaintNodeData* up
 	}
 
 	const auto texture = qobject_cast<QSGImageTexture *>( node->texture() );
+	const auto framebuffer = computerControlInterface()->framebuffer();
+	const auto sourceRect = viewport().isValid() ? viewport() : framebuffer.rect();
 
-	if( viewport().isValid() )
+	// only upload changed areas if texture already holds the current framebuffer contents
+	if( m_fullUpdatePending ||
+		texture->textureSize() != sourceRect.size() ||
+		texture->updateImage( framebuffer, m_dirtyRegion.intersected( sourceRect ), sourceRect.topLeft() ) == false )
 	{
-		texture->setImage( computerControlInterface()->framebuffer().copy( viewport() ) );
+		if( viewport().isValid() )
+		{
+			texture->setImage( framebuffer.copy( viewport() ) );
+		}
+		else
+		{
+			texture->setImage( framebuffer );
+		}
+		m_fullUpdatePending = false;
 	}
-	else
-	{
-		texture->setImage( computerControlInterface()->framebuffer() );
-	}
-	node->setRect( boundingRect() );
+#endif
+
+	m_dirtyRegion = {};
+
+	// let the GPU scale the texture while keeping the aspect ratio like VncViewWidget does
+	node->setFiltering( QSGTexture::Linear );
+	node->setRect( QRectF( QPointF( 0, 0 ), scaledSize() ) );
+	node->markDirty( QSGNode::DirtyMaterial );
 
 	return node;
-#endif
 }
 
 
@@ -96,6 +133,13 @@ void VncViewItem::setViewCursor( const QCursor& cursor )
 
 void VncViewItem::updateGeometry()
 {
+	m_fullUpdatePending = true;
+	m_dirtyRegion = {};
+
+	const auto size = effectiveFramebufferSize();
+	setImplicitSize( size.width(), size.height() );
+
+	update();
 }
 
 
@@ -123,3 +167,42 @@ bool VncViewItem::event( QEvent* event )
 {
 	return handleEvent( event ) || QQuickItem::event( event );
 }
+
+
+
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+void VncViewItem::geometryChanged( const QRectF& newGeometry, const QRectF& oldGeometry )
+{
+	QQuickItem::geometryChanged( newGeometry, oldGeometry );
+
+	updateLocalCursor();
+	update();
+}
+#else
+void VncViewItem::geometryChange( const QRectF& newGeometry, const QRectF& oldGeometry )
+{
+	QQuickItem::geometryChange( newGeometry, oldGeometry );
+
+	updateLocalCursor();
+	update();
+}
+#endif
+
+
+
+void VncViewItem::addDirtyRect( int x, int y, int w, int h )
+{
+	if( m_fullUpdatePending )
+	{
+		return;
+	}
+
+	m_dirtyRegion += QRect( x, y, w, h );
+
+	// uploading many small rectangles is slower than a single full upload
+	if( m_dirtyRegion.rectCount() > MaximumDirtyRectCount )
+	{
+		m_fullUpdatePending = true;
+		m_dirtyRegion = {};
+	}
+}
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QQuickItem>
+#include <QRegion>
 
 #include "VncView.h"
 
@@ -44,8 +45,19 @@ protected:
 	void updateGeometry() override;
 
 	bool event( QEvent* event ) override;
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+	void geometryChanged( const QRectF& newGeometry, const QRectF& oldGeometry ) override;
+#else
+	void geometryChange( const QRectF& newGeometry, const QRectF& oldGeometry ) override;
+#endif
 
 private:
+	static constexpr int MaximumDirtyRectCount = 64;
+
+	void addDirtyRect( int x, int y, int w, int h );
+
 	QSize m_framebufferSize;
+	QRegion m_dirtyRegion;
+	bool m_fullUpdatePending{true};
 
 };
@@ -0,0 +1,95 @@
+/*
+ * VncViewQuickWidget.cpp - hardware accelerated VNC view widget
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include <QQuickWindow>
+
+#include "VncViewItem.h"
+#include "VncViewQuickWidget.h"
+#include "VncViewWidget.h"
+
+
+VncViewQuickWidget::VncViewQuickWidget( const ComputerControlInterface::Pointer& computerControlInterface,
+										QRect viewport, QWidget* parent ) :
+	QWidget( parent ),
+	m_window( new QQuickWindow ),
+	m_view( new VncViewItem( computerControlInterface, m_window->contentItem() ) ),
+	m_container( QWidget::createWindowContainer( m_window, this ) )
+{
+	auto format = m_window->format();
+	format.setSwapInterval( 1 );
+	m_window->setFormat( format );
+	m_window->setColor( Qt::black );
+
+	m_view->setViewport( viewport );
+
+	connect( m_view, &QQuickItem::implicitWidthChanged, this, &VncViewQuickWidget::updateFramebufferSize );
+	connect( m_view, &QQuickItem::implicitHeightChanged, this, &VncViewQuickWidget::updateFramebufferSize );
+
+	// the container window must not take the focus from the toplevel widget
+	m_container->setFocusPolicy( Qt::NoFocus );
+	m_container->setAttribute( Qt::WA_TransparentForMouseEvents );
+
+	show();
+
+	updateFramebufferSize();
+}
+
+
+
+VncViewQuickWidget::~VncViewQuickWidget()
+{
+	// item has to be destroyed before the window it belongs to is deleted by the container
+	delete m_view;
+}
+
+
+
+QSize VncViewQuickWidget::sizeHint() const
+{
+	return VncViewWidget::fittingSizeHint( this, m_view->effectiveFramebufferSize() );
+}
+
+
+
+void VncViewQuickWidget::resizeEvent( QResizeEvent* event )
+{
+	m_container->setGeometry( rect() );
+	m_view->setSize( size() );
+
+	QWidget::resizeEvent( event );
+}
+
+
+
+void VncViewQuickWidget::updateFramebufferSize()
+{
+	const auto size = m_view->effectiveFramebufferSize();
+	if( size.isEmpty() == false )
+	{
+		resize( size );
+	}
+
+	Q_EMIT sizeHintChanged();
+}
@@ -0,0 +1,60 @@
+/*
+ * VncViewQuickWidget.h - declaration of VncViewQuickWidget class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#pragma once
+
+#include <QWidget>
+
+#include "ComputerControlInterface.h"
+
+class QQuickWindow;
+class VncViewItem;
+
+// widget embedding a VncViewItem so that framebuffer updates are uploaded to a texture
+// and scaled by the GPU, presentation is synchronized to vertical retrace
+class VEYON_CORE_EXPORT VncViewQuickWidget : public QWidget
+{
+	Q_OBJECT
+public:
+	VncViewQuickWidget( const ComputerControlInterface::Pointer& computerControlInterface, QRect viewport,
+						QWidget* parent );
+	~VncViewQuickWidget() override;
+
+	QSize sizeHint() const override;
+
+Q_SIGNALS:
+	void sizeHintChanged();
+
+protected:
+	void resizeEvent( QResizeEvent* event ) override;
+
+private:
+	void updateFramebufferSize();
+
+	QQuickWindow* m_window;
+	VncViewItem* m_view;
+	QWidget* m_container;
+
+} ;
@@ -83,21 +83,27 @@ VncViewWidget::~VncViewWidget()
 
 
 QSize VncViewWidget::sizeHint() const
+{
+	return fittingSizeHint( this, effectiveFramebufferSize() );
+}
+
+
+
+QSize VncViewWidget::fittingSizeHint( const QWidget* widget, QSize size )
 {
 	QSize availableSize{QGuiApplication::primaryScreen()->availableVirtualSize()};
 #if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
-	const auto* windowScreen = windowHandle() ? windowHandle()->screen() : nullptr;
+	const auto* windowScreen = widget->windowHandle() ? widget->windowHandle()->screen() : nullptr;
 #else
-	const auto* windowScreen = screen();
+	const auto* windowScreen = widget->screen();
 #endif
 	if (windowScreen)
 	{
 		availableSize = windowScreen->availableVirtualSize();
 	}
 
-	availableSize -= window()->frameSize() - window()->size();
+	availableSize -= widget->window()->frameSize() - widget->window()->size();
 
-	const auto size = effectiveFramebufferSize();
 	if (size.isEmpty())
 	{
 		return availableSize;
@@ -267,8 +273,7 @@ void VncViewWidget::paintEvent( QPaintEvent* paintEvent )
 
 	if( isScaledView() )
 	{
-		// repaint everything in scaled mode to avoid artifacts at rectangle boundaries
-		p.drawImage( QRect( QPoint( 0, 0 ), scaledSize() ), image, source );
+		drawScaledImage( p, image, source, paintEvent->region() );
 	}
 	else
 	{
@@ -296,6 +301,47 @@ void VncViewWidget::paintEvent( QPaintEvent* paintEvent )
 
 
 
+void VncViewWidget::drawScaledImage( QPainter& painter, const QImage& image, QRect source, const QRegion& region )
+{
+	const QRect target( QPoint( 0, 0 ), scaledSize() );
+
+	if( region.contains( target ) || region.rectCount() > MaximumPartialRepaintRectCount )
+	{
+		painter.drawImage( target, image, source );
+		return;
+	}
+
+	const auto scaleX = qreal(target.width()) / source.width();
+	const auto scaleY = qreal(target.height()) / source.height();
+
+	for( const auto& rect : region )
+	{
+		const auto dirtyRect = rect.intersected( target );
+		if( dirtyRect.isEmpty() )
+		{
+			continue;
+		}
+
+		// map dirty rectangle to source coordinates and grow it by the filter kernel radius so that
+		// all pixels inside the dirty rectangle are interpolated the same way as in a full repaint
+		const auto dirtySource = QRectF( source.x() + dirtyRect.x() / scaleX, source.y() + dirtyRect.y() / scaleY,
+										 dirtyRect.width() / scaleX, dirtyRect.height() / scaleY ).toAlignedRect()
+									 .adjusted( -ScaleFilterKernelRadius, -ScaleFilterKernelRadius,
+												ScaleFilterKernelRadius, ScaleFilterKernelRadius )
+									 .intersected( source );
+
+		const QRectF dirtyTarget( ( dirtySource.x() - source.x() ) * scaleX, ( dirtySource.y() - source.y() ) * scaleY,
+								  dirtySource.width() * scaleX, dirtySource.height() * scaleY );
+
+		painter.save();
+		painter.setClipRect( dirtyRect );
+		painter.drawImage( dirtyTarget, image, dirtySource );
+		painter.restore();
+	}
+}
+
+
+
 void VncViewWidget::resizeEvent( QResizeEvent* event )
 {
 	update();
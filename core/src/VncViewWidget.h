@@ -41,6 +41,9 @@ public:
 
 	QSize sizeHint() const override;
 
+	// returns given framebuffer size scaled down to fit the screen of the widget's window
+	static QSize fittingSizeHint( const QWidget* widget, QSize size );
+
 	void setViewOnly( bool enabled ) override;
 
 Q_SIGNALS:
@@ -63,6 +66,11 @@ protected:
 	void resizeEvent( QResizeEvent* handleEvent ) override;
 
 private:
+	// number of source pixels affecting a scaled pixel at boundaries of partial repaints
+	static constexpr int ScaleFilterKernelRadius = 2;
+	static constexpr int MaximumPartialRepaintRectCount = 32;
+
+	void drawScaledImage( QPainter& painter, const QImage& image, QRect source, const QRegion& region );
 	void drawBusyIndicator( QPainter* painter );
 	void updateConnectionState();
 
@@ -1,6 +1,4 @@
 import QtQuick 2.0
-import QtQuick.Controls 2.0
-import QtQuick.Layouts 1.0
 
 Rectangle {
 	id: item
@@ -28,40 +26,43 @@ Rectangle {
 
 	color: selected ? themeColor : "transparent";
 
-	ColumnLayout {
-		anchors.fill: parent
-		//clip: true
-		id: computerItemLayout
-		spacing: 0
-		Image {
-			source: imageId;
-			Layout.alignment: Qt.AlignCenter
-			Layout.margins: 5
-			MouseArea {
-				anchors.fill: parent
-				onClicked: item.selected = !item.selected
-			}
+	// plain anchored items instead of layouts and controls keep the per-tile
+	// item tree small so that large grids can be created and scrolled quickly
+	Image {
+		id: image
+		source: imageId;
+		// each frame has its own URL so don't keep outdated frames in the pixmap cache
+		cache: false
+		anchors.top: parent.top
+		anchors.topMargin: 5
+		anchors.horizontalCenter: parent.horizontalCenter
+		MouseArea {
+			anchors.fill: parent
+			onClicked: item.selected = !item.selected
 		}
-		Label {
-			id: label
-			text: display;
-			Layout.maximumWidth: view.cellWidth
-			Layout.margins: 5
-			Layout.alignment: Qt.AlignCenter
-			clip: true
-			elide: Label.ElideRight
-			color: parent.GridView.isCurrentItem ? "white" : item.textColor
+	}
 
-		}
+	Text {
+		id: label
+		text: display;
+		width: Math.min(implicitWidth, view.cellWidth - 10)
+		anchors.top: image.bottom
+		anchors.topMargin: 10
+		anchors.horizontalCenter: parent.horizontalCenter
+		elide: Text.ElideRight
+		color: parent.GridView.isCurrentItem ? "white" : item.textColor
+	}
 
-		RowLayout  {
-			Repeater {
-				model: item.groups
-				delegate: Rectangle {
-					width: view.cellWidth / 5
-					height: 3
-					color: modelData
-				}
+	Row {
+		anchors.top: label.bottom
+		anchors.topMargin: 5
+		visible: item.groups && item.groups.length > 0
+		Repeater {
+			model: item.groups
+			delegate: Rectangle {
+				width: view.cellWidth / 5
+				height: 3
+				color: modelData
 			}
 		}
 	}
@@ -64,6 +64,8 @@ Page {
 			delegate: ComputerDelegate {
 				view: computerMonitoringView
 				textColor: computerMonitoring.textColor
+				Component.onCompleted: computerMonitoring.setComputerVisible(uid, true)
+				Component.onDestruction: computerMonitoring.setComputerVisible(uid, false)
 			}
 
 			ScrollBar.vertical: ScrollBar {
@@ -98,11 +98,7 @@ bool CheckableItemProxyModel::setData( const QModelIndex& index, const QVariant&
 
 	if( qAsConst(m_checkStates)[uuid] != checkState )
 	{
-		m_checkStates[uuid] = checkState;
-		Q_EMIT dataChanged( index, index, { Qt::CheckStateRole } );
-
-		setChildData( index, checkState );
-		setParentData( index.parent(), checkState );
+		setSubtreeCheckState( index, checkState );
 	}
 
 	return true;
@@ -110,6 +106,19 @@ bool CheckableItemProxyModel::setData( const QModelIndex& index, const QVariant&
 
 
 
+void CheckableItemProxyModel::setSubtreeCheckState( const QModelIndex& index, Qt::CheckState checkState )
+{
+	m_checkStates[indexToUuid( index )] = checkState;
+	Q_EMIT dataChanged( index, index, { Qt::CheckStateRole } );
+
+	setChildData( index, checkState );
+	setParentData( index.parent(), checkState );
+
+	Q_EMIT checkStatesChanged();
+}
+
+
+
 void CheckableItemProxyModel::updateNewRows(const QModelIndex &parent, int first, int last)
 {
 	if( parent.isValid() )
@@ -118,9 +127,22 @@ void CheckableItemProxyModel::updateNewRows(const QModelIndex &parent, int first
 		if( parentState == Qt::Checked )
 		{
 			// also set newly inserted items checked if parent is checked
+			bool modified = false;
 			for( int i = first; i <= last; ++i )
 			{
-				setData( index( i, 0, parent ), Qt::Checked, Qt::CheckStateRole );
+				const auto childIndex = index( i, 0, parent );
+				const auto childUuid = indexToUuid( childIndex );
+				if( qAsConst(m_checkStates)[childUuid] != Qt::Checked )
+				{
+					m_checkStates[childUuid] = Qt::Checked;
+					modified = true;
+				}
+				modified |= setChildData( childIndex, Qt::Checked );
+			}
+
+			if( modified )
+			{
+				Q_EMIT dataChanged( index( first, 0, parent ), index( last, 0, parent ), { Qt::CheckStateRole } );
 			}
 		}
 		else if( parentState == Qt::Unchecked )
@@ -144,12 +166,14 @@ void CheckableItemProxyModel::updateNewRows(const QModelIndex &parent, int first
 
 QJsonArray CheckableItemProxyModel::saveStates()
 {
+	QSet<QUuid> existingUuids;
+	collectUuids( {}, existingUuids );
+
 	QJsonArray data;
 
 	for( auto it = m_checkStates.constBegin(), end = m_checkStates.constEnd(); it != end; ++it )
 	{
-		if( it.value() == Qt::Checked &&
-			match( index( 0, 0 ), m_uidRole, it.key(), 1, Qt::MatchExactly | Qt::MatchRecursive ).isEmpty() == false )
+		if( it.value() == Qt::Checked && existingUuids.contains( it.key() ) )
 		{
 			data += it.key().toString();
 		}
@@ -165,22 +189,17 @@ void CheckableItemProxyModel::loadStates( const QJsonArray& data )
 	beginResetModel();
 
 	m_checkStates.clear();
+	m_checkStates.reserve( data.size() );
 
+	// allow items being added dynamically even if we can't propagate the check state at the moment
 	for( const auto& item : data )
 	{
-		const QUuid uid = QUuid( item.toString() );
-		const auto indexList = match( index( 0, 0 ), m_uidRole, uid, 1, // clazy:exclude=inefficient-qlist
-									  Qt::MatchExactly | Qt::MatchRecursive );
-		if( indexList.isEmpty() == false &&
-				hasChildren( indexList.first() ) == false )
-		{
-			setData( indexList.first(), Qt::Checked, Qt::CheckStateRole );
-		}
-
-		// allow items being added dynamically even if we can't propagate the check state at the moment
-		m_checkStates[uid] = Qt::Checked;
+		m_checkStates[QUuid( item.toString() )] = Qt::Checked;
 	}
 
+	// derive the states of all containers from their children in a single pass
+	updateContainerStates( {} );
+
 	endResetModel();
 }
 
@@ -262,3 +281,45 @@ void CheckableItemProxyModel::setParentData( const QModelIndex& index, Qt::Check
 		setParentData( index.parent(), checkState );
 	}
 }
+
+
+
+void CheckableItemProxyModel::updateContainerStates( const QModelIndex& index )
+{
+	const auto childCount = rowCount( index );
+	if( childCount <= 0 )
+	{
+		return;
+	}
+
+	bool allChecked = true;
+	bool anyChecked = false;
+
+	for( int i = 0; i < childCount; ++i )
+	{
+		const auto childIndex = this->index( i, 0, index );
+		updateContainerStates( childIndex );
+
+		const auto childState = data( childIndex, Qt::CheckStateRole ).value<Qt::CheckState>();
+		allChecked &= childState == Qt::Checked;
+		anyChecked |= childState != Qt::Unchecked;
+	}
+
+	if( index.isValid() )
+	{
+		m_checkStates[indexToUuid( index )] = allChecked ? Qt::Checked : ( anyChecked ? Qt::PartiallyChecked : Qt::Unchecked );
+	}
+}
+
+
+
+void CheckableItemProxyModel::collectUuids( const QModelIndex& index, QSet<QUuid>& uuids ) const
+{
+	const auto childCount = rowCount( index );
+	for( int i = 0; i < childCount; ++i )
+	{
+		const auto childIndex = this->index( i, 0, index );
+		uuids.insert( indexToUuid( childIndex ) );
+		collectUuids( childIndex, uuids );
+	}
+}
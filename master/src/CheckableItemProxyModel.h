@@ -26,6 +26,7 @@
 
 #include <QJsonArray>
 #include <QIdentityProxyModel>
+#include <QSet>
 #include <QUuid>
 
 class CheckableItemProxyModel : public QIdentityProxyModel
@@ -47,14 +48,23 @@ public:
 	QJsonArray saveStates();
 	void loadStates( const QJsonArray& data );
 
+	// checks/unchecks an item including all children and updates the parents accordingly
+	void setSubtreeCheckState( const QModelIndex& index, Qt::CheckState checkState );
+
 private:
 	QUuid indexToUuid( const QModelIndex& index ) const;
 	bool setChildData( const QModelIndex &index, Qt::CheckState checkState );
 	void setParentData( const QModelIndex &index, Qt::CheckState checkState );
+	void updateContainerStates( const QModelIndex& index );
+	void collectUuids( const QModelIndex& index, QSet<QUuid>& uuids ) const;
 
 	int m_uidRole{-1};
 	int m_exceptionRole{-1};
 	QVariant m_exceptionData{};
 	QHash<QUuid, Qt::CheckState> m_checkStates;
 
+Q_SIGNALS:
+	// emitted once per operation no matter how many items have been changed
+	void checkStatesChanged();
+
 };
@@ -22,15 +22,20 @@
  *
  */
 
+#include <algorithm>
+
 #include <QPainter>
 
 #include "ComputerControlListModel.h"
 #include "ComputerImageProvider.h"
 #include "ComputerManager.h"
 #include "FeatureManager.h"
+#include "HostAddress.h"
+#include "PresenceAnnouncement.h"
 #include "VeyonMaster.h"
 #include "UserConfig.h"
 #include "VeyonConfiguration.h"
+#include "VncConnection.h"
 
 #if defined(QT_TESTLIB_LIB) && QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
 #include <QAbstractItemModelTester>
@@ -54,6 +59,45 @@ ComputerControlListModel::ComputerControlListModel( VeyonMaster* masterCore, QOb
 	connect( &m_master->computerManager(), &ComputerManager::computerSelectionChanged,
 			 this, &ComputerControlListModel::update );
 
+	if( VeyonCore::config().adaptiveComputerMonitoringUpdateInterval() )
+	{
+		connect( &m_monitoringUpdateSchedulerTimer, &QTimer::timeout,
+				 this, &ComputerControlListModel::updateMonitoringUpdateIntervals );
+		m_monitoringUpdateSchedulerTimer.start( MonitoringUpdateSchedulerInterval );
+	}
+
+	if( VeyonCore::config().presenceAnnouncementsEnabled() )
+	{
+		m_presenceSocket = new QUdpSocket( this );
+		if( m_presenceSocket->bind( QHostAddress::Any, quint16(VeyonCore::config().presenceAnnouncementPort()),
+									QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint ) )
+		{
+			connect( m_presenceSocket, &QUdpSocket::readyRead,
+					 this, &ComputerControlListModel::processPresenceAnnouncements );
+		}
+		else
+		{
+			vWarning() << "could not listen for presence announcements:" << m_presenceSocket->errorString();
+		}
+	}
+
+	// views report visibility changes tile by tile so apply them in one go
+	m_computerVisibilityUpdateTimer.setSingleShot( true );
+	m_computerVisibilityUpdateTimer.setInterval( 0 );
+	connect( &m_computerVisibilityUpdateTimer, &QTimer::timeout,
+			 this, &ComputerControlListModel::applyComputerVisibility );
+
+	// replies to queries sent to all computers arrive in bursts so notify views about them in one go
+	m_pendingUpdatesTimer.setSingleShot( true );
+	m_pendingUpdatesTimer.setInterval( 0 );
+	connect( &m_pendingUpdatesTimer, &QTimer::timeout,
+			 this, &ComputerControlListModel::applyPendingUpdates );
+
+	m_scaledFramebufferSizeUpdateTimer.setSingleShot( true );
+	m_scaledFramebufferSizeUpdateTimer.setInterval( ScaledFramebufferSizeUpdateDelay );
+	connect( &m_scaledFramebufferSizeUpdateTimer, &QTimer::timeout,
+			 this, &ComputerControlListModel::applyScaledFramebufferSize );
+
 	updateComputerScreenSize();
 
 	reload();
@@ -180,19 +224,13 @@ void ComputerControlListModel::updateComputerScreenSize()
 	const QSize newSize{ m_master->userConfig().monitoringScreenSize(),
 						 int(m_master->userConfig().monitoringScreenSize() / ratio) };
 
-	for( auto& controlInterface : m_computerControlInterfaces )
-	{
-		controlInterface->setScaledFramebufferSize( newSize );
-	}
-
 	if( m_computerScreenSize != newSize )
 	{
 		m_computerScreenSize = newSize;
 
-		for( int i = 0; i < rowCount(); ++i )
-		{
-			updateScreen( index( i ) );
-		}
+		// zooming changes the size many times in a row so let the connection
+		// threads rescale their framebuffers only once the size has settled
+		m_scaledFramebufferSizeUpdateTimer.start();
 
 		Q_EMIT computerScreenSizeChanged();
 	}
@@ -200,6 +238,26 @@ void ComputerControlListModel::updateComputerScreenSize()
 
 
 
+void ComputerControlListModel::applyScaledFramebufferSize()
+{
+	for( auto& controlInterface : m_computerControlInterfaces )
+	{
+		controlInterface->setScaledFramebufferSize( m_computerScreenSize );
+	}
+
+	for( auto it = m_decorations.begin(), end = m_decorations.end(); it != end; ++it )
+	{
+		++it->generation;
+	}
+
+	for( int i = 0; i < rowCount(); ++i )
+	{
+		updateScreen( index( i ) );
+	}
+}
+
+
+
 ComputerControlInterface::Pointer ComputerControlListModel::computerControlInterface( const QModelIndex& index  ) const
 {
 	if( index.isValid() == false || index.row() >= m_computerControlInterfaces.count() )
@@ -229,30 +287,38 @@ ComputerControlInterface::Pointer ComputerControlListModel::computerControlInter
 
 QImage ComputerControlListModel::computerDecorationRole( const ComputerControlInterface::Pointer& controlInterface ) const
 {
+	auto& decoration = m_decorations[controlInterface.data()];
+	if( decoration.image.isNull() == false && decoration.cachedGeneration == decoration.generation )
+	{
+		return decoration.image;
+	}
+
 	switch( controlInterface->state() )
 	{
 	case ComputerControlInterface::State::Connected:
-	{
-		const auto image = controlInterface->scaledFramebuffer();
-		if( image.isNull() == false )
+		decoration.image = controlInterface->scaledFramebuffer();
+		if( decoration.image.isNull() )
 		{
-			return image;
+			decoration.image = scaleAndAlignIcon( m_iconDefault, controlInterface->scaledFramebufferSize() );
 		}
-
-		return scaleAndAlignIcon( m_iconDefault, controlInterface->scaledFramebufferSize() );
-	}
+		break;
 
 	case ComputerControlInterface::State::ServerNotRunning:
-		return scaleAndAlignIcon( m_iconServerNotRunning, controlInterface->scaledFramebufferSize() );
+		decoration.image = scaleAndAlignIcon( m_iconServerNotRunning, controlInterface->scaledFramebufferSize() );
+		break;
 
 	case ComputerControlInterface::State::AuthenticationFailed:
-		return scaleAndAlignIcon( m_iconConnectionProblem, controlInterface->scaledFramebufferSize() );
+		decoration.image = scaleAndAlignIcon( m_iconConnectionProblem, controlInterface->scaledFramebufferSize() );
+		break;
 
 	default:
+		decoration.image = scaleAndAlignIcon( m_iconDefault, controlInterface->scaledFramebufferSize() );
 		break;
 	}
 
-	return scaleAndAlignIcon( m_iconDefault, controlInterface->scaledFramebufferSize() );
+	decoration.cachedGeneration = decoration.generation;
+
+	return decoration.image;
 }
 
 
@@ -263,86 +329,227 @@ void ComputerControlListModel::reload()
 
 	const auto computerList = m_master->computerManager().selectedComputers( QModelIndex() );
 
+	for( const auto& controlInterface : qAsConst(m_computerControlInterfaces) )
+	{
+		addToConnectionPool( controlInterface );
+	}
+
 	m_computerControlInterfaces.clear();
 	m_computerControlInterfaces.reserve( computerList.size() );
+	m_pendingConnections.clear();
+	m_connectionAttempts.clear();
+	m_hiddenComputers.clear();
+	m_decorations.clear();
 
 	int row = 0;
 
 	for( const auto& computer : computerList )
 	{
-		const auto controlInterface = ComputerControlInterface::Pointer::create( computer );
+		const auto controlInterface = takePooledInterface( computer );
 		m_computerControlInterfaces.append( controlInterface );
 		startComputerControlInterface( controlInterface.data() );
 		++row;
 	}
 
 	endResetModel();
+
+	trimConnectionPool();
+
+	updateFramebufferMemoryUsage();
+
+	m_computerVisibilityUpdateTimer.start();
+
+	admitConnections();
 }
 
 
 
 void ComputerControlListModel::update()
 {
-	const auto newComputerList = m_master->computerManager().selectedComputers( QModelIndex() );
+	const auto selectedComputers = m_master->computerManager().selectedComputers( QModelIndex() );
 
-	int row = 0;
+	ComputerList newComputerList;
+	newComputerList.reserve( selectedComputers.size() );
+
+	QHash<NetworkObject::Uid, int> newComputerIndices;
+	newComputerIndices.reserve( selectedComputers.size() );
+
+	for( const auto& computer : selectedComputers )
+	{
+		if( newComputerIndices.contains( computer.networkObjectUid() ) == false )
+		{
+			newComputerIndices.insert( computer.networkObjectUid(), newComputerList.size() );
+			newComputerList.append( computer );
+		}
+	}
+
+	removeComputers( newComputerIndices );
+	moveComputers( newComputerIndices );
+	insertComputers( newComputerList );
+
+	trimConnectionPool();
 
-	for( auto it = m_computerControlInterfaces.begin(); it != m_computerControlInterfaces.end(); ) // clazy:exclude=detaching-member
+	updateComputerScreenSize();
+	updateFramebufferMemoryUsage();
+
+	m_computerVisibilityUpdateTimer.start();
+
+	admitConnections();
+}
+
+
+
+void ComputerControlListModel::removeComputers( const QHash<NetworkObject::Uid, int>& newComputerIndices )
+{
+	// remove contiguous ranges of deselected computers from back to front so row numbers stay valid
+	for( int last = m_computerControlInterfaces.size() - 1; last >= 0; --last )
 	{
-		if( newComputerList.contains( (*it)->computer() ) == false )
+		if( newComputerIndices.contains( m_computerControlInterfaces[last]->computer().networkObjectUid() ) )
 		{
-			stopComputerControlInterface( *it );
+			continue;
+		}
 
-			beginRemoveRows( QModelIndex(), row, row );
-			it = m_computerControlInterfaces.erase( it );
-			endRemoveRows();
+		int first = last;
+		while( first > 0 &&
+			   newComputerIndices.contains( m_computerControlInterfaces[first-1]->computer().networkObjectUid() ) == false )
+		{
+			--first;
 		}
-		else
+
+		for( int row = first; row <= last; ++row )
 		{
-			++it;
-			++row;
+			stopComputerControlInterface( m_computerControlInterfaces[row] );
+			addToConnectionPool( m_computerControlInterfaces[row] );
 		}
+
+		beginRemoveRows( QModelIndex(), first, last );
+		m_computerControlInterfaces.erase( m_computerControlInterfaces.begin() + first,
+										   m_computerControlInterfaces.begin() + last + 1 );
+		endRemoveRows();
+
+		last = first;
+	}
+}
+
+
+
+void ComputerControlListModel::moveComputers( const QHash<NetworkObject::Uid, int>& newComputerIndices )
+{
+	// all remaining computers are selected - determine their order in the new list
+	QVector<QPair<int, int>> targetIndices;
+	targetIndices.reserve( m_computerControlInterfaces.size() );
+	for( int row = 0; row < m_computerControlInterfaces.size(); ++row )
+	{
+		targetIndices.append( { newComputerIndices.value( m_computerControlInterfaces[row]->computer().networkObjectUid() ), row } );
+	}
+
+	if( std::is_sorted( targetIndices.cbegin(), targetIndices.cend() ) )
+	{
+		return;
+	}
+
+	std::sort( targetIndices.begin(), targetIndices.end() );
+
+	// reorder all computers at once instead of moving rows one by one
+	Q_EMIT layoutAboutToBeChanged();
+
+	QVector<int> newRows( targetIndices.size() );
+	ComputerControlInterfaceList computerControlInterfaces;
+	computerControlInterfaces.reserve( targetIndices.size() );
+	for( int row = 0; row < targetIndices.size(); ++row )
+	{
+		newRows[targetIndices[row].second] = row;
+		computerControlInterfaces.append( m_computerControlInterfaces[targetIndices[row].second] );
 	}
 
-	row = 0;
+	const auto persistentIndexes = persistentIndexList();
+	QModelIndexList newPersistentIndexes;
+	newPersistentIndexes.reserve( persistentIndexes.size() );
+	for( const auto& persistentIndex : persistentIndexes )
+	{
+		newPersistentIndexes.append( index( newRows.value( persistentIndex.row() ), persistentIndex.column() ) );
+	}
+	changePersistentIndexList( persistentIndexes, newPersistentIndexes );
+
+	m_computerControlInterfaces = computerControlInterfaces;
+
+	Q_EMIT layoutChanged();
+}
+
+
+
+void ComputerControlListModel::insertComputers( const ComputerList& newComputerList )
+{
+	// existing computers now are in the same order as in the new list so only ranges
+	// of newly selected computers have to be inserted
+	int row = 0;
 
-	for( const auto& computer : newComputerList )
+	while( row < newComputerList.size() )
 	{
-		if( row < m_computerControlInterfaces.count() && m_computerControlInterfaces[row]->computer() != computer )
+		if( row < m_computerControlInterfaces.size() &&
+			m_computerControlInterfaces[row]->computer() == newComputerList[row] )
 		{
-			beginInsertRows( QModelIndex(), row, row );
-			const auto controlInterface = ComputerControlInterface::Pointer::create( computer );
-			m_computerControlInterfaces.insert( row, controlInterface );
-			startComputerControlInterface( controlInterface.data() );
-			endInsertRows();
+			++row;
+			continue;
+		}
+
+		const auto existingComputer = row < m_computerControlInterfaces.size() ?
+										  m_computerControlInterfaces[row]->computer() : Computer();
+
+		int count = 0;
+		while( row + count < newComputerList.size() &&
+			   ( row >= m_computerControlInterfaces.size() || newComputerList[row + count] != existingComputer ) )
+		{
+			++count;
 		}
-		else if( row >= m_computerControlInterfaces.count() )
+
+		beginInsertRows( QModelIndex(), row, row + count - 1 );
+		m_computerControlInterfaces.insert( row, count, ComputerControlInterface::Pointer() );
+		for( int i = row; i < row + count; ++i )
 		{
-			beginInsertRows( QModelIndex(), row, row );
-			const auto controlInterface = ComputerControlInterface::Pointer::create( computer );
-			m_computerControlInterfaces.append( controlInterface );
+			const auto controlInterface = takePooledInterface( newComputerList[i] );
+			m_computerControlInterfaces[i] = controlInterface;
 			startComputerControlInterface( controlInterface.data() );
-			endInsertRows();
 		}
+		endInsertRows();
 
-		++row;
+		row += count;
 	}
+}
 
-	updateComputerScreenSize();
+
+
+void ComputerControlListModel::setVisibleComputers( const QSet<NetworkObject::Uid>& computerUids )
+{
+	m_visibleComputers = computerUids;
+	m_hasComputerVisibility = true;
+
+	m_computerVisibilityUpdateTimer.start();
 }
 
 
 
-QModelIndex ComputerControlListModel::interfaceIndex( ComputerControlInterface* controlInterface ) const
+void ComputerControlListModel::setComputerVisible( NetworkObject::Uid computerUid, bool visible )
 {
-	return ComputerListModel::index( m_computerControlInterfaces.indexOf( controlInterface->weakPointer() ), 0 );
+	if( visible )
+	{
+		m_visibleComputers.insert( computerUid );
+	}
+	else
+	{
+		m_visibleComputers.remove( computerUid );
+	}
+
+	m_hasComputerVisibility = true;
+
+	m_computerVisibilityUpdateTimer.start();
 }
 
 
 
-void ComputerControlListModel::updateState( const QModelIndex& index )
+QModelIndex ComputerControlListModel::interfaceIndex( ComputerControlInterface* controlInterface ) const
 {
-	Q_EMIT dataChanged( index, index, { Qt::DisplayRole, Qt::DecorationRole, Qt::ToolTipRole, ImageIdRole, FramebufferRole } );
+	return ComputerListModel::index( m_computerControlInterfaces.indexOf( controlInterface->weakPointer() ), 0 );
 }
 
 
@@ -354,22 +561,72 @@ void ComputerControlListModel::updateScreen( const QModelIndex& index )
 
 
 
-void ComputerControlListModel::updateActiveFeatures( const QModelIndex& index )
+void ComputerControlListModel::scheduleUpdate( ComputerControlInterface* controlInterface, PendingUpdate update )
 {
-	Q_EMIT dataChanged( index, index, { Qt::ToolTipRole } );
-	Q_EMIT activeFeaturesChanged( index );
+	m_pendingUpdates[controlInterface] |= int(update);
+
+	if( m_pendingUpdatesTimer.isActive() == false )
+	{
+		m_pendingUpdatesTimer.start();
+	}
 }
 
 
 
-void ComputerControlListModel::updateUser( const QModelIndex& index )
+void ComputerControlListModel::applyPendingUpdates()
 {
-	Q_EMIT dataChanged( index, index, { Qt::DisplayRole, Qt::ToolTipRole } );
+	const auto pendingUpdates = m_pendingUpdates;
+	m_pendingUpdates.clear();
+
+	QVector<int> stateRows;
+	QVector<int> activeFeaturesRows;
+	QVector<int> userRows;
+
+	for( int row = 0, count = m_computerControlInterfaces.count(); row < count; ++row )
+	{
+		const auto& controlInterface = qAsConst(m_computerControlInterfaces)[row];
+		const auto updates = pendingUpdates.value( controlInterface.data() );
+		if( updates & int(PendingUpdate::State) )
+		{
+			stateRows.append( row );
+		}
+		if( updates & int(PendingUpdate::ActiveFeatures) )
+		{
+			activeFeaturesRows.append( row );
+		}
+		if( updates & int(PendingUpdate::User) )
+		{
+			userRows.append( row );
+			m_master->computerManager().updateUser( controlInterface );
+		}
+	}
+
+	notifyDataChanged( stateRows, { Qt::DisplayRole, Qt::DecorationRole, Qt::ToolTipRole, ImageIdRole, FramebufferRole } );
+	notifyDataChanged( activeFeaturesRows, { Qt::ToolTipRole } );
+	notifyDataChanged( userRows, { Qt::DisplayRole, Qt::ToolTipRole } );
+
+	for( const auto row : qAsConst(activeFeaturesRows) )
+	{
+		Q_EMIT activeFeaturesChanged( index( row ) );
+	}
+}
+
 
-	auto controlInterface = computerControlInterface( index );
-	if( controlInterface.isNull() == false )
+
+void ComputerControlListModel::notifyDataChanged( const QVector<int>& rows, const QVector<int>& roles )
+{
+	// rows are sorted so emit one signal per range of consecutive rows
+	for( int first = 0; first < rows.size(); )
 	{
-		m_master->computerManager().updateUser( controlInterface );
+		int last = first;
+		while( last + 1 < rows.size() && rows[last + 1] == rows[last] + 1 )
+		{
+			++last;
+		}
+
+		Q_EMIT dataChanged( index( rows[first] ), index( rows[last] ), roles );
+
+		first = last + 1;
 	}
 }
 
@@ -377,28 +634,65 @@ void ComputerControlListModel::updateUser( const QModelIndex& index )
 
 void ComputerControlListModel::startComputerControlInterface( ComputerControlInterface* controlInterface )
 {
-	controlInterface->start( computerScreenSize(), ComputerControlInterface::UpdateMode::Monitoring );
+	if( controlInterface->connection() )
+	{
+		// reused from connection pool
+		controlInterface->setScaledFramebufferSize( computerScreenSize() );
+		controlInterface->setMonitoringUpdateInterval( 0 );
+		controlInterface->setUpdateMode( ComputerControlInterface::UpdateMode::Monitoring );
+	}
+	else
+	{
+		m_pendingConnections.append( controlInterface );
+	}
+
+	// invalidate cached decoration before views are notified about changes
+	const auto invalidate = [=]() { invalidateDecoration( controlInterface ); };
+	connect( controlInterface, &ComputerControlInterface::scaledFramebufferUpdated, this, invalidate );
+	connect( controlInterface, &ComputerControlInterface::stateChanged, this, invalidate );
+	connect( controlInterface, &ComputerControlInterface::userChanged, this, invalidate );
+	connect( controlInterface, &ComputerControlInterface::activeFeaturesChanged, this, invalidate );
+	connect( controlInterface, &ComputerControlInterface::framebufferSizeChanged, this, invalidate );
 
 	connect( controlInterface, &ComputerControlInterface::framebufferSizeChanged,
 			 this, &ComputerControlListModel::updateComputerScreenSize );
+	connect( controlInterface, &ComputerControlInterface::framebufferSizeChanged,
+			 this, &ComputerControlListModel::updateFramebufferMemoryUsage );
+
+	controlInterface->setServerSideScaling( m_framebufferMemoryLimitExceeded );
 
 	connect( controlInterface, &ComputerControlInterface::scaledFramebufferUpdated,
-			 this, [=] () { updateScreen( interfaceIndex( controlInterface ) ); } );
+			 this, [=] () {
+				 // tiles out of view are refreshed as soon as they become visible again
+				 if( isComputerVisible( controlInterface ) )
+				 {
+					 updateScreen( interfaceIndex( controlInterface ) );
+				 }
+			 } );
 
 	connect( controlInterface, &ComputerControlInterface::activeFeaturesChanged,
-			 this, [=] () { updateActiveFeatures( interfaceIndex( controlInterface ) ); } );
+			 this, [=] () { scheduleUpdate( controlInterface, PendingUpdate::ActiveFeatures ); } );
+
+	connect( controlInterface, &ComputerControlInterface::stateChanged,
+			 this, [=] () { scheduleUpdate( controlInterface, PendingUpdate::State ); } );
 
 	connect( controlInterface, &ComputerControlInterface::stateChanged,
-			 this, [=] () { updateState( interfaceIndex( controlInterface ) ); } );
+			 this, [=] () { updateConnectionAttempt( controlInterface ); } );
 
 	connect( controlInterface, &ComputerControlInterface::userChanged,
-			 this, [=]() { updateUser( interfaceIndex( controlInterface ) ); } );
+			 this, [=]() { scheduleUpdate( controlInterface, PendingUpdate::User ); } );
 }
 
 
 
 void ComputerControlListModel::stopComputerControlInterface( const ComputerControlInterface::Pointer& controlInterface )
 {
+	m_pendingConnections.removeAll( controlInterface.data() );
+	m_connectionAttempts.remove( controlInterface.data() );
+	m_hiddenComputers.remove( controlInterface.data() );
+	m_decorations.remove( controlInterface.data() );
+	m_pendingUpdates.remove( controlInterface.data() );
+
 	m_master->stopAllFeatures( { controlInterface } );
 
 	controlInterface->disconnect( &m_master->computerManager() );
@@ -409,6 +703,317 @@ void ComputerControlListModel::stopComputerControlInterface( const ComputerContr
 
 
 
+void ComputerControlListModel::admitConnections()
+{
+	const auto maximumConnectionAttempts = VeyonCore::config().maximumConcurrentConnectionAttempts();
+
+	while( m_pendingConnections.isEmpty() == false &&
+		   ( maximumConnectionAttempts <= 0 || m_connectionAttempts.size() < maximumConnectionAttempts ) )
+	{
+		// prefer computers which are currently visible
+		auto it = m_pendingConnections.begin();
+		if( m_hasComputerVisibility )
+		{
+			it = std::find_if( m_pendingConnections.begin(), m_pendingConnections.end(),
+							   [this]( const ComputerControlInterface* controlInterface ) {
+								   return m_visibleComputers.contains( controlInterface->computer().networkObjectUid() );
+							   } );
+			if( it == m_pendingConnections.end() )
+			{
+				it = m_pendingConnections.begin();
+			}
+		}
+
+		auto controlInterface = *it;
+		m_pendingConnections.erase( it );
+
+		// already started elsewhere, e.g. by opening a remote view
+		if( controlInterface->connection() )
+		{
+			continue;
+		}
+
+		m_connectionAttempts.insert( controlInterface );
+
+		controlInterface->start( computerScreenSize(), ComputerControlInterface::UpdateMode::Monitoring );
+	}
+}
+
+
+
+ComputerControlInterface::Pointer ComputerControlListModel::takePooledInterface( const Computer& computer )
+{
+	for( auto it = m_connectionPool.begin(), end = m_connectionPool.end(); it != end; ++it )
+	{
+		if( (*it)->computer() == computer )
+		{
+			const auto controlInterface = *it;
+			m_connectionPool.erase( it );
+			return controlInterface;
+		}
+	}
+
+	const auto controlInterface = ComputerControlInterface::Pointer::create( computer );
+	controlInterface->setMonitoredScreen( VeyonCore::config().computerMonitoringScreen() );
+
+	return controlInterface;
+}
+
+
+
+void ComputerControlListModel::addToConnectionPool( const ComputerControlInterface::Pointer& controlInterface )
+{
+	controlInterface->disconnect( this );
+	m_decorations.remove( controlInterface.data() );
+	m_pendingUpdates.remove( controlInterface.data() );
+
+	const auto memoryLimit = qint64(VeyonCore::config().connectionPoolMemoryLimit()) * 1024 * 1024;
+	if( memoryLimit <= 0 || controlInterface->connection() == nullptr )
+	{
+		return;
+	}
+
+	// keep connection alive but do not receive any framebuffer updates
+	controlInterface->setUpdateMode( ComputerControlInterface::UpdateMode::Disabled );
+
+	m_connectionPool.prepend( controlInterface );
+}
+
+
+
+void ComputerControlListModel::trimConnectionPool()
+{
+	const auto memoryLimit = qint64(VeyonCore::config().connectionPoolMemoryLimit()) * 1024 * 1024;
+
+	qint64 memoryUsage = 0;
+	for( auto it = m_connectionPool.begin(); it != m_connectionPool.end(); ) // clazy:exclude=detaching-member
+	{
+		// interfaces which have been taken from the pool again are in use and must never be evicted
+		if( m_computerControlInterfaces.contains( *it ) )
+		{
+			it = m_connectionPool.erase( it );
+			continue;
+		}
+
+		memoryUsage += estimatedMemoryUsage( *it );
+		if( memoryLimit <= 0 || memoryUsage > memoryLimit )
+		{
+			// evict least recently used connections
+			it = m_connectionPool.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+
+
+qint64 ComputerControlListModel::estimatedMemoryUsage( const ComputerControlInterface::Pointer& controlInterface )
+{
+	const auto screenSize = controlInterface->screenSize();
+	const auto scaledSize = controlInterface->scaledFramebufferSize();
+
+	return ( qint64(screenSize.width()) * screenSize.height() +
+			 qint64(scaledSize.width()) * scaledSize.height() ) * 4;
+}
+
+
+
+void ComputerControlListModel::updateFramebufferMemoryUsage()
+{
+	const auto memoryLimit = qint64(VeyonCore::config().framebufferMemoryLimit()) * 1024 * 1024;
+
+	qint64 memoryUsage = 0;
+	for( const auto& controlInterface : qAsConst(m_computerControlInterfaces) )
+	{
+		// account for the full resolution even if the server currently downscales the framebuffer
+		const auto scale = controlInterface->vncConnection() ? qint64(controlInterface->vncConnection()->serverScale()) : 1;
+		const auto screenSize = controlInterface->screenSize();
+		memoryUsage += qint64(screenSize.width()) * screenSize.height() * scale * scale * 4;
+	}
+
+	const auto limitExceeded = memoryLimit > 0 && memoryUsage > memoryLimit;
+	if( limitExceeded == m_framebufferMemoryLimitExceeded )
+	{
+		return;
+	}
+
+	vDebug() << "framebuffer memory usage (MB):" << memoryUsage / ( 1024 * 1024 )
+			 << "- server side scaling" << ( limitExceeded ? "enabled" : "disabled" );
+
+	m_framebufferMemoryLimitExceeded = limitExceeded;
+
+	for( const auto& controlInterface : qAsConst(m_computerControlInterfaces) )
+	{
+		controlInterface->setServerSideScaling( limitExceeded );
+	}
+}
+
+
+
+void ComputerControlListModel::updateConnectionAttempt( ComputerControlInterface* controlInterface )
+{
+	switch( controlInterface->state() )
+	{
+	case ComputerControlInterface::State::None:
+	case ComputerControlInterface::State::Disconnected:
+	case ComputerControlInterface::State::Connecting:
+		break;
+	default:
+		// first connection attempt finished (successfully or not) so admit next computer
+		if( m_connectionAttempts.remove( controlInterface ) )
+		{
+			admitConnections();
+		}
+		break;
+	}
+}
+
+
+
+void ComputerControlListModel::processPresenceAnnouncements()
+{
+	while( m_presenceSocket->hasPendingDatagrams() )
+	{
+		QByteArray datagram( int( qBound<qint64>( 0, m_presenceSocket->pendingDatagramSize(), PresenceAnnouncement::MaximumSize + 1 ) ), 0 );
+		QHostAddress sender;
+		const auto size = m_presenceSocket->readDatagram( datagram.data(), datagram.size(), &sender );
+
+		PresenceAnnouncement::Event event;
+		QString hostName;
+		if( size < 0 || PresenceAnnouncement::parse( datagram.left( int(size) ), &event, &hostName ) == false ||
+			event == PresenceAnnouncement::Event::Stopped )
+		{
+			// stopped servers are noticed through the closed connection anyway
+			continue;
+		}
+
+		const auto shortHostName = hostName.section( QLatin1Char('.'), 0, 0 );
+
+		for( const auto& controlInterface : qAsConst(m_computerControlInterfaces) )
+		{
+			const auto host = HostAddress::parseHost( controlInterface->computer().hostAddress() );
+			if( QHostAddress( host ).isEqual( sender, QHostAddress::ConvertV4MappedToIPv4 ) == false &&
+				( hostName.isEmpty() ||
+				  ( host.compare( hostName, Qt::CaseInsensitive ) != 0 &&
+					host.compare( shortHostName, Qt::CaseInsensitive ) != 0 ) ) )
+			{
+				continue;
+			}
+
+			vDebug() << "received" << event << "from" << host;
+
+			if( controlInterface->vncConnection() )
+			{
+				controlInterface->vncConnection()->resetConnectionRetryInterval();
+			}
+			else if( m_pendingConnections.removeOne( controlInterface.data() ) )
+			{
+				// admit computer with its next connection attempt
+				m_pendingConnections.prepend( controlInterface.data() );
+			}
+		}
+	}
+
+	admitConnections();
+}
+
+
+
+void ComputerControlListModel::updateMonitoringUpdateIntervals()
+{
+	QHash<ComputerControlInterface *, int> idleCounts;
+	idleCounts.reserve( m_computerControlInterfaces.size() );
+
+	for( const auto& controlInterface : qAsConst(m_computerControlInterfaces) )
+	{
+		auto idleCount = m_idleCounts.value( controlInterface.data() );
+		if( controlInterface->takeFramebufferActivity() > 0 )
+		{
+			idleCount = 0;
+		}
+		else
+		{
+			idleCount = qMin( idleCount + 1, IdleSchedulerCycles );
+		}
+
+		idleCounts[controlInterface.data()] = idleCount;
+
+		controlInterface->setMonitoringUpdateInterval( monitoringUpdateInterval( controlInterface, idleCount ) );
+	}
+
+	m_idleCounts = idleCounts;
+}
+
+
+
+void ComputerControlListModel::applyComputerVisibility()
+{
+	const auto adaptiveUpdateInterval = VeyonCore::config().adaptiveComputerMonitoringUpdateInterval();
+
+	for( int row = 0; row < m_computerControlInterfaces.size(); ++row )
+	{
+		const auto& controlInterface = m_computerControlInterfaces[row];
+		const auto visible = isComputerVisible( controlInterface.data() );
+		const auto wasVisible = m_hiddenComputers.contains( controlInterface.data() ) == false;
+
+		if( visible == wasVisible )
+		{
+			continue;
+		}
+
+		if( visible )
+		{
+			m_hiddenComputers.remove( controlInterface.data() );
+			m_decorations.remove( controlInterface.data() );
+			controlInterface->setMonitoringUpdateInterval(
+				adaptiveUpdateInterval ? monitoringUpdateInterval( controlInterface, 0 ) : 0 );
+			// framebuffer updates received while out of view have not been signaled
+			updateScreen( index( row ) );
+		}
+		else
+		{
+			m_hiddenComputers.insert( controlInterface.data() );
+			controlInterface->setMonitoringUpdateInterval( monitoringUpdateInterval( controlInterface, 0 ) );
+		}
+	}
+}
+
+
+
+bool ComputerControlListModel::isComputerVisible( const ComputerControlInterface* controlInterface ) const
+{
+	return m_hasComputerVisibility == false ||
+		   m_visibleComputers.contains( controlInterface->computer().networkObjectUid() );
+}
+
+
+
+int ComputerControlListModel::monitoringUpdateInterval( const ComputerControlInterface::Pointer& controlInterface,
+														int idleCount ) const
+{
+	const auto baseInterval = VeyonCore::config().computerMonitoringUpdateInterval();
+
+	// computers which are filtered or scrolled out of view only get a trickle of updates
+	if( isComputerVisible( controlInterface.data() ) == false )
+	{
+		return baseInterval * MaximumUpdateIntervalFactor;
+	}
+
+	auto factor = qBound( 1, SmallTileWidth / qMax( 1, m_computerScreenSize.width() ), IdleUpdateIntervalFactor );
+
+	if( idleCount >= IdleSchedulerCycles )
+	{
+		factor *= IdleUpdateIntervalFactor;
+	}
+
+	return baseInterval * qMin( factor, MaximumUpdateIntervalFactor );
+}
+
+
+
 double ComputerControlListModel::averageAspectRatio() const
 {
 	QSize size{ 16, 9 };
@@ -427,6 +1032,17 @@ double ComputerControlListModel::averageAspectRatio() const
 
 
 
+void ComputerControlListModel::invalidateDecoration( const ComputerControlInterface* controlInterface )
+{
+	const auto it = m_decorations.find( controlInterface );
+	if( it != m_decorations.end() )
+	{
+		++it->generation;
+	}
+}
+
+
+
 QImage ComputerControlListModel::scaleAndAlignIcon( const QImage& icon, QSize size ) const
 {
 	const auto scaledIcon = icon.scaled( size.width(), size.height(), Qt::KeepAspectRatio );
@@ -25,8 +25,12 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QHash>
 #include <QQuickImageProvider>
 #include <QImage>
+#include <QSet>
+#include <QTimer>
+#include <QUdpSocket>
 
 #include "ComputerListModel.h"
 #include "ComputerControlInterface.h"
@@ -70,25 +74,56 @@ public:
 
 	void reload();
 
+	void setVisibleComputers( const QSet<NetworkObject::Uid>& computerUids );
+	void setComputerVisible( NetworkObject::Uid computerUid, bool visible );
+
 Q_SIGNALS:
 	void activeFeaturesChanged( QModelIndex );
 	void computerScreenSizeChanged();
 
 private:
 	void update();
+	void removeComputers( const QHash<NetworkObject::Uid, int>& newComputerIndices );
+	void moveComputers( const QHash<NetworkObject::Uid, int>& newComputerIndices );
+	void insertComputers( const ComputerList& newComputerList );
 
 	QModelIndex interfaceIndex( ComputerControlInterface* controlInterface ) const;
 
-	void updateState( const QModelIndex& index );
+	enum class PendingUpdate
+	{
+		State = 0x01,
+		ActiveFeatures = 0x02,
+		User = 0x04
+	};
+
 	void updateScreen( const QModelIndex& index );
-	void updateActiveFeatures( const QModelIndex& index );
-	void updateUser( const QModelIndex& index );
+	void applyScaledFramebufferSize();
+
+	void scheduleUpdate( ComputerControlInterface* controlInterface, PendingUpdate update );
+	void applyPendingUpdates();
+	void notifyDataChanged( const QVector<int>& rows, const QVector<int>& roles );
 
 	void startComputerControlInterface( ComputerControlInterface* controlInterface );
 	void stopComputerControlInterface( const ComputerControlInterface::Pointer& controlInterface );
 
+	void admitConnections();
+
+	ComputerControlInterface::Pointer takePooledInterface( const Computer& computer );
+	void addToConnectionPool( const ComputerControlInterface::Pointer& controlInterface );
+	void trimConnectionPool();
+	static qint64 estimatedMemoryUsage( const ComputerControlInterface::Pointer& controlInterface );
+	void updateFramebufferMemoryUsage();
+	void updateConnectionAttempt( ComputerControlInterface* controlInterface );
+	void processPresenceAnnouncements();
+
+	void updateMonitoringUpdateIntervals();
+	void applyComputerVisibility();
+	bool isComputerVisible( const ComputerControlInterface* controlInterface ) const;
+	int monitoringUpdateInterval( const ComputerControlInterface::Pointer& controlInterface, int idleCount ) const;
+
 	double averageAspectRatio() const;
 
+	void invalidateDecoration( const ComputerControlInterface* controlInterface );
 	QImage scaleAndAlignIcon( const QImage& icon, QSize size ) const;
 	QString computerToolTipRole( const ComputerControlInterface::Pointer& controlInterface ) const;
 	QString computerDisplayRole( const ComputerControlInterface::Pointer& controlInterface ) const;
@@ -108,4 +143,40 @@ private:
 
 	ComputerControlInterfaceList m_computerControlInterfaces{};
 
+	// decoration images are rebuilt only if the generation has changed since they were cached
+	struct Decoration
+	{
+		quint64 generation{0};
+		quint64 cachedGeneration{0};
+		QImage image{};
+	};
+	mutable QHash<const ComputerControlInterface *, Decoration> m_decorations{};
+
+	static constexpr int MonitoringUpdateSchedulerInterval = 2000;
+	static constexpr int MaximumUpdateIntervalFactor = 10;
+	static constexpr int IdleUpdateIntervalFactor = 4;
+	static constexpr int IdleSchedulerCycles = 3;
+	static constexpr int SmallTileWidth = 150;
+	static constexpr int ScaledFramebufferSizeUpdateDelay = 250;
+
+	QTimer m_monitoringUpdateSchedulerTimer{this};
+	QTimer m_computerVisibilityUpdateTimer{this};
+	QTimer m_pendingUpdatesTimer{this};
+	QTimer m_scaledFramebufferSizeUpdateTimer{this};
+	QHash<ComputerControlInterface *, int> m_pendingUpdates{};
+	bool m_framebufferMemoryLimitExceeded{false};
+	bool m_hasComputerVisibility{false};
+	QSet<NetworkObject::Uid> m_visibleComputers{};
+	QSet<ComputerControlInterface *> m_hiddenComputers{};
+	QHash<ComputerControlInterface *, int> m_idleCounts{};
+
+	// computers waiting for their first connection attempt and those currently attempting it
+	QList<ComputerControlInterface *> m_pendingConnections{};
+	QSet<ComputerControlInterface *> m_connectionAttempts{};
+
+	// recently removed computers which are kept connected, most recently used first
+	ComputerControlInterfaceList m_connectionPool{};
+
+	QUdpSocket* m_presenceSocket{nullptr};
+
 };
@@ -27,6 +27,7 @@
 #include <QHostAddress>
 #include <QHostInfo>
 #include <QMessageBox>
+#include <QtConcurrent>
 
 #include "ComputerManager.h"
 #include "VeyonConfiguration.h"
@@ -48,9 +49,13 @@ ComputerManager::ComputerManager( UserConfig& config, QObject* parent ) :
 	m_networkObjectOverlayDataModel( new NetworkObjectOverlayDataModel( tr( "User" ), this ) ),
 	m_computerTreeModel( new CheckableItemProxyModel( NetworkObjectModel::UidRole, this ) ),
 	m_networkObjectFilterProxyModel( new NetworkObjectFilterProxyModel( this ) ),
-	m_localHostNames( QHostInfo::localHostName().toLower() ),
-	m_localHostAddresses( QHostInfo::fromName( QHostInfo::localHostName() ).addresses() )
+	m_localHostNames( QHostInfo::localHostName().toLower() )
 {
+	// resolve addresses of the local computer while the network object directory is being loaded
+	const auto localHostAddresses = QtConcurrent::run( []() {
+		return QHostInfo::fromName( QHostInfo::localHostName() ).addresses();
+	} );
+
 	if( m_networkObjectDirectory == nullptr )
 	{
 		QMessageBox::critical( nullptr,
@@ -69,6 +74,9 @@ ComputerManager::ComputerManager( UserConfig& config, QObject* parent ) :
 								 QHostInfo::localDomainName().toLower() );
 	}
 
+	m_networkObjectDirectory->update();
+	m_localHostAddresses = localHostAddresses.result();
+
 	initNetworkObjectLayer();
 	initLocations();
 	initComputerTreeModel();
@@ -160,19 +168,6 @@ void ComputerManager::updateUser(const ComputerControlInterface::Pointer& contro
 
 
 
-void ComputerManager::checkChangedData( const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles )
-{
-	Q_UNUSED(topLeft)
-	Q_UNUSED(bottomRight)
-
-	if( roles.contains( Qt::CheckStateRole ) )
-	{
-		Q_EMIT computerSelectionChanged();
-	}
-}
-
-
-
 void ComputerManager::initLocations()
 {
 	for( const auto& hostName : qAsConst( m_localHostNames ) )
@@ -214,8 +209,11 @@ void ComputerManager::initLocations()
 
 void ComputerManager::initNetworkObjectLayer()
 {
-	m_networkObjectDirectory->update();
 	m_networkObjectDirectory->setUpdateInterval( VeyonCore::config().networkObjectDirectoryUpdateInterval() );
+	connect( &VeyonCore::config().networkObjectDirectoryUpdateIntervalProperty(), &Configuration::Property::valueChanged,
+			 m_networkObjectDirectory, [this]() {
+				 m_networkObjectDirectory->setUpdateInterval( VeyonCore::config().networkObjectDirectoryUpdateInterval() );
+			 } );
 	m_networkObjectOverlayDataModel->setSourceModel( m_networkObjectModel );
 	m_networkObjectFilterProxyModel->setSourceModel( m_networkObjectOverlayDataModel );
 	m_computerTreeModel->setException( NetworkObjectModel::TypeRole, QVariant::fromValue( NetworkObject::Type::Label ) );
@@ -298,12 +296,36 @@ void ComputerManager::initComputerTreeModel()
 	connect( computerTreeModel(), &QAbstractItemModel::layoutChanged,
 			 this, &ComputerManager::computerSelectionReset );
 
-	connect( computerTreeModel(), &QAbstractItemModel::dataChanged,
-			 this, &ComputerManager::checkChangedData );
-	connect( computerTreeModel(), &QAbstractItemModel::rowsInserted,
+	// a reset reloads the whole selection so pending changes are obsolete
+	connect( computerTreeModel(), &QAbstractItemModel::modelReset,
+			 &m_computerSelectionChangedTimer, &QTimer::stop );
+	connect( computerTreeModel(), &QAbstractItemModel::layoutChanged,
+			 &m_computerSelectionChangedTimer, &QTimer::stop );
+
+	// coalesce bursts of selection edits so the selection is diffed only once
+	m_computerSelectionChangedTimer.setSingleShot( true );
+	m_computerSelectionChangedTimer.setInterval( ComputerSelectionChangedDelay );
+	connect( &m_computerSelectionChangedTimer, &QTimer::timeout,
 			 this, &ComputerManager::computerSelectionChanged );
+
+	// pass checked items to the user configuration which saves them in the background
+	connect( m_computerTreeModel, &CheckableItemProxyModel::checkStatesChanged,
+			 this, [this]() { m_checkStatesModified = true; } );
+	connect( &m_computerSelectionChangedTimer, &QTimer::timeout, this, [this]() {
+		if( m_checkStatesModified )
+		{
+			m_checkStatesModified = false;
+			m_config.setCheckedNetworkObjects( m_computerTreeModel->saveStates() );
+		}
+	} );
+
+	const auto scheduleSelectionChanged = QOverload<>::of( &QTimer::start );
+	connect( m_computerTreeModel, &CheckableItemProxyModel::checkStatesChanged,
+			 &m_computerSelectionChangedTimer, scheduleSelectionChanged );
+	connect( computerTreeModel(), &QAbstractItemModel::rowsInserted,
+			 &m_computerSelectionChangedTimer, scheduleSelectionChanged );
 	connect( computerTreeModel(), &QAbstractItemModel::rowsRemoved,
-			 this, &ComputerManager::computerSelectionChanged );
+			 &m_computerSelectionChangedTimer, scheduleSelectionChanged );
 }
 
 
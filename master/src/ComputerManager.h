@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <QTimer>
+
 #include "CheckableItemProxyModel.h"
 #include "ComputerControlInterface.h"
 
@@ -64,8 +66,6 @@ Q_SIGNALS:
 	void computerSelectionChanged();
 
 private:
-	void checkChangedData( const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles );
-
 	void initLocations();
 	void initNetworkObjectLayer();
 	void initComputerTreeModel();
@@ -82,6 +82,7 @@ private:
 	QModelIndex mapToUserNameModelIndex(const QModelIndex& networkObjectIndex) const;
 
 	static constexpr int OverlayDataUsernameColumn = 1;
+	static constexpr int ComputerSelectionChangedDelay = 50;
 
 	UserConfig& m_config;
 
@@ -97,4 +98,7 @@ private:
 	QStringList m_localHostNames;
 	QList<QHostAddress> m_localHostAddresses;
 
+	QTimer m_computerSelectionChangedTimer{this};
+	bool m_checkStatesModified{false};
+
 };
@@ -87,6 +87,17 @@ void ComputerMonitoringItem::runFeature( QString uid )
 
 
 
+void ComputerMonitoringItem::setComputerVisible( const QVariant& uid, bool visible )
+{
+	const auto uuid = uid.toUuid();
+	if( uuid.isNull() == false )
+	{
+		master()->computerControlListModel().setComputerVisible( uuid, visible );
+	}
+}
+
+
+
 QObject* ComputerMonitoringItem::model() const
 {
 	return dataModel();
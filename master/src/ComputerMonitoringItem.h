@@ -61,6 +61,7 @@ public:
 	void alignComputers() override;
 
 	Q_INVOKABLE void runFeature( QString featureUid );
+	Q_INVOKABLE void setComputerVisible( const QVariant& uid, bool visible );
 
 private:
 	QObject* model() const;
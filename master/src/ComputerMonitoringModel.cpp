@@ -22,6 +22,8 @@
  *
  */
 
+#include <algorithm>
+
 #include "ComputerControlListModel.h"
 #include "ComputerMonitoringModel.h"
 
@@ -37,6 +39,17 @@ ComputerMonitoringModel::ComputerMonitoringModel( ComputerControlListModel* sour
 	new QAbstractItemModelTester( this, QAbstractItemModelTester::FailureReportingMode::Warning, this );
 #endif
 
+	// keep cached search keys in sync - connected before setting the source model
+	// so the keys are invalidated before the base class re-filters changed rows
+	connect( sourceModel, &QAbstractItemModel::dataChanged, this, [this]( const QModelIndex& topLeft, const QModelIndex& bottomRight ) {
+		invalidateSearchKeys( topLeft.row(), bottomRight.row() );
+	} );
+	connect( sourceModel, &QAbstractItemModel::rowsInserted, this, &ComputerMonitoringModel::invalidateAllSearchKeys );
+	connect( sourceModel, &QAbstractItemModel::rowsRemoved, this, &ComputerMonitoringModel::invalidateAllSearchKeys );
+	connect( sourceModel, &QAbstractItemModel::rowsMoved, this, &ComputerMonitoringModel::invalidateAllSearchKeys );
+	connect( sourceModel, &QAbstractItemModel::layoutChanged, this, &ComputerMonitoringModel::invalidateAllSearchKeys );
+	connect( sourceModel, &QAbstractItemModel::modelReset, this, &ComputerMonitoringModel::invalidateAllSearchKeys );
+
 	setSourceModel( sourceModel );
 	setFilterCaseSensitivity( Qt::CaseInsensitive );
 	setSortRole( Qt::InitialSortOrderRole );
@@ -109,6 +122,32 @@ void ComputerMonitoringModel::setGroupsFilter( const QStringList& groups )
 
 
 
+void ComputerMonitoringModel::setSearchFilter( const QString& searchFilter )
+{
+	if( searchFilter == m_searchFilter )
+	{
+		return;
+	}
+
+	m_searchFilter = searchFilter;
+	m_foldedSearchFilter = searchFilter.toCaseFolded();
+
+	// plain text is matched as substring, anything else is treated as (case insensitive) regular expression
+	static const QRegularExpression specialCharacters( QStringLiteral("[\\\\^$*+?()\\[\\]{}|]") );
+	if( searchFilter.contains( specialCharacters ) )
+	{
+		m_searchFilterExpression = QRegularExpression( searchFilter, QRegularExpression::CaseInsensitiveOption );
+	}
+	else
+	{
+		m_searchFilterExpression = {};
+	}
+
+	invalidateFilter();
+}
+
+
+
 bool ComputerMonitoringModel::filterAcceptsRow( int sourceRow, const QModelIndex& sourceParent ) const
 {
 	if( m_stateFilter != ComputerControlInterface::State::None &&
@@ -143,5 +182,88 @@ bool ComputerMonitoringModel::filterAcceptsRow( int sourceRow, const QModelIndex
 		}
 	}
 
-	return QSortFilterProxyModel::filterAcceptsRow( sourceRow, sourceParent );
+	return matchesSearchFilter( sourceRow, sourceParent );
+}
+
+
+
+bool ComputerMonitoringModel::matchesSearchFilter( int sourceRow, const QModelIndex& sourceParent ) const
+{
+	if( m_searchFilter.isEmpty() )
+	{
+		return true;
+	}
+
+	if( m_searchKeys.size() != sourceModel()->rowCount( sourceParent ) )
+	{
+		m_searchKeys = QVector<QStringList>( sourceModel()->rowCount( sourceParent ) );
+	}
+
+	if( sourceRow < 0 || sourceRow >= m_searchKeys.size() )
+	{
+		return false;
+	}
+
+	auto& fields = m_searchKeys[sourceRow];
+	if( fields.isEmpty() )
+	{
+		fields = searchKey( sourceModel()->index( sourceRow, 0, sourceParent ) );
+	}
+
+	// match each field on its own so that anchors and patterns never span multiple fields
+	if( m_searchFilterExpression.pattern().isEmpty() == false )
+	{
+		return m_searchFilterExpression.isValid() &&
+			   std::any_of( fields.cbegin(), fields.cend(), [this]( const QString& field ) {
+				   return field.contains( m_searchFilterExpression );
+			   } );
+	}
+
+	return std::any_of( fields.cbegin(), fields.cend(), [this]( const QString& field ) {
+		return field.contains( m_foldedSearchFilter );
+	} );
+}
+
+
+
+QStringList ComputerMonitoringModel::searchKey( const QModelIndex& sourceIndex ) const
+{
+	QStringList fields{ sourceModel()->data( sourceIndex, Qt::DisplayRole ).toString() };
+
+	const auto controlInterface = sourceModel()->data( sourceIndex, ComputerControlListModel::ControlInterfaceRole )
+									  .value<ComputerControlInterface::Pointer>();
+	if( controlInterface )
+	{
+		fields += {
+			controlInterface->computer().name(),
+			controlInterface->computer().hostAddress(),
+			controlInterface->computer().location(),
+			controlInterface->userLoginName(),
+			controlInterface->userFullName()
+		};
+	}
+
+	for( auto& field : fields )
+	{
+		field = field.toCaseFolded();
+	}
+
+	return fields;
+}
+
+
+
+void ComputerMonitoringModel::invalidateSearchKeys( int first, int last )
+{
+	for( int row = qMax( 0, first ); row <= last && row < m_searchKeys.size(); ++row )
+	{
+		m_searchKeys[row].clear();
+	}
+}
+
+
+
+void ComputerMonitoringModel::invalidateAllSearchKeys()
+{
+	m_searchKeys.clear();
 }
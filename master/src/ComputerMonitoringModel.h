@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <QRegularExpression>
 #include <QSortFilterProxyModel>
 
 #include "ComputerControlInterface.h"
@@ -78,10 +79,22 @@ public:
 
 	void setGroupsFilter( const QStringList& groups );
 
+	const QString& searchFilter() const
+	{
+		return m_searchFilter;
+	}
+
+	void setSearchFilter( const QString& searchFilter );
+
 protected:
 	bool filterAcceptsRow( int sourceRow, const QModelIndex& sourceParent ) const override;
 
 private:
+	bool matchesSearchFilter( int sourceRow, const QModelIndex& sourceParent ) const;
+	QStringList searchKey( const QModelIndex& sourceIndex ) const;
+	void invalidateSearchKeys( int first, int last );
+	void invalidateAllSearchKeys();
+
 	int m_stateRole{-1};
 	int m_userLoginNameRole{-1};
 	int m_groupsRole{-1};
@@ -89,4 +102,11 @@ private:
 	bool m_filterNonEmptyUserLoginNames{false};
 	QSet<QString> m_groupsFilter;
 
+	QString m_searchFilter;
+	QString m_foldedSearchFilter;
+	QRegularExpression m_searchFilterExpression;
+
+	// case folded host names, user and location names per source row, built on demand
+	mutable QVector<QStringList> m_searchKeys;
+
 };
@@ -86,22 +86,14 @@ ComputerMonitoringModel* ComputerMonitoringView::dataModel() const
 
 QString ComputerMonitoringView::searchFilter() const
 {
-#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
-	return dataModel()->filterRegularExpression().pattern();
-#else
-	return dataModel()->filterRegExp().pattern();
-#endif
+	return dataModel()->searchFilter();
 }
 
 
 
 void ComputerMonitoringView::setSearchFilter( const QString& searchFilter )
 {
-#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 1)
-	dataModel()->setFilterRegularExpression( searchFilter );
-#else
-	dataModel()->setFilterRegExp( searchFilter );
-#endif
+	dataModel()->setSearchFilter( searchFilter );
 }
 
 
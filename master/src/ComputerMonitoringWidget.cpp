@@ -64,6 +64,20 @@ ComputerMonitoringWidget::ComputerMonitoringWidget( QWidget *parent ) :
 	initializeView( this );
 
 	setModel( dataModel() );
+
+	m_visibleComputersUpdateTimer.setInterval( VisibleComputersUpdateDelay );
+	m_visibleComputersUpdateTimer.setSingleShot( true );
+	connect( &m_visibleComputersUpdateTimer, &QTimer::timeout, this, &ComputerMonitoringWidget::updateVisibleComputers );
+
+	const auto scheduleVisibleComputersUpdate = [this]() { m_visibleComputersUpdateTimer.start(); };
+	connect( verticalScrollBar(), &QScrollBar::valueChanged, this, scheduleVisibleComputersUpdate );
+	connect( horizontalScrollBar(), &QScrollBar::valueChanged, this, scheduleVisibleComputersUpdate );
+	connect( dataModel(), &QAbstractItemModel::rowsInserted, this, scheduleVisibleComputersUpdate );
+	connect( dataModel(), &QAbstractItemModel::rowsRemoved, this, scheduleVisibleComputersUpdate );
+	connect( dataModel(), &QAbstractItemModel::layoutChanged, this, scheduleVisibleComputersUpdate );
+	connect( dataModel(), &QAbstractItemModel::modelReset, this, scheduleVisibleComputersUpdate );
+	connect( &master()->computerControlListModel(), &ComputerControlListModel::computerScreenSizeChanged,
+			 this, scheduleVisibleComputersUpdate );
 }
 
 
@@ -95,12 +109,15 @@ bool ComputerMonitoringWidget::performIconSizeAutoAdjust()
 
 	m_ignoreResizeEvent = true;
 
-	auto size = iconSize().width();
+	// every size change rescales all framebuffers so start with an estimated size
+	// instead of growing step by step - custom positions can't be estimated though
+	auto size = flexible() ? iconSize().width() : estimatedFittingComputerScreenSize();
 
 	setComputerScreenSize( size );
 	QApplication::processEvents();
 
-	while( verticalScrollBar()->isVisible() == false &&
+	while( flexible() &&
+		   verticalScrollBar()->isVisible() == false &&
 		   horizontalScrollBar()->isVisible() == false &&
 		   size < MaximumComputerScreenSize )
 	{
@@ -128,6 +145,80 @@ bool ComputerMonitoringWidget::performIconSizeAutoAdjust()
 
 
 
+int ComputerMonitoringWidget::estimatedFittingComputerScreenSize() const
+{
+	const auto count = model()->rowCount();
+	const auto currentIconSize = iconSize();
+
+	if( count <= 0 || currentIconSize.isEmpty() )
+	{
+		return currentIconSize.width();
+	}
+
+	// the label and margins of an item do not depend on the icon size
+	const auto itemOverhead = sizeHintForIndex( model()->index( 0, 0 ) ) - currentIconSize;
+	const auto aspectRatio = double(currentIconSize.width()) / currentIconSize.height();
+	const auto availableSize = maximumViewportSize();
+	const auto itemSpacing = spacing();
+
+	const auto fits = [&]( int size ) {
+		const auto itemWidth = size + itemOverhead.width() + itemSpacing;
+		const auto itemHeight = int( size / aspectRatio ) + itemOverhead.height() + itemSpacing;
+		const auto columns = ( availableSize.width() - itemSpacing ) / itemWidth;
+		if( columns < 1 )
+		{
+			return false;
+		}
+		const auto rows = ( count + columns - 1 ) / columns;
+		return rows * itemHeight + itemSpacing <= availableSize.height();
+	};
+
+	// binary search for the largest size (in steps) which lets all items fit
+	int lowerStep = 0;
+	int upperStep = ( MaximumComputerScreenSize - MinimumComputerScreenSize ) / IconSizeAdjustStepSize;
+
+	while( lowerStep < upperStep )
+	{
+		const auto step = ( lowerStep + upperStep + 1 ) / 2;
+		if( fits( MinimumComputerScreenSize + step * IconSizeAdjustStepSize ) )
+		{
+			lowerStep = step;
+		}
+		else
+		{
+			upperStep = step - 1;
+		}
+	}
+
+	return MinimumComputerScreenSize + lowerStep * IconSizeAdjustStepSize;
+}
+
+
+
+void ComputerMonitoringWidget::updateVisibleComputers()
+{
+	QSet<NetworkObject::Uid> visibleComputers;
+
+	if( isVisible() )
+	{
+		const auto viewportRect = viewport()->rect();
+		const auto rows = model()->rowCount();
+
+		for( int row = 0; row < rows; ++row )
+		{
+			const auto index = model()->index( row, 0 );
+			if( visualRect( index ).intersects( viewportRect ) )
+			{
+				visibleComputers.insert( model()->data( index, ComputerControlListModel::UidRole ).toUuid() );
+			}
+		}
+	}
+
+	master()->computerControlListModel().setVisibleComputers( visibleComputers );
+}
+
+
+
 void ComputerMonitoringWidget::setUseCustomComputerPositions( bool enabled )
 {
 	setFlexible( enabled );
@@ -365,6 +456,8 @@ void ComputerMonitoringWidget::resizeEvent( QResizeEvent* event )
 	{
 		initiateIconSizeAutoAdjust();
 	}
+
+	m_visibleComputersUpdateTimer.start();
 }
 
 
@@ -376,6 +469,8 @@ void ComputerMonitoringWidget::showEvent( QShowEvent* event )
 		initiateIconSizeAutoAdjust();
 	}
 
+	m_visibleComputersUpdateTimer.start();
+
 	FlexibleListView::showEvent( event );
 }
 
@@ -64,6 +64,9 @@ private:
 	void loadComputerPositions( const QJsonArray& positions ) override;
 
 	bool performIconSizeAutoAdjust() override;
+	int estimatedFittingComputerScreenSize() const;
+
+	void updateVisibleComputers();
 
 	void populateFeatureMenu( const ComputerControlInterfaceList& computerControlInterfaces );
 	void addFeatureToMenu( const Feature& feature, const QString& label );
@@ -91,6 +94,9 @@ private:
 
 	ComputerZoomWidget* m_computerZoomWidget{nullptr};
 
+	static constexpr auto VisibleComputersUpdateDelay = 250;
+	QTimer m_visibleComputersUpdateTimer{this};
+
 Q_SIGNALS:
 	void computerScreenSizeAdjusted( int size );
 
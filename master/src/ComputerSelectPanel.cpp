@@ -58,8 +58,12 @@ ComputerSelectPanel::ComputerSelectPanel( ComputerManager& computerManager, Comp
 
 	ui->filterLineEdit->setHidden( VeyonCore::config().hideComputerFilter() );
 
+	// filtering the (possibly large) tree recursively is expensive so wait for typing to pause
+	m_filterTimer.setSingleShot( true );
+	m_filterTimer.setInterval( FilterDelay );
+	connect( &m_filterTimer, &QTimer::timeout, this, &ComputerSelectPanel::updateFilter );
 	connect( ui->filterLineEdit, &QLineEdit::textChanged,
-			 this, &ComputerSelectPanel::updateFilter );
+			 &m_filterTimer, QOverload<>::of(&QTimer::start) );
 }
 
 
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QModelIndexList>
+#include <QTimer>
 #include <QWidget>
 
 namespace Ui {
@@ -50,10 +51,13 @@ private Q_SLOTS:
 	void updateFilter();
 
 private:
+	static constexpr int FilterDelay = 150;
+
 	Ui::ComputerSelectPanel *ui;
 	ComputerManager& m_computerManager;
 	ComputerSelectModel* m_model;
 	QString m_previousFilter;
 	QModelIndexList m_expandedGroups;
+	QTimer m_filterTimer{this};
 
 };
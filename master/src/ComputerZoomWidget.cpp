@@ -25,11 +25,15 @@
 #include <QApplication>
 #include <QIcon>
 #include <QKeyEvent>
+#include <QLabel>
+#include <QPainter>
+#include <QSlider>
 
 #include "ComputerZoomWidget.h"
 #include "VeyonConfiguration.h"
 #include "VeyonMasterInterface.h"
 #include "PlatformCoreFunctions.h"
+#include "VncStatisticsOverlay.h"
 #include "VncViewWidget.h"
 
 
@@ -60,6 +64,28 @@ ComputerZoomWidget::ComputerZoomWidget( const ComputerControlInterface::Pointer&
 	m_vncView->installEventFilter( this );
 	connect( m_vncView, &VncViewWidget::sizeHintChanged, this, &ComputerZoomWidget::updateSize );
 
+	const auto thumbnailHistory = computerControlInterface->thumbnailHistory();
+	if( thumbnailHistory )
+	{
+		// scrubbing through the history works with the cursor keys while the zoom is shown
+		m_historyThumbnail = new QLabel( this );
+		m_historyThumbnail->setAlignment( Qt::AlignCenter );
+		m_historyThumbnail->setStyleSheet( QStringLiteral("QLabel { background: black; color: white; }") );
+		m_historyThumbnail->hide();
+
+		m_historySlider = new QSlider( Qt::Horizontal, this );
+		m_historySlider->setFocusPolicy( Qt::NoFocus );
+		connect( m_historySlider, &QSlider::valueChanged, this, &ComputerZoomWidget::showHistoryThumbnail );
+		connect( thumbnailHistory, &ThumbnailHistory::thumbnailAdded, this, &ComputerZoomWidget::updateHistoryRange );
+
+		updateHistoryRange();
+	}
+
+	if( VeyonCore::config().connectionStatisticsOverlay() )
+	{
+		new VncStatisticsOverlay( m_vncView->connection(), m_vncView );
+	}
+
 	setWindowState(Qt::WindowMaximized);
 	VeyonCore::platform().coreFunctions().raiseWindow( this, false );
 
@@ -83,6 +109,18 @@ bool ComputerZoomWidget::eventFilter( QObject* object, QEvent* event )
 
 		const auto screens = m_vncView->computerControlInterface()->screens();
 		const auto key = static_cast<QKeyEvent *>( event )->key();
+
+		if( m_historySlider && ( key == Qt::Key_Left || key == Qt::Key_Right || key == Qt::Key_End ) )
+		{
+			switch( key )
+			{
+			case Qt::Key_Left: m_historySlider->setValue( m_historySlider->value() - 1 ); break;
+			case Qt::Key_Right: m_historySlider->setValue( m_historySlider->value() + 1 ); break;
+			default: m_historySlider->setValue( m_historySlider->maximum() ); break;
+			}
+			return true;
+		}
+
 		if ( screens.size() > 1 && ( key == Qt::Key_Tab || key == Qt::Key_Backtab ) )
 		{
 			if( key == Qt::Key_Tab )
@@ -152,9 +190,71 @@ void ComputerZoomWidget::updateComputerZoomWidgetTitle()
 
 
 
+void ComputerZoomWidget::updateHistoryRange()
+{
+	const auto thumbnailHistory = m_vncView->computerControlInterface()->thumbnailHistory();
+
+	// the last position shows the live view
+	const auto live = m_historySlider->value() == m_historySlider->maximum();
+	m_historySlider->setMaximum( thumbnailHistory->count() );
+	if( live )
+	{
+		m_historySlider->setValue( m_historySlider->maximum() );
+	}
+
+	m_historySlider->setVisible( thumbnailHistory->count() > 0 );
+	updateHistoryGeometry();
+}
+
+
+
+void ComputerZoomWidget::showHistoryThumbnail( int index )
+{
+	const auto thumbnailHistory = m_vncView->computerControlInterface()->thumbnailHistory();
+	const auto image = thumbnailHistory->image( index );
+
+	if( image.isNull() )
+	{
+		m_historyThumbnail->hide();
+		return;
+	}
+
+	auto pixmap = QPixmap::fromImage( image ).scaled( m_historyThumbnail->size(), Qt::KeepAspectRatio,
+													   Qt::SmoothTransformation );
+
+	QPainter painter( &pixmap );
+	painter.setPen( Qt::white );
+	painter.drawText( pixmap.rect().adjusted( 8, 8, -8, -8 ), Qt::AlignTop | Qt::AlignLeft,
+					  thumbnailHistory->timestamp( index ).time().toString() );
+	painter.end();
+
+	m_historyThumbnail->setPixmap( pixmap );
+	m_historyThumbnail->show();
+	m_historyThumbnail->raise();
+}
+
+
+
+void ComputerZoomWidget::updateHistoryGeometry()
+{
+	if( m_historySlider == nullptr )
+	{
+		return;
+	}
+
+	const auto sliderHeight = m_historySlider->sizeHint().height();
+	m_historySlider->setGeometry( 0, height() - sliderHeight, width(), sliderHeight );
+	m_historySlider->raise();
+
+	m_historyThumbnail->setGeometry( 0, 0, width(), height() - sliderHeight );
+}
+
+
+
 void ComputerZoomWidget::resizeEvent( QResizeEvent* event )
 {
 	m_vncView->resize( size() );
+	updateHistoryGeometry();
 
 	QWidget::resizeEvent( event );
 }
@@ -28,6 +28,8 @@
 
 #include <QWidget>
 
+class QLabel;
+class QSlider;
 class VncViewWidget;
 
 // clazy:excludeall=ctor-missing-parent-argument
@@ -47,11 +49,17 @@ protected:
 private:
 	void updateSize();
 	void updateComputerZoomWidgetTitle();
+	void updateHistoryRange();
+	void showHistoryThumbnail( int index );
+	void updateHistoryGeometry();
 
 	int m_currentScreen{-1};
 
 	VncViewWidget* m_vncView;
 
+	QSlider* m_historySlider{nullptr};
+	QLabel* m_historyThumbnail{nullptr};
+
 Q_SIGNALS:
 	void keypressInComputerZoomWidget( );
 
@@ -72,17 +72,18 @@ bool FlexibleListView::flexible() const
 void FlexibleListView::alignToGrid()
 {
 	auto m = model();
+	const auto gridSize = effectiveGridSize();
 
 	for( int i = 0, count = m->rowCount(); i < count; ++i )
 	{
 		const auto index = m->index( i, 0 );
-		const auto uid = m->data( index, m_uidRole ).toUuid();
+		const auto it = m_positions.find( m->data( index, m_uidRole ).toUuid() );
 
-		if( uid.isNull() == false && m_positions.contains( uid ) )
+		if( it != m_positions.end() )
 		{
-			m_positions[uid] = QPointF( qMax<int>( 0, qRound( m_positions[uid].x() ) ),
-										qMax<int>( 0, qRound( m_positions[uid].y() ) ) );
-			setPositionForIndex( toItemPosition( qAsConst(m_positions)[uid] ), index );
+			*it = QPointF( qMax<int>( 0, qRound( it->x() ) ),
+						   qMax<int>( 0, qRound( it->y() ) ) );
+			setPositionForIndex( toItemPosition( *it, gridSize ), index );
 		}
 	}
 }
@@ -176,19 +177,22 @@ void FlexibleListView::restorePositions()
 {
 	auto m = model();
 
-	if( m == nullptr )
+	if( m == nullptr || m_positions.isEmpty() )
 	{
 		return;
 	}
 
+	// the grid size is derived from the first item's geometry so determine it only once
+	const auto gridSize = effectiveGridSize();
+
 	for( int i = 0, count = m->rowCount(); i < count; ++i )
 	{
 		const auto index = m->index( i, 0 );
-		const auto uid = m->data( index, m_uidRole ).toUuid();
+		const auto it = m_positions.constFind( m->data( index, m_uidRole ).toUuid() );
 
-		if( uid.isNull() == false && m_positions.contains( uid ) )
+		if( it != m_positions.constEnd() )
 		{
-			setPositionForIndex( toItemPosition( qAsConst(m_positions)[uid] ), index );
+			setPositionForIndex( toItemPosition( *it, gridSize ), index );
 		}
 	}
 }
@@ -200,6 +204,7 @@ void FlexibleListView::updatePositions()
 	if( movement() == QListView::Free && model() )
 	{
 		auto m = model();
+		const auto gridSize = effectiveGridSize();
 
 		for( int i = 0, count = m->rowCount(); i < count; ++i )
 		{
@@ -208,7 +213,7 @@ void FlexibleListView::updatePositions()
 
 			if( uid.isNull() == false )
 			{
-				m_positions[uid] = toGridPoint( rectForIndex( index ).topLeft() );
+				m_positions[uid] = toGridPoint( rectForIndex( index ).topLeft(), gridSize );
 			}
 		}
 	}
@@ -235,20 +240,16 @@ QSizeF FlexibleListView::effectiveGridSize() const
 
 
 
-QPointF FlexibleListView::toGridPoint( QPoint pos ) const
+QPointF FlexibleListView::toGridPoint( QPoint pos, QSizeF gridSize ) const
 {
-	const auto gridSize = effectiveGridSize();
-
 	return { ( pos.x() - spacing() ) / gridSize.width(),
 				( pos.y() - spacing() ) / gridSize.height() };
 }
 
 
 
-QPoint FlexibleListView::toItemPosition( QPointF gridPoint ) const
+QPoint FlexibleListView::toItemPosition( QPointF gridPoint, QSizeF gridSize ) const
 {
-	const auto gridSize = effectiveGridSize();
-
 	return { spacing() + qMax<int>( 0, static_cast<int>( gridPoint.x() * gridSize.width() ) ),
 				spacing() + qMax<int>( 0, static_cast<int>( gridPoint.y() * gridSize.height() ) ) };
 }
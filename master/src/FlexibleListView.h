@@ -56,8 +56,8 @@ private:
 	void updatePositions();
 
 	QSizeF effectiveGridSize() const;
-	QPointF toGridPoint( QPoint pos ) const;
-	QPoint toItemPosition( QPointF gridPoint ) const;
+	QPointF toGridPoint( QPoint pos, QSizeF gridSize ) const;
+	QPoint toItemPosition( QPointF gridPoint, QSizeF gridSize ) const;
 
 	int m_uidRole;
 	QHash<QUuid, QPointF> m_positions;
@@ -198,8 +198,12 @@ MainWindow::MainWindow( VeyonMaster &masterCore, QWidget* parent ) :
 	// initialize search filter
 	ui->filterPoweredOnComputersButton->setChecked( m_master.userConfig().filterPoweredOnComputers() );
 	ui->filterComputersWithLoggedOnUsersButton->setChecked( m_master.userConfig().filterComputersWithLoggedOnUsers() );
-	connect( ui->filterLineEdit, &QLineEdit::textChanged,
-			 this, [this]( const QString& filter ) { ui->computerMonitoringWidget->setSearchFilter( filter ); } );
+	// do not re-filter all computers for each keystroke while typing
+	m_searchFilterTimer.setSingleShot( true );
+	m_searchFilterTimer.setInterval( SearchFilterDelay );
+	connect( &m_searchFilterTimer, &QTimer::timeout,
+			 this, [this]() { ui->computerMonitoringWidget->setSearchFilter( ui->filterLineEdit->text() ); } );
+	connect( ui->filterLineEdit, &QLineEdit::textChanged, &m_searchFilterTimer, QOverload<>::of(&QTimer::start) );
 	connect( ui->filterPoweredOnComputersButton, &QToolButton::toggled,
 			 this, [this]( bool enabled ) { ui->computerMonitoringWidget->setFilterPoweredOnComputers( enabled ); } );
 	connect( ui->filterComputersWithLoggedOnUsersButton, &QToolButton::toggled,
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QMainWindow>
+#include <QTimer>
 
 #include "ComputerControlInterface.h"
 
@@ -72,6 +73,8 @@ private:
 		return int(qHash(feature.uid()));
 	}
 
+	static constexpr int SearchFilterDelay = 150;
+
 	static constexpr const char* originalSizePropertyName()
 	{
 		return "originalSize";
@@ -88,4 +91,6 @@ private:
 
 	QButtonGroup* m_modeGroup;
 
+	QTimer m_searchFilterTimer{this};
+
 } ;
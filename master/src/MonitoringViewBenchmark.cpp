@@ -0,0 +1,124 @@
+/*
+ * MonitoringViewBenchmark.cpp - helper for measuring the rendering performance of the monitoring view
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include <algorithm>
+#include <numeric>
+
+#include "ComputerMonitoringModel.h"
+#include "ComputerMonitoringWidget.h"
+#include "MainWindow.h"
+#include "MonitoringViewBenchmark.h"
+
+
+#ifdef VEYON_DEBUG
+
+bool MonitoringViewBenchmark::run()
+{
+	auto mainWindow = m_master.mainWindow();
+	if( mainWindow == nullptr )
+	{
+		vCritical() << "benchmark is only available for the classic user interface";
+		return false;
+	}
+
+	mainWindow->move( 0, 0 );
+	mainWindow->resize( 1920, 1080 );
+	mainWindow->show();
+
+	auto view = mainWindow->findChild<ComputerMonitoringWidget *>();
+
+	// let the computers of the configured locations be loaded and connections be attempted
+	QElapsedTimer startupTimer;
+	startupTimer.start();
+	while( startupTimer.elapsed() < 5000 )
+	{
+		QCoreApplication::processEvents( QEventLoop::AllEvents, 100 );
+	}
+
+	QJsonArray results;
+	for( const auto computerScreenSize : { 100, 150, 250, 400 } )
+	{
+		results.append( measure( view, computerScreenSize ) );
+	}
+
+	const QJsonObject report{
+		{ QStringLiteral("version"), VeyonCore::versionString() },
+		{ QStringLiteral("computers"), view->dataModel()->rowCount() },
+		{ QStringLiteral("results"), results }
+	};
+
+	QFile outputFile( m_outputFileName );
+	if( outputFile.open( QFile::WriteOnly | QFile::Truncate ) == false )
+	{
+		vCritical() << "could not write benchmark results to" << m_outputFileName;
+		return false;
+	}
+
+	outputFile.write( QJsonDocument( report ).toJson() );
+
+	return true;
+}
+
+
+
+QJsonObject MonitoringViewBenchmark::measure( ComputerMonitoringWidget* view, int computerScreenSize )
+{
+	view->setComputerScreenSize( computerScreenSize );
+	QCoreApplication::processEvents();
+
+	QVector<qint64> frameTimes;
+	frameTimes.reserve( FramesPerSize );
+
+	QElapsedTimer frameTimer;
+
+	for( int i = 0; i < FramesPerSize; ++i )
+	{
+		frameTimer.start();
+		view->viewport()->repaint();
+		frameTimes.append( frameTimer.nsecsElapsed() );
+
+		// process updated framebuffers between frames like in regular operation
+		QCoreApplication::processEvents();
+	}
+
+	std::sort( frameTimes.begin(), frameTimes.end() );
+
+	const auto toMilliseconds = []( qint64 nsecs ) { return double(nsecs) / 1e6; };
+
+	return {
+		{ QStringLiteral("computerScreenSize"), computerScreenSize },
+		{ QStringLiteral("averageFrameTime"),
+		  toMilliseconds( std::accumulate( frameTimes.constBegin(), frameTimes.constEnd(), qint64(0) ) / frameTimes.size() ) },
+		{ QStringLiteral("medianFrameTime"), toMilliseconds( frameTimes[frameTimes.size() / 2] ) },
+		{ QStringLiteral("maximumFrameTime"), toMilliseconds( frameTimes.last() ) }
+	};
+}
+
+#endif
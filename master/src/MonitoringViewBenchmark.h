@@ -0,0 +1,59 @@
+/*
+ * MonitoringViewBenchmark.h - helper for measuring the rendering performance of the monitoring view
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QJsonObject>
+#include <QObject>
+
+#include "VeyonMaster.h"
+
+#ifdef VEYON_DEBUG
+
+class ComputerMonitoringWidget;
+
+// clazy:excludeall=ctor-missing-parent-argument
+class MonitoringViewBenchmark : public QObject
+{
+	Q_OBJECT
+public:
+	explicit MonitoringViewBenchmark( const QString& outputFileName ) :
+		m_outputFileName( outputFileName )
+	{
+	}
+
+	bool run();
+
+private:
+	static constexpr int FramesPerSize = 100;
+
+	static QJsonObject measure( ComputerMonitoringWidget* view, int computerScreenSize );
+
+	const QString m_outputFileName;
+
+	VeyonMaster m_master{VeyonCore::instance()};
+
+};
+
+#endif
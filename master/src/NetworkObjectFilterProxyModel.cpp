@@ -43,7 +43,13 @@ NetworkObjectFilterProxyModel::NetworkObjectFilterProxyModel( QObject* parent )
 void NetworkObjectFilterProxyModel::setGroupFilter( const QStringList& groupList )
 {
 	beginResetModel();
-	m_groupList = groupList;
+	m_groups.clear();
+	m_groups.reserve( groupList.size() );
+	for( const auto& group : groupList )
+	{
+		m_groups.insert( group );
+	}
+	invalidateContainerCache();
 	endResetModel();
 }
 
@@ -52,12 +58,47 @@ void NetworkObjectFilterProxyModel::setGroupFilter( const QStringList& groupList
 void NetworkObjectFilterProxyModel::setComputerExcludeFilter( const QStringList& computerExcludeList )
 {
 	beginResetModel();
-	m_computerExcludeList = computerExcludeList;
+	m_excludedComputers.clear();
+	m_excludedComputers.reserve( computerExcludeList.size() );
+	for( const auto& computer : computerExcludeList )
+	{
+		m_excludedComputers.insert( computer.toCaseFolded() );
+	}
 	endResetModel();
 }
 
 
 
+void NetworkObjectFilterProxyModel::setSourceModel( QAbstractItemModel* sourceModel )
+{
+	if( this->sourceModel() )
+	{
+		disconnect( this->sourceModel(), nullptr, this, nullptr );
+	}
+
+	// connect before the base class does so cached results are dropped before they're used
+	// for re-evaluating rows of the modified source model
+	if( sourceModel )
+	{
+		connect( sourceModel, &QAbstractItemModel::dataChanged, this, &NetworkObjectFilterProxyModel::invalidateContainerCache );
+		connect( sourceModel, &QAbstractItemModel::rowsAboutToBeInserted, this, &NetworkObjectFilterProxyModel::invalidateContainerCache );
+		connect( sourceModel, &QAbstractItemModel::rowsInserted, this, &NetworkObjectFilterProxyModel::invalidateContainerCache );
+		connect( sourceModel, &QAbstractItemModel::rowsAboutToBeRemoved, this, &NetworkObjectFilterProxyModel::invalidateContainerCache );
+		connect( sourceModel, &QAbstractItemModel::rowsRemoved, this, &NetworkObjectFilterProxyModel::invalidateContainerCache );
+		connect( sourceModel, &QAbstractItemModel::rowsMoved, this, &NetworkObjectFilterProxyModel::invalidateContainerCache );
+		connect( sourceModel, &QAbstractItemModel::layoutAboutToBeChanged, this, &NetworkObjectFilterProxyModel::invalidateContainerCache );
+		connect( sourceModel, &QAbstractItemModel::layoutChanged, this, &NetworkObjectFilterProxyModel::invalidateContainerCache );
+		connect( sourceModel, &QAbstractItemModel::modelAboutToBeReset, this, &NetworkObjectFilterProxyModel::invalidateContainerCache );
+		connect( sourceModel, &QAbstractItemModel::modelReset, this, &NetworkObjectFilterProxyModel::invalidateContainerCache );
+	}
+
+	invalidateContainerCache();
+
+	QSortFilterProxyModel::setSourceModel( sourceModel );
+}
+
+
+
 bool NetworkObjectFilterProxyModel::filterAcceptsRow( int sourceRow, const QModelIndex& sourceParent ) const
 {
 	const auto rowIndex = sourceModel()->index(sourceRow, 0, sourceParent);
@@ -65,50 +106,75 @@ bool NetworkObjectFilterProxyModel::filterAcceptsRow( int sourceRow, const QMode
 
 	if (objectType == NetworkObject::Type::Host)
 	{
-		if( m_computerExcludeList.isEmpty() )
+		if( m_excludedComputers.isEmpty() )
 		{
 			return true;
 		}
 
 		const auto hostAddress = sourceModel()->data(rowIndex, NetworkObjectModel::HostAddressRole).toString();
 
-		return m_computerExcludeList.contains( hostAddress, Qt::CaseInsensitive ) == false;
+		return m_excludedComputers.contains( hostAddress.toCaseFolded() ) == false;
 	}
 	else if(NetworkObject::isContainer(objectType))
 	{
-		if (sourceModel()->canFetchMore(rowIndex))
+		const auto cachedResult = m_containerCache.constFind( rowIndex );
+		if( cachedResult != m_containerCache.constEnd() )
 		{
-			sourceModel()->fetchMore(rowIndex);
+			return *cachedResult;
 		}
 
-		const auto rows = sourceModel()->rowCount(rowIndex);
+		const auto accepted = filterAcceptsContainer( rowIndex );
 
-		if (m_excludeEmptyGroups && rows == 0)
-		{
-			return false;
-		}
+		// fetching children above may have invalidated the cache, which doesn't matter for this result
+		m_containerCache.insert( rowIndex, accepted );
 
-		if (m_groupList.isEmpty())
-		{
-			return true;
-		}
+		return accepted;
+	}
 
-		for (int i = 0; i < rows; ++i)
-		{
-			const auto objectType = NetworkObject::Type(sourceModel()->data(sourceModel()->index(i, 0, rowIndex),
-																			NetworkObjectModel::TypeRole).toInt());
+	return true;
+}
+
+
+
+bool NetworkObjectFilterProxyModel::filterAcceptsContainer( const QModelIndex& index ) const
+{
+	if (sourceModel()->canFetchMore(index))
+	{
+		sourceModel()->fetchMore(index);
+	}
+
+	const auto rows = sourceModel()->rowCount(index);
+
+	if (m_excludeEmptyGroups && rows == 0)
+	{
+		return false;
+	}
+
+	if (m_groups.isEmpty())
+	{
+		return true;
+	}
+
+	for (int i = 0; i < rows; ++i)
+	{
+		const auto objectType = NetworkObject::Type(sourceModel()->data(sourceModel()->index(i, 0, index),
+																		NetworkObjectModel::TypeRole).toInt());
 
-			if (objectType == NetworkObject::Type::Location || objectType == NetworkObject::Type::DesktopGroup)
+		if (objectType == NetworkObject::Type::Location || objectType == NetworkObject::Type::DesktopGroup)
+		{
+			if (filterAcceptsRow(i, index))
 			{
-				if (filterAcceptsRow(i, rowIndex))
-				{
-					return true;
-				}
+				return true;
 			}
 		}
-
-		return m_groupList.contains(sourceModel()->data(rowIndex).toString());
 	}
 
-	return true;
+	return m_groups.contains(sourceModel()->data(index).toString());
+}
+
+
+
+void NetworkObjectFilterProxyModel::invalidateContainerCache()
+{
+	m_containerCache.clear();
 }
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <QSet>
 #include <QSortFilterProxyModel>
 
 class NetworkObjectFilterProxyModel : public QSortFilterProxyModel
@@ -37,14 +38,23 @@ public:
 	void setEmptyGroupsExcluded( bool enabled )
 	{
 		m_excludeEmptyGroups = enabled;
+		invalidateContainerCache();
 	}
 
+	void setSourceModel( QAbstractItemModel* sourceModel ) override;
+
 protected:
 	bool filterAcceptsRow( int sourceRow, const QModelIndex& sourceParent ) const override;
 
 private:
-	QStringList m_groupList{};
-	QStringList m_computerExcludeList{};
+	bool filterAcceptsContainer( const QModelIndex& index ) const;
+	void invalidateContainerCache();
+
+	QSet<QString> m_groups{};
+	QSet<QString> m_excludedComputers{}; // case folded
 	bool m_excludeEmptyGroups{false};
 
+	// results for containers which otherwise would be evaluated recursively for each parent again
+	mutable QHash<QModelIndex, bool> m_containerCache{};
+
 };
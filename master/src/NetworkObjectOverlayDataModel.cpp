@@ -23,7 +23,6 @@
  */
 
 #include "NetworkObjectOverlayDataModel.h"
-#include "NetworkObjectModel.h"
 
 #if defined(QT_TESTLIB_LIB) && QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
 #include <QAbstractItemModelTester>
@@ -42,25 +41,41 @@ NetworkObjectOverlayDataModel::NetworkObjectOverlayDataModel( const QString& ove
 	new QAbstractItemModelTester( this, QAbstractItemModelTester::FailureReportingMode::Warning, this );
 #endif
 	appendColumn( overlayDataHeader );
+
+	// coalesce updates of many overlay data items (e.g. user names after connecting) into few signals
+	m_pendingChangesTimer.setSingleShot( true );
+	m_pendingChangesTimer.setInterval( 0 );
+	connect( &m_pendingChangesTimer, &QTimer::timeout, this, &NetworkObjectOverlayDataModel::emitPendingChanges );
 }
 
 
 
-QVariant NetworkObjectOverlayDataModel::extraColumnData(const QModelIndex &parent, int row, int extraColumn, int role) const
+QVariant NetworkObjectOverlayDataModel::data( const QModelIndex& index, int role ) const
 {
-	if( extraColumn != 0 || role != m_overlayDataRole )
+	if( extraColumnForProxyColumn( index.column() ) == 0 )
 	{
-		return {};
+		// avoid determining the parent index and the UID of the network object for each painted cell
+		if( role != m_overlayDataRole )
+		{
+			return {};
+		}
+
+		return m_overlayData.value( index.internalId() );
 	}
 
-	NetworkObject::Uid networkObjectUid = data( index( row, 0, parent ), NetworkObjectModel::UidRole ).toUuid();
+	return KExtraColumnsProxyModel::data( index, role );
+}
 
-	if( networkObjectUid.isNull() == false && m_overlayData.contains( networkObjectUid ) )
+
+
+QVariant NetworkObjectOverlayDataModel::extraColumnData(const QModelIndex &parent, int row, int extraColumn, int role) const
+{
+	if( extraColumn != 0 || role != m_overlayDataRole )
 	{
-		return m_overlayData[networkObjectUid];
+		return {};
 	}
 
-	return {};
+	return m_overlayData.value( index( row, proxyColumnForExtraColumn( extraColumn ), parent ).internalId() );
 }
 
 
@@ -71,13 +86,45 @@ bool NetworkObjectOverlayDataModel::setExtraColumnData( const QModelIndex &paren
 		return false;
 	}
 
-	const auto networkObjectUid = KExtraColumnsProxyModel::data( index( row, 0, parent ), NetworkObjectModel::UidRole ).toUuid();
+	auto& overlayData = m_overlayData[index( row, proxyColumnForExtraColumn( extraColumn ), parent ).internalId()];
 
-	if( m_overlayData[networkObjectUid] != data )
+	if( overlayData != data )
 	{
-		m_overlayData[networkObjectUid] = data;
-		extraColumnDataChanged( parent, row, extraColumn, { m_overlayDataRole } );
+		overlayData = data;
+
+		const auto it = m_pendingChanges.find( parent );
+		if( it == m_pendingChanges.end() )
+		{
+			m_pendingChanges.insert( parent, { row, row } );
+		}
+		else
+		{
+			it->first = qMin( it->first, row );
+			it->second = qMax( it->second, row );
+		}
+
+		m_pendingChangesTimer.start();
 	}
 
 	return true;
 }
+
+
+
+void NetworkObjectOverlayDataModel::emitPendingChanges()
+{
+	const auto column = proxyColumnForExtraColumn( 0 );
+	const auto pendingChanges = m_pendingChanges;
+	m_pendingChanges.clear();
+
+	for( auto it = pendingChanges.constBegin(), end = pendingChanges.constEnd(); it != end; ++it )
+	{
+		// rows may have been removed in the meantime
+		const auto lastRow = qMin( it->second, rowCount( it.key() ) - 1 );
+		if( it->first <= lastRow )
+		{
+			Q_EMIT dataChanged( index( it->first, column, it.key() ), index( lastRow, column, it.key() ),
+								{ m_overlayDataRole } );
+		}
+	}
+}
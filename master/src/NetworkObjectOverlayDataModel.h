@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <QTimer>
+
 #include "KExtraColumnsProxyModel.h"
 #include "NetworkObject.h"
 
@@ -34,13 +36,24 @@ public:
 	explicit NetworkObjectOverlayDataModel( const QString& overlayDataHeader,
 								   QObject *parent = nullptr );
 
+	QVariant data( const QModelIndex& index, int role ) const override;
+
 	QVariant extraColumnData( const QModelIndex &parent, int row, int extraColumn, int role ) const override;
 
 	bool setExtraColumnData( const QModelIndex &parent, int row, int extraColumn, const QVariant &data, int role ) override;
 
 
 private:
+	void emitPendingChanges();
+
 	int m_overlayDataRole;
-	QHash<NetworkObject::Uid, QVariant> m_overlayData;
+
+	// overlay data by internal ID of the proxy index which (as with NetworkObjectModel as source model)
+	// identifies the network object and therefore allows lookups without querying the source model
+	QHash<quintptr, QVariant> m_overlayData{};
+
+	// changed row ranges per parent which are announced at once after all pending updates
+	QHash<QPersistentModelIndex, QPair<int, int>> m_pendingChanges{};
+	QTimer m_pendingChangesTimer{this};
 
 };
@@ -76,12 +76,20 @@ ScreenshotManagementPanel::~ScreenshotManagementPanel()
 
 void ScreenshotManagementPanel::setPreview( const Screenshot& screenshot )
 {
-	ui->previewLbl->setPixmap( QPixmap::fromImage( screenshot.image() ) );
+	setPreview( QPixmap::fromImage( screenshot.image() ),
+				{ screenshot.user(), screenshot.host(), screenshot.date(), screenshot.time() } );
+}
+
+
+
+void ScreenshotManagementPanel::setPreview( const QPixmap& pixmap, const ScreenshotCatalog::Entry& entry )
+{
+	ui->previewLbl->setPixmap( pixmap );
 
-	ui->userLbl->setText( screenshot.user() );
-	ui->hostLbl->setText( screenshot.host() );
-	ui->dateLbl->setText( screenshot.date() );
-	ui->timeLbl->setText( screenshot.time() );
+	ui->userLbl->setText( entry.user );
+	ui->hostLbl->setText( entry.host );
+	ui->dateLbl->setText( entry.date );
+	ui->timeLbl->setText( entry.time );
 }
 
 
@@ -102,9 +110,11 @@ void ScreenshotManagementPanel::updateModel()
 {
 	const auto currentFile = m_model.data( ui->list->currentIndex(), Qt::DisplayRole ).toString();
 
-	const QDir dir{ VeyonCore::filesystem().screenshotDirectoryPath() };
-	const auto files = dir.entryList( { QStringLiteral("*.png") },
-									  QDir::Filter::Files, QDir::SortFlag::Name );
+	const auto files = m_catalog.update();
+	if( files == m_model.stringList() )
+	{
+		return;
+	}
 
 	m_model.setStringList( files );
 
@@ -122,7 +132,9 @@ QString ScreenshotManagementPanel::filePath( const QModelIndex& index ) const
 
 void ScreenshotManagementPanel::updateScreenshot( const QModelIndex& index )
 {
-	setPreview( Screenshot( filePath( index ) ) );
+	// metadata is taken from the catalog so only the selected screenshot itself has to be loaded
+	setPreview( QPixmap( filePath( index ) ),
+				m_catalog.entry( m_model.data( index, Qt::DisplayRole ).toString() ) );
 }
 
 
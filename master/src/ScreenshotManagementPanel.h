@@ -29,6 +29,8 @@
 #include <QTimer>
 #include <QWidget>
 
+#include "ScreenshotCatalog.h"
+
 class QModelIndex;
 class Screenshot;
 
@@ -49,6 +51,8 @@ protected:
 	void resizeEvent( QResizeEvent* event ) override;
 
 private:
+	void setPreview( const QPixmap& pixmap, const ScreenshotCatalog::Entry& entry );
+
 	void updateModel();
 
 	QString filePath( const QModelIndex& index ) const;
@@ -61,6 +65,7 @@ private:
 
 	Ui::ScreenshotManagementPanel* ui;
 
+	ScreenshotCatalog m_catalog{this};
 	QStringListModel m_model{this};
 	QFileSystemWatcher m_fsWatcher{this};
 
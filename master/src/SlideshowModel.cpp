@@ -53,6 +53,17 @@ SlideshowModel::SlideshowModel( QAbstractItemModel* sourceModel, QObject* parent
 			 } );
 
 	connect( &m_timer, &QTimer::timeout, this, &SlideshowModel::showNext );
+
+	m_prefetchTimer.setSingleShot( true );
+	connect( &m_prefetchTimer, &QTimer::timeout, this, &SlideshowModel::prefetchNext );
+}
+
+
+
+SlideshowModel::~SlideshowModel()
+{
+	m_timer.stop();
+	updateStreams();
 }
 
 
@@ -104,6 +115,11 @@ void SlideshowModel::setRunning( bool running, int duration )
 	{
 		m_timer.start();
 	}
+
+	m_prefetchTimer.stop();
+	m_prefetchedControlInterface.clear();
+
+	updateStreams();
 }
 
 
@@ -116,9 +132,7 @@ void SlideshowModel::showPrevious()
 	{
 		setCurrentRow( m_currentRow - 1 );
 
-		if( m_currentControlInterface &&
-			m_currentControlInterface->state() == ComputerControlInterface::State::Connected &&
-			m_currentControlInterface->hasValidFramebuffer() )
+		if( isShowable( m_currentControlInterface ) )
 		{
 			valid = true;
 			break;
@@ -136,6 +150,11 @@ void SlideshowModel::showPrevious()
 		m_timer.stop();
 		m_timer.start();
 	}
+
+	m_prefetchTimer.stop();
+	m_prefetchedControlInterface.clear();
+
+	updateStreams();
 }
 
 
@@ -148,9 +167,7 @@ void SlideshowModel::showNext()
 	{
 		setCurrentRow( m_currentRow + 1 );
 
-		if( m_currentControlInterface &&
-			m_currentControlInterface->state() == ComputerControlInterface::State::Connected &&
-			m_currentControlInterface->hasValidFramebuffer() )
+		if( isShowable( m_currentControlInterface ) )
 		{
 			valid = true;
 			break;
@@ -168,6 +185,11 @@ void SlideshowModel::showNext()
 		m_timer.stop();
 		m_timer.start();
 	}
+
+	m_prefetchTimer.stop();
+	m_prefetchedControlInterface.clear();
+
+	updateStreams();
 }
 
 
@@ -200,3 +222,88 @@ void SlideshowModel::setCurrentRow( int row )
 
 	invalidateFilter();
 }
+
+
+
+ComputerControlInterface::Pointer SlideshowModel::nextControlInterface() const
+{
+	const auto rowCount = sourceModel()->rowCount();
+
+	for( int i = 1; i <= rowCount; ++i )
+	{
+		const auto controlInterface = sourceModel()->data( sourceModel()->index( ( m_currentRow + i ) % rowCount, 0 ),
+														   ComputerListModel::ControlInterfaceRole )
+										  .value<ComputerControlInterface::Pointer>();
+		if( isShowable( controlInterface ) )
+		{
+			return controlInterface;
+		}
+	}
+
+	return {};
+}
+
+
+
+bool SlideshowModel::isShowable( const ComputerControlInterface::Pointer& controlInterface )
+{
+	return controlInterface &&
+		   controlInterface->state() == ComputerControlInterface::State::Connected &&
+		   controlInterface->hasValidFramebuffer();
+}
+
+
+
+void SlideshowModel::prefetchNext()
+{
+	m_prefetchedControlInterface = nextControlInterface();
+
+	updateStreams();
+}
+
+
+
+void SlideshowModel::updateStreams()
+{
+	if( m_timer.isActive() == false )
+	{
+		m_prefetchTimer.stop();
+		m_prefetchedControlInterface.clear();
+	}
+	else if( m_prefetchTimer.isActive() == false && m_prefetchedControlInterface.isNull() )
+	{
+		// request full resolution updates of the next computer shortly before switching to it
+		m_prefetchTimer.start( qMax( 0, m_timer.interval() - PrefetchLeadTime ) );
+	}
+
+	// only the computer currently shown and the next one are streamed at full resolution and rate
+	ComputerControlInterfaceList liveControlInterfaces;
+	if( m_timer.isActive() )
+	{
+		for( const auto& controlInterface : { m_currentControlInterface, m_prefetchedControlInterface } )
+		{
+			if( controlInterface && liveControlInterfaces.contains( controlInterface ) == false )
+			{
+				liveControlInterfaces.append( controlInterface );
+			}
+		}
+	}
+
+	for( const auto& controlInterface : qAsConst(m_liveControlInterfaces) )
+	{
+		if( liveControlInterfaces.contains( controlInterface ) == false )
+		{
+			controlInterface->setUpdateMode( ComputerControlInterface::UpdateMode::Monitoring );
+		}
+	}
+
+	for( const auto& controlInterface : qAsConst(liveControlInterfaces) )
+	{
+		if( m_liveControlInterfaces.contains( controlInterface ) == false )
+		{
+			controlInterface->setUpdateMode( ComputerControlInterface::UpdateMode::Live );
+		}
+	}
+
+	m_liveControlInterfaces = liveControlInterfaces;
+}
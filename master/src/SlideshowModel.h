@@ -34,6 +34,7 @@ class SlideshowModel : public QSortFilterProxyModel
 	Q_OBJECT
 public:
 	SlideshowModel( QAbstractItemModel* sourceModel, QObject* parent = nullptr );
+	~SlideshowModel() override;
 
 	void setIconSize( QSize size );
 
@@ -49,12 +50,23 @@ protected:
 
 private:
 	void setCurrentRow( int row );
+	ComputerControlInterface::Pointer nextControlInterface() const;
+	static bool isShowable( const ComputerControlInterface::Pointer& controlInterface );
+
+	void prefetchNext();
+	void updateStreams();
+
+	// time before switching to next computer at which its full resolution stream is requested
+	static constexpr int PrefetchLeadTime = 2000;
 
 	QSize m_iconSize;
 
 	QTimer m_timer;
+	QTimer m_prefetchTimer;
 
 	int m_currentRow{0};
 	ComputerControlInterface::Pointer m_currentControlInterface;
+	ComputerControlInterface::Pointer m_prefetchedControlInterface;
+	ComputerControlInterfaceList m_liveControlInterfaces;
 
 };
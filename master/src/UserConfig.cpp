@@ -24,14 +24,32 @@
  */
 
 #include <QMessageBox>
+#include <QtConcurrent>
 
+#include "Configuration/JsonStore.h"
 #include "VeyonCore.h"
 #include "UserConfig.h"
 
 
 UserConfig::UserConfig( Configuration::Store::Backend backend ) :
-	Configuration::Object( backend, Configuration::Store::User, QStringLiteral("VeyonMaster") )
+	Configuration::Object( backend, Configuration::Store::User, QStringLiteral("VeyonMaster") ),
+	m_persistedData( data() )
 {
+	if( backend == Configuration::Store::JsonFile )
+	{
+		// determine path once as resolving it may access the (possibly remote) user profile
+		Configuration::JsonStore store( Configuration::Store::User );
+		store.setName( QStringLiteral("VeyonMaster") );
+		m_filePath = store.configurationFilePath();
+	}
+
+	// save changes in the background shortly after the last modification so checking
+	// items or moving computers never blocks the UI on slow (network) user profiles
+	m_persistTimer.setSingleShot( true );
+	m_persistTimer.setInterval( PersistDelay );
+	connect( &m_persistTimer, &QTimer::timeout, this, &UserConfig::persist );
+	connect( this, &UserConfig::configurationChanged, &m_persistTimer, QOverload<>::of(&QTimer::start) );
+
 	if( isStoreWritable() == false )
 	{
 		QMessageBox::information( nullptr,
@@ -41,3 +59,55 @@ UserConfig::UserConfig( Configuration::Store::Backend backend ) :
 									  "file path using the %1 Configurator." ).arg( VeyonCore::applicationName() ) );
 	}
 }
+
+
+
+UserConfig::~UserConfig()
+{
+	m_persistFuture.waitForFinished();
+}
+
+
+
+void UserConfig::flush()
+{
+	m_persistTimer.stop();
+	m_persistFuture.waitForFinished();
+
+	flushStore();
+
+	m_persistedData = data();
+}
+
+
+
+void UserConfig::persist()
+{
+	if( m_persistFuture.isRunning() )
+	{
+		// retry once the current write has finished
+		m_persistTimer.start();
+		return;
+	}
+
+	const auto currentData = data();
+	if( currentData == m_persistedData )
+	{
+		return;
+	}
+
+	m_persistedData = currentData;
+
+	if( m_filePath.isEmpty() )
+	{
+		flushStore();
+		return;
+	}
+
+	m_persistFuture = QtConcurrent::run( [filePath = m_filePath, currentData]() {
+		if( Configuration::JsonStore::writeFile( filePath, Configuration::JsonStore::toJson( currentData ) ) == false )
+		{
+			vCritical() << "could not write to configuration file" << filePath;
+		}
+	} );
+}
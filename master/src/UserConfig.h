@@ -24,8 +24,10 @@
 
 #pragma once
 
+#include <QFuture>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QTimer>
 
 #include "Configuration/Object.h"
 #include "Configuration/Property.h"
@@ -40,6 +42,10 @@ class UserConfig : public Configuration::Object
 	Q_OBJECT
 public:
 	explicit UserConfig( Configuration::Store::Backend backend );
+	~UserConfig() override;
+
+	// waits for pending background writes and writes all changes synchronously
+	void flush();
 
 #define FOREACH_PERSONAL_CONFIG_PROPERTY(OP)						\
 	OP( UserConfig, VeyonMaster::userConfig(), QJsonArray, checkedNetworkObjects, setCheckedNetworkObjects, "CheckedNetworkObjects", "UI", QJsonArray(), Configuration::Property::Flag::Standard )	\
@@ -60,4 +66,14 @@ public:
 
 	FOREACH_PERSONAL_CONFIG_PROPERTY(DECLARE_CONFIG_PROPERTY)
 
+private:
+	static constexpr int PersistDelay = 2000;
+
+	void persist();
+
+	QString m_filePath;
+	QTimer m_persistTimer{};
+	DataMap m_persistedData{};
+	QFuture<void> m_persistFuture{};
+
 } ;
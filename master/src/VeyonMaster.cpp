@@ -83,7 +83,7 @@ VeyonMaster::~VeyonMaster()
 
 	delete m_computerManager;
 
-	m_userConfig->flushStore();
+	m_userConfig->flush();
 	delete m_userConfig;
 }
 
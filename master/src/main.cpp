@@ -28,6 +28,7 @@
 
 #include "DocumentationFigureCreator.h"
 #include "MainWindow.h"
+#include "MonitoringViewBenchmark.h"
 #include "VeyonConfiguration.h"
 #include "VeyonMaster.h"
 
@@ -38,6 +39,19 @@ int main( int argc, char** argv )
 
 	const auto modernUi = VeyonConfiguration().modernUserInterface();
 
+	if( modernUi )
+	{
+		// computer thumbnails are uploaded into the scene graph's texture atlas - make it large
+		// enough to hold a whole grid of thumbnails so they can be drawn in a few batches
+		for( const auto& variable : { "QSG_ATLAS_WIDTH", "QSG_ATLAS_HEIGHT" } )
+		{
+			if( qEnvironmentVariableIsSet( variable ) == false )
+			{
+				qputenv( variable, QByteArrayLiteral("4096") );
+			}
+		}
+	}
+
 	QGuiApplication* app = modernUi ? new QGuiApplication( argc, argv ) : new QApplication( argc, argv );
 
 	VeyonCore core( app, VeyonCore::Component::Master, QStringLiteral("Master") );
@@ -48,6 +62,16 @@ int main( int argc, char** argv )
 		DocumentationFigureCreator().run();
 		return 0;
 	}
+
+	if( qEnvironmentVariableIsSet( "VEYON_MASTER_BENCHMARK") )
+	{
+		if( MainWindow::initAuthentication() == false )
+		{
+			return -1;
+		}
+
+		return MonitoringViewBenchmark( qEnvironmentVariable( "VEYON_MASTER_BENCHMARK" ) ).run() ? 0 : -1;
+	}
 #endif
 
 	QSplashScreen* splashScreen = nullptr;
@@ -165,14 +165,13 @@ VncServerClient::AuthState AuthKeysPlugin::performAuthentication( VncServerClien
 
 		const auto publicKeyPath = m_manager.publicKeyPath( authKeyName );
 
-		CryptoCore::PublicKey publicKey( publicKeyPath );
+		auto publicKey = loadPublicKey( publicKeyPath );
 		if( publicKey.isNull() || publicKey.isPublic() == false )
 		{
 			vWarning() << "failed to load public key from" << publicKeyPath;
 			return VncServerClient::AuthState::Failed;
 		}
 
-		vDebug() << "loaded public key from" << publicKeyPath;
 		if( publicKey.verifyMessage( client->challenge(), signature, CryptoCore::DefaultSignatureAlgorithm ) == false )
 		{
 			vWarning() << "FAIL";
@@ -225,6 +224,39 @@ bool AuthKeysPlugin::authenticate( QIODevice* socket ) const
 
 
 
+CryptoCore::PublicKey AuthKeysPlugin::loadPublicKey( const QString& publicKeyFile ) const
+{
+	const QFileInfo fileInfo( publicKeyFile );
+	const auto lastModified = fileInfo.lastModified();
+	const auto size = fileInfo.size();
+
+	QMutexLocker locker( &m_publicKeyCacheMutex );
+
+	const auto it = m_publicKeyCache.constFind( publicKeyFile );
+	if( it != m_publicKeyCache.constEnd() &&
+		it->lastModified == lastModified &&
+		it->size == size )
+	{
+		// return a copy so the key can be used concurrently
+		return it->key;
+	}
+
+	CryptoCore::PublicKey publicKey( publicKeyFile );
+	if( publicKey.isNull() || publicKey.isPublic() == false )
+	{
+		m_publicKeyCache.remove( publicKeyFile );
+		return {};
+	}
+
+	vDebug() << "loaded public key from" << publicKeyFile;
+
+	m_publicKeyCache[publicKeyFile] = { lastModified, size, publicKey };
+
+	return publicKey;
+}
+
+
+
 QStringList AuthKeysPlugin::commands() const
 {
 	return m_commands.keys();
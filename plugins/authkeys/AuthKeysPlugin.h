@@ -24,6 +24,9 @@
 
 #pragma once
 
+#include <QDateTime>
+#include <QMutex>
+
 #include "AuthenticationPluginInterface.h"
 #include "AuthKeysConfiguration.h"
 #include "AuthKeysManager.h"
@@ -121,6 +124,7 @@ public Q_SLOTS:
 
 private:
 	bool loadPrivateKey( const QString& privateKeyFile );
+	CryptoCore::PublicKey loadPublicKey( const QString& publicKeyFile ) const;
 
 	void printAuthKeyTable();
 	static QString authKeysTableData( const AuthKeysTableModel& tableModel, int row, int column );
@@ -134,4 +138,14 @@ private:
 
 	QMap<QString, QString> m_commands;
 
+	// parsed public keys which are reloaded only if the key file has been modified
+	struct CachedPublicKey
+	{
+		QDateTime lastModified;
+		qint64 size{-1};
+		CryptoCore::PublicKey key;
+	};
+	mutable QMutex m_publicKeyCacheMutex;
+	mutable QHash<QString, CachedPublicKey> m_publicKeyCache;
+
 };
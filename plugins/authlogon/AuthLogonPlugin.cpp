@@ -27,6 +27,7 @@
 
 #include "AuthLogonPlugin.h"
 #include "AuthLogonDialog.h"
+#include "AuthenticationCredentialCache.h"
 #include "PlatformUserFunctions.h"
 #include "VariantArrayMessage.h"
 
@@ -120,8 +121,16 @@ VncServerClient::AuthState AuthLogonPlugin::performAuthentication( VncServerClie
 
 		vInfo() << "authenticating user" << client->username();
 
+		if( AuthenticationCredentialCache::contains( name(), client->username(), decryptedPassword ) )
+		{
+			vDebug() << "SUCCESS (cached)";
+			return VncServerClient::AuthState::Successful;
+		}
+
 		if( VeyonCore::platform().userFunctions().authenticate( client->username(), decryptedPassword.toByteArray() ) )
 		{
+			AuthenticationCredentialCache::insert( name(), client->username(), decryptedPassword );
+
 			vDebug() << "SUCCESS";
 			return VncServerClient::AuthState::Successful;
 		}
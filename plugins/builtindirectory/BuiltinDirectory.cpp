@@ -67,7 +67,7 @@ void BuiltinDirectory::update()
 
 void BuiltinDirectory::updateLocation( const NetworkObject& locationObject, const QJsonArray& networkObjects )
 {
-	NetworkObjectUidList computerUids;
+	NetworkObjectList computerObjects;
 
 	for( const auto& networkObjectValue : networkObjects )
 	{
@@ -75,11 +75,9 @@ void BuiltinDirectory::updateLocation( const NetworkObject& locationObject, cons
 
 		if( networkObject.parentUid() == locationObject.uid() )
 		{
-			computerUids.append( networkObject.uid() ); // clazy:exclude=reserve-candidates
-			addOrUpdateObject( networkObject, locationObject );
+			computerObjects.append( networkObject ); // clazy:exclude=reserve-candidates
 		}
 	}
 
-	removeObjects( locationObject, [computerUids]( const NetworkObject& object ) {
-		return object.type() == NetworkObject::Type::Host && computerUids.contains( object.uid() ) == false; } );
+	replaceObjects( computerObjects, locationObject );
 }
@@ -579,6 +579,9 @@ bool BuiltinDirectoryPlugin::importFile( QFile& inputFile,
 										 const QString& regExWithPlaceholders,
 										 const QString& location )
 {
+	QStringList placeholders;
+	const auto regEx = compileImportRegularExpression( regExWithPlaceholders, placeholders );
+
 	int lineCount = 0;
 	QMap<QString, NetworkObjectList > networkObjects;
 	while( inputFile.atEnd() == false )
@@ -588,7 +591,7 @@ bool BuiltinDirectoryPlugin::importFile( QFile& inputFile,
 		auto targetLocation = location;
 
 		const auto line = inputFile.readLine();
-		const auto networkObject = toNetworkObject( QString::fromUtf8( line ), regExWithPlaceholders, targetLocation );
+		const auto networkObject = toNetworkObject( QString::fromUtf8( line ), regEx, placeholders, targetLocation );
 
 		if( networkObject.isValid() )
 		{
@@ -618,15 +621,20 @@ bool BuiltinDirectoryPlugin::importFile( QFile& inputFile,
 			parentLocationUid = parentLocation.uid();
 		}
 
+		NetworkObjectList locationObjects;
+		locationObjects.reserve( it.value().count() );
+
 		for( const NetworkObject& networkObject : qAsConst(it.value()) )
 		{
-			objectManager.update( NetworkObject( nullptr,
-												 networkObject.type(),
-												 networkObject.name(),
-												 networkObject.properties(),
-												 {},
-												 parentLocationUid ), true );
+			locationObjects.append( NetworkObject( nullptr,
+												   networkObject.type(),
+												   networkObject.name(),
+												   networkObject.properties(),
+												   {},
+												   parentLocationUid ) );
 		}
+
+		objectManager.update( locationObjects, true );
 	}
 
 	m_configuration.setNetworkObjects( objectManager.objects() );
@@ -648,6 +656,19 @@ bool BuiltinDirectoryPlugin::exportFile( QFile& outputFile, const QString& forma
 		locationObject = objectManager.findByName( location );
 	}
 
+	QHash<NetworkObject::Uid, QString> locationNames;
+	if( locationObject.isValid() == false )
+	{
+		for( const auto& networkObjectValue : networkObjects )
+		{
+			const NetworkObject networkObject{networkObjectValue.toObject()};
+			if( networkObject.type() == NetworkObject::Type::Location )
+			{
+				locationNames[networkObject.uid()] = networkObject.name();
+			}
+		}
+	}
+
 	QStringList lines;
 	lines.reserve( networkObjects.count() );
 
@@ -666,7 +687,7 @@ bool BuiltinDirectoryPlugin::exportFile( QFile& outputFile, const QString& forma
 		}
 		else
 		{
-			currentLocation = objectManager.findByUid( networkObject.parentUid() ).name();
+			currentLocation = locationNames.value( networkObject.parentUid() );
 		}
 
 		lines.append( toFormattedString( networkObject, formatString, currentLocation ) );
@@ -697,10 +718,11 @@ NetworkObject BuiltinDirectoryPlugin::findNetworkObject( const QString& uidOrNam
 
 
 
-NetworkObject BuiltinDirectoryPlugin::toNetworkObject( const QString& line, const QString& regExWithPlaceholders,
-													   QString& location )
+QRegularExpression BuiltinDirectoryPlugin::compileImportRegularExpression( const QString& regExWithPlaceholders,
+																		  QStringList& placeholders )
 {
-	QStringList placeholders;
+	placeholders.clear();
+
 	auto varDetectionMatchIterator = QRegularExpression{ QStringLiteral("\\((%\\w+%):[^)]+\\)") }.globalMatch( regExWithPlaceholders );
 
 	while( varDetectionMatchIterator.hasNext() )
@@ -714,7 +736,18 @@ NetworkObject BuiltinDirectoryPlugin::toNetworkObject( const QString& line, cons
 		rxString.replace( QStringLiteral("%1:").arg( var ), QString() );
 	}
 
-	auto match = QRegularExpression( rxString ).match( line );
+	QRegularExpression regEx( rxString );
+	regEx.optimize();
+
+	return regEx;
+}
+
+
+
+NetworkObject BuiltinDirectoryPlugin::toNetworkObject( const QString& line, const QRegularExpression& regEx,
+													   const QStringList& placeholders, QString& location )
+{
+	auto match = regEx.match( line );
 	if( match.hasMatch() )
 	{
 		auto objectType = NetworkObject::Type::Host;
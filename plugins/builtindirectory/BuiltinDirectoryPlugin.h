@@ -31,6 +31,7 @@
 #include "NetworkObjectDirectoryPluginInterface.h"
 
 class QFile;
+class QRegularExpression;
 
 class BuiltinDirectoryPlugin : public QObject,
 		PluginInterface,
@@ -130,7 +131,10 @@ private:
 
 	NetworkObject findNetworkObject( const QString& uidOrName ) const;
 
-	static NetworkObject toNetworkObject( const QString& line, const QString& regExWithVariables, QString& location );
+	static QRegularExpression compileImportRegularExpression( const QString& regExWithPlaceholders,
+															  QStringList& placeholders );
+	static NetworkObject toNetworkObject( const QString& line, const QRegularExpression& regEx,
+										  const QStringList& placeholders, QString& location );
 	static QString toFormattedString( const NetworkObject& networkObject, const QString& formatString, const QString& location );
 
 	static QStringList importExportPlaceholders();
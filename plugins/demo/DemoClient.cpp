@@ -28,10 +28,13 @@
 #include "DemoClient.h"
 #include "LockWidget.h"
 #include "PlatformCoreFunctions.h"
+#include "VncConnection.h"
+#include "VncViewQuickWidget.h"
 #include "VncViewWidget.h"
 
 
-DemoClient::DemoClient( const QString& host, int port, bool fullscreen, QRect viewport, QObject* parent ) :
+DemoClient::DemoClient( const QString& host, int port, bool fullscreen, QRect viewport,
+						bool hardwareAccelerated, QObject* parent ) :
 	QObject( parent ),
 	m_computerControlInterface( ComputerControlInterface::Pointer::create( Computer( {}, host, host ), port, this ) )
 {
@@ -51,10 +54,23 @@ DemoClient::DemoClient( const QString& host, int port, bool fullscreen, QRect vi
 	m_toplevel->setAttribute( Qt::WA_DeleteOnClose, false );
 	m_toplevel->installEventFilter(this);
 
-	m_vncView = new VncViewWidget( m_computerControlInterface, viewport, m_toplevel );
+	if( hardwareAccelerated )
+	{
+		auto vncView = new VncViewQuickWidget( m_computerControlInterface, viewport, m_toplevel );
+		connect( vncView, &VncViewQuickWidget::sizeHintChanged, this, &DemoClient::resizeToplevelWidget );
+		m_vncView = vncView;
+	}
+	else
+	{
+		auto vncView = new VncViewWidget( m_computerControlInterface, viewport, m_toplevel );
+		connect( vncView, &VncViewWidget::sizeHintChanged, this, &DemoClient::resizeToplevelWidget );
+		m_vncView = vncView;
+	}
+
+	// let the demo server only send updates for the area we're showing
+	m_computerControlInterface->vncConnection()->setFramebufferUpdateRegion( viewport );
 
 	connect( m_toplevel, &QObject::destroyed, this, &DemoClient::viewDestroyed );
-	connect( m_vncView, &VncViewWidget::sizeHintChanged, this, &DemoClient::resizeToplevelWidget );
 
 	if (fullscreen == false)
 	{
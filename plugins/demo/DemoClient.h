@@ -28,13 +28,12 @@
 
 #include "ComputerControlInterface.h"
 
-class VncViewWidget;
-
 class DemoClient : public QObject
 {
 	Q_OBJECT
 public:
-	DemoClient( const QString& host, int port, bool fullscreen, QRect viewport, QObject* parent = nullptr );
+	DemoClient( const QString& host, int port, bool fullscreen, QRect viewport,
+				bool hardwareAccelerated, QObject* parent = nullptr );
 	~DemoClient() override;
 
 protected:
@@ -47,6 +46,6 @@ private:
 	QWidget* m_toplevel{nullptr};
 
 	ComputerControlInterface::Pointer m_computerControlInterface;
-	VncViewWidget* m_vncView{nullptr};
+	QWidget* m_vncView{nullptr};
 
 } ;
@@ -33,6 +33,8 @@
 	OP( DemoConfiguration, m_configuration, int, framebufferUpdateInterval, setFramebufferUpdateInterval, "FramebufferUpdateInterval", "Demo", 100, Configuration::Property::Flag::Advanced )	\
 	OP( DemoConfiguration, m_configuration, int, keyFrameInterval, setKeyFrameInterval, "KeyFrameInterval", "Demo", 10, Configuration::Property::Flag::Advanced )	\
 	OP( DemoConfiguration, m_configuration, int, memoryLimit, setMemoryLimit, "MemoryLimit", "Demo", 128, Configuration::Property::Flag::Advanced )	\
+	OP( DemoConfiguration, m_configuration, bool, hardwareAcceleratedClient, setHardwareAcceleratedClient, "HardwareAcceleratedClient", "Demo", false, Configuration::Property::Flag::Advanced )	\
+	OP( DemoConfiguration, m_configuration, QString, recordingDirectory, setRecordingDirectory, "RecordingDirectory", "Demo", QString(), Configuration::Property::Flag::Advanced )	\
 
 // clazy:excludeall=missing-qobject-macro
 
@@ -426,7 +426,8 @@ bool DemoFeaturePlugin::handleFeatureMessage( VeyonWorkerInterface& worker, cons
 				const auto viewport = message.argument( Argument::Viewport ).toRect();
 
 				vDebug() << "connecting with master" << demoServerHost;
-				m_demoClient = new DemoClient( demoServerHost, demoServerPort, isFullscreenDemo, viewport );
+				m_demoClient = new DemoClient( demoServerHost, demoServerPort, isFullscreenDemo, viewport,
+											  m_configuration.hardwareAcceleratedClient() );
 			}
 			return true;
 
@@ -26,10 +26,12 @@
 #include "rfb/rfbproto.h"
 
 #include <QTcpSocket>
+#include <QThread>
 
 #include "DemoConfiguration.h"
 #include "DemoServer.h"
 #include "DemoServerConnection.h"
+#include "RfbRecording.h"
 #include "VncClientProtocol.h"
 
 
@@ -65,6 +67,13 @@ DemoServer::DemoServer( int vncServerPort, const Password& vncServerPassword, co
 
 DemoServer::~DemoServer()
 {
+	for( auto thread : qAsConst(m_senderThreads) )
+	{
+		thread->quit();
+		thread->wait( ConnectionThreadWaitTime );
+	}
+
+	delete m_recording;
 	delete m_vncClientProtocol;
 	delete m_vncServerSocket;
 }
@@ -75,21 +84,19 @@ void DemoServer::terminate()
 {
 	m_vncServerSocket->disconnect( this );
 
-	const auto connections = findChildren<DemoServerConnection *>();
-	if( connections.isEmpty() )
+	QMutexLocker locker( &m_connectionsMutex );
+
+	if( m_connections.isEmpty() )
 	{
 		deleteLater();
 	}
 	else
 	{
-		for( auto connection : connections )
+		// connections unregister themselves when being destroyed so it's safe to
+		// post events to all of them as long as the mutex is locked
+		for( auto connection : qAsConst(m_connections) )
 		{
-			connection->quit();
-		}
-
-		for( auto connection : connections )
-		{
-			connection->wait( ConnectionThreadWaitTime );
+			QMetaObject::invokeMethod( connection, &QObject::deleteLater, Qt::QueuedConnection );
 		}
 
 		QTimer::singleShot( TerminateRetryInterval, this, &DemoServer::terminate );
@@ -98,25 +105,17 @@ void DemoServer::terminate()
 
 
 
-const QByteArray& DemoServer::serverInitMessage() const
+void DemoServer::removeConnection( DemoServerConnection* connection )
 {
-	return m_vncClientProtocol->serverInitMessage();
+	QMutexLocker locker( &m_connectionsMutex );
+	m_connections.removeAll( connection );
 }
 
 
 
-void DemoServer::lockDataForRead()
+const QByteArray& DemoServer::serverInitMessage() const
 {
-	QElapsedTimer readLockTimer;
-	readLockTimer.restart();
-
-	m_dataLock.lockForRead();
-
-	if( readLockTimer.elapsed() > 100 )
-	{
-		vDebug() << "locking for read took" << readLockTimer.elapsed() << "ms in thread"
-				 << QThread::currentThreadId();
-	}
+	return m_vncClientProtocol->serverInitMessage();
 }
 
 
@@ -139,12 +138,44 @@ void DemoServer::acceptPendingConnections()
 {
 	while( m_pendingConnections.isEmpty() == false )
 	{
-		new DemoServerConnection( this, m_authentication, m_pendingConnections.takeFirst() );
+		auto connection = new DemoServerConnection( this, m_authentication, m_pendingConnections.takeFirst() );
+
+		m_connectionsMutex.lock();
+		m_connections.append( connection );
+		m_connectionsMutex.unlock();
+
+		connection->moveToThread( senderThread() );
+		QMetaObject::invokeMethod( connection, &DemoServerConnection::start, Qt::QueuedConnection );
 	}
 }
 
 
 
+QThread* DemoServer::senderThread()
+{
+	if( m_senderThreads.size() < qBound( 1, QThread::idealThreadCount(), int(MaximumSenderThreads) ) )
+	{
+		auto thread = new QThread( this );
+		thread->start();
+		m_senderThreads.append( thread );
+		return thread;
+	}
+
+	m_nextSenderThread = ( m_nextSenderThread + 1 ) % m_senderThreads.size();
+
+	return m_senderThreads[m_nextSenderThread];
+}
+
+
+
+int DemoServer::connectionCount() const
+{
+	QMutexLocker locker( &m_connectionsMutex );
+	return m_connections.count();
+}
+
+
+
 void DemoServer::reconnectToVncServer()
 {
 	m_vncClientProtocol->start();
@@ -184,22 +215,65 @@ void DemoServer::requestFramebufferUpdate()
 		return;
 	}
 
-	if( m_requestFullFramebufferUpdate ||
+	const auto updateRegion = requestedRegion();
+	if( updateRegion != m_updateRegion )
+	{
+		// start a new key frame which covers the changed area completely
+		vDebug() << "update region changed to" << updateRegion;
+		m_updateRegion = updateRegion;
+		m_requestFullFramebufferUpdate = true;
+	}
+
+	if( m_recording && m_recordingKeyFrameRequested == false &&
+		( m_lastRecordingKeyFrame.isValid() == false || m_lastRecordingKeyFrame.elapsed() >= m_keyFrameInterval ) )
+	{
+		// the preferred encodings keep compression state across messages so their updates
+		// can't be decoded on their own - temporarily switch to stateless encodings in order
+		// to get a key frame the recording can be seeked to
+		vDebug() << "Requesting key frame for recording";
+		m_recordingKeyFrameRequested = true;
+		setVncServerEncodings( m_quality );
+		m_vncClientProtocol->requestFramebufferUpdate( QRect( 0, 0, m_vncClientProtocol->framebufferWidth(),
+															  m_vncClientProtocol->framebufferHeight() ), false );
+		m_lastFullFramebufferUpdate.restart();
+		m_requestFullFramebufferUpdate = false;
+	}
+	else if( m_requestFullFramebufferUpdate ||
 		m_lastFullFramebufferUpdate.elapsed() >= m_keyFrameInterval )
 	{
 		vDebug() << "Requesting full framebuffer update";
-		m_vncClientProtocol->requestFramebufferUpdate( false );
+		m_vncClientProtocol->requestFramebufferUpdate( m_updateRegion, false );
 		m_lastFullFramebufferUpdate.restart();
 		m_requestFullFramebufferUpdate = false;
 	}
 	else
 	{
-		m_vncClientProtocol->requestFramebufferUpdate( true );
+		m_vncClientProtocol->requestFramebufferUpdate( m_updateRegion, true );
 	}
 }
 
 
 
+QRect DemoServer::requestedRegion() const
+{
+	const QRect framebufferRect( 0, 0, m_vncClientProtocol->framebufferWidth(), m_vncClientProtocol->framebufferHeight() );
+
+	// all connections share the same updates so request the area covering the viewports of all clients
+	QRect region;
+	m_connectionsMutex.lock();
+	for( const auto* connection : qAsConst(m_connections) )
+	{
+		region |= connection->requestedRegion();
+	}
+	m_connectionsMutex.unlock();
+
+	region &= framebufferRect;
+
+	return region.isEmpty() ? framebufferRect : region;
+}
+
+
+
 bool DemoServer::receiveVncServerMessage()
 {
 	if( m_vncClientProtocol->receiveMessage() )
@@ -223,32 +297,31 @@ bool DemoServer::receiveVncServerMessage()
 
 void DemoServer::enqueueFramebufferUpdateMessage( const QByteArray& message )
 {
-	QElapsedTimer writeLockTime;
-	writeLockTime.start();
+	const auto lastUpdatedRect = m_vncClientProtocol->lastUpdatedRect();
+
+	// updates with CopyRect rects (e.g. from scrolling or moving windows) must not start a new
+	// segment list as clients starting with them would copy from undefined framebuffer contents
+	const bool isFullUpdate = ( lastUpdatedRect.contains( m_updateRegion ) &&
+								m_vncClientProtocol->lastUpdateContainsCopyRect() == false );
 
-	m_dataLock.lockForWrite();
+	const auto queueSize = m_framebufferUpdateQueueSize;
 
-	if( writeLockTime.elapsed() > 10 )
+	// clients start with the first segment of a list so it always has to contain a full update
+	if( isFullUpdate == false && m_lastSegment == nullptr )
 	{
-		vDebug() << "locking for write took" << writeLockTime.elapsed() << "ms";
+		m_requestFullFramebufferUpdate = true;
+		return;
 	}
 
-	const auto lastUpdatedRect = m_vncClientProtocol->lastUpdatedRect();
-
-	const bool isFullUpdate = ( lastUpdatedRect.x() == 0 && lastUpdatedRect.y() == 0 &&
-								lastUpdatedRect.width() == m_vncClientProtocol->framebufferWidth() &&
-								lastUpdatedRect.height() == m_vncClientProtocol->framebufferHeight() );
-
-	const auto queueSize = framebufferUpdateMessageQueueSize();
-
-	if( isFullUpdate || queueSize > m_memoryLimit*2 )
+	if( isFullUpdate )
 	{
 		if( m_keyFrameTimer.elapsed() > 1 )
 		{
 			const auto memTotal = queueSize / 1024;
 			const auto bandwidth = (memTotal * 1000) / m_keyFrameTimer.elapsed();
-			const auto clientCount = qMin(1, findChildren<DemoServerConnection *>().count());
-			const auto totalBandwidth = bandwidth * clientCount;
+			// every connection receives the same data so the uplink load scales with the number of clients
+			const auto clientCount = qMax(1, connectionCount());
+			const auto totalBandwidth = qMax<qint64>(1, bandwidth * clientCount);
 
 			auto newQuality = m_quality;
 			if (totalBandwidth > m_bandwidthLimit)
@@ -267,7 +340,7 @@ void DemoServer::enqueueFramebufferUpdateMessage( const QByteArray& message )
 				setVncServerEncodings(newQuality);
 			}
 
-			vDebug() << "message count:" << m_framebufferUpdateMessages.size()
+			vDebug() << "message count:" << m_framebufferUpdateMessageCount
 					 << "queue size (KB):" << memTotal
 					 << "total bandwidth (KB/s):" << totalBandwidth << "of" << m_bandwidthLimit
 					 << "bandwidth per client (KB/s):" << bandwidth
@@ -276,33 +349,58 @@ void DemoServer::enqueueFramebufferUpdateMessage( const QByteArray& message )
 		m_keyFrameTimer.restart();
 		++m_keyFrame;
 
-		m_framebufferUpdateMessages.clear();
+		// publish new list - connections still sending the previous list keep it alive on their own
+		m_lastSegment = std::make_shared<FramebufferUpdateSegment>( m_keyFrame, message );
+		std::atomic_store( &m_keyFrameSegment, m_lastSegment );
+
+		m_framebufferUpdateMessageCount = 0;
+		m_framebufferUpdateQueueSize = 0;
+	}
+	else
+	{
+		auto segment = std::make_shared<FramebufferUpdateSegment>( m_keyFrame, message );
+		std::atomic_store( &m_lastSegment->next, segment );
+		m_lastSegment = std::move(segment);
 	}
 
-	m_framebufferUpdateMessages.append( message );
+	if( m_recording )
+	{
+		// key frames of the recording have to cover the whole framebuffer, not just the requested region,
+		// and must not depend on compression state of previous messages
+		const QRect framebufferRect( 0, 0, m_vncClientProtocol->framebufferWidth(), m_vncClientProtocol->framebufferHeight() );
+		const auto coversFramebuffer = isFullUpdate && lastUpdatedRect.contains( framebufferRect );
+		const auto isKeyFrame = coversFramebuffer && m_vncClientProtocol->lastUpdateIsSelfContained();
 
-	m_dataLock.unlock();
+		m_recording->record( message, isKeyFrame );
 
-	// we're about to reach memory limits?
-	if( framebufferUpdateMessageQueueSize() > m_memoryLimit )
-	{
-		// then request a full update so we can clear our queue
-		m_requestFullFramebufferUpdate = true;
-	}
-}
+		if( isKeyFrame )
+		{
+			m_lastRecordingKeyFrame.restart();
+		}
 
+		if( m_recordingKeyFrameRequested && coversFramebuffer )
+		{
+			if( isKeyFrame == false )
+			{
+				vWarning() << "VNC server sent a non-seekable update for a recording key frame";
+				m_lastRecordingKeyFrame.restart();
+			}
 
+			// return to the preferred encodings
+			m_recordingKeyFrameRequested = false;
+			setVncServerEncodings( m_quality );
+		}
+	}
 
-qint64 DemoServer::framebufferUpdateMessageQueueSize() const
-{
-	qint64 size = 0;
+	++m_framebufferUpdateMessageCount;
+	m_framebufferUpdateQueueSize += message.size();
 
-	for( const auto& message : qAsConst( m_framebufferUpdateMessages ) )
+	// we're about to reach memory limits?
+	if( m_framebufferUpdateQueueSize > m_memoryLimit )
 	{
-		size += message.size();
+		// then request a full update so we can start a new list
+		m_requestFullFramebufferUpdate = true;
 	}
-
-	return size;
 }
 
 
@@ -314,6 +412,19 @@ void DemoServer::start()
 	setVncServerPixelFormat();
 	setVncServerEncodings(DefaultQuality);
 
+	// compressed encodings keep state across messages so each VNC server connection needs its own recording
+	delete m_recording;
+	m_recording = nullptr;
+	m_recordingKeyFrameRequested = false;
+	m_lastRecordingKeyFrame.invalidate();
+
+	const auto recordingDirectory = m_configuration.recordingDirectory();
+	if( recordingDirectory.isEmpty() == false )
+	{
+		m_recording = new RfbRecording( recordingDirectory, QStringLiteral("demo") );
+		m_recording->record( serverInitMessage() );
+	}
+
 	m_requestFullFramebufferUpdate = true;
 
 	requestFramebufferUpdate();
@@ -353,6 +464,18 @@ bool DemoServer::setVncServerEncodings(int quality)
 {
 	m_quality = quality;
 
+	if( m_recordingKeyFrameRequested )
+	{
+		// keep the recording seekable by encoding each rect on its own
+		return m_vncClientProtocol->
+				setEncodings( {
+								  rfbEncodingHextile,
+								  rfbEncodingRaw,
+								  rfbEncodingNewFBSize,
+								  rfbEncodingLastRect
+							  } );
+	}
+
 	return m_vncClientProtocol->
 			setEncodings( {
 							  rfbEncodingTight,
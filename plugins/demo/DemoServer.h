@@ -25,8 +25,10 @@
 
 #pragma once
 
+#include <memory>
+
 #include <QElapsedTimer>
-#include <QReadWriteLock>
+#include <QMutex>
 #include <QTcpServer>
 #include <QTimer>
 
@@ -34,8 +36,11 @@
 
 class DemoAuthentication;
 class DemoConfiguration;
+class DemoServerConnection;
 class QTcpServer;
 class QTcpSocket;
+class QThread;
+class RfbRecording;
 class VncClientProtocol;
 
 class DemoServer : public QTcpServer
@@ -43,7 +48,43 @@ class DemoServer : public QTcpServer
 	Q_OBJECT
 public:
 	using Password = CryptoCore::PlaintextPassword;
-	using MessageList = QVector<QByteArray>;
+
+	// immutable element of a singly linked list of framebuffer update messages shared
+	// by all connections - each key frame starts a new list, older lists are released
+	// as soon as the last connection moved on to a newer key frame
+	struct FramebufferUpdateSegment
+	{
+		using Pointer = std::shared_ptr<FramebufferUpdateSegment>;
+
+		FramebufferUpdateSegment( int keyFrame, const QByteArray& message ) :
+			keyFrame( keyFrame ),
+			message( message )
+		{
+		}
+
+		~FramebufferUpdateSegment()
+		{
+			// unlink segments iteratively as recursive destruction of long lists would overflow the stack -
+			// stop at segments still referenced elsewhere, e.g. by connections sending them
+			auto segment = std::atomic_exchange( &next, Pointer{} );
+			while( segment && segment.use_count() == 1 )
+			{
+				segment = std::atomic_exchange( &segment->next, Pointer{} );
+			}
+		}
+
+		FramebufferUpdateSegment( const FramebufferUpdateSegment& ) = delete;
+		FramebufferUpdateSegment& operator=( const FramebufferUpdateSegment& ) = delete;
+
+		Pointer nextSegment() const
+		{
+			return std::atomic_load( &next );
+		}
+
+		const int keyFrame;
+		const QByteArray message;
+		Pointer next{};
+	};
 
 	DemoServer( int vncServerPort, const Password& vncServerPassword, const DemoAuthentication& authentication,
 				const DemoConfiguration& configuration, int demoServerPort, QObject *parent );
@@ -58,40 +99,34 @@ public:
 
 	const QByteArray& serverInitMessage() const;
 
-	void lockDataForRead();
-
-	void unlockData()
-	{
-		m_dataLock.unlock();
-	}
-
-	int keyFrame() const
+	// returns first segment of the current key frame, safe to call from any thread
+	FramebufferUpdateSegment::Pointer keyFrameSegment() const
 	{
-		return m_keyFrame;
+		return std::atomic_load( &m_keyFrameSegment );
 	}
 
-	const MessageList& framebufferUpdateMessages() const
-	{
-		return m_framebufferUpdateMessages;
-	}
+	// called by connections when being destroyed, safe to call from any thread
+	void removeConnection( DemoServerConnection* connection );
 
 private:
 	void incomingConnection( qintptr socketDescriptor ) override;
 	void acceptPendingConnections();
+	QThread* senderThread();
+	int connectionCount() const;
 	void reconnectToVncServer();
 	void readFromVncServer();
 	void requestFramebufferUpdate();
+	QRect requestedRegion() const;
 
 	bool receiveVncServerMessage();
 	void enqueueFramebufferUpdateMessage( const QByteArray& message );
 
-	qint64 framebufferUpdateMessageQueueSize() const;
-
 	void start();
 	bool setVncServerPixelFormat();
 	bool setVncServerEncodings(int quality);
 
 	static constexpr auto ConnectionThreadWaitTime = 5000;
+	static constexpr auto MaximumSenderThreads = 4;
 	static constexpr auto TerminateRetryInterval = 1000;
 	static constexpr auto MinimumQuality = 0;
 	static constexpr auto DefaultQuality = 6;
@@ -104,18 +139,31 @@ private:
 	const int m_vncServerPort;
 
 	QList<quintptr> m_pendingConnections;
+
+	// connections are distributed across a few threads each serving many sockets
+	QVector<QThread *> m_senderThreads;
+	int m_nextSenderThread{0};
+	mutable QMutex m_connectionsMutex;
+	QList<DemoServerConnection *> m_connections;
 	QTcpSocket* m_vncServerSocket;
 	VncClientProtocol* m_vncClientProtocol;
 
-	QReadWriteLock m_dataLock{};
 	QTimer m_framebufferUpdateTimer{this};
 	QElapsedTimer m_lastFullFramebufferUpdate{};
 	QElapsedTimer m_keyFrameTimer{};
 	bool m_requestFullFramebufferUpdate{false};
+	QRect m_updateRegion{};
 
 	int m_keyFrame{0};
-	MessageList m_framebufferUpdateMessages{};
+	FramebufferUpdateSegment::Pointer m_keyFrameSegment{};
+	FramebufferUpdateSegment::Pointer m_lastSegment{};
+	int m_framebufferUpdateMessageCount{0};
+	qint64 m_framebufferUpdateQueueSize{0};
 	int m_quality = DefaultQuality;
 	int m_bandwidthLimit;
 
+	RfbRecording* m_recording{nullptr};
+	QElapsedTimer m_lastRecordingKeyFrame{};
+	bool m_recordingKeyFrameRequested{false};
+
 } ;
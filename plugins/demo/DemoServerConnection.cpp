@@ -25,18 +25,27 @@
 
 #include "rfb/rfbproto.h"
 
+#include <QMutexLocker>
 #include <QTcpSocket>
 
 #include "DemoConfiguration.h"
 #include "DemoServer.h"
 #include "DemoServerConnection.h"
 #include "FeatureMessage.h"
+#include "RfbContinuousUpdates.h"
+
+#include <array>
+
+#ifdef Q_OS_UNIX
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
 
 
 DemoServerConnection::DemoServerConnection( DemoServer* demoServer,
 											const DemoAuthentication& authentication,
 											quintptr socketDescriptor ) :
-	QThread( demoServer ),
+	QObject(),
 	m_authentication( authentication ),
 	m_demoServer( demoServer ),
 	m_socketDescriptor( socketDescriptor ),
@@ -48,12 +57,29 @@ DemoServerConnection::DemoServerConnection( DemoServer* demoServer,
 									 } ),
 	m_framebufferUpdateInterval( m_demoServer->configuration().framebufferUpdateInterval() )
 {
-	start();
 }
 
 
 
-void DemoServerConnection::run()
+DemoServerConnection::~DemoServerConnection()
+{
+	delete m_serverProtocol;
+	delete m_socket;
+
+	m_demoServer->removeConnection( this );
+}
+
+
+
+QRect DemoServerConnection::requestedRegion() const
+{
+	QMutexLocker locker( &m_requestedRegionMutex );
+	return m_requestedRegion;
+}
+
+
+
+void DemoServerConnection::start()
 {
 	vDebug() << m_socketDescriptor;
 
@@ -62,28 +88,17 @@ void DemoServerConnection::run()
 	if( m_socket->setSocketDescriptor( m_socketDescriptor ) == false )
 	{
 		vCritical() << "failed to set socket descriptor";
-		delete m_socket;
-		m_socket = nullptr;
 		deleteLater();
 		return;
 	}
 
-	connect( m_socket, &QTcpSocket::readyRead, this, &DemoServerConnection::processClient, Qt::DirectConnection );
-	connect( m_socket, &QTcpSocket::disconnected, this, &DemoServerConnection::quit );
+	connect( m_socket, &QTcpSocket::readyRead, this, &DemoServerConnection::processClient );
+	connect( m_socket, &QTcpSocket::disconnected, this, &QObject::deleteLater );
 
 	m_serverProtocol = new DemoServerProtocol( m_authentication, m_socket, &m_vncServerClient ),
 
 	m_serverProtocol->setServerInitMessage( m_demoServer->serverInitMessage() );
 	m_serverProtocol->start();
-
-	exec();
-
-	delete m_serverProtocol;
-	delete m_socket;
-
-	m_socket = nullptr;
-
-	deleteLater();
 }
 
 
@@ -122,19 +137,10 @@ bool DemoServerConnection::receiveClientMessage()
 	switch( messageType )
 	{
 	case rfbSetEncodings:
-		if( m_socket->bytesAvailable() >= sz_rfbSetEncodingsMsg )
-		{
-			rfbSetEncodingsMsg setEncodingsMessage;
-			if( m_socket->peek( reinterpret_cast<char *>( &setEncodingsMessage ), sz_rfbSetEncodingsMsg ) == sz_rfbSetEncodingsMsg )
-			{
-				const qint64 totalSize = sz_rfbSetEncodingsMsg + qFromBigEndian(setEncodingsMessage.nEncodings) * sizeof(uint32_t);
-				if( m_socket->bytesAvailable() >= totalSize )
-				{
-					return m_socket->read( totalSize ).size() == totalSize;
-				}
-			}
-		}
-		break;
+		return receiveSetEncodingsMessage();
+
+	case RfbContinuousUpdates::EnableMessageType:
+		return receiveEnableContinuousUpdatesMessage();
 
 	case FeatureMessage::RfbMessageType:
 	{
@@ -162,11 +168,19 @@ bool DemoServerConnection::receiveClientMessage()
 			return false;
 		}
 
-		m_socket->read( m_rfbClientToServerMessageSizes[messageType] );
+		const auto message = m_socket->read( m_rfbClientToServerMessageSizes[messageType] );
 
 		if( messageType == rfbFramebufferUpdateRequest )
 		{
-			sendFramebufferUpdate();
+			const auto request = reinterpret_cast<const rfbFramebufferUpdateRequestMsg *>( message.constData() );
+
+			setRequestedRegion( { qFromBigEndian( request->x ), qFromBigEndian( request->y ),
+								  qFromBigEndian( request->w ), qFromBigEndian( request->h ) } );
+
+			if( m_continuousUpdatesEnabled == false || request->incremental == 0 )
+			{
+				sendFramebufferUpdate();
+			}
 		}
 
 		return true;
@@ -177,34 +191,263 @@ bool DemoServerConnection::receiveClientMessage()
 
 
 
-void DemoServerConnection::sendFramebufferUpdate()
+bool DemoServerConnection::receiveSetEncodingsMessage()
 {
-	m_demoServer->lockDataForRead();
+	rfbSetEncodingsMsg setEncodingsMessage;
+	if( m_socket->bytesAvailable() < sz_rfbSetEncodingsMsg ||
+		m_socket->peek( reinterpret_cast<char *>( &setEncodingsMessage ), sz_rfbSetEncodingsMsg ) != sz_rfbSetEncodingsMsg )
+	{
+		return false;
+	}
+
+	const auto nEncodings = qFromBigEndian(setEncodingsMessage.nEncodings);
+	const qint64 totalSize = sz_rfbSetEncodingsMsg + nEncodings * sizeof(uint32_t);
+	if( m_socket->bytesAvailable() < totalSize )
+	{
+		return false;
+	}
+
+	const auto message = m_socket->read( totalSize );
+	if( message.size() != totalSize )
+	{
+		return false;
+	}
+
+	const auto encodings = reinterpret_cast<const uint32_t *>( message.constData() + sz_rfbSetEncodingsMsg );
+	for( int i = 0; i < nEncodings && m_continuousUpdatesAnnounced == false; ++i )
+	{
+		if( int32_t(qFromBigEndian( encodings[i] )) == RfbContinuousUpdates::PseudoEncoding )
+		{
+			m_continuousUpdatesAnnounced = true;
+			m_socket->putChar( char(RfbContinuousUpdates::EndMessageType) );
+		}
+	}
+
+	return true;
+}
 
-	const auto& framebufferUpdateMessages = m_demoServer->framebufferUpdateMessages();
 
-	const int framebufferUpdateMessageCount = framebufferUpdateMessages.count();
 
-	if( m_demoServer->keyFrame() != m_keyFrame ||
-			m_framebufferUpdateMessageIndex > framebufferUpdateMessageCount )
+bool DemoServerConnection::receiveEnableContinuousUpdatesMessage()
+{
+	RfbContinuousUpdates::EnableMessage message;
+	if( m_socket->bytesAvailable() < RfbContinuousUpdates::EnableMessageSize ||
+		m_socket->read( reinterpret_cast<char *>( &message ), RfbContinuousUpdates::EnableMessageSize ) != RfbContinuousUpdates::EnableMessageSize )
 	{
-		m_framebufferUpdateMessageIndex = 0;
-		m_keyFrame = m_demoServer->keyFrame();
+		return false;
 	}
 
-	bool sentUpdates = false;
-	while( m_framebufferUpdateMessageIndex < framebufferUpdateMessageCount )
+	if( message.enable )
+	{
+		setRequestedRegion( { qFromBigEndian( message.x ), qFromBigEndian( message.y ),
+							  qFromBigEndian( message.w ), qFromBigEndian( message.h ) } );
+
+		m_continuousUpdatesEnabled = true;
+		if( m_continuousUpdatesScheduled == false )
+		{
+			sendContinuousUpdates();
+		}
+	}
+	else if( m_continuousUpdatesEnabled )
 	{
-		m_socket->write( framebufferUpdateMessages[m_framebufferUpdateMessageIndex] );
-		++m_framebufferUpdateMessageIndex;
-		sentUpdates = true;
+		m_continuousUpdatesEnabled = false;
+		m_socket->putChar( char(RfbContinuousUpdates::EndMessageType) );
 	}
 
-	m_demoServer->unlockData();
+	return true;
+}
+
+
+
+void DemoServerConnection::setRequestedRegion( QRect region )
+{
+	QMutexLocker locker( &m_requestedRegionMutex );
+	m_requestedRegion = region;
+}
+
+
+
+void DemoServerConnection::sendFramebufferUpdate()
+{
+	if( updateCongestionState() )
+	{
+		// do not queue up even more data for a client which can't keep up
+		QTimer::singleShot( m_framebufferUpdateInterval, m_socket, [this]() { sendFramebufferUpdate(); } );
+		return;
+	}
 
-	if( sentUpdates == false )
+	if( sendPendingSegments() == false )
 	{
 		// did not send updates but client still waiting for update? then try again soon
 		QTimer::singleShot( m_framebufferUpdateInterval, m_socket, [this]() { sendFramebufferUpdate(); } );
 	}
 }
+
+
+
+bool DemoServerConnection::sendPendingSegments()
+{
+	auto segment = m_demoServer->keyFrameSegment();
+
+	if( segment && segment->keyFrame != m_keyFrame )
+	{
+		// (re)start with the first segment of the current key frame
+		m_keyFrame = segment->keyFrame;
+	}
+	else if( m_lastSentSegment && m_keyFramesOnly == false )
+	{
+		segment = m_lastSentSegment->nextSegment();
+	}
+	else
+	{
+		segment.reset();
+	}
+
+	QVector<QByteArray> messages;
+	while( segment )
+	{
+		messages.append( segment->message );
+		m_lastSentSegment = segment;
+		segment = segment->nextSegment();
+	}
+
+	if( messages.isEmpty() )
+	{
+		return false;
+	}
+
+	writeSegments( messages );
+
+	return true;
+}
+
+
+
+void DemoServerConnection::writeSegments( const QVector<QByteArray>& messages )
+{
+	int first = 0;
+	qint64 offset = 0;
+
+#ifdef Q_OS_UNIX
+	// pass the shared segments to the kernel with a single system call instead of
+	// copying all of them into the write buffer of the socket first - this is only
+	// possible as long as there's no buffered data which has to be sent before
+	if( m_socket->bytesToWrite() == 0 )
+	{
+		std::array<iovec, MaximumGatherWriteSegments> vectors;
+
+		while( first < messages.size() )
+		{
+			int count = 0;
+			qint64 batchSize = 0;
+			for( int i = first; i < messages.size() && count < MaximumGatherWriteSegments; ++i, ++count )
+			{
+				const auto skip = i == first ? offset : 0;
+				vectors[size_t(count)].iov_base = const_cast<char *>( messages[i].constData() + skip );
+				vectors[size_t(count)].iov_len = size_t(messages[i].size() - skip);
+				batchSize += messages[i].size() - skip;
+			}
+
+			msghdr header{};
+			header.msg_iov = vectors.data();
+			header.msg_iovlen = size_t(count);
+
+			const auto sent = sendmsg( int(m_socket->socketDescriptor()), &header, MSG_NOSIGNAL );
+			if( sent < 0 && errno == EINTR )
+			{
+				continue;
+			}
+			if( sent <= 0 )
+			{
+				// leave the remaining data to the socket which also handles errors
+				break;
+			}
+
+			auto consumed = qint64(sent);
+			while( consumed > 0 )
+			{
+				const auto remaining = messages[first].size() - offset;
+				if( consumed >= remaining )
+				{
+					consumed -= remaining;
+					++first;
+					offset = 0;
+				}
+				else
+				{
+					offset += consumed;
+					consumed = 0;
+				}
+			}
+
+			if( sent < batchSize )
+			{
+				// kernel buffer full
+				break;
+			}
+		}
+	}
+#endif
+
+	if( first < messages.size() && offset > 0 )
+	{
+		m_socket->write( messages[first].constData() + offset, messages[first].size() - offset );
+		++first;
+	}
+
+	for( int i = first; i < messages.size(); ++i )
+	{
+		m_socket->write( messages[i] );
+	}
+}
+
+
+
+void DemoServerConnection::sendContinuousUpdates()
+{
+	m_continuousUpdatesScheduled = false;
+
+	if( m_continuousUpdatesEnabled == false )
+	{
+		return;
+	}
+
+	if( updateCongestionState() == false )
+	{
+		sendPendingSegments();
+	}
+
+	m_continuousUpdatesScheduled = true;
+	QTimer::singleShot( m_framebufferUpdateInterval, m_socket, [this]() { sendContinuousUpdates(); } );
+}
+
+
+
+bool DemoServerConnection::updateCongestionState()
+{
+	const auto congested = m_socket->bytesToWrite() > MaximumSendBacklog;
+
+	if( congested )
+	{
+		m_congestionCount = qMin( m_congestionCount + 1, SlowClientCongestionCount );
+	}
+	else
+	{
+		m_congestionCount = qMax( m_congestionCount - 1, 0 );
+	}
+
+	// slow clients only receive key frames (along with the changes collected since) until they catch up
+	// again instead of lowering the quality for all clients
+	if( m_keyFramesOnly == false && m_congestionCount >= SlowClientCongestionCount )
+	{
+		vDebug() << "client" << m_socketDescriptor << "can't keep up - sending key frames only";
+		m_keyFramesOnly = true;
+	}
+	else if( m_keyFramesOnly && m_congestionCount == 0 )
+	{
+		vDebug() << "client" << m_socketDescriptor << "caught up - sending all updates";
+		m_keyFramesOnly = false;
+	}
+
+	return congested;
+}
@@ -24,31 +24,45 @@
 
 #pragma once
 
-#include "DemoServerProtocol.h"
+#include <QMutex>
 
-class DemoServer;
+#include "DemoServer.h"
+#include "DemoServerProtocol.h"
 
 // clazy:excludeall=ctor-missing-parent-argument
 
-// the demo server creates an instance of this class for each client connection,
-// i.e. each client is connected to a different server thread for best
-// performance
-class DemoServerConnection : public QThread
+// the demo server creates an instance of this class for each client connection
+// and moves it to one of its sender threads which serve many connections each
+class DemoServerConnection : public QObject
 {
 	Q_OBJECT
 public:
 	static constexpr int ProtocolRetryTime = 250;
+	static constexpr qint64 MaximumSendBacklog = 1024*1024;
+	static constexpr int SlowClientCongestionCount = 10;
+	static constexpr int MaximumGatherWriteSegments = 64;
 
 	DemoServerConnection( DemoServer* demoServer, const DemoAuthentication& authentication, quintptr socketDescriptor );
-	~DemoServerConnection() = default;
+	~DemoServerConnection() override;
 
-private:
-	void run() override;
+	// sets up the socket and starts the protocol, has to be called in the sender thread
+	void start();
+
+	// area of the framebuffer the client requested updates for, safe to call from any thread
+	QRect requestedRegion() const;
 
-	void processClient(); // clazy:exclude=thread-with-slots
+private:
+	void processClient();
 	void sendFramebufferUpdate();
+	bool sendPendingSegments();
+	void writeSegments( const QVector<QByteArray>& messages );
+	void sendContinuousUpdates();
+	bool updateCongestionState();
 
 	bool receiveClientMessage();
+	bool receiveSetEncodingsMessage();
+	bool receiveEnableContinuousUpdatesMessage();
+	void setRequestedRegion( QRect region );
 
 	const DemoAuthentication& m_authentication;
 	DemoServer* m_demoServer;
@@ -62,7 +76,17 @@ private:
 	const QMap<int, int> m_rfbClientToServerMessageSizes;
 
 	int m_keyFrame{-1};
-	int m_framebufferUpdateMessageIndex{0};
+	DemoServer::FramebufferUpdateSegment::Pointer m_lastSentSegment{};
+
+	int m_congestionCount{0};
+	bool m_keyFramesOnly{false};
+
+	bool m_continuousUpdatesAnnounced{false};
+	bool m_continuousUpdatesEnabled{false};
+	bool m_continuousUpdatesScheduled{false};
+
+	mutable QMutex m_requestedRegionMutex;
+	QRect m_requestedRegion{};
 
 	const int m_framebufferUpdateInterval;
 
@@ -22,15 +22,13 @@
  *
  */
 
-#include <QTcpSocket>
-
 #include "DemoAuthentication.h"
 #include "DemoServerProtocol.h"
 #include "VariantArrayMessage.h"
 #include "VncServerClient.h"
 
 
-DemoServerProtocol::DemoServerProtocol( const DemoAuthentication& authentication, QTcpSocket* socket, VncServerClient* client ) :
+DemoServerProtocol::DemoServerProtocol( const DemoAuthentication& authentication, QIODevice* socket, VncServerClient* client ) :
 	VncServerProtocol( socket, client ),
 	m_authentication( authentication )
 {
@@ -34,7 +34,7 @@ class DemoAuthentication;
 class DemoServerProtocol : public VncServerProtocol
 {
 public:
-	DemoServerProtocol( const DemoAuthentication& authentication, QTcpSocket* socket, VncServerClient* client );
+	DemoServerProtocol( const DemoAuthentication& authentication, QIODevice* socket, VncServerClient* client );
 
 protected:
 	AuthMethodUids supportedAuthMethodUids() const override;
@@ -31,6 +31,7 @@
 	OP( DesktopServicesConfiguration, m_configuration, QJsonArray, legacyPredefinedPrograms, setLegacyPredefinedPrograms, "PredefinedPrograms", "DesktopServices", QJsonArray(), Configuration::Property::Flag::Legacy)	\
 	OP( DesktopServicesConfiguration, m_configuration, QJsonArray, predefinedApplications, setPredefinedApplications, "PredefinedApplications", "DesktopServices", QJsonArray(), Configuration::Property::Flag::Standard )	\
 	OP( DesktopServicesConfiguration, m_configuration, QJsonArray, predefinedWebsites, setPredefinedWebsites, "PredefinedWebsites", "DesktopServices", QJsonArray(), Configuration::Property::Flag::Standard )	\
+	OP( DesktopServicesConfiguration, m_configuration, int, applicationLaunchSpreadTime, setApplicationLaunchSpreadTime, "ApplicationLaunchSpreadTime", "DesktopServices", 0, Configuration::Property::Flag::Advanced )	\
 
 // clazy:excludeall=missing-qobject-macro
 
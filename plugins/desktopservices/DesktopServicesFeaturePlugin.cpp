@@ -26,6 +26,8 @@
 #include <QKeyEvent>
 #include <QMenu>
 #include <QQuickWindow>
+#include <QRandomGenerator>
+#include <QTimer>
 #include <QToolButton>
 #include <QUrl>
 
@@ -158,9 +160,16 @@ bool DesktopServicesFeaturePlugin::handleFeatureMessage( VeyonServerInterface& s
 	if( message.featureUid() == m_startAppFeature.uid() )
 	{
 		const auto apps = message.argument( Argument::Applications ).toStringList();
-		for( const auto& app : apps )
+		const auto spreadTime = m_configuration.applicationLaunchSpreadTime();
+		if( spreadTime > 0 )
 		{
-			runApplicationAsUser( app );
+			// do not load the programs from shared storage on all computers at the same time
+			QTimer::singleShot( int( QRandomGenerator::global()->bounded( spreadTime ) ), this,
+								[=]() { runApplicationsAsUser( apps ); } );
+		}
+		else
+		{
+			runApplicationsAsUser( apps );
 		}
 	}
 	else if( message.featureUid() == m_openWebsiteFeature.uid() )
@@ -386,7 +395,21 @@ void DesktopServicesFeaturePlugin::openWebsite( const QString& website, const QS
 
 
 
-void DesktopServicesFeaturePlugin::runApplicationAsUser( const QString& commandLine )
+void DesktopServicesFeaturePlugin::runApplicationsAsUser( const QStringList& commandLines )
+{
+	const auto username = VeyonCore::platform().userFunctions().currentUser();
+	const auto desktop = VeyonCore::platform().coreFunctions().activeDesktopName();
+
+	for( const auto& commandLine : commandLines )
+	{
+		runApplicationAsUser( commandLine, username, desktop );
+	}
+}
+
+
+
+void DesktopServicesFeaturePlugin::runApplicationAsUser( const QString& commandLine,
+														 const QString& username, const QString& desktop )
 {
 	vDebug() << "launching" << commandLine;
 
@@ -413,9 +436,7 @@ void DesktopServicesFeaturePlugin::runApplicationAsUser( const QString& commandL
 		program = commandLine;
 	}
 
-	VeyonCore::platform().coreFunctions().runProgramAsUser( program, parameters,
-															VeyonCore::platform().userFunctions().currentUser(),
-															VeyonCore::platform().coreFunctions().activeDesktopName() );
+	VeyonCore::platform().coreFunctions().runProgramAsUser( program, parameters, username, desktop );
 }
 
 
@@ -438,9 +459,9 @@ bool DesktopServicesFeaturePlugin::openWebsite( const QString& urlString )
 	{
 		vWarning() << "could not open URL" << url << "via QDesktopServices - trying native generic URL handler";
 
-		runApplicationAsUser( QStringLiteral("%1 %2").arg(
-							  VeyonCore::platform().coreFunctions().genericUrlHandler(),
-							  url.toString() ) );
+		runApplicationsAsUser( { QStringLiteral("%1 %2").arg(
+								 VeyonCore::platform().coreFunctions().genericUrlHandler(),
+								 url.toString() ) } );
 	}
 
 	return true;
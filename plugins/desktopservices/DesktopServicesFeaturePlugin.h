@@ -120,7 +120,8 @@ private:
 	void openWebsite( const QString& website, const QString& saveItemName,
 					 VeyonMasterInterface& master, const ComputerControlInterfaceList& computerControlInterfaces );
 
-	void runApplicationAsUser( const QString& commandLine );
+	void runApplicationsAsUser( const QStringList& commandLines );
+	void runApplicationAsUser( const QString& commandLine, const QString& username, const QString& desktop );
 	bool openWebsite( const QString& urlString );
 
 	void updatePredefinedApplications();
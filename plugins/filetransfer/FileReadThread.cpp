@@ -22,12 +22,19 @@
  *
  */
 
+#include <QFileInfo>
+
+#include <array>
+#include <cmath>
+
 #include "FileReadThread.h"
 
 
-FileReadThread::FileReadThread( const QString& fileName, QObject* parent ) :
+FileReadThread::FileReadThread( const QString& fileName, qint64 chunkSize, int readAheadChunks, QObject* parent ) :
 	QObject( parent ),
-	m_fileName( fileName )
+	m_fileName( fileName ),
+	m_chunkSize( chunkSize ),
+	m_readAheadChunks( qMax( 1, readAheadChunks ) )
 {
 	m_timer->moveToThread( m_thread );
 	m_thread->start();
@@ -40,27 +47,56 @@ FileReadThread::FileReadThread( const QString& fileName, QObject* parent ) :
 
 FileReadThread::~FileReadThread()
 {
+	// make sure no pending read accesses this object after destruction
 	m_thread->quit();
+	m_thread->wait();
 }
 
 
 
 bool FileReadThread::start()
 {
-	if( QFile( m_fileName ).open( QFile::ReadOnly ) == false )
+	QFile file( m_fileName );
+	if( file.open( QFile::ReadOnly ) == false )
 	{
 		return false;
 	}
 
-	m_timer->singleShot( 0, this, [this]() {
+	m_fileSize = file.size();
+
+	// do not waste time on compressing data which is compressed already
+	static const QStringList compressedFileSuffixes{
+		QStringLiteral("7z"), QStringLiteral("avi"), QStringLiteral("bz2"), QStringLiteral("docx"),
+		QStringLiteral("flac"), QStringLiteral("gif"), QStringLiteral("gz"), QStringLiteral("jpeg"),
+		QStringLiteral("jpg"), QStringLiteral("mkv"), QStringLiteral("mov"), QStringLiteral("mp3"),
+		QStringLiteral("mp4"), QStringLiteral("odp"), QStringLiteral("ods"), QStringLiteral("odt"),
+		QStringLiteral("ogg"), QStringLiteral("png"), QStringLiteral("pptx"), QStringLiteral("rar"),
+		QStringLiteral("webm"), QStringLiteral("webp"), QStringLiteral("xlsx"), QStringLiteral("xz"),
+		QStringLiteral("zip"), QStringLiteral("zst")
+	};
+
+	if( compressedFileSuffixes.contains( QFileInfo( m_fileName ).suffix().toLower() ) )
+	{
+		m_compressionEnabled = false;
+	}
+
+	// use m_timer as context so the file is opened and read in the background thread
+	QTimer::singleShot( 0, m_timer, [this]() {
 		m_file = new QFile( m_fileName );
 		m_file->open( QFile::ReadOnly );
 		connect( m_thread, &QThread::finished, m_file, &QObject::deleteLater );
 
-		m_mutex.lock();
-		m_filePos = 0;
-		m_fileSize = m_file->size();
-		m_mutex.unlock();
+		// map whole file if possible to avoid read() calls for each chunk - mapping
+		// is released automatically when m_file is destroyed
+		m_fileData = m_fileSize > 0 ? m_file->map( 0, m_fileSize ) : nullptr;
+
+		if( m_fileSize == 0 )
+		{
+			QMutexLocker lock( &m_mutex );
+			m_checksumResult = m_checksum.result();
+		}
+
+		readAhead();
 	} );
 
 	return true;
@@ -68,39 +104,40 @@ bool FileReadThread::start()
 
 
 
-QByteArray FileReadThread::currentChunk()
+bool FileReadThread::isChunkReady()
 {
 	QMutexLocker lock( &m_mutex );
-	return m_currentChunk;
+	return m_chunks.isEmpty() == false;
 }
 
 
 
-void FileReadThread::readNextChunk( qint64 chunkSize )
+FileReadThread::Chunk FileReadThread::takeChunk()
 {
 	m_mutex.lock();
-	m_chunkReady = false;
+	const auto chunk = m_chunks.isEmpty() ? Chunk{} : m_chunks.dequeue();
+	m_filePos += chunk.size;
 	m_mutex.unlock();
 
-	m_timer->singleShot( 0, this, [this, chunkSize]() {
-		if( m_file )
-		{
-			const auto chunk = m_file->read( chunkSize );
-			m_mutex.lock();
-			m_currentChunk = chunk;
-			m_chunkReady = true;
-			m_filePos = m_file->pos();
-			m_mutex.unlock();
-		}
-	} );
+	QTimer::singleShot( 0, m_timer, [this]() { readAhead(); } );
+
+	return chunk;
 }
 
 
 
-bool FileReadThread::isChunkReady()
+QByteArray FileReadThread::checksum()
+{
+	QMutexLocker lock( &m_mutex );
+	return m_checksumResult;
+}
+
+
+
+bool FileReadThread::hasReadError()
 {
 	QMutexLocker lock( &m_mutex );
-	return m_chunkReady;
+	return m_readError;
 }
 
 
@@ -118,3 +155,106 @@ int FileReadThread::progress()
 	QMutexLocker lock( &m_mutex );
 	return m_fileSize > 0 ? static_cast<int>( m_filePos * 100 / m_fileSize ) : 0;
 }
+
+
+
+void FileReadThread::readAhead()
+{
+	if( m_file == nullptr )
+	{
+		return;
+	}
+
+	m_mutex.lock();
+
+	while( m_chunks.size() < m_readAheadChunks && m_readPos < m_fileSize )
+	{
+		m_mutex.unlock();
+
+		QByteArray chunk;
+		if( m_fileData )
+		{
+			const auto size = qMin( m_chunkSize, m_fileSize - m_readPos );
+			chunk = QByteArray( reinterpret_cast<const char *>( m_fileData + m_readPos ), int(size) );
+		}
+		else
+		{
+			chunk = m_file->read( m_chunkSize );
+		}
+
+		if( chunk.isEmpty() )
+		{
+			m_mutex.lock();
+			m_readError = true;
+			m_mutex.unlock();
+
+			// wake up controller so it can abort the transfer
+			Q_EMIT chunkReady();
+			return;
+		}
+
+		m_checksum.addData( chunk );
+
+		if( m_readPos == 0 && m_compressionEnabled )
+		{
+			m_compressionEnabled = isCompressible( chunk );
+		}
+
+		m_readPos += chunk.size();
+
+		Chunk nextChunk{chunk, false, chunk.size()};
+		if( m_compressionEnabled )
+		{
+			const auto compressedChunk = qCompress( chunk, CompressionLevel );
+			if( compressedChunk.size() < chunk.size() )
+			{
+				nextChunk = { compressedChunk, true, chunk.size() };
+			}
+		}
+
+		m_mutex.lock();
+
+		if( m_readPos >= m_fileSize )
+		{
+			m_checksumResult = m_checksum.result();
+		}
+
+		m_chunks.enqueue( nextChunk );
+
+		m_mutex.unlock();
+		Q_EMIT chunkReady();
+		m_mutex.lock();
+	}
+
+	m_mutex.unlock();
+}
+
+
+
+bool FileReadThread::isCompressible( const QByteArray& data ) const
+{
+	// estimate Shannon entropy of a sample - already compressed data is close to 8 bits per byte
+	const auto sampleSize = qMin( data.size(), EntropySampleSize );
+	if( sampleSize <= 0 )
+	{
+		return false;
+	}
+
+	std::array<int, 256> histogram{};
+	for( int i = 0; i < sampleSize; ++i )
+	{
+		++histogram[uchar(data[i])];
+	}
+
+	double entropy = 0;
+	for( const auto count : histogram )
+	{
+		if( count > 0 )
+		{
+			const auto p = double(count) / sampleSize;
+			entropy -= p * std::log2( p );
+		}
+	}
+
+	return entropy < MaximumCompressibleEntropy;
+}
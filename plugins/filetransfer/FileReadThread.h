@@ -24,37 +24,75 @@
 
 #pragma once
 
+#include <QCryptographicHash>
 #include <QFile>
 #include <QMutex>
+#include <QQueue>
 #include <QTimer>
 #include <QThread>
 
+// reads a file in a background thread and keeps a configurable number of chunks ready
 class FileReadThread : public QObject
 {
 	Q_OBJECT
 public:
-	explicit FileReadThread( const QString& fileName, QObject* parent = nullptr );
+	struct Chunk
+	{
+		QByteArray data;
+		bool compressed{false};
+		qint64 size{0};
+	};
+
+	FileReadThread( const QString& fileName, qint64 chunkSize, int readAheadChunks, QObject* parent = nullptr );
 	~FileReadThread() override;
 
+	// has to be called before start()
+	void setCompressionEnabled( bool enabled )
+	{
+		m_compressionEnabled = enabled;
+	}
+
 	bool start();
 
-	QByteArray currentChunk();
-	void readNextChunk( qint64 chunkSize );
 	bool isChunkReady();
+	Chunk takeChunk();
+
+	// SHA-256 checksum of the uncompressed file data, valid once atEnd() returns true
+	QByteArray checksum();
+
+	// set if the file could not be read completely - the transfer has to be aborted then
+	bool hasReadError();
 
 	bool atEnd();
 	int progress();
 
+Q_SIGNALS:
+	void chunkReady();
+
 private:
+	void readAhead();
+	bool isCompressible( const QByteArray& data ) const;
+
+	static constexpr int CompressionLevel = 1;
+	static constexpr int EntropySampleSize = 64*1024;
+	static constexpr double MaximumCompressibleEntropy = 7.5;
+
 	QMutex m_mutex{};
 	QThread* m_thread{new QThread};
 	QFile* m_file{nullptr};
-	QByteArray m_currentChunk{};
+	const uchar* m_fileData{nullptr};
+	QQueue<Chunk> m_chunks{};
+	QCryptographicHash m_checksum{QCryptographicHash::Sha256};
+	QByteArray m_checksumResult{};
 
 	QTimer* m_timer{new QTimer};
 
-	QString m_fileName;
-	bool m_chunkReady{false};
+	const QString m_fileName;
+	const qint64 m_chunkSize;
+	const int m_readAheadChunks;
+	bool m_compressionEnabled{false};
+	bool m_readError{false};
+	qint64 m_readPos{0};
 	qint64 m_filePos{0};
 	qint64 m_fileSize{0};
 
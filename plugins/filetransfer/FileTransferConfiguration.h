@@ -27,12 +27,17 @@
 #include "VeyonConfiguration.h"
 #include "Configuration/Proxy.h"
 
-#define FOREACH_FILE_TRANSFER_CONFIG_PROPERTY(OP) \
+#define FOREACH_FILE_TRANSFER_UI_CONFIG_PROPERTY(OP) \
 	OP( FileTransferConfiguration, m_configuration, bool, rememberLastFileTransferSourceDirectory, setRememberLastFileTransferSourceDirectory, "RememberLastSourceDirectory", "FileTransfer", true, Configuration::Property::Flag::Advanced )	\
 	OP( FileTransferConfiguration, m_configuration, bool, fileTransferCreateDestinationDirectory, setFileTransferCreateDestinationDirectory, "CreateDestinationDirectory", "FileTransfer", true, Configuration::Property::Flag::Advanced )	\
 	OP( FileTransferConfiguration, m_configuration, QString, fileTransferDefaultSourceDirectory, setFileTransferDefaultSourceDirectory, "DefaultSourceDirectory", "FileTransfer", QStringLiteral("%HOME%"), Configuration::Property::Flag::Advanced )	\
 	OP( FileTransferConfiguration, m_configuration, QString, fileTransferDestinationDirectory, setFileTransferDestinationDirectory, "DestinationDirectory", "FileTransfer", QStringLiteral("%HOME%"), Configuration::Property::Flag::Advanced )	\
 
+#define FOREACH_FILE_TRANSFER_CONFIG_PROPERTY(OP) \
+	FOREACH_FILE_TRANSFER_UI_CONFIG_PROPERTY(OP) \
+	OP( FileTransferConfiguration, m_configuration, int, fileTransferReadAheadChunks, setFileTransferReadAheadChunks, "ReadAheadChunks", "FileTransfer", 8, Configuration::Property::Flag::Advanced )	\
+	OP( FileTransferConfiguration, m_configuration, bool, fileTransferCompressionEnabled, setFileTransferCompressionEnabled, "CompressionEnabled", "FileTransfer", true, Configuration::Property::Flag::Advanced )	\
+
 // clazy:excludeall=missing-qobject-macro
 
 DECLARE_CONFIG_PROXY(FileTransferConfiguration, FOREACH_FILE_TRANSFER_CONFIG_PROPERTY)
@@ -56,14 +56,14 @@ FileTransferConfigurationPage::~FileTransferConfigurationPage()
 
 void FileTransferConfigurationPage::resetWidgets()
 {
-	FOREACH_FILE_TRANSFER_CONFIG_PROPERTY(INIT_WIDGET_FROM_PROPERTY);
+	FOREACH_FILE_TRANSFER_UI_CONFIG_PROPERTY(INIT_WIDGET_FROM_PROPERTY);
 }
 
 
 
 void FileTransferConfigurationPage::connectWidgetsToProperties()
 {
-	FOREACH_FILE_TRANSFER_CONFIG_PROPERTY(CONNECT_WIDGET_TO_PROPERTY)
+	FOREACH_FILE_TRANSFER_UI_CONFIG_PROPERTY(CONNECT_WIDGET_TO_PROPERTY)
 }
 
 
@@ -22,6 +22,8 @@
  *
  */
 
+#include <QDir>
+#include <QDirIterator>
 #include <QFileInfo>
 
 #include "FileReadThread.h"
@@ -48,7 +50,32 @@ FileTransferController::~FileTransferController()
 
 void FileTransferController::setFiles( const QStringList& files )
 {
-	m_files = files;
+	m_files.clear();
+	m_destinationFileNames.clear();
+
+	// expand directories recursively and transfer their contents with paths relative to the parent directory
+	for( const auto& file : files )
+	{
+		const QFileInfo fileInfo( file );
+		if( fileInfo.isDir() )
+		{
+			const QDir baseDir( fileInfo.absolutePath() );
+			QDirIterator it( fileInfo.absoluteFilePath(), QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot,
+							 QDirIterator::Subdirectories );
+			while( it.hasNext() )
+			{
+				const auto filePath = it.next();
+				m_files.append( filePath );
+				m_destinationFileNames.append( baseDir.relativeFilePath( filePath ) );
+			}
+		}
+		else
+		{
+			m_files.append( file );
+			m_destinationFileNames.append( fileInfo.fileName() );
+		}
+	}
+
 	m_currentFileIndex = 0;
 	Q_EMIT filesChanged();
 }
@@ -125,6 +152,19 @@ bool FileTransferController::isRunning() const
 
 
 void FileTransferController::process()
+{
+	// advance through as many states as possible instead of waiting for the next timer tick for each
+	// state transition - otherwise a lot of small files would take ages to transfer
+	while( processFile() )
+	{
+	}
+
+	updateProgress();
+}
+
+
+
+bool FileTransferController::processFile()
 {
 	switch( m_fileState )
 	{
@@ -137,12 +177,13 @@ void FileTransferController::process()
 		{
 			m_fileState = FileStateFinished;
 		}
-		break;
+		return true;
 
 	case FileStateTransferring:
 		if( transferFile() )
 		{
 			m_fileState = FileStateFinished;
+			return true;
 		}
 		break;
 
@@ -162,11 +203,12 @@ void FileTransferController::process()
 		else
 		{
 			m_fileState = FileStateOpen;
+			return true;
 		}
 		break;
 	}
 
-	updateProgress();
+	return false;
 }
 
 
@@ -178,7 +220,10 @@ bool FileTransferController::openFile()
 		return false;
 	}
 
-	m_fileReadThread = new FileReadThread( m_files[m_currentFileIndex], this );
+	m_fileReadThread = new FileReadThread( m_files[m_currentFileIndex], ChunkSize,
+										   m_plugin->configuration().fileTransferReadAheadChunks(), this );
+	m_fileReadThread->setCompressionEnabled( m_plugin->configuration().fileTransferCompressionEnabled() &&
+											 allInterfacesSupportCompression() );
 
 	if( m_fileReadThread->start() == false )
 	{
@@ -188,12 +233,17 @@ bool FileTransferController::openFile()
 		return false;
 	}
 
-	// start reading initial chunk in background
-	m_fileReadThread->readNextChunk( ChunkSize );
+	// send next chunk as soon as it has been read instead of waiting for next timer tick
+	connect( m_fileReadThread, &FileReadThread::chunkReady, this, [this]() {
+		if( isRunning() && m_fileState == FileStateTransferring )
+		{
+			process();
+		}
+	}, Qt::QueuedConnection );
 
 	m_currentTransferId = QUuid::createUuid();
 
-	m_plugin->sendStartMessage( m_currentTransferId, QFileInfo( m_files[m_currentFileIndex] ).fileName(),
+	m_plugin->sendStartMessage( m_currentTransferId, m_destinationFileNames[m_currentFileIndex],
 								m_flags.testFlag( OverwriteExistingFiles ), m_interfaces );
 
 	return true;
@@ -209,17 +259,34 @@ bool FileTransferController::transferFile()
 		return true;
 	}
 
-	// wait for all clients to catch up and current data chunk to be read completely
-	if( allQueuesEmpty() == false || m_fileReadThread->isChunkReady() == false )
+	// keep a limited number of chunks in flight per client and send all chunks read ahead so far
+	while( m_fileReadThread->atEnd() == false )
 	{
-		return false;
-	}
+		if( m_fileReadThread->hasReadError() )
+		{
+			delete m_fileReadThread;
+			m_fileReadThread = nullptr;
+
+			// make clients discard the incomplete file
+			m_plugin->sendCancelMessage( m_currentTransferId, m_interfaces );
+			m_currentTransferId = QUuid();
 
-	m_plugin->sendDataMessage( m_currentTransferId, m_fileReadThread->currentChunk(), m_interfaces );
+			Q_EMIT errorOccured( tr( "Could not read file \"%1\"! The transfer of this file has been aborted." ).
+								 arg( m_files[m_currentFileIndex] ) );
+			return true;
+		}
 
-	m_fileReadThread->readNextChunk( ChunkSize );
+		if( maximumQueueSize() >= MaximumQueuedChunks || m_fileReadThread->isChunkReady() == false )
+		{
+			return false;
+		}
+
+		const auto chunk = m_fileReadThread->takeChunk();
+
+		m_plugin->sendDataMessage( m_currentTransferId, chunk.data, chunk.compressed, m_interfaces );
+	}
 
-	return m_fileReadThread->atEnd();
+	return true;
 }
 
 
@@ -228,10 +295,13 @@ void FileTransferController::finishFile()
 {
 	if( m_fileReadThread )
 	{
+		const auto checksum = m_fileReadThread->checksum();
+
 		delete m_fileReadThread;
 		m_fileReadThread = nullptr;
 
-		m_plugin->sendFinishMessage( m_currentTransferId, QFileInfo( m_files[m_currentFileIndex] ).fileName(),
+		m_plugin->sendFinishMessage( m_currentTransferId, m_destinationFileNames[m_currentFileIndex],
+									 checksum,
 									 m_flags.testFlag( OpenFilesInApplication ), m_interfaces );
 
 		m_currentTransferId = QUuid();
@@ -255,11 +325,26 @@ void FileTransferController::updateProgress()
 
 
 
-bool FileTransferController::allQueuesEmpty()
+int FileTransferController::maximumQueueSize()
+{
+	int maximumSize = 0;
+
+	for( const auto& controlInterface : qAsConst(m_interfaces) )
+	{
+		maximumSize = qMax( maximumSize, controlInterface->messageQueueSize() );
+	}
+
+	return maximumSize;
+}
+
+
+
+bool FileTransferController::allInterfacesSupportCompression() const
 {
+	// older servers can't decompress data chunks
 	for( const auto& controlInterface : qAsConst(m_interfaces) )
 	{
-		if( controlInterface->isMessageQueueEmpty() == false )
+		if( controlInterface->serverVersion() < VeyonCore::ApplicationVersion::Version_5_0 )
 		{
 			return false;
 		}
@@ -76,6 +76,7 @@ private:
 	};
 
 	void process();
+	bool processFile();
 
 	bool openFile();
 	bool transferFile();
@@ -83,16 +84,19 @@ private:
 
 	void updateProgress();
 
-	bool allQueuesEmpty();
+	int maximumQueueSize();
+	bool allInterfacesSupportCompression() const;
 
 	static constexpr int ProcessInterval = 25;
 	static constexpr int ChunkSize = 256*1024;
+	static constexpr int MaximumQueuedChunks = 16;
 
 	FileTransferPlugin* m_plugin;
 
 	int m_currentFileIndex{-1};
 	QUuid m_currentTransferId{};
 	QStringList m_files{};
+	QStringList m_destinationFileNames{};
 	Flags m_flags{Transfer};
 	ComputerControlInterfaceList m_interfaces{};
 
@@ -200,7 +200,9 @@ bool FileTransferPlugin::handleFeatureMessage( VeyonServerInterface& server,
 
 	if( m_fileTransferFeature.uid() == message.featureUid() )
 	{
-		if( message.command() == FileTransferFinishCommand )
+		// do not flood the tray with notifications for each file of a directory tree
+		if( message.command() == FileTransferFinishCommand &&
+			message.argument( Argument::Filename ).toString().contains( QLatin1Char('/') ) == false )
 		{
 			VeyonCore::builtinFeatures().systemTrayIcon().showMessage( m_fileTransferFeature.displayName(),
 																   tr( "Received file \"%1\"." ).
@@ -230,7 +232,13 @@ bool FileTransferPlugin::handleFeatureMessage( VeyonWorkerInterface& worker, con
 		case FileTransferStartCommand:
 			m_currentFile.close();
 
-			m_currentFileName = destinationDirectory() + QDir::separator() + message.argument( Argument::Filename ).toString();
+			m_currentFileName = destinationFilePath( message.argument( Argument::Filename ).toString() );
+			if( m_currentFileName.isEmpty() )
+			{
+				vWarning() << "invalid file name" << message.argument( Argument::Filename ).toString();
+				return true;
+			}
+
 			m_currentFile.setFileName( m_currentFileName );
 			if( m_currentFile.exists() && message.argument( Argument::OverwriteExistingFile ).toBool() == false )
 			{
@@ -246,6 +254,7 @@ bool FileTransferPlugin::handleFeatureMessage( VeyonWorkerInterface& worker, con
 					QFile::ReadOwner | QFile::WriteOwner | QFile::ReadGroup | QFile::WriteGroup | QFile::ReadOther ) )
 			{
 				m_currentTransferId = message.argument( Argument::TransferId ).toUuid();
+				m_currentChecksum.reset();
 			}
 			else
 			{
@@ -258,7 +267,17 @@ bool FileTransferPlugin::handleFeatureMessage( VeyonWorkerInterface& worker, con
 		case FileTransferContinueCommand:
 			if( message.argument( Argument::TransferId ).toUuid() == m_currentTransferId )
 			{
-				m_currentFile.write( message.argument( Argument::DataChunk ).toByteArray() );
+				auto dataChunk = message.argument( Argument::DataChunk ).toByteArray();
+				if( message.argument( Argument::Compressed ).toBool() )
+				{
+					dataChunk = qUncompress( dataChunk );
+					if( dataChunk.isEmpty() )
+					{
+						vWarning() << "failed to decompress data chunk";
+					}
+				}
+				m_currentChecksum.addData( dataChunk );
+				m_currentFile.write( dataChunk );
 			}
 			else
 			{
@@ -279,6 +298,18 @@ bool FileTransferPlugin::handleFeatureMessage( VeyonWorkerInterface& worker, con
 
 		case FileTransferFinishCommand:
 			m_currentFile.close();
+			// never keep a file which can't be verified
+			if( message.argument( Argument::TransferId ).toUuid() == m_currentTransferId &&
+				( message.argument( Argument::Checksum ).toByteArray().isEmpty() ||
+				  message.argument( Argument::Checksum ).toByteArray() != m_currentChecksum.result() ) )
+			{
+				m_currentFile.remove();
+				m_currentFile.setFileName( {} );
+				QMessageBox::critical( nullptr, m_fileTransferFeature.displayName(),
+									   tr( "Received file \"%1\" is corrupted and has been discarded." ).
+									   arg( m_currentFileName ) );
+				return true;
+			}
 			if( message.argument( Argument::OpenFileInApplication ).toBool() )
 			{
 				QDesktopServices::openUrl( QUrl::fromLocalFile( m_currentFileName ) );
@@ -312,13 +343,18 @@ void FileTransferPlugin::sendStartMessage( QUuid transferId, const QString& file
 
 
 
-void FileTransferPlugin::sendDataMessage( QUuid transferId, const QByteArray& data,
+void FileTransferPlugin::sendDataMessage( QUuid transferId, const QByteArray& data, bool compressed,
 										  const ComputerControlInterfaceList& interfaces )
 {
-	sendFeatureMessage( FeatureMessage( m_fileTransferFeature.uid(), FileTransferContinueCommand ).
-						addArgument( Argument::TransferId, transferId ).
-						addArgument( Argument::DataChunk, data ),
-						interfaces );
+	FeatureMessage message( m_fileTransferFeature.uid(), FileTransferContinueCommand );
+	message.addArgument( Argument::TransferId, transferId );
+	message.addArgument( Argument::DataChunk, data );
+	if( compressed )
+	{
+		message.addArgument( Argument::Compressed, true );
+	}
+
+	sendFeatureMessage( message, interfaces );
 }
 
 
@@ -332,12 +368,13 @@ void FileTransferPlugin::sendCancelMessage( QUuid transferId,
 
 
 
-void FileTransferPlugin::sendFinishMessage( QUuid transferId, const QString& fileName,
+void FileTransferPlugin::sendFinishMessage( QUuid transferId, const QString& fileName, const QByteArray& checksum,
 											bool openFileInApplication, const ComputerControlInterfaceList& interfaces )
 {
 	sendFeatureMessage( FeatureMessage( m_fileTransferFeature.uid(), FileTransferFinishCommand ).
 						addArgument( Argument::TransferId, transferId ).
 						addArgument( Argument::Filename, fileName ).
+						addArgument( Argument::Checksum, checksum ).
 						addArgument( Argument::OpenFileInApplication, openFileInApplication ), interfaces );
 }
 
@@ -350,6 +387,29 @@ void FileTransferPlugin::sendOpenTransferFolderMessage( const ComputerControlInt
 
 
 
+QString FileTransferPlugin::destinationFilePath( const QString& fileName ) const
+{
+	// file names may contain relative paths when transferring directories but must not leave the destination directory
+	const auto cleanFileName = QDir::cleanPath( fileName );
+	if( cleanFileName.isEmpty() || QDir::isAbsolutePath( cleanFileName ) ||
+		cleanFileName == QLatin1String("..") || cleanFileName.startsWith( QLatin1String("../") ) )
+	{
+		return {};
+	}
+
+	const auto filePath = destinationDirectory() + QDir::separator() + cleanFileName;
+
+	if( cleanFileName.contains( QLatin1Char('/') ) &&
+		VeyonCore::filesystem().ensurePathExists( QFileInfo( filePath ).absolutePath() ) == false )
+	{
+		return {};
+	}
+
+	return filePath;
+}
+
+
+
 QString FileTransferPlugin::destinationDirectory() const
 {
 	auto dir = VeyonCore::filesystem().expandPath( m_configuration.fileTransferDestinationDirectory() );
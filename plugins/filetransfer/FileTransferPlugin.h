@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <QCryptographicHash>
 #include <QFile>
 #include <QUrl>
 
@@ -50,7 +51,9 @@ public:
 		DataChunk,
 		OpenFileInApplication,
 		OverwriteExistingFile,
-		Files
+		Files,
+		Checksum,
+		Compressed
 	};
 	Q_ENUM(Argument)
 
@@ -106,14 +109,20 @@ public:
 
 	void sendStartMessage( QUuid transferId, const QString& fileName,
 						   bool overwriteExistingFile, const ComputerControlInterfaceList& interfaces );
-	void sendDataMessage( QUuid transferId, const QByteArray& data, const ComputerControlInterfaceList& interfaces );
+	void sendDataMessage( QUuid transferId, const QByteArray& data, bool compressed,
+						  const ComputerControlInterfaceList& interfaces );
 	void sendCancelMessage( QUuid transferId, const ComputerControlInterfaceList& interfaces );
-	void sendFinishMessage( QUuid transferId, const QString& fileName,
+	void sendFinishMessage( QUuid transferId, const QString& fileName, const QByteArray& checksum,
 							bool openFileInApplication, const ComputerControlInterfaceList& interfaces );
 	void sendOpenTransferFolderMessage( const ComputerControlInterfaceList& interfaces );
 
 	ConfigurationPage* createConfigurationPage() override;
 
+	const FileTransferConfiguration& configuration() const
+	{
+		return m_configuration;
+	}
+
 Q_SIGNALS:
 	Q_INVOKABLE void acceptSelectedFiles( const QList<QUrl>& fileUrls );
 
@@ -124,6 +133,7 @@ private:
 	}
 
 	QString destinationDirectory() const;
+	QString destinationFilePath( const QString& fileName ) const;
 
 	enum Commands
 	{
@@ -147,5 +157,6 @@ private:
 	QFile m_currentFile{};
 	QString m_currentFileName;
 	QUuid m_currentTransferId{};
+	QCryptographicHash m_currentChecksum{QCryptographicHash::Sha256};
 
 };
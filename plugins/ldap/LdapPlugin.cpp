@@ -29,6 +29,7 @@
 #include "AuthLdapDialog.h"
 #include "CommandLineIO.h"
 #include "ConfigurationManager.h"
+#include "AuthenticationCredentialCache.h"
 #include "LdapNetworkObjectDirectory.h"
 #include "LdapPlugin.h"
 #include "LdapConfigurationPage.h"
@@ -41,7 +42,6 @@
 LdapPlugin::LdapPlugin( QObject* parent ) :
 	QObject( parent ),
 	m_configuration( &VeyonCore::config() ),
-	m_ldapClient( nullptr ),
 	m_ldapDirectory( nullptr ),
 	m_commands( {
 		{ QStringLiteral("autoconfigurebasedn"), tr( "Auto-configure the base DN via naming context" ) },
@@ -58,9 +58,6 @@ LdapPlugin::~LdapPlugin()
 {
 	delete m_ldapDirectory;
 	m_ldapDirectory = nullptr;
-
-	delete m_ldapClient;
-	m_ldapClient = nullptr;
 }
 
 
@@ -192,12 +189,20 @@ VncServerClient::AuthState LdapPlugin::performAuthentication( VncServerClient* c
 
 		vInfo() << "authenticating user" << client->username();
 
+		if( AuthenticationCredentialCache::contains( name(), client->username(), decryptedPassword ) )
+		{
+			vDebug() << "SUCCESS (cached)";
+			return VncServerClient::AuthState::Successful;
+		}
+
 		AuthLdapCore authCore;
 		authCore.setUsername( client->username() );
 		authCore.setPassword( decryptedPassword );
 
 		if( authCore.authenticate() )
 		{
+			AuthenticationCredentialCache::insert( name(), client->username(), decryptedPassword );
+
 			vDebug() << "SUCCESS";
 			return VncServerClient::AuthState::Successful;
 		}
@@ -287,7 +292,7 @@ QStringList LdapPlugin::userGroups( bool queryDomainGroups )
 {
 	Q_UNUSED(queryDomainGroups)
 
-	return LdapClient::stripBaseDn( ldapDirectory().userGroups(), ldapClient().baseDn() );
+	return LdapClient::stripBaseDn( ldapDirectory().userGroups(), ldapDirectory().client().baseDn() );
 }
 
 
@@ -306,7 +311,7 @@ QStringList LdapPlugin::groupsOfUser( const QString& username, bool queryDomainG
 		return QStringList();
 	}
 
-	return LdapClient::stripBaseDn( ldapDirectory().groupsOfUser( userDn ), ldapClient().baseDn() );
+	return LdapClient::stripBaseDn( ldapDirectory().groupsOfUser( userDn ), ldapDirectory().client().baseDn() );
 }
 
 
@@ -467,20 +472,6 @@ CommandLinePluginInterface::RunResult LdapPlugin::handle_help( const QStringList
 
 
 
-LdapClient& LdapPlugin::ldapClient()
-{
-	if( m_ldapClient == nullptr )
-	{
-		m_ldapClient = new LdapClient( m_configuration );
-	}
-
-	// TODO: check whether still connected and reconnect if neccessary
-
-	return *m_ldapClient;
-}
-
-
-
 LdapDirectory& LdapPlugin::ldapDirectory()
 {
 	if( m_ldapDirectory == nullptr )
@@ -488,7 +479,6 @@ LdapDirectory& LdapPlugin::ldapDirectory()
 		m_ldapDirectory = new LdapDirectory( m_configuration );
 	}
 
-	// TODO: check whether still connected and reconnect if neccessary
-
+	// the client reconnects and binds again by itself if the connection has been lost
 	return *m_ldapDirectory;
 }
@@ -22,12 +22,15 @@
  *
  */
 
+#include <QQueue>
+
 #include "LdapConfiguration.h"
 #include "LdapClient.h"
 
 #include <ldap.h>
 
 #include "ldapconnection.h"
+#include "ldapcontrol.h"
 #include "ldapoperation.h"
 #include "ldapserver.h"
 
@@ -118,72 +121,143 @@ LdapClient::Objects LdapClient::queryObjects( const QString& dn, const QStringLi
 
 	Objects entries;
 
-	int result = -1;
-	auto id = m_operation->search( KLDAP::LdapDN( dn ), kldapUrlScope( scope ), filter, QStringList( attributes ) );
+	auto realAttributeNames = attributes;
+	for( auto& attribute : realAttributeNames )
+	{
+		attribute = attribute.toLower();
+	}
+
+	auto isFirstResult = true;
+
+	const auto result = search( dn, scope, filter, attributes, [&]() {
+		if( isFirstResult )
+		{
+			isFirstResult = false;
+			matchAttributeNames( realAttributeNames );
+		}
+
+		addObjectEntry( entries, realAttributeNames );
+	} );
+
+	vDebug() << "results:" << entries;
 
-	if( id != -1 )
+	if( result == -1 )
 	{
-		auto realAttributeNames = attributes;
-		for( auto& attribute : realAttributeNames )
+		vWarning() << "LDAP search failed with code" << m_connection->ldapErrorCode();
+
+		if( m_state == Bound && m_queryRetry == false )
 		{
-			attribute = attribute.toLower();
+			// close connection and try again
+			m_queryRetry = true;
+			m_state = Disconnected;
+			entries = queryObjects( dn, attributes, filter, scope );
+			m_queryRetry = false;
 		}
+	}
 
-		auto isFirstResult = true;
+	return entries;
 
-		while( ( result = m_operation->waitForResult( id, m_queryTimeout ) ) == KLDAP::LdapOperation::RES_SEARCH_ENTRY )
+}
+
+
+
+LdapClient::Objects LdapClient::queryObjects( const QStringList& dns, const QStringList& attributes,
+											  const QString& filter )
+{
+	vDebug() << "called with" << dns.size() << "DNs" << attributes << filter;
+
+	if( m_state != Bound && reconnect() == false )
+	{
+		vCritical() << "not bound to server!";
+		return {};
+	}
+
+	if( attributes.isEmpty() )
+	{
+		vCritical() << "attributes empty!";
+		return {};
+	}
+
+	Objects entries;
+
+	auto realAttributeNames = attributes;
+	for( auto& attribute : realAttributeNames )
+	{
+		attribute = attribute.toLower();
+	}
+
+	auto isFirstResult = true;
+
+	QQueue<int> pendingSearches;
+	auto nextDn = dns.constBegin();
+
+	int result = 0;
+
+	while( result != -1 && ( nextDn != dns.constEnd() || pendingSearches.isEmpty() == false ) )
+	{
+		// keep multiple searches on the wire so the server's latency is paid once per batch instead of once per object
+		while( nextDn != dns.constEnd() && pendingSearches.size() < MaximumPendingSearches )
 		{
-			if( isFirstResult )
+			if( nextDn->isEmpty() == false )
 			{
-				isFirstResult = false;
-
-				// match attribute name from result with requested attribute name in order
-				// to keep result aggregation below case-insensitive
-				const auto attributes = m_operation->object().attributes();
-				for( auto it = attributes.constBegin(), end = attributes.constEnd(); it != end; ++it )
+				const auto id = m_operation->search( KLDAP::LdapDN( *nextDn ), KLDAP::LdapUrl::Base, filter, attributes );
+				if( id == -1 )
 				{
-					for( auto& attribute : realAttributeNames )
-					{
-						if( QString::compare( it.key().toLower(), attribute, Qt::CaseInsensitive ) == 0 )
-						{
-							attribute = it.key();
-							break;
-						}
-					}
+					result = -1;
+					break;
 				}
+				pendingSearches.enqueue( id );
 			}
+			++nextDn;
+		}
 
-			// convert result list from type QList<QByteArray> to QStringList
-			const auto dn = m_operation->object().dn().toString();
-			for( const auto& attribute : realAttributeNames )
+		if( pendingSearches.isEmpty() )
+		{
+			break;
+		}
+
+		const auto id = pendingSearches.head();
+
+		while( ( result = m_operation->waitForResult( id, m_queryTimeout ) ) == KLDAP::LdapOperation::RES_SEARCH_ENTRY )
+		{
+			if( isFirstResult )
 			{
-				const auto values = m_operation->object().values( attribute );
-				for( const auto& value : values )
-				{
-					entries[dn][attribute] += QString::fromUtf8( value );
-				}
+				isFirstResult = false;
+				matchAttributeNames( realAttributeNames );
 			}
+
+			addObjectEntry( entries, realAttributeNames );
 		}
 
-		vDebug() << "results:" << entries;
+		if( result != -1 )
+		{
+			pendingSearches.dequeue();
+		}
 	}
 
+	vDebug() << "results:" << entries.size();
+
 	if( result == -1 )
 	{
 		vWarning() << "LDAP search failed with code" << m_connection->ldapErrorCode();
 
+		// don't leave searches running on the server, e.g. after a timeout
+		for( const auto id : qAsConst(pendingSearches) )
+		{
+			m_operation->abandon( id );
+		}
+
 		if( m_state == Bound && m_queryRetry == false )
 		{
 			// close connection and try again
 			m_queryRetry = true;
 			m_state = Disconnected;
-			entries = queryObjects( dn, attributes, filter, scope );
+			entries = queryObjects( dns, attributes, filter );
 			m_queryRetry = false;
 		}
 	}
 
 	return entries;
-
 }
 
 
@@ -214,43 +288,25 @@ QStringList LdapClient::queryAttributeValues( const QString& dn, const QString&
 
 	QStringList entries;
 
-	int result = -1;
-	int id = m_operation->search( KLDAP::LdapDN( dn ), kldapUrlScope( scope ), filter, QStringList( attribute ) );
+	QStringList realAttributeNames{ attribute.toLower() };
+	bool isFirstResult = true;
 
-	if( id != -1 )
-	{
-		bool isFirstResult = true;
-		QString realAttributeName = attribute.toLower();
-
-		while( ( result = m_operation->waitForResult( id, m_queryTimeout ) ) == KLDAP::LdapOperation::RES_SEARCH_ENTRY )
+	const auto result = search( dn, scope, filter, { attribute }, [&]() {
+		if( isFirstResult )
 		{
-			if( isFirstResult )
-			{
-				isFirstResult = false;
-
-				// match attribute name from result with requested attribute name in order
-				// to keep result aggregation below case-insensitive
-				const auto attributes = m_operation->object().attributes();
-				for( auto it = attributes.constBegin(), end = attributes.constEnd(); it != end; ++it )
-				{
-					if( it.key().toLower() == realAttributeName )
-					{
-						realAttributeName = it.key();
-						break;
-					}
-				}
-			}
+			isFirstResult = false;
+			matchAttributeNames( realAttributeNames );
+		}
 
-			// convert result list from type QList<QByteArray> to QStringList
-			const auto values = m_operation->object().values( realAttributeName );
-			for( const auto& value : values )
-			{
-				entries += QString::fromUtf8( value );
-			}
+		// convert result list from type QList<QByteArray> to QStringList
+		const auto values = m_operation->object().values( realAttributeNames.first() );
+		for( const auto& value : values )
+		{
+			entries += QString::fromUtf8( value );
 		}
+	} );
 
-		vDebug() << "results:" << entries;
-	}
+	vDebug() << "results:" << entries;
 
 	if( result == -1 )
 	{
@@ -289,17 +345,11 @@ QStringList LdapClient::queryDistinguishedNames( const QString& dn, const QStrin
 
 	QStringList distinguishedNames;
 
-	int result = -1;
-	int id = m_operation->search( KLDAP::LdapDN( dn ), kldapUrlScope( scope ), filter, QStringList() );
+	const auto result = search( dn, scope, filter, {}, [&]() {
+		distinguishedNames += m_operation->object().dn().toString();
+	} );
 
-	if( id != -1 )
-	{
-		while( ( result = m_operation->waitForResult( id, m_queryTimeout ) ) == KLDAP::LdapOperation::RES_SEARCH_ENTRY )
-		{
-			distinguishedNames += m_operation->object().dn().toString();
-		}
-		vDebug() << "results" << distinguishedNames;
-	}
+	vDebug() << "results" << distinguishedNames;
 
 	if( result == -1 )
 	{
@@ -454,6 +504,100 @@ QStringList LdapClient::stripBaseDn( const QStringList& dns, const QString& base
 
 
 
+int LdapClient::search( const QString& dn, Scope scope, const QString& filter, const QStringList& attributes,
+						const std::function<void()>& processEntry )
+{
+	// request results in pages for one level and subtree searches so large containers
+	// do not hit server-side size limits and results are transferred incrementally
+	const auto usePagedResults = scope != Scope::Base;
+
+	QByteArray cookie;
+	int result = -1;
+
+	do
+	{
+		if( usePagedResults )
+		{
+			auto pageControl = KLDAP::LdapControl::createPageControl( PagedResultsPageSize, cookie );
+			// servers not supporting paged results simply return all results at once
+			pageControl.setCritical( false );
+			m_operation->setServerControls( { pageControl } );
+		}
+
+		const auto id = m_operation->search( KLDAP::LdapDN( dn ), kldapUrlScope( scope ), filter, attributes );
+
+		if( usePagedResults )
+		{
+			m_operation->setServerControls( {} );
+		}
+
+		if( id == -1 )
+		{
+			return -1;
+		}
+
+		while( ( result = m_operation->waitForResult( id, m_queryTimeout ) ) == KLDAP::LdapOperation::RES_SEARCH_ENTRY )
+		{
+			processEntry();
+		}
+
+		cookie.clear();
+
+		if( usePagedResults && result == KLDAP::LdapOperation::RES_SEARCH_RESULT )
+		{
+			const auto controls = m_operation->controls();
+			for( const auto& control : controls )
+			{
+				if( control.oid() == QLatin1String(LDAP_CONTROL_PAGEDRESULTS) )
+				{
+					control.parsePageControl( cookie );
+				}
+			}
+		}
+	}
+	while( cookie.isEmpty() == false );
+
+	return result;
+}
+
+
+
+void LdapClient::matchAttributeNames( QStringList& attributeNames ) const
+{
+	// match attribute name from result with requested attribute name in order
+	// to keep result aggregation case-insensitive
+	const auto attributes = m_operation->object().attributes();
+	for( auto it = attributes.constBegin(), end = attributes.constEnd(); it != end; ++it )
+	{
+		for( auto& attribute : attributeNames )
+		{
+			if( QString::compare( it.key(), attribute, Qt::CaseInsensitive ) == 0 )
+			{
+				attribute = it.key();
+				break;
+			}
+		}
+	}
+}
+
+
+
+void LdapClient::addObjectEntry( Objects& entries, const QStringList& attributeNames ) const
+{
+	// convert result list from type QList<QByteArray> to QStringList
+	const auto dn = m_operation->object().dn().toString();
+	for( const auto& attribute : attributeNames )
+	{
+		const auto values = m_operation->object().values( attribute );
+		for( const auto& value : values )
+		{
+			entries[dn][attribute] += QString::fromUtf8( value );
+		}
+	}
+}
+
+
+
 bool LdapClient::connectAndBind( const QUrl& url )
 {
 	if( url.isValid() )
@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include <QObject>
 #include <QUrl>
 
@@ -91,6 +93,9 @@ public:
 
 	Objects queryObjects( const QString& dn, const QStringList& attributes, const QString& filter, Scope scope );
 
+	// queries the given objects with multiple pipelined base scope searches
+	Objects queryObjects( const QStringList& dns, const QStringList& attributes, const QString& filter );
+
 	QStringList queryAttributeValues( const QString &dn, const QString &attribute,
 									  const QString& filter = QStringLiteral( "(objectclass=*)" ),
 									  Scope scope = Scope::Base );
@@ -127,10 +132,17 @@ public:
 	}
 
 	static constexpr int DefaultQueryTimeout = 3000;
+	static constexpr int PagedResultsPageSize = 500;
+	static constexpr int MaximumPendingSearches = 16;
 
 private:
 	static constexpr auto LdapLibraryDebugAny = -1;
 
+	int search( const QString& dn, Scope scope, const QString& filter, const QStringList& attributes,
+				const std::function<void()>& processEntry );
+	void matchAttributeNames( QStringList& attributeNames ) const;
+	void addObjectEntry( Objects& entries, const QStringList& attributeNames ) const;
+
 	bool reconnect();
 	bool connectAndBind( const QUrl& url );
 	void initTLS();
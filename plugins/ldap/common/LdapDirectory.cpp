@@ -283,9 +283,11 @@ QStringList LdapDirectory::groupsOfUser( const QString& userDn )
 		return {};
 	}
 
-	return m_client.queryDistinguishedNames( groupsDn(),
-											 LdapClient::constructQueryFilter( m_groupMemberFilterAttribute, userId, m_userGroupsFilter ),
-											 m_defaultSearchScope );
+	return cachedMembership( m_groupsOfUserCache, userDn, [&]() {
+		return m_client.queryDistinguishedNames( groupsDn(),
+												 LdapClient::constructQueryFilter( m_groupMemberFilterAttribute, userId, m_userGroupsFilter ),
+												 m_defaultSearchScope );
+	} );
 }
 
 
@@ -298,35 +300,39 @@ QStringList LdapDirectory::groupsOfComputer( const QString& computerDn )
 		return {};
 	}
 
-	return m_client.queryDistinguishedNames( computerGroupsDn(),
-											 LdapClient::constructQueryFilter( m_groupMemberFilterAttribute, computerId, m_computerGroupsFilter ),
-											 m_defaultSearchScope );
+	return cachedMembership( m_groupsOfComputerCache, computerDn, [&]() {
+		return m_client.queryDistinguishedNames( computerGroupsDn(),
+												 LdapClient::constructQueryFilter( m_groupMemberFilterAttribute, computerId, m_computerGroupsFilter ),
+												 m_defaultSearchScope );
+	} );
 }
 
 
 
 QStringList LdapDirectory::locationsOfComputer( const QString& computerDn )
 {
-	if( m_computerLocationsByAttribute )
-	{
-		return m_client.queryAttributeValues( computerDn, m_computerLocationAttribute );
-	}
+	return cachedMembership( m_locationsOfComputerCache, computerDn, [&]() -> QStringList {
+		if( m_computerLocationsByAttribute )
+		{
+			return m_client.queryAttributeValues( computerDn, m_computerLocationAttribute );
+		}
 
-	if( m_computerLocationsByContainer )
-	{
-		return m_client.queryAttributeValues( LdapClient::parentDn( computerDn ), m_locationNameAttribute );
-	}
+		if( m_computerLocationsByContainer )
+		{
+			return m_client.queryAttributeValues( LdapClient::parentDn( computerDn ), m_locationNameAttribute );
+		}
 
-	const auto computerId = groupMemberComputerIdentification( computerDn );
-	if( m_groupMemberFilterAttribute.isEmpty() || computerId.isEmpty() )
-	{
-		return {};
-	}
+		const auto computerId = groupMemberComputerIdentification( computerDn );
+		if( m_groupMemberFilterAttribute.isEmpty() || computerId.isEmpty() )
+		{
+			return {};
+		}
 
-	return m_client.queryAttributeValues( computerGroupsDn(),
-										  m_locationNameAttribute,
-										  LdapClient::constructQueryFilter( m_groupMemberFilterAttribute, computerId, m_computerGroupsFilter ),
-										  m_defaultSearchScope );
+		return m_client.queryAttributeValues( computerGroupsDn(),
+											  m_locationNameAttribute,
+											  LdapClient::constructQueryFilter( m_groupMemberFilterAttribute, computerId, m_computerGroupsFilter ),
+											  m_defaultSearchScope );
+	} );
 }
 
 
@@ -489,3 +495,32 @@ LdapClient::Scope LdapDirectory::computerSearchScope() const
 
 	return m_defaultSearchScope;
 }
+
+
+
+QStringList LdapDirectory::cachedMembership( MembershipCache& cache, const QString& dn,
+											 const std::function<QStringList()>& query )
+{
+	const auto it = cache.constFind( dn );
+	if( it != cache.constEnd() && it->age.hasExpired( MembershipCacheTimeout ) == false )
+	{
+		return it->values;
+	}
+
+	const auto values = query();
+
+	// do not cache results of failed queries
+	if( m_client.isBound() )
+	{
+		if( cache.size() >= MaximumMembershipCacheSize )
+		{
+			cache.clear();
+		}
+
+		auto& entry = cache[dn];
+		entry.values = values;
+		entry.age.start();
+	}
+
+	return values;
+}
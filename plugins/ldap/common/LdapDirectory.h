@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <QElapsedTimer>
+
 #include "LdapClient.h"
 #include "LdapCommon.h"
 #include "VeyonCore.h"
@@ -118,8 +120,23 @@ public:
 	}
 
 private:
+	static constexpr auto MembershipCacheTimeout = 60*1000;
+	static constexpr auto MaximumMembershipCacheSize = 4096;
+
+	struct CachedMembership
+	{
+		QStringList values;
+		QElapsedTimer age;
+	};
+	using MembershipCache = QHash<QString, CachedMembership>;
+
 	LdapClient::Scope computerSearchScope() const;
 
+	// memberships are queried for every connection during access control so
+	// keep results for a while instead of running the same search again
+	QStringList cachedMembership( MembershipCache& cache, const QString& dn,
+								  const std::function<QStringList()>& query );
+
 	const LdapConfiguration& m_configuration;
 	LdapClient m_client;
 
@@ -151,4 +168,8 @@ private:
 	bool m_computerLocationsByAttribute = false;
 	bool m_computerHostNameAsFQDN = false;
 
+	MembershipCache m_groupsOfUserCache;
+	MembershipCache m_groupsOfComputerCache;
+	MembershipCache m_locationsOfComputerCache;
+
 };
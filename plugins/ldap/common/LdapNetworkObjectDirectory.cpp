@@ -22,6 +22,16 @@
  *
  */
 
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTimer>
+
 #include "LdapConfiguration.h"
 #include "LdapDirectory.h"
 #include "LdapNetworkObjectDirectory.h"
@@ -71,6 +81,18 @@ NetworkObjectList LdapNetworkObjectDirectory::queryParents( const NetworkObject&
 
 void LdapNetworkObjectDirectory::update()
 {
+	if( m_snapshotLoaded == false )
+	{
+		m_snapshotLoaded = true;
+
+		if( hasObjects() == false && loadSnapshot() )
+		{
+			// present the snapshot right away and synchronize with the LDAP server afterwards
+			QTimer::singleShot( 0, this, &LdapNetworkObjectDirectory::update );
+			return;
+		}
+	}
+
 	const auto locations = m_ldapDirectory.computerLocations();
 
 	for( const auto& location : qAsConst( locations ) )
@@ -84,6 +106,8 @@ void LdapNetworkObjectDirectory::update()
 
 	removeObjects( rootObject(), [locations]( const NetworkObject& object ) {
 		return object.type() == NetworkObject::Type::Location && locations.contains( object.name() ) == false; } );
+
+	saveSnapshot();
 }
 
 
@@ -92,18 +116,143 @@ void LdapNetworkObjectDirectory::updateLocation( const NetworkObject& locationOb
 {
 	const auto computers = m_ldapDirectory.computerLocationEntries( locationObject.name() );
 
-	for( const auto& computer : qAsConst( computers ) )
+	replaceObjects( computersToObjects( this, &m_ldapDirectory, computers ), locationObject );
+}
+
+
+
+QString LdapNetworkObjectDirectory::snapshotFilePath() const
+{
+	const auto instanceId = m_ldapDirectory.configInstanceId();
+
+	return QStandardPaths::writableLocation( QStandardPaths::CacheLocation ) + QDir::separator() +
+		   QStringLiteral("ldap-directory-%1.json").arg( instanceId.isEmpty() ? QStringLiteral("default") : instanceId );
+}
+
+
+
+bool LdapNetworkObjectDirectory::loadSnapshot()
+{
+	QFile snapshotFile( snapshotFilePath() );
+	if( snapshotFile.open( QFile::ReadOnly ) == false )
+	{
+		return false;
+	}
+
+	const auto snapshot = QJsonDocument::fromJson( snapshotFile.readAll() ).object();
+	if( snapshot.value( QStringLiteral("version") ).toInt() != SnapshotVersion )
+	{
+		return false;
+	}
+
+	const auto locations = snapshot.value( QStringLiteral("locations") ).toArray();
+	if( locations.isEmpty() )
+	{
+		return false;
+	}
+
+	vDebug() << "loading" << locations.size() << "locations from snapshot" << snapshotFile.fileName();
+
+	for( const auto& locationValue : locations )
+	{
+		const auto location = locationValue.toObject();
+		const NetworkObject locationObject{this, NetworkObject::Type::Location,
+										   location.value( QStringLiteral("name") ).toString()};
+
+		addOrUpdateObject( locationObject, rootObject() );
+
+		const auto hosts = location.value( QStringLiteral("hosts") ).toArray();
+		for( const auto& hostValue : hosts )
+		{
+			const auto host = hostValue.toObject();
+			NetworkObject::Properties properties;
+			properties[NetworkObject::propertyKey(NetworkObject::Property::HostAddress)] =
+				host.value( QStringLiteral("hostAddress") ).toString();
+			if( host.contains( QStringLiteral("macAddress") ) )
+			{
+				properties[NetworkObject::propertyKey(NetworkObject::Property::MacAddress)] =
+					host.value( QStringLiteral("macAddress") ).toString();
+			}
+			properties[NetworkObject::propertyKey(NetworkObject::Property::DirectoryAddress)] =
+				host.value( QStringLiteral("dn") ).toString();
+
+			addOrUpdateObject( NetworkObject{this, NetworkObject::Type::Host,
+											 host.value( QStringLiteral("name") ).toString(), properties},
+							   locationObject );
+		}
+	}
+
+	return true;
+}
+
+
+
+void LdapNetworkObjectDirectory::saveSnapshot()
+{
+	const auto locationObjects = objects( rootObject() );
+	if( locationObjects.isEmpty() )
+	{
+		// most likely the server was not reachable so keep the last snapshot
+		return;
+	}
+
+	QJsonArray locations;
+
+	for( const auto& locationObject : locationObjects )
 	{
-		const auto hostObject = computerToObject( this, &m_ldapDirectory, computer );
-		if( hostObject.type() == NetworkObject::Type::Host )
+		QJsonArray hosts;
+
+		const auto hostObjects = objects( locationObject );
+		for( const auto& hostObject : hostObjects )
 		{
-			addOrUpdateObject( hostObject, locationObject );
+			QJsonObject host{
+				{ QStringLiteral("name"), hostObject.name() },
+				{ QStringLiteral("hostAddress"), hostObject.property( NetworkObject::Property::HostAddress ).toString() },
+				{ QStringLiteral("dn"), hostObject.property( NetworkObject::Property::DirectoryAddress ).toString() }
+			};
+			const auto macAddress = hostObject.property( NetworkObject::Property::MacAddress );
+			if( macAddress.isValid() )
+			{
+				host[QStringLiteral("macAddress")] = macAddress.toString();
+			}
+			hosts.append( host );
 		}
+
+		locations.append( QJsonObject{
+							  { QStringLiteral("name"), locationObject.name() },
+							  { QStringLiteral("hosts"), hosts }
+						  } );
+	}
+
+	const auto data = QJsonDocument( QJsonObject{
+										 { QStringLiteral("version"), SnapshotVersion },
+										 { QStringLiteral("locations"), locations }
+									 } ).toJson( QJsonDocument::Compact );
+
+	// avoid rewriting the snapshot on every update interval if nothing changed
+	const auto hash = QCryptographicHash::hash( data, QCryptographicHash::Sha1 );
+	if( hash == m_snapshotHash )
+	{
+		return;
+	}
+
+	const auto filePath = snapshotFilePath();
+	if( QDir().mkpath( QFileInfo( filePath ).absolutePath() ) == false )
+	{
+		return;
 	}
 
-	removeObjects( locationObject, [computers]( const NetworkObject& object ) {
-		return object.type() == NetworkObject::Type::Host &&
-			   computers.contains( object.property( NetworkObject::Property::DirectoryAddress ).toString() ) == false; } );
+	QSaveFile snapshotFile( filePath );
+	if( snapshotFile.open( QFile::WriteOnly ) &&
+		snapshotFile.write( data ) == data.size() &&
+		snapshotFile.commit() )
+	{
+		m_snapshotHash = hash;
+	}
+	else
+	{
+		vWarning() << "could not write snapshot" << filePath;
+	}
 }
 
 
@@ -171,25 +320,22 @@ NetworkObjectList LdapNetworkObjectDirectory::queryHosts( NetworkObject::Propert
 		return {};
 	}
 
-	NetworkObjectList hostObjects;
-	hostObjects.reserve( computers.size() );
-
-	for( const auto& computer : qAsConst(computers) )
-	{
-		const auto hostObject = computerToObject( this, &m_ldapDirectory, computer );
-		if( hostObject.isValid() )
-		{
-			hostObjects.append( hostObject );
-		}
-	}
-
-	return hostObjects;
+	return computersToObjects( this, &m_ldapDirectory, computers );
 }
 
 
 
 NetworkObject LdapNetworkObjectDirectory::computerToObject( NetworkObjectDirectory* directory,
 												  LdapDirectory* ldapDirectory, const QString& computerDn )
+{
+	return computersToObjects( directory, ldapDirectory, { computerDn } ).value( 0, NetworkObject{directory, NetworkObject::Type::None} );
+}
+
+
+
+NetworkObjectList LdapNetworkObjectDirectory::computersToObjects( NetworkObjectDirectory* directory,
+																  LdapDirectory* ldapDirectory,
+																  const QStringList& computerDns )
 {
 	auto displayNameAttribute = ldapDirectory->computerDisplayNameAttribute();
 	if( displayNameAttribute.isEmpty() )
@@ -213,12 +359,16 @@ NetworkObject LdapNetworkObjectDirectory::computerToObject( NetworkObjectDirecto
 
 	computerAttributes.removeDuplicates();
 
-	const auto computers = ldapDirectory->client().queryObjects( computerDn, computerAttributes,
-															 ldapDirectory->computersFilter(), LdapClient::Scope::Base );
-	if( computers.isEmpty() == false )
+	const auto computers = ldapDirectory->client().queryObjects( computerDns, computerAttributes,
+																 ldapDirectory->computersFilter() );
+
+	NetworkObjectList computerObjects;
+	computerObjects.reserve( computers.size() );
+
+	for( auto it = computers.constBegin(), end = computers.constEnd(); it != end; ++it )
 	{
-		const auto& computerDn = computers.firstKey();
-		const auto& computer = computers.first();
+		const auto& computerDn = it.key();
+		const auto& computer = it.value();
 
 		auto displayName = computer[displayNameAttribute].value( 0 );
 		auto hostName = computer[hostNameAttribute].value( 0 );
@@ -241,8 +391,8 @@ NetworkObject LdapNetworkObjectDirectory::computerToObject( NetworkObjectDirecto
 		}
 		properties[NetworkObject::propertyKey(NetworkObject::Property::DirectoryAddress)] = computerDn;
 
-		return NetworkObject{directory, NetworkObject::Type::Host, displayName, properties};
+		computerObjects.append( NetworkObject{directory, NetworkObject::Type::Host, displayName, properties} );
 	}
 
-	return NetworkObject{directory, NetworkObject::Type::None};
+	return computerObjects;
 }
@@ -39,13 +39,23 @@ public:
 
 	static NetworkObject computerToObject( NetworkObjectDirectory* directory,
 						  LdapDirectory* ldapDirectory, const QString& computerDn );
+	static NetworkObjectList computersToObjects( NetworkObjectDirectory* directory,
+												 LdapDirectory* ldapDirectory, const QStringList& computerDns );
 
 private:
+	static constexpr auto SnapshotVersion = 1;
+
 	void update() override;
 	void updateLocation( const NetworkObject& locationObject );
 
+	QString snapshotFilePath() const;
+	bool loadSnapshot();
+	void saveSnapshot();
+
 	NetworkObjectList queryLocations( NetworkObject::Property property, const QVariant& value );
 	NetworkObjectList queryHosts( NetworkObject::Property property, const QVariant& value );
 
 	LdapDirectory m_ldapDirectory;
+	bool m_snapshotLoaded{false};
+	QByteArray m_snapshotHash;
 };
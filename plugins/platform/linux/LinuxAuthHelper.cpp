@@ -0,0 +1,264 @@
+/*
+ * LinuxAuthHelper.cpp - implementation of LinuxAuthHelper class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include <QDataStream>
+#include <QDeadlineTimer>
+#include <QtEndian>
+
+#include "LinuxAuthHelper.h"
+#include "VeyonCore.h"
+
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+LinuxAuthHelper::~LinuxAuthHelper()
+{
+	for( auto& instance : m_instances )
+	{
+		stop( instance );
+	}
+}
+
+
+
+LinuxAuthHelper::Result LinuxAuthHelper::authenticate( const QByteArray& username, const QByteArray& password,
+													   const QByteArray& service, int timeout )
+{
+	if( m_availableInstances.tryAcquire( 1, timeout ) == false )
+	{
+		vWarning() << "all authentication helpers busy";
+		return Result::Failure;
+	}
+
+	QSemaphoreReleaser releaser( m_availableInstances );
+
+	for( auto& instance : m_instances )
+	{
+		if( instance.mutex.tryLock() == false )
+		{
+			continue;
+		}
+
+		const auto requestId = ++instance.requestId;
+
+		QByteArray request;
+		QDataStream stream( &request, QIODevice::WriteOnly );
+		stream << requestId << username << password << service;
+
+		auto result = authenticate( instance, request, requestId, timeout );
+		if( result == Result::Unavailable )
+		{
+			// helper may have been terminated in the meantime, so retry with a new one
+			stop( instance );
+			result = authenticate( instance, request, requestId, timeout );
+		}
+
+		request.fill( 0 );
+
+		instance.mutex.unlock();
+
+		return result;
+	}
+
+	// not reached since the semaphore ensures that one instance is available
+	return Result::Unavailable;
+}
+
+
+
+LinuxAuthHelper::Result LinuxAuthHelper::authenticate( Instance& instance, const QByteArray& request,
+													   quint32 requestId, int timeout )
+{
+	if( instance.socket < 0 && start( instance ) == false )
+	{
+		return Result::Unavailable;
+	}
+
+	if( writeData( instance.socket, request ) == false )
+	{
+		return Result::Unavailable;
+	}
+
+	// id, result code and length of error message
+	static constexpr int HeaderSize = 3 * sizeof(quint32);
+
+	const QDeadlineTimer deadline( timeout );
+
+	char header[HeaderSize];
+	if( readData( instance.socket, header, HeaderSize, deadline ) == false )
+	{
+		vCritical() << "no response from VeyonAuthHelper";
+		stop( instance );
+		// do not try again with a new helper if the current one hangs
+		return deadline.hasExpired() ? Result::Failure : Result::Unavailable;
+	}
+
+	const auto responseId = qFromBigEndian<quint32>( header );
+	const auto err = qFromBigEndian<qint32>( header + sizeof(quint32) );
+	auto messageSize = qFromBigEndian<quint32>( header + 2 * sizeof(quint32) );
+	if( messageSize == 0xffffffff )
+	{
+		messageSize = 0;
+	}
+
+	QByteArray message( int(messageSize), 0 );
+	if( responseId != requestId ||
+		readData( instance.socket, message.data(), message.size(), deadline ) == false )
+	{
+		vCritical() << "invalid response from VeyonAuthHelper";
+		stop( instance );
+		return Result::Failure;
+	}
+
+	if( err != 0 )
+	{
+		vCritical() << "VeyonAuthHelper failed:" << err << message;
+		return Result::Failure;
+	}
+
+	return Result::Success;
+}
+
+
+
+bool LinuxAuthHelper::start( Instance& instance )
+{
+	int sockets[2];
+	if( socketpair( AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sockets ) != 0 )
+	{
+		vCritical() << "failed to create socket pair for VeyonAuthHelper:" << errno;
+		return false;
+	}
+
+	posix_spawn_file_actions_t fileActions;
+	posix_spawn_file_actions_init( &fileActions );
+	// duplicated descriptors do not inherit the close-on-exec flag
+	posix_spawn_file_actions_adddup2( &fileActions, sockets[1], STDIN_FILENO );
+	posix_spawn_file_actions_adddup2( &fileActions, sockets[1], STDOUT_FILENO );
+
+	char program[] = "veyon-auth-helper";
+	char persistentArgument[] = "--persistent";
+	char* arguments[] = { program, persistentArgument, nullptr };
+
+	pid_t pid = -1;
+	const auto err = posix_spawnp( &pid, program, &fileActions, nullptr, arguments, environ );
+
+	posix_spawn_file_actions_destroy( &fileActions );
+	close( sockets[1] );
+
+	if( err != 0 )
+	{
+		vCritical() << "failed to start VeyonAuthHelper:" << err;
+		close( sockets[0] );
+		return false;
+	}
+
+	instance.pid = pid;
+	instance.socket = sockets[0];
+
+	return true;
+}
+
+
+
+void LinuxAuthHelper::stop( Instance& instance )
+{
+	if( instance.socket >= 0 )
+	{
+		// closing the socket makes the helper quit
+		close( instance.socket );
+		instance.socket = -1;
+	}
+
+	if( instance.pid > 0 )
+	{
+		if( waitpid( instance.pid, nullptr, WNOHANG ) == 0 )
+		{
+			kill( instance.pid, SIGKILL );
+			waitpid( instance.pid, nullptr, 0 );
+		}
+		instance.pid = -1;
+	}
+}
+
+
+
+bool LinuxAuthHelper::writeData( int socket, const QByteArray& data )
+{
+	qint64 written = 0;
+	while( written < data.size() )
+	{
+		const auto ret = send( socket, data.constData() + written, size_t(data.size() - written), MSG_NOSIGNAL );
+		if( ret < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			return false;
+		}
+		written += ret;
+	}
+
+	return true;
+}
+
+
+
+bool LinuxAuthHelper::readData( int socket, char* data, int size, const QDeadlineTimer& deadline )
+{
+	int bytesRead = 0;
+	while( bytesRead < size )
+	{
+		pollfd pfd{ socket, POLLIN, 0 };
+		const auto ret = poll( &pfd, 1, int(deadline.remainingTime()) );
+		if( ret < 0 && errno == EINTR )
+		{
+			continue;
+		}
+		if( ret <= 0 )
+		{
+			return false;
+		}
+
+		const auto n = recv( socket, data + bytesRead, size_t(size - bytesRead), 0 );
+		if( n < 0 && errno == EINTR )
+		{
+			continue;
+		}
+		if( n <= 0 )
+		{
+			return false;
+		}
+		bytesRead += int(n);
+	}
+
+	return true;
+}
@@ -0,0 +1,79 @@
+/*
+ * LinuxAuthHelper.h - declaration of LinuxAuthHelper class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#pragma once
+
+#include <QByteArray>
+#include <QMutex>
+#include <QSemaphore>
+
+#include <array>
+
+#include <sys/types.h>
+
+class QDeadlineTimer;
+
+// keeps a small number of veyon-auth-helper processes running in persistent mode
+// and passes authentication requests to them via a socket pair so that PAM
+// conversations still run in a separate process without forking for each request
+class LinuxAuthHelper
+{
+public:
+	enum class Result
+	{
+		Success,
+		Failure,
+		Unavailable
+	};
+
+	LinuxAuthHelper() = default;
+	~LinuxAuthHelper();
+
+	Result authenticate( const QByteArray& username, const QByteArray& password, const QByteArray& service,
+						 int timeout );
+
+private:
+	static constexpr int MaximumInstances = 2;
+
+	struct Instance
+	{
+		QMutex mutex{};
+		pid_t pid{-1};
+		int socket{-1};
+		quint32 requestId{0};
+	};
+
+	Result authenticate( Instance& instance, const QByteArray& request, quint32 requestId, int timeout );
+
+	static bool start( Instance& instance );
+	static void stop( Instance& instance );
+
+	static bool writeData( int socket, const QByteArray& data );
+	static bool readData( int socket, char* data, int size, const QDeadlineTimer& deadline );
+
+	std::array<Instance, MaximumInstances> m_instances{};
+	QSemaphore m_availableInstances{MaximumInstances};
+
+} ;
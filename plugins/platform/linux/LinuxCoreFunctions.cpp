@@ -39,6 +39,7 @@
 #include "LinuxDesktopIntegration.h"
 #include "LinuxUserFunctions.h"
 #include "PlatformUserFunctions.h"
+#include "ProcessHelper.h"
 
 #include <X11/XKBlib.h>
 #include <X11/extensions/dpms.h>
@@ -431,7 +432,10 @@ void LinuxCoreFunctions::restartDisplayManagers()
 		 QStringLiteral("wdm"),
 		 QStringLiteral("xdm") } )
 	{
-		systemctl( { QStringLiteral("restart"), displayManager } );
+		// do not block the server while the display managers restart
+		ProcessHelper::runAsync( QStringLiteral("systemctl"),
+								 { QStringLiteral("--no-pager"), QStringLiteral("-q"), QStringLiteral("restart"), displayManager },
+								 SystemctlTimeout, VeyonCore::instance() );
 	}
 }
 
@@ -86,6 +86,8 @@ public:
 	static bool waitForProcess( qint64 pid, int timeout, int sleepInterval );
 
 private:
+	static constexpr int SystemctlTimeout = 30000;
+
 	int m_screenSaverTimeout{0};
 	int m_screenSaverPreferBlanking{0};
 	bool m_dpmsEnabled{false};
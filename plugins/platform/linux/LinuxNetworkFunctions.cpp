@@ -22,20 +22,36 @@
  *
  */
 
+#include <netinet/icmp6.h>
 #include <netinet/in.h>
+#include <netinet/ip_icmp.h>
 #include <netinet/tcp.h>
+#include <poll.h>
+#include <unistd.h>
 
+#include <array>
+
+#include <QElapsedTimer>
 #include <QProcess>
+#include <QRandomGenerator>
 
+#include "HostAddress.h"
 #include "LinuxNetworkFunctions.h"
 
 bool LinuxNetworkFunctions::ping( const QString& hostAddress )
 {
-	QProcess pingProcess;
-	pingProcess.start( QStringLiteral("ping"), { QStringLiteral("-c"), QStringLiteral("1"), QStringLiteral("-w"), QString::number( PingTimeout / 1000 ), hostAddress } );
-	pingProcess.waitForFinished( PingProcessTimeout );
+	bool result;
 
-	return pingProcess.exitCode() == 0;
+	const QHostAddress address( HostAddress(hostAddress).tryConvert(HostAddress::Type::IpAddress) );
+
+	if( ( address.protocol() == QAbstractSocket::IPv4Protocol ||
+		  address.protocol() == QAbstractSocket::IPv6Protocol ) &&
+		pingAddress( address, &result ) )
+	{
+		return result;
+	}
+
+	return pingViaUtility( hostAddress );
 }
 
 
@@ -51,6 +67,95 @@ bool LinuxNetworkFunctions::configureFirewallException( const QString& applicati
 
 
 
+bool LinuxNetworkFunctions::pingAddress( const QHostAddress& address, bool* result )
+{
+	*result = false;
+
+	const auto ipv6 = address.protocol() == QAbstractSocket::IPv6Protocol;
+
+	// unprivileged datagram ICMP sockets are only available if permitted via net.ipv4.ping_group_range
+	const auto fd = socket( ipv6 ? AF_INET6 : AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, ipv6 ? IPPROTO_ICMPV6 : IPPROTO_ICMP );
+	if( fd < 0 )
+	{
+		return false;
+	}
+
+	sockaddr_storage remoteAddress{};
+	socklen_t remoteAddressLength = 0;
+
+	if( ipv6 )
+	{
+		auto remoteAddress6 = reinterpret_cast<sockaddr_in6 *>( &remoteAddress );
+		remoteAddress6->sin6_family = AF_INET6;
+		const auto ipv6Address = address.toIPv6Address();
+		memcpy( &remoteAddress6->sin6_addr, &ipv6Address, sizeof(remoteAddress6->sin6_addr) );
+		remoteAddressLength = sizeof(sockaddr_in6);
+	}
+	else
+	{
+		auto remoteAddress4 = reinterpret_cast<sockaddr_in *>( &remoteAddress );
+		remoteAddress4->sin_family = AF_INET;
+		remoteAddress4->sin_addr.s_addr = htonl( address.toIPv4Address() );
+		remoteAddressLength = sizeof(sockaddr_in);
+	}
+
+	// type, code, checksum, identifier and sequence number followed by payload -
+	// the kernel fills in identifier and checksum for datagram ICMP sockets
+	std::array<uint8_t, 14> request{ uint8_t(ipv6 ? ICMP6_ECHO_REQUEST : ICMP_ECHO), 0, 0, 0, 0, 0, 0, 0,
+									 'V', 'e', 'y', 'o', 'n', 0 };
+	const auto sequenceNumber = quint16( QRandomGenerator::global()->generate() );
+	request[6] = uint8_t( sequenceNumber >> 8 );
+	request[7] = uint8_t( sequenceNumber & 0xff );
+
+	if( sendto( fd, request.data(), request.size(), 0,
+				reinterpret_cast<sockaddr *>( &remoteAddress ), remoteAddressLength ) != ssize_t(request.size()) )
+	{
+		// host or network unreachable
+		close( fd );
+		return true;
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+
+	while( timer.elapsed() < PingTimeout )
+	{
+		pollfd pollFd{ fd, POLLIN, 0 };
+		if( poll( &pollFd, 1, int( PingTimeout - timer.elapsed() ) ) <= 0 )
+		{
+			break;
+		}
+
+		// datagram ICMP sockets only receive replies for their own identifier without IP header
+		std::array<uint8_t, 256> reply{};
+		const auto size = recv( fd, reply.data(), reply.size(), 0 );
+		if( size >= 8 &&
+			reply[0] == uint8_t(ipv6 ? ICMP6_ECHO_REPLY : ICMP_ECHOREPLY) &&
+			reply[6] == request[6] && reply[7] == request[7] )
+		{
+			*result = true;
+			break;
+		}
+	}
+
+	close( fd );
+
+	return true;
+}
+
+
+
+bool LinuxNetworkFunctions::pingViaUtility( const QString& hostAddress )
+{
+	QProcess pingProcess;
+	pingProcess.start( QStringLiteral("ping"), { QStringLiteral("-c"), QStringLiteral("1"), QStringLiteral("-w"), QString::number( PingTimeout / 1000 ), hostAddress } );
+	pingProcess.waitForFinished( PingProcessTimeout );
+
+	return pingProcess.exitCode() == 0;
+}
+
+
+
 bool LinuxNetworkFunctions::configureSocketKeepalive( Socket socket, bool enabled, int idleTime, int interval, int probes )
 {
 	int optval;
@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <QHostAddress>
+
 #include "PlatformNetworkFunctions.h"
 
 // clazy:excludeall=copyable-polymorphic
@@ -36,4 +38,8 @@ public:
 
 	bool configureSocketKeepalive( Socket socket, bool enabled, int idleTime, int interval, int probes ) override;
 
+private:
+	bool pingAddress( const QHostAddress& address, bool* result );
+	bool pingViaUtility( const QString& hostAddress );
+
 };
@@ -29,6 +29,7 @@
 #define FOREACH_LINUX_PLATFORM_CONFIG_PROPERTY(OP) \
 	OP( LinuxPlatformConfiguration, m_configuration, QString, pamServiceName, setPamServiceName, "PamServiceName", "Linux", QString(), Configuration::Property::Flag::Advanced ) \
 	OP( LinuxPlatformConfiguration, m_configuration, int, minimumUserSessionLifetime, setMinimumUserSessionLifetime, "MinimumUserSessionLifetime", "Linux", 3, Configuration::Property::Flag::Advanced ) \
+	OP( LinuxPlatformConfiguration, m_configuration, bool, includePrimaryGroupInGroupMemberships, setIncludePrimaryGroupInGroupMemberships, "IncludePrimaryGroupInGroupMemberships", "Linux", false, Configuration::Property::Flag::Advanced ) \
 	OP( LinuxPlatformConfiguration, m_configuration, QString, userLoginKeySequence, setUserLoginKeySequence, "UserLoginKeySequence", "Linux", QStringLiteral("%username%<Tab>%password%<Return>"), Configuration::Property::Flag::Advanced ) \
 
 // clazy:excludeall=missing-qobject-macro
@@ -22,8 +22,11 @@
  *
  */
 
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+
 #include <QDBusReply>
-#include <QEventLoop>
 #include <QFileInfo>
 #include <QTimer>
 
@@ -34,10 +37,23 @@
 #include "VeyonConfiguration.h"
 
 
+int LinuxServiceCore::s_reloadSignalSockets[2] = { -1, -1 };
+
+
 LinuxServiceCore::LinuxServiceCore( QObject* parent ) :
-	QObject( parent )
+	QObject( parent ),
+	m_minimumSessionUptime( LinuxPlatformConfiguration(&VeyonCore::config()).minimumUserSessionLifetime() )
 {
+	m_serverStartTimer.setInterval( ServerStartInterval );
+	connect( &m_serverStartTimer, &QTimer::timeout, this, &LinuxServiceCore::startNextServer );
+
+	m_sessionStateCheckTimer.setInterval( SessionStateCheckDelay );
+	m_sessionStateCheckTimer.setSingleShot( true );
+	connect( &m_sessionStateCheckTimer, &QTimer::timeout, this, &LinuxServiceCore::checkSessionStates );
+
 	connectToLoginManager();
+
+	setupReloadSignalHandler();
 }
 
 
@@ -53,8 +69,7 @@ void LinuxServiceCore::run()
 {
 	startServers();
 
-	QEventLoop eventLoop;
-	eventLoop.exec();
+	m_eventLoop.exec();
 }
 
 
@@ -67,7 +82,14 @@ void LinuxServiceCore::startServer( const QString& login1SessionId, const QDBusO
 
 	vDebug() << "new session" << sessionPath;
 
-	startServer( sessionPath );
+	if( m_sessionManager.mode() == PlatformSessionManager::Mode::Multi )
+	{
+		queueServerStart( sessionPath );
+	}
+	else
+	{
+		startServer( sessionPath );
+	}
 }
 
 
@@ -133,13 +155,54 @@ void LinuxServiceCore::startServers()
 			m_deferredServerSessions.contains( s ) == false &&
 			( m_sessionManager.mode() == PlatformSessionManager::Mode::Multi || m_serverProcesses.isEmpty() ) )
 		{
-			startServer( s );
+			if( m_sessionManager.mode() == PlatformSessionManager::Mode::Multi )
+			{
+				queueServerStart( s );
+			}
+			else
+			{
+				startServer( s );
+			}
 		}
 	}
 }
 
 
 
+void LinuxServiceCore::queueServerStart( const QString& sessionPath )
+{
+	if( m_pendingServerStarts.contains( sessionPath ) == false )
+	{
+		m_pendingServerStarts.append( sessionPath );
+	}
+
+	if( m_serverStartTimer.isActive() == false )
+	{
+		// start first server immediately
+		startNextServer();
+		m_serverStartTimer.start();
+	}
+}
+
+
+
+void LinuxServiceCore::startNextServer()
+{
+	if( m_pendingServerStarts.isEmpty() )
+	{
+		m_serverStartTimer.stop();
+		return;
+	}
+
+	const auto sessionPath = m_pendingServerStarts.takeFirst();
+	if( m_serverProcesses.contains( sessionPath ) == false )
+	{
+		startServer( sessionPath );
+	}
+}
+
+
+
 void LinuxServiceCore::startServer( const QString& sessionPath )
 {
 	const auto sessionType = LinuxSessionFunctions::getSessionType( sessionPath );
@@ -204,13 +267,12 @@ void LinuxServiceCore::startServer( const QString& sessionPath )
 	}
 
 	const auto sessionUptime = LinuxSessionFunctions::getSessionUptimeSeconds( sessionPath );
-	const auto minimumSessionUptime = LinuxPlatformConfiguration(&VeyonCore::config()).minimumUserSessionLifetime();
 
 	if( sessionUptime >= 0 &&
-		sessionUptime < minimumSessionUptime )
+		sessionUptime < m_minimumSessionUptime )
 	{
-		vDebug() << "Session" << sessionPath << "too young - retrying in" << minimumSessionUptime - sessionUptime << "msecs";
-		deferServerStart( sessionPath, int(minimumSessionUptime - sessionUptime) );
+		vDebug() << "Session" << sessionPath << "too young - retrying in" << m_minimumSessionUptime - sessionUptime << "msecs";
+		deferServerStart( sessionPath, int(m_minimumSessionUptime - sessionUptime) );
 		return;
 	}
 
@@ -246,7 +308,7 @@ void LinuxServiceCore::startServer( const QString& sessionPath )
 	auto serverProcess = new LinuxServerProcess( sessionEnvironment, sessionPath, sessionId, this );
 	serverProcess->start();
 
-	connect( serverProcess, &QProcess::stateChanged, this, [=]() { checkSessionState( sessionPath ); } );
+	connect( serverProcess, &QProcess::stateChanged, this, [=]() { queueSessionStateCheck( sessionPath ); } );
 
 	m_serverProcesses[sessionPath] = serverProcess;
 	m_deferredServerSessions.removeAll( sessionPath );
@@ -270,6 +332,9 @@ void LinuxServiceCore::stopServer( const QString& sessionPath )
 {
 	m_sessionManager.closeSession( sessionPath );
 
+	m_pendingServerStarts.removeAll( sessionPath );
+	m_pendingSessionStateChecks.removeAll( sessionPath );
+
 	if( m_serverProcesses.contains( sessionPath ) == false )
 	{
 		return;
@@ -297,6 +362,103 @@ void LinuxServiceCore::stopAllServers()
 
 
 
+void LinuxServiceCore::setupReloadSignalHandler()
+{
+	if( ::socketpair( AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, s_reloadSignalSockets ) != 0 )
+	{
+		vWarning() << "could not create socket pair for reload signal handler - reloading will not be supported";
+		return;
+	}
+
+	m_reloadSignalNotifier = new QSocketNotifier( s_reloadSignalSockets[1], QSocketNotifier::Read, this );
+	connect( m_reloadSignalNotifier, &QSocketNotifier::activated, this, &LinuxServiceCore::reloadConfiguration );
+
+	struct sigaction action{};
+	action.sa_handler = handleReloadSignal;
+	sigemptyset( &action.sa_mask );
+	action.sa_flags = SA_RESTART;
+	sigaction( SIGHUP, &action, nullptr );
+}
+
+
+
+void LinuxServiceCore::reloadConfiguration()
+{
+	char signal = 0;
+	if( ::read( s_reloadSignalSockets[1], &signal, sizeof(signal) ) != sizeof(signal) )
+	{
+		return;
+	}
+
+	vInfo() << "Reloading configuration";
+
+	const auto reloadMode = VeyonCore::config().reloadForService();
+
+	if( reloadMode == VeyonConfiguration::ServiceReloadMode::RestartService )
+	{
+		// stop all servers and exit - systemd restarts the service (Restart=always)
+		// which then reads all settings again
+		vInfo() << "Restarting service to apply changed service settings";
+		m_eventLoop.quit();
+		return;
+	}
+
+	VeyonCore::instance()->reapplyConfiguration();
+
+	m_minimumSessionUptime = LinuxPlatformConfiguration(&VeyonCore::config()).minimumUserSessionLifetime();
+
+	if( reloadMode == VeyonConfiguration::ServiceReloadMode::RestartServers )
+	{
+		// restart servers in place so they keep their session IDs and thereby their ports
+		for( auto serverProcess : qAsConst(m_serverProcesses) )
+		{
+			serverProcess->stop();
+			serverProcess->start();
+		}
+	}
+}
+
+
+
+void LinuxServiceCore::handleReloadSignal( int signal )
+{
+	Q_UNUSED(signal)
+
+	const char data = 1;
+	const auto bytesWritten = ::write( s_reloadSignalSockets[0], &data, sizeof(data) );
+	Q_UNUSED(bytesWritten)
+}
+
+
+
+void LinuxServiceCore::queueSessionStateCheck( const QString& sessionPath )
+{
+	if( m_pendingSessionStateChecks.contains( sessionPath ) == false )
+	{
+		m_pendingSessionStateChecks.append( sessionPath );
+	}
+
+	if( m_sessionStateCheckTimer.isActive() == false )
+	{
+		m_sessionStateCheckTimer.start();
+	}
+}
+
+
+
+void LinuxServiceCore::checkSessionStates()
+{
+	const auto sessionPaths = m_pendingSessionStateChecks;
+	m_pendingSessionStateChecks.clear();
+
+	for( const auto& sessionPath : sessionPaths )
+	{
+		checkSessionState( sessionPath );
+	}
+}
+
+
+
 void LinuxServiceCore::checkSessionState( const QString& sessionPath )
 {
 	const auto sessionState = LinuxSessionFunctions::getSessionState( sessionPath );
@@ -24,6 +24,10 @@
 
 #pragma once
 
+#include <QEventLoop>
+#include <QSocketNotifier>
+#include <QTimer>
+
 #include "LinuxCoreFunctions.h"
 #include "PlatformSessionManager.h"
 #include "ServiceDataManager.h"
@@ -49,20 +53,45 @@ private:
 	static constexpr auto LoginManagerReconnectInterval = 3000;
 	static constexpr auto SessionEnvironmentProbingInterval = 1000;
 	static constexpr auto SessionStateProbingInterval = 1000;
+	static constexpr auto ServerStartInterval = 200;
+	static constexpr auto SessionStateCheckDelay = 100;
 
 	void connectToLoginManager();
 	void startServers();
+	void queueServerStart( const QString& sessionPath );
+	void startNextServer();
 	void startServer( const QString& sessionPath );
 	void deferServerStart( const QString& sessionPath, int delay );
 	void stopServer( const QString& sessionPath );
 	void stopAllServers();
 
+	void setupReloadSignalHandler();
+	void reloadConfiguration();
+	static void handleReloadSignal( int signal );
+
+	void queueSessionStateCheck( const QString& sessionPath );
+	void checkSessionStates();
 	void checkSessionState( const QString& sessionPath );
 
 	LinuxCoreFunctions::DBusInterfacePointer m_loginManager{LinuxCoreFunctions::systemdLoginManager()};
 	QMap<QString, LinuxServerProcess *> m_serverProcesses;
 	QStringList m_deferredServerSessions;
 
+	// spread server starts for many sessions (e.g. during a login storm) over time
+	QStringList m_pendingServerStarts;
+	QTimer m_serverStartTimer{this};
+
+	QStringList m_pendingSessionStateChecks;
+	QTimer m_sessionStateCheckTimer{this};
+
+	int m_minimumSessionUptime{0};
+
+	QEventLoop m_eventLoop{};
+
+	// SIGHUP (e.g. via "systemctl reload") is forwarded to the event loop through a socket pair
+	static int s_reloadSignalSockets[2];
+	QSocketNotifier* m_reloadSignalNotifier{nullptr};
+
 	ServiceDataManager m_dataManager{};
 	PlatformSessionManager m_sessionManager{};
 
@@ -66,6 +66,13 @@ bool LinuxServiceFunctions::stop( const QString& name )
 
 
 
+bool LinuxServiceFunctions::reload( const QString& name )
+{
+	return LinuxCoreFunctions::systemctl( { QStringLiteral("reload"), name } ) == 0;
+}
+
+
+
 bool LinuxServiceFunctions::install( const QString& name, const QString& filePath,
 									 StartMode startMode, const QString& displayName )
 {
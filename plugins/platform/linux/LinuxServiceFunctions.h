@@ -37,6 +37,7 @@ public:
 	bool isRunning( const QString& name ) override;
 	bool start( const QString& name ) override;
 	bool stop( const QString& name ) override;
+	bool reload( const QString& name ) override;
 	bool install( const QString& name, const QString& serviceFilePath,
 				  StartMode startMode, const QString& displayName) override;
 	bool uninstall( const QString& name ) override;
@@ -24,12 +24,15 @@
 
 #include <QDateTime>
 #include <QDBusReply>
+#include <QFile>
+#include <QMutex>
 #include <QProcessEnvironment>
 
 #include <proc/readproc.h>
 
 #include "LinuxCoreFunctions.h"
 #include "LinuxSessionFunctions.h"
+#include "LinuxSessionPropertyCache.h"
 #include "PlatformSessionManager.h"
 
 
@@ -105,27 +108,7 @@ QStringList LinuxSessionFunctions::listSessions()
 
 QVariant LinuxSessionFunctions::getSessionProperty(const QString& session, const QString& property, bool logErrors)
 {
-	QDBusInterface loginManager( QStringLiteral("org.freedesktop.login1"),
-								 session,
-								 QStringLiteral("org.freedesktop.DBus.Properties"),
-								 QDBusConnection::systemBus() );
-
-	const QDBusReply<QDBusVariant> reply = loginManager.call( QStringLiteral("Get"),
-															  QStringLiteral("org.freedesktop.login1.Session"),
-															  property );
-
-	if( reply.isValid() == false )
-	{
-		if (logErrors)
-		{
-			vCritical() << "Could not query property" << property
-						<< "of session" << session
-						<< "error:" << reply.error().message();
-		}
-		return {};
-	}
-
-	return reply.value().variant();
+	return LinuxSessionPropertyCache::instance().property( session, property, logErrors );
 }
 
 
@@ -233,18 +216,11 @@ QString LinuxSessionFunctions::getSessionId(const QString& session, bool logErro
 
 QString LinuxSessionFunctions::getSessionUser(const QString& session)
 {
-	quint32 uid{0};
-	QString userObjectPath;
-
-	const auto reply = getSessionProperty(session, QStringLiteral("User"));
-	if (reply.isValid())
+	// (uid, object path)
+	const auto user = getSessionProperty(session, QStringLiteral("User")).toList();
+	if (user.size() == 2)
 	{
-		const auto replyData = reply.value<QDBusArgument>();
-		replyData.beginStructure();
-		replyData >> uid >> userObjectPath;
-		replyData.endStructure();
-
-		return userObjectPath;
+		return user.at(1).toString();
 	}
 
 	return {};
@@ -277,13 +253,15 @@ LinuxSessionFunctions::State LinuxSessionFunctions::getSessionState( const QStri
 
 LinuxSessionFunctions::LoginDBusSessionSeat LinuxSessionFunctions::getSessionSeat( const QString& session )
 {
-	const auto seatArgument = getSessionProperty( session, QStringLiteral("Seat") ).value<QDBusArgument>();
+	// (id, object path)
+	const auto seatData = getSessionProperty( session, QStringLiteral("Seat") ).toList();
 
 	LoginDBusSessionSeat seat;
-	seatArgument.beginStructure();
-	seatArgument >> seat.id;
-	seatArgument >> seat.path;
-	seatArgument.endStructure();
+	if( seatData.size() == 2 )
+	{
+		seat.id = seatData.at(0).toString();
+		seat.path = seatData.at(1).toString();
+	}
 
 	return seat;
 }
@@ -292,34 +270,118 @@ LinuxSessionFunctions::LoginDBusSessionSeat LinuxSessionFunctions::getSessionSea
 
 QProcessEnvironment LinuxSessionFunctions::getSessionEnvironment( int sessionLeaderPid )
 {
-	QProcessEnvironment sessionEnv;
+	struct CachedEnvironment
+	{
+		qint64 startTime;
+		qint64 cacheTime;
+		QProcessEnvironment environment;
+	};
 
+	// variables may be exported by the session only some time after the session leader started,
+	// so cache entries expire after a while in addition to being dropped for dead session leaders
+	static constexpr qint64 CacheLifetime = 60 * 1000;
+
+	static QMutex cacheMutex;
+	static QHash<int, CachedEnvironment> cache;
+
+	// the start time of the session leader distinguishes reused PIDs of later sessions
+	const auto startTime = processStartTime( sessionLeaderPid );
+	const auto now = QDateTime::currentMSecsSinceEpoch();
+
+	QMutexLocker locker( &cacheMutex );
+
+	const auto cachedEnvironment = cache.constFind( sessionLeaderPid );
+	if( startTime >= 0 &&
+		cachedEnvironment != cache.constEnd() &&
+		cachedEnvironment->startTime == startTime &&
+		now - cachedEnvironment->cacheTime < CacheLifetime )
+	{
+		return cachedEnvironment->environment;
+	}
+
+	// determine session processes first and then read the environment of these processes only
+	// instead of letting libprocps read the environment of every process on the system
+	QList<int> sessionProcesses;
 	LinuxCoreFunctions::forEachChildProcess(
-		[&sessionEnv]( proc_t* procInfo ) {
-			if( procInfo->environ != nullptr )
+		[&sessionProcesses]( proc_t* procInfo ) {
+			sessionProcesses.append( procInfo->tid );
+			return true;
+		},
+		sessionLeaderPid, 0, true );
+
+	QProcessEnvironment sessionEnv;
+
+	for( const auto pid : qAsConst(sessionProcesses) )
+	{
+		QFile environFile( QStringLiteral("/proc/%1/environ").arg( pid ) );
+		if( environFile.open( QFile::ReadOnly ) == false )
+		{
+			continue;
+		}
+
+		const auto variables = environFile.readAll().split( '\0' );
+		for( const auto& variable : variables )
+		{
+			const auto env = QString::fromUtf8( variable );
+			const auto separatorPos = env.indexOf( QLatin1Char('=') );
+			if( separatorPos > 0 )
 			{
-				for( int i = 0; procInfo->environ[i]; ++i )
-				{
-					const auto env = QString::fromUtf8( procInfo->environ[i] );
-					const auto separatorPos = env.indexOf( QLatin1Char('=') );
-					if( separatorPos > 0 )
-					{
-						sessionEnv.insert( env.left( separatorPos ), env.mid( separatorPos+1 ) );
-					}
-				}
-
-				return true;
+				sessionEnv.insert( env.left( separatorPos ), env.mid( separatorPos+1 ) );
 			}
+		}
+	}
 
-			return false;
-		},
-		sessionLeaderPid, PROC_FILLENV, true );
+	for( auto it = cache.begin(); it != cache.end(); )
+	{
+		if( now - it->cacheTime >= CacheLifetime || processStartTime( it.key() ) != it->startTime )
+		{
+			it = cache.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	// don't cache environments of sessions which are still being set up
+	const auto isComplete = ( sessionEnv.contains( QStringLiteral("DISPLAY") ) ||
+							  sessionEnv.contains( QStringLiteral("WAYLAND_DISPLAY") ) ) &&
+							sessionEnv.contains( QStringLiteral("XDG_RUNTIME_DIR") ) &&
+							sessionEnv.contains( QStringLiteral("XDG_SESSION_ID") );
+
+	if( startTime >= 0 && isComplete )
+	{
+		cache[sessionLeaderPid] = { startTime, now, sessionEnv };
+	}
 
 	return sessionEnv;
 }
 
 
 
+qint64 LinuxSessionFunctions::processStartTime( int pid )
+{
+	QFile statFile( QStringLiteral("/proc/%1/stat").arg( pid ) );
+	if( pid <= 0 || statFile.open( QFile::ReadOnly ) == false )
+	{
+		return -1;
+	}
+
+	// skip PID and command name which may contain spaces and parentheses
+	const auto stat = statFile.readAll();
+	const auto fields = stat.mid( stat.lastIndexOf( ')' ) + 2 ).split( ' ' );
+
+	// starttime is the 22nd field while the remaining fields start with the 3rd one
+	static constexpr auto StartTimeField = 22 - 3;
+
+	bool ok = false;
+	const auto startTime = fields.value( StartTimeField ).toLongLong( &ok );
+
+	return ok ? startTime : -1;
+}
+
+
+
 QString LinuxSessionFunctions::currentSessionPath()
 {
 	const auto xdgSessionPath = QProcessEnvironment::systemEnvironment().value( sessionPathEnvVarName() );
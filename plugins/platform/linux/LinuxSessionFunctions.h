@@ -99,6 +99,7 @@ public:
 	static LoginDBusSessionSeat getSessionSeat( const QString& session );
 
 	static QProcessEnvironment getSessionEnvironment( int sessionLeaderPid );
+	static qint64 processStartTime( int pid );
 
 	static QString currentSessionPath();
 
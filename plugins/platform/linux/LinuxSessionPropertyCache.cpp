@@ -0,0 +1,196 @@
+/*
+ * LinuxSessionPropertyCache.cpp - implementation of LinuxSessionPropertyCache class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QCoreApplication>
+#include <QDBusArgument>
+#include <QDBusConnection>
+#include <QDBusInterface>
+#include <QDBusReply>
+
+#include "LinuxSessionPropertyCache.h"
+#include "VeyonCore.h"
+
+
+LinuxSessionPropertyCache::LinuxSessionPropertyCache() :
+	QObject()
+{
+	if( QCoreApplication::instance() )
+	{
+		moveToThread( QCoreApplication::instance()->thread() );
+	}
+
+	auto bus = QDBusConnection::systemBus();
+
+	bus.connect( loginService(), {}, QStringLiteral("org.freedesktop.DBus.Properties"), QStringLiteral("PropertiesChanged"),
+				 this, SLOT(updateProperties(QString,QVariantMap,QStringList,QDBusMessage)) );
+	bus.connect( loginService(), QStringLiteral("/org/freedesktop/login1"),
+				 QStringLiteral("org.freedesktop.login1.Manager"), QStringLiteral("SessionRemoved"),
+				 this, SLOT(removeSession(QString,QDBusObjectPath)) );
+}
+
+
+
+LinuxSessionPropertyCache& LinuxSessionPropertyCache::instance()
+{
+	static LinuxSessionPropertyCache cache;
+	return cache;
+}
+
+
+
+QVariant LinuxSessionPropertyCache::property( const QString& session, const QString& property, bool logErrors )
+{
+	QMutexLocker locker( &m_mutex );
+
+	auto it = m_sessions.find( session );
+	if( it == m_sessions.end() || it->age.hasExpired( MaximumAge ) || it->properties.contains( property ) == false )
+	{
+		locker.unlock();
+		const auto properties = loadProperties( session, logErrors );
+		locker.relock();
+
+		if( properties.isEmpty() )
+		{
+			m_sessions.remove( session );
+			return {};
+		}
+
+		it = m_sessions.insert( session, {} );
+		it->properties = properties;
+		it->age.start();
+	}
+
+	const auto value = it->properties.value( property );
+	if( value.isValid() == false && logErrors )
+	{
+		vCritical() << "Could not query property" << property << "of session" << session;
+	}
+
+	return value;
+}
+
+
+
+void LinuxSessionPropertyCache::updateProperties( const QString& interface, const QVariantMap& changedProperties,
+												  const QStringList& invalidatedProperties, const QDBusMessage& message )
+{
+	if( interface != sessionInterface() )
+	{
+		return;
+	}
+
+	QMutexLocker locker( &m_mutex );
+
+	const auto it = m_sessions.find( message.path() );
+	if( it == m_sessions.end() )
+	{
+		return;
+	}
+
+	for( auto property = changedProperties.constBegin(), end = changedProperties.constEnd(); property != end; ++property )
+	{
+		it->properties[property.key()] = demarshall( property.value() );
+	}
+
+	// properties are reloaded on next access
+	for( const auto& property : invalidatedProperties )
+	{
+		it->properties.remove( property );
+	}
+}
+
+
+
+void LinuxSessionPropertyCache::removeSession( const QString& id, const QDBusObjectPath& path )
+{
+	Q_UNUSED(id)
+
+	QMutexLocker locker( &m_mutex );
+	m_sessions.remove( path.path() );
+}
+
+
+
+QVariantMap LinuxSessionPropertyCache::loadProperties( const QString& session, bool logErrors )
+{
+	QDBusInterface properties( loginService(), session, QStringLiteral("org.freedesktop.DBus.Properties"),
+							   QDBusConnection::systemBus() );
+
+	const QDBusReply<QVariantMap> reply = properties.call( QStringLiteral("GetAll"), sessionInterface() );
+
+	if( reply.isValid() == false )
+	{
+		if( logErrors )
+		{
+			vCritical() << "Could not query properties of session" << session
+						<< "error:" << reply.error().message();
+		}
+		return {};
+	}
+
+	auto sessionProperties = reply.value();
+	for( auto it = sessionProperties.begin(), end = sessionProperties.end(); it != end; ++it )
+	{
+		it.value() = demarshall( it.value() );
+	}
+
+	return sessionProperties;
+}
+
+
+
+QVariant LinuxSessionPropertyCache::demarshall( const QVariant& value )
+{
+	// structures such as User and Seat are delivered as QDBusArgument which can be read only once,
+	// so convert them into a list of plain values which can be read as often as required
+	if( value.userType() != qMetaTypeId<QDBusArgument>() )
+	{
+		return value;
+	}
+
+	const auto argument = value.value<QDBusArgument>();
+	if( argument.currentType() != QDBusArgument::StructureType )
+	{
+		return value;
+	}
+
+	QVariantList items;
+
+	argument.beginStructure();
+	while( argument.atEnd() == false )
+	{
+		const auto item = argument.asVariant();
+		if( item.userType() == qMetaTypeId<QDBusObjectPath>() )
+		{
+			items.append( item.value<QDBusObjectPath>().path() );
+		}
+		else
+		{
+			items.append( item );
+		}
+	}
+	argument.endStructure();
+
+	return items;
+}
@@ -0,0 +1,78 @@
+/*
+ * LinuxSessionPropertyCache.h - declaration of LinuxSessionPropertyCache class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QDBusMessage>
+#include <QDBusObjectPath>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QVariantMap>
+
+// caches properties of logind sessions which are loaded with a single GetAll call
+// per session and kept up to date via PropertiesChanged and SessionRemoved signals
+class LinuxSessionPropertyCache : public QObject
+{
+	Q_OBJECT
+public:
+	static LinuxSessionPropertyCache& instance();
+
+	QVariant property( const QString& session, const QString& property, bool logErrors );
+
+private Q_SLOTS:
+	void updateProperties( const QString& interface, const QVariantMap& changedProperties,
+						   const QStringList& invalidatedProperties, const QDBusMessage& message );
+	void removeSession( const QString& id, const QDBusObjectPath& path );
+
+private:
+	LinuxSessionPropertyCache();
+
+	static QString loginService()
+	{
+		return QStringLiteral("org.freedesktop.login1");
+	}
+
+	static QString sessionInterface()
+	{
+		return QStringLiteral("org.freedesktop.login1.Session");
+	}
+
+	static QVariantMap loadProperties( const QString& session, bool logErrors );
+	static QVariant demarshall( const QVariant& value );
+
+	// reload properties regularly in case change notifications are not delivered, e.g.
+	// because there's no event loop running in the process
+	static constexpr auto MaximumAge = 5000;
+
+	struct Session
+	{
+		QVariantMap properties;
+		QElapsedTimer age;
+	};
+
+	QMutex m_mutex;
+	QHash<QString, Session> m_sessions;
+
+};
@@ -24,8 +24,10 @@
 
 #include <QDataStream>
 #include <QDBusReply>
+#include <QMutex>
 #include <QProcess>
 #include <QRegularExpression>
+#include <QtConcurrent>
 
 #include "LinuxCoreFunctions.h"
 #include "LinuxDesktopIntegration.h"
@@ -40,13 +42,35 @@
 #include <X11/keysymdef.h>
 #include <X11/Xlib.h>
 
+#include <grp.h>
 #include <pwd.h>
 #include <unistd.h>
 
 
+// thread-safe replacement for getpwnam() as groups are also queried from background threads
+static passwd* lookupUser( const QString& username, passwd* entry, QByteArray& buffer )
+{
+	passwd* result = nullptr;
+	int error = 0;
+
+	buffer.resize( 4096 );
+
+	while( ( error = getpwnam_r( username.toUtf8().constData(), entry, buffer.data(), size_t(buffer.size()),
+								 &result ) ) == ERANGE )
+	{
+		buffer.resize( buffer.size() * 2 );
+	}
+
+	return error == 0 ? result : nullptr;
+}
+
+
+
 QString LinuxUserFunctions::fullName( const QString& username )
 {
-	const auto pw_entry = getpwnam(username.toUtf8().constData());
+	passwd passwdEntry{};
+	QByteArray buffer;
+	const auto pw_entry = lookupUser( username, &passwdEntry, buffer );
 
 	if( pw_entry )
 	{
@@ -71,6 +95,76 @@ QStringList LinuxUserFunctions::userGroups( bool queryDomainGroups )
 {
 	Q_UNUSED(queryDomainGroups)
 
+	return cachedGroups( {}, &LinuxUserFunctions::queryUserGroups );
+}
+
+
+
+QStringList LinuxUserFunctions::groupsOfUser( const QString& username, bool queryDomainGroups )
+{
+	Q_UNUSED(queryDomainGroups)
+
+	if( username.isEmpty() )
+	{
+		return {};
+	}
+
+	const auto includePrimaryGroup = LinuxPlatformConfiguration( &VeyonCore::config() ).includePrimaryGroupInGroupMemberships();
+
+	return cachedGroups( username, [username, includePrimaryGroup]() {
+		return queryGroupsOfUser( username, includePrimaryGroup );
+	} );
+}
+
+
+
+QStringList LinuxUserFunctions::cachedGroups( const QString& key, const std::function<QStringList()>& query )
+{
+	// shared by all instances so that background refreshes never refer to a destroyed instance
+	static QMutex groupCacheMutex;
+	static QHash<QString, CachedGroups> groupCache;
+
+	QMutexLocker locker( &groupCacheMutex );
+
+	auto it = groupCache.find( key );
+	if( it != groupCache.end() && it->timer.elapsed() < GroupCacheMaximumAge )
+	{
+		// serve outdated entries immediately and refresh them in the background
+		if( it->timer.elapsed() >= GroupCacheRefreshAge && it->refreshing == false )
+		{
+			it->refreshing = true;
+
+			(void) QtConcurrent::run( [key, query]() {
+				const auto groups = query();
+
+				QMutexLocker refreshLocker( &groupCacheMutex );
+				auto& entry = groupCache[key];
+				entry.groups = groups;
+				entry.timer.restart();
+				entry.refreshing = false;
+			} );
+		}
+
+		return it->groups;
+	}
+
+	locker.unlock();
+
+	const auto groups = query();
+
+	locker.relock();
+
+	auto& entry = groupCache[key];
+	entry.groups = groups;
+	entry.timer.restart();
+
+	return groups;
+}
+
+
+
+QStringList LinuxUserFunctions::queryUserGroups()
+{
 	QStringList groupList;
 
 	QProcess getentProcess;
@@ -173,10 +267,87 @@ QStringList LinuxUserFunctions::userGroups( bool queryDomainGroups )
 
 
 
-QStringList LinuxUserFunctions::groupsOfUser( const QString& username, bool queryDomainGroups )
+QStringList LinuxUserFunctions::queryGroupsOfUser( const QString& username, bool includePrimaryGroup )
 {
-	Q_UNUSED(queryDomainGroups)
+	passwd passwdEntry{};
+	QByteArray passwdBuffer;
+	const auto pw_entry = lookupUser( username, &passwdEntry, passwdBuffer );
+	if( pw_entry == nullptr )
+	{
+		return queryGroupsOfUserFromDatabase( username );
+	}
+
+	// let NSS determine the groups of this user only instead of enumerating the whole group database
+	const auto primaryGroupId = pw_entry->pw_gid;
+	int groupCount = 32;
+	QVector<gid_t> groupIds( groupCount );
+
+	while( getgrouplist( pw_entry->pw_name, primaryGroupId, groupIds.data(), &groupCount ) < 0 )
+	{
+		if( groupCount <= groupIds.size() )
+		{
+			return queryGroupsOfUserFromDatabase( username );
+		}
+		groupIds.resize( groupCount );
+	}
+
+	groupIds.resize( groupCount );
+
+	QStringList groupList;
+	groupList.reserve( groupCount );
+
+	QByteArray buffer( 4096, 0 );
+
+	for( const auto groupId : qAsConst(groupIds) )
+	{
+		group groupEntry{};
+		group* result = nullptr;
+		int error = 0;
+
+		while( ( error = getgrgid_r( groupId, &groupEntry, buffer.data(), size_t(buffer.size()), &result ) ) == ERANGE )
+		{
+			buffer.resize( buffer.size() * 2 );
+		}
+
+		if( error == 0 && result )
+		{
+			// only report the primary group if the user is listed as member explicitly
+			// (as with the group database) unless configured otherwise
+			if( groupId == primaryGroupId && includePrimaryGroup == false &&
+				isGroupMember( result, pw_entry->pw_name ) == false )
+			{
+				continue;
+			}
+
+			groupList += QString::fromUtf8( result->gr_name ); // clazy:exclude=reserve-candidates
+		}
+	}
+
+	groupList.removeDuplicates();
+	groupList.removeAll( QString() );
+
+	return groupList;
+}
+
+
+
+bool LinuxUserFunctions::isGroupMember( const group* groupEntry, const char* username )
+{
+	for( auto member = groupEntry->gr_mem; member && *member; ++member )
+	{
+		if( qstrcmp( *member, username ) == 0 )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 
+
+QStringList LinuxUserFunctions::queryGroupsOfUserFromDatabase( const QString& username )
+{
 	QStringList groupList;
 
 	QProcess getentProcess;
@@ -412,6 +583,20 @@ void LinuxUserFunctions::logoff()
 
 bool LinuxUserFunctions::authenticate( const QString& username, const Password& password )
 {
+	const auto pamService = LinuxPlatformConfiguration( &VeyonCore::config() ).pamServiceName();
+
+	switch( m_authHelper.authenticate( username.toUtf8(), password.toByteArray(), pamService.toUtf8(), AuthHelperTimeout ) )
+	{
+	case LinuxAuthHelper::Result::Success:
+		vDebug() << "User authenticated successfully";
+		return true;
+	case LinuxAuthHelper::Result::Failure:
+		return false;
+	case LinuxAuthHelper::Result::Unavailable:
+		break;
+	}
+
+	// fall back to running the helper once for this request
 	QProcess p;
 	p.start( QStringLiteral( "veyon-auth-helper" ), QStringList{}, QProcess::ReadWrite | QProcess::Unbuffered );
 	if( p.waitForStarted() == false )
@@ -420,8 +605,6 @@ bool LinuxUserFunctions::authenticate( const QString& username, const Password&
 		return false;
 	}
 
-	const auto pamService = LinuxPlatformConfiguration( &VeyonCore::config() ).pamServiceName();
-
 	QDataStream ds( &p );
 	ds << username.toUtf8();
 	ds << password.toByteArray();
@@ -24,9 +24,13 @@
 
 #pragma once
 
+#include <QElapsedTimer>
+
+#include "LinuxAuthHelper.h"
 #include "LogonHelper.h"
 #include "PlatformUserFunctions.h"
 
+#include <grp.h>
 #include <pwd.h>
 
 // clazy:excludeall=copyable-polymorphic
@@ -56,7 +60,24 @@ public:
 
 private:
 	static constexpr auto AuthHelperTimeout = 10000;
+	static constexpr auto GroupCacheRefreshAge = 60000;
+	static constexpr auto GroupCacheMaximumAge = 600000;
+
+	struct CachedGroups
+	{
+		QStringList groups;
+		QElapsedTimer timer;
+		bool refreshing{false};
+	};
+
+	static QStringList cachedGroups( const QString& key, const std::function<QStringList()>& query );
+
+	static QStringList queryUserGroups();
+	static QStringList queryGroupsOfUser( const QString& username, bool includePrimaryGroup );
+	static bool isGroupMember( const group* groupEntry, const char* username );
+	static QStringList queryGroupsOfUserFromDatabase( const QString& username );
 
 	LogonHelper m_logonHelper{};
+	LinuxAuthHelper m_authHelper{};
 
 };
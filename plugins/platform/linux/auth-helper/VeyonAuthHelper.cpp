@@ -68,15 +68,8 @@ static int pam_conv( int num_msg, const struct pam_message** msg, struct pam_res
 }
 
 
-int main()
+static int authenticate( QByteArray& message )
 {
-	QFile stdIn;
-	stdIn.open( 0, QFile::ReadOnly | QFile::Unbuffered );
-	QDataStream ds( &stdIn );
-	ds >> pam_username;
-	ds >> pam_password;
-	ds >> pam_service;
-
 	if( pam_service.isEmpty() )
 	{
 		pam_service = QByteArrayLiteral("login");
@@ -90,23 +83,87 @@ int main()
 		err = pam_authenticate( pamh, PAM_SILENT );
 		if( err != PAM_SUCCESS )
 		{
-			printf( "pam_authenticate: %s\n", pam_strerror( pamh, err ) );
+			message = QByteArrayLiteral("pam_authenticate: ") + pam_strerror( pamh, err );
+		}
+		else
+		{
+			err = pam_acct_mgmt( pamh, PAM_SILENT );
+			if( err != PAM_SUCCESS )
+			{
+				message = QByteArrayLiteral("pam_acct_mgmt: ") + pam_strerror( pamh, err );
+			}
 		}
-        else
-        {
-            err = pam_acct_mgmt( pamh, PAM_SILENT );
-            if( err != PAM_SUCCESS )
-            {
-                printf( "pam_acct_mgmt: %s\n", pam_strerror( pamh, err ) );
-            }
-        }
 	}
 	else
 	{
-		printf( "pam_start: %s\n", pam_strerror( pamh, err ) );
+		message = QByteArrayLiteral("pam_start: ") + pam_strerror( pamh, err );
 	}
 
 	pam_end( pamh, err );
 
+	pam_password.fill( 0 );
+
+	return err;
+}
+
+
+
+// serve requests of the form (id, username, password, service) until stdin is closed
+// and reply with (id, PAM result code, error message) each
+static int serveRequests()
+{
+	QFile stdIn;
+	stdIn.open( 0, QFile::ReadOnly | QFile::Unbuffered );
+	QFile stdOut;
+	stdOut.open( 1, QFile::WriteOnly | QFile::Unbuffered );
+
+	QDataStream in( &stdIn );
+	QDataStream out( &stdOut );
+
+	while( true )
+	{
+		quint32 requestId = 0;
+		in >> requestId >> pam_username >> pam_password >> pam_service;
+		if( in.status() != QDataStream::Ok )
+		{
+			break;
+		}
+
+		QByteArray message;
+		const auto err = authenticate( message );
+
+		out << requestId << qint32(err) << message;
+		if( out.status() != QDataStream::Ok )
+		{
+			break;
+		}
+	}
+
+	return 0;
+}
+
+
+
+int main( int argc, char** argv )
+{
+	if( argc > 1 && qstrcmp( argv[1], "--persistent" ) == 0 )
+	{
+		return serveRequests();
+	}
+
+	QFile stdIn;
+	stdIn.open( 0, QFile::ReadOnly | QFile::Unbuffered );
+	QDataStream ds( &stdIn );
+	ds >> pam_username;
+	ds >> pam_password;
+	ds >> pam_service;
+
+	QByteArray message;
+	const auto err = authenticate( message );
+	if( err != PAM_SUCCESS )
+	{
+		printf( "%s\n", message.constData() );
+	}
+
 	return err == PAM_SUCCESS ? 0 : -1;
 }
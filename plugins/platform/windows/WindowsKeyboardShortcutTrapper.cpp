@@ -24,12 +24,37 @@
 
 #include <windows.h>
 
+#include <array>
+#include <atomic>
+
 #include "WindowsKeyboardShortcutTrapper.h"
 
 // clazy:excludeall=non-pod-global-static
 
-static QMutex __trappedShortcutsMutex;
-static QList<WindowsKeyboardShortcutTrapper::Shortcut> __trappedShortcuts;
+using Shortcut = KeyboardShortcutTrapper::Shortcut;
+
+// shortcuts to trap for each virtual key code if pressed together with Alt or Ctrl
+struct TrappedShortcuts
+{
+	Shortcut withAlt{KeyboardShortcutTrapper::NoShortcut};
+	Shortcut withCtrl{KeyboardShortcutTrapper::NoShortcut};
+};
+
+static constexpr auto __trappedShortcutTable = [] {
+	std::array<TrappedShortcuts, 256> table{};
+	table[VK_TAB].withAlt = KeyboardShortcutTrapper::AltTab;
+	table[VK_ESCAPE].withAlt = KeyboardShortcutTrapper::AltEsc;
+	table[VK_ESCAPE].withCtrl = KeyboardShortcutTrapper::CtrlEsc;
+	table[VK_SPACE].withAlt = KeyboardShortcutTrapper::AltSpace;
+	table[VK_F4].withAlt = KeyboardShortcutTrapper::AltF4;
+	return table;
+}();
+
+// single producer (hook) single consumer (poll timer) queue so the hook never
+// has to lock or allocate - shortcuts are dropped if the queue is full
+static std::array<Shortcut, 64> __trappedShortcuts{};
+static std::atomic<uint> __trappedShortcutsWriteIndex{0};
+static std::atomic<uint> __trappedShortcutsReadIndex{0};
 
 QMutex WindowsKeyboardShortcutTrapper::s_refCntMutex;
 int WindowsKeyboardShortcutTrapper::s_refCnt = 0;
@@ -38,63 +63,54 @@ int WindowsKeyboardShortcutTrapper::s_refCnt = 0;
 static HHOOK __lowLevelKeyboardHookHandle = nullptr; // hook handle
 
 
+static void enqueueTrappedShortcut( Shortcut shortcut )
+{
+	const auto writeIndex = __trappedShortcutsWriteIndex.load( std::memory_order_relaxed );
+	if( writeIndex - __trappedShortcutsReadIndex.load( std::memory_order_acquire ) < __trappedShortcuts.size() )
+	{
+		__trappedShortcuts[writeIndex % __trappedShortcuts.size()] = shortcut;
+		__trappedShortcutsWriteIndex.store( writeIndex + 1, std::memory_order_release );
+	}
+}
+
+
+
 LRESULT CALLBACK TaskKeyHookLL( int nCode, WPARAM wp, LPARAM lp )
 {
 	auto pkh = reinterpret_cast<KBDLLHOOKSTRUCT *>( static_cast<intptr_t>( lp ) );
-	static QList<KeyboardShortcutTrapper::Shortcut> pressed;
 
-	if( nCode == HC_ACTION )
+	// bit mask of shortcuts whose key down event has been trapped
+	static uint pressed = 0;
+
+	if( nCode == HC_ACTION && pkh->vkCode < __trappedShortcutTable.size() )
 	{
-		BOOL isCtrlKeyDown = GetAsyncKeyState( VK_CONTROL ) >> ( ( sizeof( SHORT ) * 8 ) - 1 );
-		QMutexLocker m( &__trappedShortcutsMutex );
+		const auto& trappedShortcuts = __trappedShortcutTable[pkh->vkCode];
 
-		KeyboardShortcutTrapper::Shortcut shortcut = KeyboardShortcutTrapper::NoShortcut;
+		auto shortcut = KeyboardShortcutTrapper::NoShortcut;
 
-		if( pkh->vkCode == VK_ESCAPE && isCtrlKeyDown )
+		if( trappedShortcuts.withCtrl != KeyboardShortcutTrapper::NoShortcut &&
+			GetAsyncKeyState( VK_CONTROL ) >> ( ( sizeof( SHORT ) * 8 ) - 1 ) )
 		{
-			shortcut = KeyboardShortcutTrapper::CtrlEsc;
+			shortcut = trappedShortcuts.withCtrl;
 		}
-		else if( pkh->vkCode == VK_TAB && pkh->flags & LLKHF_ALTDOWN )
+		else if( trappedShortcuts.withAlt != KeyboardShortcutTrapper::NoShortcut && pkh->flags & LLKHF_ALTDOWN )
 		{
-			shortcut = KeyboardShortcutTrapper::AltTab;
-		}
-		else if( pkh->vkCode == VK_ESCAPE && pkh->flags & LLKHF_ALTDOWN )
-		{
-			shortcut = KeyboardShortcutTrapper::AltEsc;
-		}
-		else if( pkh->vkCode == VK_SPACE && pkh->flags & LLKHF_ALTDOWN )
-		{
-			shortcut = KeyboardShortcutTrapper::AltSpace;
-		}
-		else if( pkh->vkCode == VK_F4 && pkh->flags & LLKHF_ALTDOWN )
-		{
-			shortcut = KeyboardShortcutTrapper::AltF4;
+			shortcut = trappedShortcuts.withAlt;
 		}
 		else if( pkh->vkCode == VK_LWIN || pkh->vkCode == VK_RWIN )
 		{
-			pressed.removeAll( KeyboardShortcutTrapper::SuperKeyDown );
-			pressed.removeAll( KeyboardShortcutTrapper::SuperKeyUp );
-			if( wp == WM_KEYDOWN )
-			{
-				shortcut = KeyboardShortcutTrapper::SuperKeyDown;
-			}
-			else
-			{
-				shortcut = KeyboardShortcutTrapper::SuperKeyUp;
-			}
+			pressed &= ~( ( 1u << KeyboardShortcutTrapper::SuperKeyDown ) | ( 1u << KeyboardShortcutTrapper::SuperKeyUp ) );
+			shortcut = wp == WM_KEYDOWN ? KeyboardShortcutTrapper::SuperKeyDown : KeyboardShortcutTrapper::SuperKeyUp;
 		}
 
 		if( shortcut != KeyboardShortcutTrapper::NoShortcut )
 		{
-			if( pressed.contains( shortcut ) == false )
-			{
-				__trappedShortcuts.push_back( shortcut );
-				pressed << shortcut;
-			}
-			else
+			const auto mask = 1u << shortcut;
+			if( ( pressed & mask ) == 0 )
 			{
-				pressed.removeAll( shortcut );
+				enqueueTrappedShortcut( shortcut );
 			}
+			pressed ^= mask;
 			return 1;
 		}
 	}
@@ -162,10 +178,13 @@ void WindowsKeyboardShortcutTrapper::setEnabled( bool on )
 
 void WindowsKeyboardShortcutTrapper::forwardTrappedShortcuts()
 {
-	QMutexLocker m( &__trappedShortcutsMutex );
+	auto readIndex = __trappedShortcutsReadIndex.load( std::memory_order_relaxed );
+	const auto writeIndex = __trappedShortcutsWriteIndex.load( std::memory_order_acquire );
 
-	while( __trappedShortcuts.isEmpty() == false )
+	while( readIndex != writeIndex )
 	{
-		Q_EMIT shortcutTrapped( __trappedShortcuts.takeFirst() );
+		const auto shortcut = __trappedShortcuts[readIndex % __trappedShortcuts.size()];
+		__trappedShortcutsReadIndex.store( ++readIndex, std::memory_order_release );
+		Q_EMIT shortcutTrapped( shortcut );
 	}
 }
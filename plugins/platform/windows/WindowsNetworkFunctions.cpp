@@ -182,10 +182,72 @@ cleanup:
 
 
 
+static bool WindowsFirewallFindApp2( INetFwPolicy2* fwPolicy2,
+									 const wchar_t* fwApplicationPath,
+									 const wchar_t* fwName,
+									 bool* upToDate )
+{
+	*upToDate = false;
+
+	INetFwRules *pFwRules = nullptr;
+	INetFwRule *pFwRule = nullptr;
+
+	if( FAILED( fwPolicy2->get_Rules( &pFwRules ) ) )
+	{
+		return false;
+	}
+
+	BSTR fwBstrRuleName = SysAllocString( fwName );
+	const auto found = SUCCEEDED( pFwRules->Item( fwBstrRuleName, &pFwRule ) ) && pFwRule != nullptr;
+	SysFreeString( fwBstrRuleName );
+
+	if( found )
+	{
+		BSTR fwBstrApplicationPath = nullptr;
+		NET_FW_ACTION action = NET_FW_ACTION_BLOCK;
+		VARIANT_BOOL ruleEnabled = VARIANT_FALSE;
+		LONG protocol = 0;
+		LONG profiles = 0;
+
+		if( SUCCEEDED( pFwRule->get_ApplicationName( &fwBstrApplicationPath ) ) &&
+			SUCCEEDED( pFwRule->get_Action( &action ) ) &&
+			SUCCEEDED( pFwRule->get_Enabled( &ruleEnabled ) ) &&
+			SUCCEEDED( pFwRule->get_Protocol( &protocol ) ) &&
+			SUCCEEDED( pFwRule->get_Profiles( &profiles ) ) )
+		{
+			*upToDate = fwBstrApplicationPath != nullptr &&
+						_wcsicmp( fwBstrApplicationPath, fwApplicationPath ) == 0 &&
+						action == NET_FW_ACTION_ALLOW &&
+						ruleEnabled == VARIANT_TRUE &&
+						protocol == NET_FW_IP_PROTOCOL_TCP &&
+						profiles == NET_FW_PROFILE2_ALL;
+		}
+
+		SysFreeString( fwBstrApplicationPath );
+		pFwRule->Release();
+	}
+
+	pFwRules->Release();
+
+	return found;
+}
+
+
+
 static bool configureFirewallException( INetFwPolicy2* fwPolicy2, const wchar_t* fwApplicationPath, const wchar_t* fwName, bool enabled )
 {
-	// always remove firewall exception first
-	WindowsFirewallRemoveApp2( fwPolicy2, fwName );
+	// only modify rules if required as recreating them is slow
+	bool upToDate = false;
+	const auto exists = WindowsFirewallFindApp2( fwPolicy2, fwApplicationPath, fwName, &upToDate );
+	if( exists == enabled && ( enabled == false || upToDate ) )
+	{
+		return true;
+	}
+
+	if( exists )
+	{
+		WindowsFirewallRemoveApp2( fwPolicy2, fwName );
+	}
 
 	if( enabled )
 	{
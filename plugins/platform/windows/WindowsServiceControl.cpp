@@ -189,6 +189,28 @@ bool WindowsServiceControl::stop()
 
 
 
+bool WindowsServiceControl::reload()
+{
+	if( checkService() == false )
+	{
+		return false;
+	}
+
+	SERVICE_STATUS status;
+	if( ControlService( m_serviceHandle, SERVICE_CONTROL_PARAMCHANGE, &status ) )
+	{
+		return true;
+	}
+
+	const auto error = GetLastError();
+	vWarning() << "failed to reload service" << m_name
+			   << qUtf8Printable(QStringLiteral("(error %1)").arg(error));
+
+	return false;
+}
+
+
+
 bool WindowsServiceControl::install( const QString& filePath, const QString& displayName  )
 {
 	const auto binaryPath = QStringLiteral("\"%1\"").arg( QString( filePath ).replace( QLatin1Char('"'), QString() ) );
@@ -41,6 +41,7 @@ public:
 	bool isRunning();
 	bool start();
 	bool stop();
+	bool reload();
 	bool install( const QString& filePath, const QString& displayName );
 	bool uninstall();
 	bool setStartType( int startType );
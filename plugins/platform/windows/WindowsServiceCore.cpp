@@ -116,14 +116,6 @@ WindowsServiceCore::WindowsServiceCore( const QString& name,
 {
 	s_instance = this;
 
-	// allocate session 0 (PlatformSessionFunctions::DefaultSessionId) so we can always assign it to the console session
-	if( m_sessionManager.mode() != PlatformSessionManager::Mode::Active ||
-		( WtsSessionManager::activeSessions().size() <= 1 &&
-		  WtsSessionManager::activeConsoleSession() != WtsSessionManager::InvalidSession ) )
-	{
-		m_sessionManager.openSession( QStringLiteral("0 (console)") );
-	}
-
 	// enable privileges required to create process with access token from other process
 	WindowsCoreFunctions::enablePrivilege( SE_ASSIGNPRIMARYTOKEN_NAME, true );
 	WindowsCoreFunctions::enablePrivilege( SE_INCREASE_QUOTA_NAME, true );
@@ -162,19 +154,54 @@ bool WindowsServiceCore::runAsService()
 
 void WindowsServiceCore::manageServerInstances()
 {
-	m_serverShutdownEvent = CreateEvent( nullptr, false, false, L"Global\\SessionEventUltra" );
-	ResetEvent( m_serverShutdownEvent );
+	// manual reset so that signalling it reaches all server instances at once
+	m_serverShutdownEvent = CreateEvent( nullptr, true, false, L"Global\\SessionEventUltra" );
 
-	if( m_sessionManager.mode() != PlatformSessionManager::Mode::Local )
+	do
 	{
-		manageServersForAllSessions();
+		// start over with a new session manager so session management settings are read again
+		m_serviceRestartRequested = 0;
+		ResetEvent( m_serverShutdownEvent );
+
+		initSessionManager();
+
+		if( m_sessionManager->mode() != PlatformSessionManager::Mode::Local )
+		{
+			manageServersForAllSessions();
+		}
+		else
+		{
+			manageServerForConsoleSession();
+		}
+
+		delete m_sessionManager;
+		m_sessionManager = nullptr;
 	}
-	else
+	while( m_serviceRestartRequested != 0 && m_serviceStopRequested == 0 );
+
+	CloseHandle( m_serverShutdownEvent );
+}
+
+
+
+void WindowsServiceCore::initSessionManager()
+{
+	m_sessionManager = new PlatformSessionManager;
+
+	// allocate session 0 (PlatformSessionFunctions::DefaultSessionId) so we can always assign it to the console session
+	if( m_sessionManager->mode() != PlatformSessionManager::Mode::Active ||
+		( WtsSessionManager::activeSessions().size() <= 1 &&
+		  WtsSessionManager::activeConsoleSession() != WtsSessionManager::InvalidSession ) )
 	{
-		manageServerForConsoleSession();
+		m_sessionManager->openSession( QStringLiteral("0 (console)") );
 	}
+}
 
-	CloseHandle( m_serverShutdownEvent );
+
+
+bool WindowsServiceCore::isStopRequested() const
+{
+	return m_serviceStopRequested != 0 || m_serviceRestartRequested != 0;
 }
 
 
@@ -183,7 +210,7 @@ void WindowsServiceCore::manageServersForAllSessions()
 {
 	QMap<WtsSessionManager::SessionId, VeyonServerProcess*> serverProcesses;
 
-	const auto activeSessionOnly = m_sessionManager.mode() == PlatformSessionManager::Mode::Active;
+	const auto activeSessionOnly = m_sessionManager->mode() == PlatformSessionManager::Mode::Active;
 
 	do
 	{
@@ -207,6 +234,28 @@ void WindowsServiceCore::manageServersForAllSessions()
 			wtsSessionIds.removeAll( consoleSessionId );
 		}
 
+		const auto restartServers = reloadConfiguration();
+		if( isStopRequested() )
+		{
+			break;
+		}
+
+		if( restartServers )
+		{
+			// restart servers in place so they keep their session IDs and thereby their ports
+			SetEvent( m_serverShutdownEvent );
+			for( auto serverProcess : qAsConst(serverProcesses) )
+			{
+				serverProcess->stop();
+			}
+			ResetEvent( m_serverShutdownEvent );
+
+			for( auto it = serverProcesses.constBegin(), end = serverProcesses.constEnd(); it != end; ++it )
+			{
+				it.value()->start( it.key(), m_dataManager.token() );
+			}
+		}
+
 		for( auto it = serverProcesses.begin(); it != serverProcesses.end(); )
 		{
 			if( wtsSessionIds.contains( it.key() ) == false )
@@ -214,7 +263,7 @@ void WindowsServiceCore::manageServersForAllSessions()
 				delete it.value();
 				if( it.key() != consoleSessionId || excludeConsoleSession )
 				{
-					m_sessionManager.closeSession( QString::number(it.key() ) );
+					m_sessionManager->closeSession( QString::number(it.key() ) );
 				}
 				it = serverProcesses.erase( it );
 			}
@@ -224,26 +273,42 @@ void WindowsServiceCore::manageServersForAllSessions()
 			}
 		}
 
+		bool serverStarted = false;
+
 		for( auto wtsSessionId : wtsSessionIds )
 		{
 			if( serverProcesses.contains( wtsSessionId ) == false )
 			{
+				// spread server starts for many sessions (e.g. during a login storm) over time
+				if( serverStarted &&
+					( WaitForSingleObject( m_stopServiceEvent, ServerStartInterval ) == WAIT_OBJECT_0 ||
+					  isStopRequested() ) )
+				{
+					break;
+				}
+
 				if( wtsSessionId != consoleSessionId || includeConsoleSession )
 				{
-					m_sessionManager.openSession( QString::number(wtsSessionId) );
+					m_sessionManager->openSession( QString::number(wtsSessionId) );
 				}
 
 				auto serverProcess = new VeyonServerProcess;
 				serverProcess->start( wtsSessionId, m_dataManager.token() );
 
 				serverProcesses[wtsSessionId] = serverProcess;
+				serverStarted = true;
 			}
 		}
 
+		if( isStopRequested() )
+		{
+			break;
+		}
+
 		std::array<HANDLE, 2> events{m_sessionChangeEvent, m_stopServiceEvent};
 		WaitForMultipleObjects(events.size(), events.data(), FALSE, SessionPollingInterval);
 
-	} while (m_serviceStopRequested == 0);
+	} while (isStopRequested() == false);
 
 	vInfo() << "Service shutdown";
 
@@ -263,7 +328,13 @@ void WindowsServiceCore::manageServerForConsoleSession()
 	QElapsedTimer lastServerStart;
 
 	do {
-		const auto sessionChanged = m_sessionChanged.testAndSetOrdered(1, 0);
+		const auto configurationChanged = reloadConfiguration();
+		if( isStopRequested() )
+		{
+			break;
+		}
+
+		const auto sessionChanged = m_sessionChanged.testAndSetOrdered(1, 0) || configurationChanged;
 		const auto wtsSessionId = WtsSessionManager::activeConsoleSession();
 
 		if( oldWtsSessionId != wtsSessionId || sessionChanged )
@@ -280,12 +351,13 @@ void WindowsServiceCore::manageServerForConsoleSession()
 				while( lastServerStart.elapsed() < MinimumServerUptimeTime && veyonServerProcess.isRunning() );
 
 				veyonServerProcess.stop();
+				ResetEvent( m_serverShutdownEvent );
 			}
 
 			if( wtsSessionId != WtsSessionManager::InvalidSession || sessionChanged )
 			{
 				veyonServerProcess.stop();
-				if (m_serviceStopRequested == 0 &&
+				if (isStopRequested() == false &&
 					wtsSessionId != WtsSessionManager::InvalidSession)
 				{
 					veyonServerProcess.start( wtsSessionId, m_dataManager.token() );
@@ -309,7 +381,7 @@ void WindowsServiceCore::manageServerForConsoleSession()
 		std::array<HANDLE, 2> events{m_sessionChangeEvent, m_stopServiceEvent};
 		WaitForMultipleObjects(events.size(), events.data(), FALSE, SessionPollingInterval);
 
-	} while (m_serviceStopRequested == 0);
+	} while (isStopRequested() == false);
 
 	vInfo() << "Service shutdown";
 
@@ -319,6 +391,32 @@ void WindowsServiceCore::manageServerForConsoleSession()
 
 
 
+bool WindowsServiceCore::reloadConfiguration()
+{
+	if( m_configurationChanged.testAndSetOrdered(1, 0) == false )
+	{
+		return false;
+	}
+
+	vInfo() << "Reloading configuration";
+
+	const auto reloadMode = VeyonCore::config().reloadForService();
+
+	VeyonCore::instance()->reapplyConfiguration();
+
+	if( reloadMode == VeyonConfiguration::ServiceReloadMode::RestartService )
+	{
+		// leave the server management loop and start over
+		vInfo() << "Restarting service to apply changed service settings";
+		m_serviceRestartRequested = 1;
+		return false;
+	}
+
+	return reloadMode == VeyonConfiguration::ServiceReloadMode::RestartServers;
+}
+
+
+
 void WindowsServiceCore::serviceMainStatic( DWORD argc, LPWSTR* argv )
 {
 	Q_UNUSED(argc)
@@ -370,8 +468,12 @@ void WindowsServiceCore::serviceMain()
 	SasEventListener sasEventListener;
 	sasEventListener.start();
 
+	WtsSessionManager::setSessionTrackingEnabled( true );
+
 	m_serviceEntryPoint();
 
+	WtsSessionManager::setSessionTrackingEnabled( false );
+
 	CloseHandle(m_sessionChangeEvent);
 	CloseHandle( m_stopServiceEvent );
 
@@ -433,12 +535,21 @@ DWORD WindowsServiceCore::serviceCtrl( DWORD ctrlCode, DWORD eventType, LPVOID e
 		// Service control manager just wants to know our state
 		break;
 
+	case SERVICE_CONTROL_PARAMCHANGE:
+		m_configurationChanged = 1;
+		SetEvent(m_sessionChangeEvent);
+		break;
+
 	case SERVICE_CONTROL_SESSIONCHANGE:
 		if( sessionChangeEventTypes.contains( eventType ) )
 		{
 			const auto notification = reinterpret_cast<WTSSESSION_NOTIFICATION *>( eventData );
 			vDebug() << "session change event:" << sessionChangeEventTypes[eventType]
 					 << "for session" << ( notification ? notification->dwSessionId : -1 );
+			if( notification )
+			{
+				WtsSessionManager::invalidateSession( notification->dwSessionId );
+			}
 		}
 		switch( eventType )
 		{
@@ -481,7 +592,8 @@ bool WindowsServiceCore::reportStatus( DWORD state, DWORD exitCode, DWORD waitHi
 	}
 	else
 	{
-		m_status.dwControlsAccepted = SERVICE_ACCEPT_STOP | SERVICE_ACCEPT_SHUTDOWN | SERVICE_ACCEPT_SESSIONCHANGE;
+		m_status.dwControlsAccepted = SERVICE_ACCEPT_STOP | SERVICE_ACCEPT_SHUTDOWN | SERVICE_ACCEPT_SESSIONCHANGE |
+									  SERVICE_ACCEPT_PARAMCHANGE;
 	}
 
 	// Save the new status we've been given
@@ -43,8 +43,11 @@ public:
 	void manageServerInstances();
 
 private:
+	void initSessionManager();
+	bool isStopRequested() const;
 	void manageServersForAllSessions();
 	void manageServerForConsoleSession();
+	bool reloadConfiguration();
 
 	static void WINAPI serviceMainStatic( DWORD argc, LPWSTR* argv );
 	static DWORD WINAPI serviceCtrlStatic( DWORD ctrlCode, DWORD eventType, LPVOID eventData, LPVOID context );
@@ -64,11 +67,14 @@ private:
 	HANDLE m_serverShutdownEvent{nullptr};
 	QAtomicInt m_serviceStopRequested{0};
 	QAtomicInt m_sessionChanged{0};
+	QAtomicInt m_configurationChanged{0};
+	QAtomicInt m_serviceRestartRequested{0};
 
 	ServiceDataManager m_dataManager{};
-	PlatformSessionManager m_sessionManager{};
+	PlatformSessionManager* m_sessionManager{nullptr};
 
 	static constexpr auto SessionPollingInterval = 5000;
+	static constexpr auto ServerStartInterval = 200;
 	static constexpr auto MinimumServerUptimeTime = 10000;
 	static constexpr auto ServiceStartTimeout = 15000;
 
@@ -62,6 +62,13 @@ bool WindowsServiceFunctions::stop( const QString& name )
 
 
 
+bool WindowsServiceFunctions::reload( const QString& name )
+{
+	return WindowsServiceControl( name ).reload();
+}
+
+
+
 bool WindowsServiceFunctions::install( const QString& name, const QString& filePath,
 									   StartMode startMode, const QString& displayName )
 {
@@ -29,6 +29,15 @@
 #include "WtsSessionManager.h"
 
 
+QMutex WtsSessionManager::s_registryMutex;
+bool WtsSessionManager::s_sessionTracking = false;
+bool WtsSessionManager::s_sessionListValid = false;
+WtsSessionManager::SessionList WtsSessionManager::s_sessionList;
+QElapsedTimer WtsSessionManager::s_sessionListTimer;
+QHash<WtsSessionManager::SessionId, WtsSessionManager::ProcessEntry> WtsSessionManager::s_winlogonProcesses;
+QHash<QString, WtsSessionManager::ProcessEntry> WtsSessionManager::s_userProcesses;
+
+
 WtsSessionManager::SessionId WtsSessionManager::currentSession()
 {
 	auto sessionId = InvalidSession;
@@ -51,6 +60,25 @@ WtsSessionManager::SessionId WtsSessionManager::activeConsoleSession()
 
 
 WtsSessionManager::SessionList WtsSessionManager::activeSessions()
+{
+	QMutexLocker locker( &s_registryMutex );
+
+	if( s_sessionTracking && s_sessionListValid &&
+		s_sessionListTimer.elapsed() < SessionListMaximumAge )
+	{
+		return s_sessionList;
+	}
+
+	s_sessionList = queryActiveSessions();
+	s_sessionListValid = true;
+	s_sessionListTimer.restart();
+
+	return s_sessionList;
+}
+
+
+
+WtsSessionManager::SessionList WtsSessionManager::queryActiveSessions()
 {
 	PWTS_SESSION_INFO sessions;
 	DWORD sessionCount = 0;
@@ -154,6 +182,31 @@ WtsSessionManager::ProcessId WtsSessionManager::findWinlogonProcessId( SessionId
 		return InvalidProcess;
 	}
 
+	QMutexLocker locker( &s_registryMutex );
+
+	const auto cachedProcess = s_winlogonProcesses.value( sessionId );
+	if( isValid( cachedProcess ) )
+	{
+		return cachedProcess.processId;
+	}
+
+	const auto processId = queryWinlogonProcessId( sessionId );
+	if( processId != InvalidProcess )
+	{
+		s_winlogonProcesses[sessionId] = processEntry( processId );
+	}
+	else
+	{
+		s_winlogonProcesses.remove( sessionId );
+	}
+
+	return processId;
+}
+
+
+
+WtsSessionManager::ProcessId WtsSessionManager::queryWinlogonProcessId( SessionId sessionId )
+{
 	PWTS_PROCESS_INFO processInfo = nullptr;
 	DWORD processCount = 0;
 
@@ -188,6 +241,31 @@ WtsSessionManager::ProcessId WtsSessionManager::findWinlogonProcessId( SessionId
 
 
 WtsSessionManager::ProcessId WtsSessionManager::findUserProcessId( const QString& userName )
+{
+	QMutexLocker locker( &s_registryMutex );
+
+	const auto cachedProcess = s_userProcesses.value( userName );
+	if( isValid( cachedProcess ) )
+	{
+		return cachedProcess.processId;
+	}
+
+	const auto processId = queryUserProcessId( userName );
+	if( processId != InvalidProcess )
+	{
+		s_userProcesses[userName] = processEntry( processId );
+	}
+	else
+	{
+		s_userProcesses.remove( userName );
+	}
+
+	return processId;
+}
+
+
+
+WtsSessionManager::ProcessId WtsSessionManager::queryUserProcessId( const QString& userName )
 {
 	DWORD sidLen = SECURITY_MAX_SID_SIZE; // Flawfinder: ignore
 	std::array<char, SECURITY_MAX_SID_SIZE> userSID{};
@@ -266,3 +344,59 @@ WtsSessionManager::ProcessId WtsSessionManager::findProcessId( const QString& pr
 
 	return pid;
 }
+
+
+
+void WtsSessionManager::setSessionTrackingEnabled( bool enabled )
+{
+	QMutexLocker locker( &s_registryMutex );
+
+	s_sessionTracking = enabled;
+	s_sessionListValid = false;
+}
+
+
+
+void WtsSessionManager::invalidateSession( SessionId sessionId )
+{
+	QMutexLocker locker( &s_registryMutex );
+
+	s_sessionListValid = false;
+	s_winlogonProcesses.remove( sessionId );
+}
+
+
+
+WtsSessionManager::ProcessEntry WtsSessionManager::processEntry( ProcessId processId )
+{
+	ProcessEntry entry;
+
+	const auto processHandle = OpenProcess( PROCESS_QUERY_LIMITED_INFORMATION, false, processId );
+	if( processHandle == nullptr )
+	{
+		return entry;
+	}
+
+	FILETIME creationTime{}, exitTime{}, kernelTime{}, userTime{};
+	DWORD exitCode = 0;
+	if( GetProcessTimes( processHandle, &creationTime, &exitTime, &kernelTime, &userTime ) &&
+		GetExitCodeProcess( processHandle, &exitCode ) &&
+		exitCode == STILL_ACTIVE )
+	{
+		entry.processId = processId;
+		entry.creationTime = ( quint64( creationTime.dwHighDateTime ) << 32 ) | creationTime.dwLowDateTime;
+	}
+
+	CloseHandle( processHandle );
+
+	return entry;
+}
+
+
+
+bool WtsSessionManager::isValid( const ProcessEntry& entry )
+{
+	// a matching creation time ensures the process ID has not been reused by another process meanwhile
+	return entry.processId != InvalidProcess &&
+		   processEntry( entry.processId ).creationTime == entry.creationTime;
+}
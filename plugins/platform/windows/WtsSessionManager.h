@@ -26,6 +26,9 @@
 
 #include <windows.h>
 
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
 #include <QObject>
 
 class WtsSessionManager
@@ -59,4 +62,32 @@ public:
 	static ProcessId findUserProcessId( const QString& userName );
 	static ProcessId findProcessId( const QString& processName );
 
+	// session lists are only cached while session change notifications are forwarded via invalidateSession()
+	static void setSessionTrackingEnabled( bool enabled );
+	static void invalidateSession( SessionId sessionId );
+
+private:
+	static constexpr auto SessionListMaximumAge = 60000;
+
+	struct ProcessEntry
+	{
+		ProcessId processId{InvalidProcess};
+		quint64 creationTime{0};
+	};
+
+	static SessionList queryActiveSessions();
+	static ProcessId queryWinlogonProcessId( SessionId sessionId );
+	static ProcessId queryUserProcessId( const QString& userName );
+
+	static ProcessEntry processEntry( ProcessId processId );
+	static bool isValid( const ProcessEntry& entry );
+
+	static QMutex s_registryMutex;
+	static bool s_sessionTracking;
+	static bool s_sessionListValid;
+	static SessionList s_sessionList;
+	static QElapsedTimer s_sessionListTimer;
+	static QHash<SessionId, ProcessEntry> s_winlogonProcesses;
+	static QHash<QString, ProcessEntry> s_userProcesses;
+
 } ;
@@ -24,7 +24,6 @@
 
 #include <QEvent>
 #include <QMessageBox>
-#include <QNetworkInterface>
 #include <QProgressBar>
 #include <QProgressDialog>
 #include <QUdpSocket>
@@ -92,6 +91,12 @@ PowerControlFeaturePlugin::PowerControlFeaturePlugin( QObject* parent ) :
 	m_features( { m_powerOnFeature, m_rebootFeature, m_powerDownFeature, m_powerDownNowFeature,
 				m_installUpdatesAndPowerDownFeature, m_powerDownConfirmedFeature, m_powerDownDelayedFeature } )
 {
+	connect( &m_wakeOnLanScheduler, &WakeOnLanScheduler::relayRequested, this,
+			 [this]( const ComputerControlInterface::Pointer& relay, const QStringList& macAddresses ) {
+				 sendFeatureMessage( FeatureMessage{ m_powerOnFeature.uid(), FeatureMessage::DefaultCommand }
+										 .addArgument( Argument::MacAddresses, macAddresses ),
+									 { relay } );
+			 } );
 }
 
 
@@ -127,26 +132,34 @@ bool PowerControlFeaturePlugin::controlFeature( Feature::Uid featureUid,
 		return false;
 	}
 
+	const auto feature = m_features.value( m_features.indexOf( Feature{ featureUid } ) );
+
 	if( featureUid == m_powerOnFeature.uid() )
 	{
-		for( const auto& controlInterface : computerControlInterfaces )
-		{
-			broadcastWOLPacket( controlInterface->computer().macAddress() );
-		}
+		m_powerOperationScheduler.schedule( feature.name(), computerControlInterfaces,
+											[this]( const ComputerControlInterfaceList& batch ) {
+												m_wakeOnLanScheduler.wakeUp( batch );
+											},
+											PowerOperationScheduler::Completion::Online );
+		return true;
 	}
-	else if( featureUid == m_powerDownDelayedFeature.uid() )
-	{
-		const auto shutdownTimeout = arguments.value( argToString(Argument::ShutdownTimeout), 60 ).toInt();
 
-		sendFeatureMessage( FeatureMessage{ featureUid, FeatureMessage::DefaultCommand }
-								.addArgument( Argument::ShutdownTimeout, shutdownTimeout ),
-							computerControlInterfaces );
-	}
-	else
+	FeatureMessage message{ featureUid, FeatureMessage::DefaultCommand };
+
+	if( featureUid == m_powerDownDelayedFeature.uid() )
 	{
-		sendFeatureMessage( FeatureMessage{ featureUid, FeatureMessage::DefaultCommand }, computerControlInterfaces );
+		const auto shutdownTimeout = arguments.value( argToString(Argument::ShutdownTimeout), 60 ).toInt();
+		message.addArgument( Argument::ShutdownTimeout, shutdownTimeout );
 	}
 
+	m_powerOperationScheduler.schedule( feature.name(), computerControlInterfaces,
+										[this, message]( const ComputerControlInterfaceList& batch ) {
+											sendFeatureMessage( message, batch );
+										},
+										featureUid == m_rebootFeature.uid() ?
+											PowerOperationScheduler::Completion::Restarted :
+											PowerOperationScheduler::Completion::Offline );
+
 	return true;
 }
 
@@ -227,6 +240,15 @@ bool PowerControlFeaturePlugin::handleFeatureMessage( VeyonServerInterface& serv
 	{
 		VeyonCore::platform().coreFunctions().reboot();
 	}
+	else if( message.featureUid() == m_powerOnFeature.uid() )
+	{
+		// forward Wake-on-LAN packets on behalf of a master outside of this subnet
+		const auto macAddresses = message.argument( Argument::MacAddresses ).toStringList();
+		for( const auto& macAddress : macAddresses )
+		{
+			broadcastWOLPacket( macAddress );
+		}
+	}
 	else
 	{
 		return false;
@@ -341,65 +363,24 @@ bool PowerControlFeaturePlugin::confirmFeatureExecution( const Feature& feature,
 
 
 
-bool PowerControlFeaturePlugin::broadcastWOLPacket( QString macAddress )
+bool PowerControlFeaturePlugin::broadcastWOLPacket( const QString& macAddress )
 {
-	static constexpr size_t MAC_SIZE = 6;
-	std::array<uint, MAC_SIZE> mac{};
-
 	if( macAddress.isEmpty() )
 	{
 		return false;
 	}
 
-	const auto originalMacAddress = macAddress;
-
-	// remove all possible delimiters
-	macAddress.replace( QLatin1Char(':'), QString() );
-	macAddress.replace( QLatin1Char('-'), QString() );
-	macAddress.replace( QLatin1Char('.'), QString() );
-
-	if( sscanf( macAddress.toUtf8().constData(),
-				"%2x%2x%2x%2x%2x%2x",
-				&mac[0],
-				&mac[1],
-				&mac[2],
-				&mac[3],
-				&mac[4],
-				&mac[5] ) != MAC_SIZE )
+	const auto datagram = WakeOnLanScheduler::createMagicPacket( macAddress );
+	if( datagram.isEmpty() )
 	{
 		CommandLineIO::error( tr( "Invalid MAC address specified!" ) );
-		vWarning() << "invalid MAC address" << originalMacAddress;
+		vWarning() << "invalid MAC address" << macAddress;
 		return false;
 	}
 
-	QByteArray datagram( MAC_SIZE*17, static_cast<char>( 0xff ) );
-
-	for( size_t i = 1; i < 17; ++i )
-	{
-		for( size_t j = 0; j < MAC_SIZE; ++j )
-		{
-			datagram[uint(i*MAC_SIZE+j)] = static_cast<char>( mac.at(j) );
-		}
-	}
-
 	QUdpSocket udpSocket;
 
-	bool success = ( udpSocket.writeDatagram( datagram, QHostAddress::Broadcast, 9 ) == datagram.size() );
-
-	const auto networkInterfaces = QNetworkInterface::allInterfaces();
-	for( const auto& networkInterface : networkInterfaces )
-	{
-		const auto addressEntries = networkInterface.addressEntries();
-		for( const auto& addressEntry : addressEntries )
-		{
-			if( addressEntry.broadcast().isNull() == false )
-			{
-				success &= ( udpSocket.writeDatagram( datagram, addressEntry.broadcast(), 9 ) == datagram.size() );
-			}
-		}
-	}
-
-	return success;
+	return WakeOnLanScheduler::broadcastMagicPacket( udpSocket, datagram );
 }
 
 
@@ -28,6 +28,8 @@
 #include "CommandLinePluginInterface.h"
 #include "Feature.h"
 #include "FeatureProviderInterface.h"
+#include "PowerOperationScheduler.h"
+#include "WakeOnLanScheduler.h"
 
 class PowerControlFeaturePlugin : public QObject,
 		PluginInterface,
@@ -41,7 +43,8 @@ class PowerControlFeaturePlugin : public QObject,
 public:
 	enum class Argument
 	{
-		ShutdownTimeout
+		ShutdownTimeout,
+		MacAddresses
 	};
 	Q_ENUM(Argument)
 
@@ -114,7 +117,7 @@ protected:
 
 private:
 	bool confirmFeatureExecution( const Feature& feature, bool all, QWidget* parent );
-	static bool broadcastWOLPacket( QString macAddress );
+	static bool broadcastWOLPacket( const QString& macAddress );
 
 	void confirmShutdown();
 	void displayShutdownTimeout( int shutdownTimeout );
@@ -130,4 +133,7 @@ private:
 	const Feature m_powerDownDelayedFeature;
 	const FeatureList m_features;
 
+	WakeOnLanScheduler m_wakeOnLanScheduler{this};
+	PowerOperationScheduler m_powerOperationScheduler{this};
+
 };
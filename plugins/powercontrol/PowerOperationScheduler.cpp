@@ -0,0 +1,176 @@
+/*
+ * PowerOperationScheduler.cpp - implementation of PowerOperationScheduler class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include "PowerOperationScheduler.h"
+#include "VeyonConfiguration.h"
+
+
+PowerOperationScheduler::PowerOperationScheduler( QObject* parent ) :
+	QObject( parent )
+{
+	m_dispatchTimer.setInterval( DispatchInterval );
+	connect( &m_dispatchTimer, &QTimer::timeout, this, &PowerOperationScheduler::processJobs );
+}
+
+
+
+void PowerOperationScheduler::schedule( const QString& name,
+										const ComputerControlInterfaceList& computerControlInterfaces,
+										const Operation& operation, Completion completion )
+{
+	// there's no event loop to dispatch further batches in non-interactive components
+	if( VeyonCore::component() != VeyonCore::Component::Master )
+	{
+		operation( computerControlInterfaces );
+		return;
+	}
+
+	Job job;
+	job.name = name;
+	job.operation = operation;
+	job.completion = completion;
+	job.totalCount = computerControlInterfaces.size();
+	job.timer.start();
+
+	for( const auto& controlInterface : computerControlInterfaces )
+	{
+		job.pendingComputers[controlInterface->computer().location()].append( controlInterface );
+	}
+
+	dispatch( job );
+
+	m_jobs.append( job );
+
+	if( m_dispatchTimer.isActive() == false )
+	{
+		m_dispatchTimer.start();
+	}
+}
+
+
+
+void PowerOperationScheduler::processJobs()
+{
+	for( auto it = m_jobs.begin(); it != m_jobs.end(); )
+	{
+		dispatch( *it );
+
+		const auto completed = updateCompletion( *it );
+
+		if( it->pendingComputers.isEmpty() &&
+			( completed || it->timer.elapsed() >= CompletionTimeout ) )
+		{
+			vInfo() << it->name << "completed for" << it->completedCount << "of" << it->totalCount << "computers";
+			it = m_jobs.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	if( m_jobs.isEmpty() )
+	{
+		m_dispatchTimer.stop();
+	}
+}
+
+
+
+void PowerOperationScheduler::dispatch( Job& job )
+{
+	const auto rate = VeyonCore::config().powerControlRatePerLocation();
+
+	ComputerControlInterfaceList batch;
+
+	for( auto it = job.pendingComputers.begin(); it != job.pendingComputers.end(); )
+	{
+		auto& computers = it.value();
+		const auto count = rate > 0 ? qMin( rate, int(computers.size()) ) : int(computers.size());
+
+		batch.append( computers.mid( 0, count ) );
+		computers.erase( computers.begin(), computers.begin() + count );
+
+		if( computers.isEmpty() )
+		{
+			it = job.pendingComputers.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	if( batch.isEmpty() )
+	{
+		return;
+	}
+
+	job.operation( batch );
+
+	if( job.completion != Completion::None )
+	{
+		for( const auto& controlInterface : qAsConst(batch) )
+		{
+			job.dispatchedComputers.append( { controlInterface, false } );
+		}
+	}
+
+	vDebug() << job.name << "dispatched to" << batch.size() << "computers";
+}
+
+
+
+bool PowerOperationScheduler::updateCompletion( Job& job )
+{
+	const auto previouslyCompletedCount = job.completedCount;
+
+	for( auto it = job.dispatchedComputers.begin(); it != job.dispatchedComputers.end(); )
+	{
+		const auto online = it->controlInterface->state() == ComputerControlInterface::State::Connected;
+		it->wentOffline |= ( online == false );
+
+		const auto completed = ( job.completion == Completion::Online && online ) ||
+							   ( job.completion == Completion::Offline && online == false ) ||
+							   ( job.completion == Completion::Restarted && online && it->wentOffline );
+
+		if( completed )
+		{
+			++job.completedCount;
+			it = job.dispatchedComputers.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	if( job.completedCount != previouslyCompletedCount )
+	{
+		vInfo() << job.name << "completed for" << job.completedCount << "of" << job.totalCount << "computers";
+	}
+
+	return job.dispatchedComputers.isEmpty();
+}
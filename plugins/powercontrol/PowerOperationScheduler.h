@@ -0,0 +1,87 @@
+/*
+ * PowerOperationScheduler.h - declaration of PowerOperationScheduler class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#pragma once
+
+#include <functional>
+
+#include <QElapsedTimer>
+#include <QTimer>
+
+#include "ComputerControlInterface.h"
+
+// dispatches power operations to a limited number of computers per location and
+// second and keeps track of the computers reaching the expected state afterwards
+class PowerOperationScheduler : public QObject
+{
+	Q_OBJECT
+public:
+	enum class Completion
+	{
+		None,
+		Online,
+		Offline,
+		Restarted
+	};
+	Q_ENUM(Completion)
+
+	using Operation = std::function<void(const ComputerControlInterfaceList&)>;
+
+	explicit PowerOperationScheduler( QObject* parent = nullptr );
+	~PowerOperationScheduler() override = default;
+
+	void schedule( const QString& name, const ComputerControlInterfaceList& computerControlInterfaces,
+				   const Operation& operation, Completion completion );
+
+private:
+	static constexpr auto DispatchInterval = 1000;
+	static constexpr auto CompletionTimeout = 10 * 60 * 1000;
+
+	struct TrackedComputer
+	{
+		ComputerControlInterface::Pointer controlInterface;
+		bool wentOffline{false};
+	};
+
+	struct Job
+	{
+		QString name;
+		Operation operation;
+		Completion completion{Completion::None};
+		QMap<QString, ComputerControlInterfaceList> pendingComputers;
+		QList<TrackedComputer> dispatchedComputers;
+		int totalCount{0};
+		int completedCount{0};
+		QElapsedTimer timer;
+	};
+
+	void processJobs();
+	void dispatch( Job& job );
+	static bool updateCompletion( Job& job );
+
+	QList<Job> m_jobs;
+	QTimer m_dispatchTimer{this};
+
+} ;
@@ -0,0 +1,314 @@
+/*
+ * WakeOnLanScheduler.cpp - implementation of WakeOnLanScheduler class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include <QNetworkInterface>
+
+#include "HostAddress.h"
+#include "VncConnection.h"
+#include "WakeOnLanScheduler.h"
+
+
+WakeOnLanScheduler::WakeOnLanScheduler( QObject* parent ) :
+	QObject( parent )
+{
+	m_retryTimer.setSingleShot( true );
+	connect( &m_retryTimer, &QTimer::timeout, this, &WakeOnLanScheduler::sendPackets );
+}
+
+
+
+void WakeOnLanScheduler::wakeUp( const ComputerControlInterfaceList& computerControlInterfaces )
+{
+	QStringList hostAddresses;
+	hostAddresses.reserve( computerControlInterfaces.size() );
+
+	for( const auto& controlInterface : computerControlInterfaces )
+	{
+		hostAddresses.append( HostAddress::parseHost( controlInterface->computer().hostAddress() ) );
+	}
+
+	// resolve all host names in parallel up front
+	HostAddress::prefetch( hostAddresses );
+
+	QList<ComputerControlInterface *> newComputers;
+
+	for( const auto& controlInterface : computerControlInterfaces )
+	{
+		const auto addresses = lookupIPv4Addresses( controlInterface->computer().hostAddress() );
+
+		// computers which are already running can forward packets to other computers in their subnet
+		if( controlInterface->state() == ComputerControlInterface::State::Connected )
+		{
+			for( const auto& address : addresses )
+			{
+				m_relays[directedBroadcastAddress( address )] = controlInterface;
+			}
+			continue;
+		}
+
+		const auto macAddress = controlInterface->computer().macAddress();
+		const auto packet = createMagicPacket( macAddress );
+		if( packet.isEmpty() )
+		{
+			continue;
+		}
+
+		PendingComputer pendingComputer{ controlInterface, macAddress, packet, {}, 0 };
+		if( addresses.isEmpty() == false && isInLocalSubnet( addresses.first() ) == false )
+		{
+			pendingComputer.directedBroadcast = directedBroadcastAddress( addresses.first() );
+		}
+
+		if( m_pendingComputers.contains( controlInterface.data() ) == false )
+		{
+			++m_totalComputerCount;
+		}
+
+		m_pendingComputers[controlInterface.data()] = pendingComputer;
+		newComputers.append( controlInterface.data() );
+
+		// check for computer coming online with the initial retry interval again
+		if( controlInterface->vncConnection() )
+		{
+			controlInterface->vncConnection()->resetConnectionRetryInterval();
+		}
+	}
+
+	if( m_retryTimer.isActive() == false )
+	{
+		m_retryInterval = InitialRetryInterval;
+		sendPackets();
+		return;
+	}
+
+	// computers added while retrying others receive their first packet immediately
+	QHash<QHostAddress, QStringList> relayedMacAddresses;
+	for( auto computer : qAsConst(newComputers) )
+	{
+		sendPacket( m_pendingComputers[computer], relayedMacAddresses );
+	}
+
+	requestRelays( relayedMacAddresses );
+}
+
+
+
+QByteArray WakeOnLanScheduler::createMagicPacket( QString macAddress )
+{
+	static constexpr size_t MAC_SIZE = 6;
+	std::array<uint, MAC_SIZE> mac{};
+
+	if( macAddress.isEmpty() )
+	{
+		return {};
+	}
+
+	// remove all possible delimiters
+	macAddress.replace( QLatin1Char(':'), QString() );
+	macAddress.replace( QLatin1Char('-'), QString() );
+	macAddress.replace( QLatin1Char('.'), QString() );
+
+	if( sscanf( macAddress.toUtf8().constData(),
+				"%2x%2x%2x%2x%2x%2x",
+				&mac[0],
+				&mac[1],
+				&mac[2],
+				&mac[3],
+				&mac[4],
+				&mac[5] ) != MAC_SIZE )
+	{
+		return {};
+	}
+
+	QByteArray datagram( MAC_SIZE*17, static_cast<char>( 0xff ) );
+
+	for( size_t i = 1; i < 17; ++i )
+	{
+		for( size_t j = 0; j < MAC_SIZE; ++j )
+		{
+			datagram[uint(i*MAC_SIZE+j)] = static_cast<char>( mac.at(j) );
+		}
+	}
+
+	return datagram;
+}
+
+
+
+bool WakeOnLanScheduler::broadcastMagicPacket( QUdpSocket& socket, const QByteArray& packet )
+{
+	bool success = ( socket.writeDatagram( packet, QHostAddress::Broadcast, WakeOnLanPort ) == packet.size() );
+
+	const auto networkInterfaces = QNetworkInterface::allInterfaces();
+	for( const auto& networkInterface : networkInterfaces )
+	{
+		const auto addressEntries = networkInterface.addressEntries();
+		for( const auto& addressEntry : addressEntries )
+		{
+			if( addressEntry.broadcast().isNull() == false )
+			{
+				success &= ( socket.writeDatagram( packet, addressEntry.broadcast(), WakeOnLanPort ) == packet.size() );
+			}
+		}
+	}
+
+	return success;
+}
+
+
+
+void WakeOnLanScheduler::sendPackets()
+{
+	QHash<QHostAddress, QStringList> relayedMacAddresses;
+
+	for( auto it = m_pendingComputers.begin(); it != m_pendingComputers.end(); )
+	{
+		auto& pendingComputer = it.value();
+
+		if( pendingComputer.controlInterface->state() == ComputerControlInterface::State::Connected )
+		{
+			++m_wokenComputerCount;
+			it = m_pendingComputers.erase( it );
+			continue;
+		}
+
+		if( pendingComputer.attempts >= MaximumAttempts )
+		{
+			vWarning() << "computer" << pendingComputer.controlInterface->computer().hostAddress()
+					   << "did not wake up after" << MaximumAttempts << "attempts";
+			it = m_pendingComputers.erase( it );
+			continue;
+		}
+
+		sendPacket( pendingComputer, relayedMacAddresses );
+		++it;
+	}
+
+	requestRelays( relayedMacAddresses );
+
+	vDebug() << m_wokenComputerCount << "of" << m_totalComputerCount << "computers woken up,"
+			 << m_pendingComputers.size() << "pending";
+
+	if( m_pendingComputers.isEmpty() )
+	{
+		vInfo() << m_wokenComputerCount << "of" << m_totalComputerCount << "computers woken up";
+		m_relays.clear();
+		m_totalComputerCount = 0;
+		m_wokenComputerCount = 0;
+		return;
+	}
+
+	m_retryTimer.start( m_retryInterval );
+	m_retryInterval *= 2;
+}
+
+
+
+void WakeOnLanScheduler::sendPacket( PendingComputer& pendingComputer,
+									 QHash<QHostAddress, QStringList>& relayedMacAddresses )
+{
+	broadcastMagicPacket( m_socket, pendingComputer.packet );
+
+	if( pendingComputer.directedBroadcast.isNull() == false )
+	{
+		m_socket.writeDatagram( pendingComputer.packet, pendingComputer.directedBroadcast, WakeOnLanPort );
+
+		if( m_relays.contains( pendingComputer.directedBroadcast ) )
+		{
+			relayedMacAddresses[pendingComputer.directedBroadcast].append( pendingComputer.macAddress );
+		}
+	}
+
+	++pendingComputer.attempts;
+}
+
+
+
+void WakeOnLanScheduler::requestRelays( const QHash<QHostAddress, QStringList>& relayedMacAddresses )
+{
+	for( auto it = relayedMacAddresses.constBegin(), end = relayedMacAddresses.constEnd(); it != end; ++it )
+	{
+		const auto relay = m_relays.value( it.key() );
+		if( relay && relay->state() == ComputerControlInterface::State::Connected )
+		{
+			Q_EMIT relayRequested( relay, it.value() );
+		}
+	}
+}
+
+
+
+QList<QHostAddress> WakeOnLanScheduler::lookupIPv4Addresses( const QString& hostAddress )
+{
+	const auto host = HostAddress::parseHost( hostAddress );
+	const HostAddress hostAddressObject( host );
+
+	const auto ipAddresses = hostAddressObject.type() == HostAddress::Type::IpAddress ?
+								 QStringList{ host } : hostAddressObject.lookupIpAddresses();
+
+	QList<QHostAddress> addresses;
+	for( const auto& ipAddress : ipAddresses )
+	{
+		const QHostAddress address( ipAddress );
+		bool isIPv4 = false;
+		const auto ipv4Address = address.toIPv4Address( &isIPv4 );
+		if( isIPv4 )
+		{
+			addresses.append( QHostAddress( ipv4Address ) );
+		}
+	}
+
+	return addresses;
+}
+
+
+
+QHostAddress WakeOnLanScheduler::directedBroadcastAddress( const QHostAddress& address )
+{
+	const quint32 hostMask = ( 1U << ( 32 - DirectedBroadcastPrefixLength ) ) - 1;
+
+	return QHostAddress( address.toIPv4Address() | hostMask );
+}
+
+
+
+bool WakeOnLanScheduler::isInLocalSubnet( const QHostAddress& address )
+{
+	const auto networkInterfaces = QNetworkInterface::allInterfaces();
+	for( const auto& networkInterface : networkInterfaces )
+	{
+		const auto addressEntries = networkInterface.addressEntries();
+		for( const auto& addressEntry : addressEntries )
+		{
+			if( addressEntry.broadcast().isNull() == false &&
+				address.isInSubnet( addressEntry.ip(), addressEntry.prefixLength() ) )
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,84 @@
+/*
+ * WakeOnLanScheduler.h - declaration of WakeOnLanScheduler class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#pragma once
+
+#include <QHostAddress>
+#include <QTimer>
+#include <QUdpSocket>
+
+#include "ComputerControlInterface.h"
+
+// sends Wake-on-LAN packets for many computers at once and repeats them with
+// increasing intervals until the computers are reachable or retries are exhausted
+class WakeOnLanScheduler : public QObject
+{
+	Q_OBJECT
+public:
+	explicit WakeOnLanScheduler( QObject* parent = nullptr );
+	~WakeOnLanScheduler() override = default;
+
+	void wakeUp( const ComputerControlInterfaceList& computerControlInterfaces );
+
+	static QByteArray createMagicPacket( QString macAddress );
+	static bool broadcastMagicPacket( QUdpSocket& socket, const QByteArray& packet );
+
+Q_SIGNALS:
+	void relayRequested( const ComputerControlInterface::Pointer& relay, const QStringList& macAddresses );
+
+private:
+	static constexpr auto WakeOnLanPort = 9;
+	static constexpr auto MaximumAttempts = 6;
+	static constexpr auto InitialRetryInterval = 1000;
+	static constexpr auto DirectedBroadcastPrefixLength = 24;
+
+	struct PendingComputer
+	{
+		ComputerControlInterface::Pointer controlInterface;
+		QString macAddress;
+		QByteArray packet;
+		QHostAddress directedBroadcast;
+		int attempts{0};
+	};
+
+	void sendPackets();
+	void sendPacket( PendingComputer& pendingComputer, QHash<QHostAddress, QStringList>& relayedMacAddresses );
+	void requestRelays( const QHash<QHostAddress, QStringList>& relayedMacAddresses );
+
+	static QList<QHostAddress> lookupIPv4Addresses( const QString& hostAddress );
+	static QHostAddress directedBroadcastAddress( const QHostAddress& address );
+	static bool isInLocalSubnet( const QHostAddress& address );
+
+	QUdpSocket m_socket{this};
+	QTimer m_retryTimer{this};
+	int m_retryInterval{InitialRetryInterval};
+
+	QHash<ComputerControlInterface *, PendingComputer> m_pendingComputers;
+	QHash<QHostAddress, ComputerControlInterface::Pointer> m_relays;
+
+	int m_totalComputerCount{0};
+	int m_wokenComputerCount{0};
+
+} ;
@@ -26,6 +26,7 @@
 #include <QBuffer>
 #include <QClipboard>
 #include <QInputDialog>
+#include <QtEndian>
 
 #include "AuthenticationManager.h"
 #include "FeatureWorkerManager.h"
@@ -151,9 +152,15 @@ bool RemoteAccessFeaturePlugin::handleFeatureMessage(ComputerControlInterface::P
 
 	if (message.featureUid() == m_clipboardExchangeFeature.uid())
 	{
-		for (auto it = m_vncViews.constBegin(), end = m_vncViews.constEnd(); it != end; ++it)
+		if (hasClipboardExchange(computerControlInterface))
 		{
-			if (it->first && it->second->computerControlInterface() == computerControlInterface)
+			if (message.command() == ClipboardChanged)
+			{
+				// only fetch the actual data if it's going to be used
+				computerControlInterface->sendFeatureMessage(FeatureMessage{m_clipboardExchangeFeature.uid(),
+																			 RequestClipboardData});
+			}
+			else if (message.command() == ClipboardData)
 			{
 				loadClipboardData(message);
 			}
@@ -171,8 +178,6 @@ bool RemoteAccessFeaturePlugin::handleFeatureMessage(VeyonServerInterface &serve
 													 const MessageContext &messageContext,
 													 const FeatureMessage &message)
 {
-	Q_UNUSED(messageContext)
-
 	if (message.featureUid() == m_remoteViewFeature.uid() ||
 		message.featureUid() == m_remoteControlFeature.uid())
 	{
@@ -182,7 +187,25 @@ bool RemoteAccessFeaturePlugin::handleFeatureMessage(VeyonServerInterface &serve
 	}
 	else if (message.featureUid() == m_clipboardExchangeFeature.uid())
 	{
-		loadClipboardData(message);
+		if (message.command() == RequestClipboardData)
+		{
+			m_clipboardDataMutex.lock();
+			if (m_clipboardDataMessageVersion != m_clipboardDataVersion)
+			{
+				// encode once for all masters requesting the current clipboard contents
+				m_clipboardDataMessage = FeatureMessage{m_clipboardExchangeFeature.uid(), ClipboardData};
+				storeClipboardData(&m_clipboardDataMessage, m_clipboardText, m_clipboardImage);
+				m_clipboardDataMessageVersion = m_clipboardDataVersion;
+			}
+			const FeatureMessage reply(m_clipboardDataMessage);
+			m_clipboardDataMutex.unlock();
+
+			server.sendFeatureMessageReply(messageContext, reply);
+		}
+		else if (message.command() == ClipboardData)
+		{
+			loadClipboardData(message);
+		}
 		return true;
 	}
 
@@ -218,13 +241,8 @@ void RemoteAccessFeaturePlugin::sendAsyncFeatureMessages(VeyonServerInterface& s
 
 	if (clipboardDataVersion != m_clipboardDataVersion)
 	{
-		FeatureMessage message{m_clipboardExchangeFeature.uid()};
-
-		m_clipboardDataMutex.lock();
-		storeClipboardData(&message, m_clipboardText, m_clipboardImage);
-		m_clipboardDataMutex.unlock();
-
-		server.sendFeatureMessageReply(messageContext, message);
+		// announce changes only - masters with open remote access windows fetch the data on their own
+		server.sendFeatureMessageReply(messageContext, FeatureMessage{m_clipboardExchangeFeature.uid(), ClipboardChanged});
 		messageContext.ioDevice()->setProperty(clipboardDataVersionProperty(), m_clipboardDataVersion);
 	}
 }
@@ -408,15 +426,50 @@ void RemoteAccessFeaturePlugin::createRemoteAccessWindow(const ComputerControlIn
 
 
 
+bool RemoteAccessFeaturePlugin::hasClipboardExchange(const ComputerControlInterface::Pointer& computerControlInterface) const
+{
+	for (auto it = m_vncViews.constBegin(), end = m_vncViews.constEnd(); it != end; ++it)
+	{
+		if (it->first && it->second->computerControlInterface() == computerControlInterface)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+
 void RemoteAccessFeaturePlugin::storeClipboardData(FeatureMessage *message, const QString& text, const QImage& image)
 {
+	const auto textData = text.toUtf8();
+	if (textData.size() > MaximumClipboardTextSize)
+	{
+		vWarning() << "not transferring clipboard text of" << textData.size() << "bytes";
+	}
+	else if (textData.size() > ClipboardCompressionThreshold)
+	{
+		message->addArgument(Argument::CompressedClipboardText, qCompress(textData));
+	}
+	else
+	{
+		message->addArgument(Argument::ClipboardText, text);
+	}
+
 	QBuffer buffer;
 	buffer.open(QIODevice::WriteOnly);
 	image.save(&buffer, clipboardImageFormat());
 	buffer.close();
 
-	message->addArgument(Argument::ClipboardText, text);
-	message->addArgument(Argument::ClipboardImage, buffer.data());
+	if (buffer.data().size() > MaximumClipboardImageSize)
+	{
+		vWarning() << "not transferring clipboard image of" << buffer.data().size() << "bytes";
+	}
+	else
+	{
+		message->addArgument(Argument::ClipboardImage, buffer.data());
+	}
 }
 
 
@@ -425,7 +478,16 @@ void RemoteAccessFeaturePlugin::loadClipboardData(const FeatureMessage &message)
 {
 	const auto clipboard = QGuiApplication::clipboard();
 
-	const auto text = message.argument(Argument::ClipboardText).toString();
+	auto text = message.argument(Argument::ClipboardText).toString();
+
+	const auto compressedText = message.argument(Argument::CompressedClipboardText).toByteArray();
+	// qCompress() prefixes the data with its uncompressed size
+	if (compressedText.size() > 4 &&
+		qFromBigEndian<quint32>(compressedText.constData()) <= quint32(MaximumClipboardTextSize))
+	{
+		text = QString::fromUtf8(qUncompress(compressedText));
+	}
+
 	if (text.isEmpty() == false && clipboard->text() != text)
 	{
 		clipboard->setText(text);
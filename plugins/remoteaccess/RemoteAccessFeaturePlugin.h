@@ -40,10 +40,18 @@ public:
 	{
 		HostName,
 		ClipboardText,
-		ClipboardImage
+		ClipboardImage,
+		CompressedClipboardText
 	};
 	Q_ENUM(Argument)
 
+	enum Commands
+	{
+		ClipboardData,
+		ClipboardChanged,
+		RequestClipboardData
+	};
+
 	explicit RemoteAccessFeaturePlugin( QObject* parent = nullptr );
 	~RemoteAccessFeaturePlugin() override = default;
 
@@ -54,7 +62,7 @@ public:
 
 	QVersionNumber version() const override
 	{
-		return QVersionNumber( 1, 1 );
+		return QVersionNumber( 1, 2 );
 	}
 
 	QString name() const override
@@ -126,6 +134,10 @@ private:
 		return "PNG";
 	}
 
+	static constexpr int ClipboardCompressionThreshold = 4096;
+	static constexpr int MaximumClipboardTextSize = 16*1024*1024;
+	static constexpr int MaximumClipboardImageSize = 32*1024*1024;
+
 	bool remoteViewEnabled() const;
 	bool remoteControlEnabled() const;
 	bool initAuthentication();
@@ -133,6 +145,7 @@ private:
 	void createRemoteAccessWindow(const ComputerControlInterface::Pointer& computerControlInterface, bool viewOnly,
 								  VeyonMasterInterface* master);
 
+	bool hasClipboardExchange(const ComputerControlInterface::Pointer& computerControlInterface) const;
 	void storeClipboardData(FeatureMessage* message, const QString& text, const QImage& image);
 	void loadClipboardData(const FeatureMessage& message);
 	void sendClipboardData(ComputerControlInterface::Pointer computerControlInterface);
@@ -150,6 +163,8 @@ private:
 	int m_clipboardDataVersion{0};
 	QString m_clipboardText;
 	QImage m_clipboardImage;
+	FeatureMessage m_clipboardDataMessage{};
+	int m_clipboardDataMessageVersion{-1};
 
 	QList<QPair<QPointer<QObject>, VncView *> > m_vncViews{};
 
@@ -32,6 +32,7 @@
 
 #include "RemoteAccessWidget.h"
 #include "RemoteAccessFeaturePlugin.h"
+#include "VncStatisticsOverlay.h"
 #include "VncViewWidget.h"
 #include "VeyonConfiguration.h"
 #include "VeyonConnection.h"
@@ -331,6 +332,11 @@ RemoteAccessWidget::RemoteAccessWidget( const ComputerControlInterface::Pointer&
 	connect( m_vncView, &VncViewWidget::mouseAtBorder, m_toolBar, &RemoteAccessWidgetToolBar::appear );
 	connect( m_vncView, &VncViewWidget::sizeHintChanged, this, &RemoteAccessWidget::updateSize );
 
+	if( VeyonCore::config().connectionStatisticsOverlay() )
+	{
+		new VncStatisticsOverlay( m_vncView->connection(), m_vncView );
+	}
+
 	showMaximized();
 	VeyonCore::platform().coreFunctions().raiseWindow( this, false );
 
@@ -22,27 +22,46 @@
  *
  */
 
+#include <QBuffer>
+#include <QGuiApplication>
+#include <QInputDialog>
 #include <QMessageBox>
+#include <QPixmap>
 #include <QQmlEngine>
+#include <QScreen>
+#include <QtConcurrent>
 
 #include "ComputerControlInterface.h"
+#include "FeatureWorkerManager.h"
 #include "Screenshot.h"
 #include "ScreenshotFeaturePlugin.h"
 #include "ScreenshotListModel.h"
 #include "QmlCore.h"
+#include "VeyonConfiguration.h"
 #include "VeyonMasterInterface.h"
+#include "VeyonServerInterface.h"
+#include "VeyonWorkerInterface.h"
 
 ScreenshotFeaturePlugin::ScreenshotFeaturePlugin( QObject* parent ) :
 	QObject( parent ),
 	m_screenshotFeature( Feature( QStringLiteral( "Screenshot" ),
-								  Feature::Flag::Action | Feature::Flag::Master,
+								  Feature::Flag::Action | Feature::Flag::AllComponents,
 								  Feature::Uid( "d5ee3aac-2a87-4d05-b827-0c20344490bd" ),
 								  Feature::Uid(),
 								  tr( "Screenshot" ), {},
 								  tr( "Use this function to take a screenshot of selected computers." ),
 								  QStringLiteral(":/screenshot/camera-photo.png") ) ),
-	m_features( { m_screenshotFeature } )
+	m_takeScreenshotFeature( Feature( QStringLiteral( "TakeScreenshot" ),
+									  Feature::Flag::Action | Feature::Flag::Master,
+									  Feature::Uid( "54985a3f-02f2-4950-ab1b-1293c55b6543" ),
+									  m_screenshotFeature.uid(),
+									  tr( "Take screenshot now" ), {},
+									  tr( "Take a screenshot of selected computers now." ) ) )
 {
+	updateFeatures();
+
+	connect( &m_scheduleTimer, &QTimer::timeout, this, &ScreenshotFeaturePlugin::captureNextScheduled );
+
 	if( VeyonCore::component() == VeyonCore::Component::Master )
 	{
 		connect( VeyonCore::instance(), &VeyonCore::applicationLoaded,
@@ -63,18 +82,34 @@ bool ScreenshotFeaturePlugin::controlFeature( Feature::Uid featureUid,
 											 Operation operation, const QVariantMap& arguments,
 											 const ComputerControlInterfaceList& computerControlInterfaces )
 {
-	Q_UNUSED(arguments)
+	if( hasFeature( featureUid ) == false )
+	{
+		return false;
+	}
 
-	if( hasFeature( featureUid ) && operation == Operation::Start )
+	if( operation == Operation::Start )
 	{
+		const auto interval = arguments.value( argToString(Argument::Interval) ).toInt();
+		if( interval > 0 )
+		{
+			startScheduledCapture( computerControlInterfaces, interval );
+			return true;
+		}
+
 		for( const auto& controlInterface : computerControlInterfaces )
 		{
-			Screenshot().take( controlInterface );
+			takeScreenshot( controlInterface );
 		}
 
 		return true;
 	}
 
+	if( operation == Operation::Stop )
+	{
+		stopScheduledCapture();
+		return true;
+	}
+
 	return false;
 }
 
@@ -83,6 +118,28 @@ bool ScreenshotFeaturePlugin::controlFeature( Feature::Uid featureUid,
 bool ScreenshotFeaturePlugin::startFeature( VeyonMasterInterface& master, const Feature& feature,
 											const ComputerControlInterfaceList& computerControlInterfaces )
 {
+	if( feature.uid() == scheduledScreenshotsFeatureUid() )
+	{
+		if( m_scheduleTimer.isActive() )
+		{
+			return controlFeature( feature.uid(), Operation::Stop, {}, computerControlInterfaces );
+		}
+
+		bool ok = false;
+		const auto minutes = QInputDialog::getInt( master.mainWindow(), tr( "Periodic screenshots" ),
+												   tr( "Take a screenshot of each selected computer every (minutes):" ),
+												   m_lastScheduleInterval, 1, 24*60, 1, &ok );
+		if( ok == false )
+		{
+			return false;
+		}
+
+		m_lastScheduleInterval = minutes;
+
+		return controlFeature( feature.uid(), Operation::Start,
+							   { { argToString(Argument::Interval), minutes * 60 * 1000 } }, computerControlInterfaces );
+	}
+
 	if( controlFeature( feature.uid(), Operation::Start, {}, computerControlInterfaces ) )
 	{
 		QMessageBox::information( master.mainWindow(),
@@ -98,6 +155,120 @@ bool ScreenshotFeaturePlugin::startFeature( VeyonMasterInterface& master, const
 
 
 
+bool ScreenshotFeaturePlugin::handleFeatureMessage( ComputerControlInterface::Pointer computerControlInterface,
+													 const FeatureMessage& message )
+{
+	if( message.featureUid() != m_screenshotFeature.uid() ||
+		message.command() != ScreenshotCaptured )
+	{
+		return false;
+	}
+
+	const auto imageData = message.argument( Argument::ImageData ).toByteArray();
+	if( imageData.isEmpty() )
+	{
+		vWarning() << "server-side capture failed on" << computerControlInterface->computer().hostAddress()
+				   << "- falling back to local framebuffer";
+		if( computerControlInterface->hasValidFramebuffer() )
+		{
+			Screenshot().take( computerControlInterface );
+		}
+		return true;
+	}
+
+	// decode in background and add caption and save on the main thread afterwards
+	const QPointer<ScreenshotFeaturePlugin> plugin( this );
+	(void) QtConcurrent::run( [=]() {
+		const auto image = QImage::fromData( imageData ).convertToFormat( QImage::Format_RGB32 );
+		if( plugin )
+		{
+			QMetaObject::invokeMethod( plugin, [=]() {
+				if( image.isNull() == false )
+				{
+					Screenshot().take( computerControlInterface, image );
+				}
+			}, Qt::QueuedConnection );
+		}
+	} );
+
+	return true;
+}
+
+
+
+bool ScreenshotFeaturePlugin::handleFeatureMessage( VeyonServerInterface& server,
+													 const MessageContext& messageContext,
+													 const FeatureMessage& message )
+{
+	if( message.featureUid() != m_screenshotFeature.uid() )
+	{
+		return false;
+	}
+
+	if( message.command() == CaptureScreenshot )
+	{
+		// an empty reply makes the master fall back to its local framebuffer
+		const FeatureMessage emptyReply{ m_screenshotFeature.uid(), ScreenshotCaptured };
+
+		const auto requestId = QUuid::createUuid();
+
+		FeatureMessage workerMessage{ message };
+		workerMessage.addArgument( Argument::RequestId, requestId );
+
+		if( server.featureWorkerManager().sendMessageToUnmanagedSessionWorker( workerMessage ) == false )
+		{
+			// no user session available to capture
+			return server.sendFeatureMessageReply( messageContext, emptyReply );
+		}
+
+		m_pendingCaptures[requestId] = messageContext;
+
+		QTimer::singleShot( CaptureTimeout, this, [this, &server, requestId, emptyReply]() {
+			const auto context = m_pendingCaptures.take( requestId );
+			if( context.ioDevice() )
+			{
+				server.sendFeatureMessageReply( context, emptyReply );
+			}
+		} );
+
+		return true;
+	}
+
+	if( message.command() == ScreenshotCaptured )
+	{
+		const auto requestId = message.argument( Argument::RequestId ).toUuid();
+		const auto context = m_pendingCaptures.take( requestId );
+		if( context.ioDevice() )
+		{
+			return server.sendFeatureMessageReply( context,
+												   FeatureMessage{ m_screenshotFeature.uid(), ScreenshotCaptured }
+												   .addArgument( Argument::ImageData, message.argument( Argument::ImageData ) ) );
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+
+
+bool ScreenshotFeaturePlugin::handleFeatureMessage( VeyonWorkerInterface& worker, const FeatureMessage& message )
+{
+	if( message.featureUid() != m_screenshotFeature.uid() ||
+		message.command() != CaptureScreenshot )
+	{
+		return false;
+	}
+
+	return worker.sendFeatureMessageReply(
+		FeatureMessage{ m_screenshotFeature.uid(), ScreenshotCaptured }
+			.addArgument( Argument::RequestId, message.argument( Argument::RequestId ) )
+			.addArgument( Argument::ImageData, captureDesktop( message.argument( Argument::Lossless ).toBool() ) ) );
+}
+
+
+
 void ScreenshotFeaturePlugin::initUi()
 {
 	auto master = VeyonCore::instance()->findChild<VeyonMasterInterface *>();
@@ -111,3 +282,156 @@ void ScreenshotFeaturePlugin::initUi()
 
 	}
 }
+
+
+
+void ScreenshotFeaturePlugin::startScheduledCapture( const ComputerControlInterfaceList& computerControlInterfaces,
+													 int interval )
+{
+	m_scheduledInterfaces.clear();
+	m_scheduledInterfaces.reserve( computerControlInterfaces.size() );
+	for( const auto& controlInterface : computerControlInterfaces )
+	{
+		m_scheduledInterfaces.append( controlInterface );
+	}
+
+	m_nextScheduledInterface = 0;
+
+	if( m_scheduledInterfaces.isEmpty() )
+	{
+		stopScheduledCapture();
+		return;
+	}
+
+	// spread captures evenly across the interval instead of capturing all computers at once
+	m_scheduleTimer.start( qMax( MinimumCaptureInterval, interval / m_scheduledInterfaces.size() ) );
+
+	updateFeatures();
+}
+
+
+
+void ScreenshotFeaturePlugin::stopScheduledCapture()
+{
+	m_scheduleTimer.stop();
+	m_scheduledInterfaces.clear();
+
+	updateFeatures();
+}
+
+
+
+void ScreenshotFeaturePlugin::captureNextScheduled()
+{
+	if( m_scheduledInterfaces.isEmpty() )
+	{
+		stopScheduledCapture();
+		return;
+	}
+
+	m_nextScheduledInterface %= m_scheduledInterfaces.size();
+
+	const auto controlInterface = m_scheduledInterfaces.at( m_nextScheduledInterface ).toStrongRef();
+	if( controlInterface.isNull() )
+	{
+		m_scheduledInterfaces.removeAt( m_nextScheduledInterface );
+		return;
+	}
+
+	++m_nextScheduledInterface;
+
+	// the master continuously receives framebuffer updates of monitored computers so
+	// take the current frame if available unless the server can capture and encode it itself
+	if( supportsServerSideCapture( controlInterface ) || controlInterface->hasValidFramebuffer() )
+	{
+		takeScreenshot( controlInterface );
+	}
+	else
+	{
+		vDebug() << "skipping" << controlInterface->computer().hostAddress() << "as no framebuffer is available";
+	}
+}
+
+
+
+void ScreenshotFeaturePlugin::updateFeatures()
+{
+	auto flags = Feature::Flag::Option | Feature::Flag::Master;
+	if( m_scheduleTimer.isActive() )
+	{
+		flags |= Feature::Flag::Checked;
+	}
+
+	m_features = { m_screenshotFeature, m_takeScreenshotFeature,
+				   Feature( QStringLiteral( "ScheduledScreenshots" ), flags,
+							scheduledScreenshotsFeatureUid(), m_screenshotFeature.uid(),
+							tr( "Take screenshots periodically" ), {},
+							tr( "Take screenshots of selected computers at regular intervals. "
+								"The screenshots are spread evenly across the interval." ) ) };
+
+	const auto master = VeyonCore::instance()->findChild<VeyonMasterInterface *>();
+	if( master )
+	{
+		master->reloadSubFeatures();
+	}
+}
+
+
+
+void ScreenshotFeaturePlugin::takeScreenshot( const ComputerControlInterface::Pointer& computerControlInterface )
+{
+	if( supportsServerSideCapture( computerControlInterface ) == false )
+	{
+		Screenshot().take( computerControlInterface );
+		return;
+	}
+
+	const auto format = VeyonCore::config().screenshotFormat();
+	const auto lossless = format != ScreenshotConfiguration::Format::JPEG &&
+						  format != ScreenshotConfiguration::Format::WebP;
+
+	sendFeatureMessage( FeatureMessage{ m_screenshotFeature.uid(), CaptureScreenshot }
+							.addArgument( Argument::Lossless, lossless ),
+						{ computerControlInterface } );
+}
+
+
+
+bool ScreenshotFeaturePlugin::supportsServerSideCapture( const ComputerControlInterface::Pointer& computerControlInterface ) const
+{
+	return VeyonCore::config().serverSideScreenshots() &&
+		   computerControlInterface->state() == ComputerControlInterface::State::Connected &&
+		   computerControlInterface->serverVersion() >= VeyonCore::ApplicationVersion::Version_5_0;
+}
+
+
+
+QByteArray ScreenshotFeaturePlugin::captureDesktop( bool lossless )
+{
+	const auto screen = QGuiApplication::primaryScreen();
+	if( screen == nullptr )
+	{
+		vWarning() << "no screen available";
+		return {};
+	}
+
+	const auto geometry = screen->virtualGeometry();
+	const auto image = screen->grabWindow( 0, geometry.x(), geometry.y(), geometry.width(), geometry.height() ).toImage();
+	if( image.isNull() )
+	{
+		vWarning() << "failed to grab screen";
+		return {};
+	}
+
+	QByteArray data;
+	QBuffer buffer( &data );
+	buffer.open( QBuffer::WriteOnly );
+
+	if( lossless ? image.save( &buffer, "PNG", PngQuality ) : image.save( &buffer, "JPG", JpegQuality ) )
+	{
+		return data;
+	}
+
+	vWarning() << "failed to encode screenshot";
+	return {};
+}
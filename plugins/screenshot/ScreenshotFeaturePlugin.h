@@ -24,6 +24,10 @@
 
 #pragma once
 
+#include <QMap>
+#include <QTimer>
+#include <QUuid>
+
 #include "Feature.h"
 #include "FeatureProviderInterface.h"
 
@@ -33,6 +37,15 @@ class ScreenshotFeaturePlugin : public QObject, FeatureProviderInterface, Plugin
 	Q_PLUGIN_METADATA(IID "io.veyon.Veyon.Plugins.Screenshot")
 	Q_INTERFACES(PluginInterface FeatureProviderInterface)
 public:
+	enum class Argument
+	{
+		Interval,
+		RequestId,
+		Lossless,
+		ImageData
+	};
+	Q_ENUM(Argument)
+
 	explicit ScreenshotFeaturePlugin( QObject* parent = nullptr );
 	~ScreenshotFeaturePlugin() override = default;
 
@@ -74,11 +87,53 @@ public:
 	bool startFeature( VeyonMasterInterface& master, const Feature& feature,
 					   const ComputerControlInterfaceList& computerControlInterfaces ) override;
 
+	bool handleFeatureMessage( ComputerControlInterface::Pointer computerControlInterface,
+							   const FeatureMessage& message ) override;
+
+	bool handleFeatureMessage( VeyonServerInterface& server,
+							   const MessageContext& messageContext,
+							   const FeatureMessage& message ) override;
+
+	bool handleFeatureMessage( VeyonWorkerInterface& worker, const FeatureMessage& message ) override;
 
 private:
+	enum Commands
+	{
+		CaptureScreenshot,
+		ScreenshotCaptured
+	};
+
 	void initUi();
 
+	void takeScreenshot( const ComputerControlInterface::Pointer& computerControlInterface );
+	bool supportsServerSideCapture( const ComputerControlInterface::Pointer& computerControlInterface ) const;
+	static QByteArray captureDesktop( bool lossless );
+
+	void startScheduledCapture( const ComputerControlInterfaceList& computerControlInterfaces, int interval );
+	void stopScheduledCapture();
+	void captureNextScheduled();
+	void updateFeatures();
+
+	static Feature::Uid scheduledScreenshotsFeatureUid()
+	{
+		return Feature::Uid( "9c59630d-a52c-4396-b4b3-4be26b7c3f16" );
+	}
+
+	static constexpr int DefaultScheduleInterval = 5;
+	static constexpr int MinimumCaptureInterval = 1000;
+	static constexpr int CaptureTimeout = 60000;
+	static constexpr int JpegQuality = 85;
+	static constexpr int PngQuality = 50;
+
 	const Feature m_screenshotFeature;
-	const FeatureList m_features;
+	const Feature m_takeScreenshotFeature;
+	FeatureList m_features;
+
+	QTimer m_scheduleTimer{this};
+	QList<QWeakPointer<ComputerControlInterface>> m_scheduledInterfaces;
+	int m_nextScheduledInterface{0};
+	int m_lastScheduleInterval{DefaultScheduleInterval};
+
+	QMap<QUuid, MessageContext> m_pendingCaptures;
 
 };
@@ -26,6 +26,7 @@
 #include <QFileInfo>
 
 #include "Filesystem.h"
+#include "Screenshot.h"
 #include "ScreenshotListModel.h"
 #include "VeyonConfiguration.h"
 #include "VeyonCore.h"
@@ -57,6 +58,7 @@ QHash<int, QByteArray> ScreenshotListModel::roleNames() const
 	QHash<int, QByteArray> roles;
 	roles[Qt::DisplayRole] = "name";
 	roles[Qt::UserRole+1] = "url";
+	roles[Qt::UserRole+2] = "thumbnailUrl";
 	return roles;
 }
 
@@ -69,6 +71,12 @@ QVariant ScreenshotListModel::data(const QModelIndex& index, int role) const
 		return QString{QStringLiteral("file://") + filePath(index)};
 	}
 
+	if( role == Qt::UserRole+2 )
+	{
+		return QString{QStringLiteral("file://") +
+					   m_catalog.thumbnailFilePath( QStringListModel::data( index, Qt::DisplayRole ).toString() )};
+	}
+
 	return QStringListModel::data(index, role);
 }
 
@@ -76,8 +84,11 @@ QVariant ScreenshotListModel::data(const QModelIndex& index, int role) const
 
 void ScreenshotListModel::updateModel()
 {
-	setStringList( QDir{ VeyonCore::filesystem().screenshotDirectoryPath() }
-					   .entryList( { QStringLiteral("*.png") }, QDir::Filter::Files, QDir::SortFlag::Name ) );
+	const auto files = m_catalog.update();
+	if( files != stringList() )
+	{
+		setStringList( files );
+	}
 }
 
 
@@ -28,6 +28,8 @@
 #include <QStringListModel>
 #include <QTimer>
 
+#include "ScreenshotCatalog.h"
+
 class ScreenshotListModel : public QStringListModel
 {
 	Q_OBJECT
@@ -45,6 +47,7 @@ private:
 
 	QString filePath( const QModelIndex& index ) const;
 
+	ScreenshotCatalog m_catalog{this};
 	QFileSystemWatcher m_fsWatcher{this};
 
 	QTimer m_reloadTimer{this};
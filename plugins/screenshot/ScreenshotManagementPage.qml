@@ -43,7 +43,7 @@ Page {
 				height: gridView.cellHeight
 				Image {
 					Layout.margins: 2
-					source: url
+					source: thumbnailUrl
 					Layout.alignment: Qt.AlignHCenter
 					sourceSize.width: width//parent.width
 					sourceSize.height: height//parent.height - label.height
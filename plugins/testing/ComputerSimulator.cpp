@@ -0,0 +1,97 @@
+/*
+ * ComputerSimulator.cpp - implementation of ComputerSimulator class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include <QTcpServer>
+
+#include "ComputerSimulator.h"
+#include "SimulatedComputer.h"
+
+
+ComputerSimulator::ComputerSimulator( QObject* parent ) :
+	QObject( parent )
+{
+}
+
+
+
+bool ComputerSimulator::listenOnPorts( int count, int firstPort )
+{
+	for( int i = 0; i < count; ++i )
+	{
+		if( listen( i, QHostAddress::Any, firstPort + i ) == false )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+
+bool ComputerSimulator::listenOnAddresses( int count, const QHostAddress& firstAddress, int port )
+{
+	if( firstAddress.protocol() != QAbstractSocket::IPv4Protocol )
+	{
+		vCritical() << "only IPv4 addresses are supported";
+		return false;
+	}
+
+	for( int i = 0; i < count; ++i )
+	{
+		if( listen( i, QHostAddress( firstAddress.toIPv4Address() + quint32(i) ), port ) == false )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+
+bool ComputerSimulator::listen( int index, const QHostAddress& address, int port )
+{
+	auto server = new QTcpServer( this );
+	if( server->listen( address, quint16(port) ) == false )
+	{
+		vCritical() << "could not listen on" << address.toString() << port << server->errorString();
+		return false;
+	}
+
+	connect( server, &QTcpServer::newConnection, this, [this, server, index]() { acceptConnections( server, index ); } );
+
+	return true;
+}
+
+
+
+void ComputerSimulator::acceptConnections( QTcpServer* server, int index )
+{
+	while( server->hasPendingConnections() )
+	{
+		new SimulatedComputer( server->nextPendingConnection(), index, this );
+	}
+}
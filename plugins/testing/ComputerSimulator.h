@@ -0,0 +1,49 @@
+/*
+ * ComputerSimulator.h - declaration of ComputerSimulator class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#pragma once
+
+#include <QHostAddress>
+
+#include "VeyonCore.h"
+
+class QTcpServer;
+
+// runs many simulated computers in a single process, either on consecutive ports
+// or on consecutive (loopback) addresses sharing the same port
+class ComputerSimulator : public QObject
+{
+	Q_OBJECT
+public:
+	explicit ComputerSimulator( QObject* parent = nullptr );
+
+	bool listenOnPorts( int count, int firstPort );
+	bool listenOnAddresses( int count, const QHostAddress& firstAddress, int port );
+
+private:
+	bool listen( int index, const QHostAddress& address, int port );
+	void acceptConnections( QTcpServer* server, int index );
+
+} ;
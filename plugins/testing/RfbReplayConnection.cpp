@@ -0,0 +1,108 @@
+/*
+ * RfbReplayConnection.cpp - implementation of RfbReplayConnection class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include <QTcpSocket>
+
+#include "RfbReplayConnection.h"
+
+
+RfbReplayConnection::RfbReplayConnection( QTcpSocket* socket, const RfbRecording::Messages& messages, QObject* parent ) :
+	QObject( parent ),
+	m_socket( socket ),
+	m_messages( messages ),
+	m_client(),
+	m_protocol( socket, &m_client )
+{
+	m_socket->setParent( this );
+
+	m_protocol.setServerInitMessage( m_messages.first().data );
+
+	m_replayTimer.setSingleShot( true );
+
+	connect( &m_replayTimer, &QTimer::timeout, this, &RfbReplayConnection::sendMessages );
+	connect( m_socket, &QTcpSocket::readyRead, this, &RfbReplayConnection::readFromClient );
+	connect( m_socket, &QTcpSocket::disconnected, this, &QObject::deleteLater );
+
+	m_protocol.start();
+}
+
+
+
+RfbReplayConnection::~RfbReplayConnection()
+{
+	disconnect( m_socket );
+}
+
+
+
+void RfbReplayConnection::readFromClient()
+{
+	if( m_protocol.state() == VncServerProtocol::State::Running )
+	{
+		// pixel format, encodings and update requests are implied by the recording
+		m_socket->readAll();
+		return;
+	}
+
+	while( m_protocol.read() ) // Flawfinder: ignore
+	{
+	}
+
+	if( m_protocol.state() == VncServerProtocol::State::Running )
+	{
+		m_elapsedTimer.start();
+		sendMessages();
+	}
+}
+
+
+
+void RfbReplayConnection::sendMessages()
+{
+	if( m_socket->bytesToWrite() > MaximumPendingBytes )
+	{
+		m_replayTimer.start( BackpressureRetryInterval );
+		return;
+	}
+
+	const auto startTime = m_messages.value( 1 ).timestamp;
+
+	while( m_nextMessage < m_messages.size() )
+	{
+		const auto delay = m_messages[m_nextMessage].timestamp - startTime - m_elapsedTimer.elapsed();
+		if( delay > 0 )
+		{
+			m_replayTimer.start( int(delay) );
+			return;
+		}
+
+		m_socket->write( m_messages[m_nextMessage].data );
+		++m_nextMessage;
+	}
+
+	// compressed encodings keep state across messages so we can't just loop the
+	// recording - let the master reconnect and start over with a new stream instead
+	m_socket->disconnectFromHost();
+}
@@ -0,0 +1,62 @@
+/*
+ * RfbReplayConnection.h - declaration of RfbReplayConnection class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QTimer>
+
+#include "RfbRecording.h"
+#include "TestingServerProtocol.h"
+#include "VncServerClient.h"
+
+class QTcpSocket;
+
+// serves a recorded RFB session to a single connected client
+class RfbReplayConnection : public QObject
+{
+	Q_OBJECT
+public:
+	RfbReplayConnection( QTcpSocket* socket, const RfbRecording::Messages& messages, QObject* parent );
+	~RfbReplayConnection() override;
+
+private:
+	static constexpr int MaximumPendingBytes = 4*1024*1024;
+	static constexpr int BackpressureRetryInterval = 10;
+
+	void readFromClient();
+	void sendMessages();
+
+	QTcpSocket* m_socket;
+	const RfbRecording::Messages m_messages;
+
+	VncServerClient m_client;
+	TestingServerProtocol m_protocol;
+
+	QTimer m_replayTimer{this};
+	QElapsedTimer m_elapsedTimer;
+	int m_nextMessage{1};
+
+} ;
@@ -0,0 +1,69 @@
+/*
+ * RfbReplayServer.cpp - implementation of RfbReplayServer class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include <QHostAddress>
+#include <QTcpServer>
+
+#include "RfbReplayConnection.h"
+#include "RfbReplayServer.h"
+
+
+RfbReplayServer::RfbReplayServer( const QVector<RfbRecording::Messages>& recordings, QObject* parent ) :
+	QObject( parent ),
+	m_recordings( recordings )
+{
+}
+
+
+
+bool RfbReplayServer::listen( int firstPort, int count )
+{
+	for( int i = 0; i < count; ++i )
+	{
+		auto server = new QTcpServer( this );
+		if( server->listen( QHostAddress::Any, quint16(firstPort + i) ) == false )
+		{
+			vCritical() << "could not listen on port" << firstPort + i << server->errorString();
+			return false;
+		}
+
+		// distribute recordings across ports
+		const auto& messages = m_recordings[i % m_recordings.size()];
+
+		connect( server, &QTcpServer::newConnection, this, [this, server, messages]() { acceptConnections( server, messages ); } );
+	}
+
+	return true;
+}
+
+
+
+void RfbReplayServer::acceptConnections( QTcpServer* server, const RfbRecording::Messages& messages )
+{
+	while( server->hasPendingConnections() )
+	{
+		new RfbReplayConnection( server->nextPendingConnection(), messages, this );
+	}
+}
@@ -0,0 +1,563 @@
+/*
+ * SimulatedComputer.cpp - implementation of SimulatedComputer class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include <QTcpSocket>
+#include <QtEndian>
+
+#include "BuiltinFeatures.h"
+#include "FeatureMessage.h"
+#include "MonitoringMode.h"
+#include "SimulatedComputer.h"
+#include "VeyonConfiguration.h"
+
+
+SimulatedComputer::SimulatedComputer( QTcpSocket* socket, int index, QObject* parent ) :
+	QObject( parent ),
+	m_socket( socket ),
+	m_index( index ),
+	m_client(),
+	m_protocol( socket, &m_client ),
+	m_activityBlock( 0, 0, ActivityBlockSize, ActivityBlockSize ),
+	m_activityColor( qRgb( 255, 255, 255 ) ),
+	m_backgroundColor( qRgb( index * 53 % 256, index * 97 % 256, 128 ) )
+{
+	m_socket->setParent( this );
+
+	m_pixelFormat.bitsPerPixel = 32;
+	m_pixelFormat.depth = 24;
+	m_pixelFormat.trueColour = 1;
+	m_pixelFormat.redMax = 255;
+	m_pixelFormat.greenMax = 255;
+	m_pixelFormat.blueMax = 255;
+	m_pixelFormat.redShift = 16;
+	m_pixelFormat.greenShift = 8;
+	m_pixelFormat.blueShift = 0;
+
+	m_protocol.setServerInitMessage( serverInitMessage() );
+
+	m_framebufferUpdateTimer.start();
+
+	connect( &m_activityTimer, &QTimer::timeout, this, &SimulatedComputer::simulateActivity );
+	connect( m_socket, &QTcpSocket::readyRead, this, &SimulatedComputer::readFromClient );
+	connect( m_socket, &QTcpSocket::disconnected, this, &QObject::deleteLater );
+
+	m_protocol.start();
+}
+
+
+
+SimulatedComputer::~SimulatedComputer()
+{
+	disconnect( m_socket );
+}
+
+
+
+void SimulatedComputer::readFromClient()
+{
+	if( m_protocol.state() != VncServerProtocol::State::Running )
+	{
+		while( m_protocol.read() ) // Flawfinder: ignore
+		{
+		}
+
+		if( m_protocol.state() != VncServerProtocol::State::Running )
+		{
+			return;
+		}
+
+		// announce session state like a real server does right after connecting
+		sendUserInformation();
+		sendActiveFeatures();
+		sendScreens();
+
+		// desynchronize activity of simulated computers
+		m_activityTimer.start( ActivityInterval + m_index % 100 );
+	}
+
+	while( receiveClientMessage() )
+	{
+	}
+}
+
+
+
+bool SimulatedComputer::receiveClientMessage()
+{
+	uint8_t messageType = 0;
+	if( m_socket->peek( reinterpret_cast<char *>( &messageType ), sizeof(messageType) ) != sizeof(messageType) )
+	{
+		return false;
+	}
+
+	switch( messageType )
+	{
+	case rfbSetPixelFormat:
+		return receiveSetPixelFormatMessage();
+
+	case rfbSetEncodings:
+		return receiveSetEncodingsMessage();
+
+	case rfbFramebufferUpdateRequest:
+		return receiveFramebufferUpdateRequestMessage();
+
+	case rfbKeyEvent:
+		return discardMessage( sz_rfbKeyEventMsg );
+
+	case rfbPointerEvent:
+		return discardMessage( sz_rfbPointerEventMsg );
+
+	case rfbXvp:
+		return discardMessage( sz_rfbXvpMsg );
+
+	case rfbSetScale:
+		return discardMessage( sz_rfbSetScaleMsg );
+
+	case rfbClientCutText:
+		if( m_socket->bytesAvailable() >= sz_rfbClientCutTextMsg )
+		{
+			rfbClientCutTextMsg message;
+			if( m_socket->peek( reinterpret_cast<char *>( &message ), sz_rfbClientCutTextMsg ) == sz_rfbClientCutTextMsg )
+			{
+				return discardMessage( sz_rfbClientCutTextMsg + qFromBigEndian( message.length ) );
+			}
+		}
+		break;
+
+	case FeatureMessage::RfbMessageType:
+		return receiveFeatureMessage();
+
+	default:
+		vCritical() << "received unknown message type:" << static_cast<int>( messageType );
+		m_socket->close();
+		break;
+	}
+
+	return false;
+}
+
+
+
+bool SimulatedComputer::receiveFeatureMessage()
+{
+	char messageType;
+	if( m_socket->getChar( &messageType ) == false )
+	{
+		return false;
+	}
+
+	FeatureMessage message;
+	if( message.isReadyForReceive( m_socket ) == false )
+	{
+		m_socket->ungetChar( messageType );
+		return false;
+	}
+
+	if( message.receive( m_socket ) == false )
+	{
+		return false;
+	}
+
+	const auto& monitoringMode = VeyonCore::builtinFeatures().monitoringMode();
+	const auto& featureUid = message.featureUid();
+
+	if( featureUid == monitoringMode.feature().uid() )
+	{
+		if( message.command() == MonitoringMode::Ping )
+		{
+			sendFeatureMessage( message );
+		}
+		else if( message.command() == MonitoringMode::SetMinimumFramebufferUpdateInterval )
+		{
+			m_minimumFramebufferUpdateInterval = message.argument( MonitoringMode::Argument::MinimumFramebufferUpdateInterval ).toInt();
+		}
+	}
+	else if( featureUid == monitoringMode.queryApplicationVersionFeature().uid() )
+	{
+		sendFeatureMessage( FeatureMessage{featureUid}
+								.addArgument( MonitoringMode::Argument::ApplicationVersion,
+											  int(VeyonCore::config().applicationVersion()) ) );
+	}
+	else if( featureUid == monitoringMode.queryActiveFeaturesFeature().uid() )
+	{
+		sendActiveFeatures();
+	}
+	else if( featureUid == monitoringMode.queryLoggedOnUserInfoFeature().uid() )
+	{
+		sendUserInformation();
+	}
+	else if( featureUid == monitoringMode.queryScreensFeature().uid() )
+	{
+		sendScreens();
+	}
+	else
+	{
+		// other features are not simulated as they'd act on the local computer
+		vDebug() << "ignoring" << message;
+	}
+
+	return true;
+}
+
+
+
+bool SimulatedComputer::receiveSetPixelFormatMessage()
+{
+	if( m_socket->bytesAvailable() < sz_rfbSetPixelFormatMsg )
+	{
+		return false;
+	}
+
+	rfbSetPixelFormatMsg message;
+	if( m_socket->read( reinterpret_cast<char *>( &message ), sz_rfbSetPixelFormatMsg ) != sz_rfbSetPixelFormatMsg )
+	{
+		return false;
+	}
+
+	auto format = message.format;
+	format.redMax = qFromBigEndian( format.redMax );
+	format.greenMax = qFromBigEndian( format.greenMax );
+	format.blueMax = qFromBigEndian( format.blueMax );
+
+	if( format.trueColour == 0 ||
+		( format.bitsPerPixel != 8 && format.bitsPerPixel != 16 && format.bitsPerPixel != 32 ) )
+	{
+		vWarning() << "unsupported pixel format requested";
+		return true;
+	}
+
+	m_pixelFormat = format;
+
+	return true;
+}
+
+
+
+bool SimulatedComputer::receiveSetEncodingsMessage()
+{
+	rfbSetEncodingsMsg message;
+	if( m_socket->bytesAvailable() < sz_rfbSetEncodingsMsg ||
+		m_socket->peek( reinterpret_cast<char *>( &message ), sz_rfbSetEncodingsMsg ) != sz_rfbSetEncodingsMsg )
+	{
+		return false;
+	}
+
+	const auto nEncodings = qFromBigEndian( message.nEncodings );
+	if( nEncodings > MAX_ENCODINGS )
+	{
+		vCritical() << "received too many encodings from client";
+		m_socket->close();
+		return false;
+	}
+
+	const auto size = sz_rfbSetEncodingsMsg + nEncodings * sizeof(uint32_t);
+	if( m_socket->bytesAvailable() < qint64(size) )
+	{
+		return false;
+	}
+
+	const auto data = m_socket->read( size );
+
+	m_hextile = false;
+	for( int i = 0; i < nEncodings; ++i )
+	{
+		const auto encoding = qFromBigEndian<int32_t>( data.constData() + sz_rfbSetEncodingsMsg + i * sizeof(uint32_t) );
+		if( encoding == rfbEncodingHextile )
+		{
+			m_hextile = true;
+		}
+	}
+
+	return true;
+}
+
+
+
+bool SimulatedComputer::receiveFramebufferUpdateRequestMessage()
+{
+	rfbFramebufferUpdateRequestMsg message;
+	if( m_socket->bytesAvailable() < sz_rfbFramebufferUpdateRequestMsg ||
+		m_socket->read( reinterpret_cast<char *>( &message ), sz_rfbFramebufferUpdateRequestMsg ) != sz_rfbFramebufferUpdateRequestMsg )
+	{
+		return false;
+	}
+
+	// discard update requests like the server does when a minimum update interval is set
+	if( message.incremental &&
+		m_minimumFramebufferUpdateInterval > 0 &&
+		m_framebufferUpdateTimer.hasExpired( m_minimumFramebufferUpdateInterval ) == false )
+	{
+		return true;
+	}
+
+	m_framebufferUpdateTimer.restart();
+
+	if( message.incremental == false )
+	{
+		m_dirtyRegion = QRect( 0, 0, FramebufferWidth, FramebufferHeight );
+	}
+
+	m_updateRequested = true;
+
+	sendFramebufferUpdate();
+
+	return true;
+}
+
+
+
+bool SimulatedComputer::discardMessage( qint64 size )
+{
+	if( m_socket->bytesAvailable() < size )
+	{
+		return false;
+	}
+
+	return m_socket->read( size ).size() == size;
+}
+
+
+
+void SimulatedComputer::sendFeatureMessage( const FeatureMessage& message )
+{
+	const char rfbMessageType = FeatureMessage::RfbMessageType;
+	m_socket->write( &rfbMessageType, sizeof(rfbMessageType) );
+
+	message.send( m_socket );
+}
+
+
+
+void SimulatedComputer::sendUserInformation()
+{
+	FeatureMessage message{VeyonCore::builtinFeatures().monitoringMode().queryLoggedOnUserInfoFeature().uid()};
+
+	if( m_index % UserlessComputerInterval == UserlessComputerInterval - 1 )
+	{
+		message.addArgument( MonitoringMode::Argument::UserLoginName, QString{} );
+		message.addArgument( MonitoringMode::Argument::UserFullName, QString{} );
+		message.addArgument( MonitoringMode::Argument::UserSessionId, -1 );
+	}
+	else
+	{
+		const auto number = QStringLiteral("%1").arg( m_index + 1, 4, 10, QLatin1Char('0') );
+		message.addArgument( MonitoringMode::Argument::UserLoginName, QStringLiteral("user%1").arg( number ) );
+		message.addArgument( MonitoringMode::Argument::UserFullName, QStringLiteral("Simulated User %1").arg( number ) );
+		message.addArgument( MonitoringMode::Argument::UserSessionId, 1 );
+	}
+
+	sendFeatureMessage( message );
+}
+
+
+
+void SimulatedComputer::sendActiveFeatures()
+{
+	sendFeatureMessage( FeatureMessage{VeyonCore::builtinFeatures().monitoringMode().queryActiveFeaturesFeature().uid()}
+							.addArgument( MonitoringMode::Argument::ActiveFeaturesList, QStringList{} ) );
+}
+
+
+
+void SimulatedComputer::sendScreens()
+{
+	const QVariantList screens{
+		QVariantMap{
+			{ QStringLiteral("name"), QStringLiteral("Simulated screen") },
+			{ QStringLiteral("geometry"), QRect( 0, 0, FramebufferWidth, FramebufferHeight ) }
+		}
+	};
+
+	sendFeatureMessage( FeatureMessage{VeyonCore::builtinFeatures().monitoringMode().queryScreensFeature().uid()}
+							.addArgument( MonitoringMode::Argument::ScreenInfoList, screens ) );
+}
+
+
+
+void SimulatedComputer::simulateActivity()
+{
+	// move a block across the screen like a cursor or small window
+	m_dirtyRegion += m_activityBlock;
+
+	++m_activityStep;
+
+	constexpr auto columns = FramebufferWidth / ActivityBlockSize;
+	constexpr auto rows = FramebufferHeight / ActivityBlockSize;
+	const auto position = ( m_activityStep * 7 + m_index * 13 ) % ( columns * rows );
+
+	m_activityBlock.moveTo( position % columns * ActivityBlockSize, position / columns * ActivityBlockSize );
+	m_activityColor = qRgb( m_activityStep * 37 % 256, m_activityStep * 91 % 256, 255 - m_index % 256 );
+
+	m_dirtyRegion += m_activityBlock;
+
+	// switch background from time to time like when switching applications
+	if( m_activityStep % ActivityStepsPerBackground == 0 )
+	{
+		m_backgroundColor = qRgb( m_activityStep * 13 % 256, m_index * 97 % 256, m_activityStep * 29 % 256 );
+		m_dirtyRegion = QRect( 0, 0, FramebufferWidth, FramebufferHeight );
+	}
+
+	sendFramebufferUpdate();
+}
+
+
+
+void SimulatedComputer::sendFramebufferUpdate()
+{
+	if( m_updateRequested == false || m_dirtyRegion.isEmpty() )
+	{
+		return;
+	}
+
+	rfbFramebufferUpdateMsg header{};
+	header.type = rfbFramebufferUpdate;
+	header.nRects = qToBigEndian<uint16_t>( uint16_t(m_dirtyRegion.rectCount()) );
+
+	QByteArray message( reinterpret_cast<const char *>( &header ), sz_rfbFramebufferUpdateMsg );
+
+	for( const auto& rect : m_dirtyRegion )
+	{
+		rfbFramebufferUpdateRectHeader rectHeader{};
+		rectHeader.r.x = qToBigEndian<uint16_t>( uint16_t(rect.x()) );
+		rectHeader.r.y = qToBigEndian<uint16_t>( uint16_t(rect.y()) );
+		rectHeader.r.w = qToBigEndian<uint16_t>( uint16_t(rect.width()) );
+		rectHeader.r.h = qToBigEndian<uint16_t>( uint16_t(rect.height()) );
+		rectHeader.encoding = qToBigEndian<uint32_t>( m_hextile ? rfbEncodingHextile : rfbEncodingRaw );
+
+		message.append( reinterpret_cast<const char *>( &rectHeader ), sz_rfbFramebufferUpdateRectHeader );
+
+		if( m_hextile )
+		{
+			appendRectHextile( message, rect );
+		}
+		else
+		{
+			appendRectRaw( message, rect );
+		}
+	}
+
+	m_socket->write( message );
+
+	m_dirtyRegion = {};
+	m_updateRequested = false;
+}
+
+
+
+void SimulatedComputer::appendRectRaw( QByteArray& message, const QRect& rect ) const
+{
+	const auto background = pixelData( m_backgroundColor );
+	const auto foreground = pixelData( m_activityColor );
+
+	message.reserve( message.size() + rect.width() * rect.height() * background.size() );
+
+	for( int y = rect.top(); y <= rect.bottom(); ++y )
+	{
+		for( int x = rect.left(); x <= rect.right(); ++x )
+		{
+			message.append( m_activityBlock.contains( x, y ) ? foreground : background );
+		}
+	}
+}
+
+
+
+void SimulatedComputer::appendRectHextile( QByteArray& message, const QRect& rect ) const
+{
+	const auto background = pixelData( m_backgroundColor );
+	const auto foreground = pixelData( m_activityColor );
+
+	// the background color is retained across tiles so it only has to be sent once per rect
+	bool firstTile = true;
+
+	for( int y = rect.top(); y <= rect.bottom(); y += HextileTileSize )
+	{
+		for( int x = rect.left(); x <= rect.right(); x += HextileTileSize )
+		{
+			const QRect tile( x, y, qMin( HextileTileSize, rect.right() + 1 - x ), qMin( HextileTileSize, rect.bottom() + 1 - y ) );
+			const auto block = tile.intersected( m_activityBlock );
+
+			uint8_t subEncoding = firstTile ? rfbHextileBackgroundSpecified : 0;
+			if( block.isEmpty() == false )
+			{
+				subEncoding |= rfbHextileForegroundSpecified | rfbHextileAnySubrects;
+			}
+
+			message.append( char(subEncoding) );
+
+			if( firstTile )
+			{
+				message.append( background );
+				firstTile = false;
+			}
+
+			if( block.isEmpty() == false )
+			{
+				message.append( foreground );
+				message.append( char(1) );
+				message.append( char( ( block.x() - tile.x() ) << 4 | ( block.y() - tile.y() ) ) );
+				message.append( char( ( block.width() - 1 ) << 4 | ( block.height() - 1 ) ) );
+			}
+		}
+	}
+}
+
+
+
+QByteArray SimulatedComputer::pixelData( QRgb color ) const
+{
+	const auto value = uint32_t( qRed(color) * m_pixelFormat.redMax / 255 ) << m_pixelFormat.redShift |
+					   uint32_t( qGreen(color) * m_pixelFormat.greenMax / 255 ) << m_pixelFormat.greenShift |
+					   uint32_t( qBlue(color) * m_pixelFormat.blueMax / 255 ) << m_pixelFormat.blueShift;
+
+	const auto bytesPerPixel = m_pixelFormat.bitsPerPixel / 8;
+
+	QByteArray data( bytesPerPixel, 0 );
+	for( int i = 0; i < bytesPerPixel; ++i )
+	{
+		const auto shift = ( m_pixelFormat.bigEndian ? bytesPerPixel - 1 - i : i ) * 8;
+		data[i] = char( ( value >> shift ) & 0xff );
+	}
+
+	return data;
+}
+
+
+
+QByteArray SimulatedComputer::serverInitMessage() const
+{
+	const auto name = QStringLiteral("Simulated computer %1").arg( m_index + 1 ).toUtf8();
+
+	rfbServerInitMsg message{};
+	message.framebufferWidth = qToBigEndian<uint16_t>( FramebufferWidth );
+	message.framebufferHeight = qToBigEndian<uint16_t>( FramebufferHeight );
+	message.format = m_pixelFormat;
+	message.format.redMax = qToBigEndian( m_pixelFormat.redMax );
+	message.format.greenMax = qToBigEndian( m_pixelFormat.greenMax );
+	message.format.blueMax = qToBigEndian( m_pixelFormat.blueMax );
+	message.nameLength = qToBigEndian<uint32_t>( uint32_t(name.size()) );
+
+	return QByteArray( reinterpret_cast<const char *>( &message ), sz_rfbServerInitMsg ) + name;
+}
@@ -0,0 +1,102 @@
+/*
+ * SimulatedComputer.h - declaration of SimulatedComputer class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QRegion>
+#include <QRgb>
+#include <QTimer>
+
+#include "rfb/rfbproto.h"
+
+#include "TestingServerProtocol.h"
+#include "VncServerClient.h"
+
+class QTcpSocket;
+
+class FeatureMessage;
+
+// emulates a Veyon Server with scripted framebuffer activity and a logged on user
+// so masters can be tested against many computers without real servers
+class SimulatedComputer : public QObject
+{
+	Q_OBJECT
+public:
+	SimulatedComputer( QTcpSocket* socket, int index, QObject* parent );
+	~SimulatedComputer() override;
+
+private:
+	static constexpr int FramebufferWidth = 1920;
+	static constexpr int FramebufferHeight = 1080;
+	static constexpr int ActivityInterval = 1000;
+	static constexpr int ActivityBlockSize = 64;
+	static constexpr int ActivityStepsPerBackground = 30;
+	static constexpr int HextileTileSize = 16;
+	static constexpr int UserlessComputerInterval = 10;
+
+	void readFromClient();
+	bool receiveClientMessage();
+	bool receiveFeatureMessage();
+	bool receiveSetPixelFormatMessage();
+	bool receiveSetEncodingsMessage();
+	bool receiveFramebufferUpdateRequestMessage();
+	bool discardMessage( qint64 size );
+
+	void sendFeatureMessage( const FeatureMessage& message );
+	void sendUserInformation();
+	void sendActiveFeatures();
+	void sendScreens();
+
+	void simulateActivity();
+	void sendFramebufferUpdate();
+
+	void appendRectRaw( QByteArray& message, const QRect& rect ) const;
+	void appendRectHextile( QByteArray& message, const QRect& rect ) const;
+	QByteArray pixelData( QRgb color ) const;
+
+	QByteArray serverInitMessage() const;
+
+	QTcpSocket* m_socket;
+	const int m_index;
+
+	VncServerClient m_client;
+	TestingServerProtocol m_protocol;
+
+	rfbPixelFormat m_pixelFormat{};
+	bool m_hextile{false};
+
+	bool m_updateRequested{false};
+	QRegion m_dirtyRegion;
+	int m_minimumFramebufferUpdateInterval{0};
+	QElapsedTimer m_framebufferUpdateTimer;
+
+	QTimer m_activityTimer{this};
+	int m_activityStep{0};
+	QRect m_activityBlock;
+	QRgb m_activityColor{0};
+	QRgb m_backgroundColor{0};
+
+} ;
@@ -22,9 +22,13 @@
  *
  */
 
+#include <QEventLoop>
+
 #include "CommandLineIO.h"
 #include "AccessControlProvider.h"
+#include "ComputerSimulator.h"
 #include "PlatformNetworkFunctions.h"
+#include "RfbReplayServer.h"
 #include "TestingCommandLinePlugin.h"
 
 
@@ -35,6 +39,8 @@ TestingCommandLinePlugin::TestingCommandLinePlugin( QObject* parent ) :
 { QStringLiteral("authorizedgroups"), QStringLiteral( "check if specified user is in authorized groups [ACCESSING USER]" ) },
 { QStringLiteral("accesscontrolrules"), QStringLiteral( "process access control rules with arguments [ACCESSING USER] [ACCESSING COMPUTER] [LOCAL USER] [LOCAL COMPUTER] [CONNECTED USER] [AUTH METHOD UID]" ) },
 { QStringLiteral("isaccessdeniedbylocalstate"), QStringLiteral( "check if access would be denied by local state") },
+{ QStringLiteral("replayserver"), QStringLiteral( "serve RFB recordings on multiple ports to simulate many computers with arguments [FIRST PORT] [PORT COUNT] [RECORDING FILE[@START SECONDS]]..." ) },
+{ QStringLiteral("simulatecomputers"), QStringLiteral( "simulate computers with scripted screen activity and logged on users with arguments [COUNT] [FIRST PORT] [FIRST ADDRESS]" ) },
 				} )
 {
 }
@@ -133,3 +139,113 @@ CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_ping( con
 
 	return VeyonCore::platform().networkFunctions().ping( arguments.first() ) ? Successful : Failed;
 }
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_replayserver( const QStringList& arguments )
+{
+	if( arguments.count() < 3 )
+	{
+		return NotEnoughArguments;
+	}
+
+	bool firstPortValid = false;
+	bool countValid = false;
+	const auto firstPort = arguments[0].toInt( &firstPortValid );
+	const auto count = arguments[1].toInt( &countValid );
+
+	if( firstPortValid == false || countValid == false || count < 1 || firstPort < 1 || firstPort + count > 65536 )
+	{
+		return InvalidArguments;
+	}
+
+	QVector<RfbRecording::Messages> recordings;
+	for( const auto& argument : arguments.mid( 2 ) )
+	{
+		// playback can start at a later position, e.g. "demo.vrfb@90"
+		auto fileName = argument;
+		qint64 startTime = 0;
+		const auto separator = argument.lastIndexOf( QLatin1Char('@') );
+		if( separator > 0 )
+		{
+			bool startTimeValid = false;
+			const auto startSeconds = argument.mid( separator + 1 ).toDouble( &startTimeValid );
+			if( startTimeValid )
+			{
+				fileName = argument.left( separator );
+				startTime = qint64(startSeconds * 1000);
+			}
+		}
+
+		const auto messages = RfbRecording::load( fileName, startTime );
+		if( messages.isEmpty() )
+		{
+			return Failed;
+		}
+		recordings.append( messages );
+	}
+
+	RfbReplayServer server( recordings );
+	if( server.listen( firstPort, count ) == false )
+	{
+		return Failed;
+	}
+
+	printf( "[TEST]: ReplayServer: serving %d recording(s) on ports %d-%d\n",
+			int(recordings.count()), firstPort, firstPort + count - 1 );
+
+	QEventLoop().exec();
+
+	return Successful;
+}
+
+
+
+CommandLinePluginInterface::RunResult TestingCommandLinePlugin::handle_simulatecomputers( const QStringList& arguments )
+{
+	if( arguments.count() < 2 )
+	{
+		return NotEnoughArguments;
+	}
+
+	bool countValid = false;
+	bool firstPortValid = false;
+	const auto count = arguments[0].toInt( &countValid );
+	const auto firstPort = arguments[1].toInt( &firstPortValid );
+	const QHostAddress firstAddress( arguments.value( 2 ) );
+
+	if( countValid == false || firstPortValid == false || count < 1 || firstPort < 1 || firstPort > 65535 ||
+		( arguments.count() > 2 && firstAddress.isNull() ) )
+	{
+		return InvalidArguments;
+	}
+
+	ComputerSimulator simulator;
+
+	if( firstAddress.isNull() )
+	{
+		if( firstPort + count > 65536 || simulator.listenOnPorts( count, firstPort ) == false )
+		{
+			return Failed;
+		}
+	}
+	else if( simulator.listenOnAddresses( count, firstAddress, firstPort ) == false )
+	{
+		return Failed;
+	}
+
+	// print computer list in a format suitable for "networkobjects import" with "%name%;%host%"
+	for( int i = 0; i < count; ++i )
+	{
+		const auto host = firstAddress.isNull() ?
+							  QStringLiteral("127.0.0.1:%1").arg( firstPort + i ) :
+							  QStringLiteral("%1:%2").arg( QHostAddress( firstAddress.toIPv4Address() + quint32(i) ).toString() )
+														.arg( firstPort );
+		printf( "Simulated computer %d;%s\n", i + 1, qUtf8Printable(host) );
+	}
+	fflush( stdout );
+
+	QEventLoop().exec();
+
+	return Successful;
+}
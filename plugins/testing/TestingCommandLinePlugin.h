@@ -85,6 +85,8 @@ public Q_SLOTS:
 	CommandLinePluginInterface::RunResult handle_accesscontrolrules( const QStringList& arguments );
 	CommandLinePluginInterface::RunResult handle_isaccessdeniedbylocalstate( const QStringList& arguments );
 	CommandLinePluginInterface::RunResult handle_ping( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_replayserver( const QStringList& arguments );
+	CommandLinePluginInterface::RunResult handle_simulatecomputers( const QStringList& arguments );
 
 private:
 	QMap<QString, QString> m_commands;
@@ -0,0 +1,76 @@
+/*
+ * TestingServerProtocol.cpp - implementation of TestingServerProtocol class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include "AuthenticationManager.h"
+#include "TestingServerProtocol.h"
+#include "VncServerClient.h"
+
+
+TestingServerProtocol::TestingServerProtocol( QIODevice* socket, VncServerClient* client ) :
+	VncServerProtocol( socket, client )
+{
+}
+
+
+
+TestingServerProtocol::AuthMethodUids TestingServerProtocol::supportedAuthMethodUids() const
+{
+	AuthMethodUids authMethodUids;
+
+	const auto& plugins = VeyonCore::authenticationManager().plugins();
+	for( auto it = plugins.constBegin(), end = plugins.constEnd(); it != end; ++it )
+	{
+		if( VeyonCore::authenticationManager().isEnabled( it.key() ) )
+		{
+			authMethodUids.append( it.key() );
+		}
+	}
+
+	return authMethodUids;
+}
+
+
+
+void TestingServerProtocol::processAuthenticationMessage( VariantArrayMessage& message )
+{
+	// authenticate masters like a real server would do so they do not need special configuration
+	auto authPlugin = VeyonCore::authenticationManager().plugins().value( client()->authMethodUid() );
+
+	if( authPlugin && VeyonCore::authenticationManager().isEnabled( client()->authMethodUid() ) )
+	{
+		client()->setAuthState( authPlugin->performAuthentication( client(), message ) );
+	}
+	else
+	{
+		client()->setAuthState( VncServerClient::AuthState::Failed );
+	}
+}
+
+
+
+void TestingServerProtocol::performAccessControl()
+{
+	client()->setAccessControlState( VncServerClient::AccessControlState::Successful );
+}
@@ -46,6 +46,9 @@ TextMessageFeaturePlugin::TextMessageFeaturePlugin( QObject* parent ) :
 								   QStringLiteral(":/textmessage/dialog-information.png") ) ),
 	m_features( { m_textMessageFeature } )
 {
+	m_receiptSummaryTimer.setSingleShot( true );
+	m_receiptSummaryTimer.setInterval( ReceiptSummaryDelay );
+	connect( &m_receiptSummaryTimer, &QTimer::timeout, this, &TextMessageFeaturePlugin::logReceipts );
 }
 
 
@@ -71,10 +74,16 @@ bool TextMessageFeaturePlugin::controlFeature( Feature::Uid featureUid,
 	{
 		const auto text = arguments.value( argToString(Argument::Text) ).toString();
 		const auto icon = arguments.value( argToString(Argument::Icon) ).toInt();
+		const auto messageId = QUuid::createUuid();
 
-		sendFeatureMessage( FeatureMessage{ featureUid, ShowTextMessage }
-								.addArgument( Argument::Text, text )
-								.addArgument( Argument::Icon, icon ), computerControlInterfaces );
+		const auto failedCount = sendFeatureMessage( FeatureMessage{ featureUid, ShowTextMessage }
+														 .addArgument( Argument::Text, text )
+														 .addArgument( Argument::Icon, icon )
+														 .addArgument( Argument::MessageId, messageId ),
+													 computerControlInterfaces );
+
+		m_receipts[messageId].sentCount = computerControlInterfaces.size() - failedCount;
+		QTimer::singleShot( ReceiptTimeout, this, [this, messageId]() { m_receipts.remove( messageId ); } );
 
 		return true;
 	}
@@ -133,29 +142,82 @@ bool TextMessageFeaturePlugin::startFeature( VeyonMasterInterface& master, const
 
 
 
+bool TextMessageFeaturePlugin::handleFeatureMessage( ComputerControlInterface::Pointer computerControlInterface,
+													 const FeatureMessage& message )
+{
+	Q_UNUSED(computerControlInterface)
+
+	if( message.featureUid() != m_textMessageFeature.uid() )
+	{
+		return false;
+	}
+
+	const auto it = m_receipts.find( message.argument( Argument::MessageId ).toUuid() );
+	if( it == m_receipts.end() )
+	{
+		return true;
+	}
+
+	if( message.command() == TextMessageDelivered )
+	{
+		++it->deliveredCount;
+	}
+	else if( message.command() == TextMessageRead )
+	{
+		++it->readCount;
+	}
+
+	if( m_receiptSummaryTimer.isActive() == false )
+	{
+		m_receiptSummaryTimer.start();
+	}
+
+	return true;
+}
+
+
+
 bool TextMessageFeaturePlugin::handleFeatureMessage( VeyonServerInterface& server,
 													 const MessageContext& messageContext,
 													 const FeatureMessage& message )
 {
-	Q_UNUSED(messageContext)
+	if( m_textMessageFeature.uid() != message.featureUid() )
+	{
+		return false;
+	}
+
+	const auto messageId = message.argument( Argument::MessageId ).toUuid();
 
-	if( m_textMessageFeature.uid() == message.featureUid() )
+	if( message.command() == ShowTextMessage )
 	{
+		if( messageId.isNull() == false )
+		{
+			m_pendingReceipts[messageId] = messageContext;
+			QTimer::singleShot( ReceiptTimeout, this, [this, messageId]() { m_pendingReceipts.remove( messageId ); } );
+		}
+
 		// forward message to worker
 		server.featureWorkerManager().sendMessageToUnmanagedSessionWorker( message );
 
 		return true;
 	}
 
-	return false;
+	// receipt from worker
+	const auto context = message.command() == TextMessageRead ? m_pendingReceipts.take( messageId )
+															   : m_pendingReceipts.value( messageId );
+	if( context.ioDevice() )
+	{
+		server.sendFeatureMessageReply( context, FeatureMessage{ m_textMessageFeature.uid(), message.command() }
+													 .addArgument( Argument::MessageId, messageId ) );
+	}
+
+	return true;
 }
 
 
 
 bool TextMessageFeaturePlugin::handleFeatureMessage( VeyonWorkerInterface& worker, const FeatureMessage& message )
 {
-	Q_UNUSED(worker)
-
 	if( message.featureUid() == m_textMessageFeature.uid() )
 	{
 		auto messageBox = new QMessageBox( static_cast<QMessageBox::Icon>( message.argument( Argument::Icon ).toInt() ),
@@ -167,9 +229,41 @@ bool TextMessageFeaturePlugin::handleFeatureMessage( VeyonWorkerInterface& worke
 
 		connect( messageBox, &QMessageBox::accepted, messageBox, &QMessageBox::deleteLater );
 
+		const auto messageId = message.argument( Argument::MessageId ).toUuid();
+		if( messageId.isNull() == false )
+		{
+			worker.sendFeatureMessageReply( FeatureMessage{ m_textMessageFeature.uid(), TextMessageDelivered }
+												.addArgument( Argument::MessageId, messageId ) );
+
+			connect( messageBox, &QMessageBox::finished, this, [this, &worker, messageId]() {
+				worker.sendFeatureMessageReply( FeatureMessage{ m_textMessageFeature.uid(), TextMessageRead }
+													.addArgument( Argument::MessageId, messageId ) );
+			} );
+		}
+
 		return true;
 	}
 
 	return true;
 }
 
+
+
+
+void TextMessageFeaturePlugin::logReceipts()
+{
+	for( auto it = m_receipts.begin(); it != m_receipts.end(); )
+	{
+		vInfo() << "text message" << it.key() << "delivered to" << it->deliveredCount
+				<< "and read on" << it->readCount << "of" << it->sentCount << "computers";
+
+		if( it->readCount >= it->sentCount )
+		{
+			it = m_receipts.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
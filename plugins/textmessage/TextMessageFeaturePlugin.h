@@ -24,6 +24,10 @@
 
 #pragma once
 
+#include <QMap>
+#include <QTimer>
+#include <QUuid>
+
 #include "Feature.h"
 #include "FeatureProviderInterface.h"
 
@@ -35,7 +39,8 @@ class TextMessageFeaturePlugin : public QObject, FeatureProviderInterface, Plugi
 public:
 	enum class Argument {
 		Text,
-		Icon
+		Icon,
+		MessageId
 	};
 	Q_ENUM(Argument)
 
@@ -80,6 +85,9 @@ public:
 	bool startFeature( VeyonMasterInterface& master, const Feature& feature,
 					   const ComputerControlInterfaceList& computerControlInterfaces ) override;
 
+	bool handleFeatureMessage( ComputerControlInterface::Pointer computerControlInterface,
+							   const FeatureMessage& message ) override;
+
 	bool handleFeatureMessage( VeyonServerInterface& server,
 							   const MessageContext& messageContext,
 							   const FeatureMessage& message ) override;
@@ -91,10 +99,30 @@ Q_SIGNALS:
 
 private:
 	enum Commands {
-		ShowTextMessage
+		ShowTextMessage,
+		TextMessageDelivered,
+		TextMessageRead
+	};
+
+	static constexpr auto ReceiptSummaryDelay = 1000;
+	static constexpr auto ReceiptTimeout = 60 * 60 * 1000;
+
+	struct Receipts
+	{
+		int sentCount{0};
+		int deliveredCount{0};
+		int readCount{0};
 	};
 
+	void logReceipts();
+
 	const Feature m_textMessageFeature;
 	const FeatureList m_features;
 
+	// receipts are collected and logged once per second instead of for each computer
+	QMap<QUuid, Receipts> m_receipts;
+	QTimer m_receiptSummaryTimer{this};
+
+	QMap<QUuid, MessageContext> m_pendingReceipts;
+
 };
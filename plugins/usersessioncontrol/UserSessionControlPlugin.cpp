@@ -50,6 +50,8 @@ UserSessionControlPlugin::UserSessionControlPlugin( QObject* parent ) :
 						 QStringLiteral( ":/usersessioncontrol/logout-user.png" ) ),
 	m_features( { m_userLoginFeature, m_userLogoffFeature } )
 {
+	m_logonDispatchTimer.setInterval( LogonDispatchInterval );
+	connect( &m_logonDispatchTimer, &QTimer::timeout, this, &UserSessionControlPlugin::dispatchLogons );
 }
 
 
@@ -71,10 +73,24 @@ bool UserSessionControlPlugin::controlFeature( Feature::Uid featureUid, Operatio
 			return false;
 		}
 
-		sendFeatureMessage( FeatureMessage{ featureUid, FeatureMessage::DefaultCommand }
-								.addArgument( Argument::Username, username )
-								.addArgument( Argument::Password, VeyonCore::cryptoCore().encryptPassword( password ) ),
-							computerControlInterfaces );
+		FeatureMessage message{ featureUid, FeatureMessage::DefaultCommand };
+		message.addArgument( Argument::Username, username )
+			.addArgument( Argument::Password, VeyonCore::cryptoCore().encryptPassword( password ) );
+
+		// there's no event loop to dispatch further batches in non-interactive components
+		if( VeyonCore::config().userLogonRate() <= 0 || VeyonCore::component() != VeyonCore::Component::Master )
+		{
+			sendFeatureMessage( message, computerControlInterfaces );
+			return true;
+		}
+
+		m_logonMessage = message;
+		m_pendingLogons = computerControlInterfaces;
+		m_dispatchedLogonCount = 0;
+
+		dispatchLogons();
+
+		m_logonDispatchTimer.start();
 
 		return true;
 	}
@@ -160,6 +176,26 @@ bool UserSessionControlPlugin::handleFeatureMessage( VeyonServerInterface& serve
 
 
 
+void UserSessionControlPlugin::dispatchLogons()
+{
+	const auto count = qMin( VeyonCore::config().userLogonRate(), int(m_pendingLogons.size()) );
+
+	sendFeatureMessage( m_logonMessage, m_pendingLogons.mid( 0, count ) );
+	m_pendingLogons.erase( m_pendingLogons.begin(), m_pendingLogons.begin() + count );
+	m_dispatchedLogonCount += count;
+
+	vInfo() << "logon dispatched to" << m_dispatchedLogonCount << "of"
+			<< m_dispatchedLogonCount + m_pendingLogons.size() << "computers";
+
+	if( m_pendingLogons.isEmpty() )
+	{
+		m_logonDispatchTimer.stop();
+		m_logonMessage = {};
+	}
+}
+
+
+
 bool UserSessionControlPlugin::confirmFeatureExecution( const Feature& feature, bool all, QWidget* parent )
 {
 	if( VeyonCore::config().confirmUnsafeActions() == false )
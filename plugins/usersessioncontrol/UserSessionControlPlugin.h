@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QReadWriteLock>
+#include <QTimer>
 
 #include "FeatureProviderInterface.h"
 
@@ -90,10 +91,21 @@ public:
 							   const FeatureMessage& message ) override;
 
 private:
+	static constexpr auto LogonDispatchInterval = 1000;
+
 	bool confirmFeatureExecution( const Feature& feature, bool all, QWidget* parent );
 
+	void dispatchLogons();
+
 	const Feature m_userLoginFeature;
 	const Feature m_userLogoffFeature;
 	const FeatureList m_features;
 
+	// logons are dispatched in batches so that the domain controllers and file servers
+	// are not hit by all computers at once
+	FeatureMessage m_logonMessage{};
+	ComputerControlInterfaceList m_pendingLogons{};
+	int m_dispatchedLogonCount{0};
+	QTimer m_logonDispatchTimer{this};
+
 };
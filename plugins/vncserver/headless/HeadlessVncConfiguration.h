@@ -29,6 +29,10 @@
 #include "Configuration/Proxy.h"
 
 #define FOREACH_HEADLESS_VNC_CONFIG_PROPERTY(OP) \
-    OP( HeadlessVncConfiguration, m_configuration, QColor, backgroundColor, setBackgroundColor, "BackgroundColor", "HeadlessVncServer", QColor(QStringLiteral("#198cb3")), Configuration::Property::Flag::Advanced )
+    OP( HeadlessVncConfiguration, m_configuration, QColor, backgroundColor, setBackgroundColor, "BackgroundColor", "HeadlessVncServer", QColor(QStringLiteral("#198cb3")), Configuration::Property::Flag::Advanced ) \
+    OP( HeadlessVncConfiguration, m_configuration, int, framebufferWidth, setFramebufferWidth, "FramebufferWidth", "HeadlessVncServer", 640, Configuration::Property::Flag::Advanced ) \
+    OP( HeadlessVncConfiguration, m_configuration, int, framebufferHeight, setFramebufferHeight, "FramebufferHeight", "HeadlessVncServer", 480, Configuration::Property::Flag::Advanced ) \
+    OP( HeadlessVncConfiguration, m_configuration, int, screenCount, setScreenCount, "ScreenCount", "HeadlessVncServer", 1, Configuration::Property::Flag::Advanced ) \
+    OP( HeadlessVncConfiguration, m_configuration, int, colorDepth, setColorDepth, "ColorDepth", "HeadlessVncServer", 32, Configuration::Property::Flag::Advanced )
 
 DECLARE_CONFIG_PROXY(HeadlessVncConfiguration, FOREACH_HEADLESS_VNC_CONFIG_PROPERTY)
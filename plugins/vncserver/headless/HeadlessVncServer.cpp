@@ -34,6 +34,9 @@ extern "C" {
 
 struct HeadlessVncScreen
 {
+	static constexpr auto MaximumFramebufferSize = 8192;
+	static constexpr auto MaximumScreenCount = 16;
+
 	~HeadlessVncScreen()
 	{
 		delete[] passwords[0];
@@ -42,10 +45,140 @@ struct HeadlessVncScreen
 	rfbScreenInfoPtr rfbScreen{nullptr};
 	std::array<char *, 2> passwords{};
 	QImage framebuffer;
+	QColor backgroundColor;
+	QVector<QRect> screens;
 
 };
 
 
+static void setRgb32Format( rfbScreenInfoPtr rfbScreen )
+{
+	rfbScreen->serverFormat.redShift = 16;
+	rfbScreen->serverFormat.greenShift = 8;
+	rfbScreen->serverFormat.blueShift = 0;
+
+	rfbScreen->serverFormat.redMax = 255;
+	rfbScreen->serverFormat.greenMax = 255;
+	rfbScreen->serverFormat.blueMax = 255;
+
+	rfbScreen->serverFormat.trueColour = true;
+	rfbScreen->serverFormat.bitsPerPixel = 32;
+}
+
+
+
+// QImage::Format_RGB555 stores red in the upper and blue in the lower bits
+static void setRgb555Format( rfbScreenInfoPtr rfbScreen )
+{
+	rfbScreen->serverFormat.redShift = 10;
+	rfbScreen->serverFormat.greenShift = 5;
+	rfbScreen->serverFormat.blueShift = 0;
+
+	rfbScreen->serverFormat.redMax = 31;
+	rfbScreen->serverFormat.greenMax = 31;
+	rfbScreen->serverFormat.blueMax = 31;
+
+	rfbScreen->serverFormat.trueColour = true;
+	rfbScreen->serverFormat.bitsPerPixel = 16;
+}
+
+
+
+#ifdef HAVE_LIBVNCSERVER_EXTENDED_DESKTOP_SIZE
+static void resizeFramebuffer( HeadlessVncScreen* screen, QSize size )
+{
+	screen->framebuffer = QImage( size, screen->framebuffer.format() );
+	screen->framebuffer.fill( screen->backgroundColor );
+
+	const auto bytesPerPixel = screen->framebuffer.depth() / 8;
+
+	rfbNewFramebuffer( screen->rfbScreen, reinterpret_cast<char *>( screen->framebuffer.bits() ),
+					   size.width(), size.height(),
+					   bytesPerPixel == 2 ? 5 : 8, 3, bytesPerPixel );
+	screen->rfbScreen->paddedWidthInBytes = int(screen->framebuffer.bytesPerLine());
+
+	if( bytesPerPixel == 4 )
+	{
+		setRgb32Format( screen->rfbScreen );
+	}
+	else
+	{
+		setRgb555Format( screen->rfbScreen );
+	}
+}
+
+
+
+static int setDesktopSize( int width, int height, int numberOfScreens,
+						   rfbExtDesktopScreen* extDesktopScreens, rfbClientPtr client )
+{
+	auto screen = static_cast<HeadlessVncScreen *>( client->screen->screenData );
+
+	if( width <= 0 || height <= 0 ||
+		width > HeadlessVncScreen::MaximumFramebufferSize ||
+		height > HeadlessVncScreen::MaximumFramebufferSize ||
+		numberOfScreens < 1 || numberOfScreens > HeadlessVncScreen::MaximumScreenCount )
+	{
+		return rfbExtDesktopSize_InvalidScreenLayout;
+	}
+
+	const QRect framebufferRect( 0, 0, width, height );
+
+	QVector<QRect> screens;
+	screens.reserve( numberOfScreens );
+
+	for( int i = 0; i < numberOfScreens; ++i )
+	{
+		const QRect geometry( extDesktopScreens[i].x, extDesktopScreens[i].y,
+							  extDesktopScreens[i].width, extDesktopScreens[i].height );
+		if( geometry.isEmpty() || framebufferRect.contains( geometry ) == false )
+		{
+			return rfbExtDesktopSize_InvalidScreenLayout;
+		}
+		screens.append( geometry );
+	}
+
+	screen->screens = screens;
+
+	if( framebufferRect.size() != screen->framebuffer.size() )
+	{
+		resizeFramebuffer( screen, framebufferRect.size() );
+	}
+
+	return rfbExtDesktopSize_Success;
+}
+
+
+
+static int numberOfScreens( rfbClientPtr client )
+{
+	return static_cast<HeadlessVncScreen *>( client->screen->screenData )->screens.size();
+}
+
+
+
+static rfbBool getScreen( int index, rfbExtDesktopScreen* extDesktopScreen, rfbClientPtr client )
+{
+	const auto& screens = static_cast<HeadlessVncScreen *>( client->screen->screenData )->screens;
+	if( index < 0 || index >= screens.size() )
+	{
+		return false;
+	}
+
+	const auto& geometry = screens.at( index );
+	extDesktopScreen->id = uint32_t(index + 1);
+	extDesktopScreen->x = uint16_t(geometry.x());
+	extDesktopScreen->y = uint16_t(geometry.y());
+	extDesktopScreen->width = uint16_t(geometry.width());
+	extDesktopScreen->height = uint16_t(geometry.height());
+	extDesktopScreen->flags = 0;
+
+	return true;
+}
+#endif
+
+
+
 HeadlessVncServer::HeadlessVncServer( QObject* parent ) :
 	QObject( parent ),
 	m_configuration( &VeyonCore::config() )
@@ -72,9 +205,8 @@ bool HeadlessVncServer::runServer( int serverPort, const Password& password )
 
 	while( true )
 	{
-		QThread::msleep( DefaultSleepTime );
-
-		rfbProcessEvents( screen.rfbScreen, 0 );
+		// block until client activity or timeout instead of polling at a fixed rate
+		rfbProcessEvents( screen.rfbScreen, DefaultEventTimeout * 1000 );
 	}
 
 	rfbShutdownServer( screen.rfbScreen, true );
@@ -87,8 +219,30 @@ bool HeadlessVncServer::runServer( int serverPort, const Password& password )
 
 bool HeadlessVncServer::initScreen( HeadlessVncScreen* screen )
 {
-	screen->framebuffer = QImage( DefaultFramebufferWidth, DefaultFramebufferHeight, QImage::Format_RGB32 );
-	screen->framebuffer.fill( m_configuration.backgroundColor() );
+	auto screenWidth = m_configuration.framebufferWidth();
+	auto screenHeight = m_configuration.framebufferHeight();
+	const auto screenCount = qBound( 1, m_configuration.screenCount(), HeadlessVncScreen::MaximumScreenCount );
+
+	if( screenWidth <= 0 || screenHeight <= 0 ||
+		screenWidth * screenCount > HeadlessVncScreen::MaximumFramebufferSize ||
+		screenHeight > HeadlessVncScreen::MaximumFramebufferSize )
+	{
+		vWarning() << "invalid framebuffer geometry configured, using defaults";
+		screenWidth = DefaultFramebufferWidth;
+		screenHeight = DefaultFramebufferHeight;
+	}
+
+	// arrange virtual heads side by side
+	for( int i = 0; i < screenCount; ++i )
+	{
+		screen->screens.append( QRect( i * screenWidth, 0, screenWidth, screenHeight ) );
+	}
+
+	const auto format = m_configuration.colorDepth() == 16 ? QImage::Format_RGB555 : QImage::Format_RGB32;
+
+	screen->backgroundColor = m_configuration.backgroundColor();
+	screen->framebuffer = QImage( screenWidth * screenCount, screenHeight, format );
+	screen->framebuffer.fill( screen->backgroundColor );
 
 	return true;
 }
@@ -98,9 +252,12 @@ bool HeadlessVncServer::initScreen( HeadlessVncScreen* screen )
 bool HeadlessVncServer::initVncServer( int serverPort, const VncServerPluginInterface::Password& password,
 									  HeadlessVncScreen* screen )
 {
+	const auto bytesPerPixel = screen->framebuffer.depth() / 8;
+
+	// 16 bit framebuffers use RGB555, the pixel format is set up accordingly below
 	auto rfbScreen = rfbGetScreen( nullptr, nullptr,
 								   screen->framebuffer.width(), screen->framebuffer.height(),
-								   8, 3, 4 );
+								   bytesPerPixel == 2 ? 5 : 8, 3, bytesPerPixel );
 
 	if( rfbScreen == nullptr )
 	{
@@ -111,31 +268,39 @@ bool HeadlessVncServer::initVncServer( int serverPort, const VncServerPluginInte
 
 	rfbScreen->desktopName = "VeyonVNC";
 	rfbScreen->frameBuffer = reinterpret_cast<char *>( screen->framebuffer.bits() );
+	// QImage pads scanlines to 32 bit boundaries
+	rfbScreen->paddedWidthInBytes = int(screen->framebuffer.bytesPerLine());
 	rfbScreen->port = serverPort;
 	rfbScreen->ipv6port = serverPort;
 
 	rfbScreen->authPasswdData = screen->passwords.data();
 	rfbScreen->passwordCheck = rfbCheckPasswordByList;
 
-	rfbScreen->serverFormat.redShift = 16;
-	rfbScreen->serverFormat.greenShift = 8;
-	rfbScreen->serverFormat.blueShift = 0;
-
-	rfbScreen->serverFormat.redMax = 255;
-	rfbScreen->serverFormat.greenMax = 255;
-	rfbScreen->serverFormat.blueMax = 255;
-
-	rfbScreen->serverFormat.trueColour = true;
-	rfbScreen->serverFormat.bitsPerPixel = 32;
+	if( bytesPerPixel == 4 )
+	{
+		setRgb32Format( rfbScreen );
+	}
+	else
+	{
+		setRgb555Format( rfbScreen );
+	}
 
 	rfbScreen->alwaysShared = true;
 	rfbScreen->handleEventsEagerly = true;
-	rfbScreen->deferUpdateTime = 5;
+	// send updates within the same event processing pass as the framebuffer never changes and
+	// deferred updates would otherwise wait for the next client activity or the event timeout
+	rfbScreen->deferUpdateTime = 0;
 
 	rfbScreen->screenData = screen;
 
 	rfbScreen->cursor = nullptr;
 
+#ifdef HAVE_LIBVNCSERVER_EXTENDED_DESKTOP_SIZE
+	rfbScreen->setDesktopSizeHook = setDesktopSize;
+	rfbScreen->numberOfExtDesktopScreensHook = numberOfScreens;
+	rfbScreen->getExtDesktopScreenHook = getScreen;
+#endif
+
 	rfbInitServer( rfbScreen );
 
 	rfbMarkRectAsModified( rfbScreen, 0, 0, rfbScreen->width, rfbScreen->height );
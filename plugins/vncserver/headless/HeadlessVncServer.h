@@ -100,7 +100,7 @@ public:
 private:
 	static constexpr auto DefaultFramebufferWidth = 640;
 	static constexpr auto DefaultFramebufferHeight = 480;
-	static constexpr auto DefaultSleepTime = 25;
+	static constexpr auto DefaultEventTimeout = 5000;
 
 	bool initScreen( HeadlessVncScreen* screen );
 	bool initVncServer( int serverPort, const VncServerPluginInterface::Password& password,
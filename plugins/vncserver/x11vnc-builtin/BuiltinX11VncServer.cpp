@@ -66,6 +66,18 @@ bool BuiltinX11VncServer::runServer( int serverPort, const Password& password )
 							QStringLiteral("-no6"),
 						  } ;
 
+	// x11vnc polls the screen continuously as long as any client is connected, regardless of how
+	// often updates are requested, so allow trading update latency for CPU time
+	if( m_configuration.pollingInterval() > 0 )
+	{
+		cmdline.append( { QStringLiteral("-wait"), QString::number( m_configuration.pollingInterval() ) } );
+	}
+
+	if( m_configuration.updateDeferTime() >= 0 )
+	{
+		cmdline.append( { QStringLiteral("-defer"), QString::number( m_configuration.updateDeferTime() ) } );
+	}
+
 	const auto extraArguments = m_configuration.extraArguments();
 
 	if( extraArguments.isEmpty() == false )
@@ -89,6 +101,11 @@ bool BuiltinX11VncServer::runServer( int serverPort, const Password& password )
 	{
 		cmdline.append( QStringLiteral("-noxdamage") );
 	}
+	else if( m_configuration.trustXDamage() )
+	{
+		// use all damage rectangles as they are instead of verifying them by polling the screen
+		cmdline.append( { QStringLiteral("-xd_area"), QStringLiteral("0") } );
+	}
 
 #ifdef VEYON_X11VNC_EXTERNAL
 	QTemporaryFile tempFile;
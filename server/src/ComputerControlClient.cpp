@@ -79,9 +79,10 @@ bool ComputerControlClient::receiveClientMessage()
 
 		const auto messageData = socket->read(sz_rfbFramebufferUpdateRequestMsg);
 		const auto updateRequestMessage = reinterpret_cast<const rfbFramebufferUpdateRequestMsg *>(messageData.constData());
+		const auto updateInterval = qMax(m_minimumFramebufferUpdateInterval, m_budgetFramebufferUpdateInterval);
 
 		if (updateRequestMessage->incremental &&
-			m_framebufferUpdateTimer.hasExpired(m_minimumFramebufferUpdateInterval) == false)
+			m_framebufferUpdateTimer.hasExpired(updateInterval) == false)
 		{
 			// discard update request
 			return true;
@@ -101,3 +102,10 @@ void ComputerControlClient::setMinimumFramebufferUpdateInterval(int interval)
 {
 	m_minimumFramebufferUpdateInterval = interval;
 }
+
+
+
+void ComputerControlClient::setBudgetFramebufferUpdateInterval(int interval)
+{
+	m_budgetFramebufferUpdateInterval = interval;
+}
@@ -55,6 +55,15 @@ public:
 
 	void setMinimumFramebufferUpdateInterval(int interval);
 
+	// clients which did not request a minimum update interval (e.g. remote access sessions)
+	// are not subject to the framebuffer update budget of the server
+	bool isBackgroundClient() const
+	{
+		return m_minimumFramebufferUpdateInterval > 0;
+	}
+
+	void setBudgetFramebufferUpdateInterval(int interval);
+
 protected:
 	VncClientProtocol& clientProtocol() override
 	{
@@ -75,6 +84,7 @@ private:
 	VncClientProtocol m_clientProtocol;
 
 	int m_minimumFramebufferUpdateInterval{-1};
+	int m_budgetFramebufferUpdateInterval{-1};
 	QElapsedTimer m_framebufferUpdateTimer;
 
 } ;
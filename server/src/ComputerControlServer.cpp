@@ -23,6 +23,7 @@
  */
 
 #include <QCoreApplication>
+#include <QElapsedTimer>
 
 #include "AccessControlProvider.h"
 #include "BuiltinFeatures.h"
@@ -31,8 +32,11 @@
 #include "FeatureManager.h"
 #include "FeatureMessage.h"
 #include "HostAddress.h"
+#include "Metrics.h"
+#include "MonitoringMode.h"
 #include "VeyonConfiguration.h"
 #include "SystemTrayIcon.h"
+#include "Tracer.h"
 
 
 ComputerControlServer::ComputerControlServer( QObject* parent ) :
@@ -59,7 +63,10 @@ ComputerControlServer::ComputerControlServer( QObject* parent ) :
 
 	connect(&m_vncProxyServer, &VncProxyServer::serverMessageProcessed,
 			 this, &ComputerControlServer::sendAsyncFeatureMessages, Qt::DirectConnection);
+	connect(&VeyonCore::builtinFeatures().monitoringMode(), &MonitoringMode::stateChanged,
+			 this, &ComputerControlServer::pushAsyncFeatureMessages, Qt::QueuedConnection);
 	connect( &m_vncProxyServer, &VncProxyServer::connectionClosed, this, &ComputerControlServer::updateTrayIconToolTip );
+	connect( &m_vncProxyServer, &VncProxyServer::connectionClosed, this, &ComputerControlServer::updateFramebufferUpdateBudget );
 }
 
 
@@ -68,6 +75,8 @@ ComputerControlServer::~ComputerControlServer()
 {
 	vDebug();
 
+	announcePresence( PresenceAnnouncement::Event::Stopped );
+
 	m_vncProxyServer.stop();
 }
 
@@ -75,6 +84,8 @@ ComputerControlServer::~ComputerControlServer()
 
 bool ComputerControlServer::start()
 {
+	const Tracer::Scope traceScope( "ComputerControlServer::start" );
+
 	if( m_vncProxyServer.start( m_vncServer.serverPort(), m_vncServer.password() ) == false )
 	{
 		return false;
@@ -83,11 +94,53 @@ bool ComputerControlServer::start()
 	m_vncServer.prepare();
 	m_vncServer.start();
 
+	if( VeyonCore::config().metricsServerPort() > 0 )
+	{
+		m_metricsServer.start( VeyonCore::config().metricsServerPort() + VeyonCore::sessionId() );
+	}
+
+	if( VeyonCore::config().presenceAnnouncementsEnabled() )
+	{
+		m_presenceSocket = new QUdpSocket( this );
+		m_announcedUserInfoVersion = VeyonCore::builtinFeatures().monitoringMode().userInfoVersion();
+
+		connect( &VeyonCore::builtinFeatures().monitoringMode(), &MonitoringMode::stateChanged,
+				 this, &ComputerControlServer::announceSessionChange, Qt::QueuedConnection );
+
+		announcePresence( PresenceAnnouncement::Event::Started );
+	}
+
 	return true;
 }
 
 
 
+void ComputerControlServer::announcePresence( PresenceAnnouncement::Event event )
+{
+	if( m_presenceSocket == nullptr )
+	{
+		return;
+	}
+
+	m_presenceSocket->writeDatagram( PresenceAnnouncement::create( event, HostAddress::localFQDN() ),
+									 QHostAddress::Broadcast, quint16(VeyonCore::config().presenceAnnouncementPort()) );
+}
+
+
+
+void ComputerControlServer::announceSessionChange()
+{
+	// monitoring mode also reports changes of active features and screens
+	const auto userInfoVersion = VeyonCore::builtinFeatures().monitoringMode().userInfoVersion();
+	if( userInfoVersion != m_announcedUserInfoVersion )
+	{
+		m_announcedUserInfoVersion = userInfoVersion;
+		announcePresence( PresenceAnnouncement::Event::SessionChanged );
+	}
+}
+
+
+
 VncProxyConnection* ComputerControlServer::createVncProxyConnection( QTcpSocket* clientSocket,
 																	 int vncServerPort,
 																	 const Password& vncServerPassword,
@@ -128,8 +181,14 @@ bool ComputerControlServer::handleFeatureMessage(ComputerControlClient* client)
 		return false;
 	}
 
+	QElapsedTimer processingTimer;
+	processingTimer.start();
+
 	VeyonCore::featureManager().handleFeatureMessage( *this, MessageContext{socket, client}, featureMessage );
 
+	Metrics::increment( "veyon_feature_messages_total" );
+	Metrics::observe( "veyon_feature_message_processing_seconds", double(processingTimer.nsecsElapsed()) / 1e9 );
+
 	return true;
 }
 
@@ -137,7 +196,7 @@ bool ComputerControlServer::handleFeatureMessage(ComputerControlClient* client)
 
 bool ComputerControlServer::sendFeatureMessageReply( const MessageContext& context, const FeatureMessage& reply )
 {
-	vDebug() << reply;
+	vDebug() << reply.featureUid() << reply.command();
 
 	if( context.ioDevice() )
 	{
@@ -158,6 +217,7 @@ void ComputerControlServer::setMinimumFramebufferUpdateInterval(const MessageCon
 	if (client)
 	{
 		client->setMinimumFramebufferUpdateInterval(interval);
+		updateFramebufferUpdateBudget();
 	}
 }
 
@@ -258,6 +318,8 @@ QFutureWatcher<void>* ComputerControlServer::resolveFQDNs( const QStringList& ho
 	auto watcher = new QFutureWatcher<void>();
 
 	watcher->setFuture( QtConcurrent::run( [this, hosts]() {
+		HostAddress::prefetch( hosts );
+
 		for( const auto& host : hosts )
 		{
 			const auto fqdn = HostAddress( host ).tryConvert( HostAddress::Type::FullyQualifiedDomainName );
@@ -282,6 +344,62 @@ void ComputerControlServer::sendAsyncFeatureMessages(VncProxyConnection* connect
 
 
 
+void ComputerControlServer::pushAsyncFeatureMessages()
+{
+	// deliver state changes immediately instead of waiting for the next message from
+	// the VNC server, which may not arrive for a long time if the screen is static
+	for (auto connection : m_vncProxyServer.clients())
+	{
+		if (connection->isRunning())
+		{
+			sendAsyncFeatureMessages(connection);
+		}
+	}
+}
+
+
+
+void ComputerControlServer::updateFramebufferUpdateBudget( VncProxyConnection* closedConnection )
+{
+	const auto budget = VeyonCore::config().framebufferUpdateBudget();
+
+	QVector<ComputerControlClient *> backgroundClients;
+	for (auto connection : m_vncProxyServer.clients())
+	{
+		auto client = qobject_cast<ComputerControlClient *>(connection);
+		if (client == nullptr || connection == closedConnection)
+		{
+			continue;
+		}
+
+		if (budget > 0 && client->isBackgroundClient())
+		{
+			backgroundClients.append(client);
+		}
+		else
+		{
+			// clients which left background mode (e.g. remote access sessions) are not throttled
+			client->setBudgetFramebufferUpdateInterval(-1);
+		}
+	}
+
+	if (backgroundClients.isEmpty())
+	{
+		return;
+	}
+
+	// share the configured number of updates per second between all monitoring clients
+	// while leaving remote access sessions unthrottled
+	const auto interval = backgroundClients.size() * 1000 / budget;
+
+	for (auto client : qAsConst(backgroundClients))
+	{
+		client->setBudgetFramebufferUpdateInterval(interval);
+	}
+}
+
+
+
 void ComputerControlServer::updateTrayIconToolTip()
 {
 	auto toolTip = tr( "%1 Service %2 at %3:%4" ).arg( VeyonCore::applicationName(), VeyonCore::versionString(),
@@ -25,9 +25,12 @@
 #pragma once
 
 #include <QMutex>
+#include <QUdpSocket>
 #include <QtConcurrent>
 
 #include "FeatureWorkerManager.h"
+#include "MetricsServer.h"
+#include "PresenceAnnouncement.h"
 #include "ServerAuthenticationManager.h"
 #include "ServerAccessControlManager.h"
 #include "VeyonServerInterface.h"
@@ -84,8 +87,13 @@ private:
 	QFutureWatcher<void>* resolveFQDNs( const QStringList& hosts );
 
 	void sendAsyncFeatureMessages(VncProxyConnection* connection);
+	void pushAsyncFeatureMessages();
+	void updateFramebufferUpdateBudget( VncProxyConnection* closedConnection = nullptr );
 	void updateTrayIconToolTip();
 
+	void announcePresence( PresenceAnnouncement::Event event );
+	void announceSessionChange();
+
 	QMutex m_dataMutex{};
 	QStringList m_allowedIPs{};
 
@@ -102,4 +110,9 @@ private:
 	VncServer m_vncServer{};
 	VncProxyServer m_vncProxyServer;
 
+	MetricsServer m_metricsServer{this};
+
+	QUdpSocket* m_presenceSocket{nullptr};
+	int m_announcedUserInfoVersion{0};
+
 } ;
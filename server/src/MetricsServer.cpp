@@ -0,0 +1,104 @@
+/*
+ * MetricsServer.cpp - implementation of MetricsServer class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#include <QTcpSocket>
+
+#include "Metrics.h"
+#include "MetricsServer.h"
+
+
+MetricsServer::MetricsServer( QObject* parent ) :
+	QObject( parent )
+{
+	connect( &m_tcpServer, &QTcpServer::newConnection, this, &MetricsServer::acceptConnection );
+}
+
+
+
+MetricsServer::~MetricsServer()
+{
+	Metrics::setEnabled( false );
+}
+
+
+
+bool MetricsServer::start( int port )
+{
+	if( m_tcpServer.listen( QHostAddress::LocalHost, quint16(port) ) == false )
+	{
+		vWarning() << "could not listen on port" << port << m_tcpServer.errorString();
+		return false;
+	}
+
+	vDebug() << "started on port" << port;
+
+	Metrics::setEnabled( true );
+
+	return true;
+}
+
+
+
+void MetricsServer::acceptConnection()
+{
+	while( m_tcpServer.hasPendingConnections() )
+	{
+		auto socket = m_tcpServer.nextPendingConnection();
+
+		connect( socket, &QTcpSocket::readyRead, this, [=]() { processRequest( socket ); } );
+		connect( socket, &QTcpSocket::disconnected, socket, &QTcpSocket::deleteLater );
+	}
+}
+
+
+
+void MetricsServer::processRequest( QTcpSocket* socket )
+{
+	// wait for the complete request header - the request itself does not matter as
+	// all requests are answered with the current metrics
+	const auto endOfHeader = QByteArrayLiteral("\r\n\r\n");
+	if( socket->bytesAvailable() > MaximumRequestSize )
+	{
+		socket->abort();
+		return;
+	}
+
+	const auto request = socket->peek( MaximumRequestSize );
+	if( request.contains( endOfHeader ) == false )
+	{
+		return;
+	}
+
+	socket->readAll();
+
+	const auto body = request.startsWith( "GET " ) ? Metrics::toPrometheusText() : QByteArray{};
+
+	socket->write( request.startsWith( "GET " ) ? "HTTP/1.0 200 OK\r\n" : "HTTP/1.0 405 Method Not Allowed\r\n" );
+	socket->write( "Content-Type: text/plain; version=0.0.4\r\n"
+				   "Connection: close\r\n"
+				   "Content-Length: " + QByteArray::number( body.size() ) + "\r\n\r\n" );
+	socket->write( body );
+	socket->disconnectFromHost();
+}
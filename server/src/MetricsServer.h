@@ -0,0 +1,48 @@
+/*
+ * MetricsServer.h - declaration of MetricsServer class
+ *
+ * Copyright (c) 2022 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+
+#pragma once
+
+#include <QTcpServer>
+
+// serves the metrics recorded via Metrics to local HTTP clients such as a Prometheus node agent
+class MetricsServer : public QObject
+{
+	Q_OBJECT
+public:
+	explicit MetricsServer( QObject* parent = nullptr );
+	~MetricsServer() override;
+
+	bool start( int port );
+
+private:
+	static constexpr int MaximumRequestSize = 8192;
+
+	void acceptConnection();
+	void processRequest( QTcpSocket* socket );
+
+	QTcpServer m_tcpServer{this};
+
+} ;
@@ -23,6 +23,7 @@
  */
 
 #include "AuthenticationManager.h"
+#include "Metrics.h"
 #include "ServerAuthenticationManager.h"
 #include "VeyonConfiguration.h"
 
@@ -58,6 +59,13 @@ void ServerAuthenticationManager::processAuthenticationMessage( VncServerClient*
 	{
 	case VncServerClient::AuthState::Failed:
 	case VncServerClient::AuthState::Successful:
+		Metrics::increment( "veyon_authentications_total", 1, QStringLiteral("result"),
+							client->authState() == VncServerClient::AuthState::Successful ?
+								QStringLiteral("successful") : QStringLiteral("failed") );
+		if( client->authenticationTimer().isValid() )
+		{
+			Metrics::observe( "veyon_authentication_duration_seconds", double(client->authenticationTimer().elapsed()) / 1000 );
+		}
 		Q_EMIT finished( client );
 		break;
 	default:
@@ -22,10 +22,19 @@
  *
  */
 
+#include <QSocketNotifier>
 #include <QSslKey>
 #include <QSslSocket>
+#include <QTimer>
+
+#ifdef Q_OS_WIN
+#include <winsock2.h>
+#else
+#include <sys/socket.h>
+#endif
 
 #include "TlsServer.h"
+#include "VeyonConfiguration.h"
 
 
 TlsServer::TlsServer( const VeyonCore::TlsConfiguration& tlsConfig, QObject* parent ) :
@@ -52,34 +61,131 @@ void TlsServer::incomingConnection( qintptr socketDescriptor )
 			delete socket;
 		}
 	}
+	else if( VeyonCore::config().unencryptedNetworks().isEmpty() )
+	{
+		startEncryption( socketDescriptor );
+	}
 	else
 	{
-		auto socket = new QSslSocket;
-		if( socket->setSocketDescriptor(socketDescriptor) )
+		negotiateTransport( socketDescriptor );
+	}
+}
+
+
+
+void TlsServer::negotiateTransport( qintptr socketDescriptor )
+{
+	// clients either start the TLS handshake right away or explicitly request an unencrypted
+	// transport so both sides always agree on the transport instead of guessing it on their own
+	auto notifier = new QSocketNotifier( socketDescriptor, QSocketNotifier::Read, this );
+
+	QTimer::singleShot( TransportNegotiationTimeout, notifier, [=]() {
+		if( notifier->isEnabled() )
 		{
-			connect(socket, QOverload<const QList<QSslError>&>::of(&QSslSocket::sslErrors),
-					 [this, socket]( const QList<QSslError> &errors) {
-						 for( const auto& err : errors )
-						 {
-							 vCritical() << "SSL error" << err;
-						 }
+			vWarning() << "no transport requested for socket" << socketDescriptor;
+			notifier->setEnabled( false );
+			notifier->deleteLater();
+			closeSocket( socketDescriptor );
+		}
+	} );
 
-						 Q_EMIT tlsErrors( socket, errors );
-					 } );
+	connect( notifier, &QSocketNotifier::activated, this, [=]() {
+		notifier->setEnabled( false );
+		notifier->deleteLater();
 
-			connect(socket, &QSslSocket::encrypted, this,
-					 []() { vDebug() << "connection encryption established"; } );
+		// peek on the descriptor itself so a TLS ClientHello is left untouched for QSslSocket
+		char transportRequest = 0;
+		if( ::recv( SocketHandle(socketDescriptor), &transportRequest, 1, MSG_PEEK ) != 1 )
+		{
+			closeSocket( socketDescriptor );
+			return;
+		}
 
-			socket->setSslConfiguration( m_tlsConfig );
-			socket->startServerEncryption();
+		if( transportRequest != VeyonCore::PlainTransportRequest )
+		{
+			startEncryption( socketDescriptor );
+			emitNewConnection();
+			return;
+		}
 
-			vDebug() << "establishing TLS connection for socket" << socketDescriptor;
-			addPendingConnection( socket );
+		// consume the request
+		if( ::recv( SocketHandle(socketDescriptor), &transportRequest, 1, 0 ) != 1 )
+		{
+			closeSocket( socketDescriptor );
+			return;
 		}
-		else
+
+		auto socket = new QSslSocket;
+		if( socket->setSocketDescriptor( socketDescriptor ) == false )
+		{
+			vCritical() << "failed to set socket descriptor for incoming non-TLS connection";
+			delete socket;
+			return;
+		}
+
+		if( VeyonCore::isTransportEncryptionRequired( socket->peerAddress() ) )
 		{
-			vCritical() << "failed to set socket descriptor for incoming TLS connection";
+			vWarning() << "rejecting unencrypted connection from" << socket->peerAddress();
 			delete socket;
+			return;
 		}
+
+		vDebug() << "accepting unencrypted connection from trusted network for socket" << socketDescriptor;
+		addPendingConnection( socket );
+		emitNewConnection();
+	} );
+}
+
+
+
+void TlsServer::startEncryption( qintptr socketDescriptor )
+{
+	auto socket = new QSslSocket;
+	if( socket->setSocketDescriptor(socketDescriptor) )
+	{
+		connect(socket, QOverload<const QList<QSslError>&>::of(&QSslSocket::sslErrors),
+				 [this, socket]( const QList<QSslError> &errors) {
+					 for( const auto& err : errors )
+					 {
+						 vCritical() << "SSL error" << err;
+					 }
+
+					 Q_EMIT tlsErrors( socket, errors );
+				 } );
+
+		connect(socket, &QSslSocket::encrypted, this,
+				 []() { vDebug() << "connection encryption established"; } );
+
+		socket->setSslConfiguration( m_tlsConfig );
+		socket->startServerEncryption();
+
+		vDebug() << "establishing TLS connection for socket" << socketDescriptor;
+		addPendingConnection( socket );
+	}
+	else
+	{
+		vCritical() << "failed to set socket descriptor for incoming TLS connection";
+		delete socket;
 	}
 }
+
+
+
+void TlsServer::closeSocket( qintptr socketDescriptor )
+{
+	QTcpSocket socket;
+	if( socket.setSocketDescriptor( socketDescriptor ) )
+	{
+		socket.abort();
+	}
+}
+
+
+
+void TlsServer::emitNewConnection()
+{
+	// connections added after incomingConnection() returned are not announced by QTcpServer itself
+#if QT_VERSION < QT_VERSION_CHECK(6, 4, 0)
+	Q_EMIT newConnection();
+#endif
+}
@@ -40,6 +40,19 @@ protected:
 	void incomingConnection( qintptr socketDescriptor ) override;
 
 private:
+	static constexpr auto TransportNegotiationTimeout = 10000;
+
+#ifdef Q_OS_WIN
+	using SocketHandle = SOCKET;
+#else
+	using SocketHandle = int;
+#endif
+
+	void negotiateTransport( qintptr socketDescriptor );
+	void startEncryption( qintptr socketDescriptor );
+	void closeSocket( qintptr socketDescriptor );
+	void emitNewConnection();
+
 	VeyonCore::TlsConfiguration m_tlsConfig;
 
 Q_SIGNALS:
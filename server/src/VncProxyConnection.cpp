@@ -27,6 +27,9 @@
 #include <QTcpSocket>
 #include <QTimer>
 
+#include "Metrics.h"
+#include "RfbContinuousUpdates.h"
+#include "RfbRecording.h"
 #include "VncClientProtocol.h"
 #include "VncProxyConnection.h"
 #include "VncServerProtocol.h"
@@ -44,11 +47,27 @@ VncProxyConnection::VncProxyConnection( QTcpSocket* clientSocket,
 		{ rfbKeyEvent, sz_rfbKeyEventMsg },
 		{ rfbPointerEvent, sz_rfbPointerEventMsg },
 		{ rfbXvp, sz_rfbXvpMsg },
+		{ rfbSetScale, sz_rfbSetScaleMsg },
 		} )
 {
+	// keyboard and pointer events must not be held back by Nagle's algorithm
+	m_proxyClientSocket->setSocketOption( QAbstractSocket::LowDelayOption, 1 );
+	// socket options can only be applied once the socket has been connected
+	connect( m_vncServerSocket, &QTcpSocket::connected, this, [this]() {
+		m_vncServerSocket->setSocketOption( QAbstractSocket::LowDelayOption, 1 );
+	} );
+
 	connect( m_proxyClientSocket, &QTcpSocket::readyRead, this, &VncProxyConnection::readFromClient );
 	connect( m_vncServerSocket, &QTcpSocket::readyRead, this, &VncProxyConnection::readFromServer );
 
+	// bound the memory used per connection - once the buffers are full, TCP flow control
+	// throttles the peers instead of letting the buffers grow with bursty or slow connections
+	m_proxyClientSocket->setReadBufferSize( ClientReadBufferSize );
+	m_vncServerSocket->setReadBufferSize( ServerReadBufferSize );
+
+	connect( m_proxyClientSocket, &QTcpSocket::bytesWritten, this, &VncProxyConnection::requestContinuousUpdate );
+	connect( m_proxyClientSocket, &QTcpSocket::bytesWritten, this, &VncProxyConnection::resumeReadingFromServer );
+
 	connect( m_vncServerSocket, &QTcpSocket::disconnected, this, &VncProxyConnection::clientConnectionClosed );
 	connect( m_proxyClientSocket, &QTcpSocket::disconnected, this, &VncProxyConnection::serverConnectionClosed );
 }
@@ -63,6 +82,8 @@ VncProxyConnection::~VncProxyConnection()
 
 	delete m_vncServerSocket;
 	delete m_proxyClientSocket;
+
+	delete m_recording;
 }
 
 
@@ -74,6 +95,14 @@ void VncProxyConnection::start()
 
 
 
+bool VncProxyConnection::isRunning()
+{
+	return clientProtocol().state() == VncClientProtocol::State::Running &&
+			serverProtocol().state() == VncServerProtocol::State::Running;
+}
+
+
+
 void VncProxyConnection::readFromClient()
 {
 	if( serverProtocol().state() != VncServerProtocol::State::Running )
@@ -89,8 +118,14 @@ void VncProxyConnection::readFromClient()
 	}
 	else if( clientProtocol().state() == VncClientProtocol::State::Running )
 	{
+		int messageCount = 0;
 		while( receiveClientMessage() )
 		{
+			if( ++messageCount >= MaximumMessagesPerRead )
+			{
+				continueReadingFromClient();
+				break;
+			}
 		}
 	}
 	else
@@ -127,14 +162,40 @@ void VncProxyConnection::readFromServer()
 			// we can forward to the real client
 			serverProtocol().setServerInitMessage( clientProtocol().serverInitMessage() );
 
+			if( RfbRecording::isEnabled() && m_recording == nullptr )
+			{
+				m_recording = new RfbRecording( m_proxyClientSocket->peerAddress().toString() );
+				m_recording->record( clientProtocol().serverInitMessage() );
+			}
+
 			readFromServerLater();
 		}
 	}
 	else if( serverProtocol().state() == VncServerProtocol::State::Running )
 	{
+		// do not queue up more data for a client which can't keep up - resumed once data has been written
+		if( m_proxyClientSocket->bytesToWrite() > MaximumClientSendBacklog )
+		{
+			m_readingFromServerPaused = true;
+			return;
+		}
+
+		int messageCount = 0;
 		while( receiveServerMessage() )
 		{
 			Q_EMIT serverMessageProcessed();
+
+			if( m_proxyClientSocket->bytesToWrite() > MaximumClientSendBacklog )
+			{
+				m_readingFromServerPaused = true;
+				break;
+			}
+
+			if( ++messageCount >= MaximumMessagesPerRead )
+			{
+				continueReadingFromServer();
+				break;
+			}
 		}
 	}
 	else
@@ -169,6 +230,7 @@ bool VncProxyConnection::forwardDataToServer( qint64 size )
 		const auto data = m_proxyClientSocket->read( size ); // Flawfinder: ignore
 		if( data.size() == size )
 		{
+			Metrics::increment( "veyon_proxy_received_bytes_total", size );
 			return m_vncServerSocket->write( data ) == size;
 		}
 	}
@@ -192,6 +254,47 @@ void VncProxyConnection::readFromClientLater()
 
 
 
+void VncProxyConnection::continueReadingFromServer()
+{
+	// return to the event loop so that other connections sharing it are not starved
+	// by a single client pulling large framebuffer updates
+	if( m_continueReadingFromServer == false )
+	{
+		m_continueReadingFromServer = true;
+		QTimer::singleShot( 0, this, [this]() {
+			m_continueReadingFromServer = false;
+			readFromServer();
+		} );
+	}
+}
+
+
+
+void VncProxyConnection::resumeReadingFromServer()
+{
+	if( m_readingFromServerPaused && m_proxyClientSocket->bytesToWrite() <= MaximumClientSendBacklog / 2 )
+	{
+		m_readingFromServerPaused = false;
+		continueReadingFromServer();
+	}
+}
+
+
+
+void VncProxyConnection::continueReadingFromClient()
+{
+	if( m_continueReadingFromClient == false )
+	{
+		m_continueReadingFromClient = true;
+		QTimer::singleShot( 0, this, [this]() {
+			m_continueReadingFromClient = false;
+			readFromClient();
+		} );
+	}
+}
+
+
+
 bool VncProxyConnection::receiveClientMessage()
 {
 	auto socket = proxyClientSocket();
@@ -204,23 +307,33 @@ bool VncProxyConnection::receiveClientMessage()
 
 	switch( messageType )
 	{
+	case rfbSetPixelFormat:
+		return receiveSetPixelFormatMessage();
+
 	case rfbSetEncodings:
-		if( socket->bytesAvailable() >= sz_rfbSetEncodingsMsg )
+		return receiveSetEncodingsMessage();
+
+	case rfbKeyEvent:
+		return receiveKeyEventMessage();
+
+	case rfbPointerEvent:
+		return receivePointerEventMessage();
+
+	case RfbContinuousUpdates::EnableMessageType:
+		return receiveEnableContinuousUpdatesMessage();
+
+	case rfbFramebufferUpdateRequest:
+		if( m_continuousUpdatesEnabled && socket->bytesAvailable() >= sz_rfbFramebufferUpdateRequestMsg )
 		{
-			rfbSetEncodingsMsg setEncodingsMessage;
-			if( socket->peek( reinterpret_cast<char *>( &setEncodingsMessage ), sz_rfbSetEncodingsMsg ) == sz_rfbSetEncodingsMsg )
+			rfbFramebufferUpdateRequestMsg updateRequest;
+			if( socket->peek( reinterpret_cast<char *>( &updateRequest ), sz_rfbFramebufferUpdateRequestMsg ) == sz_rfbFramebufferUpdateRequestMsg &&
+				updateRequest.incremental )
 			{
-				const auto nEncodings = qFromBigEndian(setEncodingsMessage.nEncodings);
-				if( nEncodings > MAX_ENCODINGS )
-				{
-					vCritical() << "received too many encodings from client";
-					socket->close();
-					return false;
-				}
-				return forwardDataToServer( sz_rfbSetEncodingsMsg + nEncodings * sizeof(uint32_t) );
+				// updates are pushed already so drop requests sent out of habit by the client
+				return socket->read( sz_rfbFramebufferUpdateRequestMsg ).size() == sz_rfbFramebufferUpdateRequestMsg;
 			}
 		}
-		break;
+		return forwardDataToServer( sz_rfbFramebufferUpdateRequestMsg );
 
 	default:
 		if( m_rfbClientToServerMessageSizes.contains( messageType ) == false )
@@ -242,10 +355,280 @@ bool VncProxyConnection::receiveServerMessage()
 {
 	if( clientProtocol().receiveMessage() )
 	{
-		m_proxyClientSocket->write( clientProtocol().lastMessage() );
+		const auto& message = clientProtocol().lastMessage();
+
+		m_proxyClientSocket->write( message );
+
+		if( clientProtocol().lastMessageType() == rfbFramebufferUpdate )
+		{
+			m_continuousUpdateRequestPending = false;
+
+			if( m_inputResponseTimer.isValid() )
+			{
+				Metrics::observe( "veyon_proxy_input_response_seconds", double(m_inputResponseTimer.nsecsElapsed()) / 1e9 );
+				m_inputResponseTimer.invalidate();
+			}
+
+			if( m_continuousUpdatesEndPending )
+			{
+				// the last requested update has been forwarded so confirm disabling continuous updates
+				m_continuousUpdatesEndPending = false;
+				m_proxyClientSocket->putChar( char(RfbContinuousUpdates::EndMessageType) );
+			}
+			else
+			{
+				requestContinuousUpdate();
+			}
+		}
+
+		if( m_recording )
+		{
+			const QRect framebufferRect( 0, 0, clientProtocol().framebufferWidth(), clientProtocol().framebufferHeight() );
+			m_recording->record( message, clientProtocol().lastMessageType() == rfbFramebufferUpdate &&
+										  clientProtocol().lastUpdatedRect().contains( framebufferRect ) &&
+										  clientProtocol().lastUpdateIsSelfContained() );
+		}
+
+		if( Metrics::isEnabled() )
+		{
+			const auto client = m_proxyClientSocket->peerAddress().toString();
+			Metrics::increment( "veyon_proxy_sent_bytes_total", message.size(), QStringLiteral("client"), client );
+			if( message.isEmpty() == false && uint8_t(message.at(0)) == rfbFramebufferUpdate )
+			{
+				Metrics::increment( "veyon_proxy_framebuffer_updates_total", 1, QStringLiteral("client"), client );
+			}
+		}
 
 		return true;
 	}
 
 	return false;
 }
+
+
+
+bool VncProxyConnection::receiveSetPixelFormatMessage()
+{
+	auto socket = proxyClientSocket();
+
+	if( socket->bytesAvailable() < sz_rfbSetPixelFormatMsg )
+	{
+		return false;
+	}
+
+	const auto message = socket->read( sz_rfbSetPixelFormatMsg ); // Flawfinder: ignore
+	if( message.size() != sz_rfbSetPixelFormatMsg )
+	{
+		return false;
+	}
+
+	Metrics::increment( "veyon_proxy_received_bytes_total", sz_rfbSetPixelFormatMsg );
+
+	if( message == m_pixelFormatMessage )
+	{
+		return true;
+	}
+
+	m_pixelFormatMessage = message;
+
+	return m_vncServerSocket->write( message ) == message.size();
+}
+
+
+
+bool VncProxyConnection::receiveKeyEventMessage()
+{
+	return forwardInputEventToServer( sz_rfbKeyEventMsg );
+}
+
+
+
+bool VncProxyConnection::receivePointerEventMessage()
+{
+	auto socket = proxyClientSocket();
+
+	// drop pure pointer movements which are superseded by a subsequent queued pointer
+	// event with the same button state so that backlogged motion does not delay
+	// the events following it - events changing the button state are always forwarded
+	rfbPointerEventMsg pointerEvents[2];
+	const auto peekSize = qMin<qint64>( socket->bytesAvailable(), 2 * sz_rfbPointerEventMsg );
+	if( peekSize < sz_rfbPointerEventMsg ||
+		socket->peek( reinterpret_cast<char *>( pointerEvents ), peekSize ) != peekSize )
+	{
+		return false;
+	}
+
+	const auto isMotion = pointerEvents[0].buttonMask == m_lastPointerButtonMask;
+	m_lastPointerButtonMask = pointerEvents[0].buttonMask;
+
+	if( isMotion &&
+		peekSize == 2 * sz_rfbPointerEventMsg &&
+		pointerEvents[1].type == rfbPointerEvent &&
+		pointerEvents[1].buttonMask == pointerEvents[0].buttonMask )
+	{
+		Metrics::increment( "veyon_proxy_coalesced_pointer_events_total" );
+		return socket->read( sz_rfbPointerEventMsg ).size() == sz_rfbPointerEventMsg;
+	}
+
+	return forwardInputEventToServer( sz_rfbPointerEventMsg );
+}
+
+
+
+bool VncProxyConnection::forwardInputEventToServer( qint64 size )
+{
+	if( forwardDataToServer( size ) == false )
+	{
+		return false;
+	}
+
+	if( Metrics::isEnabled() && m_inputResponseTimer.isValid() == false )
+	{
+		m_inputResponseTimer.start();
+	}
+
+	return true;
+}
+
+
+
+bool VncProxyConnection::receiveSetEncodingsMessage()
+{
+	auto socket = proxyClientSocket();
+
+	rfbSetEncodingsMsg setEncodingsMessage;
+	if( socket->bytesAvailable() < sz_rfbSetEncodingsMsg ||
+		socket->peek( reinterpret_cast<char *>( &setEncodingsMessage ), sz_rfbSetEncodingsMsg ) != sz_rfbSetEncodingsMsg )
+	{
+		return false;
+	}
+
+	const auto nEncodings = qFromBigEndian(setEncodingsMessage.nEncodings);
+	if( nEncodings > MAX_ENCODINGS )
+	{
+		vCritical() << "received too many encodings from client";
+		socket->close();
+		return false;
+	}
+
+	const qint64 messageSize = sz_rfbSetEncodingsMsg + nEncodings * sizeof(uint32_t);
+	if( socket->bytesAvailable() < messageSize )
+	{
+		return false;
+	}
+
+	const auto message = socket->read( messageSize ); // Flawfinder: ignore
+	if( message.size() != messageSize )
+	{
+		return false;
+	}
+
+	Metrics::increment( "veyon_proxy_received_bytes_total", messageSize );
+
+	// do not pass the pseudo encoding to the VNC server as we're handling it on our own
+	QVector<uint32_t> encodings;
+	encodings.reserve( nEncodings );
+
+	bool continuousUpdatesRequested = false;
+	const auto encodingData = reinterpret_cast<const uint32_t *>( message.constData() + sz_rfbSetEncodingsMsg );
+	for( int i = 0; i < nEncodings; ++i )
+	{
+		const auto encoding = qFromBigEndian( encodingData[i] );
+		if( int32_t(encoding) == RfbContinuousUpdates::PseudoEncoding )
+		{
+			continuousUpdatesRequested = true;
+		}
+		else
+		{
+			encodings.append( encoding );
+		}
+	}
+
+	if( encodings != m_encodings )
+	{
+		if( clientProtocol().setEncodings( encodings ) == false )
+		{
+			return false;
+		}
+
+		m_encodings = encodings;
+	}
+
+	// confirm support once as specified by the extension
+	if( continuousUpdatesRequested && m_continuousUpdatesAnnounced == false )
+	{
+		m_continuousUpdatesAnnounced = true;
+		m_proxyClientSocket->putChar( char(RfbContinuousUpdates::EndMessageType) );
+	}
+
+	return true;
+}
+
+
+
+bool VncProxyConnection::receiveEnableContinuousUpdatesMessage()
+{
+	auto socket = proxyClientSocket();
+
+	if( m_continuousUpdatesAnnounced == false )
+	{
+		vCritical() << "client enabled continuous updates without announcing support";
+		socket->close();
+		return false;
+	}
+
+	RfbContinuousUpdates::EnableMessage message;
+	if( socket->bytesAvailable() < RfbContinuousUpdates::EnableMessageSize ||
+		socket->read( reinterpret_cast<char *>( &message ), RfbContinuousUpdates::EnableMessageSize ) != RfbContinuousUpdates::EnableMessageSize ) // Flawfinder: ignore
+	{
+		return false;
+	}
+
+	if( message.enable )
+	{
+		m_continuousUpdatesRect = QRect( qFromBigEndian( message.x ), qFromBigEndian( message.y ),
+										 qFromBigEndian( message.w ), qFromBigEndian( message.h ) );
+		m_continuousUpdatesEnabled = true;
+		m_continuousUpdatesEndPending = false;
+
+		requestContinuousUpdate();
+	}
+	else if( m_continuousUpdatesEnabled )
+	{
+		m_continuousUpdatesEnabled = false;
+
+		if( m_continuousUpdateRequestPending )
+		{
+			// confirm once the update for the pending request has been forwarded
+			m_continuousUpdatesEndPending = true;
+		}
+		else
+		{
+			m_proxyClientSocket->putChar( char(RfbContinuousUpdates::EndMessageType) );
+		}
+	}
+
+	return true;
+}
+
+
+
+void VncProxyConnection::requestContinuousUpdate()
+{
+	if( m_continuousUpdatesEnabled == false ||
+		m_continuousUpdateRequestPending ||
+		clientProtocol().state() != VncClientProtocol::State::Running )
+	{
+		return;
+	}
+
+	// do not request further updates while the client has not received the previous ones,
+	// i.e. the network link determines the frame rate - retried once data has been written
+	if( m_proxyClientSocket->bytesToWrite() > MaximumContinuousUpdatesBacklog )
+	{
+		return;
+	}
+
+	m_continuousUpdateRequestPending = true;
+	clientProtocol().requestFramebufferUpdate( m_continuousUpdatesRect, true );
+}
@@ -24,11 +24,16 @@
 
 #pragma once
 
+#include <QElapsedTimer>
+#include <QRect>
+
+#include "VariantArrayMessage.h"
 #include "VeyonCore.h"
 
 class QBuffer;
 class QTcpSocket;
 
+class RfbRecording;
 class VncClientProtocol;
 class VncServerProtocol;
 
@@ -41,6 +46,8 @@ public:
 
 	void start();
 
+	bool isRunning();
+
 	QTcpSocket* proxyClientSocket() const
 	{
 		return m_proxyClientSocket;
@@ -65,19 +72,62 @@ protected:
 	virtual bool receiveClientMessage();
 	virtual bool receiveServerMessage();
 
+	bool receiveSetPixelFormatMessage();
+	bool receiveKeyEventMessage();
+	bool receivePointerEventMessage();
+	bool receiveSetEncodingsMessage();
+	bool receiveEnableContinuousUpdatesMessage();
+	void requestContinuousUpdate();
+
 	virtual VncClientProtocol& clientProtocol() = 0;
 	virtual VncServerProtocol& serverProtocol() = 0;
 
 private:
 	static constexpr int ProtocolRetryTime = 250;
+	static constexpr int MaximumMessagesPerRead = 8;
+	static constexpr qint64 MaximumContinuousUpdatesBacklog = 512*1024;
+	static constexpr qint64 MaximumClientSendBacklog = 8*1024*1024;
+	static constexpr qint64 ServerReadBufferSize = 4*1024*1024;
+	static constexpr qint64 ClientReadBufferSize = VariantArrayMessage::MaxMessageSize + 64*1024;
+
+	void continueReadingFromServer();
+	void continueReadingFromClient();
+	void resumeReadingFromServer();
+
+	bool forwardInputEventToServer( qint64 size );
 
 	const int m_vncServerPort;
 
 	QTcpSocket* m_proxyClientSocket;
 	QTcpSocket* m_vncServerSocket;
 
+	RfbRecording* m_recording{nullptr};
+
 	const QMap<int, int> m_rfbClientToServerMessageSizes;
 
+	// pixel format and encodings last forwarded to the VNC server so that repeated
+	// identical requests do not make the server reset its translation and encoder state
+	QByteArray m_pixelFormatMessage{};
+	QVector<uint32_t> m_encodings{};
+
+	// time since the first input event forwarded after the last framebuffer update
+	QElapsedTimer m_inputResponseTimer{};
+
+	bool m_continueReadingFromServer{false};
+	bool m_readingFromServerPaused{false};
+	bool m_continueReadingFromClient{false};
+
+	// button state of the last pointer event received from the client
+	uint8_t m_lastPointerButtonMask{0};
+
+	// ContinuousUpdates extension is implemented by the proxy itself so that
+	// only the local connection to the VNC server uses request/response
+	bool m_continuousUpdatesAnnounced{false};
+	bool m_continuousUpdatesEnabled{false};
+	bool m_continuousUpdatesEndPending{false};
+	bool m_continuousUpdateRequestPending{false};
+	QRect m_continuousUpdatesRect{};
+
 Q_SIGNALS:
 	void clientConnectionClosed();
 	void serverConnectionClosed();
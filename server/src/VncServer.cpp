@@ -30,6 +30,7 @@
 #include "VeyonConfiguration.h"
 #include "PlatformSessionFunctions.h"
 #include "PluginManager.h"
+#include "Tracer.h"
 #include "VncServer.h"
 #include "VncServerPluginInterface.h"
 
@@ -97,6 +98,8 @@ void VncServer::prepare()
 {
 	vDebug();
 
+	const Tracer::Scope traceScope( "VncServer::prepare" );
+
 	if( m_pluginInterface )
 	{
 		m_pluginInterface->prepareServer();
@@ -153,6 +156,8 @@ void VncServer::run()
 			VeyonCore::authenticationCredentials().setInternalVncServerPassword( m_pluginInterface->configuredPassword() );
 		}
 
+		Tracer::milestone( "VncServer::run" );
+
 		if( m_pluginInterface->runServer( serverPort(), password() ) == false )
 		{
 			vCritical() << "An error occurred while running the VNC server plugin";
@@ -0,0 +1,461 @@
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QTest>
+#include <QtEndian>
+
+#include <atomic>
+
+#include "FramebufferScaler.h"
+#include "RfbRecording.h"
+#include "VariantStream.h"
+#include "VeyonCore.h"
+#include "VncClientProtocol.h"
+
+#ifdef __GLIBC__
+static std::atomic<quint64> allocationCount{0};
+
+extern "C" {
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	return __libc_realloc(ptr, size);
+}
+}
+
+static quint64 allocations()
+{
+	return allocationCount.load(std::memory_order_relaxed);
+}
+#else
+static quint64 allocations()
+{
+	return 0;
+}
+#endif
+
+
+class VncClientProtocolBenchmark : public VncClientProtocol
+{
+public:
+	VncClientProtocolBenchmark(QIODevice* socket) :
+		VncClientProtocol(socket, {})
+	{
+		setState(State::FramebufferInit);
+	}
+
+};
+
+
+class Measurement
+{
+public:
+	Measurement(const char* name, qint64 bytesPerIteration) :
+		m_name(name),
+		m_bytesPerIteration(bytesPerIteration),
+		m_allocations(allocations())
+	{
+		m_timer.start();
+	}
+
+	~Measurement()
+	{
+		const auto elapsed = qMax<qint64>(1, m_timer.nsecsElapsed());
+		const auto iterations = qMax<qint64>(1, m_iterations);
+
+		qInfo("%s: %.1f MB/s, %.1f allocations per iteration", m_name,
+			  double(m_bytesPerIteration * iterations) * 1000 / elapsed,
+			  double(allocations() - m_allocations) / iterations);
+	}
+
+	void next()
+	{
+		++m_iterations;
+	}
+
+private:
+	const char* m_name;
+	const qint64 m_bytesPerIteration;
+	const quint64 m_allocations;
+	qint64 m_iterations{0};
+	QElapsedTimer m_timer;
+
+};
+
+
+class VeyonBenchmarks : public QObject
+{
+	Q_OBJECT
+private:
+	static constexpr int FramebufferWidth = 1920;
+	static constexpr int FramebufferHeight = 1080;
+	static constexpr int HextileTileSize = 16;
+
+	template<typename T>
+	static void append(QByteArray& data, T value)
+	{
+		value = qToBigEndian(value);
+		data.append(reinterpret_cast<const char *>(&value), sizeof(value));
+	}
+
+	static QByteArray serverInitMessage()
+	{
+		QByteArray data;
+		append<uint16_t>(data, FramebufferWidth);
+		append<uint16_t>(data, FramebufferHeight);
+
+		// 32 bpp, depth 24, little endian, true colour, 8 bits per channel
+		append<uint8_t>(data, 32);
+		append<uint8_t>(data, 24);
+		append<uint8_t>(data, 0);
+		append<uint8_t>(data, 1);
+		append<uint16_t>(data, 255);
+		append<uint16_t>(data, 255);
+		append<uint16_t>(data, 255);
+		append<uint8_t>(data, 16);
+		append<uint8_t>(data, 8);
+		append<uint8_t>(data, 0);
+		data.append(3, 0);
+
+		const auto name = QByteArrayLiteral("benchmark");
+		append<uint32_t>(data, name.size());
+		data.append(name);
+
+		return data;
+	}
+
+	static void appendRectHeader(QByteArray& data, const QRect& rect, int32_t encoding)
+	{
+		append<uint16_t>(data, rect.x());
+		append<uint16_t>(data, rect.y());
+		append<uint16_t>(data, rect.width());
+		append<uint16_t>(data, rect.height());
+		append<int32_t>(data, encoding);
+	}
+
+	static QByteArray rawUpdateMessage(const QRect& rect)
+	{
+		QByteArray data;
+		append<uint8_t>(data, rfbFramebufferUpdate);
+		append<uint8_t>(data, 0);
+		append<uint16_t>(data, 1);
+		appendRectHeader(data, rect, rfbEncodingRaw);
+
+		const auto pixelDataSize = rect.width() * rect.height() * 4;
+		data.reserve(data.size() + pixelDataSize);
+		for (int i = 0; i < pixelDataSize; ++i)
+		{
+			data.append(char(i * 7));
+		}
+
+		return data;
+	}
+
+	static QByteArray hextileUpdateMessage(const QRect& rect)
+	{
+		QByteArray data;
+		append<uint8_t>(data, rfbFramebufferUpdate);
+		append<uint8_t>(data, 0);
+		append<uint16_t>(data, 1);
+		appendRectHeader(data, rect, rfbEncodingHextile);
+
+		int tile = 0;
+		for (int y = rect.top(); y <= rect.bottom(); y += HextileTileSize)
+		{
+			for (int x = rect.left(); x <= rect.right(); x += HextileTileSize, ++tile)
+			{
+				const auto w = qMin(HextileTileSize, rect.right() + 1 - x);
+				const auto h = qMin(HextileTileSize, rect.bottom() + 1 - y);
+
+				if (tile % 4 == 0)
+				{
+					// raw tile
+					append<uint8_t>(data, rfbHextileRaw);
+					data.append(w * h * 4, char(tile));
+				}
+				else
+				{
+					// background plus coloured subrects
+					append<uint8_t>(data, rfbHextileBackgroundSpecified | rfbHextileAnySubrects | rfbHextileSubrectsColoured);
+					append<uint32_t>(data, 0x00ffffff);
+					const auto subrects = 4;
+					append<uint8_t>(data, subrects);
+					for (int i = 0; i < subrects; ++i)
+					{
+						append<uint32_t>(data, 0x00102030 * i);
+						append<uint8_t>(data, uint8_t((i * 2) << 4 | (i * 2)));
+						append<uint8_t>(data, uint8_t(0x11));
+					}
+				}
+			}
+		}
+
+		return data;
+	}
+
+	static RfbRecording::Messages recording()
+	{
+		const auto fileName = qEnvironmentVariable("VEYON_BENCHMARK_RFB_RECORDING");
+		if (fileName.isEmpty())
+		{
+			return {};
+		}
+
+		return RfbRecording::load(fileName);
+	}
+
+	static int replay(const QByteArray& updateMessages, const QByteArray& serverInit = serverInitMessage())
+	{
+		QBuffer buffer;
+		buffer.open(QIODevice::ReadWrite);
+		buffer.write(serverInit);
+		buffer.write(updateMessages);
+		buffer.seek(0);
+
+		VncClientProtocolBenchmark protocol(&buffer);
+		protocol.read();
+
+		int messages = 0;
+		while (buffer.bytesAvailable() > 0 && protocol.receiveMessage())
+		{
+			++messages;
+		}
+
+		return messages;
+	}
+
+	static QVariantMap featureMessageArguments()
+	{
+		return {
+			{ QStringLiteral("text"), QStringLiteral("Please save your work, the computer is shut down in 5 minutes.") },
+			{ QStringLiteral("icon"), 1 },
+			{ QStringLiteral("fullScreen"), true },
+			{ QStringLiteral("rect"), QRect(0, 0, 1920, 1080) },
+			{ QStringLiteral("users"), QStringList{ QStringLiteral("alice"), QStringLiteral("bob"), QStringLiteral("carol") } },
+			{ QStringLiteral("data"), QByteArray(4096, 'x') }
+		};
+	}
+
+	// nests maps as deep as VariantStream accepts to exercise its worst-case recursion costs
+	static QVariantMap nestedMap(int depth, int entries)
+	{
+		QVariantMap map;
+		for (int i = 0; i < entries; ++i)
+		{
+			const auto key = QString::number(i);
+			if (depth > 1)
+			{
+				map[key] = nestedMap(depth - 1, entries);
+			}
+			else
+			{
+				map[key] = i;
+			}
+		}
+		return map;
+	}
+
+	static QImage framebuffer()
+	{
+		QImage image(FramebufferWidth, FramebufferHeight, QImage::Format_RGB32);
+		for (int y = 0; y < image.height(); ++y)
+		{
+			auto line = reinterpret_cast<QRgb *>(image.scanLine(y));
+			for (int x = 0; x < image.width(); ++x)
+			{
+				line[x] = qRgb(x, y, x ^ y);
+			}
+		}
+		return image;
+	}
+
+private Q_SLOTS:
+	void initTestCase()
+	{
+		new VeyonCore(QCoreApplication::instance(), VeyonCore::Component::CLI, QStringLiteral("Benchmark"));
+	}
+
+	void vncClientProtocolRaw()
+	{
+		QByteArray messages;
+		for (int i = 0; i < 8; ++i)
+		{
+			messages.append(rawUpdateMessage({0, i * 128, FramebufferWidth, 128}));
+		}
+
+		QCOMPARE(replay(messages), 8);
+
+		Measurement measurement("raw", messages.size());
+		QBENCHMARK {
+			replay(messages);
+			measurement.next();
+		}
+	}
+
+	void vncClientProtocolHextile()
+	{
+		const auto messages = hextileUpdateMessage({0, 0, FramebufferWidth, FramebufferHeight});
+
+		QCOMPARE(replay(messages), 1);
+
+		Measurement measurement("hextile", messages.size());
+		QBENCHMARK {
+			replay(messages);
+			measurement.next();
+		}
+	}
+
+	void vncClientProtocolManyRects()
+	{
+		// maximum number of tiny rectangles per update to make per-rectangle overhead visible
+		constexpr int RectCount = 65535;
+
+		QByteArray messages;
+		append<uint8_t>(messages, rfbFramebufferUpdate);
+		append<uint8_t>(messages, 0);
+		append<uint16_t>(messages, RectCount);
+		for (int i = 0; i < RectCount; ++i)
+		{
+			appendRectHeader(messages, {i % FramebufferWidth, i / FramebufferWidth, 1, 1}, rfbEncodingRaw);
+			append<uint32_t>(messages, uint32_t(i));
+		}
+
+		QCOMPARE(replay(messages), 1);
+
+		Measurement measurement("many rects", messages.size());
+		QBENCHMARK {
+			replay(messages);
+			measurement.next();
+		}
+	}
+
+	void vncClientProtocolRecording()
+	{
+		const auto messages = recording();
+		if (messages.isEmpty())
+		{
+			QSKIP("set VEYON_BENCHMARK_RFB_RECORDING to a file recorded by the server via VEYON_RFB_RECORDING_DIR");
+		}
+
+		QByteArray updateMessages;
+		for (int i = 1; i < messages.size(); ++i)
+		{
+			updateMessages.append(messages[i].data);
+		}
+
+		Measurement measurement("recording", updateMessages.size());
+		QBENCHMARK {
+			replay(updateMessages, messages.first().data);
+			measurement.next();
+		}
+	}
+
+	void variantStreamWrite()
+	{
+		const QVariant arguments = featureMessageArguments();
+
+		QBuffer buffer;
+		buffer.open(QIODevice::ReadWrite);
+		VariantStream(&buffer).write(arguments);
+		const auto size = buffer.size();
+
+		Measurement measurement("VariantStream::write()", size);
+		QBENCHMARK {
+			buffer.seek(0);
+			VariantStream(&buffer).write(arguments);
+			measurement.next();
+		}
+	}
+
+	void variantStreamRead()
+	{
+		const QVariant arguments = featureMessageArguments();
+
+		QBuffer buffer;
+		buffer.open(QIODevice::ReadWrite);
+		VariantStream(&buffer).write(arguments);
+		buffer.seek(0);
+		QCOMPARE(VariantStream(&buffer).read(), arguments);
+
+		Measurement measurement("VariantStream::read()", buffer.size());
+		QBENCHMARK {
+			buffer.seek(0);
+			VariantStream(&buffer).read();
+			measurement.next();
+		}
+	}
+
+	void variantStreamReadNested()
+	{
+		const QVariant arguments = nestedMap(VariantStream::MaxCheckRecursionDepth, 32);
+
+		QBuffer buffer;
+		buffer.open(QIODevice::ReadWrite);
+		VariantStream(&buffer).write(arguments);
+		buffer.seek(0);
+		QCOMPARE(VariantStream(&buffer).read(), arguments);
+
+		Measurement measurement("VariantStream::read() nested", buffer.size());
+		QBENCHMARK {
+			buffer.seek(0);
+			VariantStream(&buffer).read();
+			measurement.next();
+		}
+	}
+
+	void framebufferScaling_data()
+	{
+		QTest::addColumn<VncConnectionConfiguration::ScalingMode>("mode");
+
+		QTest::newRow("fast") << VncConnectionConfiguration::ScalingMode::Fast;
+		QTest::newRow("area-averaging") << VncConnectionConfiguration::ScalingMode::AreaAveraging;
+		QTest::newRow("smooth") << VncConnectionConfiguration::ScalingMode::Smooth;
+	}
+
+	void framebufferScaling()
+	{
+		QFETCH(VncConnectionConfiguration::ScalingMode, mode);
+
+		const auto image = framebuffer();
+		const QSize thumbnailSize(320, 180);
+
+		Measurement measurement(QTest::currentDataTag(), image.sizeInBytes());
+		QBENCHMARK {
+			FramebufferScaler::scaled(image, thumbnailSize, mode);
+			measurement.next();
+		}
+	}
+
+	void framebufferScalingPartial()
+	{
+		const auto image = framebuffer();
+		auto scaledImage = FramebufferScaler::areaAveraged(image, {320, 180});
+		const QRect updatedRect(640, 360, 256, 128);
+
+		Measurement measurement("partial area-averaging", updatedRect.width() * updatedRect.height() * 4);
+		QBENCHMARK {
+			FramebufferScaler::areaAveraged(image, scaledImage, updatedRect);
+			measurement.next();
+		}
+	}
+
+};
+
+
+QTEST_GUILESS_MAIN(VeyonBenchmarks)
+#include "main.moc"
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+
+// flags inputs whose processing time grows super-linearly with their size - enabled by
+// setting VEYON_FUZZER_MAX_NSECS_PER_BYTE, memory usage is bounded via libFuzzer's
+// -malloc_limit_mb and -rss_limit_mb options instead
+class CostGuard
+{
+public:
+	template<class Function>
+	static void run(size_t size, Function&& process)
+	{
+		if (maximumNsecsPerByte() <= 0)
+		{
+			process();
+			return;
+		}
+
+		const auto inputSize = qint64(size);
+		const auto budget = FixedBudget + maximumNsecsPerByte() * inputSize;
+
+		std::array<qint64, Repetitions> samples{};
+		samples[0] = measure(process);
+
+		report(inputSize, samples[0]);
+
+		if (samples[0] <= budget)
+		{
+			return;
+		}
+
+		// a single slow run may be caused by scheduling or load on the host so only
+		// fail if the median of several runs exceeds the budget as well
+		for (size_t i = 1; i < samples.size(); ++i)
+		{
+			samples[i] = measure(process);
+		}
+
+		std::sort(samples.begin(), samples.end());
+		const auto median = samples[samples.size() / 2];
+
+		if (median > budget)
+		{
+			fprintf(stderr, "COST: median processing time of %lld bytes is %lld ns which exceeds budget of %lld ns per byte\n",
+					inputSize, median, maximumNsecsPerByte());
+			abort();
+		}
+	}
+
+private:
+	// covers setup costs which do not depend on the input size
+	static constexpr qint64 FixedBudget = 10*1000*1000;
+	static constexpr size_t Repetitions = 5;
+
+	template<class Function>
+	static qint64 measure(Function& process)
+	{
+		QElapsedTimer timer;
+		timer.start();
+		process();
+		return timer.nsecsElapsed();
+	}
+
+	static void report(qint64 size, qint64 elapsed)
+	{
+		const auto nsecsPerByte = elapsed / qMax<qint64>(1, size);
+
+		static qint64 maximumObservedNsecsPerByte = 0;
+		if (nsecsPerByte > maximumObservedNsecsPerByte && elapsed > FixedBudget / 10)
+		{
+			maximumObservedNsecsPerByte = nsecsPerByte;
+			fprintf(stderr, "COST: %lld bytes took %lld ns (%lld ns per byte)\n",
+					size, elapsed, nsecsPerByte);
+		}
+	}
+
+	static qint64 maximumNsecsPerByte()
+	{
+		static const qint64 value = qEnvironmentVariableIntValue("VEYON_FUZZER_MAX_NSECS_PER_BYTE");
+		return value;
+	}
+
+};
@@ -1,15 +1,18 @@
 #include <QBuffer>
 
+#include "CostGuard.h"
 #include "VariantStream.h"
 
 extern "C" int LLVMFuzzerTestOneInput(const char *data, size_t size)
 {
-	QBuffer buffer;
-	buffer.open(QIODevice::ReadWrite);
-	buffer.write(QByteArray::fromRawData(data, size));
-	buffer.seek(0);
+	CostGuard::run(size, [&]() {
+		QBuffer buffer;
+		buffer.open(QIODevice::ReadWrite);
+		buffer.write(QByteArray::fromRawData(data, size));
+		buffer.seek(0);
 
-	VariantStream{&buffer}.read();
+		VariantStream{&buffer}.read();
+	});
 
 	return 0;
 }
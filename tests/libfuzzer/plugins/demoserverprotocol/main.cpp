@@ -0,0 +1,40 @@
+#include <QBuffer>
+
+#include "CostGuard.h"
+#include "DemoAuthentication.h"
+#include "DemoServerProtocol.h"
+#include "VncServerClient.h"
+
+
+extern "C" int LLVMFuzzerTestOneInput(const char *data, size_t size)
+{
+	CostGuard::run(size, [&]() {
+		if (size < 4)
+		{
+			return;
+		}
+
+		static DemoAuthentication authentication(Plugin::Uid{QByteArrayLiteral("6e8c4b64-bf21-4bbb-bade-6bbea4f04a66")});
+		if (authentication.hasCredentials() == false)
+		{
+			authentication.initializeCredentials();
+		}
+
+		QBuffer buffer;
+		buffer.open(QIODevice::ReadWrite);
+
+		VncServerClient client;
+		DemoServerProtocol protocol(authentication, &buffer, &client);
+
+		client.setProtocolState(VncServerProtocol::State(data[0]));
+		client.setAuthState(VncServerClient::AuthState(data[1]));
+		client.setAccessControlState(VncServerClient::AccessControlState(data[2]));
+
+		buffer.write(QByteArray::fromRawData(data+3, size-3));
+		buffer.seek(0);
+
+		protocol.read();
+	});
+
+	return 0;
+}
@@ -26,18 +26,21 @@
 #include <QHostAddress>
 
 #include "FeatureManager.h"
+#include "FeatureWorkerManager.h"
 #include "FeatureWorkerManagerConnection.h"
 #include "VeyonConfiguration.h"
 
 
 FeatureWorkerManagerConnection::FeatureWorkerManagerConnection( VeyonWorkerInterface& worker,
 																Feature::Uid featureUid,
+																const QString& standbyToken,
 																QObject* parent ) :
 	QObject( parent ),
 	m_worker( worker ),
 	m_port(VeyonCore::config().featureWorkerManagerPort() + VeyonCore::sessionId()),
 	m_socket( this ),
-	m_featureUid( featureUid )
+	m_featureUid( featureUid ),
+	m_standbyToken( standbyToken )
 {
 	connect( &m_connectTimer, &QTimer::timeout, this, &FeatureWorkerManagerConnection::tryConnection );
 
@@ -86,7 +89,16 @@ void FeatureWorkerManagerConnection::sendInitMessage()
 
 	m_connectTimer.stop();
 
-	FeatureMessage( m_featureUid, FeatureMessage::InitCommand ).send( &m_socket );
+	m_socket.setSocketOption( QAbstractSocket::LowDelayOption, 1 );
+
+	FeatureMessage initMessage( m_featureUid, FeatureMessage::InitCommand );
+	if( m_featureUid.isNull() )
+	{
+		// lets the server verify this worker was started for the current user session
+		initMessage.addArgument( FeatureWorkerManager::InitArgument::StandbyToken, m_standbyToken );
+	}
+
+	initMessage.send( &m_socket );
 }
 
 
@@ -97,7 +109,20 @@ void FeatureWorkerManagerConnection::receiveMessage()
 
 	while( featureMessage.isReadyForReceive( &m_socket ) )
 	{
-		if( featureMessage.receive( &m_socket ) )
+		if( featureMessage.receive( &m_socket ) == false )
+		{
+			continue;
+		}
+
+		if( featureMessage.command() == FeatureMessage::BindCommand )
+		{
+			if( m_featureUid.isNull() )
+			{
+				m_featureUid = featureMessage.featureUid();
+				Q_EMIT featureBound( m_featureUid );
+			}
+		}
+		else
 		{
 			VeyonCore::featureManager().handleFeatureMessage( m_worker, featureMessage );
 		}
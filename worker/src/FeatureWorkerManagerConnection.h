@@ -39,6 +39,7 @@ class FeatureWorkerManagerConnection : public QObject
 public:
 	FeatureWorkerManagerConnection( VeyonWorkerInterface& worker,
 									Feature::Uid featureUid,
+									const QString& standbyToken,
 									QObject* parent = nullptr );
 
 
@@ -55,6 +56,10 @@ private:
 	const int m_port;
 	QTcpSocket m_socket;
 	Feature::Uid m_featureUid;
+	const QString m_standbyToken;
 	QTimer m_connectTimer{this};
 
+Q_SIGNALS:
+	void featureBound( Feature::Uid featureUid );
+
 } ;
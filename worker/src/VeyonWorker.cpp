@@ -30,35 +30,26 @@
 #include "VeyonWorker.h"
 
 
-VeyonWorker::VeyonWorker( QUuid featureUid, QObject* parent ) :
+VeyonWorker::VeyonWorker( QUuid featureUid, const QString& standbyToken, QObject* parent ) :
 	QObject( parent ),
 	m_core( QCoreApplication::instance(),
 			VeyonCore::Component::Worker,
-			QStringLiteral( "FeatureWorker-" ) + VeyonCore::formattedUuid( featureUid ) )
+			QStringLiteral( "FeatureWorker-" ) +
+				( featureUid.isNull() ? QStringLiteral("Standby") : VeyonCore::formattedUuid( featureUid ) ) )
 {
-	const Feature* workerFeature = nullptr;
-
-	for( const auto& feature : VeyonCore::featureManager().features() )
+	if( featureUid.isNull() == false )
 	{
-		if( feature.uid() == featureUid )
-		{
-			workerFeature = &feature;
-		}
+		initFeature( featureUid );
 	}
-
-	if( workerFeature == nullptr )
+	else
 	{
-		qFatal( "Could not find specified feature" );
+		vInfo() << "Running standby worker";
 	}
 
-	if( VeyonCore::config().disabledFeatures().contains( featureUid.toString() ) )
-	{
-		qFatal( "Specified feature is disabled by configuration!" );
-	}
+	m_workerManagerConnection = new FeatureWorkerManagerConnection(*this, featureUid, standbyToken);
 
-	m_workerManagerConnection = new FeatureWorkerManagerConnection(*this, featureUid);
-
-	vInfo() << "Running worker for feature" << workerFeature->name();
+	connect( m_workerManagerConnection, &FeatureWorkerManagerConnection::featureBound,
+			 this, &VeyonWorker::initFeature );
 }
 
 
@@ -80,3 +71,30 @@ bool VeyonWorker::sendFeatureMessageReply( const FeatureMessage& reply )
 	return m_workerManagerConnection &&
 			m_workerManagerConnection->sendMessage( reply );
 }
+
+
+
+void VeyonWorker::initFeature( QUuid featureUid )
+{
+	const Feature* workerFeature = nullptr;
+
+	for( const auto& feature : VeyonCore::featureManager().features() )
+	{
+		if( feature.uid() == featureUid )
+		{
+			workerFeature = &feature;
+		}
+	}
+
+	if( workerFeature == nullptr )
+	{
+		qFatal( "Could not find specified feature" );
+	}
+
+	if( VeyonCore::config().disabledFeatures().contains( featureUid.toString() ) )
+	{
+		qFatal( "Specified feature is disabled by configuration!" );
+	}
+
+	vInfo() << "Running worker for feature" << workerFeature->name();
+}
@@ -33,7 +33,7 @@ class VeyonWorker : public QObject, VeyonWorkerInterface
 {
 	Q_OBJECT
 public:
-	explicit VeyonWorker( QUuid featureUid, QObject* parent = nullptr );
+	explicit VeyonWorker( QUuid featureUid, const QString& standbyToken, QObject* parent = nullptr );
 	~VeyonWorker() override;
 
 	bool sendFeatureMessageReply( const FeatureMessage& reply ) override;
@@ -44,6 +44,8 @@ public:
 	}
 
 private:
+	void initFeature( QUuid featureUid );
+
 	VeyonCore m_core;
 	FeatureWorkerManagerConnection* m_workerManagerConnection{nullptr};
 
@@ -26,6 +26,7 @@
 #include <QIcon>
 
 #include "Feature.h"
+#include "FeatureWorkerManager.h"
 #include "VeyonWorker.h"
 
 
@@ -43,13 +44,15 @@ int main( int argc, char **argv )
 		qFatal( "Not enough arguments (feature)" );
 	}
 
-	const auto featureUid = Feature::Uid{arguments[1]};
-	if( featureUid.isNull() )
+	// standby workers are started without a feature and bound to one later on
+	const auto featureUid = arguments[1] == FeatureWorkerManager::standbyWorkerArgument() ?
+								Feature::Uid{} : Feature::Uid{arguments[1]};
+	if( featureUid.isNull() && arguments[1] != FeatureWorkerManager::standbyWorkerArgument() )
 	{
 		qFatal( "Invalid feature UID given" );
 	}
 
-	VeyonWorker worker( featureUid );
+	VeyonWorker worker( featureUid, featureUid.isNull() ? arguments.value( 2 ) : QString{} );
 
 	return worker.core().exec();
 }